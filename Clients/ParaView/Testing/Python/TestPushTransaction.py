@@ -0,0 +1,92 @@
+import os
+import shutil
+import tempfile
+
+from paraview import servermanager
+import paraview.simple as smp
+
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+
+def getHost(url):
+   return url.split(':')[1][2:]
+
+
+def getPort(url):
+   return int(url.split(':')[2])
+
+
+def getServerOutput(source):
+    """Returns a summary of the output of the source as computed on the server,
+    which depends on the property values of the server-side objects."""
+    data = servermanager.Fetch(source)
+    return (data.GetNumberOfPoints(), data.GetNumberOfCells(),
+            tuple(round(x, 6) for x in data.GetBounds()))
+
+
+def buildPipeline():
+    sphere = smp.Sphere(Radius=2.5, ThetaResolution=17, PhiResolution=11, Center=[1, 2, 3])
+    shrink = smp.Shrink(Input=sphere, ShrinkFactor=0.3)
+    clip = smp.Clip(Input=shrink)
+    clip.ClipType = 'Plane'
+    clip.ClipType.Origin = [1, 2, 3]
+    clip.ClipType.Normal = [0, 1, 1]
+    return [sphere, shrink, clip]
+
+
+def runTest():
+
+    options = servermanager.vtkRemotingCoreConfiguration.GetInstance()
+    url = options.GetServerURL()
+
+    smp.Connect(getHost(url), getPort(url))
+    pxm = servermanager.ProxyManager().SMProxyManager
+
+    # A state loaded in a transaction gives the server-side objects the same
+    # property values as the ones they got from separate pushes.
+    names = ['Sphere1', 'Shrink1', 'Clip1']
+    expected = [getServerOutput(source) for source in buildPipeline()]
+
+    tempdir = tempfile.mkdtemp()
+    try:
+        statefile = os.path.join(tempdir, 'TestPushTransaction.pvsm')
+        smp.SaveState(statefile)
+        for name in reversed(names):
+            smp.Delete(smp.FindSource(name))
+
+        pxm.BeginPushTransaction()
+        smp.LoadState(statefile)
+        pxm.EndPushTransaction()
+    finally:
+        shutil.rmtree(tempdir)
+
+    loaded = [getServerOutput(smp.FindSource(name)) for name in names]
+    assert loaded == expected, "state loaded in a transaction: %s != %s" % (loaded, expected)
+
+    # A proxy updated several times in a transaction, with overlapping
+    # properties, ends up with the last values of each property.
+    reference = smp.Sphere(Radius=3.0, ThetaResolution=9, Center=[5, 0, 0])
+    expected = getServerOutput(reference)
+
+    sphere = smp.Sphere()
+    pxm.BeginPushTransaction()
+    sphere.Radius = 1.0
+    sphere.UpdateVTKObjects()
+    sphere.Radius = 4.0
+    sphere.ThetaResolution = 9
+    sphere.UpdateVTKObjects()
+    sphere.Center = [5, 0, 0]
+    sphere.UpdateVTKObjects()
+    sphere.Radius = 3.0
+    sphere.UpdateVTKObjects()
+    pxm.EndPushTransaction()
+
+    updated = getServerOutput(sphere)
+    assert updated == expected, "proxy updated in a transaction: %s != %s" % (updated, expected)
+
+    smp.Disconnect()
+
+
+runTest()
@@ -22,13 +22,17 @@ static const int NO_COMPRESSION = 0;
 static const int LZ4_COMPRESSION = 1;
 static const int SQUIRT_COMPRESSION = 2;
 static const int ZLIB_COMPRESSION = 3;
-static const int NVPIPE_COMPRESSION = 4;
+static const int DELTA_COMPRESSION = 4;
+static const int NVPIPE_COMPRESSION = 5;
 //-----------------------------------------------------------------------------
 
 class pqImageCompressorWidget::pqInternals
 {
 public:
   Ui::ImageCompressorWidget Ui;
+  // Delta compressor options without a widget, kept from the last configuration.
+  int DeltaTileCompressor = 0;
+  int DeltaKeyFrameInterval = 0;
 };
 
 //-----------------------------------------------------------------------------
@@ -56,6 +60,8 @@ pqImageCompressorWidget::pqImageCompressorWidget(
   this->connect(
     ui.compressionType, SIGNAL(currentIndexChanged(int)), SIGNAL(compressorConfigChanged()));
   this->connect(ui.squirtColorSpace, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
+  this->connect(ui.squirtStripes, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
+  this->connect(ui.deltaTileSize, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
   this->connect(ui.zlibColorSpace, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
   this->connect(ui.zlibLevel, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
   QObject::connect(ui.zlibStripAlpha, &QCheckBox::pqCheckBoxSignal, this,
@@ -83,10 +89,11 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
   // Need to fix it.
   Ui::ImageCompressorWidget& ui = this->Internals->Ui;
   QRegExp squirtRegExp("^vtkSquirtCompressor"
-                       "\\s+"     // space
-                       "0"        // 0
-                       "\\s+"     // space
-                       "([0-9]+)" // num-of-bits.
+                       "\\s+"              // space
+                       "0"                 // 0
+                       "\\s+"              // space
+                       "([0-9]+)"          // num-of-bits.
+                       "(?:\\s+([0-9]+))?" // optional number of stripes.
                        "$");
   QRegExp zlibRegExp("^vtkZlibImageCompressor"
                      "\\s+"
@@ -104,6 +111,18 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
                     "\\s+"     // space
                     "([0-9]+)" // num-of-bits.
                     "$");
+  QRegExp deltaRegExp("^vtkDeltaImageCompressor"
+                      "\\s+"
+                      "0"
+                      "\\s+"
+                      "([0-9]+)" // tile size
+                      "\\s+"
+                      "([01])" // tile compressor (0: LZ4, 1: Squirt)
+                      "\\s+"
+                      "([0-9]+)" // quality
+                      "\\s+"
+                      "([0-9]+)" // key frame interval
+                      "$");
   QRegExp nvpipeRegExp("^vtkNvPipeCompressor"
                        "\\s+"     // space
                        "0"        // 0
@@ -120,8 +139,10 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
   else if (squirtRegExp.exactMatch(value))
   {
     int numBits = squirtRegExp.cap(1).toInt();
+    int numStripes = squirtRegExp.cap(2).toInt();
     ui.compressionType->setCurrentIndex(SQUIRT_COMPRESSION);
     ui.squirtColorSpace->setValue(numBits);
+    ui.squirtStripes->setValue(numStripes);
   }
   else if (zlibRegExp.exactMatch(value))
   {
@@ -133,6 +154,16 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
     ui.zlibColorSpace->setValue(numBits);
     ui.zlibStripAlpha->setCheckState(stripAlpha ? Qt::Checked : Qt::Unchecked);
   }
+  else if (deltaRegExp.exactMatch(value))
+  {
+    int tileSize = deltaRegExp.cap(1).toInt();
+    this->Internals->DeltaTileCompressor = deltaRegExp.cap(2).toInt();
+    int quality = deltaRegExp.cap(3).toInt();
+    this->Internals->DeltaKeyFrameInterval = deltaRegExp.cap(4).toInt();
+    ui.compressionType->setCurrentIndex(DELTA_COMPRESSION);
+    ui.deltaTileSize->setValue(tileSize);
+    ui.squirtColorSpace->setValue(quality);
+  }
   else if (nvpipeRegExp.exactMatch(value))
   {
     int level = nvpipeRegExp.cap(1).toInt();
@@ -155,7 +186,9 @@ QString pqImageCompressorWidget::compressorConfig() const
       return QString("vtkLZ4Compressor 0 %1").arg(ui.squirtColorSpace->value());
 
     case SQUIRT_COMPRESSION: // squirt
-      return QString("vtkSquirtCompressor 0 %1").arg(ui.squirtColorSpace->value());
+      return QString("vtkSquirtCompressor 0 %1 %2")
+        .arg(ui.squirtColorSpace->value())
+        .arg(ui.squirtStripes->value());
 
     case ZLIB_COMPRESSION: // zlib
       return QString("vtkZlibImageCompressor 0 %1 %2 %3")
@@ -163,6 +196,13 @@ QString pqImageCompressorWidget::compressorConfig() const
         .arg(ui.zlibColorSpace->value())
         .arg(ui.zlibStripAlpha->isChecked() ? 1 : 0);
 
+    case DELTA_COMPRESSION: // delta
+      return QString("vtkDeltaImageCompressor 0 %1 %2 %3 %4")
+        .arg(ui.deltaTileSize->value())
+        .arg(this->Internals->DeltaTileCompressor)
+        .arg(ui.squirtColorSpace->value())
+        .arg(this->Internals->DeltaKeyFrameInterval);
+
     case NVPIPE_COMPRESSION: // nvpipe
       return QString("vtkNvPipeCompressor 0 %1").arg(ui.nvpLevel->value());
   }
@@ -174,8 +214,14 @@ QString pqImageCompressorWidget::compressorConfig() const
 void pqImageCompressorWidget::currentIndexChanged(int index)
 {
   Ui::ImageCompressorWidget& ui = this->Internals->Ui;
-  ui.squirtLabel->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
-  ui.squirtColorSpace->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
+  ui.squirtLabel->setVisible(
+    index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION || index == DELTA_COMPRESSION);
+  ui.squirtColorSpace->setVisible(
+    index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION || index == DELTA_COMPRESSION);
+  ui.squirtStripesLabel->setVisible(index == SQUIRT_COMPRESSION);
+  ui.squirtStripes->setVisible(index == SQUIRT_COMPRESSION);
+  ui.deltaTileSizeLabel->setVisible(index == DELTA_COMPRESSION);
+  ui.deltaTileSize->setVisible(index == DELTA_COMPRESSION);
 
   ui.zlibLabel1->setVisible(index == ZLIB_COMPRESSION);
   ui.zlibLabel2->setVisible(index == ZLIB_COMPRESSION);
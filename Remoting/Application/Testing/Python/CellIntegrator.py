@@ -9,6 +9,9 @@ paraview.compatibility.major = 3
 paraview.compatibility.minor = 4
 from paraview import servermanager
 from paraview import util
+from paraview.vtk.vtkCommonCore import vtkPoints
+from paraview.vtk.vtkCommonDataModel import vtkUnstructuredGrid
+from paraview.vtk.vtkCommonDataModel import VTK_HEXAHEDRON, VTK_PYRAMID, VTK_WEDGE
 
 smtesting.ProcessCommandLineArguments()
 
@@ -83,3 +86,48 @@ integVal = util.IntegrateCell(filter2Output, 200)
 if integVal < 0.569 or integVal > 0.570:
     print("ERROR: incorrect result for cell 200 of 3rd dataset")
     sys.exit(1)
+
+# Non-affine hexahedra, wedges and pyramids, whose volumes are known
+# analytically. These cells are integrated with a quadrature rule that is
+# exact for their trilinear mappings.
+def MakeCell(cellType, coordinates):
+    points = vtkPoints()
+    for coordinate in coordinates:
+        points.InsertNextPoint(coordinate)
+    grid = vtkUnstructuredGrid()
+    grid.SetPoints(points)
+    grid.InsertNextCell(cellType, len(coordinates), list(range(len(coordinates))))
+    return grid
+
+cells = [
+    # Frustum of a square pyramid, from a unit square to a 2 x 2 square:
+    # h / 3 * (1 + 4 + sqrt(1 * 4)).
+    ("frustum hexahedron", VTK_HEXAHEDRON,
+     [(0, 0, 0), (1, 0, 0), (1, 1, 0), (0, 1, 0),
+      (0, 0, 1), (2, 0, 1), (2, 2, 1), (0, 2, 1)], 7.0 / 3.0),
+    # Unit square base under the non-planar top z = 1 + x * y:
+    # 1 + 1 / 4.
+    ("twisted hexahedron", VTK_HEXAHEDRON,
+     [(0, 0, 0), (1, 0, 0), (1, 1, 0), (0, 1, 0),
+      (0, 0, 1), (1, 0, 1), (1, 1, 2), (0, 1, 1)], 1.25),
+    # Frustum of a triangular pyramid, from a right triangle of area 1 / 2 to
+    # one of area 2: h / 3 * (1 / 2 + 2 + sqrt(1 / 2 * 2)).
+    ("frustum wedge", VTK_WEDGE,
+     [(0, 0, 0), (0, 1, 0), (1, 0, 0),
+      (0, 0, 1), (0, 2, 1), (2, 0, 1)], 7.0 / 6.0),
+    # Wedge stretched along y only, whose cross section at height z is a
+    # right triangle of area (1 + 2 * z) / 2: the integral of it from 0 to 1.
+    ("stretched wedge", VTK_WEDGE,
+     [(0, 0, 0), (0, 1, 0), (1, 0, 0),
+      (0, 0, 1), (0, 3, 1), (1, 0, 1)], 1.0),
+    # Pyramid over a trapezoid of area 3 / 2, with a slanted apex:
+    # 3 / 2 * h / 3.
+    ("trapezoid pyramid", VTK_PYRAMID,
+     [(0, 0, 0), (2, 0, 0), (1, 1, 0), (0, 1, 0), (0.3, 0.2, 2)], 1.0),
+]
+for name, cellType, coordinates, volume in cells:
+    integVal = util.IntegrateCell(MakeCell(cellType, coordinates), 0)
+    if abs(integVal - volume) > 1e-12 * volume:
+        print("ERROR: incorrect result for the %s: %.17g instead of %.17g" %
+              (name, integVal, volume))
+        sys.exit(1)
@@ -0,0 +1,74 @@
+from paraview.simple import *
+from paraview import smtesting
+from os.path import join
+import os, shutil
+
+# Tests that the collective mode of the parallel legacy VTK writers produces a
+# single VTK XML file that reads back the same data.
+
+def Barrier():
+    # ensure all ranks wait till root has created the directory to write into.
+    pm = servermanager.vtkProcessModule.GetProcessModule()
+    if pm.GetSymmetricMPIMode():
+        pm.GetGlobalController().Barrier()
+
+def InitializeDir(rootdir, create=True):
+    pm = servermanager.vtkProcessModule.GetProcessModule()
+    if pm.GetPartitionId() == 0:
+        shutil.rmtree(rootdir, ignore_errors=True)
+        if create:
+            os.makedirs(rootdir)
+    Barrier()
+
+
+smtesting.ProcessCommandLineArguments()
+
+pm = servermanager.vtkProcessModule.GetProcessModule()
+# separate dirs to avoid failures in parallel test runs
+if pm.GetSymmetricMPIMode():
+    rootdir = join(smtesting.TempDir, "parallelserialwritercollectiveio-sym")
+else:
+    rootdir = join(smtesting.TempDir, "parallelserialwritercollectiveio")
+InitializeDir(rootdir)
+
+def Compare(source, fname):
+    reader = OpenDataFile(fname)
+    reader.UpdatePipeline()
+    expected = source.GetDataInformation()
+    actual = reader.GetDataInformation()
+    assert actual.GetNumberOfPoints() == expected.GetNumberOfPoints(), \
+        "%s: %d points instead of %d" % (fname, actual.GetNumberOfPoints(),
+                                         expected.GetNumberOfPoints())
+    assert actual.GetNumberOfCells() == expected.GetNumberOfCells(), \
+        "%s: %d cells instead of %d" % (fname, actual.GetNumberOfCells(),
+                                        expected.GetNumberOfCells())
+    for a, e in zip(actual.GetBounds(), expected.GetBounds()):
+        assert abs(a - e) < 1e-6, "%s: bounds mismatch" % fname
+    Delete(reader)
+
+sphere = Sphere()
+sphere.PhiResolution = 80
+sphere.ThetaResolution = 80
+sphere.UpdatePipeline()
+
+grid = Tetrahedralize(Input=Wavelet())
+grid.UpdatePipeline()
+
+for ioRanks in (1, 3):
+    for source, proxyname, ext in ((sphere, "PDataSetWriterPolyData", "vtp"),
+                                   (grid, "PDataSetWriterUnstructuredGrid", "vtu")):
+        fname = join(rootdir, "%s-%d.vtk" % (proxyname, ioRanks))
+        writer = getattr(servermanager.writers, proxyname)(Input=source, FileName=fname)
+        writer.CollectiveIO = 1
+        writer.NumberOfIORanks = ioRanks
+        writer.UpdatePipeline()
+        del writer
+        Barrier()
+
+        # the extension is replaced and no file is written per IO rank.
+        assert not os.path.exists(fname)
+        assert not os.path.exists(join(rootdir, "%s-%d-0.vtk" % (proxyname, ioRanks)))
+        Compare(source, join(rootdir, "%s-%d.%s" % (proxyname, ioRanks, ext)))
+
+# remove dirs on success
+InitializeDir(rootdir, create=False)
@@ -0,0 +1,72 @@
+# This test verifies that the tree-based reduction of mergeable information
+# objects gives the same result as gathering every rank's information on the
+# root, for several fan-outs. It's designed to run on 5 ranks so that the
+# trees are not complete. Ranks 2 and 3, which receive the results of other
+# ranks with fan-outs 2 and 3, have no local data in one of the cases.
+
+from paraview.simple import *
+from paraview import servermanager
+from paraview import smtesting
+from paraview.modules.vtkRemotingCore import vtkPVDataInformation, vtkPVDataSizeInformation
+
+pm = servermanager.vtkProcessModule.GetProcessModule()
+if pm.GetNumberOfLocalPartitions() != 5:
+    raise smtesting.TestError("Test must be run on 5 ranks!")
+if pm.GetSymmetricMPIMode():
+    raise smtesting.TestError("Test cannot be run in symmetric mode!")
+
+# A composite dataset whose leaves, arrays and ranges differ across ranks.
+wavelet = ProcessIds(Input=Wavelet())
+sphere = ProcessIds(Input=Sphere(ThetaResolution=64, PhiResolution=64))
+group = GroupDatasets(Input=[wavelet, sphere])
+group.UpdatePipeline()
+
+# The group without data on ranks 2 and 3.
+holes = ProgrammableFilter(Input=group, Script="""
+from vtkmodules.vtkParallelCore import vtkMultiProcessController
+if vtkMultiProcessController.GetGlobalController().GetLocalProcessId() not in (2, 3):
+    self.GetOutputDataObject(0).ShallowCopy(self.GetInputDataObject(0, 0))
+""")
+holes.UpdatePipeline()
+
+session = servermanager.ActiveConnection.Session
+core = session.GetSessionCore()
+
+
+def gather(info, proxy, fanOut):
+    core.SetInformationReductionFanOut(fanOut)
+    info.SetPortNumber(0)
+    session.GatherInformation(servermanager.vtkPVSession.DATA_SERVER, info, proxy.GetGlobalID())
+    return info
+
+
+def summary(info):
+    arrays = []
+    for attributes in (info.GetPointDataInformation(), info.GetCellDataInformation()):
+        for i in range(attributes.GetNumberOfArrays()):
+            array = attributes.GetArrayInformation(i)
+            arrays.append((array.GetName(),
+                           tuple(array.GetComponentRange(-1)),
+                           array.GetNumberOfTuples()))
+    return (info.GetNumberOfPoints(), info.GetNumberOfCells(), info.GetNumberOfDataSets(),
+            info.GetMemorySize(), tuple(info.GetBounds()), sorted(arrays))
+
+
+for proxy in (wavelet, group, holes):
+    expected = summary(gather(vtkPVDataInformation(), proxy, 0))
+    for fanOut in (2, 3, 4, 8):
+        actual = summary(gather(vtkPVDataInformation(), proxy, fanOut))
+        if actual != expected:
+            print("expected: ", expected)
+            print("actual:   ", actual)
+            raise smtesting.TestError(
+                "Data information reduced with fan-out %d differs from the gathered one" % fanOut)
+
+    expected = gather(vtkPVDataSizeInformation(), proxy, 0).GetMemorySize()
+    for fanOut in (2, 3, 4, 8):
+        actual = gather(vtkPVDataSizeInformation(), proxy, fanOut).GetMemorySize()
+        if actual != expected:
+            raise smtesting.TestError(
+                "Data size reduced with fan-out %d differs from the gathered one" % fanOut)
+
+core.SetInformationReductionFanOut(2)
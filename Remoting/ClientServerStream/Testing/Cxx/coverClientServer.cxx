@@ -7,6 +7,7 @@
 #include "vtkVariantArray.h"
 
 #include <iostream>
+#include <vector>
 
 static double dblIni[] = { 904., 906., 917. };
 static const char* strIni[] = { "901", "Turbo", "Targa" };
@@ -349,7 +350,105 @@ static bool do_test()
   return true;
 }
 
+// Get the stream data by concatenating its segments.
+static std::vector<unsigned char> get_segments(const vtkClientServerStream& css)
+{
+  std::vector<unsigned char> result;
+  for (int i = 0; i < css.GetNumberOfDataSegments(); ++i)
+  {
+    const unsigned char* data;
+    size_t length;
+    if (css.GetDataSegment(i, &data, &length))
+    {
+      result.insert(result.end(), data, data + length);
+    }
+  }
+  return result;
+}
+
+static std::vector<unsigned char> get_data(const vtkClientServerStream& css)
+{
+  const unsigned char* data;
+  size_t length;
+  css.GetData(&data, &length);
+  return std::vector<unsigned char>(data, data + length);
+}
+
+static bool do_test_references()
+{
+  std::vector<double> values(1000);
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = 0.5 * i;
+  }
+  const int count = static_cast<int>(values.size());
+  int ids[3] = { 4, 8, 15 };
+
+  // The same message with arrays copied or referenced.
+  vtkClientServerStream copied;
+  copied << vtkClientServerStream::Reply << vtkClientServerStream::InsertArray(values.data(), count)
+         << 16 << vtkClientServerStream::InsertArray(ids, 3) << vtkClientServerStream::End;
+  vtkClientServerStream referenced;
+  referenced << vtkClientServerStream::Reply
+             << vtkClientServerStream::InsertArrayReference(values.data(), count) << 16
+             << vtkClientServerStream::InsertArrayReference(ids, 3) << vtkClientServerStream::End;
+
+  if (referenced.GetNumberOfDataSegments() != 5 || get_segments(referenced) != get_data(copied))
+  {
+    std::cerr << "FAILED: Data segments do not match the copied stream." << endl;
+    return false;
+  }
+
+  // Referenced elements are read in place.
+  const double* pointer = nullptr;
+  vtkTypeUInt32 length = 0;
+  if (!referenced.GetArgumentPointer(0, 0, &pointer, &length) || pointer != values.data() ||
+    length != values.size())
+  {
+    std::cerr << "FAILED: GetArgumentPointer did not return the referenced array." << endl;
+    return false;
+  }
+  std::vector<float> converted(values.size());
+  int value = 0;
+  int outIds[3] = { 0, 0, 0 };
+  if (!referenced.GetArgument(0, 0, converted.data(), length) || converted[999] != 499.5f ||
+    !referenced.GetArgument(0, 1, &value) || value != 16 ||
+    !referenced.GetArgument(0, 2, outIds, 3) || outIds[2] != 15)
+  {
+    std::cerr << "FAILED: Referenced arguments could not be retrieved." << endl;
+    return false;
+  }
+
+  // Appending by reference keeps pointing at the same elements.
+  vtkClientServerStream view;
+  view << vtkClientServerStream::Reply;
+  for (int a = 0; a < copied.GetNumberOfArguments(0); ++a)
+  {
+    view.AppendArgumentReference(copied, 0, a);
+  }
+  view << vtkClientServerStream::End;
+  if (get_segments(view) != get_data(copied))
+  {
+    std::cerr << "FAILED: AppendArgumentReference did not append the arguments." << endl;
+    return false;
+  }
+
+  // Copies do not depend on the referenced arrays.
+  vtkClientServerStream copy(referenced);
+  if (copy.GetNumberOfDataSegments() != 1 || get_data(copy) != get_data(copied))
+  {
+    std::cerr << "FAILED: Copy constructor did not copy referenced arrays." << endl;
+    return false;
+  }
+  if (get_data(referenced) != get_data(copied) || referenced.GetNumberOfDataSegments() != 1)
+  {
+    std::cerr << "FAILED: GetData did not copy referenced arrays." << endl;
+    return false;
+  }
+  return true;
+}
+
 extern int coverClientServer(int, char*[])
 {
-  return do_test() ? 0 : 1;
+  return (do_test() && do_test_references()) ? 0 : 1;
 }
@@ -10,9 +10,14 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 
+#include <algorithm>
+#include <cstring>
 #include <map>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 vtkStandardNewMacro(vtkClientServerInterpreter);
@@ -58,12 +63,40 @@ public:
   };
   typedef FunctionWithContext<vtkClientServerNewInstanceFunction> NewInstanceFunction;
   typedef FunctionWithContext<vtkClientServerCommandFunction> CommandFunction;
-  typedef std::map<std::string, const NewInstanceFunction*> NewInstanceFunctionsType;
-  typedef std::map<std::string, const CommandFunction*> ClassToFunctionMapType;
+  typedef std::unordered_map<std::string, const NewInstanceFunction*> NewInstanceFunctionsType;
+  typedef std::unordered_map<std::string, const CommandFunction*> ClassToFunctionMapType;
   typedef std::map<vtkTypeUInt32, vtkClientServerStream*> IDToMessageMapType;
+  // Command functions, or nullptr, keyed by class name. The keys refer to the
+  // strings of InternedClassNames, so looking a name up neither allocates nor
+  // depends on the address of the name. Cleared when a command function is
+  // added.
+  typedef std::unordered_map<std::string_view, const CommandFunction*> CommandFunctionCacheType;
   NewInstanceFunctionsType NewInstanceFunctions;
   ClassToFunctionMapType ClassToFunctionMap;
   IDToMessageMapType IDToMessageMap;
+  CommandFunctionCacheType CommandFunctionCache;
+  std::unordered_set<std::string> InternedClassNames;
+
+  const CommandFunction* FindCachedCommandFunction(const char* cname)
+  {
+    CommandFunctionCacheType::const_iterator cached = this->CommandFunctionCache.find(cname);
+    if (cached != this->CommandFunctionCache.end())
+    {
+      return cached->second;
+    }
+    const std::string& name = *this->InternedClassNames.insert(cname).first;
+    ClassToFunctionMapType::const_iterator f = this->ClassToFunctionMap.find(name);
+    const CommandFunction* function = f != this->ClassToFunctionMap.end() ? f->second : nullptr;
+    this->CommandFunctionCache.emplace(name, function);
+    return function;
+  }
+
+  static int Call(const CommandFunction* n, vtkClientServerInterpreter* self, vtkObjectBase* ptr,
+    const char* method, const vtkClientServerStream& msg, vtkClientServerStream& result)
+  {
+    void* ctx = n->Context ? n->Context->Context : nullptr;
+    return n->Function(self, ptr, method, msg, result, ctx);
+  }
 };
 
 //----------------------------------------------------------------------------
@@ -407,10 +440,12 @@ int vtkClientServerInterpreter::ProcessCommandInvoke(const vtkClientServerStream
     }
 
     // Find the command function for this object's type.
-    if (obj && this->HasCommandFunction(obj->GetClassName()))
+    const vtkClientServerInterpreterInternals::CommandFunction* function =
+      obj ? this->Internal->FindCachedCommandFunction(obj->GetClassName()) : nullptr;
+    if (function)
     {
-      if (this->CallCommandFunction(
-            obj->GetClassName(), obj, method, msg, *this->LastResultMessage))
+      if (vtkClientServerInterpreterInternals::Call(
+            function, this, obj, method, msg, *this->LastResultMessage))
       {
         return 1;
       }
@@ -590,11 +625,26 @@ int vtkClientServerInterpreter::ExpandMessage(
   // Copy the command.
   out << in.GetCommand(inIndex);
 
-  // Just copy the first arguments.
+  // Arguments of the input message are appended by reference so that
+  // large arrays are not copied: the expanded message is only used
+  // while the input message is being processed.  The last result is
+  // reset before that, so its arguments must be copied.
+  auto appendArgument = [&](int argument) {
+    if (&in != this->LastResultMessage)
+    {
+      out.AppendArgumentReference(in, inIndex, argument);
+    }
+    else
+    {
+      out << in.GetArgument(inIndex, argument);
+    }
+  };
+
+  // Just reference the first arguments.
   int a;
   for (a = 0; a < startArgument && a < in.GetNumberOfArguments(inIndex); ++a)
   {
-    out << in.GetArgument(inIndex, a);
+    appendArgument(a);
   }
 
   // Expand id_value for remaining arguments.
@@ -615,7 +665,7 @@ int vtkClientServerInterpreter::ExpandMessage(
       }
       else
       {
-        out << in.GetArgument(inIndex, a);
+        appendArgument(a);
       }
     }
     else if (in.GetArgumentType(inIndex, a) == vtkClientServerStream::LastResult)
@@ -647,8 +697,8 @@ int vtkClientServerInterpreter::ExpandMessage(
     }
     else
     {
-      // Just copy the argument.
-      out << in.GetArgument(inIndex, a);
+      // Just reference the argument.
+      appendArgument(a);
     }
   }
 
@@ -766,6 +816,30 @@ void vtkClientServerInterpreter::AddCommandFunction(const char* cname,
 
   this->Internal->ClassToFunctionMap[cname] =
     new vtkClientServerInterpreterInternals::CommandFunction(func, context);
+  this->Internal->CommandFunctionCache.clear();
+}
+
+//----------------------------------------------------------------------------
+int vtkClientServerInterpreter::FindMethod(const MethodEntry* methods, int numberOfMethods,
+  const char* method, int numberOfArguments)
+{
+  if (!methods || !method || numberOfMethods <= 0)
+  {
+    return -1;
+  }
+  const MethodEntry* end = methods + numberOfMethods;
+  const MethodEntry* entry = std::lower_bound(methods, end, method,
+    [numberOfArguments](const MethodEntry& candidate, const char* name)
+    {
+      const int cmp = strcmp(candidate.Name, name);
+      return cmp < 0 || (cmp == 0 && candidate.NumberOfArguments < numberOfArguments);
+    });
+  if (entry == end || entry->NumberOfArguments != numberOfArguments ||
+    strcmp(entry->Name, method) != 0)
+  {
+    return -1;
+  }
+  return static_cast<int>(entry - methods);
 }
 
 //----------------------------------------------------------------------------
@@ -793,9 +867,17 @@ int vtkClientServerInterpreter::CallCommandFunction(const char* cname, vtkObject
 
   const vtkClientServerInterpreterInternals::CommandFunction* n = f->second;
 
-  vtkClientServerCommandFunction function = n->Function;
-  void* ctx = n->Context ? n->Context->Context : nullptr;
-  return function(this, ptr, method, msg, result, ctx);
+  return vtkClientServerInterpreterInternals::Call(n, this, ptr, method, msg, result);
+}
+
+//----------------------------------------------------------------------------
+int vtkClientServerInterpreter::CallSuperclassCommandFunction(const char* cname,
+  vtkObjectBase* ptr, const char* method, const vtkClientServerStream& msg,
+  vtkClientServerStream& result)
+{
+  const vtkClientServerInterpreterInternals::CommandFunction* n =
+    cname ? this->Internal->FindCachedCommandFunction(cname) : nullptr;
+  return n ? vtkClientServerInterpreterInternals::Call(n, this, ptr, method, msg, result) : 0;
 }
 
 void vtkClientServerInterpreter::AddNewInstanceFunction(const char* name,
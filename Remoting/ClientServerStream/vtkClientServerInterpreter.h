@@ -123,6 +123,27 @@ public:
    */
   int NewObserver(vtkObject* obj, const char* event, const vtkClientServerStream& css);
 
+  /**
+   * An entry of the method table of a generated command function. The table
+   * is sorted by Name, then NumberOfArguments (including the object and the
+   * method name), and Index identifies the overload in the command function.
+   */
+  struct MethodEntry
+  {
+    const char* Name;
+    int NumberOfArguments;
+    int Index;
+  };
+
+  /**
+   * Called by generated code to find, with a binary search, the first entry
+   * of the sorted table `methods` matching `method` and `numberOfArguments`.
+   * Returns its position in the table, or -1 if there is none. Do not call
+   * directly.
+   */
+  static int FindMethod(const MethodEntry* methods, int numberOfMethods, const char* method,
+    int numberOfArguments);
+
   /**
    * Add a command function for a class.
    */
@@ -140,6 +161,14 @@ public:
   int CallCommandFunction(const char* classname, vtkObjectBase* ptr, const char* method,
     const vtkClientServerStream& msg, vtkClientServerStream& result);
 
+  /**
+   * Called by generated code to call the command function of a superclass,
+   * if there is one. Returns 0 if there is none or if it failed. The lookup
+   * is cached by class name. Do not call directly.
+   */
+  int CallSuperclassCommandFunction(const char* cname, vtkObjectBase* ptr, const char* method,
+    const vtkClientServerStream& msg, vtkClientServerStream& result);
+
   /**
    * Add a function used to create new objects.
    */
@@ -16,6 +16,7 @@
 #include <vtkVariantArray.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -128,11 +129,14 @@ public:
     : Data(r.Data)
     , ValueOffsets(r.ValueOffsets)
     , MessageIndexes(r.MessageIndexes)
+    , External(r.External)
     , Objects(r.Objects, owner)
     , StartIndex(r.StartIndex)
     , Invalid(r.Invalid)
     , String(r.String)
   {
+    // Copies never depend on the buffers referenced by the original.
+    this->CopyExternal();
   }
 
   // Actual binary data in the stream.
@@ -148,6 +152,84 @@ public:
   typedef std::vector<ValueOffsetsType::size_type> MessageIndexesType;
   MessageIndexesType MessageIndexes;
 
+  // Elements of arrays inserted by reference.  They are not stored in
+  // Data but logically located at Offset in it, right after the type and
+  // length of their array.  Blocks are sorted by Offset.
+  struct ExternalBlock
+  {
+    DataType::size_type Offset;
+    const unsigned char* Data;
+    size_t Size;
+  };
+  typedef std::vector<ExternalBlock> ExternalType;
+  ExternalType External;
+
+  // Find the external block located at the given offset in Data, if any.
+  const ExternalBlock* FindExternal(DataType::size_type offset) const
+  {
+    auto block = std::lower_bound(this->External.begin(), this->External.end(), offset,
+      [](const ExternalBlock& b, DataType::size_type o) { return b.Offset < o; });
+    return (block != this->External.end() && block->Offset == offset) ? &*block : nullptr;
+  }
+
+  // Get the elements of the array whose length is stored at the given
+  // location in Data.
+  const unsigned char* GetArrayElements(const unsigned char* length) const
+  {
+    const unsigned char* elements = length + sizeof(vtkTypeUInt32);
+    if (!this->External.empty())
+    {
+      if (const ExternalBlock* block =
+            this->FindExternal(static_cast<DataType::size_type>(elements - this->Data.data())))
+      {
+        return block->Data;
+      }
+    }
+    return elements;
+  }
+
+  // Copy the elements of all arrays inserted by reference into Data.
+  void CopyExternal()
+  {
+    if (this->External.empty())
+    {
+      return;
+    }
+
+    size_t total = this->Data.size();
+    for (const ExternalBlock& block : this->External)
+    {
+      total += block.Size;
+    }
+    DataType data;
+    data.reserve(total);
+    DataType::size_type start = 0;
+    for (const ExternalBlock& block : this->External)
+    {
+      data.insert(data.end(), this->Data.begin() + start, this->Data.begin() + block.Offset);
+      data.insert(data.end(), block.Data, block.Data + block.Size);
+      start = block.Offset;
+    }
+    data.insert(data.end(), this->Data.begin() + start, this->Data.end());
+
+    // Values located after a block move by the size of that block.
+    DataType::difference_type shift = 0;
+    ExternalType::const_iterator block = this->External.begin();
+    for (DataType::difference_type& offset : this->ValueOffsets)
+    {
+      for (; block != this->External.end() &&
+           static_cast<DataType::difference_type>(block->Offset) <= offset;
+           ++block)
+      {
+        shift += static_cast<DataType::difference_type>(block->Size);
+      }
+      offset += shift;
+    }
+
+    this->Data.swap(data);
+    this->External.clear();
+  }
+
   // Hold references to vtkObjectBase instances stored in the stream.
   // The object that owns this stream is passed as the argument to
   // Register/UnRegister for objects stored in the stream because the
@@ -233,6 +315,11 @@ public:
   {
     return css.GetValue(message, value);
   }
+  static const unsigned char* GetArrayElements(
+    const vtkClientServerStream& css, const unsigned char* length)
+  {
+    return css.Internal->GetArrayElements(length);
+  }
 };
 
 const vtkClientServerStreamInternals::ValueOffsetsType::size_type
@@ -265,6 +352,7 @@ vtkClientServerStream::vtkClientServerStream(const vtkClientServerStream& r, vtk
 vtkClientServerStream& vtkClientServerStream::operator=(const vtkClientServerStream& that)
 {
   *this->Internal = *that.Internal;
+  this->Internal->CopyExternal();
   return *this;
 }
 
@@ -310,6 +398,7 @@ void vtkClientServerStream::Reset()
     this->Internal->ValueOffsets.begin(), this->Internal->ValueOffsets.end());
   this->Internal->MessageIndexes.erase(
     this->Internal->MessageIndexes.begin(), this->Internal->MessageIndexes.end());
+  this->Internal->External.clear();
   this->Internal->Objects.Clear();
 
   // No message has yet been started.
@@ -422,6 +511,62 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
   return *this;
 }
 
+//----------------------------------------------------------------------------
+vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::ArrayReference a)
+{
+  // Store the array type and length, then reference the data.
+  *this << a.Type;
+  this->Write(&a.Length, sizeof(a.Length));
+  if (a.Size > 0)
+  {
+    if (!a.Data)
+    {
+      vtkGenericWarningMacro(
+        "vtkClientServerStream::InsertArrayReference given NULL pointer and non-zero length.");
+      this->Internal->Invalid = 1;
+      return *this;
+    }
+    vtkClientServerStreamInternals::ExternalBlock block = { this->Internal->Data.size(),
+      static_cast<const unsigned char*>(a.Data), a.Size };
+    this->Internal->External.push_back(block);
+  }
+  return *this;
+}
+
+//----------------------------------------------------------------------------
+int vtkClientServerStream::AppendArgumentReference(
+  const vtkClientServerStream& source, int message, int argument)
+{
+  const unsigned char* data = source.GetValue(message, 1 + argument);
+  if (!data)
+  {
+    return 0;
+  }
+
+  // Get the type of the value in the source stream.
+  vtkTypeUInt32 tp;
+  memcpy(&tp, data, sizeof(tp));
+  data += sizeof(tp);
+
+  // Only arrays are referenced.  Other values are small enough to copy.
+  size_t elementSize = 0;
+  switch (tp)
+  {
+    VTK_CSS_TEMPLATE_MACRO(array, elementSize = sizeof(*T));
+    default:
+      *this << source.GetArgument(message, argument);
+      return 1;
+  }
+
+  vtkTypeUInt32 length;
+  memcpy(&length, data, sizeof(length));
+  vtkClientServerStream::ArrayReference a = { static_cast<vtkClientServerStream::Types>(tp),
+    length, static_cast<vtkTypeUInt32>(length * elementSize),
+    vtkClientServerStreamInternals::GetArrayElements(source, data) };
+  *this << a;
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 vtkClientServerStream& vtkClientServerStream::operator<<(const vtkClientServerStream& css)
 {
@@ -641,6 +786,43 @@ VTK_CLIENT_SERVER_INSERT_ARRAY(float)
 VTK_CLIENT_SERVER_INSERT_ARRAY(double)
 #undef VTK_CLIENT_SERVER_INSERT_ARRAY
 
+//----------------------------------------------------------------------------
+// Template and macro to implement all InsertArrayReference methods in the same way.
+namespace
+{
+template <class T>
+vtkClientServerStream::ArrayReference vtkClientServerStreamInsertArrayReference(
+  const T* data, int length)
+{
+  // Construct and return the array information structure.
+  typedef typename vtkTypeTraits<T>::SizedType Type;
+  vtkClientServerStream::ArrayReference a = { vtkClientServerTypeTraits<Type>::Array(),
+    static_cast<vtkTypeUInt32>(length), static_cast<vtkTypeUInt32>(sizeof(Type) * length), data };
+  return a;
+}
+}
+
+#define VTK_CLIENT_SERVER_INSERT_ARRAY_REFERENCE(type)                                             \
+  vtkClientServerStream::ArrayReference vtkClientServerStream::InsertArrayReference(               \
+    const type* data, int length)                                                                  \
+  {                                                                                                \
+    return ::vtkClientServerStreamInsertArrayReference(data, length);                              \
+  }
+VTK_CLIENT_SERVER_INSERT_ARRAY_REFERENCE(char)
+VTK_CLIENT_SERVER_INSERT_ARRAY_REFERENCE(short)
+VTK_CLIENT_SERVER_INSERT_ARRAY_REFERENCE(int)
+VTK_CLIENT_SERVER_INSERT_ARRAY_REFERENCE(long)
+VTK_CLIENT_SERVER_INSERT_ARRAY_REFERENCE(signed char)
+VTK_CLIENT_SERVER_INSERT_ARRAY_REFERENCE(unsigned char)
+VTK_CLIENT_SERVER_INSERT_ARRAY_REFERENCE(unsigned short)
+VTK_CLIENT_SERVER_INSERT_ARRAY_REFERENCE(unsigned int)
+VTK_CLIENT_SERVER_INSERT_ARRAY_REFERENCE(unsigned long)
+VTK_CLIENT_SERVER_INSERT_ARRAY_REFERENCE(long long)
+VTK_CLIENT_SERVER_INSERT_ARRAY_REFERENCE(unsigned long long)
+VTK_CLIENT_SERVER_INSERT_ARRAY_REFERENCE(float)
+VTK_CLIENT_SERVER_INSERT_ARRAY_REFERENCE(double)
+#undef VTK_CLIENT_SERVER_INSERT_ARRAY_REFERENCE
+
 //----------------------------------------------------------------------------
 // Template to implement each type conversion in the lookup tables below.
 // The "long, long, long" arguments are used to convince VS6 to select
@@ -1028,12 +1210,8 @@ namespace
 {
 template <typename SourceType, typename DestType>
 int vtkClientServerStreamGetArgumentArrayCase(
-  const unsigned char* src, DestType* dest, vtkTypeUInt32 length)
+  const unsigned char* src, vtkTypeUInt32 len, DestType* dest, vtkTypeUInt32 length)
 {
-  // Get the length of the value in the stream.
-  vtkTypeUInt32 len;
-  memcpy(&len, src, sizeof(len));
-  src += sizeof(len);
   if (len == length)
   {
     // Copy the value out of the stream.
@@ -1050,7 +1228,8 @@ int vtkClientServerStreamGetArgumentArrayCase(
 #define VTK_CSS_GET_ARGUMENT_ARRAY_CASE(TypeId, SourceType)                                        \
   case vtkClientServerStream::TypeId:                                                              \
   {                                                                                                \
-    return ::vtkClientServerStreamGetArgumentArrayCase<SourceType, T>(data, value, length);        \
+    return ::vtkClientServerStreamGetArgumentArrayCase<SourceType, T>(                             \
+      elements, len, value, length);                                                               \
   }
 
 //----------------------------------------------------------------------------
@@ -1070,19 +1249,20 @@ int vtkClientServerStreamGetArgumentArray(
     memcpy(&tp, data, sizeof(tp));
     data += sizeof(tp);
 
+    // Get the length and the elements of the value in the stream.  The
+    // length is only meaningful for array types, checked below.
+    vtkTypeUInt32 len;
+    memcpy(&len, data, sizeof(len));
+    const unsigned char* elements = vtkClientServerStreamInternals::GetArrayElements(*self, data);
+
     // If the type and length of the array match, use it.
     const auto array_type = vtkClientServerTypeTraits<Type>::Array();
     if (static_cast<vtkClientServerStream::Types>(tp) == array_type)
     {
-      // Get the length of the value in the stream.
-      vtkTypeUInt32 len;
-      memcpy(&len, data, sizeof(len));
-      data += sizeof(len);
-
       if (len == length)
       {
         // Copy the value out of the stream.
-        memcpy(value, data, len * sizeof(Type));
+        memcpy(value, elements, len * sizeof(Type));
         return 1;
       }
     }
@@ -1143,6 +1323,61 @@ VTK_CSS_GET_ARGUMENT_ARRAY(long long)
 VTK_CSS_GET_ARGUMENT_ARRAY(unsigned long long)
 #undef VTK_CSS_GET_ARGUMENT_ARRAY
 
+//----------------------------------------------------------------------------
+// Template and macro to implement GetArgumentPointer methods in the same way.
+namespace
+{
+template <class T>
+int vtkClientServerStreamGetArgumentPointer(
+  const vtkClientServerStream* self, int midx, int argument, const T** value, vtkTypeUInt32* length)
+{
+  typedef typename vtkTypeTraits<T>::SizedType Type;
+  if (const unsigned char* data =
+        vtkClientServerStreamInternals::GetValue(*self, midx, 1 + argument))
+  {
+    // Get the type of the value in the stream.
+    vtkTypeUInt32 tp;
+    memcpy(&tp, data, sizeof(tp));
+    data += sizeof(tp);
+
+    // The elements can only be used in place with the exact same type.
+    if (static_cast<vtkClientServerStream::Types>(tp) == vtkClientServerTypeTraits<Type>::Array())
+    {
+      const unsigned char* elements =
+        vtkClientServerStreamInternals::GetArrayElements(*self, data);
+      if (reinterpret_cast<std::uintptr_t>(elements) % alignof(T) == 0)
+      {
+        memcpy(length, data, sizeof(*length));
+        *value = reinterpret_cast<const T*>(elements);
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+}
+
+#define VTK_CSS_GET_ARGUMENT_POINTER(type)                                                         \
+  int vtkClientServerStream::GetArgumentPointer(                                                   \
+    int message, int argument, const type** value, vtkTypeUInt32* length) const                    \
+  {                                                                                                \
+    return ::vtkClientServerStreamGetArgumentPointer(this, message, argument, value, length);      \
+  }
+VTK_CSS_GET_ARGUMENT_POINTER(signed char)
+VTK_CSS_GET_ARGUMENT_POINTER(char)
+VTK_CSS_GET_ARGUMENT_POINTER(int)
+VTK_CSS_GET_ARGUMENT_POINTER(short)
+VTK_CSS_GET_ARGUMENT_POINTER(long)
+VTK_CSS_GET_ARGUMENT_POINTER(unsigned char)
+VTK_CSS_GET_ARGUMENT_POINTER(unsigned int)
+VTK_CSS_GET_ARGUMENT_POINTER(unsigned short)
+VTK_CSS_GET_ARGUMENT_POINTER(unsigned long)
+VTK_CSS_GET_ARGUMENT_POINTER(float)
+VTK_CSS_GET_ARGUMENT_POINTER(double)
+VTK_CSS_GET_ARGUMENT_POINTER(long long)
+VTK_CSS_GET_ARGUMENT_POINTER(unsigned long long)
+#undef VTK_CSS_GET_ARGUMENT_POINTER
+
 //----------------------------------------------------------------------------
 int vtkClientServerStream::GetArgument(int message, int argument, const char** value) const
 {
@@ -1489,6 +1724,9 @@ int vtkClientServerStream::GetData(const unsigned char** data, size_t* length) c
   // Do not return data unless stream is valid.
   if (!this->Internal->Invalid)
   {
+    // The data must be contiguous.
+    this->Internal->CopyExternal();
+
     if (data)
     {
       *data = &*this->Internal->Data.begin();
@@ -1515,6 +1753,42 @@ int vtkClientServerStream::GetData(const unsigned char** data, size_t* length) c
   }
 }
 
+//----------------------------------------------------------------------------
+int vtkClientServerStream::GetNumberOfDataSegments() const
+{
+  // Data are split around each external block.
+  return this->Internal->Invalid ? 0 : static_cast<int>(2 * this->Internal->External.size() + 1);
+}
+
+//----------------------------------------------------------------------------
+int vtkClientServerStream::GetDataSegment(
+  int segment, const unsigned char** data, size_t* length) const
+{
+  if (segment < 0 || segment >= this->GetNumberOfDataSegments())
+  {
+    return 0;
+  }
+
+  // Odd segments are external blocks, even segments are the parts of
+  // the stream data between them.
+  const vtkClientServerStreamInternals::ExternalType& external = this->Internal->External;
+  const size_t index = static_cast<size_t>(segment / 2);
+  if (segment % 2)
+  {
+    *data = external[index].Data;
+    *length = external[index].Size;
+  }
+  else
+  {
+    const size_t begin = index > 0 ? external[index - 1].Offset : 0;
+    const size_t end =
+      index < external.size() ? external[index].Offset : this->Internal->Data.size();
+    *data = this->Internal->Data.data() + begin;
+    *length = end - begin;
+  }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkClientServerStream::SetData(const unsigned char* data, size_t length)
 {
@@ -1910,6 +2184,18 @@ vtkClientServerStream::Argument vtkClientServerStream::GetArgument(int message,
   // Prepare a return value.
   vtkClientServerStream::Argument result = { nullptr, 0 };
 
+  // An argument must be contiguous to be returned.  Copy referenced
+  // arrays into the stream if this argument is one of them.
+  if (!this->Internal->External.empty())
+  {
+    const unsigned char* data = this->GetValue(message, 1 + argument);
+    if (data && this->Internal->FindExternal(static_cast<size_t>(
+                  data + sizeof(vtkTypeUInt32) * 2 - this->Internal->Data.data())))
+    {
+      this->Internal->CopyExternal();
+    }
+  }
+
   // Get a pointer to the type/value pair in the stream.
   if (const unsigned char* data = this->GetValue(message, 1 + argument))
   {
@@ -177,6 +177,42 @@ public:
   int GetArgument(int message, int argument, vtkObjectBase** value) const;
   ///@}
 
+  ///@{
+  /**
+   * Get a pointer to the elements of an array argument without copying
+   * them.  This only succeeds when the array is stored with exactly the
+   * requested type and its elements are suitably aligned in memory,
+   * otherwise the GetArgument overloads taking a length must be used to
+   * copy and convert the values.  The pointer is invalidated when the
+   * stream is modified.
+   */
+  int GetArgumentPointer(
+    int message, int argument, const signed char** value, vtkTypeUInt32* length) const;
+  int GetArgumentPointer(
+    int message, int argument, const char** value, vtkTypeUInt32* length) const;
+  int GetArgumentPointer(
+    int message, int argument, const short** value, vtkTypeUInt32* length) const;
+  int GetArgumentPointer(int message, int argument, const int** value, vtkTypeUInt32* length) const;
+  int GetArgumentPointer(
+    int message, int argument, const long** value, vtkTypeUInt32* length) const;
+  int GetArgumentPointer(
+    int message, int argument, const unsigned char** value, vtkTypeUInt32* length) const;
+  int GetArgumentPointer(
+    int message, int argument, const unsigned short** value, vtkTypeUInt32* length) const;
+  int GetArgumentPointer(
+    int message, int argument, const unsigned int** value, vtkTypeUInt32* length) const;
+  int GetArgumentPointer(
+    int message, int argument, const unsigned long** value, vtkTypeUInt32* length) const;
+  int GetArgumentPointer(
+    int message, int argument, const float** value, vtkTypeUInt32* length) const;
+  int GetArgumentPointer(
+    int message, int argument, const double** value, vtkTypeUInt32* length) const;
+  int GetArgumentPointer(
+    int message, int argument, const long long** value, vtkTypeUInt32* length) const;
+  int GetArgumentPointer(
+    int message, int argument, const unsigned long long** value, vtkTypeUInt32* length) const;
+  ///@}
+
   /**
    * Get the value of the given argument in the given message.
    * Returns whether the argument could be converted to the requested
@@ -216,7 +252,9 @@ public:
   /**
    * Get the given argument of the given message in a form that can be
    * sent to another stream.  Returns an empty argument if it either
-   * index is out of range.
+   * index is out of range.  If the argument is an array inserted with
+   * InsertArrayReference, the referenced arrays are first copied into
+   * the stream.
    */
   vtkClientServerStream::Argument GetArgument(int message, int argument) const;
 
@@ -224,10 +262,27 @@ public:
    * Get a pointer to the stream data and its length.  The values are
    * suitable for passing to another stream's SetData method, but are
    * invalidated when any further writing to the stream is done.
-   * Returns whether the stream is currently valid.
+   * Returns whether the stream is currently valid.  Arrays inserted
+   * with InsertArrayReference are copied into the stream by this call;
+   * use GetNumberOfDataSegments/GetDataSegment to avoid that copy.
    */
   int GetData(const unsigned char** data, size_t* length) const;
 
+  ///@{
+  /**
+   * Get the stream data as a sequence of contiguous segments.  The
+   * concatenation of all segments is the data returned by GetData, but
+   * the elements of arrays inserted with InsertArrayReference are
+   * returned in place as segments of their own, so that the stream can
+   * be sent without copying them.  Segments may be empty.  The values
+   * are invalidated when any further writing to the stream is done.
+   * GetNumberOfDataSegments returns 0 and GetDataSegment returns 0 when
+   * the stream is invalid.
+   */
+  int GetNumberOfDataSegments() const;
+  int GetDataSegment(int segment, const unsigned char** data, size_t* length) const;
+  ///@}
+
   //--------------------------------------------------------------------------
   // Stream writing methods:
 
@@ -245,6 +300,20 @@ public:
   };
   ///@}
 
+  ///@{
+  /**
+   * Proxy-object returned by InsertArrayReference and used to insert
+   * array data into the stream without copying it.
+   */
+  struct ArrayReference
+  {
+    Types Type;
+    vtkTypeUInt32 Length;
+    vtkTypeUInt32 Size;
+    const void* Data;
+  };
+  ///@}
+
   ///@{
   /**
    * Stream operators for special types.
@@ -253,6 +322,7 @@ public:
   vtkClientServerStream& operator<<(vtkClientServerStream::Types);
   vtkClientServerStream& operator<<(vtkClientServerStream::Argument);
   vtkClientServerStream& operator<<(vtkClientServerStream::Array);
+  vtkClientServerStream& operator<<(vtkClientServerStream::ArrayReference);
   vtkClientServerStream& operator<<(const vtkClientServerStream&);
   vtkClientServerStream& operator<<(vtkClientServerID);
   vtkClientServerStream& operator<<(vtkObjectBase*);
@@ -300,6 +370,42 @@ public:
   static vtkClientServerStream::Array InsertArray(const double*, int);
   ///@}
 
+  ///@{
+  /**
+   * Allow arrays to be passed into the stream by reference.  The
+   * elements are not copied into the stream: they are read in place
+   * when the stream is processed and sent as separate data segments.
+   * The array must therefore remain valid and unchanged as long as the
+   * stream, or any stream it is appended to through
+   * AppendArgumentReference, is used.  Copying the stream or calling
+   * GetData copies the elements into the stream.
+   */
+  static vtkClientServerStream::ArrayReference InsertArrayReference(const char*, int);
+  static vtkClientServerStream::ArrayReference InsertArrayReference(const short*, int);
+  static vtkClientServerStream::ArrayReference InsertArrayReference(const int*, int);
+  static vtkClientServerStream::ArrayReference InsertArrayReference(const long*, int);
+  static vtkClientServerStream::ArrayReference InsertArrayReference(const signed char*, int);
+  static vtkClientServerStream::ArrayReference InsertArrayReference(const unsigned char*, int);
+  static vtkClientServerStream::ArrayReference InsertArrayReference(const unsigned short*, int);
+  static vtkClientServerStream::ArrayReference InsertArrayReference(const unsigned int*, int);
+  static vtkClientServerStream::ArrayReference InsertArrayReference(const unsigned long*, int);
+  static vtkClientServerStream::ArrayReference InsertArrayReference(const long long*, int);
+  static vtkClientServerStream::ArrayReference InsertArrayReference(
+    const unsigned long long*, int);
+  static vtkClientServerStream::ArrayReference InsertArrayReference(const float*, int);
+  static vtkClientServerStream::ArrayReference InsertArrayReference(const double*, int);
+  ///@}
+
+  /**
+   * Append the given argument of a message in another stream to the
+   * message being constructed.  Array arguments are appended by
+   * reference to the elements stored in the source stream, which must
+   * therefore outlive this stream and remain unchanged while it is
+   * used.  Other arguments are copied.  Returns 0 if either index is
+   * out of range.
+   */
+  int AppendArgumentReference(const vtkClientServerStream& source, int message, int argument);
+
   /**
    * Construct the entire stream from the given data.  This destroys
    * any data already in the stream.  Returns whether the stream is
@@ -464,7 +570,8 @@ class vtkClientServerStreamDataArg
 {
 public:
   // Constructor checks the argument type and length, allocates
-  // memory, and extracts the data from the message.
+  // memory, and extracts the data from the message.  The data are
+  // always copied because the wrapped method may modify them.
   vtkClientServerStreamDataArg(const vtkClientServerStream& msg, int message, int argument)
     : Data(nullptr)
   {
@@ -499,6 +606,60 @@ public:
 private:
   T* Data;
 };
+
+// Extract the given argument of the given message as a const data
+// array.  The wrapped method cannot modify the data, so when the
+// message stores the array with the requested type, the data are used
+// in place instead of being copied.  The generator uses this
+// specialization only for const T* parameters.
+template <class T>
+class vtkClientServerStreamDataArg<const T>
+{
+public:
+  vtkClientServerStreamDataArg(const vtkClientServerStream& msg, int message, int argument)
+    : Data(nullptr)
+    , Copy(nullptr)
+  {
+    vtkTypeUInt32 length = 0;
+    if (msg.GetArgumentPointer(message, argument, &this->Data, &length))
+    {
+      if (length == 0)
+      {
+        this->Data = nullptr;
+      }
+      return;
+    }
+
+    // Copy the data as for non-const arrays.
+    this->Data = nullptr;
+    if (msg.GetArgumentLength(message, argument, &length) && length > 0)
+    {
+      try
+      {
+        this->Copy = new T[length];
+      }
+      catch (...)
+      {
+      }
+    }
+    if (this->Copy && !msg.GetArgument(message, argument, this->Copy, length))
+    {
+      delete[] this->Copy;
+      this->Copy = nullptr;
+    }
+    this->Data = this->Copy;
+  }
+
+  // Destructor frees the copied data, if any.
+  ~vtkClientServerStreamDataArg() { delete[] this->Copy; }
+
+  // Allow this object to be passed as if it were a pointer.
+  operator const T*() { return this->Data; }
+
+private:
+  const T* Data;
+  T* Copy;
+};
 #endif
 
 #endif
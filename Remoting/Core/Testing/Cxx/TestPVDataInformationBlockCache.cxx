@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDoubleArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVArrayInformation.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <iostream>
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> GetPolyData(double center)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(center, 0, 0);
+  sphere->Update();
+
+  vtkSmartPointer<vtkPolyData> pd = sphere->GetOutput();
+  vtkNew<vtkDoubleArray> array;
+  array->SetName("values");
+  array->SetNumberOfTuples(pd->GetNumberOfPoints());
+  array->FillComponent(0, center);
+  pd->GetPointData()->AddArray(array);
+  return pd;
+}
+
+bool Compare(vtkPVDataInformation* cached, vtkPVDataInformation* reference)
+{
+  double cbds[6], rbds[6];
+  cached->GetBounds(cbds);
+  reference->GetBounds(rbds);
+  for (int cc = 0; cc < 6; ++cc)
+  {
+    if (cbds[cc] != rbds[cc])
+    {
+      std::cerr << "ERROR: bounds mismatch." << endl;
+      return false;
+    }
+  }
+  if (cached->GetNumberOfPoints() != reference->GetNumberOfPoints() ||
+    cached->GetNumberOfCells() != reference->GetNumberOfCells() ||
+    cached->GetNumberOfDataSets() != reference->GetNumberOfDataSets() ||
+    cached->GetMemorySize() != reference->GetMemorySize())
+  {
+    std::cerr << "ERROR: counts mismatch." << endl;
+    return false;
+  }
+  auto carray = cached->GetArrayInformation("values", vtkDataObject::POINT);
+  auto rarray = reference->GetArrayInformation("values", vtkDataObject::POINT);
+  if (!carray || !rarray)
+  {
+    std::cerr << "ERROR: missing `values` array." << endl;
+    return false;
+  }
+  double crange[2], rrange[2];
+  carray->GetComponentRange(0, crange);
+  rarray->GetComponentRange(0, rrange);
+  if (crange[0] != rrange[0] || crange[1] != rrange[1])
+  {
+    std::cerr << "ERROR: range mismatch (" << crange[0] << ", " << crange[1] << ") != ("
+              << rrange[0] << ", " << rrange[1] << ")." << endl;
+    return false;
+  }
+  return true;
+}
+
+bool Gather(vtkMultiBlockDataSet* mb, vtkIdType expectedReused, vtkIdType expectedRescanned)
+{
+  vtkNew<vtkPVDataInformation> cached;
+  cached->CopyFromObject(mb);
+  if (cached->GetNumberOfReusedBlocks() != expectedReused ||
+    cached->GetNumberOfRescannedBlocks() != expectedRescanned)
+  {
+    std::cerr << "ERROR: expected " << expectedReused << " reused and " << expectedRescanned
+              << " rescanned block(s), got " << cached->GetNumberOfReusedBlocks() << " and "
+              << cached->GetNumberOfRescannedBlocks() << "." << endl;
+    return false;
+  }
+
+  // a deep copy has new blocks, which are always scanned.
+  vtkNew<vtkMultiBlockDataSet> copy;
+  copy->DeepCopy(mb);
+  vtkNew<vtkPVDataInformation> reference;
+  reference->CopyFromObject(copy);
+  if (reference->GetNumberOfReusedBlocks() != 0)
+  {
+    std::cerr << "ERROR: new blocks must not be reused." << endl;
+    return false;
+  }
+
+  return Compare(cached, reference);
+}
+}
+
+extern int TestPVDataInformationBlockCache(int, char*[])
+{
+  vtkNew<vtkMultiBlockDataSet> mb;
+  for (unsigned int cc = 0; cc < 4; ++cc)
+  {
+    mb->SetBlock(cc, GetPolyData(static_cast<double>(cc)));
+  }
+
+  // populate the cache; every block is scanned.
+  vtkPVDataInformation::SetBlockCacheEnabled(true);
+  vtkNew<vtkPVDataInformation> info;
+  info->CopyFromObject(mb);
+  if (info->GetNumberOfRescannedBlocks() != 4 || info->GetNumberOfReusedBlocks() != 0)
+  {
+    std::cerr << "ERROR: all blocks must be scanned on the first gather." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // nothing changed; all blocks must be reused.
+  if (!Gather(mb, 4, 0))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // modify an array in one block; the block must be rescanned.
+  auto block = vtkPolyData::SafeDownCast(mb->GetBlock(2));
+  auto array = vtkDoubleArray::SafeDownCast(block->GetPointData()->GetArray("values"));
+  array->SetValue(0, 100.0);
+  array->Modified();
+  if (!Gather(mb, 3, 1))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // replace a block; the new block must be scanned.
+  mb->SetBlock(1, GetPolyData(10.0));
+  if (!Gather(mb, 3, 1))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // the cache is bounded; least recently used blocks are evicted first.
+  info->CopyFromObject(mb);
+  vtkPVDataInformation::SetBlockCacheSize(2);
+  if (vtkPVDataInformation::GetNumberOfCachedBlocks() != 2)
+  {
+    std::cerr << "ERROR: cache must be shrunk to its maximum size." << endl;
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkPVDataInformation> bounded;
+  bounded->CopyFromObject(mb->GetBlock(3));
+  if (bounded->GetNumberOfReusedBlocks() != 1)
+  {
+    std::cerr << "ERROR: most recently used block must remain cached." << endl;
+    return EXIT_FAILURE;
+  }
+  bounded->CopyFromObject(mb->GetBlock(0));
+  if (bounded->GetNumberOfRescannedBlocks() != 1)
+  {
+    std::cerr << "ERROR: least recently used block must be evicted." << endl;
+    return EXIT_FAILURE;
+  }
+  vtkPVDataInformation::SetBlockCacheSize(4096);
+
+  // disabling the cache clears it.
+  vtkPVDataInformation::SetBlockCacheEnabled(false);
+  if (vtkPVDataInformation::GetNumberOfCachedBlocks() != 0)
+  {
+    std::cerr << "ERROR: cache must be cleared when disabled." << endl;
+    return EXIT_FAILURE;
+  }
+  vtkPVDataInformation::SetBlockCacheEnabled(true);
+
+  return EXIT_SUCCESS;
+}
@@ -37,19 +37,186 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUniformGridAMR.h"
+#include "vtkWeakPointer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <mutex>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+namespace
+{
+/**
+ * Process-wide cache of per-block data information. Entries are keyed by the
+ * block's address, its MTime (which includes the MTime of its attribute arrays
+ * and points) and the InspectCells flag, and hold a weak reference to the
+ * block to detect address reuse. Cached information is kept in its serialized
+ * form so that the cache does not hold on to any VTK objects. The cache is
+ * bounded: the least recently used entries are evicted first. All accesses are
+ * guarded by a mutex since information may be gathered from several threads.
+ */
+class vtkPVDataInformationBlockCache
+{
+  struct Key
+  {
+    vtkDataObject* Address;
+    vtkMTimeType MTime;
+    bool InspectCells;
+
+    bool operator==(const Key& other) const
+    {
+      return this->Address == other.Address && this->MTime == other.MTime &&
+        this->InspectCells == other.InspectCells;
+    }
+  };
+
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const
+    {
+      std::size_t hash = std::hash<vtkDataObject*>{}(key.Address);
+      hash ^= std::hash<vtkMTimeType>{}(key.MTime) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      return hash ^ static_cast<std::size_t>(key.InspectCells);
+    }
+  };
+
+  struct Entry
+  {
+    Key EntryKey;
+    vtkWeakPointer<vtkDataObject> DataObject;
+    vtkClientServerStream Stream;
+  };
+
+  // Most recently used entries first.
+  std::list<Entry> Entries;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> Index;
+  std::size_t MaximumSize = 4096;
+  std::mutex Mutex;
+
+  void Erase(std::list<Entry>::iterator iter)
+  {
+    this->Index.erase(iter->EntryKey);
+    this->Entries.erase(iter);
+  }
+
+  void Shrink()
+  {
+    while (this->Entries.size() > this->MaximumSize)
+    {
+      this->Erase(std::prev(this->Entries.end()));
+    }
+  }
+
+public:
+  static vtkPVDataInformationBlockCache& GetInstance()
+  {
+    static vtkPVDataInformationBlockCache instance;
+    return instance;
+  }
+
+  bool Find(vtkDataObject* dobj, bool inspectCells, vtkPVDataInformation* info)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto iter = this->Index.find(Key{ dobj, dobj->GetMTime(), inspectCells });
+    if (iter == this->Index.end())
+    {
+      return false;
+    }
+    auto entry = iter->second;
+    if (entry->DataObject != dobj)
+    {
+      // the block was deleted and another one allocated at the same address.
+      this->Erase(entry);
+      return false;
+    }
+    this->Entries.splice(this->Entries.begin(), this->Entries, entry);
+    info->CopyFromStream(&entry->Stream);
+    return true;
+  }
+
+  void Insert(vtkDataObject* dobj, bool inspectCells, vtkPVDataInformation* info)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    if (this->MaximumSize == 0)
+    {
+      return;
+    }
+    const Key key{ dobj, dobj->GetMTime(), inspectCells };
+    auto iter = this->Index.find(key);
+    if (iter != this->Index.end())
+    {
+      this->Erase(iter->second);
+    }
+    this->Entries.emplace_front();
+    auto& entry = this->Entries.front();
+    entry.EntryKey = key;
+    entry.DataObject = dobj;
+    info->CopyToStream(&entry.Stream);
+    this->Index[key] = this->Entries.begin();
+    this->Shrink();
+  }
+
+  // Drop entries for blocks that have since been deleted.
+  void Prune()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    for (auto iter = this->Entries.begin(); iter != this->Entries.end();)
+    {
+      auto next = std::next(iter);
+      if (iter->DataObject == nullptr)
+      {
+        this->Erase(iter);
+      }
+      iter = next;
+    }
+  }
+
+  void Clear()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Entries.clear();
+    this->Index.clear();
+  }
+
+  void SetMaximumSize(std::size_t size)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->MaximumSize = size;
+    this->Shrink();
+  }
+
+  std::size_t GetMaximumSize()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->MaximumSize;
+  }
+
+  std::size_t GetSize()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->Entries.size();
+  }
+};
+
+std::atomic<bool> BlockCacheEnabled{ true };
+}
+
 class vtkPVDataInformationAccumulator
 {
   vtkNew<vtkPVDataInformation> Current;
 
 public:
   std::set<int> UniqueBlockTypes;
+  vtkIdType NumberOfRescannedBlocks = 0;
+  vtkIdType NumberOfReusedBlocks = 0;
+
   vtkPVDataInformation* operator()(vtkPVDataInformation* info, vtkDataObject* dobj)
   {
     if (!dobj)
@@ -60,7 +227,20 @@ public:
 
     this->Current->Initialize();
     this->Current->SetInspectCells(info->InspectCells);
-    this->Current->CopyFromDataObject(dobj);
+    auto& cache = vtkPVDataInformationBlockCache::GetInstance();
+    if (::BlockCacheEnabled && cache.Find(dobj, info->InspectCells, this->Current))
+    {
+      ++this->NumberOfReusedBlocks;
+    }
+    else
+    {
+      this->Current->CopyFromDataObject(dobj);
+      ++this->NumberOfRescannedBlocks;
+      if (::BlockCacheEnabled)
+      {
+        cache.Insert(dobj, info->InspectCells, this->Current);
+      }
+    }
     if (this->Current->GetDataSetType() != -1)
     {
       assert(this->Current->GetCompositeDataSetType() == -1);
@@ -140,6 +320,7 @@ vtkStandardNewMacro(vtkPVDataInformation);
 vtkPVDataInformation::vtkPVDataInformation()
 {
   this->Initialize();
+  this->SetMergeable(true);
 }
 
 //----------------------------------------------------------------------------
@@ -316,6 +497,8 @@ void vtkPVDataInformation::Initialize()
   this->CompositeDataSetType = -1;
   this->FirstLeafCompositeIndex = 0;
   this->UniqueBlockTypes.clear();
+  this->NumberOfRescannedBlocks = 0;
+  this->NumberOfReusedBlocks = 0;
 
   this->AttributeMetadata.clear();
   auto& attributeType = this->AttributeMetadata[vtkDataObject::FIELD];
@@ -349,6 +532,41 @@ void vtkPVDataInformation::Initialize()
   this->DataAssembly->Initialize();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVDataInformation::SetBlockCacheEnabled(bool enabled)
+{
+  ::BlockCacheEnabled = enabled;
+  if (!enabled)
+  {
+    vtkPVDataInformationBlockCache::GetInstance().Clear();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataInformation::GetBlockCacheEnabled()
+{
+  return ::BlockCacheEnabled;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataInformation::SetBlockCacheSize(vtkIdType size)
+{
+  vtkPVDataInformationBlockCache::GetInstance().SetMaximumSize(
+    static_cast<std::size_t>(std::max<vtkIdType>(size, 0)));
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVDataInformation::GetBlockCacheSize()
+{
+  return static_cast<vtkIdType>(vtkPVDataInformationBlockCache::GetInstance().GetMaximumSize());
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVDataInformation::GetNumberOfCachedBlocks()
+{
+  return static_cast<vtkIdType>(vtkPVDataInformationBlockCache::GetInstance().GetSize());
+}
+
 //----------------------------------------------------------------------------
 vtkSmartPointer<vtkCompositeDataSet> vtkPVDataInformation::SimplifyCompositeDataSet(
   vtkCompositeDataSet* cd)
@@ -433,6 +651,11 @@ void vtkPVDataInformation::CopyFromObject(vtkObject* object)
     subset = dobj;
   }
 
+  if (::BlockCacheEnabled)
+  {
+    vtkPVDataInformationBlockCache::GetInstance().Prune();
+  }
+
   vtkPVDataInformationAccumulator accumulator;
   if (auto cd = vtkCompositeDataSet::SafeDownCast(subset))
   {
@@ -479,6 +702,13 @@ void vtkPVDataInformation::CopyFromObject(vtkObject* object)
     accumulator(this, subset);
   }
 
+  vtkVLogF(PARAVIEW_LOG_PIPELINE_VERBOSITY(),
+    "data information for `%s`: %lld block(s) rescanned, %lld block(s) reused",
+    vtkLogIdentifier(dobj), static_cast<long long>(accumulator.NumberOfRescannedBlocks),
+    static_cast<long long>(accumulator.NumberOfReusedBlocks));
+  this->NumberOfRescannedBlocks = accumulator.NumberOfRescannedBlocks;
+  this->NumberOfReusedBlocks = accumulator.NumberOfReusedBlocks;
+
   this->UniqueBlockTypes.clear();
   if (this->CompositeDataSetType != -1)
   {
@@ -483,6 +483,45 @@ public:
    */
   const std::vector<unsigned char>& GetUniqueCellTypes() const { return this->UniqueCellTypes; }
 
+  ///@{
+  /**
+   * Enable/disable the process-wide cache of per-block information. When
+   * enabled (default), the information gathered for each non-composite block
+   * is cached and reused on subsequent gathers as long as the block's MTime is
+   * unchanged, so only modified blocks are rescanned. The number of rescanned
+   * and reused blocks is logged using `PARAVIEW_LOG_PIPELINE_VERBOSITY()`.
+   * Disabling the cache also clears it.
+   */
+  static void SetBlockCacheEnabled(bool enabled);
+  static bool GetBlockCacheEnabled();
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the maximum number of blocks kept in the per-block information
+   * cache. When the cache is full, the least recently used entries are
+   * evicted. Default is 4096; 0 disables caching new blocks.
+   */
+  static void SetBlockCacheSize(vtkIdType size);
+  static vtkIdType GetBlockCacheSize();
+  ///@}
+
+  /**
+   * Returns the number of blocks currently held in the per-block information
+   * cache.
+   */
+  static vtkIdType GetNumberOfCachedBlocks();
+
+  ///@{
+  /**
+   * Returns the number of non-composite blocks that were scanned, resp. whose
+   * information was reused from the per-block cache, by the last call to
+   * `CopyFromObject` on this process. These are not serialized.
+   */
+  vtkGetMacro(NumberOfRescannedBlocks, vtkIdType);
+  vtkGetMacro(NumberOfReusedBlocks, vtkIdType);
+  ///@}
+
 protected:
   vtkPVDataInformation();
   ~vtkPVDataInformation() override;
@@ -518,6 +557,8 @@ private:
   int DataSetType = -1;
   int CompositeDataSetType = -1;
   vtkTypeUInt64 FirstLeafCompositeIndex = 0;
+  vtkIdType NumberOfRescannedBlocks = 0;
+  vtkIdType NumberOfReusedBlocks = 0;
   vtkTypeInt64 NumberOfTrees = 0;
   vtkTypeInt64 NumberOfLeaves = 0;
   vtkTypeInt64 NumberOfAMRLevels = 0;
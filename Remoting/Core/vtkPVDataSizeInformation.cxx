@@ -13,6 +13,7 @@ vtkStandardNewMacro(vtkPVDataSizeInformation);
 vtkPVDataSizeInformation::vtkPVDataSizeInformation()
 {
   this->Initialize();
+  this->SetMergeable(true);
 }
 
 //----------------------------------------------------------------------------
@@ -58,6 +58,17 @@ public:
   vtkGetMacro(RootOnly, int);
   ///@}
 
+  ///@{
+  /**
+   * Returns true if AddInformation() is associative, i.e. information merged
+   * from a contiguous range of ranks can itself be serialized and merged with
+   * the information from the next range. Subclasses that satisfy this opt in
+   * by setting Mergeable in their constructor, which lets vtkPVSessionCore use a
+   * tree-based reduction instead of gathering every rank's stream on the root.
+   */
+  vtkGetMacro(Mergeable, bool);
+  ///@}
+
 protected:
   vtkPVInformation();
   ~vtkPVInformation() override;
@@ -65,6 +76,9 @@ protected:
   int RootOnly;
   vtkSetMacro(RootOnly, int);
 
+  bool Mergeable;
+  vtkSetMacro(Mergeable, bool);
+
   vtkPVInformation(const vtkPVInformation&) = delete;
   void operator=(const vtkPVInformation&) = delete;
 };
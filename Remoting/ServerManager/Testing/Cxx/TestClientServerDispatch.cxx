@@ -0,0 +1,337 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerInterpreterInitializer.h"
+#include "vtkClientServerStream.h"
+#include "vtkDataObject.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkInformation.h"
+#include "vtkInitializationHelper.h"
+#include "vtkProcessModule.h"
+
+#include <vtksys/FStream.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Replays streams of Invoke messages through
+// vtkClientServerInterpreter::ProcessStream() and reports the message rate.
+// By default, the streams are made of the kind of property pushes a state load
+// sends, to classes deep in the hierarchy, with the objects referred to by id
+// and then by pointer, as the server manager does. The test then checks that
+// the values reached the objects, that overloads are resolved, that a call
+// with a wrong number of arguments fails and that the cached command function
+// lookups find the same functions as the uncached ones. `--stream <file>` replays
+// instead the data of a recorded vtkClientServerStream (see
+// vtkClientServerStream::GetData()), which must only refer to objects by id.
+// `--repeat <n>` sets the number of times each stream is processed.
+namespace
+{
+const vtkClientServerStream::Types End = vtkClientServerStream::End;
+const vtkClientServerStream::Commands Invoke = vtkClientServerStream::Invoke;
+
+template <typename ObjectReference>
+void BuildStateLoadStream(vtkClientServerStream& css, ObjectReference sphere,
+  ObjectReference calculator, ObjectReference glyph)
+{
+  for (int i = 0; i < 100; ++i)
+  {
+    css << Invoke << sphere << "SetRadius" << 0.5 + i << End;
+    css << Invoke << sphere << "SetThetaResolution" << 8 + i << End;
+    css << Invoke << sphere << "SetCenter" << 0.0 << 1.0 << 2.0 << End;
+    css << Invoke << calculator << "SetFunction" << "coordsX * 2" << End;
+    css << Invoke << calculator << "SetResultArrayName" << "Result" << End;
+    css << Invoke << calculator << "SetAttributeType" << 0 << End;
+    css << Invoke << calculator << "SetInputArrayToProcess" << 0 << 0 << 0 << 0 << "Normals"
+        << End;
+    css << Invoke << glyph << "SetScaleFactor" << 0.1 * i << End;
+    css << Invoke << glyph << "SetGlyphMode" << 1 << End;
+    css << Invoke << glyph << "SetDebug" << 0 << End;
+    css << Invoke << glyph << "Modified" << End;
+  }
+}
+
+bool Replay(vtkClientServerInterpreter* interp, const vtkClientServerStream& css, int repeat,
+  const char* label)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeat; ++i)
+  {
+    if (!interp->ProcessStream(css))
+    {
+      std::cerr << "Failed to process the " << label << " stream: " << std::endl;
+      interp->GetLastResult().Print(std::cerr);
+      return false;
+    }
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  const double messages = static_cast<double>(css.GetNumberOfMessages()) * repeat;
+  std::cout << label << ": " << messages << " messages in " << elapsed.count() << " s, "
+            << messages / std::max(elapsed.count(), 1e-9) << " messages/s" << std::endl;
+  return true;
+}
+
+// Invokes `method` on `object` with the arguments of `args`, if any, and
+// returns its first result in `value`.
+template <typename T>
+bool Query(vtkClientServerInterpreter* interp, vtkClientServerID object, const char* method,
+  T* value, int argument = -1)
+{
+  vtkClientServerStream css;
+  css << Invoke << object << method;
+  if (argument >= 0)
+  {
+    css << argument;
+  }
+  css << End;
+  return interp->ProcessStream(css) && interp->GetLastResult().GetArgument(0, 0, value);
+}
+
+bool QueryCenter(vtkClientServerInterpreter* interp, vtkClientServerID sphere, double center[3])
+{
+  vtkClientServerStream css;
+  css << Invoke << sphere << "GetCenter" << End;
+  return interp->ProcessStream(css) && interp->GetLastResult().GetArgument(0, 0, center, 3);
+}
+
+vtkInformation* QueryInputArrayInformation(
+  vtkClientServerInterpreter* interp, vtkClientServerID calculator)
+{
+  vtkObjectBase* info = nullptr;
+  return Query(interp, calculator, "GetInputArrayInformation", &info, 0)
+    ? vtkInformation::SafeDownCast(info)
+    : nullptr;
+}
+
+#define CHECK(condition)                                                                           \
+  do                                                                                               \
+  {                                                                                                \
+    if (!(condition))                                                                              \
+    {                                                                                              \
+      std::cerr << "Failed at line " << __LINE__ << ": " #condition << std::endl;                 \
+      return false;                                                                                \
+    }                                                                                              \
+  } while (false)
+
+// Checks the objects have the values of the last iteration of BuildStateLoadStream.
+bool CheckState(vtkClientServerInterpreter* interp, vtkClientServerID sphere,
+  vtkClientServerID calculator, vtkClientServerID glyph)
+{
+  double radius = 0;
+  CHECK(Query(interp, sphere, "GetRadius", &radius) && radius == 0.5 + 99);
+  int resolution = 0;
+  CHECK(Query(interp, sphere, "GetThetaResolution", &resolution) && resolution == 8 + 99);
+  double center[3] = { 0, 0, 0 };
+  CHECK(QueryCenter(interp, sphere, center));
+  CHECK(center[0] == 0.0 && center[1] == 1.0 && center[2] == 2.0);
+
+  std::string function;
+  CHECK(Query(interp, calculator, "GetFunction", &function) && function == "coordsX * 2");
+  std::string resultName;
+  CHECK(Query(interp, calculator, "GetResultArrayName", &resultName) && resultName == "Result");
+  vtkInformation* info = QueryInputArrayInformation(interp, calculator);
+  CHECK(info && info->Has(vtkDataObject::FIELD_NAME()));
+  CHECK(strcmp(info->Get(vtkDataObject::FIELD_NAME()), "Normals") == 0);
+
+  double scaleFactor = 0;
+  CHECK(Query(interp, glyph, "GetScaleFactor", &scaleFactor) && scaleFactor == 0.1 * 99);
+  int glyphMode = 0;
+  CHECK(Query(interp, glyph, "GetGlyphMode", &glyphMode) && glyphMode == 1);
+  return true;
+}
+
+// Checks that overloads, with different numbers of arguments or different
+// argument types, are resolved and that a wrong number of arguments fails.
+bool CheckDispatch(
+  vtkClientServerInterpreter* interp, vtkClientServerID sphere, vtkClientServerID calculator)
+{
+  // SetCenter(double[3]) and SetCenter(double, double, double).
+  const double arrayCenter[3] = { 3.0, 4.0, 5.0 };
+  vtkClientServerStream css;
+  css << Invoke << sphere << "SetCenter" << vtkClientServerStream::InsertArray(arrayCenter, 3)
+      << End;
+  double center[3] = { 0, 0, 0 };
+  CHECK(interp->ProcessStream(css) && QueryCenter(interp, sphere, center));
+  CHECK(std::equal(center, center + 3, arrayCenter));
+  css.Reset();
+  css << Invoke << sphere << "SetCenter" << 6.0 << 7.0 << 8.0 << End;
+  CHECK(interp->ProcessStream(css) && QueryCenter(interp, sphere, center));
+  CHECK(center[0] == 6.0 && center[1] == 7.0 && center[2] == 8.0);
+
+  // Overloads of SetInputArrayToProcess with five arguments, tried in
+  // declaration order until the arguments convert.
+  css.Reset();
+  css << Invoke << calculator << "SetInputArrayToProcess" << 0 << 0 << 0 << 0
+      << static_cast<int>(vtkDataSetAttributes::TCOORDS) << End;
+  CHECK(interp->ProcessStream(css));
+  vtkInformation* info = QueryInputArrayInformation(interp, calculator);
+  CHECK(info && info->Has(vtkDataObject::FIELD_ATTRIBUTE_TYPE()));
+  CHECK(info->Get(vtkDataObject::FIELD_ATTRIBUTE_TYPE()) == vtkDataSetAttributes::TCOORDS);
+  css.Reset();
+  css << Invoke << calculator << "SetInputArrayToProcess" << 0 << 0 << 0
+      << vtkDataObject::GetAssociationTypeAsString(vtkDataObject::FIELD_ASSOCIATION_CELLS)
+      << "Pressure" << End;
+  CHECK(interp->ProcessStream(css));
+  info = QueryInputArrayInformation(interp, calculator);
+  CHECK(info && info->Has(vtkDataObject::FIELD_NAME()));
+  CHECK(strcmp(info->Get(vtkDataObject::FIELD_NAME()), "Pressure") == 0);
+  CHECK(info->Get(vtkDataObject::FIELD_ASSOCIATION()) == vtkDataObject::FIELD_ASSOCIATION_CELLS);
+
+  // No SetRadius takes two values: the call fails and leaves the radius as is.
+  double radius = 0;
+  CHECK(Query(interp, sphere, "GetRadius", &radius));
+  css.Reset();
+  css << Invoke << sphere << "SetRadius" << 1.0 << 2.0 << End;
+  CHECK(!interp->ProcessStream(css));
+  CHECK(interp->GetLastResult().GetCommand(0) == vtkClientServerStream::Error);
+  double unchanged = 0;
+  CHECK(Query(interp, sphere, "GetRadius", &unchanged) && unchanged == radius);
+
+  // Unknown methods fail too.
+  css.Reset();
+  css << Invoke << sphere << "SetNoSuchProperty" << 1.0 << End;
+  CHECK(!interp->ProcessStream(css));
+  return true;
+}
+
+// A command function replying with the tag given as its context.
+int TagCommand(vtkClientServerInterpreter*, vtkObjectBase*, const char*,
+  const vtkClientServerStream&, vtkClientServerStream& result, void* ctx)
+{
+  result << vtkClientServerStream::Reply << static_cast<const char*>(ctx) << End;
+  return 1;
+}
+
+// Calls the command function of `cname` through the cache or not, and returns
+// the tag of its reply.
+std::string CallTag(vtkClientServerInterpreter* interp, const char* cname, bool cached)
+{
+  vtkClientServerStream msg;
+  vtkClientServerStream result;
+  const int called = cached
+    ? interp->CallSuperclassCommandFunction(cname, nullptr, "Tag", msg, result)
+    : interp->CallCommandFunction(cname, nullptr, "Tag", msg, result);
+  std::string tag;
+  return called && result.GetArgument(0, 0, &tag) ? tag : std::string();
+}
+
+// Checks that command functions found through the cache are the ones found
+// without it, whatever the address of the class name.
+bool CheckCommandFunctionCache(vtkClientServerInterpreter* interp, vtkClientServerID sphere)
+{
+  static char tagA[] = "A";
+  static char tagB[] = "B";
+  static char tagC[] = "C";
+  interp->AddCommandFunction("vtkCacheTestA", TagCommand, tagA);
+  interp->AddCommandFunction("vtkCacheTestB", TagCommand, tagB);
+
+  char name[] = "vtkCacheTestA";
+  CHECK(CallTag(interp, name, true) == "A" && CallTag(interp, name, false) == "A");
+  // Same name at another address.
+  const std::string copy(name);
+  CHECK(CallTag(interp, copy.c_str(), true) == "A");
+  // Another name at the same address.
+  name[sizeof(name) - 2] = 'B';
+  CHECK(CallTag(interp, name, true) == "B" && CallTag(interp, name, false) == "B");
+  // A class without command function, until one is added.
+  name[sizeof(name) - 2] = 'C';
+  CHECK(CallTag(interp, name, true).empty() && !interp->HasCommandFunction(name));
+  interp->AddCommandFunction("vtkCacheTestC", TagCommand, tagC);
+  CHECK(CallTag(interp, name, true) == "C" && CallTag(interp, name, false) == "C");
+
+  // A generated command function, with its class name in a transient string.
+  vtkObjectBase* object = interp->GetObjectFromID(sphere);
+  const std::string className = object->GetClassName();
+  vtkClientServerStream msg;
+  msg << Invoke << object << "GetRadius" << End;
+  vtkClientServerStream cachedResult;
+  vtkClientServerStream result;
+  double cachedRadius = 0;
+  double radius = -1;
+  CHECK(interp->CallSuperclassCommandFunction(
+    className.c_str(), object, "GetRadius", msg, cachedResult));
+  CHECK(interp->CallCommandFunction(className.c_str(), object, "GetRadius", msg, result));
+  CHECK(cachedResult.GetArgument(0, 0, &cachedRadius) && result.GetArgument(0, 0, &radius));
+  CHECK(cachedRadius == radius);
+  return true;
+}
+}
+
+//----------------------------------------------------------------------------
+extern int TestClientServerDispatch(int argc, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argc, argv, vtkProcessModule::PROCESS_CLIENT);
+
+  std::string streamFile;
+  int repeat = 100;
+  for (int i = 1; i + 1 < argc; ++i)
+  {
+    if (strcmp(argv[i], "--stream") == 0)
+    {
+      streamFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "--repeat") == 0)
+    {
+      repeat = std::stoi(argv[++i]);
+    }
+  }
+
+  vtkClientServerInterpreter* interp =
+    vtkClientServerInterpreterInitializer::GetInitializer()->NewInterpreter();
+
+  int return_value = EXIT_SUCCESS;
+  if (streamFile.empty())
+  {
+    const vtkClientServerID sphere(1), calculator(2), glyph(3);
+    vtkClientServerStream setup;
+    setup << vtkClientServerStream::New << "vtkSphereSource" << sphere << End;
+    setup << vtkClientServerStream::New << "vtkPVArrayCalculator" << calculator << End;
+    setup << vtkClientServerStream::New << "vtkPVGlyphFilter" << glyph << End;
+    if (!interp->ProcessStream(setup))
+    {
+      std::cerr << "Failed to create the objects." << std::endl;
+      return_value = EXIT_FAILURE;
+    }
+    else
+    {
+      vtkClientServerStream byId;
+      BuildStateLoadStream(byId, sphere, calculator, glyph);
+      vtkClientServerStream byPointer;
+      BuildStateLoadStream(byPointer, interp->GetObjectFromID(sphere),
+        interp->GetObjectFromID(calculator), interp->GetObjectFromID(glyph));
+      if (!Replay(interp, byId, repeat, "objects by id") ||
+        !CheckState(interp, sphere, calculator, glyph) ||
+        !Replay(interp, byPointer, repeat, "objects by pointer") ||
+        !CheckState(interp, sphere, calculator, glyph) ||
+        !CheckDispatch(interp, sphere, calculator) || !CheckCommandFunctionCache(interp, sphere))
+      {
+        return_value = EXIT_FAILURE;
+      }
+    }
+  }
+  else
+  {
+    vtkClientServerStream css;
+    vtksys::ifstream file(streamFile.c_str(), std::ios::in | std::ios::binary);
+    std::vector<unsigned char> data(
+      (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.empty() || !css.SetData(data.data(), data.size()))
+    {
+      std::cerr << "Cannot read a stream from " << streamFile << std::endl;
+      return_value = EXIT_FAILURE;
+    }
+    else if (!Replay(interp, css, repeat, streamFile.c_str()))
+    {
+      return_value = EXIT_FAILURE;
+    }
+  }
+
+  interp->Delete();
+  vtkInitializationHelper::Finalize();
+  return return_value;
+}
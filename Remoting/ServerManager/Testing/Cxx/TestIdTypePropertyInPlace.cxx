@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerInterpreterInitializer.h"
+#include "vtkClientServerStream.h"
+#include "vtkInitializationHelper.h"
+#include "vtkObject.h"
+#include "vtkObjectFactory.h"
+#include "vtkProcessModule.h"
+#include "vtkSIProxy.h"
+#include "vtkSMMessage.h"
+#include "vtkSMProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSmartPointer.h"
+
+#include <cstring>
+#include <iostream>
+
+// Checks that the values of an IdType vector property pushed to a VTK object
+// are passed to it in place, from the message, without being copied.
+namespace
+{
+class vtkIdTypeSink : public vtkObject
+{
+public:
+  static vtkIdTypeSink* New();
+  vtkTypeMacro(vtkIdTypeSink, vtkObject);
+
+  const vtkIdType* Ids = nullptr;
+  vtkTypeUInt32 NumberOfIds = 0;
+
+protected:
+  vtkIdTypeSink() = default;
+  ~vtkIdTypeSink() override = default;
+
+private:
+  vtkIdTypeSink(const vtkIdTypeSink&) = delete;
+  void operator=(const vtkIdTypeSink&) = delete;
+};
+vtkStandardNewMacro(vtkIdTypeSink);
+
+vtkObjectBase* vtkIdTypeSinkNew(void*)
+{
+  return vtkIdTypeSink::New();
+}
+
+// Records where the values given to SetIds are, as the command function of a
+// wrapped method taking a const vtkIdType* would get them.
+int vtkIdTypeSinkCommand(vtkClientServerInterpreter*, vtkObjectBase* ptr, const char* method,
+  const vtkClientServerStream& msg, vtkClientServerStream&, void*)
+{
+  vtkIdTypeSink* sink = static_cast<vtkIdTypeSink*>(ptr);
+  if (strcmp(method, "SetIds") == 0)
+  {
+    return msg.GetArgumentPointer(0, 2, &sink->Ids, &sink->NumberOfIds);
+  }
+  return 1;
+}
+
+void vtkIdTypeSinkInitialize(vtkClientServerInterpreter* interp)
+{
+  interp->AddNewInstanceFunction("vtkIdTypeSink", vtkIdTypeSinkNew);
+  interp->AddCommandFunction("vtkIdTypeSink", vtkIdTypeSinkCommand);
+}
+
+const char* sinkDefinition = "<ServerManagerConfiguration>"
+                             " <ProxyGroup name='misc'>"
+                             "  <Proxy name='IdTypeSink' class='vtkIdTypeSink'>"
+                             "   <IdTypeVectorProperty name='Ids'"
+                             "                         command='SetIds'"
+                             "                         argument_is_array='1'"
+                             "                         number_of_elements='0'"
+                             "                         repeat_command='0' />"
+                             "  </Proxy>"
+                             " </ProxyGroup>"
+                             "</ServerManagerConfiguration>";
+}
+
+extern int TestIdTypePropertyInPlace(int argc, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argc, argv, vtkProcessModule::PROCESS_CLIENT);
+  vtkClientServerInterpreterInitializer::GetInitializer()->RegisterCallback(
+    &vtkIdTypeSinkInitialize);
+
+  int status = EXIT_SUCCESS;
+  {
+    vtkSmartPointer<vtkSMSession> session = vtkSmartPointer<vtkSMSession>::New();
+    vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+    pxm->GetProxyDefinitionManager()->LoadConfigurationXMLFromString(sinkDefinition);
+
+    vtkSmartPointer<vtkSMProxy> proxy;
+    proxy.TakeReference(pxm->NewProxy("misc", "IdTypeSink"));
+    proxy->UpdateVTKObjects();
+
+    vtkSIProxy* siProxy = vtkSIProxy::SafeDownCast(session->GetSIObject(proxy->GetGlobalID()));
+    vtkIdTypeSink* sink = siProxy ? vtkIdTypeSink::SafeDownCast(siProxy->GetVTKObject()) : nullptr;
+    if (!sink)
+    {
+      std::cerr << "ERROR: The sink was not created." << endl;
+      status = EXIT_FAILURE;
+    }
+    else
+    {
+      // Push the values as a client does, with an IdType variant.
+      vtkSMMessage message;
+      message.set_global_id(proxy->GetGlobalID());
+      message.set_location(proxy->GetLocation());
+      ProxyState_Property* prop = message.AddExtension(ProxyState::property);
+      prop->set_name("Ids");
+      Variant* variant = prop->mutable_value();
+      variant->set_type(Variant::IDTYPE);
+      for (vtkIdType i = 0; i < 100000; ++i)
+      {
+        variant->add_idtype(3 * i);
+      }
+      siProxy->Push(&message);
+
+      const void* values = variant->idtype().data();
+      if (sink->NumberOfIds != 100000 || sink->Ids == nullptr || sink->Ids[99999] != 299997)
+      {
+        std::cerr << "ERROR: The sink did not get the values." << endl;
+        status = EXIT_FAILURE;
+      }
+      else if (static_cast<const void*>(sink->Ids) != values)
+      {
+        std::cerr << "ERROR: The values were copied instead of being used in place." << endl;
+        status = EXIT_FAILURE;
+      }
+    }
+  }
+
+  vtkInitializationHelper::Finalize();
+  return status;
+}
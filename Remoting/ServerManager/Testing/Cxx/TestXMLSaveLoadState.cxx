@@ -1,13 +1,16 @@
 // SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkInitializationHelper.h"
+#include "vtkNew.h"
 #include "vtkPVDataInformation.h"
+#include "vtkPVGeneralSettings.h"
 #include "vtkProcessModule.h"
 #include "vtkSMPropertyHelper.h"
 #include "vtkSMProxyManager.h"
 #include "vtkSMSession.h"
 #include "vtkSMSessionProxyManager.h"
 #include "vtkSMSourceProxy.h"
+#include "vtkSMStateLoader.h"
 
 #include "vtkPVXMLElement.h"
 
@@ -87,6 +90,28 @@ extern int TestXMLSaveLoadState(int argc, char* argv[])
     std::cout << endl << " ### FAILED: States are NOT equals ###" << endl;
     return_value = EXIT_FAILURE;
   }
+
+  std::cout << "==== Loading previous state in waves ====" << endl;
+  pxm->UnRegisterProxies();
+  vtkPVGeneralSettings::GetInstance()->SetLoadStateInWaves(true);
+  vtkNew<vtkSMStateLoader> loader;
+  vtkPVGeneralSettings::GetInstance()->SetLoadStateInWaves(false);
+  if (!loader->GetLoadInWaves())
+  {
+    std::cout << " ### FAILED: LoadStateInWaves setting not used by the loader ###" << endl;
+    return_value = EXIT_FAILURE;
+  }
+  loader->SetSessionProxyManager(pxm);
+  pxm->LoadXMLState(xmlRootNodeOrigin, loader);
+  vtkSMProxy* loadedSphere = pxm->GetProxy("sources", "sphere");
+  vtkSMProxy* loadedShrink = pxm->GetProxy("filters", "shrink");
+  if (!loadedSphere || !loadedShrink ||
+    vtkSMPropertyHelper(loadedShrink, "Input").GetAsProxy() != loadedSphere ||
+    vtkSMPropertyHelper(loadedSphere, "PhiResolution").GetAsInt() != 20)
+  {
+    std::cout << " ### FAILED: State not loaded correctly in waves ###" << endl;
+    return_value = EXIT_FAILURE;
+  }
   session->Delete();
 
   //---------------------------------------------------------------------------
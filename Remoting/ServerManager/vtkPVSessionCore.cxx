@@ -26,11 +26,14 @@
 
 #include "vtksys/FStream.hxx"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <set>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #define LOG(x)                                                                                     \
   if (this->LogStream)                                                                             \
@@ -232,6 +235,7 @@ vtkPVSessionCore::vtkPVSessionCore()
   this->Interpreter = vtkClientServerInterpreterInitializer::GetInitializer()->NewInterpreter();
   this->MPIMToNSocketConnection = nullptr;
   this->SymmetricMPIMode = false;
+  this->InformationReductionFanOut = 2;
 
   vtkPVSessionCoreInterpreterHelper* helper = vtkPVSessionCoreInterpreterHelper::New();
   helper->SetCore(this);
@@ -502,6 +506,7 @@ void vtkPVSessionCore::PushStateSatelliteCallback()
 void vtkPVSessionCore::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "InformationReductionFanOut: " << this->InformationReductionFanOut << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -556,10 +561,19 @@ void vtkPVSessionCore::ExecuteStream(
       this->ParallelController->GetLocalProcessId() == 0)
     {
       // Forward the message to the satellites if the object is expected to exist
-      // on the satellites.
-      size_t byte_size;
-      const unsigned char* raw_data;
-      stream.GetData(&raw_data, &byte_size);
+      // on the satellites. The stream is broadcast segment by segment so that
+      // arrays it references are not copied into it first.
+      const int numberOfSegments = stream.GetNumberOfDataSegments();
+      std::vector<int> segmentSizes(numberOfSegments);
+      size_t byte_size = 0;
+      for (int cc = 0; cc < numberOfSegments; ++cc)
+      {
+        const unsigned char* segment;
+        size_t segmentSize;
+        stream.GetDataSegment(cc, &segment, &segmentSize);
+        segmentSizes[cc] = static_cast<int>(segmentSize);
+        byte_size += segmentSize;
+      }
 
       // FIXME: There's one flaw in this logic. If a object is to be created on
       // DATA_SERVER_ROOT, but on all RENDER_SERVER nodes, then in render-server
@@ -568,11 +582,26 @@ void vtkPVSessionCore::ExecuteStream(
       // and we should fix this.
       unsigned char type = EXECUTE_STREAM;
       this->ParallelController->TriggerRMIOnAllChildren(&type, 1, ROOT_SATELLITE_RMI_TAG);
-      int size[2];
+      int size[3];
       size[0] = static_cast<int>(byte_size);
       size[1] = (ignore_errors ? 1 : 0);
-      this->ParallelController->Broadcast(size, 2, 0);
-      this->ParallelController->Broadcast(const_cast<unsigned char*>(raw_data), size[0], 0);
+      size[2] = numberOfSegments;
+      this->ParallelController->Broadcast(size, 3, 0);
+      if (numberOfSegments > 0)
+      {
+        this->ParallelController->Broadcast(segmentSizes.data(), numberOfSegments, 0);
+      }
+      for (int cc = 0; cc < numberOfSegments; ++cc)
+      {
+        const unsigned char* segment;
+        size_t segmentSize;
+        stream.GetDataSegment(cc, &segment, &segmentSize);
+        if (segmentSize > 0)
+        {
+          this->ParallelController->Broadcast(
+            const_cast<unsigned char*>(segment), static_cast<vtkIdType>(segmentSize), 0);
+        }
+      }
     }
   }
 
@@ -582,10 +611,25 @@ void vtkPVSessionCore::ExecuteStream(
 //----------------------------------------------------------------------------
 void vtkPVSessionCore::ExecuteStreamSatelliteCallback()
 {
-  int byte_size[2] = { 0, 0 };
-  this->ParallelController->Broadcast(byte_size, 2, 0);
+  int byte_size[3] = { 0, 0, 0 };
+  this->ParallelController->Broadcast(byte_size, 3, 0);
+  std::vector<int> segmentSizes(byte_size[2]);
+  if (byte_size[2] > 0)
+  {
+    this->ParallelController->Broadcast(segmentSizes.data(), byte_size[2], 0);
+  }
+
+  // Gather the segments sent by the root in a contiguous buffer.
   unsigned char* raw_data = new unsigned char[byte_size[0] + 1];
-  this->ParallelController->Broadcast(raw_data, byte_size[0], 0);
+  int offset = 0;
+  for (int segmentSize : segmentSizes)
+  {
+    if (segmentSize > 0)
+    {
+      this->ParallelController->Broadcast(raw_data + offset, segmentSize, 0);
+      offset += segmentSize;
+    }
+  }
 
   vtkClientServerStream stream;
   stream.SetData(raw_data, byte_size[0]);
@@ -798,6 +842,11 @@ bool vtkPVSessionCore::GatherInformation(
   const bool skip_satellites = (information->GetRootOnly() ||
     (location & vtkProcessModule::SERVERS) == 0 || this->SymmetricMPIMode);
 
+  // pick the reduction strategy here so that all ranks agree on it.
+  const int fanOut = (information->GetMergeable() && this->InformationReductionFanOut >= 2)
+    ? this->InformationReductionFanOut
+    : 0;
+
   // send message to satellites and then start processing.
   // this must be done before calling `GatherInformationInternal` on this process to
   // avoid deadlocks if the gather results in pipeline updates
@@ -816,7 +865,7 @@ bool vtkPVSessionCore::GatherInformation(
     this->ParallelController->TriggerRMIOnAllChildren(&type, 1, ROOT_SATELLITE_RMI_TAG);
 
     vtkMultiProcessStream stream;
-    stream << information->GetClassName() << globalid;
+    stream << information->GetClassName() << globalid << fanOut;
 
     // serialize information parameters so all processes have the same ivars.
     information->CopyParametersToStream(stream);
@@ -827,7 +876,13 @@ bool vtkPVSessionCore::GatherInformation(
   // Now collect local information.
   const bool status = this->GatherInformationInternal(information, globalid);
 
-  return (skip_satellites || this->CollectInformation(information)) && status;
+  if (skip_satellites)
+  {
+    return status;
+  }
+  const bool collected = fanOut > 0 ? this->ReduceInformation(information, fanOut)
+                                    : this->CollectInformation(information);
+  return collected && status;
 }
 
 //----------------------------------------------------------------------------
@@ -838,7 +893,8 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
 
   std::string classname;
   vtkTypeUInt32 globalid;
-  stream >> classname >> globalid;
+  int fanOut;
+  stream >> classname >> globalid >> fanOut;
 
   vtkSmartPointer<vtkObjectBase> o;
   o.TakeReference(vtkClientServerStreamInstantiator::CreateInstance(classname.c_str()));
@@ -847,13 +903,27 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
   {
     info->CopyParametersFromStream(stream);
     this->GatherInformationInternal(info, globalid);
-    this->CollectInformation(info);
+    if (fanOut > 0)
+    {
+      this->ReduceInformation(info, fanOut);
+    }
+    else
+    {
+      this->CollectInformation(info);
+    }
   }
   else
   {
     vtkErrorMacro("Could not gather information on Satellite.");
     // let the parent know, otherwise root will hang.
-    this->CollectInformation(nullptr);
+    if (fanOut > 0)
+    {
+      this->ReduceInformation(nullptr, fanOut);
+    }
+    else
+    {
+      this->CollectInformation(nullptr);
+    }
   }
 }
 
@@ -945,6 +1015,106 @@ bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVSessionCore::ReduceInformation(vtkPVInformation* info, int fanOut)
+{
+  assert("pre: fanOut must be at least 2" && fanOut >= 2);
+
+  auto controller = this->ParallelController;
+  const int rank = controller->GetLocalProcessId();
+  const int nranks = controller->GetNumberOfProcesses();
+  if (nranks == 1)
+  {
+    /* short-circuit */
+    return true;
+  }
+
+  // k-ary tree reduction: at each level with `stride`, a rank that is a
+  // multiple of `stride * fanOut` receives the partial results of ranks
+  // `rank + j * stride` (j in [1, fanOut)), in increasing rank order, while
+  // every other rank sends its partial result to its parent and leaves.
+  // Since children are merged in rank order, the information on the root is
+  // merged in the same order as with CollectInformation(); only
+  // associativity of AddInformation() is required.
+  //
+  // A partial result is sent as a number of serialized information objects
+  // followed by each of them. A rank without information, i.e. where the
+  // information could not be created, keeps the ones of its subtree unmerged
+  // and forwards them to its parent.
+  auto sendBuffer = [controller](const unsigned char* data, vtkIdType length, int parent)
+  {
+    controller->Send(&length, 1, parent, ROOT_SATELLITE_INFO_TAG);
+    if (length > 0)
+    {
+      controller->Send(data, length, parent, ROOT_SATELLITE_INFO_TAG);
+    }
+  };
+
+  vtkClientServerStream stream;
+  std::vector<std::vector<unsigned char>> forwarded;
+  for (vtkIdType stride = 1; stride < nranks; stride *= fanOut)
+  {
+    const vtkIdType span = stride * fanOut;
+    if (rank % span != 0)
+    {
+      // send partial result to the parent.
+      const int parent = static_cast<int>(rank - (rank % span));
+      if (info)
+      {
+        const unsigned char* data = nullptr;
+        size_t length = 0;
+        info->CopyToStream(&stream);
+        stream.GetData(&data, &length);
+        vtkIdType count = 1;
+        controller->Send(&count, 1, parent, ROOT_SATELLITE_INFO_TAG);
+        sendBuffer(data, static_cast<vtkIdType>(length), parent);
+      }
+      else
+      {
+        vtkIdType count = static_cast<vtkIdType>(forwarded.size());
+        controller->Send(&count, 1, parent, ROOT_SATELLITE_INFO_TAG);
+        for (const auto& buffer : forwarded)
+        {
+          sendBuffer(buffer.data(), static_cast<vtkIdType>(buffer.size()), parent);
+        }
+      }
+      break;
+    }
+
+    for (vtkIdType child = rank + stride; child < std::min<vtkIdType>(rank + span, nranks);
+         child += stride)
+    {
+      vtkIdType count = 0;
+      controller->Receive(&count, 1, static_cast<int>(child), ROOT_SATELLITE_INFO_TAG);
+      for (vtkIdType cc = 0; cc < count; ++cc)
+      {
+        vtkIdType length = 0;
+        controller->Receive(&length, 1, static_cast<int>(child), ROOT_SATELLITE_INFO_TAG);
+        if (length <= 0)
+        {
+          continue;
+        }
+        std::vector<unsigned char> rcvbuffer(static_cast<size_t>(length));
+        controller->Receive(
+          rcvbuffer.data(), length, static_cast<int>(child), ROOT_SATELLITE_INFO_TAG);
+        if (info)
+        {
+          stream.SetData(rcvbuffer.data(), rcvbuffer.size());
+          vtkSmartPointer<vtkPVInformation> tempInfo;
+          tempInfo.TakeReference(info->NewInstance());
+          tempInfo->CopyFromStream(&stream);
+          info->AddInformation(tempInfo);
+        }
+        else
+        {
+          forwarded.push_back(std::move(rcvbuffer));
+        }
+      }
+    }
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionCore::RegisterRemoteObject(vtkTypeUInt32 gid, vtkObject* obj)
 {
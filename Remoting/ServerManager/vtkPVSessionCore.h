@@ -115,6 +115,20 @@ public:
   virtual bool GatherInformation(
     vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid);
 
+  ///@{
+  /**
+   * Get/Set the fan-out of the tree used to reduce information objects that
+   * report themselves as mergeable (see vtkPVInformation::GetMergeable) across
+   * MPI ranks. Each interior rank merges the information from up to
+   * `InformationReductionFanOut - 1` children before forwarding it to its
+   * parent, giving a reduction depth of log_k(number of ranks). Set to 0 to
+   * always gather every rank's information on the root instead. Only the value
+   * on the root rank is used. Default is 2.
+   */
+  vtkSetMacro(InformationReductionFanOut, int);
+  vtkGetMacro(InformationReductionFanOut, int);
+  ///@}
+
   /**
    * Returns the number of processes. This simply calls the
    * GetNumberOfProcesses() on this->ParallelController
@@ -203,6 +217,12 @@ protected:
    */
   bool CollectInformation(vtkPVInformation*);
 
+  /**
+   * Gather information across MPI satellites using a k-ary tree reduction
+   * with the given fan-out. Only valid for mergeable information objects.
+   */
+  bool ReduceInformation(vtkPVInformation*, int fanOut);
+
   /**
    * Increment reference count of a local vtkSIObject.
    */
@@ -242,6 +262,8 @@ private:
   // Local counter for global Ids
   vtkTypeUInt32 LocalGlobalID;
 
+  int InformationReductionFanOut;
+
   ostream* LogStream;
 };
 
@@ -540,6 +540,26 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int messageLeng
     }
     break;
 
+    case vtkPVSessionServer::PUSH_BATCH:
+    {
+      std::string string;
+      stream >> string;
+      vtkSMMessageCollection collection;
+      collection.ParseFromString(string);
+
+      // Apply the states in the order in which the client pushed them.
+      for (int cc = 0; cc < collection.item_size(); cc++)
+      {
+        vtkSMMessage* msg = collection.mutable_item(cc);
+        if (!this->Internal->StoreShareOnly(msg))
+        {
+          this->PushState(msg);
+        }
+        this->NotifyOtherClients(msg);
+      }
+    }
+    break;
+
     case vtkPVSessionServer::PULL:
     {
       std::string string;
@@ -580,11 +600,23 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int messageLeng
 
     case vtkPVSessionServer::EXECUTE_STREAM:
     {
-      int ignoreErrors, sendReply, size;
-      stream >> ignoreErrors >> sendReply >> size;
+      int ignoreErrors, sendReply, size, numberOfSegments;
+      stream >> ignoreErrors >> sendReply >> size >> numberOfSegments;
+
+      // Gather the segments sent by the client in a contiguous buffer.
       unsigned char* css_data = new unsigned char[size + 1];
-      this->Internal->GetActiveController()->Receive(
-        css_data, size, 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+      int offset = 0;
+      for (int cc = 0; cc < numberOfSegments; ++cc)
+      {
+        int segmentSize;
+        stream >> segmentSize;
+        if (segmentSize > 0)
+        {
+          this->Internal->GetActiveController()->Receive(
+            css_data + offset, segmentSize, 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+          offset += segmentSize;
+        }
+      }
       vtkClientServerStream cssStream;
       cssStream.SetData(css_data, size);
       this->ExecuteStream(vtkPVSession::CLIENT_AND_SERVERS, cssStream, ignoreErrors != 0);
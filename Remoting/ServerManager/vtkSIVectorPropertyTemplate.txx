@@ -10,6 +10,7 @@
 
 #include <cassert>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 namespace
@@ -19,11 +20,26 @@ struct HelperTraits
 {
 };
 
+// The values of a variant can be used in place as vtkIdType when both types
+// have the same size and signedness. The protobuf sint64 field is
+// int64_t, which is long on LP64 platforms, while vtkIdType is long long.
+template <typename U>
+const vtkIdType* IdTypeData(const U* values)
+{
+  if (sizeof(U) == sizeof(vtkIdType) &&
+    std::is_signed<U>::value == std::is_signed<vtkIdType>::value)
+  {
+    return reinterpret_cast<const vtkIdType*>(values);
+  }
+  return nullptr;
+}
+
 template <typename ForceIdType>
 struct HelperTraits<int, ForceIdType>
 {
   static int size(const Variant& variant) { return variant.integer_size(); }
   static int get(const Variant& variant, int idx) { return variant.integer(idx); }
+  static const int* data(const Variant& variant) { return variant.integer().data(); }
   static Variant_Type variant_type() { return Variant::INT; }
   static void append(Variant& variant, int value) { variant.add_integer(value); }
 };
@@ -33,6 +49,7 @@ struct HelperTraits<double, ForceIdType>
 {
   static int size(const Variant& variant) { return variant.float64_size(); }
   static double get(const Variant& variant, int idx) { return variant.float64(idx); }
+  static const double* data(const Variant& variant) { return variant.float64().data(); }
   static Variant_Type variant_type() { return Variant::FLOAT64; }
   static void append(Variant& variant, double value) { variant.add_float64(value); }
 };
@@ -42,6 +59,10 @@ struct HelperTraits<vtkIdType, bool>
 {
   static int size(const Variant& variant) { return variant.idtype_size(); }
   static vtkIdType get(const Variant& variant, int idx) { return variant.idtype(idx); }
+  static const vtkIdType* data(const Variant& variant)
+  {
+    return IdTypeData(variant.idtype().data());
+  }
   static Variant_Type variant_type() { return Variant::IDTYPE; }
   static void append(Variant& variant, vtkIdType value) { variant.add_idtype(value); }
 };
@@ -132,6 +153,16 @@ bool vtkSIVectorPropertyTemplate<T, force_idtype>::Push(vtkSMMessage* message, i
   this->SaveValueToCache(message, offset);
 
   const Variant* variant = &prop->value();
+  const int num_elems = HelperTraits<T, force_idtype>::size(*variant);
+  if (num_elems > 0)
+  {
+    // Push the values stored in the message in place when their type matches.
+    if (const T* values = HelperTraits<T, force_idtype>::data(*variant))
+    {
+      return this->Push(const_cast<T*>(values), num_elems);
+    }
+  }
+
   std::vector<T> values = VariantToVector<T, force_idtype>(*variant);
   return (values.size() > 0)
     ? this->Push(values.data(), static_cast<int>(values.size()))
@@ -204,6 +235,8 @@ bool vtkSIVectorPropertyTemplate<T, force_idtype>::Push(T* values, int number_of
     return true;
   }
 
+  // The stream is processed before returning, so the values are
+  // inserted by reference instead of being copied into it.
   vtkClientServerStream stream;
   vtkObjectBase* object = this->GetVTKObject();
 
@@ -236,7 +269,7 @@ bool vtkSIVectorPropertyTemplate<T, force_idtype>::Push(T* values, int number_of
     }
     if (this->ArgumentIsArray)
     {
-      stream << vtkClientServerStream::InsertArray(values, number_of_elements);
+      stream << vtkClientServerStream::InsertArrayReference(values, number_of_elements);
     }
     else
     {
@@ -263,7 +296,7 @@ bool vtkSIVectorPropertyTemplate<T, force_idtype>::Push(T* values, int number_of
       }
       if (this->ArgumentIsArray)
       {
-        stream << vtkClientServerStream::InsertArray(
+        stream << vtkClientServerStream::InsertArrayReference(
           &(values[i * this->NumberOfElementsPerCommand]), this->NumberOfElementsPerCommand);
       }
       else
@@ -38,6 +38,9 @@ vtkPVDataInformation* vtkSMOutputPort::GetDataInformation()
     vtkTimerLog::MarkStartEvent(mystr.str().c_str());
     this->DataInformation->SetPortNumber(this->PortIndex);
     this->GatherInformation(this->DataInformation);
+    // Gathering does not modify the information object, mark it so that its MTime tells
+    // when the data was last gathered.
+    this->DataInformation->Modified();
     this->DataInformationValid = true;
     vtkTimerLog::MarkEndEvent(mystr.str().c_str());
   }
@@ -55,6 +58,7 @@ vtkPVDataInformation* vtkSMOutputPort::GetDataSetInformation()
     this->DataInformation->SetInspectCells(true);
     this->DataInformation->SetPortNumber(this->PortIndex);
     this->GatherInformation(this->DataInformation);
+    this->DataInformation->Modified();
     this->DataSetInformationValid = true;
     vtkTimerLog::MarkEndEvent(mystr.str().c_str());
   }
@@ -46,6 +46,7 @@ public:
    * invalid, calls GatherDataInformation.
    * If data information is gathered then this fires the
    * vtkCommand::UpdateInformationEvent event.
+   * The MTime of the returned information changes each time it is gathered.
    */
   virtual vtkPVDataInformation* GetDataInformation();
 
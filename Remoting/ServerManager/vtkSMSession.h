@@ -147,6 +147,19 @@ public:
    */
   void NotifyOtherClients(const vtkSMMessage*) override { /* nothing to do. */ }
 
+  ///@{
+  /**
+   * Begin/End a push transaction. While a transaction is open, a session may
+   * hold back the states pushed to remote processes and send them together
+   * when the outermost transaction ends, or as soon as any other request needs
+   * to talk to the server. States are still applied in the order in which they
+   * were pushed. Transactions can be nested. The default implementation does
+   * nothing since all the states are applied locally.
+   */
+  virtual void BeginPushTransaction() {}
+  virtual void EndPushTransaction() {}
+  ///@}
+
   //---------------------------------------------------------------------------
   // API for Collaboration management
   //---------------------------------------------------------------------------
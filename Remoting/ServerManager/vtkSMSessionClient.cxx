@@ -39,6 +39,7 @@
 #include <cassert>
 #include <iostream>
 #include <set>
+#include <vector>
 
 //****************************************************************************/
 //                    Internal Classes and typedefs
@@ -51,6 +52,60 @@ void RMICallback(
   vtkSMSessionClient* self = reinterpret_cast<vtkSMSessionClient*>(localArg);
   self->OnServerNotificationMessageRMI(remoteArg, remoteArgLength);
 }
+
+// Returns true if the message only holds property values, as the states pushed
+// by vtkSMProxy::UpdateVTKObjects().
+bool IsPropertyUpdate(const vtkSMMessage& message)
+{
+  std::vector<const google::protobuf::FieldDescriptor*> fields;
+  message.GetReflection()->ListFields(message, &fields);
+  for (const google::protobuf::FieldDescriptor* field : fields)
+  {
+    const int number = field->number();
+    if (number != vtkSMMessage::kGlobalIdFieldNumber &&
+      number != vtkSMMessage::kLocationFieldNumber && number != ProxyState::kPropertyFieldNumber)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Queues a state to push. A property update is merged into the last queued
+// state when that one updates other properties of the same proxy, so that no
+// value is lost and the order in which the values are applied is preserved.
+void QueuePushState(vtkSMMessageCollection* queue, const vtkSMMessage& message)
+{
+  const int size = queue->item_size();
+  if (size > 0 && IsPropertyUpdate(message))
+  {
+    vtkSMMessage* last = queue->mutable_item(size - 1);
+    if (last->global_id() == message.global_id() && last->location() == message.location() &&
+      IsPropertyUpdate(*last))
+    {
+      std::set<std::string> names;
+      for (int cc = 0; cc < last->ExtensionSize(ProxyState::property); ++cc)
+      {
+        names.insert(last->GetExtension(ProxyState::property, cc).name());
+      }
+      bool distinct = true;
+      for (int cc = 0; distinct && cc < message.ExtensionSize(ProxyState::property); ++cc)
+      {
+        distinct = names.find(message.GetExtension(ProxyState::property, cc).name()) == names.end();
+      }
+      if (distinct)
+      {
+        for (int cc = 0; cc < message.ExtensionSize(ProxyState::property); ++cc)
+        {
+          last->AddExtension(ProxyState::property)
+            ->CopyFrom(message.GetExtension(ProxyState::property, cc));
+        }
+        return;
+      }
+    }
+  }
+  queue->add_item()->CopyFrom(message);
+}
 };
 //****************************************************************************/
 vtkStandardNewMacro(vtkSMSessionClient);
@@ -83,6 +138,10 @@ vtkSMSessionClient::vtkSMSessionClient()
   // Default value
   this->NoMoreDelete = false;
   this->NotBusy = 0;
+
+  this->PushTransactionDepth = 0;
+  this->PendingDataServerPushes = new vtkSMMessageCollection();
+  this->PendingRenderServerPushes = new vtkSMMessageCollection();
 }
 
 //----------------------------------------------------------------------------
@@ -111,11 +170,19 @@ vtkSMSessionClient::~vtkSMSessionClient()
 
   delete this->ServerLastInvokeResult;
   this->ServerLastInvokeResult = nullptr;
+
+  delete this->PendingDataServerPushes;
+  this->PendingDataServerPushes = nullptr;
+  delete this->PendingRenderServerPushes;
+  this->PendingRenderServerPushes = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkMultiProcessController* vtkSMSessionClient::GetController(ServerFlags processType)
 {
+  // The caller may communicate with the server directly.
+  this->FlushPushTransaction();
+
   switch (processType)
   {
     case CLIENT:
@@ -530,6 +597,7 @@ bool vtkSMSessionClient::IsMPIInitialized(vtkTypeUInt32 servers)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::CloseSession()
 {
+  this->FlushPushTransaction();
   if (this->DataServerController)
   {
     this->DataServerController->TriggerRMIOnAllChildren(vtkPVSessionServer::CLOSE_SESSION);
@@ -593,8 +661,20 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
   {
     controllers[num_controllers++] = this->RenderServerController;
   }
-  if (num_controllers > 0)
+  if (num_controllers > 0 && this->PushTransactionDepth > 0 && !this->IsMultiClients())
   {
+    for (int cc = 0; cc < num_controllers; cc++)
+    {
+      QueuePushState(controllers[cc] == this->DataServerController
+          ? this->PendingDataServerPushes
+          : this->PendingRenderServerPushes,
+        *message);
+    }
+  }
+  else if (num_controllers > 0)
+  {
+    this->FlushPushTransaction();
+
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::PUSH);
     stream << message->SerializeAsString();
@@ -666,6 +746,7 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PullState(vtkSMMessage* message)
 {
+  this->FlushPushTransaction();
   this->StartBusyWork();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
@@ -722,6 +803,7 @@ void vtkSMSessionClient::ExecuteStream(
     return;
   }
 
+  this->FlushPushTransaction();
   location = this->GetRealLocation(location);
 
   vtkMultiProcessController* controllers[2] = { nullptr, nullptr };
@@ -737,13 +819,28 @@ void vtkSMSessionClient::ExecuteStream(
 
   if (num_controllers > 0)
   {
-    const unsigned char* data;
-    size_t size;
-    cssstream.GetData(&data, &size);
+    // The stream is sent segment by segment so that arrays it references
+    // are not copied into it first.
+    const int numberOfSegments = cssstream.GetNumberOfDataSegments();
+    size_t size = 0;
+    for (int cc = 0; cc < numberOfSegments; ++cc)
+    {
+      const unsigned char* data;
+      size_t segmentSize;
+      cssstream.GetDataSegment(cc, &data, &segmentSize);
+      size += segmentSize;
+    }
 
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::EXECUTE_STREAM) << static_cast<int>(ignoreErrors)
-           << static_cast<int>(sendReply) << static_cast<int>(size);
+           << static_cast<int>(sendReply) << static_cast<int>(size) << numberOfSegments;
+    for (int cc = 0; cc < numberOfSegments; ++cc)
+    {
+      const unsigned char* data;
+      size_t segmentSize;
+      cssstream.GetDataSegment(cc, &data, &segmentSize);
+      stream << static_cast<int>(segmentSize);
+    }
     std::vector<unsigned char> raw_message;
     stream.GetRawData(raw_message);
 
@@ -751,8 +848,17 @@ void vtkSMSessionClient::ExecuteStream(
     {
       controllers[cc]->TriggerRMIOnAllChildren(raw_message.data(),
         static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
-      controllers[cc]->Send(
-        data, static_cast<int>(size), 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+      for (int segment = 0; segment < numberOfSegments; ++segment)
+      {
+        const unsigned char* data;
+        size_t segmentSize;
+        cssstream.GetDataSegment(segment, &data, &segmentSize);
+        if (segmentSize > 0)
+        {
+          controllers[cc]->Send(
+            data, static_cast<int>(segmentSize), 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
+        }
+      }
       if (sendReply)
       {
         unsigned char dummy;
@@ -770,6 +876,7 @@ void vtkSMSessionClient::ExecuteStream(
 //----------------------------------------------------------------------------
 const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 location)
 {
+  this->FlushPushTransaction();
   this->StartBusyWork();
   location = this->GetRealLocation(location);
 
@@ -818,6 +925,7 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
 bool vtkSMSessionClient::GatherInformation(
   vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid)
 {
+  this->FlushPushTransaction();
   this->StartBusyWork();
   if (this->RenderServerController == nullptr)
   {
@@ -917,6 +1025,7 @@ void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
     return;
   }
 
+  this->FlushPushTransaction();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
   message->set_client_id(this->GetServerInformation()->GetClientId());
@@ -958,6 +1067,7 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
     return;
   }
 
+  this->FlushPushTransaction();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
   message->set_client_id(this->GetServerInformation()->GetClientId());
@@ -1000,6 +1110,53 @@ void vtkSMSessionClient::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
 }
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::BeginPushTransaction()
+{
+  ++this->PushTransactionDepth;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::EndPushTransaction()
+{
+  if (this->PushTransactionDepth <= 0)
+  {
+    vtkWarningMacro("EndPushTransaction() called without matching BeginPushTransaction().");
+    return;
+  }
+  if (--this->PushTransactionDepth == 0)
+  {
+    this->FlushPushTransaction();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::FlushPushTransaction()
+{
+  vtkMultiProcessController* controllers[2] = { this->DataServerController,
+    this->RenderServerController };
+  vtkSMMessageCollection* queues[2] = { this->PendingDataServerPushes,
+    this->PendingRenderServerPushes };
+  for (int cc = 0; cc < 2; cc++)
+  {
+    if (queues[cc]->item_size() == 0)
+    {
+      continue;
+    }
+    if (controllers[cc] != nullptr)
+    {
+      vtkMultiProcessStream stream;
+      stream << static_cast<int>(vtkPVSessionServer::PUSH_BATCH);
+      stream << queues[cc]->SerializeAsString();
+      std::vector<unsigned char> raw_message;
+      stream.GetRawData(raw_message);
+      controllers[cc]->TriggerRMIOnAllChildren(raw_message.data(),
+        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+    }
+    queues[cc]->Clear();
+  }
+}
 //----------------------------------------------------------------------------
 vtkTypeUInt32 vtkSMSessionClient::GetNextGlobalUniqueIdentifier()
 {
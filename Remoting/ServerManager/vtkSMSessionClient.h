@@ -155,6 +155,19 @@ public:
    */
   bool IsMPIInitialized(vtkTypeUInt32 servers) override;
 
+  ///@{
+  /**
+   * Overridden to queue the states pushed to the server(s) while a transaction
+   * is open. Consecutive property updates of the same proxy are merged into a
+   * single state and all the queued states are sent in a single message per
+   * server connection. The queue is flushed before any other request is sent
+   * to the server(s), so the server applies states in the order they were
+   * pushed. States are never queued when several clients share the session.
+   */
+  void BeginPushTransaction() override;
+  void EndPushTransaction() override;
+  ///@}
+
   //---------------------------------------------------------------------------
   // API for Collaboration management
   //---------------------------------------------------------------------------
@@ -247,6 +260,11 @@ protected:
    */
   vtkTypeUInt32 GetRealLocation(vtkTypeUInt32);
 
+  /**
+   * Sends the states queued by the current push transaction, if any.
+   */
+  void FlushPushTransaction();
+
   // Both maybe the same when connected to pvserver.
   vtkMultiProcessController* RenderServerController;
   vtkMultiProcessController* DataServerController;
@@ -286,6 +304,9 @@ private:
   void operator=(const vtkSMSessionClient&) = delete;
 
   int NotBusy;
+  int PushTransactionDepth;
+  vtkSMMessageCollection* PendingDataServerPushes;
+  vtkSMMessageCollection* PendingRenderServerPushes;
   vtkTypeUInt32 LastGlobalID;
   vtkTypeUInt32 LastGlobalIDAvailable;
 };
@@ -38,6 +38,7 @@
 #include "vtkSMUndoStackBuilder.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringList.h"
+#include "vtkTimerLog.h"
 
 #include "vtksys/FStream.hxx"
 #include "vtksys/RegularExpression.hxx"
@@ -906,6 +907,7 @@ void vtkSMSessionProxyManager::UpdateRegisteredProxies(
     this->Internals->RegisteredProxyMap.find(groupname);
   if (it != this->Internals->RegisteredProxyMap.end())
   {
+    this->BeginPushTransaction();
     vtkSMProxyManagerProxyMapType::iterator it2 = it->second.begin();
     for (; it2 != it->second.end(); it2++)
     {
@@ -922,6 +924,7 @@ void vtkSMSessionProxyManager::UpdateRegisteredProxies(
         }
       }
     }
+    this->EndPushTransaction();
   }
 }
 
@@ -929,6 +932,7 @@ void vtkSMSessionProxyManager::UpdateRegisteredProxies(
 void vtkSMSessionProxyManager::UpdateRegisteredProxies(int modified_only /*=1*/)
 {
   vtksys::RegularExpression prototypesRe("_prototypes$");
+  this->BeginPushTransaction();
 
   vtkSMSessionProxyManagerInternals::ProxyGroupType::iterator it =
     this->Internals->RegisteredProxyMap.begin();
@@ -958,6 +962,7 @@ void vtkSMSessionProxyManager::UpdateRegisteredProxies(int modified_only /*=1*/)
       }
     }
   }
+  this->EndPushTransaction();
 }
 
 //---------------------------------------------------------------------------
@@ -976,6 +981,24 @@ void vtkSMSessionProxyManager::UpdateProxyInOrder(vtkSMProxy* proxy)
   this->UpdateInputProxies = 0;
 }
 
+//---------------------------------------------------------------------------
+void vtkSMSessionProxyManager::BeginPushTransaction()
+{
+  if (vtkSMSession* session = this->GetSession())
+  {
+    session->BeginPushTransaction();
+  }
+}
+
+//---------------------------------------------------------------------------
+void vtkSMSessionProxyManager::EndPushTransaction()
+{
+  if (vtkSMSession* session = this->GetSession())
+  {
+    session->EndPushTransaction();
+  }
+}
+
 //---------------------------------------------------------------------------
 int vtkSMSessionProxyManager::GetNumberOfLinks()
 {
@@ -1201,9 +1224,11 @@ int vtkSMSessionProxyManager::AreProxiesModified()
 void vtkSMSessionProxyManager::LoadXMLState(
   const char* filename, vtkSMStateLoader* loader /*=nullptr*/, vtkTypeUInt32 location)
 {
+  vtkTimerLog::MarkStartEvent("vtkSMSessionProxyManager Parse State");
   const std::string contents = this->LoadString(filename, location);
   vtkPVXMLParser* parser = vtkPVXMLParser::New();
   parser->Parse(contents.c_str());
+  vtkTimerLog::MarkEndEvent("vtkSMSessionProxyManager Parse State");
 
   this->LoadXMLState(parser->GetRootElement(), loader);
   parser->Delete();
@@ -1230,7 +1255,10 @@ void vtkSMSessionProxyManager::LoadXMLState(vtkPVXMLElement* rootElement,
   {
     spLoader = loader;
   }
-  if (spLoader->LoadState(rootElement, keepOriginalIds))
+  this->BeginPushTransaction();
+  const bool loaded = spLoader->LoadState(rootElement, keepOriginalIds) != 0;
+  this->EndPushTransaction();
+  if (loaded)
   {
     vtkSMProxyManager::LoadStateInformation info;
     info.RootElement = rootElement;
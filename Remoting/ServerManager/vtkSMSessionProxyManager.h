@@ -316,6 +316,21 @@ public:
   void UpdateProxyInOrder(vtkSMProxy* proxy);
   ///@}
 
+  ///@{
+  /**
+   * Begin/End a push transaction on the session. Between these calls, the
+   * property updates pushed by vtkSMProxy::UpdateVTKObjects() on any number of
+   * proxies may be gathered and sent to the server in a single message when the
+   * transaction ends. The server applies them in the order they were pushed,
+   * which respects the dependencies among proxies. Any request that needs a
+   * reply from the server sends the pending updates first. Calls must be
+   * balanced and may be nested. Undo/redo and tracing are not affected.
+   * LoadXMLState() and UpdateRegisteredProxies() use a transaction internally.
+   */
+  void BeginPushTransaction();
+  void EndPushTransaction();
+  ///@}
+
   /**
    * Get the number of registered links with the server manager.
    */
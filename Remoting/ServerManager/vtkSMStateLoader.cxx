@@ -4,7 +4,10 @@
 
 #include "vtkClientServerStreamInstantiator.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVGeneralSettings.h"
+#include "vtkPVLogger.h"
 #include "vtkPVXMLElement.h"
+#include "vtkSMPTools.h"
 #include "vtkSMProperty.h"
 #include "vtkSMProxyLink.h"
 #include "vtkSMProxyLocator.h"
@@ -14,9 +17,13 @@
 #include "vtkSMStateVersionController.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringScanner.h"
+#include "vtkTimerLog.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 vtkObjectFactoryNewMacro(vtkSMStateLoader);
@@ -44,19 +51,89 @@ struct vtkSMStateLoaderInternals
   ProxyCreationOrderType ProxyCreationOrder;
   bool DeferProxyRegistration;
 
+  /// Proxy elements indexed by id, filled up when the state is loaded.
+  typedef std::unordered_map<vtkTypeUInt32, vtkPVXMLElement*> ProxyElementMapType;
+  ProxyElementMapType ProxyElements;
+  bool UseProxyElements;
+
+  /// Id of the proxy being created by the current wave, and the
+  /// proxies of the wave whose pipeline information has not been updated yet.
+  vtkTypeUInt32 WaveProxyId;
+  std::vector<vtkWeakPointer<vtkSMProxy>> PendingInformationUpdates;
+
   vtkSMStateLoaderInternals()
     : KeepOriginalId(false)
     , DeferProxyRegistration(false)
+    , UseProxyElements(false)
+    , WaveProxyId(0)
   {
   }
 };
 
+namespace
+{
+//---------------------------------------------------------------------------
+void UpdatePipelineInformation(vtkSMProxy* proxy)
+{
+  if (proxy->IsA("vtkSMSourceProxy"))
+  {
+    vtkSMSourceProxy::SafeDownCast(proxy)->UpdatePipelineInformation();
+  }
+  else if (proxy->IsA("vtkSMImporterProxy"))
+  {
+    proxy->UpdatePipelineInformation();
+  }
+}
+
+//---------------------------------------------------------------------------
+// Indexes the proxy elements under root, giving precedence to the same
+// element vtkSMStateLoader::LocateProxyElementInternal() would find.
+void IndexProxyElements(
+  vtkPVXMLElement* root, vtkSMStateLoaderInternals::ProxyElementMapType& proxyElements)
+{
+  const unsigned int numElems = root->GetNumberOfNestedElements();
+  for (unsigned int i = 0; i < numElems; i++)
+  {
+    vtkPVXMLElement* currentElement = root->GetNestedElement(i);
+    vtkIdType id;
+    if (currentElement->GetName() && strcmp(currentElement->GetName(), "Proxy") == 0 &&
+      currentElement->GetScalarAttribute("id", &id))
+    {
+      proxyElements.emplace(static_cast<vtkTypeUInt32>(id), currentElement);
+    }
+  }
+  for (unsigned int i = 0; i < numElems; i++)
+  {
+    IndexProxyElements(root->GetNestedElement(i), proxyElements);
+  }
+}
+
+//---------------------------------------------------------------------------
+// Collects the ids of the proxies referred to by the properties (and their
+// domains) of a proxy element.
+void CollectProxyReferences(vtkPVXMLElement* element, std::vector<vtkTypeUInt32>& references)
+{
+  for (unsigned int i = 0, numElems = element->GetNumberOfNestedElements(); i < numElems; i++)
+  {
+    vtkPVXMLElement* currentElement = element->GetNestedElement(i);
+    int id;
+    if (currentElement->GetName() && strcmp(currentElement->GetName(), "Proxy") == 0 &&
+      currentElement->GetScalarAttribute("value", &id) && id != 0)
+    {
+      references.push_back(static_cast<vtkTypeUInt32>(id));
+    }
+    CollectProxyReferences(currentElement, references);
+  }
+}
+}
+
 //---------------------------------------------------------------------------
 vtkSMStateLoader::vtkSMStateLoader()
 {
   this->Internal = new vtkSMStateLoaderInternals;
   this->ServerManagerStateElement = nullptr;
   this->KeepIdMapping = 0;
+  this->LoadInWaves = vtkPVGeneralSettings::GetInstance()->GetLoadStateInWaves();
   this->ProxyLocator = vtkSMProxyLocator::New();
 }
 
@@ -207,13 +284,15 @@ void vtkSMStateLoader::CreatedNewProxy(vtkTypeUInt32 id, vtkSMProxy* proxy)
 
   // Calling UpdateVTKObjects() will assign the proxy a GlobalId, if needed.
   proxy->UpdateVTKObjects();
-  if (proxy->IsA("vtkSMSourceProxy"))
+  if (this->Internal->WaveProxyId != 0 && this->Internal->WaveProxyId == id)
   {
-    vtkSMSourceProxy::SafeDownCast(proxy)->UpdatePipelineInformation();
+    // The proxies of a wave do not depend on each other, their pipeline
+    // information is updated once the whole wave is created.
+    this->Internal->PendingInformationUpdates.emplace_back(proxy);
   }
-  else if (proxy->IsA("vtkSMImporterProxy"))
+  else
   {
-    proxy->UpdatePipelineInformation();
+    ::UpdatePipelineInformation(proxy);
   }
   if (this->Internal->DeferProxyRegistration)
   {
@@ -305,6 +384,11 @@ bool vtkSMStateLoader::UpdateRegistrationInfo(
 //---------------------------------------------------------------------------
 vtkPVXMLElement* vtkSMStateLoader::LocateProxyElement(vtkTypeUInt32 id)
 {
+  if (this->Internal->UseProxyElements)
+  {
+    auto iter = this->Internal->ProxyElements.find(id);
+    return iter != this->Internal->ProxyElements.end() ? iter->second : nullptr;
+  }
   return this->LocateProxyElementInternal(this->ServerManagerStateElement, id);
 }
 
@@ -530,9 +614,16 @@ int vtkSMStateLoader::LoadState(vtkPVXMLElement* elem, bool keepOriginalId)
   }
 
   this->ProxyLocator->SetDeserializer(this);
+  pxm->BeginPushTransaction();
   int ret = this->LoadStateInternal(elem);
+  pxm->EndPushTransaction();
   this->ProxyLocator->SetDeserializer(nullptr);
 
+  this->Internal->ProxyElements.clear();
+  this->Internal->UseProxyElements = false;
+  this->Internal->WaveProxyId = 0;
+  this->Internal->PendingInformationUpdates.clear();
+
   // BUG #10650. When animation scene time ranges are read from the state, they
   // often override those that the timekeeper painstakingly computed. Here we
   // explicitly trigger the timekeeper so that the scene re-determines the
@@ -562,6 +653,7 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
     }
   }
 
+  vtkTimerLog::MarkStartEvent("vtkSMStateLoader Convert State");
   vtkSMStateVersionController* converter = vtkSMStateVersionController::New();
   if (!converter->Process(parent, this->GetSession()))
   {
@@ -569,6 +661,7 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
                     "version successfully");
   }
   converter->Delete();
+  vtkTimerLog::MarkEndEvent("vtkSMStateLoader Convert State");
 
   if (!this->VerifyXMLVersion(rootElement))
   {
@@ -577,6 +670,14 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
 
   this->ServerManagerStateElement = rootElement;
 
+  // Index the proxy elements once, LocateProxyElement() would otherwise search
+  // the whole tree for every proxy.
+  vtkTimerLog::MarkStartEvent("vtkSMStateLoader Index Proxies");
+  this->Internal->ProxyElements.clear();
+  ::IndexProxyElements(rootElement, this->Internal->ProxyElements);
+  this->Internal->UseProxyElements = true;
+  vtkTimerLog::MarkEndEvent("vtkSMStateLoader Index Proxies");
+
   unsigned int numElems = rootElement->GetNumberOfNestedElements();
   unsigned int i;
   for (i = 0; i < numElems; i++)
@@ -620,6 +721,11 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
   // present and registered.
   std::vector<vtkSmartPointer<vtkPVXMLElement>> deferredCollections;
   this->Internal->DeferProxyRegistration = true;
+  vtkTimerLog::MarkStartEvent("vtkSMStateLoader Create Proxies");
+  if (this->LoadInWaves)
+  {
+    this->CreateProxiesInWaves(rootElement);
+  }
   for (i = 0; i < numElems; i++)
   {
     vtkPVXMLElement* currentElement = rootElement->GetNestedElement(i);
@@ -637,9 +743,11 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
       }
     }
   }
+  vtkTimerLog::MarkEndEvent("vtkSMStateLoader Create Proxies");
 
   // Register proxies in order they were created (as that's a good dependency
   // order).
+  vtkTimerLog::MarkStartEvent("vtkSMStateLoader Register Proxies");
   for (vtkSMStateLoaderInternals::ProxyCreationOrderType::const_iterator iter =
          this->Internal->ProxyCreationOrder.begin();
        iter != this->Internal->ProxyCreationOrder.end(); ++iter)
@@ -647,9 +755,11 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
     this->RegisterProxy(iter->first, iter->second);
   }
   this->Internal->ProxyCreationOrder.clear();
+  vtkTimerLog::MarkEndEvent("vtkSMStateLoader Register Proxies");
 
   // Now handle animation and timekeeper collections. This time, we let the
   // proxies be registered as needed.
+  vtkTimerLog::MarkStartEvent("vtkSMStateLoader Create Animation Proxies");
   this->Internal->DeferProxyRegistration = false;
   for (size_t cc = 0; cc < deferredCollections.size(); ++cc)
   {
@@ -659,8 +769,10 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
     }
   }
   assert(this->Internal->ProxyCreationOrder.size() == 0);
+  vtkTimerLog::MarkEndEvent("vtkSMStateLoader Create Animation Proxies");
 
   // Process link elements.
+  vtkTimerLog::MarkStartEvent("vtkSMStateLoader Load Links");
   for (i = 0; i < numElems; i++)
   {
     vtkPVXMLElement* currentElement = rootElement->GetNestedElement(i);
@@ -694,6 +806,7 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
       }
     }
   }
+  vtkTimerLog::MarkEndEvent("vtkSMStateLoader Load Links");
 
   // If KeepIdMapping
   this->Internal->AlignedMappingIdTable.clear();
@@ -721,10 +834,149 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* parent)
   return 1;
 }
 
+//---------------------------------------------------------------------------
+int vtkSMStateLoader::CreateProxiesInWaves(vtkPVXMLElement* rootElement)
+{
+  // Build the dependency graph of all the proxy elements. The references of
+  // each element are collected on multiple threads, the XML tree is only read.
+  vtkTimerLog::MarkStartEvent("vtkSMStateLoader Build Proxy Dependencies");
+  std::vector<vtkPVXMLElement*> elements;
+  std::unordered_map<vtkTypeUInt32, size_t> nodes;
+  elements.reserve(this->Internal->ProxyElements.size());
+  for (const auto& item : this->Internal->ProxyElements)
+  {
+    nodes[item.first] = elements.size();
+    elements.push_back(item.second);
+  }
+  std::vector<std::vector<vtkTypeUInt32>> references(elements.size());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(elements.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        ::CollectProxyReferences(elements[cc], references[cc]);
+      }
+    });
+
+  // Assign each proxy a wave: one more than the highest wave of the proxies
+  // it depends on. Proxies that are part of a cycle are left out (-1).
+  std::vector<std::vector<size_t>> dependents(elements.size());
+  std::vector<size_t> numberOfDependencies(elements.size(), 0);
+  for (size_t cc = 0; cc < elements.size(); ++cc)
+  {
+    std::sort(references[cc].begin(), references[cc].end());
+    references[cc].erase(
+      std::unique(references[cc].begin(), references[cc].end()), references[cc].end());
+    for (vtkTypeUInt32 reference : references[cc])
+    {
+      auto iter = nodes.find(reference);
+      if (iter != nodes.end() && iter->second != cc)
+      {
+        dependents[iter->second].push_back(cc);
+        ++numberOfDependencies[cc];
+      }
+    }
+  }
+  std::vector<int> waves(elements.size(), -1);
+  std::vector<size_t> current;
+  for (size_t cc = 0; cc < elements.size(); ++cc)
+  {
+    if (numberOfDependencies[cc] == 0)
+    {
+      current.push_back(cc);
+    }
+  }
+  for (int wave = 0; !current.empty(); ++wave)
+  {
+    std::vector<size_t> next;
+    for (size_t node : current)
+    {
+      waves[node] = wave;
+      for (size_t dependent : dependents[node])
+      {
+        if (--numberOfDependencies[dependent] == 0)
+        {
+          next.push_back(dependent);
+        }
+      }
+    }
+    current.swap(next);
+  }
+
+  // The proxies to create, in the order in which the collections list them.
+  std::vector<std::pair<int, vtkTypeUInt32>> proxies;
+  std::unordered_set<vtkTypeUInt32> listed;
+  for (unsigned int i = 0, numElems = rootElement->GetNumberOfNestedElements(); i < numElems; i++)
+  {
+    vtkPVXMLElement* collectionElement = rootElement->GetNestedElement(i);
+    const char* name = collectionElement->GetName();
+    if (name == nullptr || strcmp(name, "ProxyCollection") != 0)
+    {
+      continue;
+    }
+    const char* group_name = collectionElement->GetAttributeOrEmpty("name");
+    if (strcmp(group_name, "animation") == 0 || strcmp(group_name, "timekeeper") == 0)
+    {
+      continue;
+    }
+    for (unsigned int j = 0, numItems = collectionElement->GetNumberOfNestedElements();
+         j < numItems; j++)
+    {
+      vtkPVXMLElement* currentElement = collectionElement->GetNestedElement(j);
+      int id;
+      if (currentElement->GetName() && strcmp(currentElement->GetName(), "Item") == 0 &&
+        currentElement->GetScalarAttribute("id", &id))
+      {
+        auto iter = nodes.find(static_cast<vtkTypeUInt32>(id));
+        if (iter != nodes.end() && listed.insert(iter->first).second)
+        {
+          // Proxies in cycles are created last.
+          const int wave = waves[iter->second];
+          proxies.emplace_back(wave >= 0 ? wave : VTK_INT_MAX, iter->first);
+        }
+      }
+    }
+  }
+  std::stable_sort(proxies.begin(), proxies.end(),
+    [](const std::pair<int, vtkTypeUInt32>& a, const std::pair<int, vtkTypeUInt32>& b)
+    { return a.first < b.first; });
+  vtkTimerLog::MarkEndEvent("vtkSMStateLoader Build Proxy Dependencies");
+
+  // Create the proxies wave by wave. The pipeline information of the proxies
+  // of a wave is updated after all of them have been created and pushed.
+  int numberOfWaves = 0;
+  size_t cc = 0;
+  while (cc < proxies.size())
+  {
+    const int wave = proxies[cc].first;
+    const bool deferInformation = wave != VTK_INT_MAX;
+    for (; cc < proxies.size() && proxies[cc].first == wave; ++cc)
+    {
+      this->Internal->WaveProxyId = deferInformation ? proxies[cc].second : 0;
+      this->ProxyLocator->LocateProxy(proxies[cc].second);
+    }
+    this->Internal->WaveProxyId = 0;
+    for (const auto& proxy : this->Internal->PendingInformationUpdates)
+    {
+      if (proxy)
+      {
+        ::UpdatePipelineInformation(proxy);
+      }
+    }
+    this->Internal->PendingInformationUpdates.clear();
+    ++numberOfWaves;
+  }
+
+  vtkVLogF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "created %d proxies in %d waves",
+    static_cast<int>(proxies.size()), numberOfWaves);
+  return numberOfWaves;
+}
+
 //---------------------------------------------------------------------------
 void vtkSMStateLoader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "LoadInWaves: " << this->LoadInWaves << endl;
 }
 
 //---------------------------------------------------------------------------
@@ -65,6 +65,21 @@ public:
    */
   vtkTypeUInt32* GetMappingArray(int& size);
 
+  ///@{
+  /**
+   * When set to true, LoadState() builds the dependency graph of the proxies
+   * from the proxies their properties refer to, scanning the proxy elements on
+   * multiple threads. Proxies are then created in waves of proxies that do not
+   * depend on each other, lower waves first, and the pipeline information of
+   * the proxies of a wave is updated once the whole wave has been created so
+   * that their property updates are pushed to the server together.
+   * The default is the LoadStateInWaves setting of vtkPVGeneralSettings.
+   */
+  vtkSetMacro(LoadInWaves, bool);
+  vtkGetMacro(LoadInWaves, bool);
+  vtkBooleanMacro(LoadInWaves, bool);
+  ///@}
+
 protected:
   vtkSMStateLoader();
   ~vtkSMStateLoader() override;
@@ -150,9 +165,17 @@ protected:
    */
   vtkSMProxy* LocateExistingProxyUsingRegistrationName(vtkTypeUInt32 id);
 
+  /**
+   * Used when LoadInWaves is true. Creates the proxies listed in the proxy collections of
+   * the root element, except the "animation" and "timekeeper" ones, in waves
+   * following their dependencies. Returns the number of waves.
+   */
+  int CreateProxiesInWaves(vtkPVXMLElement* rootElement);
+
   vtkPVXMLElement* ServerManagerStateElement;
   vtkSMProxyLocator* ProxyLocator;
   int KeepIdMapping;
+  bool LoadInWaves;
 
 private:
   vtkSMStateLoader(const vtkSMStateLoader&) = delete;
@@ -82,6 +82,11 @@ public:
   }
 };
 
+// The version states are converted to by the last converter of
+// vtkSMStateVersionController::Process(). States at this version or newer need
+// no conversion. Update it when adding a converter.
+const vtkSMVersion LatestConvertedVersion(6, 2, 0);
+
 //===========================================================================
 // Helper functions
 //===========================================================================
@@ -2812,6 +2817,13 @@ bool vtkSMStateVersionController::Process(vtkPVXMLElement* parent, vtkSMSession*
     version = vtkSMVersion(4, 2, 0);
   }
 
+  // States from the current version need no conversion. Skip the round trip
+  // through pugixml, which is expensive for large states.
+  if (!(version < LatestConvertedVersion))
+  {
+    return true;
+  }
+
   // A little hackish for now, convert vtkPVXMLElement to string.
   std::ostringstream stream;
   root->PrintXML(stream, vtkIndent());
@@ -2908,11 +2920,11 @@ bool vtkSMStateVersionController::Process(vtkPVXMLElement* parent, vtkSMSession*
     version = vtkSMVersion(6, 1, 0);
   }
 
-  if (status && (version < vtkSMVersion(6, 2, 0)))
+  if (status && (version < LatestConvertedVersion))
   {
     Process_6_1_to_6_2 converter;
     status = converter(document);
-    version = vtkSMVersion(6, 2, 0);
+    version = LatestConvertedVersion;
   }
 
   if (status)
@@ -119,6 +119,7 @@ void vtkPVGeneralSettings::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "CacheGeometryForAnimation: " << this->CacheGeometryForAnimation << "\n";
   os << indent << "DefaultViewType: " << this->DefaultViewType << "\n";
   os << indent << "InterfaceLanguage: " << this->InterfaceLanguage << "\n";
+  os << indent << "LoadStateInWaves: " << this->LoadStateInWaves << "\n";
   os << indent << "LockPanels: " << this->LockPanels << "\n";
   os << indent << "PreservePropertyValues: " << this->PreservePropertyValues << "\n";
   os << indent << "PropertiesPanelMode: " << this->PropertiesPanelMode << "\n";
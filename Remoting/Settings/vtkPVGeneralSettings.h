@@ -145,7 +145,9 @@ public:
 
   ///@{
   /**
-   * Set the animation cache limit in KBs.
+   * Set the animation cache limit in KBs. When geometry caching is enabled,
+   * views evict the least recently used timesteps when the cache exceeds this
+   * limit on any rank. 0 (default) means no limit.
    */
   vtkSetMacro(AnimationGeometryCacheLimit, unsigned long);
   vtkGetMacro(AnimationGeometryCacheLimit, unsigned long);
@@ -295,6 +297,17 @@ public:
   vtkBooleanMacro(LoadAllVariables, bool);
   ///@}
 
+  ///@{
+  /**
+   * Create the proxies of a state file in waves of proxies that do not depend
+   * on each other, and push the properties of each wave together. This is the
+   * default value of vtkSMStateLoader::LoadInWaves.
+   */
+  vtkSetMacro(LoadStateInWaves, bool);
+  vtkGetMacro(LoadStateInWaves, bool);
+  vtkBooleanMacro(LoadStateInWaves, bool);
+  ///@}
+
   ///@{
   /**
    * Load no variables when showing a 2D chart.
@@ -413,6 +426,7 @@ private:
   bool IgnoreNegativeLogAxisWarning = false;
   bool InheritRepresentationProperties = false;
   bool LoadNoChartVariables = false;
+  bool LoadStateInWaves = false;
 };
 
 #endif
@@ -0,0 +1,189 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkAlgorithm.h"
+#include "vtkDataArray.h"
+#include "vtkDataObject.h"
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPVArrayInformation.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVDataSetAttributesInformation.h"
+#include "vtkProcessModule.h"
+#include "vtkSMColorMapEditorHelper.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSMTransferFunctionProxy.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+vtkSmartPointer<vtkSMSourceProxy> CreateProxy(
+  vtkSMSession* session, const char* xmlgroup, const char* xmlname)
+{
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+  vtkSmartPointer<vtkSMSourceProxy> proxy;
+  proxy.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy(xmlgroup, xmlname)));
+  vtkNew<vtkSMParaViewPipelineController> controller;
+  controller->InitializeProxy(proxy);
+  return proxy;
+}
+
+// Histogram of the wavelet scalars computed directly with the given number of bins.
+vtkSmartPointer<vtkTable> ComputeDirectHistogram(
+  vtkSMSession* session, vtkSMSourceProxy* wavelet, int binCount, const double range[2])
+{
+  vtkSmartPointer<vtkSMSourceProxy> histogram = CreateProxy(session, "filters", "ExtractHistogram");
+  vtkSMPropertyHelper(histogram, "Input").Set(wavelet);
+  vtkSMPropertyHelper(histogram, "SelectInputArray")
+    .SetInputArrayToProcess(vtkDataObject::POINT, "RTData");
+  vtkSMPropertyHelper(histogram, "BinCount").Set(binCount);
+  vtkSMPropertyHelper(histogram, "BaseBinCount").Set(0);
+  vtkSMPropertyHelper(histogram, "UseCustomBinRanges").Set(1);
+  vtkSMPropertyHelper(histogram, "CustomBinRanges").Set(range, 2);
+  histogram->UpdateVTKObjects();
+  histogram->UpdatePipeline();
+
+  vtkSmartPointer<vtkTable> result = vtkSmartPointer<vtkTable>::New();
+  result->ShallowCopy(
+    vtkAlgorithm::SafeDownCast(histogram->GetClientSideObject())->GetOutputDataObject(0));
+  return result;
+}
+
+// Compares the bins, reporting differences when a label is given. The merged bin extents are
+// averages of the fine ones and may differ from the direct ones by a rounding error, the counts
+// must be equal.
+bool SameBins(vtkTable* result, vtkTable* expected, int binCount, const char* label = nullptr)
+{
+  constexpr double extentTolerance = 1e-9;
+  if (!result || result->GetNumberOfColumns() < 2 || expected->GetNumberOfColumns() < 2)
+  {
+    if (label)
+    {
+      std::cerr << label << ": missing histogram for " << binCount << " bins" << std::endl;
+    }
+    return false;
+  }
+  for (vtkIdType column = 0; column < 2; ++column)
+  {
+    vtkDataArray* resultArray = vtkDataArray::SafeDownCast(result->GetColumn(column));
+    vtkDataArray* expectedArray = vtkDataArray::SafeDownCast(expected->GetColumn(column));
+    if (!resultArray || !expectedArray || resultArray->GetNumberOfTuples() != binCount ||
+      expectedArray->GetNumberOfTuples() != binCount)
+    {
+      if (label)
+      {
+        std::cerr << label << ": wrong number of bins for " << binCount << " bins" << std::endl;
+      }
+      return false;
+    }
+    for (vtkIdType bin = 0; bin < binCount; ++bin)
+    {
+      const double difference =
+        std::abs(resultArray->GetTuple1(bin) - expectedArray->GetTuple1(bin));
+      if (difference > (column == 0 ? extentTolerance : 0.0))
+      {
+        if (label)
+        {
+          std::cerr << label << ": column " << column << " differs at bin " << bin << " of "
+                    << binCount << ": " << resultArray->GetTuple1(bin)
+                    << " != " << expectedArray->GetTuple1(bin) << std::endl;
+        }
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+extern int TestTransferFunctionHistogramCache(int, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestTransferFunctionHistogramCache");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+  vtkNew<vtkSMSession> session;
+  vtkProcessModule::GetProcessModule()->RegisterSession(session);
+  controller->InitializeSession(session);
+
+  vtkSmartPointer<vtkSMProxy> view;
+  view.TakeReference(session->GetSessionProxyManager()->NewProxy("views", "RenderView"));
+  controller->InitializeProxy(view);
+  controller->RegisterViewProxy(view);
+
+  vtkSmartPointer<vtkSMSourceProxy> wavelet = CreateProxy(session, "sources", "RTAnalyticSource");
+  controller->RegisterPipelineProxy(wavelet);
+  wavelet->UpdatePipeline();
+
+  vtkSMProxy* representation = controller->Show(wavelet, 0, view);
+  vtkSMColorMapEditorHelper::SetScalarColoring(representation, "RTData", vtkDataObject::POINT);
+  vtkSMProxy* lut = vtkSMPropertyHelper(representation, "LookupTable").GetAsProxy();
+  vtkSMTransferFunctionProxy* transferFunction = vtkSMTransferFunctionProxy::SafeDownCast(lut);
+  if (!transferFunction)
+  {
+    std::cerr << "No transfer function for RTData." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The transfer function range stays the same, only the data changes below.
+  double range[2];
+  wavelet->GetDataInformation(0)
+    ->GetPointDataInformation()
+    ->GetArrayInformation("RTData")
+    ->GetComponentRange(0, range);
+  transferFunction->RescaleTransferFunction(range);
+
+  // The first bin count is computed, the next ones are merged from the kept 57600 bins: all of
+  // them match the histograms computed directly.
+  vtkSmartPointer<vtkTable> before;
+  for (int binCount : { 10, 256, 64, 100 })
+  {
+    vtkTable* histogram = transferFunction->ComputeDataHistogramTable(binCount);
+    vtkSmartPointer<vtkTable> expected =
+      ComputeDirectHistogram(session, wavelet, binCount, range);
+    if (!SameBins(histogram, expected, binCount, "before modification"))
+    {
+      return EXIT_FAILURE;
+    }
+    if (binCount == 64)
+    {
+      before = expected;
+    }
+  }
+
+  // Changing the data drops the kept bins, for the first bin count computed again and for the
+  // ones merged from the new kept bins.
+  vtkSMPropertyHelper(wavelet, "Maximum").Set(100.0);
+  wavelet->UpdateVTKObjects();
+  wavelet->UpdatePipeline();
+  for (int binCount : { 64, 10, 256 })
+  {
+    vtkTable* histogram = transferFunction->ComputeDataHistogramTable(binCount);
+    vtkSmartPointer<vtkTable> expected =
+      ComputeDirectHistogram(session, wavelet, binCount, range);
+    if (!SameBins(histogram, expected, binCount, "after modification"))
+    {
+      return EXIT_FAILURE;
+    }
+    if (binCount == 64 && SameBins(histogram, before, binCount))
+    {
+      std::cerr << "Modifying the data did not change the histogram." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  controller->UnRegisterProxy(wavelet);
+  controller->UnRegisterProxy(view);
+
+  vtkProcessModule::GetProcessModule()->UnRegisterSession(session);
+  vtkInitializationHelper::Finalize();
+  return EXIT_SUCCESS;
+}
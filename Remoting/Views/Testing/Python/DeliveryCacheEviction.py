@@ -0,0 +1,64 @@
+from paraview.simple import *
+from paraview import smtesting
+smtesting.ProcessCommandLineArguments()
+
+# Tests that the animation geometry cache evicts the least recently used
+# timesteps first once the cache grows beyond AnimationGeometryCacheLimit.
+
+source = TimeSource()
+view = CreateRenderView()
+Show(source, view)
+
+view.UseCache = 1
+
+def GetStatistics():
+    view.UpdatePropertyInformation()
+    hits, misses, evictions, size = view.GetProperty("DeliveryCacheStatistics")
+    return int(hits), int(misses), int(evictions), int(size)
+
+def ShowTime(t):
+    view.ViewTime = t
+    view.CacheKey = t
+    Render(view)
+    return GetStatistics()
+
+# measure the size of the data cached for a single timestep.
+_, _, _, keySize = ShowTime(0.0)
+assert keySize > 0
+
+# keep at most two timesteps in the cache.
+settings = GetSettingsProxy("GeneralSettings")
+settings.AnimationGeometryCacheLimit = int(2.5 * keySize)
+
+def Visit(t, expectHit, expectEvictions):
+    before = GetStatistics()
+    after = ShowTime(t)
+    hit = after[0] - before[0] == 1 and after[1] == before[1]
+    miss = after[1] - before[1] == 1 and after[0] == before[0]
+    assert (expectHit and hit) or (not expectHit and miss), \
+        "unexpected cache lookup for t=%g: %s -> %s" % (t, before, after)
+    assert after[2] - before[2] == expectEvictions, \
+        "unexpected evictions for t=%g: %s -> %s" % (t, before, after)
+    assert after[3] <= settings.AnimationGeometryCacheLimit
+
+ResetCacheStatistics = view.GetClientSideObject().GetDeliveryManager().ResetCacheStatistics
+ResetCacheStatistics()
+
+# cache: 0, 1
+Visit(0.1, False, 0)
+# 0 is the least recently used timestep, cache: 1, 2
+Visit(0.2, False, 1)
+# touch 1, so that 2 becomes the least recently used timestep.
+Visit(0.1, True, 0)
+# cache: 1, 3
+Visit(0.3, False, 1)
+Visit(0.1, True, 0)
+# 3 is evicted to make room for 0, then 1 to make room for 2.
+Visit(0.0, False, 1)
+Visit(0.2, False, 1)
+
+# disabling the cache must not record lookups.
+view.UseCache = 0
+before = GetStatistics()
+ShowTime(0.4)
+assert GetStatistics()[:3] == before[:3]
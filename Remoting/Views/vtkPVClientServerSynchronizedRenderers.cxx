@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPVClientServerSynchronizedRenderers.h"
 
+#include "vtkDeltaImageCompressor.h"
 #include "vtkLZ4Compressor.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
@@ -24,6 +25,7 @@ vtkPVClientServerSynchronizedRenderers::vtkPVClientServerSynchronizedRenderers()
   : Compressor(nullptr)
   , LossLessCompression(true)
   , NVPipeSupport(false)
+  , KeyFrameRequested(false)
 {
   this->ConfigureCompressor("vtkLZ4Compressor 0 3");
 }
@@ -34,6 +36,40 @@ vtkPVClientServerSynchronizedRenderers::~vtkPVClientServerSynchronizedRenderers(
   this->SetCompressor(nullptr);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::MasterStartRender()
+{
+  this->Superclass::MasterStartRender();
+
+  // let the server know whether the last image could not be decoded, so that
+  // compressors that send differences between frames resend a full frame.
+  // Both sides are configured from the same compressor configuration, so they
+  // agree on whether the request is exchanged and other compressors do not pay
+  // for the round trip.
+  if (vtkDeltaImageCompressor::SafeDownCast(this->Compressor))
+  {
+    int keyFrameRequested = this->KeyFrameRequested ? 1 : 0;
+    this->ParallelController->Send(&keyFrameRequested, 1, 1, 0x023431);
+  }
+  this->KeyFrameRequested = false;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::SlaveStartRender()
+{
+  this->Superclass::SlaveStartRender();
+
+  if (auto delta = vtkDeltaImageCompressor::SafeDownCast(this->Compressor))
+  {
+    int keyFrameRequested = 0;
+    this->ParallelController->Receive(&keyFrameRequested, 1, 1, 0x023431);
+    if (keyFrameRequested)
+    {
+      delta->ForceKeyFrame();
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
 {
@@ -53,7 +89,10 @@ void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
       vtkUnsignedCharArray* data = vtkUnsignedCharArray::New();
       this->ParallelController->Receive(data, 1, 0x023430);
       this->Compressor->SetImageResolution(header[1], header[2]);
-      this->Decompress(data, rawImage.GetRawPtr());
+      if (!this->Decompress(data, rawImage.GetRawPtr()))
+      {
+        this->KeyFrameRequested = true;
+      }
       data->Delete();
     }
     else
@@ -114,7 +153,7 @@ vtkUnsignedCharArray* vtkPVClientServerSynchronizedRenderers::Compress(vtkUnsign
 }
 
 //----------------------------------------------------------------------------
-void vtkPVClientServerSynchronizedRenderers::Decompress(
+bool vtkPVClientServerSynchronizedRenderers::Decompress(
   vtkUnsignedCharArray* data, vtkUnsignedCharArray* outputBuffer)
 {
   if (this->Compressor)
@@ -125,11 +164,14 @@ void vtkPVClientServerSynchronizedRenderers::Decompress(
     if (this->Compressor->Decompress() == 0)
     {
       vtkErrorMacro("Image de-compression failed!");
+      return false;
     }
+    return true;
   }
   else
   {
     vtkErrorMacro("No compressor present.");
+    return false;
   }
 }
 
@@ -159,6 +201,10 @@ void vtkPVClientServerSynchronizedRenderers::ConfigureCompressor(const char* str
     {
       comp = vtkLZ4Compressor::New();
     }
+    else if (className == "vtkDeltaImageCompressor")
+    {
+      comp = vtkDeltaImageCompressor::New();
+    }
     else if (className == "vtkNvPipeCompressor" && this->NVPipeSupport)
     {
 #if VTK_MODULE_ENABLE_ParaView_nvpipe
@@ -60,7 +60,18 @@ protected:
   ///@}
 
   vtkUnsignedCharArray* Compress(vtkUnsignedCharArray*);
-  void Decompress(vtkUnsignedCharArray* input, vtkUnsignedCharArray* outputBuffer);
+  bool Decompress(vtkUnsignedCharArray* input, vtkUnsignedCharArray* outputBuffer);
+
+  ///@{
+  /**
+   * Overridden to forward the client's keyframe requests to the server. The
+   * client requests a keyframe when it failed to decompress the last image,
+   * e.g. when a vtkDeltaImageCompressor frame does not apply to the last
+   * decoded frame, which makes the server compressor send a full frame.
+   */
+  void MasterStartRender() override;
+  void SlaveStartRender() override;
+  ///@}
 
   void MasterEndRender() override;
   void SlaveEndRender() override;
@@ -68,6 +79,7 @@ protected:
   vtkImageCompressor* Compressor;
   bool LossLessCompression;
   bool NVPipeSupport;
+  bool KeyFrameRequested;
 
 private:
   vtkPVClientServerSynchronizedRenderers(const vtkPVClientServerSynchronizedRenderers&) = delete;
@@ -13,6 +13,16 @@
 #include "vtkSmartPointer.h"
 #include "vtkWeakPointer.h"
 
+namespace
+{
+// Cache keys are only tracked when the pieces are kept across cache keys, i.e.
+// when the view (or the representation itself) uses the cache.
+bool IsUsingCache(vtkPVDataRepresentation* repr, vtkPVView* view)
+{
+  return repr->GetForceUseCache() || (view != nullptr && view->GetUseCache());
+}
+}
+
 //*****************************************************************************
 //----------------------------------------------------------------------------
 vtkPVDataDeliveryManager::vtkPVDataDeliveryManager()
@@ -98,6 +108,10 @@ void vtkPVDataDeliveryManager::SetPiece(vtkPVDataRepresentation* repr, vtkDataOb
   if (item)
   {
     const auto cacheKey = this->GetCacheKey(repr);
+    if (::IsUsingCache(repr, this->GetView()))
+    {
+      this->Internals->TouchCacheKey(cacheKey);
+    }
     if (item->GetDataObject(cacheKey) == nullptr ||
       repr->GetPipelineDataTime() > item->GetTimeStamp())
     {
@@ -140,11 +154,24 @@ bool vtkPVDataDeliveryManager::HasPiece(vtkPVDataRepresentation* repr, bool low_
     this->Internals->GetItem(repr, low_res, port, /*create_if_needed=*/false);
   const auto cacheKey = this->GetCacheKey(repr);
   const bool val = item ? (item->GetDataObject(cacheKey) != nullptr) : false;
-
   vtkLogF(TRACE, "HasPiece %s (key=%g) : %d", repr->GetLogName().c_str(), cacheKey, val);
   return val;
 }
 
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::RecordCacheLookup(vtkPVDataRepresentation* repr, bool hit)
+{
+  if (hit)
+  {
+    this->Internals->TouchCacheKey(this->GetCacheKey(repr));
+    ++this->Internals->CacheHits;
+  }
+  else
+  {
+    ++this->Internals->CacheMisses;
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkDataObject* vtkPVDataDeliveryManager::GetDeliveredPiece(
   vtkPVDataRepresentation* repr, bool low_res, int port)
@@ -169,6 +196,10 @@ vtkAlgorithmOutput* vtkPVDataDeliveryManager::GetProducer(
 
   const int dataKey = this->GetDeliveredDataKey(low_res);
   const auto cacheKey = this->GetCacheKey(repr);
+  if (::IsUsingCache(repr, this->GetView()))
+  {
+    this->Internals->TouchCacheKey(cacheKey);
+  }
   return item->GetProducer(dataKey, cacheKey)->GetOutputPort(0);
 }
 
@@ -285,8 +316,79 @@ void vtkPVDataDeliveryManager::ClearCache(vtkPVDataRepresentation* repr)
   this->Internals->ClearCache(repr);
 }
 
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetCacheSize()
+{
+  return this->Internals->GetCacheSize();
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetNumberOfCacheKeysToEvict(vtkTypeUInt64 limit)
+{
+  auto& internals = (*this->Internals);
+  vtkTypeUInt64 size = internals.GetCacheSize();
+  vtkTypeUInt64 count = 0;
+  for (const double cacheKey : internals.GetEvictableCacheKeys(this))
+  {
+    if (size <= limit)
+    {
+      break;
+    }
+    const vtkTypeUInt64 keySize = internals.GetCacheSize(cacheKey);
+    size = keySize < size ? size - keySize : 0;
+    ++count;
+  }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::EvictCacheKeys(vtkTypeUInt64 count)
+{
+  auto& internals = (*this->Internals);
+  for (const double cacheKey : internals.GetEvictableCacheKeys(this))
+  {
+    if (count == 0)
+    {
+      break;
+    }
+    vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "evict cache key %g (%llu KiB)", cacheKey,
+      static_cast<unsigned long long>(internals.GetCacheSize(cacheKey)));
+    internals.EvictCacheKey(cacheKey);
+    --count;
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetNumberOfCacheHits() const
+{
+  return this->Internals->CacheHits;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetNumberOfCacheMisses() const
+{
+  return this->Internals->CacheMisses;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetNumberOfCacheEvictions() const
+{
+  return this->Internals->CacheEvictions;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::ResetCacheStatistics()
+{
+  this->Internals->CacheHits = 0;
+  this->Internals->CacheMisses = 0;
+  this->Internals->CacheEvictions = 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataDeliveryManager::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfCacheHits: " << this->Internals->CacheHits << endl;
+  os << indent << "NumberOfCacheMisses: " << this->Internals->CacheMisses << endl;
+  os << indent << "NumberOfCacheEvictions: " << this->Internals->CacheEvictions << endl;
 }
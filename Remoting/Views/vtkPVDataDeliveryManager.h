@@ -79,6 +79,14 @@ public:
   bool HasPiece(vtkPVDataRepresentation* repr, bool low_res = false, int port = 0);
   ///@}
 
+  /**
+   * Called once per update request by a representation that uses the cache,
+   * after checking whether its data for the current cache key is available.
+   * Updates the cache statistics and, on a hit, marks the cache key as
+   * recently used.
+   */
+  void RecordCacheLookup(vtkPVDataRepresentation* repr, bool hit);
+
   /**
    * Returns the local data object set by calling `SetPiece` (or from the
    * cache). This is the data object pre-delivery.
@@ -95,6 +103,40 @@ public:
    */
   void ClearCache(vtkPVDataRepresentation* repr);
 
+  /**
+   * Returns the memory used by all pieces stored by this manager, for all cache
+   * keys, in KiB. This includes data delivered to this process.
+   */
+  vtkTypeUInt64 GetCacheSize();
+
+  /**
+   * Returns the number of cache keys that must be evicted, least-recently-used
+   * first, for the memory used by the cache to fit within `limit` KiB. Cache
+   * keys currently used by a representation are never evicted, hence it may
+   * not be possible to fit within the limit.
+   */
+  vtkTypeUInt64 GetNumberOfCacheKeysToEvict(vtkTypeUInt64 limit);
+
+  /**
+   * Evicts up to `count` least-recently-used cache keys, releasing the pieces
+   * stored for them for all representations. Cache keys currently used by a
+   * representation are never evicted.
+   */
+  void EvictCacheKeys(vtkTypeUInt64 count);
+
+  ///@{
+  /**
+   * Cache statistics. A hit or miss is counted by RecordCacheLookup(), i.e.
+   * once every time a representation using the cache checks whether it can
+   * skip updating because its data for the current cache key is available.
+   * Evictions are counted per cache key evicted using EvictCacheKeys().
+   */
+  vtkTypeUInt64 GetNumberOfCacheHits() const;
+  vtkTypeUInt64 GetNumberOfCacheMisses() const;
+  vtkTypeUInt64 GetNumberOfCacheEvictions() const;
+  void ResetCacheStatistics();
+  ///@}
+
   ///@{
   /**
    * Provides access to the producer port for the geometry of a registered
@@ -14,9 +14,12 @@
 #include "vtkWeakPointer.h"          // for vtkWeakPointer
 
 #include <cassert> // for assert
+#include <list>    // for std::list
 #include <map>     // for std::map
 #include <numeric> // for std::accumulate
+#include <set>     // for std::set
 #include <utility> // for std::pair
+#include <vector>  // for std::vector
 
 class vtkPVDataDeliveryManager::vtkInternals
 {
@@ -58,6 +61,9 @@ public:
     vtkMTimeType TimeStamp{ 0 };
     vtkMTimeType ActualMemorySize{ 0 };
 
+    // Memory used by DataObject and DeliveredDataObjects, in KiB.
+    vtkTypeUInt64 CacheSize{ 0 };
+
     // Arbitrary meta-data container.
     vtkSmartPointer<vtkInformation> Information;
   };
@@ -73,10 +79,72 @@ public:
 
     vtkMTimeType TimeStamp{ 0 };
 
+    // Running total of the CacheSize of all stores, in KiB.
+    vtkTypeUInt64 CacheSize{ 0 };
+
+    /**
+     * Updates the memory used by a store after its data changed. Delivered
+     * data objects are counted separately from the representation's data
+     * object unless they are the same instance, so this is an upper bound when
+     * the delivered data shares arrays with it.
+     */
+    void UpdateCacheSize(vtkRepresentedData& store)
+    {
+      vtkTypeUInt64 size = store.ActualMemorySize;
+      for (const auto& dpair : store.DeliveredDataObjects)
+      {
+        if (dpair.second != nullptr && dpair.second != store.DataObject)
+        {
+          size += dpair.second->GetActualMemorySize();
+        }
+      }
+      this->CacheSize = this->CacheSize - store.CacheSize + size;
+      store.CacheSize = size;
+    }
+
   public:
     vtkItem() = default;
 
-    void ClearCache() { this->Data.clear(); }
+    void ClearCache()
+    {
+      this->Data.clear();
+      this->CacheSize = 0;
+    }
+
+    bool ClearCache(double cacheKey)
+    {
+      auto iter = this->Data.find(cacheKey);
+      if (iter == this->Data.end())
+      {
+        return false;
+      }
+      this->CacheSize -= iter->second.CacheSize;
+      this->Data.erase(iter);
+      return true;
+    }
+
+    /**
+     * Returns the memory, in KiB, used by the data cached for the given
+     * cacheKey.
+     */
+    vtkTypeUInt64 GetCacheSize(double cacheKey) const
+    {
+      auto iter = this->Data.find(cacheKey);
+      return iter != this->Data.end() ? iter->second.CacheSize : 0;
+    }
+
+    /**
+     * Returns the memory, in KiB, used by the data cached for all cache keys.
+     */
+    vtkTypeUInt64 GetCacheSize() const { return this->CacheSize; }
+
+    void GetCacheKeys(std::set<double>& keys) const
+    {
+      for (const auto& dpair : this->Data)
+      {
+        keys.insert(dpair.first);
+      }
+    }
 
     void SetDataObject(vtkDataObject* data, vtkInternals* helper, double cacheKey)
     {
@@ -104,6 +172,7 @@ public:
       // we could simply set the data too, but that can lead to other confusion as the mapper should
       // never directly see the representation's data.
       this->Producer->SetOutput(helper->GetEmptyDataObject(data));
+      this->UpdateCacheSize(store);
 
       vtkTimeStamp ts;
       ts.Modified();
@@ -115,6 +184,7 @@ public:
     {
       auto& store = this->Data[cacheKey];
       store.ActualMemorySize = size;
+      this->UpdateCacheSize(store);
     }
 
     unsigned long GetActualMemorySize(double cacheKey) const
@@ -140,6 +210,7 @@ public:
     {
       auto& store = this->Data[cacheKey];
       store.DeliveredDataObjects[dataKey] = data;
+      this->UpdateCacheSize(store);
     }
 
     vtkPVTrivialProducer* GetProducer(int dataKey, double cacheKey)
@@ -273,10 +344,133 @@ public:
         ipair.second.second.ClearCache();
       }
     }
+    this->PruneCacheKeys();
+  }
+
+  ///@{
+  /**
+   * Cache keys in least-recently-used order, most recently used last. Every
+   * access to a piece moves its cache key to the end of the list.
+   */
+  void TouchCacheKey(double cacheKey)
+  {
+    auto iter = this->CacheKeysIndex.find(cacheKey);
+    if (iter != this->CacheKeysIndex.end())
+    {
+      this->CacheKeys.splice(this->CacheKeys.end(), this->CacheKeys, iter->second);
+    }
+    else
+    {
+      this->CacheKeysIndex[cacheKey] = this->CacheKeys.insert(this->CacheKeys.end(), cacheKey);
+    }
+  }
+
+  void ForgetCacheKey(double cacheKey)
+  {
+    auto iter = this->CacheKeysIndex.find(cacheKey);
+    if (iter != this->CacheKeysIndex.end())
+    {
+      this->CacheKeys.erase(iter->second);
+      this->CacheKeysIndex.erase(iter);
+    }
+  }
+
+  // Forget the cache keys for which no item has data anymore.
+  void PruneCacheKeys()
+  {
+    std::set<double> keys;
+    for (const auto& ipair : this->ItemsMap)
+    {
+      ipair.second.first.GetCacheKeys(keys);
+      ipair.second.second.GetCacheKeys(keys);
+    }
+    for (auto iter = this->CacheKeys.begin(); iter != this->CacheKeys.end();)
+    {
+      if (keys.find(*iter) == keys.end())
+      {
+        this->CacheKeysIndex.erase(*iter);
+        iter = this->CacheKeys.erase(iter);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+  }
+  ///@}
+
+  vtkTypeUInt64 GetCacheSize(double cacheKey) const
+  {
+    vtkTypeUInt64 size = 0;
+    for (const auto& ipair : this->ItemsMap)
+    {
+      size += ipair.second.first.GetCacheSize(cacheKey);
+      size += ipair.second.second.GetCacheSize(cacheKey);
+    }
+    return size;
+  }
+
+  vtkTypeUInt64 GetCacheSize() const
+  {
+    vtkTypeUInt64 size = 0;
+    for (const auto& ipair : this->ItemsMap)
+    {
+      size += ipair.second.first.GetCacheSize();
+      size += ipair.second.second.GetCacheSize();
+    }
+    return size;
+  }
+
+  /**
+   * Returns the cache keys that may be evicted, least-recently-used first.
+   * Keys currently in use by any registered representation are never returned.
+   */
+  std::vector<double> GetEvictableCacheKeys(vtkPVDataDeliveryManager* dmgr) const
+  {
+    std::set<double> inUse;
+    for (const auto& rpair : this->RepresentationsMap)
+    {
+      if (rpair.second != nullptr)
+      {
+        inUse.insert(dmgr->GetCacheKey(rpair.second));
+      }
+    }
+
+    std::vector<double> keys;
+    for (const double cacheKey : this->CacheKeys)
+    {
+      if (inUse.find(cacheKey) == inUse.end())
+      {
+        keys.push_back(cacheKey);
+      }
+    }
+    return keys;
+  }
+
+  void EvictCacheKey(double cacheKey)
+  {
+    bool evicted = false;
+    for (auto& ipair : this->ItemsMap)
+    {
+      evicted = ipair.second.first.ClearCache(cacheKey) || evicted;
+      evicted = ipair.second.second.ClearCache(cacheKey) || evicted;
+    }
+    this->ForgetCacheKey(cacheKey);
+    if (evicted)
+    {
+      ++this->CacheEvictions;
+    }
   }
 
   ItemsMapType ItemsMap;
   RepresentationsMapType RepresentationsMap;
+
+  std::list<double> CacheKeys;
+  std::map<double, std::list<double>::iterator> CacheKeysIndex;
+
+  vtkTypeUInt64 CacheHits{ 0 };
+  vtkTypeUInt64 CacheMisses{ 0 };
+  vtkTypeUInt64 CacheEvictions{ 0 };
 };
 
 #endif // __WRAP__
@@ -11,6 +11,7 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVCompositeDataPipeline.h"
+#include "vtkPVDataDeliveryManager.h"
 #include "vtkPVDataRepresentationPipeline.h"
 #include "vtkPVTrivialProducer.h"
 #include "vtkPVView.h"
@@ -133,7 +134,12 @@ int vtkPVDataRepresentation::ProcessViewRequest(
 
     // Now, check with the view, if the data was already cached. If so, we don't
     // need to update and can skip it.
-    if (pvview->IsCached(this))
+    const bool cached = pvview->IsCached(this);
+    if ((pvview->GetUseCache() || this->ForceUseCache) && pvview->GetDeliveryManager())
+    {
+      pvview->GetDeliveryManager()->RecordCacheLookup(this, cached);
+    }
+    if (cached)
     {
       // update is needed, but we're skipping it since we have already cached
       // the update result.
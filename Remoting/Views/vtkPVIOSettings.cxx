@@ -105,4 +105,6 @@ vtkStringArray* vtkPVIOSettings::GetAllNameFilters()
 void vtkPVIOSettings::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "FileSeriesPrefetchDepth: " << this->FileSeriesPrefetchDepth << endl;
+  os << indent << "FileSeriesPrefetchMemoryLimit: " << this->FileSeriesPrefetchMemoryLimit << endl;
 }
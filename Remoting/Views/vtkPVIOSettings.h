@@ -62,6 +62,21 @@ public:
    */
   vtkStringArray* GetAllNameFilters();
 
+  ///@{
+  /**
+   * Set/get the number of files prefetched by file series readers and the
+   * memory limit, in MiB, for the prefetched files. These are passed to file
+   * series readers with a `<FileSeriesPrefetching />` hint when they are
+   * created, see
+   * `vtkFileSeriesReader::SetPrefetchDepth` and
+   * `vtkFileSeriesReader::SetPrefetchMemoryLimit`.
+   */
+  vtkSetClampMacro(FileSeriesPrefetchDepth, int, 0, VTK_INT_MAX);
+  vtkGetMacro(FileSeriesPrefetchDepth, int);
+  vtkSetClampMacro(FileSeriesPrefetchMemoryLimit, int, 0, VTK_INT_MAX);
+  vtkGetMacro(FileSeriesPrefetchMemoryLimit, int);
+  ///@}
+
 protected:
   vtkPVIOSettings();
   ~vtkPVIOSettings() override;
@@ -72,6 +87,9 @@ private:
 
   class vtkInternals;
   std::unique_ptr<vtkInternals> Internals;
+
+  int FileSeriesPrefetchDepth = 0;
+  int FileSeriesPrefetchMemoryLimit = 256;
 };
 
 #endif
@@ -31,6 +31,7 @@
 #include "vtkTimerLog.h"
 #include "vtkViewLayout.h"
 
+#include <algorithm>
 #include <cassert>
 #include <map>
 #include <sstream>
@@ -208,6 +209,7 @@ vtkPVView::vtkPVView(bool create_render_window)
   this->ViewTime = 0.0;
   this->CacheKey = 0.0;
   this->UseCache = false;
+  std::fill_n(this->DeliveryCacheStatistics, 4, 0.0);
 
   this->RequestInformation = vtkInformation::New();
   this->ReplyInformationVector = vtkInformationVector::New();
@@ -428,6 +430,7 @@ void vtkPVView::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ViewTime: " << this->ViewTime << endl;
   os << indent << "CacheKey: " << this->CacheKey << endl;
   os << indent << "UseCache: " << this->UseCache << endl;
+  os << indent << "DeliveryCacheLimit: " << this->DeliveryCacheLimit << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -466,6 +469,11 @@ void vtkPVView::Update()
     }
   }
 
+  // cache lookups miss on all processes together, since the representations
+  // update on all of them, so the cache grows on all processes or on none.
+  const vtkTypeUInt64 cacheMisses =
+    this->DeliveryManager ? this->DeliveryManager->GetNumberOfCacheMisses() : 0;
+
   vtkTimerLog::MarkStartEvent("vtkPVView::Update");
   const int count = this->CallProcessViewRequest(
     vtkPVView::REQUEST_UPDATE(), this->RequestInformation, this->ReplyInformationVector);
@@ -478,9 +486,54 @@ void vtkPVView::Update()
     this->SynchronizeRepresentationTemporalPipelineStates();
   }
 
+  if (this->UseCache)
+  {
+    this->EnforceDeliveryCacheLimit(
+      this->DeliveryManager && this->DeliveryManager->GetNumberOfCacheMisses() != cacheMisses);
+  }
+
   this->UpdateTimeStamp.Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVView::EnforceDeliveryCacheLimit(bool cacheGrew)
+{
+  // The limit comes from the client with the update request and the cache
+  // grows on all processes together, so all processes skip the reduction or
+  // none does. The cache cannot exceed an unchanged limit without growing.
+  const vtkTypeUInt64 limit = this->DeliveryCacheLimit;
+  const bool limitChanged = limit != this->EnforcedDeliveryCacheLimit;
+  this->EnforcedDeliveryCacheLimit = limit;
+  if (limit == 0 || !this->DeliveryManager || (!cacheGrew && !limitChanged))
+  {
+    return;
+  }
+
+  const vtkTypeUInt64 localCount = this->DeliveryManager->GetNumberOfCacheKeysToEvict(limit);
+  vtkTypeUInt64 count = 0;
+  this->AllReduce(localCount, count, vtkCommunicator::MAX_OP);
+  if (count > 0)
+  {
+    vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(),
+      "%s: evicting %llu cache keys (limit=%llu KiB)", this->GetLogName().c_str(),
+      static_cast<unsigned long long>(count), static_cast<unsigned long long>(limit));
+    this->DeliveryManager->EvictCacheKeys(count);
+  }
+}
+
+//----------------------------------------------------------------------------
+double* vtkPVView::GetDeliveryCacheStatistics()
+{
+  if (auto dmgr = this->DeliveryManager)
+  {
+    this->DeliveryCacheStatistics[0] = static_cast<double>(dmgr->GetNumberOfCacheHits());
+    this->DeliveryCacheStatistics[1] = static_cast<double>(dmgr->GetNumberOfCacheMisses());
+    this->DeliveryCacheStatistics[2] = static_cast<double>(dmgr->GetNumberOfCacheEvictions());
+    this->DeliveryCacheStatistics[3] = static_cast<double>(dmgr->GetCacheSize());
+  }
+  return this->DeliveryCacheStatistics;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVView::SynchronizeRepresentationTemporalPipelineStates()
 {
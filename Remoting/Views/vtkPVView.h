@@ -113,6 +113,26 @@ public:
   vtkGetMacro(UseCache, bool);
   ///@}
 
+  ///@{
+  /**
+   * Get/Set the size limit, in KiB, of the data-delivery cache on each
+   * process. 0 means unlimited. vtkSMViewProxy passes the client's
+   * vtkPVGeneralSettings::GetAnimationGeometryCacheLimit() with each update so
+   * that all processes use the same limit.
+   * \note CallOnAllProcesses
+   */
+  vtkSetMacro(DeliveryCacheLimit, vtkTypeUInt64);
+  vtkGetMacro(DeliveryCacheLimit, vtkTypeUInt64);
+  ///@}
+
+  /**
+   * Returns statistics about the data-delivery cache on this process as
+   * (hits, misses, evictions, size in KiB). The cache is limited to
+   * DeliveryCacheLimit KiB on every process when that limit is non-zero;
+   * least-recently-used cache keys are evicted first.
+   */
+  double* GetDeliveryCacheStatistics() VTK_SIZEHINT(4);
+
   ///@{
   /**
    * These methods are used to setup the view for capturing screen shots.
@@ -355,6 +375,9 @@ protected:
   double ViewTime;
   double CacheKey;
   bool UseCache;
+  vtkTypeUInt64 DeliveryCacheLimit = 0;
+  vtkTypeUInt64 EnforcedDeliveryCacheLimit = 0;
+  double DeliveryCacheStatistics[4];
 
   int Size[2];
   int Position[2];
@@ -373,6 +396,16 @@ protected:
    */
   void SynchronizeRepresentationTemporalPipelineStates();
 
+  /**
+   * Called in Update() when caching is enabled to evict least-recently-used
+   * cache keys from the delivery manager until the cache fits within
+   * DeliveryCacheLimit. The number of keys to evict is reduced across all
+   * processes so that all ranks keep the same cache keys and hence skip the
+   * same updates. The reduction only happens when `cacheGrew` is true or the
+   * limit changed, which all processes agree on.
+   */
+  void EnforceDeliveryCacheLimit(bool cacheGrew);
+
 private:
   vtkPVView(const vtkPVView&) = delete;
   void operator=(const vtkPVView&) = delete;
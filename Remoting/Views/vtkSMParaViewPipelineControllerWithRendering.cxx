@@ -2,12 +2,14 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkSMParaViewPipelineControllerWithRendering.h"
 
+#include "vtkClientServerStream.h"
 #include "vtkCollection.h"
 #include "vtkErrorCode.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVDataInformation.h"
 #include "vtkPVGeneralSettings.h"
+#include "vtkPVIOSettings.h"
 #include "vtkPVXMLElement.h"
 #include "vtkProcessModule.h"
 #include "vtkSMColorMapEditorHelper.h"
@@ -17,6 +19,7 @@
 #include "vtkSMProxyManager.h"
 #include "vtkSMProxyProperty.h"
 #include "vtkSMRepresentationProxy.h"
+#include "vtkSMSession.h"
 #include "vtkSMSessionProxyManager.h"
 #include "vtkSMSourceProxy.h"
 #include "vtkSMTrace.h"
@@ -48,6 +51,25 @@ public:
   }
   ~vtkScopedSet() { this->Ref = this->OldVal; }
 };
+//---------------------------------------------------------------------------
+// Passes the file series prefetching settings to the readers that declare
+// support for it with a `<FileSeriesPrefetching />` hint.
+void vtkSetupFileSeriesPrefetching(vtkSMProxy* proxy)
+{
+  vtkPVIOSettings* settings = vtkPVIOSettings::GetInstance();
+  if (settings->GetFileSeriesPrefetchDepth() <= 0 || !proxy->GetHints() ||
+    !proxy->GetHints()->FindNestedElementByName("FileSeriesPrefetching"))
+  {
+    return;
+  }
+  vtkClientServerStream stream;
+  stream << vtkClientServerStream::Invoke << VTKOBJECT(proxy) << "SetPrefetchDepth"
+         << settings->GetFileSeriesPrefetchDepth() << vtkClientServerStream::End;
+  stream << vtkClientServerStream::Invoke << VTKOBJECT(proxy) << "SetPrefetchMemoryLimit"
+         << settings->GetFileSeriesPrefetchMemoryLimit() << vtkClientServerStream::End;
+  proxy->GetSession()->ExecuteStream(proxy->GetLocation(), stream);
+}
+
 //---------------------------------------------------------------------------
 vtkPVXMLElement* vtkFindChildFromHints(vtkPVXMLElement* hints, const int outputPort,
   const char* xmlTag, const char* xmlAttributeName = nullptr,
@@ -290,6 +312,9 @@ bool vtkSMParaViewPipelineControllerWithRendering::PostInitializeProxy(vtkSMProx
   {
     return false;
   }
+
+  vtkSetupFileSeriesPrefetching(proxy);
+
   // BUG #14773: The domains for ColorArrayName and Representation properties
   // come up with a good default separately. In reality, we need the
   // ColorArrayName to depend on Representation and not pick any value when
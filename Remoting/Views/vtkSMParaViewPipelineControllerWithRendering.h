@@ -175,7 +175,9 @@ public:
   bool RegisterRepresentationProxy(vtkSMProxy* proxy) override;
 
   /**
-   * Overridden to handle default ColorArrayName for representations correctly.
+   * Overridden to handle default ColorArrayName for representations correctly
+   * and to pass the file series prefetching settings from `vtkPVIOSettings` to
+   * file series readers.
    */
   bool PostInitializeProxy(vtkSMProxy* proxy) override;
 
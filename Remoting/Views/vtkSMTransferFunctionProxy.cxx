@@ -9,7 +9,9 @@
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPExtractHistogram.h"
 #include "vtkPVArrayInformation.h"
+#include "vtkPVDataInformation.h"
 #include "vtkPVProminentValuesInformation.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPVXMLParser.h"
@@ -53,6 +55,13 @@ public:
   }
 };
 
+//----------------------------------------------------------------------------
+// Number of bins of the histogram computed by ComputeDataHistogramTable. Any bin count dividing it
+// is derived by merging bins instead of executing the histogram pipeline again.
+// 57600 = 2^8 * 3^2 * 5^2 is divisible by the bin counts commonly used (powers of two up to 256,
+// multiples of 10 up to 100, ...).
+constexpr int BASE_HISTOGRAM_BIN_COUNT = 57600;
+
 //----------------------------------------------------------------------------
 inline vtkSMProperty* GetControlPointsProperty(vtkSMProxy* self)
 {
@@ -505,6 +514,8 @@ vtkTable* vtkSMTransferFunctionProxy::ComputeDataHistogramTable(int numberOfBins
   group.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "GroupDataSets")));
 
   // Group all visible consumers using the transfer function proxy
+  std::ostringstream histogramKey;
+  histogramKey.precision(17);
   vtkPVArrayInformation* arrayInfo = nullptr;
   std::string arrayName;
   int arrayAsso = -1;
@@ -584,9 +595,17 @@ vtkTable* vtkSMTransferFunctionProxy::ComputeDataHistogramTable(int numberOfBins
       }
 
       // Add consumer to group filter
-      vtkSMSourceProxy* input =
-        vtkSMSourceProxy::SafeDownCast(vtkSMPropertyHelper(consumer, "Input").GetAsProxy());
+      vtkSMPropertyHelper inputHelper(consumer, "Input");
+      vtkSMSourceProxy* input = vtkSMSourceProxy::SafeDownCast(inputHelper.GetAsProxy());
       vtkSMPropertyHelper(group, "Input").Add(input);
+      unsigned int port = inputHelper.GetOutputPort();
+      if (input)
+      {
+        // The global id identifies the proxy even if another one is later allocated at the same
+        // address, and the data information is gathered again each time its data changes.
+        histogramKey << input->GetGlobalID() << ":" << port << ":"
+                     << input->GetDataInformation(port)->GetMTime() << ";";
+      }
       group->UpdateVTKObjects();
       hasData = true;
       usedProxy.insert(consumer);
@@ -600,6 +619,31 @@ vtkTable* vtkSMTransferFunctionProxy::ComputeDataHistogramTable(int numberOfBins
     return this->HistogramTableCache;
   }
 
+  // The base histogram can be reused as long as the inputs, their data, the array and the range
+  // are the same.
+  histogramKey << arrayName << ":" << arrayAsso << ":" << component << ":" << this->LastRange[0]
+               << ":" << this->LastRange[1];
+  const std::string key = histogramKey.str();
+  const bool divisible = numberOfBins > 0 && BASE_HISTOGRAM_BIN_COUNT % numberOfBins == 0;
+  if (this->BaseHistogramKey != key)
+  {
+    this->BaseHistogramTable = nullptr;
+    this->BaseHistogramKey.clear();
+  }
+  if (divisible && this->BaseHistogramTable)
+  {
+    vtkPExtractHistogram::MergeBins(this->BaseHistogramTable, numberOfBins,
+      this->BaseHistogramTable->GetColumnName(0), this->HistogramTableCache);
+    return this->HistogramTableCache;
+  }
+
+  // A first histogram of some data is computed with the requested bin count. The base histogram
+  // is only computed when the bin count changes for the same data, i.e. when it will be reused.
+  const bool useBaseHistogram = divisible && this->LastHistogramKey == key &&
+    this->LastHistogramBinCount != numberOfBins;
+  this->LastHistogramKey = key;
+  this->LastHistogramBinCount = numberOfBins;
+
   // Compute the histogram
   vtkSmartPointer<vtkSMSourceProxy> histo;
   histo.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("filters", "ExtractHistogram")));
@@ -607,7 +651,11 @@ vtkTable* vtkSMTransferFunctionProxy::ComputeDataHistogramTable(int numberOfBins
   vtkSMPropertyHelper(histo, "SelectInputArray")
     .SetInputArrayToProcess(arrayAsso, arrayName.c_str());
   vtkSMPropertyHelper(histo, "Component").Set(component);
-  vtkSMPropertyHelper(histo, "BinCount").Set(numberOfBins);
+  vtkSMPropertyHelper(histo, "BinCount")
+    .Set(useBaseHistogram ? BASE_HISTOGRAM_BIN_COUNT : numberOfBins);
+  // Histograms with a bin count dividing the base one are always derived from base bins, so that
+  // they match the histograms later merged from the base histogram, even for values on bin edges.
+  vtkSMPropertyHelper(histo, "BaseBinCount").Set(divisible ? BASE_HISTOGRAM_BIN_COUNT : 0);
   vtkSMPropertyHelper(histo, "UseCustomBinRanges").Set(true);
   vtkSMPropertyHelper(histo, "CustomBinRanges").Set(this->LastRange, 2);
   histo->UpdateVTKObjects();
@@ -655,6 +703,21 @@ vtkTable* vtkSMTransferFunctionProxy::ComputeDataHistogramTable(int numberOfBins
   doubleValueArray->DeepCopy(valueArray);
   this->HistogramTableCache->RemoveColumn(1);
   this->HistogramTableCache->AddColumn(doubleValueArray);
+
+  if (useBaseHistogram)
+  {
+    if (this->HistogramTableCache->GetNumberOfRows() != BASE_HISTOGRAM_BIN_COUNT)
+    {
+      vtkErrorMacro("Histogram is not producing the expected number of bins");
+      this->HistogramTableCache = nullptr;
+      return this->HistogramTableCache;
+    }
+    this->BaseHistogramTable = vtkSmartPointer<vtkTable>::New();
+    this->BaseHistogramTable->ShallowCopy(this->HistogramTableCache);
+    this->BaseHistogramKey = key;
+    vtkPExtractHistogram::MergeBins(this->BaseHistogramTable, numberOfBins,
+      this->BaseHistogramTable->GetColumnName(0), this->HistogramTableCache);
+  }
   return this->HistogramTableCache;
 }
 
@@ -17,6 +17,7 @@
 #include "vtkSmartPointer.h" // for ivars
 #include "vtkTable.h"        // for vtkTable
 
+#include <string>            // for std::string
 #include <vtk_jsoncpp_fwd.h> // for forward declarations
 
 // Forward declarations
@@ -393,6 +394,22 @@ protected:
    */
   vtkSmartPointer<vtkTable> HistogramTableCache;
 
+  /*
+   * Fine-grained histogram from which ComputeDataHistogram derives coarser histograms,
+   * and the global ids and data information times of its inputs, the array and range it was
+   * computed for.
+   */
+  vtkSmartPointer<vtkTable> BaseHistogramTable;
+  std::string BaseHistogramKey;
+
+  /*
+   * Inputs, data times, array and range, and bin count of the last histogram computed
+   * directly. The base histogram is only computed once a second bin count is requested
+   * for the same data.
+   */
+  std::string LastHistogramKey;
+  int LastHistogramBinCount = 0;
+
 private:
   vtkSMTransferFunctionProxy(const vtkSMTransferFunctionProxy&) = delete;
   void operator=(const vtkSMTransferFunctionProxy&) = delete;
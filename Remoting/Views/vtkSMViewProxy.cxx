@@ -12,6 +12,7 @@
 #include "vtkMath.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVGeneralSettings.h"
 #include "vtkPVLogger.h"
 #include "vtkPVView.h"
 #include "vtkPVXMLElement.h"
@@ -468,6 +469,10 @@ void vtkSMViewProxy::Update()
       int use_cache = pvview->GetUseCache() ? 1 : 0;
       stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "SetUseCache" << use_cache
              << vtkClientServerStream::End;
+      const vtkTypeUInt64 cache_limit =
+        vtkPVGeneralSettings::GetInstance()->GetAnimationGeometryCacheLimit();
+      stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "SetDeliveryCacheLimit"
+             << cache_limit << vtkClientServerStream::End;
     }
     stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "Update"
            << vtkClientServerStream::End;
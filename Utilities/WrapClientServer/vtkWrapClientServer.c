@@ -84,10 +84,15 @@ void output_temp(FILE* fp, int i, unsigned int argType, const char* Id, int coun
     return;
   }
 
-  /* Start pointer-to-data arguments.  */
+  /* Start pointer-to-data arguments.  Only const arrays may be used in
+     place, the others are copied since the method may write to them.  */
   if (isPointerToData)
   {
     fprintf(fp, "vtkClientServerStreamDataArg<");
+    if ((argType & VTK_PARSE_CONST) != 0)
+    {
+      fprintf(fp, "const ");
+    }
   }
 
   if (argType & VTK_PARSE_UNSIGNED)
@@ -410,25 +415,105 @@ void get_args(FILE* fp, int i)
 int managableArguments(FunctionInfo* curFunction);
 int notWrappable(FunctionInfo* curFunction);
 
-void outputFunction(FILE* fp, ClassInfo* data)
+/* true if the function gets a case in the command function */
+static int isWrappedFunction(ClassInfo* data, FunctionInfo* curFunction)
+{
+  /* if the args are OK and it is not a constructor or destructor */
+  return !notWrappable(curFunction) && managableArguments(curFunction) &&
+    strcmp(data->Name, curFunction->Name) != 0 && strcmp(data->Name, curFunction->Name + 1) != 0;
+}
+
+/* an entry of the method table, before sorting */
+typedef struct _MethodTableEntry
+{
+  FunctionInfo* Function;
+  int Index;
+} MethodTableEntry;
+
+/* sort by name, then number of arguments, then declaration order */
+static int methodTableCmp(const void* entry1, const void* entry2)
+{
+  const MethodTableEntry* a = (const MethodTableEntry*)entry1;
+  const MethodTableEntry* b = (const MethodTableEntry*)entry2;
+  int cmp = strcmp(a->Function->Name, b->Function->Name);
+  if (cmp == 0)
+  {
+    cmp = a->Function->NumberOfArguments - b->Function->NumberOfArguments;
+  }
+  if (cmp == 0)
+  {
+    cmp = a->Index - b->Index;
+  }
+  return cmp;
+}
+
+/*
+ * Outputs the table of the wrapped methods of the class, sorted by name and
+ * number of arguments, so that the command function finds the cases to try
+ * for a method with a binary search instead of comparing it with every
+ * method name. The index of an entry is the case generated by outputFunction.
+ * Returns the number of entries.
+ */
+static int output_MethodTable(FILE* fp, ClassInfo* data)
 {
   int i;
+  int numberOfEntries = 0;
+  MethodTableEntry* entries;
 
-  if (notWrappable(currentFunction))
+  if (data->NumberOfFunctions == 0)
   {
-    return;
+    return 0;
   }
+  entries = (MethodTableEntry*)malloc(sizeof(MethodTableEntry) * data->NumberOfFunctions);
+  for (i = 0; i < data->NumberOfFunctions; i++)
+  {
+    if (isWrappedFunction(data, data->Functions[i]))
+    {
+      entries[numberOfEntries].Function = data->Functions[i];
+      entries[numberOfEntries].Index = numberOfEntries;
+      numberOfEntries++;
+    }
+  }
+  if (numberOfEntries == 0)
+  {
+    free(entries);
+    return 0;
+  }
+  qsort(entries, numberOfEntries, sizeof(MethodTableEntry), methodTableCmp);
 
-  /* if the args are OK and it is not a constructor or destructor */
-  if (managableArguments(currentFunction) && strcmp(data->Name, currentFunction->Name) != 0 &&
-    strcmp(data->Name, currentFunction->Name + 1) != 0)
+  fprintf(fp, "  static const vtkClientServerInterpreter::MethodEntry methods[] = {\n");
+  for (i = 0; i < numberOfEntries; i++)
+  {
+    if (entries[i].Function->IsLegacy)
+    {
+      fprintf(fp, "#if !defined(VTK_LEGACY_REMOVE)\n");
+    }
+    fprintf(fp, "    { \"%s\", %i, %i },\n", entries[i].Function->Name,
+      entries[i].Function->NumberOfArguments + 2, entries[i].Index);
+    if (entries[i].Function->IsLegacy)
+    {
+      fprintf(fp, "#endif\n");
+    }
+  }
+  /* the last entry keeps the table non-empty when legacy methods are removed */
+  fprintf(fp,
+    "    { nullptr, 0, -1 }\n"
+    "  };\n");
+  free(entries);
+  return numberOfEntries;
+}
+
+void outputFunction(FILE* fp, ClassInfo* data)
+{
+  int i;
+
+  if (isWrappedFunction(data, currentFunction))
   {
     if (currentFunction->IsLegacy)
     {
       fprintf(fp, "#if !defined(VTK_LEGACY_REMOVE)\n");
     }
-    fprintf(fp, "  if (!strcmp(\"%s\",method) && msg.GetNumberOfArguments(0) == %i)\n",
-      currentFunction->Name, currentFunction->NumberOfArguments + 2);
+    fprintf(fp, "  case %i:\n", numberOfWrappedFunctions);
     fprintf(fp, "    {\n");
 
     /* process the args */
@@ -509,6 +594,7 @@ void outputFunction(FILE* fp, ClassInfo* data)
     fprintf(fp, "      return 1;\n");
     fprintf(fp, "      }\n");
     fprintf(fp, "    }\n");
+    fprintf(fp, "    break;\n");
     if (currentFunction->IsLegacy)
     {
       fprintf(fp, "#endif\n");
@@ -1398,11 +1484,33 @@ int main(int argc, char* argv[])
 
   fprintf(fp, "  (void)arlu;\n");
 
-  /* insert function handling code here */
-  for (i = 0; i < data->NumberOfFunctions; i++)
+  /* insert function handling code here: try the cases of the methods with
+   * the requested name and number of arguments, in declaration order */
+  if (output_MethodTable(fp, data))
   {
-    currentFunction = data->Functions[i];
-    outputFunction(fp, data);
+    fprintf(fp,
+      "  const int numberOfMethods =\n"
+      "    static_cast<int>(sizeof(methods) / sizeof(methods[0])) - 1;\n"
+      "  const int numberOfArguments = msg.GetNumberOfArguments(0);\n"
+      "  for (int methodIndex = vtkClientServerInterpreter::FindMethod(\n"
+      "         methods, numberOfMethods, method, numberOfArguments);\n"
+      "       methodIndex >= 0 && methodIndex < numberOfMethods &&\n"
+      "       methods[methodIndex].NumberOfArguments == numberOfArguments &&\n"
+      "       !strcmp(methods[methodIndex].Name, method);\n"
+      "       ++methodIndex)\n"
+      "  {\n"
+      "  switch (methods[methodIndex].Index)\n"
+      "  {\n");
+    for (i = 0; i < data->NumberOfFunctions; i++)
+    {
+      currentFunction = data->Functions[i];
+      outputFunction(fp, data);
+    }
+    fprintf(fp,
+      "  default:\n"
+      "    break;\n"
+      "  }\n"
+      "  }\n");
   }
 
   /* try superclasses */
@@ -1410,11 +1518,9 @@ int main(int argc, char* argv[])
   {
     fprintf(fp,
       "\n"
+      "  if (arlu->CallSuperclassCommandFunction(\"%s\", op, method, msg, resultStream))\n"
       "  {\n"
-      "    const char* commandName = \"%s\";\n"
-      "    if (arlu->HasCommandFunction(commandName) &&\n"
-      "        arlu->CallCommandFunction(commandName, op, method, msg, resultStream)) { return 1; "
-      "}\n"
+      "    return 1;\n"
       "  }\n",
       data->SuperClasses[i]);
   }
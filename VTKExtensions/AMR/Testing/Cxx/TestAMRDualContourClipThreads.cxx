@@ -0,0 +1,212 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkAMRDualClip.h"
+#include "vtkAMRDualContour.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataObject.h"
+#include "vtkDoubleArray.h"
+#include "vtkDummyController.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
+#include "vtkNonOverlappingAMR.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkUniformGrid.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    std::cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                   \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+const int BlockSize = 6;
+const int BlocksPerAxis = 4;
+const double IsoValue = 6.0;
+
+// A sphere crossing most of the blocks, so that the blocks processed
+// concurrently share points with their neighbors.
+vtkSmartPointer<vtkNonOverlappingAMR> MakeInput()
+{
+  const int numBlocks = BlocksPerAxis * BlocksPerAxis * BlocksPerAxis;
+  const double center = 0.5 * BlocksPerAxis * BlockSize;
+  auto amr = vtkSmartPointer<vtkNonOverlappingAMR>::New();
+  int blocksPerLevel[1] = { numBlocks };
+  amr->Initialize(1, blocksPerLevel);
+  int blockId = 0;
+  for (int bz = 0; bz < BlocksPerAxis; ++bz)
+  {
+    for (int by = 0; by < BlocksPerAxis; ++by)
+    {
+      for (int bx = 0; bx < BlocksPerAxis; ++bx, ++blockId)
+      {
+        vtkNew<vtkUniformGrid> grid;
+        grid->SetOrigin(bx * BlockSize, by * BlockSize, bz * BlockSize);
+        grid->SetSpacing(1, 1, 1);
+        grid->SetDimensions(BlockSize + 1, BlockSize + 1, BlockSize + 1);
+        vtkNew<vtkDoubleArray> distance;
+        distance->SetName("distance");
+        distance->SetNumberOfTuples(grid->GetNumberOfCells());
+        vtkIdType cellId = 0;
+        for (int k = 0; k < BlockSize; ++k)
+        {
+          for (int j = 0; j < BlockSize; ++j)
+          {
+            for (int i = 0; i < BlockSize; ++i, ++cellId)
+            {
+              const double x = bx * BlockSize + i + 0.5 - center;
+              const double y = by * BlockSize + j + 0.5 - center;
+              const double z = bz * BlockSize + k + 0.5 - center;
+              // Inside values are larger than the iso value.
+              distance->SetValue(cellId, 2.0 * IsoValue - std::sqrt(x * x + y * y + z * z));
+            }
+          }
+        }
+        grid->GetCellData()->AddArray(distance);
+        amr->SetDataSet(0, blockId, grid);
+      }
+    }
+  }
+  return amr;
+}
+
+struct Geometry
+{
+  std::vector<double> Points;
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> Connectivity;
+  std::vector<double> BlockIds;
+  std::vector<double> Distances;
+};
+
+bool GetGeometry(vtkMultiBlockDataSet* output, Geometry& geometry)
+{
+  auto pieces = output ? vtkMultiPieceDataSet::SafeDownCast(output->GetBlock(0)) : nullptr;
+  auto mesh = pieces ? vtkPointSet::SafeDownCast(pieces->GetPiece(0)) : nullptr;
+  if (!mesh || mesh->GetNumberOfCells() == 0)
+  {
+    return false;
+  }
+  vtkCellArray* cells = nullptr;
+  if (auto polyData = vtkPolyData::SafeDownCast(mesh))
+  {
+    cells = polyData->GetPolys();
+  }
+  else if (auto grid = vtkUnstructuredGrid::SafeDownCast(mesh))
+  {
+    cells = grid->GetCells();
+  }
+  vtkDataArray* blockIds = mesh->GetCellData()->GetArray("BlockIds");
+  vtkDataArray* distances = mesh->GetPointData()->GetArray("distance");
+  if (!cells || !blockIds || !distances)
+  {
+    return false;
+  }
+  for (vtkIdType ptId = 0; ptId < mesh->GetNumberOfPoints(); ++ptId)
+  {
+    double pt[3];
+    mesh->GetPoint(ptId, pt);
+    geometry.Points.insert(geometry.Points.end(), pt, pt + 3);
+    geometry.Distances.push_back(distances->GetTuple1(ptId));
+  }
+  for (vtkIdType cellId = 0; cellId <= cells->GetNumberOfCells(); ++cellId)
+  {
+    geometry.Offsets.push_back(cells->GetOffsetsArray()->GetTuple1(cellId));
+  }
+  for (vtkIdType idx = 0; idx < cells->GetNumberOfConnectivityIds(); ++idx)
+  {
+    geometry.Connectivity.push_back(cells->GetConnectivityArray()->GetTuple1(idx));
+  }
+  for (vtkIdType cellId = 0; cellId < blockIds->GetNumberOfTuples(); ++cellId)
+  {
+    geometry.BlockIds.push_back(blockIds->GetTuple1(cellId));
+  }
+  return true;
+}
+
+bool Contour(vtkNonOverlappingAMR* input, int numberOfThreads, bool mergePoints, Geometry& geometry)
+{
+  bool status = false;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads },
+    [&]()
+    {
+      vtkNew<vtkAMRDualContour> filter;
+      filter->SetInputData(input);
+      filter->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "distance");
+      filter->SetIsoValue(IsoValue);
+      filter->SetEnableMergePoints(mergePoints);
+      filter->SetEnableCapping(1);
+      filter->Update();
+      status =
+        GetGeometry(vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0)), geometry);
+    });
+  return status;
+}
+
+bool Clip(vtkNonOverlappingAMR* input, int numberOfThreads, bool mergePoints, Geometry& geometry)
+{
+  bool status = false;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads },
+    [&]()
+    {
+      vtkNew<vtkAMRDualClip> filter;
+      filter->SetInputData(input);
+      filter->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "distance");
+      filter->SetIsoValue(IsoValue);
+      filter->SetEnableMergePoints(mergePoints);
+      filter->Update();
+      status =
+        GetGeometry(vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0)), geometry);
+    });
+  return status;
+}
+
+bool operator==(const Geometry& a, const Geometry& b)
+{
+  return a.Points == b.Points && a.Offsets == b.Offsets && a.Connectivity == b.Connectivity &&
+    a.BlockIds == b.BlockIds && a.Distances == b.Distances;
+}
+}
+
+extern int TestAMRDualContourClipThreads(int, char*[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  vtkSmartPointer<vtkNonOverlappingAMR> input = MakeInput();
+
+  // Blocks are processed concurrently, but the output must be the one of
+  // the serial execution, point ids included.
+  for (bool mergePoints : { true, false })
+  {
+    Geometry serialContour;
+    TASSERT(Contour(input, 1, mergePoints, serialContour));
+    Geometry serialClip;
+    TASSERT(Clip(input, 1, mergePoints, serialClip));
+    for (int numberOfThreads : { 2, 4, 8 })
+    {
+      Geometry threadedContour;
+      TASSERT(Contour(input, numberOfThreads, mergePoints, threadedContour));
+      TASSERT(threadedContour == serialContour);
+      Geometry threadedClip;
+      TASSERT(Clip(input, numberOfThreads, mergePoints, threadedClip));
+      TASSERT(threadedClip == serialClip);
+    }
+  }
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return EXIT_SUCCESS;
+}
@@ -14,6 +14,7 @@
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -22,15 +23,20 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkObject.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <algorithm>
 #include <iostream>
+#include <memory>
 
 vtkStandardNewMacro(vtkAMRDualClip);
 
@@ -165,6 +171,40 @@ unsigned char* vtkAMRDualClipLocator::GetLevelMaskPointer()
   return this->LevelMaskArray->GetPointer(0);
 }
 
+//============================================================================
+// Geometry generated by one thread.  A block is processed by a single thread,
+// so its points and tetrahedra are contiguous here.  The locators hold the
+// ids the points will have if blocks are appended in order.  Each block gets
+// a range of ids large enough for the four arrays of its locator, so points
+// shared between blocks processed by different threads keep one id.
+class vtkAMRDualClipOutput
+{
+public:
+  vtkAMRDualClipOutput()
+  {
+    this->LevelMask->SetName("LevelMask");
+    this->Mesh->GetPointData()->AddArray(this->LevelMask);
+  }
+
+  vtkIdType GetNumberOfTetras()
+  {
+    return static_cast<vtkIdType>(this->TetraConnectivity.size()) / 4;
+  }
+
+  // Only the point data is used.
+  vtkNew<vtkUnstructuredGrid> Mesh;
+  vtkNew<vtkPoints> Points;
+  vtkNew<vtkUnsignedCharArray> LevelMask;
+  std::vector<vtkIdType> TetraConnectivity;
+
+  // Locator of the block being processed.
+  vtkAMRDualClipLocator* Locator = nullptr;
+  // Used when blocks do not merge points.
+  vtkAMRDualClipLocator BlockLocator;
+  // Locator id of the point at index 0 in Points.
+  vtkIdType PointIdOffset = 0;
+};
+
 namespace
 {
 //----------------------------------------------------------------------------
@@ -201,44 +241,214 @@ struct vtkDualGridClipInitializeLevelMask
   template <class TArray>
   void operator()(TArray* scalarsArray, double isoValue, unsigned char* levelMask, int dims[3])
   {
-    // unsigned char flag = 1;
-    auto scalarPtr = vtk::DataArrayValueRange(scalarsArray).begin();
+    const auto scalars = vtk::DataArrayValueRange(scalarsArray);
+    const vtkIdType planeSize = static_cast<vtkIdType>(dims[0]) * dims[1];
 
+    // Each plane only reads its own scalars, so planes are filled concurrently.
     // We only set the inside because the ghost regions can already be set.
-    scalarPtr += 1 + dims[0] + dims[0] * dims[1];
-    levelMask += 1 + dims[0] + dims[0] * dims[1];
     // Start with two because skipping from and back ghost.
     // The exact value of zz does not matter.
     // This is easier than comparing < dim-1.
-    for (int zz = 2; zz < dims[2]; ++zz)
+    vtkSMPTools::For(2, dims[2],
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType zz = begin; zz < end; ++zz)
+        {
+          vtkIdType offset = 1 + dims[0] + planeSize * (zz - 1);
+          for (int yy = 2; yy < dims[1]; ++yy)
+          {
+            for (int xx = 2; xx < dims[0]; ++xx)
+            {
+              // Lets do relative levels (to block) / level diff.
+              // Then we do not need the block level.  The only trouble is that
+              // we need to offset by 1 so that 0 can be special value (outside).
+              // 0 is the special value indicating point is outside clipped volume.
+              levelMask[offset] = (scalars[offset] > isoValue) ? 1 : 0;
+              ++offset;
+            }
+            // Skip last ghost of this row and first ghost of next.
+            offset += 2;
+          }
+        }
+      });
+  }
+};
+
+//----------------------------------------------------------------------------
+// Loops over the dual cells owned by a block.  The corner values are read
+// once, with the actual type of the array, to compute the clipping case.
+// Only cells that are not entirely clipped away are passed on.
+struct vtkAMRDualClipProcessDualCells
+{
+  template <class TArray, class TProcessDualCell>
+  void operator()(TArray* scalarsArray, vtkAMRDualGridHelperBlock* block, const int extent[6],
+    double isoValue, TProcessDualCell& processDualCell)
+  {
+    const auto scalars = vtk::DataArrayTupleRange(scalarsArray);
+    const vtkIdType yInc = extent[1] - extent[0] + 1;
+    const vtkIdType zInc = yInc * (extent[3] - extent[2] + 1);
+    // These are needed to handle the cropped boundary cells.
+    const int xMax = extent[1] - 1;
+    const int yMax = extent[3] - 1;
+    const int zMax = extent[5] - 1;
+
+    vtkIdType cornerOffsets[8];
+    double cornerValues[8];
+    vtkIdType zOffset = 0;
+    for (int z = extent[4]; z < extent[5]; ++z)
     {
-      for (int yy = 2; yy < dims[1]; ++yy)
+      const int nz = (z == extent[4]) ? 0 : ((z == zMax) ? 2 : 1);
+      vtkIdType yOffset = zOffset;
+      for (int y = extent[2]; y < extent[3]; ++y)
       {
-        for (int xx = 2; xx < dims[0]; ++xx)
+        const int ny = (y == extent[2]) ? 0 : ((y == yMax) ? 2 : 1);
+        vtkIdType xOffset = yOffset;
+        for (int x = extent[0]; x < extent[1]; ++x, ++xOffset)
         {
-          // Lets do relative levels (to block) / level diff.
-          // Then we do not need the block level.  The only trouble is that
-          // we need to offset by 1 so that 0 can be special value (outside).
-          if (*scalarPtr++ > isoValue)
+          const int nx = (x == extent[0]) ? 0 : ((x == xMax) ? 2 : 1);
+          // Skip the cell if a neighbor is already processing it.
+          if (!(block->RegionBits[nx][ny][nz] & vtkAMRRegionBitOwner))
           {
-            *levelMask++ = 1;
+            continue;
           }
-          else
-          { // Special value  indicating point is outside clipped volume.
-            *levelMask++ = 0;
-            // flag = 0;
+          // Get the corner values as offsets
+          cornerOffsets[0] = xOffset;
+          cornerOffsets[1] = xOffset + 1;
+          cornerOffsets[2] = xOffset + yInc;
+          cornerOffsets[3] = xOffset + 1 + yInc;
+          cornerOffsets[4] = xOffset + zInc;
+          cornerOffsets[5] = xOffset + 1 + zInc;
+          cornerOffsets[6] = xOffset + yInc + zInc;
+          cornerOffsets[7] = xOffset + 1 + yInc + zInc;
+          int cubeIndex = 0;
+          for (int i = 0; i < 8; ++i)
+          {
+            cornerValues[i] = static_cast<double>(scalars[cornerOffsets[i]][0]);
+            if (cornerValues[i] > isoValue)
+            {
+              cubeIndex |= (1 << i);
+            }
+          }
+          // I am trying to exit as quick as possible if there is
+          // no volume to generate.
+          if (cubeIndex != 0)
+          {
+            processDualCell(x, y, z, cornerOffsets, cornerValues, cubeIndex);
           }
         }
-        // Skip last ghost of this row and first ghost of next.
-        levelMask += 2;
-        scalarPtr += 2;
+        yOffset += yInc;
       }
-      // Skip last ghost row of this plane and first ghost row of next.
-      levelMask += 2 * dims[0];
-      scalarPtr += 2 * dims[0];
+      zOffset += zInc;
     }
   }
 };
+
+//----------------------------------------------------------------------------
+// Where the geometry of a block ended up, and where it goes in the output.
+struct vtkAMRDualClipBlockPiece
+{
+  vtkAMRDualGridHelperBlock* Block = nullptr;
+  int BlockId = 0;
+  bool Processed = false;
+  vtkAMRDualClipOutput* Output = nullptr;
+  // Id of the first point of the block in the locators.
+  vtkIdType PointIdBase = 0;
+  // Range of the block in Output.
+  vtkIdType FirstPoint = 0;
+  vtkIdType NumberOfPoints = 0;
+  vtkIdType FirstTetra = 0;
+  vtkIdType NumberOfTetras = 0;
+  // Range of the block in the appended mesh.
+  vtkIdType OutputFirstPoint = 0;
+  vtkIdType OutputFirstTetra = 0;
+};
+
+//----------------------------------------------------------------------------
+// Copies the geometry of the blocks into the mesh, in block order, so the
+// output does not depend on the number of threads.  Locator ids are
+// converted to output point ids.
+void vtkAMRDualClipAppendPieces(std::vector<vtkAMRDualClipBlockPiece>& pieces,
+  vtkUnstructuredGrid* mesh, vtkIntArray* blockIdCellArray)
+{
+  vtkIdType numPoints = 0;
+  vtkIdType numTetras = 0;
+  std::vector<vtkIdType> pointIdBases;
+  pointIdBases.reserve(pieces.size());
+  for (auto& piece : pieces)
+  {
+    piece.OutputFirstPoint = numPoints;
+    piece.OutputFirstTetra = numTetras;
+    numPoints += piece.NumberOfPoints;
+    numTetras += piece.NumberOfTetras;
+    pointIdBases.push_back(piece.PointIdBase);
+  }
+
+  vtkPoints* points = mesh->GetPoints();
+  points->SetNumberOfPoints(numPoints);
+  vtkPointData* pointData = mesh->GetPointData();
+  for (int arrayIdx = 0; arrayIdx < pointData->GetNumberOfArrays(); ++arrayIdx)
+  {
+    pointData->GetAbstractArray(arrayIdx)->SetNumberOfTuples(numPoints);
+  }
+  vtkNew<vtkIdTypeArray> tetraOffsets;
+  tetraOffsets->SetNumberOfValues(numTetras + 1);
+  vtkNew<vtkIdTypeArray> tetraConnectivity;
+  tetraConnectivity->SetNumberOfValues(4 * numTetras);
+  blockIdCellArray->SetNumberOfValues(numTetras);
+
+  vtkSMPTools::For(0, numTetras + 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType tetraIdx = begin; tetraIdx < end; ++tetraIdx)
+      {
+        tetraOffsets->SetValue(tetraIdx, 4 * tetraIdx);
+      }
+    });
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(pieces.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType pieceIdx = begin; pieceIdx < end; ++pieceIdx)
+      {
+        const vtkAMRDualClipBlockPiece& piece = pieces[pieceIdx];
+        vtkAMRDualClipOutput* output = piece.Output;
+        if (piece.NumberOfPoints > 0)
+        {
+          points->GetData()->InsertTuples(piece.OutputFirstPoint, piece.NumberOfPoints,
+            piece.FirstPoint, output->Points->GetData());
+          vtkPointData* outputPointData = output->Mesh->GetPointData();
+          for (int arrayIdx = 0; arrayIdx < pointData->GetNumberOfArrays(); ++arrayIdx)
+          {
+            pointData->GetAbstractArray(arrayIdx)->InsertTuples(piece.OutputFirstPoint,
+              piece.NumberOfPoints, piece.FirstPoint, outputPointData->GetAbstractArray(arrayIdx));
+          }
+        }
+        for (vtkIdType tetraIdx = 0; tetraIdx < piece.NumberOfTetras; ++tetraIdx)
+        {
+          blockIdCellArray->SetValue(piece.OutputFirstTetra + tetraIdx, piece.BlockId);
+        }
+        const vtkIdType* ids = output->TetraConnectivity.data() + 4 * piece.FirstTetra;
+        vtkIdType* outIds = tetraConnectivity->GetPointer(4 * piece.OutputFirstTetra);
+        for (vtkIdType idx = 0; idx < 4 * piece.NumberOfTetras; ++idx)
+        {
+          const vtkIdType pointId = ids[idx];
+          // Most points belong to the block itself.  Others were shared by a
+          // block processed before it.
+          const vtkAMRDualClipBlockPiece* owner = &piece;
+          if (pointId < piece.PointIdBase || pointId >= piece.PointIdBase + piece.NumberOfPoints)
+          {
+            auto ownerIt = std::upper_bound(pointIdBases.begin(), pointIdBases.end(), pointId);
+            owner = &pieces[(ownerIt - pointIdBases.begin()) - 1];
+          }
+          *outIds++ = owner->OutputFirstPoint + pointId - owner->PointIdBase;
+        }
+      }
+    });
+
+  vtkNew<vtkCellArray> tetras;
+  tetras->SetData(tetraOffsets, tetraConnectivity);
+  mesh->SetCells(VTK_TETRA, tetras);
+}
 }
 
 //----------------------------------------------------------------------------
@@ -953,21 +1163,12 @@ vtkAMRDualClip::vtkAMRDualClip()
   // Pipeline
   this->SetNumberOfOutputPorts(1);
 
-  this->LevelMaskPointArray = nullptr;
-  this->BlockIdCellArray = nullptr;
   this->Helper = nullptr;
-
-  this->BlockLocator = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualClip::~vtkAMRDualClip()
 {
-  if (this->BlockLocator)
-  {
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-  }
   this->SetController(nullptr);
 }
 
@@ -1101,52 +1302,129 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
     this->DistributeLevelMasks();
   }
 
-  vtkUnstructuredGrid* mesh = vtkUnstructuredGrid::New();
-  this->Points = vtkPoints::New();
-  this->Cells = vtkCellArray::New();
-  mesh->SetPoints(this->Points);
+  vtkNew<vtkUnstructuredGrid> mesh;
+  vtkNew<vtkPoints> points;
+  mesh->SetPoints(points);
   mpds->SetPiece(0, mesh);
 
-  this->BlockIdCellArray = vtkIntArray::New();
-  this->BlockIdCellArray->SetName("BlockIds");
-  mesh->GetCellData()->AddArray(this->BlockIdCellArray);
+  vtkNew<vtkIntArray> blockIdCellArray;
+  blockIdCellArray->SetName("BlockIds");
+  mesh->GetCellData()->AddArray(blockIdCellArray);
 
-  this->LevelMaskPointArray = vtkUnsignedCharArray::New();
-  this->LevelMaskPointArray->SetName("LevelMask");
-  mesh->GetPointData()->AddArray(this->LevelMaskPointArray);
+  vtkNew<vtkUnsignedCharArray> levelMaskPointArray;
+  levelMaskPointArray->SetName("LevelMask");
+  mesh->GetPointData()->AddArray(levelMaskPointArray);
 
-  this->Mesh = mesh;
-  this->InitializeCopyAttributes(hbdsInput, this->Mesh);
+  this->InitializeCopyAttributes(hbdsInput, mesh);
 
-  // Loop through blocks
-  int numLevels = hbdsInput->GetNumberOfLevels();
-  int numBlocks;
-  int blockId;
+  // Blocks that touch do not share locators or level masks concurrently.
+  // Without merging all the blocks are independent.
+  std::vector<int> blockWaves;
+  if (this->EnableMergePoints)
+  {
+    this->Helper->ComputeBlockWaves(blockWaves);
+  }
 
   // Add each block.
+  std::vector<::vtkAMRDualClipBlockPiece> pieces;
+  std::vector<std::vector<size_t>> waves;
+  vtkIdType pointIdBase = 0;
+  size_t blockIdx = 0;
+  int numLevels = hbdsInput->GetNumberOfLevels();
   for (int level = 0; level < numLevels; ++level)
   {
-    numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
-    for (blockId = 0; blockId < numBlocks; ++blockId)
+    int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+    for (int blockId = 0; blockId < numBlocks; ++blockId, ++blockIdx)
     {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      if (block->Image == nullptr)
+      { // Remote blocks are only to setup local block bit flags.
+        continue;
+      }
+      ::vtkAMRDualClipBlockPiece piece;
+      piece.Block = block;
+      piece.BlockId = blockId;
+      piece.PointIdBase = pointIdBase;
+      // The locator has one entry per cell of the image in each of its arrays.
+      pointIdBase += 4 * block->Image->GetNumberOfCells();
+      size_t wave = blockWaves.empty() ? 0 : static_cast<size_t>(blockWaves[blockIdx]);
+      if (waves.size() <= wave)
+      {
+        waves.resize(wave + 1);
+      }
+      waves[wave].push_back(pieces.size());
+      pieces.push_back(piece);
     }
   }
 
-  this->BlockIdCellArray->Delete();
-  this->BlockIdCellArray = nullptr;
-  this->LevelMaskPointArray->Delete();
-  this->LevelMaskPointArray = nullptr;
+  vtkSMPThreadLocal<std::shared_ptr<vtkAMRDualClipOutput>> outputs;
+  for (const auto& wave : waves)
+  {
+    if (this->EnableMergePoints)
+    {
+      // The level mask of a block is completed from its neighbors, which
+      // creates their locators, so this is done in the same order as the blocks.
+      for (size_t pieceIdx : wave)
+      {
+        vtkAMRDualGridHelperBlock* block = pieces[pieceIdx].Block;
+        if (block->Image->GetCellData()->GetArray(arrayNameToProcess))
+        {
+          this->InitializeLevelMask(block);
+        }
+      }
+    }
 
-  mesh->SetCells(VTK_TETRA, this->Cells);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(wave.size()), 1,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        std::shared_ptr<vtkAMRDualClipOutput>& output = outputs.Local();
+        if (!output)
+        {
+          output = std::make_shared<vtkAMRDualClipOutput>();
+          this->InitializeCopyAttributes(hbdsInput, output->Mesh);
+        }
+        for (vtkIdType idx = begin; idx < end; ++idx)
+        {
+          ::vtkAMRDualClipBlockPiece& piece = pieces[wave[idx]];
+          piece.Output = output.get();
+          piece.FirstPoint = output->Points->GetNumberOfPoints();
+          piece.FirstTetra = output->GetNumberOfTetras();
+          output->PointIdOffset = piece.PointIdBase - piece.FirstPoint;
+          piece.Processed = this->ProcessBlock(piece.Block, arrayNameToProcess, output.get());
+          piece.NumberOfPoints = output->Points->GetNumberOfPoints() - piece.FirstPoint;
+          piece.NumberOfTetras = output->GetNumberOfTetras() - piece.FirstTetra;
+        }
+      });
 
-  mesh->Delete();
-  this->Mesh = nullptr;
-  this->Points->Delete();
-  this->Points = nullptr;
-  this->Cells->Delete();
-  this->Cells = nullptr;
+    if (this->EnableMergePoints)
+    {
+      // Sharing writes into the locators of later blocks, so it is done in
+      // the same order as the blocks.
+      for (size_t pieceIdx : wave)
+      {
+        vtkAMRDualGridHelperBlock* block = pieces[pieceIdx].Block;
+        if (!pieces[pieceIdx].Processed)
+        {
+          continue;
+        }
+        this->ShareLevelMask(block);
+        // Copy point ids into neighbor locators.
+        this->ShareBlockLocatorWithNeighbors(block);
+        // We are done.  We no longer need the locator for this block.
+        delete ::vtkAMRDualClipGetBlockLocator(block);
+        block->UserData = nullptr;
+        // Lets use this unused flag (owner of center region/block) to indicate
+        // that the block is already processes.
+        // This will keep neighbors from recreating the locator.
+        // Another option would be to create the locator object for
+        // all blocks but do not allocate until needed.  Then the existence of the locator
+        // would tell whether the block was processed.
+        block->RegionBits[1][1][1] = 0;
+      }
+    }
+  }
+
+  ::vtkAMRDualClipAppendPieces(pieces, mesh, blockIdCellArray);
 
   mpds->Delete();
   this->Helper->Delete();
@@ -1356,13 +1634,13 @@ void vtkAMRDualClip::ShareLevelMask(vtkAMRDualGridHelperBlock* block)
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualClip::ProcessBlock(
-  vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayNameToProcess)
+bool vtkAMRDualClip::ProcessBlock(
+  vtkAMRDualGridHelperBlock* block, const char* arrayNameToProcess, vtkAMRDualClipOutput* output)
 {
   vtkImageData* image = block->Image;
   if (image == nullptr)
   { // Remote blocks are only to setup local block bit flags.
-    return;
+    return false;
   }
 
   // We are looking for only cell data arrays.
@@ -1370,11 +1648,9 @@ void vtkAMRDualClip::ProcessBlock(
 
   if (!volumeFractionArray)
   {
-    return;
+    return false;
   }
 
-  double origin[3];
-  double* spacing;
   int extent[6];
 
   // Get the origin and point extent of the dual grid (with ghost level).
@@ -1387,183 +1663,36 @@ void vtkAMRDualClip::ProcessBlock(
   // Locator merges points in this block.
   // Input the dimensions of the dual cells with ghosts.
   if (this->EnableMergePoints)
-  {
-    this->InitializeLevelMask(block);
-    this->BlockLocator = ::vtkAMRDualClipGetBlockLocator(block);
+  { // The level mask was initialized before the block was processed.
+    output->Locator = ::vtkAMRDualClipGetBlockLocator(block);
   }
   else
-  { // Shared locator.
-    if (this->BlockLocator == nullptr)
-    {
-      this->BlockLocator = new vtkAMRDualClipLocator;
-    }
-    this->BlockLocator->Initialize(
+  { // Locator of the thread.
+    output->Locator = &output->BlockLocator;
+    output->Locator->Initialize(
       extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    // this->BlockLocator->CopyRegionLevelDifferences(block);
+    // output->Locator->CopyRegionLevelDifferences(block);
   }
-  image->GetOrigin(origin);
-  spacing = image->GetSpacing();
-  // Dual cells are shifted half a pixel.
-  origin[0] += 0.5 * spacing[0];
-  origin[1] += 0.5 * spacing[1];
-  origin[2] += 0.5 * spacing[2];
-
-  // We deal with the various data types by copying the corner values
-  // into a double array.  We have to cast anyway to compute the case.
-  vtkIdType cornerOffsets[8];
-
-  // The templated function needs the increments for pointers
-  // cast to the correct datatype.
-  int yInc = (extent[1] - extent[0] + 1);
-  int zInc = yInc * (extent[3] - extent[2] + 1);
 
   // Loop over all the cells in the dual grid.
-  int x, y, z;
-  // These are needed to handle the cropped boundary cells.
-  int xMax = extent[1] - 1;
-  int yMax = extent[3] - 1;
-  int zMax = extent[5] - 1;
-  //-
-  vtkIdType zOffset = 0;
-  vtkIdType yOffset = 0;
-  vtkIdType xOffset = 0;
-  //-
-  for (z = extent[4]; z < extent[5]; ++z)
-  {
-    int nz = 1;
-    if (z == extent[4])
-    {
-      nz = 0;
-    }
-    else if (z == zMax)
-    {
-      nz = 2;
-    }
-    yOffset = zOffset;
-    for (y = extent[2]; y < extent[3]; ++y)
-    {
-      int ny = 1;
-      if (y == extent[2])
-      {
-        ny = 0;
-      }
-      else if (y == yMax)
-      {
-        ny = 2;
-      }
-      xOffset = yOffset;
-      for (x = extent[0]; x < extent[1]; ++x)
-      {
-        int nx = 1;
-        if (x == extent[0])
-        {
-          nx = 0;
-        }
-        else if (x == xMax)
-        {
-          nx = 2;
-        }
-        // Skip the cell if a neighbor is already processing it.
-        if ((block->RegionBits[nx][ny][nz] & vtkAMRRegionBitOwner))
-        {
-          // Get the corner values as offsets
-          cornerOffsets[0] = xOffset;
-          cornerOffsets[1] = xOffset + 1;
-          cornerOffsets[2] = xOffset + yInc;
-          cornerOffsets[3] = xOffset + 1 + yInc;
-          cornerOffsets[4] = xOffset + zInc;
-          cornerOffsets[5] = xOffset + 1 + zInc;
-          cornerOffsets[6] = xOffset + yInc + zInc;
-          cornerOffsets[7] = xOffset + 1 + yInc + zInc;
-          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
-        }
-        xOffset += 1; // xInc
-      }
-      yOffset += yInc;
-    }
-    zOffset += zInc;
-  }
-
-  if (this->EnableMergePoints)
+  auto processDualCell = [&](int x, int y, int z, vtkIdType cornerOffsets[8],
+                           double cornerValues[8], int cubeIndex)
+  { this->ProcessDualCell(block, x, y, z, cornerOffsets, cornerValues, cubeIndex, output); };
+  ::vtkAMRDualClipProcessDualCells worker;
+  if (!vtkArrayDispatch::Dispatch::Execute(
+        volumeFractionArray, worker, block, extent, this->IsoValue, processDualCell))
   {
-    this->ShareLevelMask(block);
-    // Copy point ids into neighbor locators.
-    this->ShareBlockLocatorWithNeighbors(block);
-    // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-    block->UserData = nullptr;
-    // Lets use this unused flag (owner of center region/block) to indicate
-    // that the block is already processes.
-    // This will keep neighbors from recreating the locator.
-    // Another option would be to create the locator object for
-    // all blocks but do not allocate until needed.  Then the existence of the locator
-    // would tell whether the block was processed.
-    block->RegionBits[1][1][1] = 0;
+    worker(volumeFractionArray, block, extent, this->IsoValue, processDualCell);
   }
+  return true;
 }
 
 //----------------------------------------------------------------------------
 // Not implemented as optimally as we could.  It can be improved by making
 // a fast path for internal cells (with no degeneracies).
-void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y,
-  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
+void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int x, int y, int z,
+  vtkIdType cornerOffsets[8], double cornerValues[8], int cubeIndex, vtkAMRDualClipOutput* output)
 {
-  // compute the case index
-  vtkImageData* image = block->Image;
-  if (image == nullptr)
-  { // Remote blocks are only to setup local block bit flags.
-    return;
-  }
-
-  double cornerValues[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-  for (int i = 0; i < 8; ++i)
-  {
-    cornerValues[i] = volumeFractionArray->GetComponent(cornerOffsets[i], 0);
-  }
-  // compute the case index
-  int cubeIndex = 0;
-  if (cornerValues[0] > this->IsoValue)
-  {
-    cubeIndex += 1;
-  }
-  if (cornerValues[1] > this->IsoValue)
-  {
-    cubeIndex += 2;
-  }
-  if (cornerValues[2] > this->IsoValue)
-  {
-    cubeIndex += 4;
-  }
-  if (cornerValues[3] > this->IsoValue)
-  {
-    cubeIndex += 8;
-  }
-  if (cornerValues[4] > this->IsoValue)
-  {
-    cubeIndex += 16;
-  }
-  if (cornerValues[5] > this->IsoValue)
-  {
-    cubeIndex += 32;
-  }
-  if (cornerValues[6] > this->IsoValue)
-  {
-    cubeIndex += 64;
-  }
-  if (cornerValues[7] > this->IsoValue)
-  {
-    cubeIndex += 128;
-  }
-
-  // I am trying to exit as quick as possible if there is
-  // no surface to generate.  I could also check that the index
-  // is not on boundary.4
-  if (cubeIndex == 0)
-  {
-    return;
-  }
-
   // Which boundaries does this cube/cell touch?
   unsigned char cubeBoundaryBits[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
   // If this cell is degenerate, then remove triangles with 2 points.
@@ -1730,8 +1859,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
       // convert from VTK corner ids to bit (x,y,z) corner ids.
       if (casePtId < 8)
       { // Corner (internal point)
-        ptIdPtr = this->BlockLocator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
-        levelMaskValue = this->BlockLocator->GetLevelMaskValue(
+        ptIdPtr = output->Locator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
+        levelMaskValue = output->Locator->GetLevelMaskValue(
           x + ((casePtId & 1) ? 1 : 0), y + ((casePtId & 2) ? 1 : 0), z + ((casePtId & 4) ? 1 : 0));
         if (levelMaskValue == 0)
         { // bug !!!!! trying to figure out what is going on.
@@ -1783,7 +1912,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           pt[0] = origin[0] + spacing[0] * (double)(1 << levelDiff) * ((double)(px) + dx);
           pt[1] = origin[1] + spacing[1] * (double)(1 << levelDiff) * ((double)(py) + dy);
           pt[2] = origin[2] + spacing[2] * (double)(1 << levelDiff) * ((double)(pz) + dz);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
+          vtkIdType localId = output->Points->InsertNextPoint(pt);
+          *ptIdPtr = localId + output->PointIdOffset;
           if (pt[1] > 100000.0)
           {
             std::cerr << "bug\n";
@@ -1797,14 +1927,14 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Averaging could be a pre processing step but we would have to modify input attributes
           // .......
           vtkIdType offset = cornerOffsets[casePtId];
-          this->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset, *ptIdPtr);
+          output->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset, localId);
 
-          this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          output->LevelMask->InsertNextValue(levelMaskValue);
         }
       }
       else
       { // Edge (clipped cell, point on iso surface)
-        ptIdPtr = this->BlockLocator->GetEdgePointer(x, y, z, casePtId - 8);
+        ptIdPtr = output->Locator->GetEdgePointer(x, y, z, casePtId - 8);
         if (*ptIdPtr == -1)
         {
           int edge = casePtId - 8;
@@ -1821,7 +1951,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
             cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
           pt[2] =
             cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
+          vtkIdType localId = output->Points->InsertNextPoint(pt);
+          *ptIdPtr = localId + output->PointIdOffset;
           if (pt[1] > 100000.0)
           {
             std::cerr << "bug\n";
@@ -1831,10 +1962,10 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Find the offsets of the two attributes to interpolate
           vtkIdType offset0 = cornerOffsets[pt1Idx >> 2];
           vtkIdType offset1 = cornerOffsets[pt2Idx >> 2];
-          this->Mesh->GetPointData()->InterpolateEdge(
-            block->Image->GetCellData(), *ptIdPtr, offset0, offset1, k);
+          output->Mesh->GetPointData()->InterpolateEdge(
+            block->Image->GetCellData(), localId, offset0, offset1, k);
 
-          this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          output->LevelMask->InsertNextValue(levelMaskValue);
         }
       }
       pointIds[ii] = *ptIdPtr;
@@ -1842,8 +1973,7 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
     if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[0] != pointIds[3] &&
       pointIds[1] != pointIds[2] && pointIds[1] != pointIds[3] && pointIds[2] != pointIds[3])
     {
-      this->Cells->InsertNextCell(4, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      output->TetraConnectivity.insert(output->TetraConnectivity.end(), pointIds, pointIds + 4);
     }
   }
 }
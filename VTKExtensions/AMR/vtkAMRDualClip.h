@@ -36,6 +36,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualClipLocator;
+class vtkAMRDualClipOutput;
 
 class VTKPVVTKEXTENSIONSAMR_EXPORT vtkAMRDualClip : public vtkMultiBlockDataSetAlgorithm
 {
@@ -89,9 +90,6 @@ protected:
   int EnableMultiProcessCommunication;
   int EnableMergePoints;
 
-  // Needed for copying cell data to point data.
-  vtkUnstructuredGrid* Mesh;
-
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
   void InitializeCopyAttributes(vtkNonOverlappingAMR* hbdsInput, vtkDataSet* mesh);
@@ -107,10 +105,17 @@ protected:
 
   void ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block);
 
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
+  /**
+   * Clips a block into the thread local output. Blocks are processed
+   * concurrently when they do not share locators. Returns false when the
+   * block has no data to clip.
+   */
+  bool ProcessBlock(
+    vtkAMRDualGridHelperBlock* block, const char* arrayName, vtkAMRDualClipOutput* output);
 
-  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
-    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int x, int y, int z,
+    vtkIdType cornerOffsets[8], double cornerValues[8], int cubeIndex,
+    vtkAMRDualClipOutput* output);
 
   void InitializeLevelMask(vtkAMRDualGridHelperBlock* block);
   void ShareLevelMask(vtkAMRDualGridHelperBlock* block);
@@ -121,14 +126,8 @@ protected:
   // void MirrorCases();
   // void AddGlyph(double x, double y, double z);
 
-  // Stuff exclusively for debugging.
-  vtkIntArray* BlockIdCellArray;
-  vtkUnsignedCharArray* LevelMaskPointArray;
-
   // Ivars used to reduce method parrameters.
   vtkAMRDualGridHelper* Helper;
-  vtkPoints* Points;
-  vtkCellArray* Cells;
 
   vtkMultiProcessController* Controller;
 
@@ -137,8 +136,6 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualClipLocator* BlockLocator;
-
 private:
   vtkAMRDualClip(const vtkAMRDualClip&) = delete;
   void operator=(const vtkAMRDualClip&) = delete;
@@ -19,17 +19,25 @@
 #include "vtkMath.h"
 // Data sets
 #include "vtkAMRBox.h"
+#include "vtkArrayDispatch.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
+#include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
@@ -37,6 +45,7 @@
 #include <algorithm>
 #include <cmath>
 #include <ctime>
+#include <memory>
 
 vtkStandardNewMacro(vtkAMRDualContour);
 
@@ -419,6 +428,38 @@ vtkIdType* vtkAMRDualContourEdgeLocator::GetCornerPointer(
   return this->Corners + (xCell + (yCell * this->YIncrement) + (zCell * this->ZIncrement));
 }
 
+//============================================================================
+// Geometry generated by one thread.  A block is processed by a single thread,
+// so its points and faces are contiguous here.  The locators hold the ids the
+// points will have if blocks are appended in order.  Each block gets a range
+// of ids large enough for the four arrays of its locator, so points shared
+// between blocks processed by different threads keep one id.
+class vtkAMRDualContourOutput
+{
+public:
+  vtkAMRDualContourOutput() { this->FaceOffsets.push_back(0); }
+
+  vtkIdType GetNumberOfFaces() { return static_cast<vtkIdType>(this->FaceOffsets.size()) - 1; }
+  void InsertNextFace(vtkIdType numIds, const vtkIdType* ids)
+  {
+    this->FaceConnectivity.insert(this->FaceConnectivity.end(), ids, ids + numIds);
+    this->FaceOffsets.push_back(static_cast<vtkIdType>(this->FaceConnectivity.size()));
+  }
+
+  // Only the point data is used.
+  vtkNew<vtkPolyData> Mesh;
+  vtkNew<vtkPoints> Points;
+  std::vector<vtkIdType> FaceOffsets;
+  std::vector<vtkIdType> FaceConnectivity;
+
+  // Locator of the block being processed.
+  vtkAMRDualContourEdgeLocator* Locator = nullptr;
+  // Used when blocks do not merge points.
+  vtkAMRDualContourEdgeLocator BlockLocator;
+  // Locator id of the point at index 0 in Points.
+  vtkIdType PointIdOffset = 0;
+};
+
 //----------------------------------------------------------------------------
 namespace
 {
@@ -446,6 +487,191 @@ vtkAMRDualContourEdgeLocator* vtkAMRDualContourGetBlockLocator(vtkAMRDualGridHel
   }
   return (vtkAMRDualContourEdgeLocator*)(block->UserData);
 }
+
+//----------------------------------------------------------------------------
+// Loops over the dual cells owned by a block.  The corner values are read
+// once, with the actual type of the array, to compute the marching cubes
+// case.  Only cells that generate triangles are passed on.
+struct vtkAMRDualContourProcessDualCells
+{
+  template <class TArray, class TProcessDualCell>
+  void operator()(TArray* scalarsArray, vtkAMRDualGridHelperBlock* block, const int extent[6],
+    double isoValue, TProcessDualCell& processDualCell)
+  {
+    const auto scalars = vtk::DataArrayTupleRange(scalarsArray);
+    const vtkIdType yInc = extent[1] - extent[0] + 1;
+    const vtkIdType zInc = yInc * (extent[3] - extent[2] + 1);
+    // These are needed to handle the cropped boundary cells.
+    const int xMax = extent[1] - 1;
+    const int yMax = extent[3] - 1;
+    const int zMax = extent[5] - 1;
+
+    vtkIdType cornerOffsets[8];
+    double cornerValues[8];
+    vtkIdType zOffset = 0;
+    for (int z = extent[4]; z < extent[5]; ++z)
+    {
+      const int nz = (z == extent[4]) ? 0 : ((z == zMax) ? 2 : 1);
+      vtkIdType yOffset = zOffset;
+      for (int y = extent[2]; y < extent[3]; ++y)
+      {
+        const int ny = (y == extent[2]) ? 0 : ((y == yMax) ? 2 : 1);
+        vtkIdType xOffset = yOffset;
+        for (int x = extent[0]; x < extent[1]; ++x, ++xOffset)
+        {
+          const int nx = (x == extent[0]) ? 0 : ((x == xMax) ? 2 : 1);
+          // Skip the cell if a neighbor is already processing it.
+          if (!(block->RegionBits[nx][ny][nz] & vtkAMRRegionBitOwner))
+          {
+            continue;
+          }
+          // Get the corner values as offsets
+          cornerOffsets[0] = xOffset;
+          cornerOffsets[1] = xOffset + 1;
+          cornerOffsets[2] = xOffset + 1 + yInc;
+          cornerOffsets[3] = xOffset + yInc;
+          cornerOffsets[4] = xOffset + zInc;
+          cornerOffsets[5] = xOffset + 1 + zInc;
+          cornerOffsets[6] = xOffset + 1 + yInc + zInc;
+          cornerOffsets[7] = xOffset + yInc + zInc;
+          int cubeCase = 0;
+          for (int i = 0; i < 8; ++i)
+          {
+            cornerValues[i] = static_cast<double>(scalars[cornerOffsets[i]][0]);
+            if (cornerValues[i] > isoValue)
+            {
+              cubeCase |= (1 << i);
+            }
+          }
+          // I am trying to exit as quick as possible if there is
+          // no surface to generate.
+          if (cubeCase != 0 && (cubeCase != 255 || block->BoundaryBits != 0))
+          {
+            processDualCell(x, y, z, cornerOffsets, cornerValues, cubeCase);
+          }
+        }
+        yOffset += yInc;
+      }
+      zOffset += zInc;
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Where the geometry of a block ended up, and where it goes in the output.
+struct vtkAMRDualContourBlockPiece
+{
+  vtkAMRDualGridHelperBlock* Block = nullptr;
+  int BlockId = 0;
+  bool Processed = false;
+  vtkAMRDualContourOutput* Output = nullptr;
+  // Id of the first point of the block in the locators.
+  vtkIdType PointIdBase = 0;
+  // Range of the block in Output.
+  vtkIdType FirstPoint = 0;
+  vtkIdType NumberOfPoints = 0;
+  vtkIdType FirstFace = 0;
+  vtkIdType NumberOfFaces = 0;
+  // Range of the block in the appended mesh.
+  vtkIdType OutputFirstPoint = 0;
+  vtkIdType OutputFirstFace = 0;
+  vtkIdType OutputFirstConnectivity = 0;
+};
+
+//----------------------------------------------------------------------------
+// Copies the geometry of the blocks into the mesh, in block order, so the
+// output does not depend on the number of threads.  Locator ids are
+// converted to output point ids.
+void vtkAMRDualContourAppendPieces(std::vector<vtkAMRDualContourBlockPiece>& pieces,
+  vtkPolyData* mesh, vtkIntArray* blockIdCellArray)
+{
+  vtkIdType numPoints = 0;
+  vtkIdType numFaces = 0;
+  vtkIdType connectivitySize = 0;
+  std::vector<vtkIdType> pointIdBases;
+  pointIdBases.reserve(pieces.size());
+  for (auto& piece : pieces)
+  {
+    piece.OutputFirstPoint = numPoints;
+    piece.OutputFirstFace = numFaces;
+    piece.OutputFirstConnectivity = connectivitySize;
+    numPoints += piece.NumberOfPoints;
+    numFaces += piece.NumberOfFaces;
+    if (piece.NumberOfFaces > 0)
+    {
+      const std::vector<vtkIdType>& offsets = piece.Output->FaceOffsets;
+      connectivitySize += offsets[piece.FirstFace + piece.NumberOfFaces] - offsets[piece.FirstFace];
+    }
+    pointIdBases.push_back(piece.PointIdBase);
+  }
+
+  vtkPoints* points = mesh->GetPoints();
+  points->SetNumberOfPoints(numPoints);
+  vtkPointData* pointData = mesh->GetPointData();
+  for (int arrayIdx = 0; arrayIdx < pointData->GetNumberOfArrays(); ++arrayIdx)
+  {
+    pointData->GetAbstractArray(arrayIdx)->SetNumberOfTuples(numPoints);
+  }
+  vtkNew<vtkIdTypeArray> faceOffsets;
+  faceOffsets->SetNumberOfValues(numFaces + 1);
+  faceOffsets->SetValue(numFaces, connectivitySize);
+  vtkNew<vtkIdTypeArray> faceConnectivity;
+  faceConnectivity->SetNumberOfValues(connectivitySize);
+  blockIdCellArray->SetNumberOfValues(numFaces);
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(pieces.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType pieceIdx = begin; pieceIdx < end; ++pieceIdx)
+      {
+        const vtkAMRDualContourBlockPiece& piece = pieces[pieceIdx];
+        vtkAMRDualContourOutput* output = piece.Output;
+        if (piece.NumberOfPoints > 0)
+        {
+          points->GetData()->InsertTuples(piece.OutputFirstPoint, piece.NumberOfPoints,
+            piece.FirstPoint, output->Points->GetData());
+          vtkPointData* outputPointData = output->Mesh->GetPointData();
+          for (int arrayIdx = 0; arrayIdx < pointData->GetNumberOfArrays(); ++arrayIdx)
+          {
+            pointData->GetAbstractArray(arrayIdx)->InsertTuples(piece.OutputFirstPoint,
+              piece.NumberOfPoints, piece.FirstPoint, outputPointData->GetAbstractArray(arrayIdx));
+          }
+        }
+        if (piece.NumberOfFaces == 0)
+        {
+          continue;
+        }
+        const vtkIdType connectivityStart = output->FaceOffsets[piece.FirstFace];
+        for (vtkIdType faceIdx = 0; faceIdx < piece.NumberOfFaces; ++faceIdx)
+        {
+          faceOffsets->SetValue(piece.OutputFirstFace + faceIdx,
+            piece.OutputFirstConnectivity + output->FaceOffsets[piece.FirstFace + faceIdx] -
+              connectivityStart);
+          blockIdCellArray->SetValue(piece.OutputFirstFace + faceIdx, piece.BlockId);
+        }
+        const vtkIdType connectivityEnd =
+          output->FaceOffsets[piece.FirstFace + piece.NumberOfFaces];
+        vtkIdType* outIds = faceConnectivity->GetPointer(piece.OutputFirstConnectivity);
+        for (vtkIdType idx = connectivityStart; idx < connectivityEnd; ++idx)
+        {
+          vtkIdType pointId = output->FaceConnectivity[idx];
+          // Most points belong to the block itself.  Others were shared by a
+          // block processed before it.
+          const vtkAMRDualContourBlockPiece* owner = &piece;
+          if (pointId < piece.PointIdBase || pointId >= piece.PointIdBase + piece.NumberOfPoints)
+          {
+            auto ownerIt = std::upper_bound(pointIdBases.begin(), pointIdBases.end(), pointId);
+            owner = &pieces[(ownerIt - pointIdBases.begin()) - 1];
+          }
+          *outIds++ = owner->OutputFirstPoint + pointId - owner->PointIdBase;
+        }
+      }
+    });
+
+  vtkNew<vtkCellArray> faces;
+  faces->SetData(faceOffsets, faceConnectivity);
+  mesh->SetPolys(faces);
+}
 }
 
 //----------------------------------------------------------------------------
@@ -577,20 +803,12 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->SetNumberOfOutputPorts(1);
 
   this->TemperatureArray = nullptr;
-  this->BlockIdCellArray = nullptr;
   this->Helper = nullptr;
-
-  this->BlockLocator = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualContour::~vtkAMRDualContour()
 {
-  if (this->BlockLocator)
-  {
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-  }
   this->SetController(nullptr);
 }
 
@@ -738,44 +956,112 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
 
   mpds->SetNumberOfPieces(0);
 
-  this->Mesh = vtkPolyData::New();
-  this->Points = vtkPoints::New();
-  this->Faces = vtkCellArray::New();
-  this->Mesh->SetPoints(this->Points);
-  this->Mesh->SetPolys(this->Faces);
-  mpds->SetPiece(0, this->Mesh);
+  vtkNew<vtkPolyData> mesh;
+  vtkNew<vtkPoints> points;
+  mesh->SetPoints(points);
+  mpds->SetPiece(0, mesh);
 
-  this->InitializeCopyAttributes(hbdsInput, this->Mesh);
+  this->InitializeCopyAttributes(hbdsInput, mesh);
 
   // For debugging.
-  this->BlockIdCellArray = vtkIntArray::New();
-  this->BlockIdCellArray->SetName("BlockIds");
-  this->Mesh->GetCellData()->AddArray(this->BlockIdCellArray);
+  vtkNew<vtkIntArray> blockIdCellArray;
+  blockIdCellArray->SetName("BlockIds");
+  mesh->GetCellData()->AddArray(blockIdCellArray);
 
-  // Loop through blocks
-  int numLevels = hbdsInput->GetNumberOfLevels();
+  // Blocks that touch do not share locators concurrently.  Without merging
+  // all the blocks are independent.
+  std::vector<int> blockWaves;
+  if (this->EnableMergePoints)
+  {
+    this->Helper->ComputeBlockWaves(blockWaves);
+  }
 
   // Add each block.
+  std::vector<::vtkAMRDualContourBlockPiece> pieces;
+  std::vector<std::vector<size_t>> waves;
+  vtkIdType pointIdBase = 0;
+  size_t blockIdx = 0;
+  int numLevels = hbdsInput->GetNumberOfLevels();
   for (int level = 0; level < numLevels; ++level)
   {
     int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
-    for (int blockId = 0; blockId < numBlocks; ++blockId)
+    for (int blockId = 0; blockId < numBlocks; ++blockId, ++blockIdx)
     {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      if (block->Image == nullptr)
+      { // Remote blocks are only to setup local block bit flags.
+        continue;
+      }
+      ::vtkAMRDualContourBlockPiece piece;
+      piece.Block = block;
+      piece.BlockId = blockId;
+      piece.PointIdBase = pointIdBase;
+      // The locator has one entry per cell of the image in each of its arrays.
+      pointIdBase += 4 * block->Image->GetNumberOfCells();
+      size_t wave = blockWaves.empty() ? 0 : static_cast<size_t>(blockWaves[blockIdx]);
+      if (waves.size() <= wave)
+      {
+        waves.resize(wave + 1);
+      }
+      waves[wave].push_back(pieces.size());
+      pieces.push_back(piece);
     }
   }
 
-  this->FinalizeCopyAttributes(this->Mesh);
-  this->BlockIdCellArray->Delete();
-  this->BlockIdCellArray = nullptr;
+  vtkSMPThreadLocal<std::shared_ptr<vtkAMRDualContourOutput>> outputs;
+  for (const auto& wave : waves)
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(wave.size()), 1,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        std::shared_ptr<vtkAMRDualContourOutput>& output = outputs.Local();
+        if (!output)
+        {
+          output = std::make_shared<vtkAMRDualContourOutput>();
+          this->InitializeCopyAttributes(hbdsInput, output->Mesh);
+        }
+        for (vtkIdType idx = begin; idx < end; ++idx)
+        {
+          ::vtkAMRDualContourBlockPiece& piece = pieces[wave[idx]];
+          piece.Output = output.get();
+          piece.FirstPoint = output->Points->GetNumberOfPoints();
+          piece.FirstFace = output->GetNumberOfFaces();
+          output->PointIdOffset = piece.PointIdBase - piece.FirstPoint;
+          piece.Processed = this->ProcessBlock(piece.Block, arrayNameToProcess, output.get());
+          piece.NumberOfPoints = output->Points->GetNumberOfPoints() - piece.FirstPoint;
+          piece.NumberOfFaces = output->GetNumberOfFaces() - piece.FirstFace;
+        }
+      });
+
+    if (this->EnableMergePoints)
+    {
+      // Sharing writes into the locators of later blocks, so it is done in
+      // the same order as the blocks.
+      for (size_t pieceIdx : wave)
+      {
+        vtkAMRDualGridHelperBlock* block = pieces[pieceIdx].Block;
+        if (!pieces[pieceIdx].Processed)
+        {
+          continue;
+        }
+        // Copy point ids into neighbor locators.
+        this->ShareBlockLocatorWithNeighbors(block);
+        // We are done.  We no longer need the locator for this block.
+        delete ::vtkAMRDualContourGetBlockLocator(block);
+        block->UserData = nullptr;
+        // Lets use this unused flag (owner of center region/block) to indicate
+        // that the block is already processes.
+        // This will keep neighbors from recreating the locator.
+        // Another option would be to create the locator object for
+        // all blocks but do not allocate until needed.  Then the existence of the locator
+        // would tell whether the block was processed.
+        block->RegionBits[1][1][1] = 0;
+      }
+    }
+  }
 
-  this->Mesh->Delete();
-  this->Mesh = nullptr;
-  this->Points->Delete();
-  this->Points = nullptr;
-  this->Faces->Delete();
-  this->Faces = nullptr;
+  ::vtkAMRDualContourAppendPieces(pieces, mesh, blockIdCellArray);
+  this->FinalizeCopyAttributes(mesh);
 
   mpds->Delete();
 
@@ -831,13 +1117,13 @@ void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::ProcessBlock(
-  vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayNameToProcess)
+bool vtkAMRDualContour::ProcessBlock(vtkAMRDualGridHelperBlock* block,
+  const char* arrayNameToProcess, vtkAMRDualContourOutput* output)
 {
   vtkImageData* image = block->Image;
   if (image == nullptr)
   { // Remote blocks are only to setup local block bit flags.
-    return;
+    return false;
   }
 
   // We are looking for only cell data arrays.
@@ -845,11 +1131,9 @@ void vtkAMRDualContour::ProcessBlock(
 
   if (!volumeFractionArray)
   {
-    return;
+    return false;
   }
 
-  double origin[3];
-  double* spacing;
   int extent[6];
 
   // Get the origin and point extent of the dual grid (with ghost level).
@@ -863,122 +1147,27 @@ void vtkAMRDualContour::ProcessBlock(
   // Input the dimensions of the dual cells with ghosts.
   if (this->EnableMergePoints)
   {
-    this->BlockLocator = ::vtkAMRDualContourGetBlockLocator(block);
+    output->Locator = ::vtkAMRDualContourGetBlockLocator(block);
   }
   else
-  { // Shared locator.
-    if (this->BlockLocator == nullptr)
-    {
-      this->BlockLocator = new vtkAMRDualContourEdgeLocator;
-    }
-    this->BlockLocator->Initialize(
+  { // Locator of the thread.
+    output->Locator = &output->BlockLocator;
+    output->Locator->Initialize(
       extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    this->BlockLocator->CopyRegionLevelDifferences(block);
-  }
-  image->GetOrigin(origin);
-  spacing = image->GetSpacing();
-  // Dual cells are shifted half a pixel.
-  origin[0] += 0.5 * spacing[0];
-  origin[1] += 0.5 * spacing[1];
-  origin[2] += 0.5 * spacing[2];
-
-  // We deal with the various data types by copying the corner values
-  // into a double array.  We have to cast anyway to compute the case.
-  vtkIdType cornerOffsets[8];
-
-  // The templated function needs the increments for pointers
-  // cast to the correct datatype.
-  int yInc = (extent[1] - extent[0] + 1);
-  int zInc = yInc * (extent[3] - extent[2] + 1);
-  // Use void pointers to march through the volume before we cast.
-  // int dataType = volumeFractionArray->GetDataType();
-  // int xVoidInc = volumeFractionArray->GetDataTypeSize();
-  // int yVoidInc = xVoidInc * yInc;
-  // int zVoidInc = xVoidInc * zInc;
-
-  // Loop over all the cells in the dual grid.
-  int x, y, z;
-  // These are needed to handle the cropped boundary cells.
-  int xMax = extent[1] - 1;
-  int yMax = extent[3] - 1;
-  int zMax = extent[5] - 1;
-  //-
-  vtkIdType zOffset = 0;
-  vtkIdType yOffset = 0;
-  vtkIdType xOffset = 0;
-  //-
-  for (z = extent[4]; z < extent[5]; ++z)
-  {
-    int nz = 1;
-    if (z == extent[4])
-    {
-      nz = 0;
-    }
-    else if (z == zMax)
-    {
-      nz = 2;
-    }
-    yOffset = zOffset;
-    for (y = extent[2]; y < extent[3]; ++y)
-    {
-      int ny = 1;
-      if (y == extent[2])
-      {
-        ny = 0;
-      }
-      else if (y == yMax)
-      {
-        ny = 2;
-      }
-      xOffset = yOffset;
-      for (x = extent[0]; x < extent[1]; ++x)
-      {
-        int nx = 1;
-        if (x == extent[0])
-        {
-          nx = 0;
-        }
-        else if (x == xMax)
-        {
-          nx = 2;
-        }
-        // Skip the cell if a neighbor is already processing it.
-        if ((block->RegionBits[nx][ny][nz] & vtkAMRRegionBitOwner))
-        {
-          // Get the corner values as offsets
-          cornerOffsets[0] = xOffset;
-          cornerOffsets[1] = xOffset + 1;
-          cornerOffsets[2] = xOffset + 1 + yInc;
-          cornerOffsets[3] = xOffset + yInc;
-          cornerOffsets[4] = xOffset + zInc;
-          cornerOffsets[5] = xOffset + 1 + zInc;
-          cornerOffsets[6] = xOffset + 1 + yInc + zInc;
-          cornerOffsets[7] = xOffset + yInc + zInc;
-          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
-        }
-        xOffset += 1; // xInc
-      }
-      yOffset += yInc;
-    }
-    zOffset += zInc;
+    output->Locator->CopyRegionLevelDifferences(block);
   }
 
-  if (this->EnableMergePoints)
+  // Loop over all the cells in the dual grid.
+  auto processDualCell = [&](int x, int y, int z, vtkIdType cornerOffsets[8],
+                           double cornerValues[8], int cubeCase)
+  { this->ProcessDualCell(block, x, y, z, cornerOffsets, cornerValues, cubeCase, output); };
+  ::vtkAMRDualContourProcessDualCells worker;
+  if (!vtkArrayDispatch::Dispatch::Execute(
+        volumeFractionArray, worker, block, extent, this->IsoValue, processDualCell))
   {
-    // Copy point ids into neighbor locators.
-    this->ShareBlockLocatorWithNeighbors(block);
-    // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-    block->UserData = nullptr;
-    // Lets use this unused flag (owner of center region/block) to indicate
-    // that the block is already processes.
-    // This will keep neighbors from recreating the locator.
-    // Another option would be to create the locator object for
-    // all blocks but do not allocate until needed.  Then the existence of the locator
-    // would tell whether the block was processed.
-    block->RegionBits[1][1][1] = 0;
+    worker(volumeFractionArray, block, extent, this->IsoValue, processDualCell);
   }
+  return true;
 }
 
 // Generic table for clipping a square.
@@ -1024,63 +1213,9 @@ static int vtkAMRDualLegacyIdToBitIdMap[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
 // Not implemented as optimally as we could.  It can be improved by making
 // a fast path for internal cells (with no degeneracies).
 // Corner offsets are absolute (relative to origin / 0).
-void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y,
-  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
+void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int x, int y, int z,
+  vtkIdType cornerOffsets[8], double cornerValues[8], int cubeCase, vtkAMRDualContourOutput* output)
 {
-  // compute the case index
-  vtkImageData* image = block->Image;
-  if (image == nullptr)
-  { // Remote blocks are only to setup local block bit flags.
-    return;
-  }
-
-  double cornerValues[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-  for (int i = 0; i < 8; ++i)
-  {
-    cornerValues[i] = volumeFractionArray->GetComponent(cornerOffsets[i], 0);
-  }
-  unsigned char cubeCase = 0;
-  if (cornerValues[0] > this->IsoValue)
-  {
-    cubeCase += 1;
-  }
-  if (cornerValues[1] > this->IsoValue)
-  {
-    cubeCase += 2;
-  }
-  if (cornerValues[2] > this->IsoValue)
-  {
-    cubeCase += 4;
-  }
-  if (cornerValues[3] > this->IsoValue)
-  {
-    cubeCase += 8;
-  }
-  if (cornerValues[4] > this->IsoValue)
-  {
-    cubeCase += 16;
-  }
-  if (cornerValues[5] > this->IsoValue)
-  {
-    cubeCase += 32;
-  }
-  if (cornerValues[6] > this->IsoValue)
-  {
-    cubeCase += 64;
-  }
-  if (cornerValues[7] > this->IsoValue)
-  {
-    cubeCase += 128;
-  }
-
-  // I am trying to exit as quick as possible if there is
-  // no surface to generate.  I could also check that the index
-  // is not on boundary.
-  if (cubeCase == 0 || (cubeCase == 255 && block->BoundaryBits == 0))
-  {
-    return;
-  }
-
   // Which boundaries does this cube/cell touch?
   unsigned char cubeBoundaryBits = 0;
 
@@ -1252,7 +1387,7 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
     // Only permanently keep locator for edges shared between two blocks.
     for (int ii = 0; ii < 3; ++ii, ++edge) // insert triangle
     {
-      vtkIdType* ptIdPtr = this->BlockLocator->GetEdgePointer(x, y, z, *edge);
+      vtkIdType* ptIdPtr = output->Locator->GetEdgePointer(x, y, z, *edge);
 
       if (*ptIdPtr == -1)
       {
@@ -1280,31 +1415,32 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
           cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
         pt[2] =
           cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-        *ptIdPtr = this->Points->InsertNextPoint(pt);
+        vtkIdType localId = output->Points->InsertNextPoint(pt);
+        *ptIdPtr = localId + output->PointIdOffset;
         // Interpolate attributes
         // Find the offsets of the two attributes to interpolate
         vtkIdType offset0 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][0]];
         vtkIdType offset1 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][1]];
-        this->InterpolateAttributes(block->Image, offset0, offset1, k, this->Mesh, *ptIdPtr);
+        this->InterpolateAttributes(block->Image, offset0, offset1, k, output->Mesh, localId);
       }
       edgePointIds[*edge] = pointIds[ii] = *ptIdPtr;
     }
     if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[1] != pointIds[2])
     {
-      this->Faces->InsertNextCell(3, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      output->InsertNextFace(3, pointIds);
     }
   }
 
   if (this->EnableCapping)
   {
     this->CapCell(x, y, z, cubeBoundaryBits, cubeCase, edgePointIds, cornerPoints, cornerOffsets,
-      blockId, block->Image);
+      output, block->Image);
   }
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId)
+void vtkAMRDualContour::AddCapPolygon(
+  int ptCount, vtkIdType* pointIds, vtkAMRDualContourOutput* output)
 {
   if (this->TriangulateCap)
   {
@@ -1320,8 +1456,7 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          output->InsertNextFace(3, tri);
         }
       }
       else
@@ -1331,16 +1466,14 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          output->InsertNextFace(3, tri);
         }
         tri[0] = pointIds[high];
         tri[1] = pointIds[high + 1];
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          output->InsertNextFace(3, tri);
         }
       }
       ++low;
@@ -1350,8 +1483,7 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
   else
   {
     // Do not worry about degenerate polygons in this path.
-    this->Faces->InsertNextCell(ptCount, pointIds);
-    this->BlockIdCellArray->InsertNextValue(blockId);
+    output->InsertNextFace(ptCount, pointIds);
   }
 }
 
@@ -1375,8 +1507,8 @@ void vtkAMRDualContour::CapCell(
   double cornerPoints[32],
   // The id order is VTK from marching cube cases.  Different than axis ordered "cornerPoints".
   vtkIdType cornerOffsets[8],
-  // For block id array (for debugging).  I should just make this an ivar.
-  int blockId,
+  // Where the cap polygons go.
+  vtkAMRDualContourOutput* output,
   // For passing attributes to output mesh
   vtkDataSet* inData)
 {
@@ -1397,12 +1529,13 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            vtkIdType localId = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = localId + output->PointIdOffset;
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1412,7 +1545,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, output);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1433,12 +1566,13 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            vtkIdType localId = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = localId + output->PointIdOffset;
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1448,7 +1582,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, output);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1470,12 +1604,13 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            vtkIdType localId = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = localId + output->PointIdOffset;
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1485,7 +1620,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, output);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1507,12 +1642,13 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            vtkIdType localId = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = localId + output->PointIdOffset;
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1522,7 +1658,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, output);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1543,12 +1679,13 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            vtkIdType localId = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = localId + output->PointIdOffset;
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1558,7 +1695,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, output);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1580,12 +1717,13 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            vtkIdType localId = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            *ptIdPtr = localId + output->PointIdOffset;
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              output->Mesh, localId);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1595,7 +1733,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, output);
       if (*capPtr == -1)
       {
         ++capPtr;
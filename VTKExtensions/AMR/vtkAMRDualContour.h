@@ -43,6 +43,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualContourEdgeLocator;
+class vtkAMRDualContourOutput;
 
 class VTKPVVTKEXTENSIONSAMR_EXPORT vtkAMRDualContour : public vtkMultiBlockDataSetAlgorithm
 {
@@ -143,12 +144,19 @@ protected:
 
   void ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block);
 
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
+  /**
+   * Contours the dual cells owned by the block into the output of the
+   * calling thread.  Returns false when the block has no data to contour.
+   * Blocks are processed concurrently, one per thread.
+   */
+  bool ProcessBlock(
+    vtkAMRDualGridHelperBlock* block, const char* arrayName, vtkAMRDualContourOutput* output);
 
-  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
-    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int x, int y, int z,
+    vtkIdType cornerOffsets[8], double cornerValues[8], int cubeCase,
+    vtkAMRDualContourOutput* output);
 
-  void AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId);
+  void AddCapPolygon(int ptCount, vtkIdType* pointIds, vtkAMRDualContourOutput* output);
 
   // This method is getting too many arguments!
   // Capping was an after thought...
@@ -165,20 +173,16 @@ protected:
     double cornerPoints[32],
     // The id order is VTK from marching cube cases.  Different than axis ordered "cornerPoints".
     vtkIdType cornerOffsets[8],
-    // For block id array (for debugging).  I should just make this an ivar.
-    int blockId,
+    // Where the cap polygons go.
+    vtkAMRDualContourOutput* output,
     // For passing attributes to output mesh
     vtkDataSet* inData);
 
   // Stuff exclusively for debugging.
-  vtkIntArray* BlockIdCellArray;
   vtkFloatArray* TemperatureArray;
 
   // Ivars used to reduce method parrameters.
   vtkAMRDualGridHelper* Helper;
-  vtkPolyData* Mesh;
-  vtkPoints* Points;
-  vtkCellArray* Faces;
 
   vtkMultiProcessController* Controller;
 
@@ -187,8 +191,6 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualContourEdgeLocator* BlockLocator;
-
   // Stuff for passing cell attributes to point attributes.
   void InitializeCopyAttributes(vtkNonOverlappingAMR* hbdsInput, vtkDataSet* mesh);
   void InterpolateAttributes(vtkDataSet* uGrid, vtkIdType offset0, vtkIdType offset1, double k,
@@ -14,6 +14,7 @@
 #include "vtkMultiProcessController.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSortDataArray.h"
 #include "vtkTimerLog.h"
 #include "vtkUniformGrid.h"
@@ -23,8 +24,10 @@
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <list>
+#include <unordered_map>
 #include <vector>
 
 #include "vtksys/SystemTools.hxx"
@@ -51,6 +54,14 @@ class vtkAMRDualGridHelperSeed;
 static const int SHARED_BLOCK_TAG = 2392734;
 static const int DEGENERATE_REGION_TAG = 879015;
 
+//=============================================================================
+// Just a hack to test an assumption.
+// This can be removed once we determine how the ghost values behave across
+// level changes.
+// Local degenerate regions are copied concurrently, hence the atomics.
+static std::atomic<int> vtkDualGridHelperCheckAssumption(0);
+static std::atomic<int> vtkDualGridHelperSkipGhostCopy(0);
+
 //=============================================================================
 #if 1
 namespace
@@ -872,8 +883,8 @@ void vtkAMRDualGridHelper::AddBlock(int level, int id, vtkImageData* volume)
   // block->OriginIndex[1] = this->StandardBlockDimensions[1] * y - 1;
   // block->OriginIndex[2] = this->StandardBlockDimensions[2] * z - 1;
 
-  // Complete ghost levels if they have been stripped by the reader.
-  block->AddBackGhostLevels(this->StandardBlockDimensions);
+  // Ghost levels stripped by the reader are completed in Initialize,
+  // once all the blocks have been added.
 }
 
 //----------------------------------------------------------------------------
@@ -1093,6 +1104,106 @@ void vtkAMRDualGridHelper::AssignSharedRegions()
         }
       }
     }
+    // Lower levels only receive values from even lower levels, so the
+    // regions of this level can be copied before they are claimed.
+    this->ProcessLocalDegenerateRegionQueue();
+  }
+}
+//----------------------------------------------------------------------------
+// The regions queued by ClaimBlockSharedRegion only read lower level blocks
+// and only write the ghost cells of higher level blocks.  Each receiving
+// block is filled by a single task, in the order regions were claimed.
+void vtkAMRDualGridHelper::ProcessLocalDegenerateRegionQueue()
+{
+  std::vector<vtkAMRDualGridHelperDegenerateRegion>& queue = this->LocalDegenerateRegionQueue;
+  std::stable_sort(queue.begin(), queue.end(),
+    [](const vtkAMRDualGridHelperDegenerateRegion& a,
+      const vtkAMRDualGridHelperDegenerateRegion& b)
+    { return a.ReceivingBlock->BlockId < b.ReceivingBlock->BlockId; });
+  std::vector<size_t> starts;
+  for (size_t ii = 0; ii < queue.size(); ++ii)
+  {
+    if (ii == 0 || queue[ii].ReceivingBlock != queue[ii - 1].ReceivingBlock)
+    {
+      starts.push_back(ii);
+    }
+  }
+  starts.push_back(queue.size());
+
+  vtkDualGridHelperSkipGhostCopy = this->SkipGhostCopy;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(starts.size()) - 1,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType blockIdx = begin; blockIdx < end; ++blockIdx)
+      {
+        for (size_t ii = starts[blockIdx]; ii < starts[blockIdx + 1]; ++ii)
+        {
+          const vtkAMRDualGridHelperDegenerateRegion& region = queue[ii];
+          this->CopyDegenerateRegionBlockToBlock(region.ReceivingRegion[0],
+            region.ReceivingRegion[1], region.ReceivingRegion[2], region.SourceBlock,
+            region.SourceArray, region.ReceivingBlock, region.ReceivingArray);
+        }
+      }
+    });
+  queue.clear();
+}
+//----------------------------------------------------------------------------
+void vtkAMRDualGridHelper::ComputeBlockWaves(std::vector<int>& waves)
+{
+  std::vector<vtkAMRDualGridHelperBlock*> blocks;
+  std::unordered_map<vtkAMRDualGridHelperBlock*, size_t> blockOrder;
+  int numLevels = this->GetNumberOfLevels();
+  for (int level = 0; level < numLevels; ++level)
+  {
+    int numBlocks = this->GetNumberOfBlocksInLevel(level);
+    for (int blockIdx = 0; blockIdx < numBlocks; ++blockIdx)
+    {
+      vtkAMRDualGridHelperBlock* block = this->GetBlock(level, blockIdx);
+      blockOrder[block] = blocks.size();
+      blocks.push_back(block);
+    }
+  }
+
+  // Blocks are visited in order, so the wave of a block is final before
+  // it is used to push back the waves of its neighbors.
+  waves.assign(blocks.size(), 0);
+  for (size_t ii = 0; ii < blocks.size(); ++ii)
+  {
+    vtkAMRDualGridHelperBlock* block = blocks[ii];
+    if (block->Image == nullptr)
+    {
+      continue;
+    }
+    // Same neighborhood as the one the filters share their locators with.
+    for (int level = block->Level; level < numLevels; ++level)
+    {
+      int levelDiff = level - block->Level;
+      int xMid = block->GridIndex[0];
+      int yMid = block->GridIndex[1];
+      int zMid = block->GridIndex[2];
+      for (int iz = (zMid << levelDiff) - 1; iz <= ((zMid + 1) << levelDiff); ++iz)
+      {
+        for (int iy = (yMid << levelDiff) - 1; iy <= ((yMid + 1) << levelDiff); ++iy)
+        {
+          for (int ix = (xMid << levelDiff) - 1; ix <= ((xMid + 1) << levelDiff); ++ix)
+          {
+            if ((ix >> levelDiff) != xMid || (iy >> levelDiff) != yMid ||
+              (iz >> levelDiff) != zMid)
+            {
+              vtkAMRDualGridHelperBlock* neighbor = this->GetBlock(level, ix, iy, iz);
+              if (neighbor && neighbor->Image)
+              {
+                size_t neighborIdx = blockOrder[neighbor];
+                if (neighborIdx > ii)
+                {
+                  waves[neighborIdx] = std::max(waves[neighborIdx], waves[ii] + 1);
+                }
+              }
+            }
+          }
+        }
+      }
+    }
   }
 }
 void vtkAMRDualGridHelper::AssignBlockSharedRegions(
@@ -1329,8 +1440,16 @@ int vtkAMRDualGridHelper::ClaimBlockSharedRegion(vtkAMRDualGridHelperBlock* bloc
       vtkDataArray* bestBlockDataArray = bestBlock->Image->GetCellData()->GetArray(this->ArrayName);
       if (blockDataArray && bestBlockDataArray)
       {
-        this->CopyDegenerateRegionBlockToBlock(
-          regionX, regionY, regionZ, bestBlock, bestBlockDataArray, block, blockDataArray);
+        // The copy is done with the other regions of this level.
+        vtkAMRDualGridHelperDegenerateRegion dreg;
+        dreg.ReceivingRegion[0] = regionX;
+        dreg.ReceivingRegion[1] = regionY;
+        dreg.ReceivingRegion[2] = regionZ;
+        dreg.ReceivingBlock = block;
+        dreg.ReceivingArray = blockDataArray;
+        dreg.SourceBlock = bestBlock;
+        dreg.SourceArray = bestBlockDataArray;
+        this->LocalDegenerateRegionQueue.push_back(dreg);
       }
     }
   }
@@ -1355,12 +1474,6 @@ void vtkAMRDualGridHelper::QueueRegionRemoteCopy(int regionX, int regionY, int r
   }
 }
 
-// Just a hack to test an assumption.
-// This can be removed once we determine how the ghost values behave across
-// level changes.
-static int vtkDualGridHelperCheckAssumption = 0;
-static int vtkDualGridHelperSkipGhostCopy = 0;
-
 // Given source and destination process ids, returns the buffer size, in bytes,
 // required to send the approprate degenerate cell information.  If 0 is
 // returned, it is not necessary to transfer any information, which is common.
@@ -1468,14 +1581,13 @@ void vtkDualGridHelperCopyBlockToBlock(vtkDataArray* ptr, vtkDataArray* lowerPtr
         lx = ((x + highResBlockOriginIndex[0]) >> levelDiff) - lowResBlockOriginIndex[0];
         val = lowerPtr->GetTuple1(lx + ly * yInc + lz * zInc);
         // Lets see if our assumption about ghost values is correct.
-        if (vtkDualGridHelperCheckAssumption && vtkDualGridHelperSkipGhostCopy &&
-          ptr->GetTuple1(xIndex) != val)
+        // Report issue once per execution.
+        if (vtkDualGridHelperSkipGhostCopy && ptr->GetTuple1(xIndex) != val &&
+          vtkDualGridHelperCheckAssumption.exchange(0))
         {
           // Sandia did get this message so I will default to have ghost copy on.
           //  I did not document the assumption well enough.
           vtkGenericWarningMacro("Ghost assumption incorrect.  Seams may result.");
-          // Report issue once per execution.
-          vtkDualGridHelperCheckAssumption = 0;
         }
         ptr->SetTuple1(xIndex, val);
         xIndex++;
@@ -2315,6 +2427,26 @@ int vtkAMRDualGridHelper::Initialize(vtkNonOverlappingAMR* input)
     }
   }
 
+  // Complete ghost levels if they have been stripped by the reader.
+  // Each block only copies its own image.
+  std::vector<vtkAMRDualGridHelperBlock*> localBlocks;
+  for (int level = 0; level < numLevels; ++level)
+  {
+    numBlocks = this->GetNumberOfBlocksInLevel(level);
+    for (blockId = 0; blockId < numBlocks; ++blockId)
+    {
+      localBlocks.push_back(this->GetBlock(level, blockId));
+    }
+  }
+  vtkSMPTools::For(0, static_cast<vtkIdType>(localBlocks.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType idx = begin; idx < end; ++idx)
+      {
+        localBlocks[idx]->AddBackGhostLevels(this->StandardBlockDimensions);
+      }
+    });
+
   if (neighbors)
   {
     // if we have passed neighbor information, use this to send blocks only to those
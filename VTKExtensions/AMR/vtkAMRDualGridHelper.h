@@ -125,6 +125,15 @@ public:
    * Call this before adding regions to the queue.  It clears the queue.
    */
   void ClearRegionRemoteCopyQueue();
+  /**
+   * Groups the blocks of this process so that filters can process them
+   * concurrently.  Waves gets one value per block, in GetBlock(level, blockIdx)
+   * order.  A block is in a later wave than every block before it whose
+   * neighborhood, in its level or higher, contains it.  Blocks of the same
+   * wave never share locator regions.
+   */
+  void ComputeBlockWaves(std::vector<int>& waves);
+
   ///@{
   /**
    * It is convenient to get this here.
@@ -210,6 +219,11 @@ private:
   void UnmarshalDegenerateRegionMessage(
     const void* messagePtr, int messageLength, int srcProc, bool hackLevelFlag);
 
+  // Degenerate regions between blocks of this process.  They are copied
+  // concurrently once all the regions of a level have been claimed.
+  std::vector<vtkAMRDualGridHelperDegenerateRegion> LocalDegenerateRegionQueue;
+  void ProcessLocalDegenerateRegionQueue();
+
   int SkipGhostCopy;
 
   int EnableAsynchronousCommunication;
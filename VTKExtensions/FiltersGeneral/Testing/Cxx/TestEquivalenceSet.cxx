@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkEquivalenceSet.h"
+#include "vtkNew.h"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#define vtk_assert(x)                                                                              \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    std::cerr << "On line " << __LINE__ << " ERROR: Condition FAILED!! : " << #x << endl;          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+int TestEquivalenceSet(int, char*[])
+{
+  // Small set: {0, 2, 5}, {1, 4}, {3}, {6}.
+  vtkNew<vtkEquivalenceSet> set;
+  set->AddEquivalence(5, 2);
+  set->AddEquivalence(4, 1);
+  set->AddEquivalence(3, 3);
+  set->AddEquivalence(2, 0);
+  set->AddEquivalence(6, 6);
+  vtk_assert(set->GetNumberOfMembers() == 7);
+  vtk_assert(set->GetEquivalentSetId(5) == 0);
+  vtk_assert(set->GetEquivalentSetId(4) == 1);
+  vtk_assert(set->ResolveEquivalences() == 4);
+  const int expected[7] = { 0, 1, 0, 2, 1, 0, 3 };
+  for (int ii = 0; ii < 7; ++ii)
+  {
+    vtk_assert(set->GetEquivalentSetId(ii) == expected[ii]);
+  }
+
+  // Adding pairs in a batch must give the same sets as adding them one at a
+  // time.
+  const int numberOfMembers = 200000;
+  const int numberOfPairs = 150000;
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> distribution(0, numberOfMembers - 1);
+  std::vector<int> id1(numberOfPairs);
+  std::vector<int> id2(numberOfPairs);
+  for (int ii = 0; ii < numberOfPairs; ++ii)
+  {
+    id1[ii] = distribution(generator);
+    id2[ii] = distribution(generator);
+  }
+
+  vtkNew<vtkEquivalenceSet> serialSet;
+  for (int ii = 0; ii < numberOfPairs; ++ii)
+  {
+    serialSet->AddEquivalence(id1[ii], id2[ii]);
+  }
+  vtkNew<vtkEquivalenceSet> batchSet;
+  // Two batches, so that the second one grows an existing set.
+  const int half = numberOfPairs / 2;
+  batchSet->AddEquivalences(id1.data(), id2.data(), half);
+  batchSet->AddEquivalences(id1.data() + half, id2.data() + half, numberOfPairs - half);
+
+  vtk_assert(serialSet->GetNumberOfMembers() == batchSet->GetNumberOfMembers());
+  const int numberOfSets = serialSet->ResolveEquivalences();
+  vtk_assert(batchSet->ResolveEquivalences() == numberOfSets);
+  int maxSetId = -1;
+  for (int ii = 0; ii < serialSet->GetNumberOfMembers(); ++ii)
+  {
+    const int setId = serialSet->GetEquivalentSetId(ii);
+    vtk_assert(setId == batchSet->GetEquivalentSetId(ii));
+    // Set ids are assigned in the order of the smallest member.
+    vtk_assert(setId <= maxSetId + 1);
+    maxSetId = std::max(maxSetId, setId);
+  }
+  vtk_assert(maxSetId == numberOfSets - 1);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntegrateFlowThroughSurface.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+bool Compare(const char* what, double expected, double actual)
+{
+  if (std::abs(expected - actual) > 1e-10 * std::max(1.0, std::abs(expected)))
+  {
+    std::cerr << "Mismatched " << what << ": " << expected << " != " << actual << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestIntegrateFlowThroughSurfaceFastMode(int, char*[])
+{
+  // A warped surface made of quads and triangles, with a varying vector field.
+  const int n = 60;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> velocity;
+  velocity->SetName("Velocity");
+  velocity->SetNumberOfComponents(3);
+  for (int j = 0; j <= n; ++j)
+  {
+    for (int i = 0; i <= n; ++i)
+    {
+      const double x = 0.1 * i, y = 0.1 * j;
+      points->InsertNextPoint(x, y, 0.3 * std::sin(x) * std::cos(y));
+      velocity->InsertNextTuple3(0.2 * y, -0.1 * x, 1.0 + 0.5 * x);
+    }
+  }
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < n; ++j)
+  {
+    for (int i = 0; i < n; ++i)
+    {
+      const vtkIdType p0 = i + (n + 1) * j;
+      const vtkIdType quad[4] = { p0, p0 + 1, p0 + n + 2, p0 + n + 1 };
+      if ((i + j) % 2)
+      {
+        polys->InsertNextCell(4, quad);
+      }
+      else
+      {
+        const vtkIdType first[3] = { quad[0], quad[1], quad[2] };
+        const vtkIdType second[3] = { quad[0], quad[2], quad[3] };
+        polys->InsertNextCell(3, first);
+        polys->InsertNextCell(3, second);
+      }
+    }
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->SetPolys(polys);
+  input->GetPointData()->SetVectors(velocity);
+
+  vtkNew<vtkIntegrateFlowThroughSurface> expected;
+  expected->SetInputData(input);
+  expected->Update();
+
+  vtkNew<vtkIntegrateFlowThroughSurface> actual;
+  actual->SetInputData(input);
+  actual->FastModeOn();
+  actual->Update();
+
+  vtkUnstructuredGrid* expectedOutput = expected->GetOutput();
+  vtkUnstructuredGrid* actualOutput = actual->GetOutput();
+  if (actualOutput->GetNumberOfPoints() != 1 || actualOutput->GetNumberOfCells() != 1)
+  {
+    std::cerr << "Expected a single point and vertex." << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char* pointArrays[] = { "Surface Flow", "Velocity" };
+  for (const char* name : pointArrays)
+  {
+    vtkDataArray* expectedArray = expectedOutput->GetPointData()->GetArray(name);
+    vtkDataArray* actualArray = actualOutput->GetPointData()->GetArray(name);
+    if (!expectedArray || !actualArray ||
+      expectedArray->GetNumberOfComponents() != actualArray->GetNumberOfComponents())
+    {
+      std::cerr << "Mismatched array " << name << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (int cc = 0; cc < expectedArray->GetNumberOfComponents(); ++cc)
+    {
+      if (!Compare(name, expectedArray->GetComponent(0, cc), actualArray->GetComponent(0, cc)))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  vtkDataArray* expectedArea = expectedOutput->GetCellData()->GetArray("Area");
+  vtkDataArray* actualArea = actualOutput->GetCellData()->GetArray("Area");
+  if (!expectedArea || !actualArea ||
+    !Compare("area", expectedArea->GetComponent(0, 0), actualArea->GetComponent(0, 0)))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVArrayCalculator.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+namespace
+{
+// Exposes which evaluation the last execution used.
+class vtkTestPVArrayCalculator : public vtkPVArrayCalculator
+{
+public:
+  static vtkTestPVArrayCalculator* New();
+  vtkTypeMacro(vtkTestPVArrayCalculator, vtkPVArrayCalculator);
+  using vtkPVArrayCalculator::GetUsedCompiledExpression;
+};
+vtkStandardNewMacro(vtkTestPVArrayCalculator);
+
+// Returns the result of the given block (the input itself if it is not composite), which must
+// also be the active scalars or vectors.
+// `compiled` tells whether the compiled program was used.
+vtkDataArray* RunCalculator(vtkDataObject* input, const char* function, bool compile,
+  bool& compiled, unsigned int block = 0)
+{
+  vtkNew<vtkTestPVArrayCalculator> calculator;
+  calculator->SetInputData(input);
+  calculator->SetFunction(function);
+  calculator->SetResultArrayName("Result");
+  calculator->SetCompileExpression(compile);
+  calculator->Update();
+  compiled = calculator->GetUsedCompiledExpression();
+  vtkDataObject* output = calculator->GetOutputDataObject(0);
+  if (auto outputMB = vtkMultiBlockDataSet::SafeDownCast(output))
+  {
+    output = outputMB->GetBlock(block);
+  }
+  auto outputPD = vtkPolyData::SafeDownCast(output);
+  vtkDataArray* result = outputPD ? outputPD->GetPointData()->GetArray("Result") : nullptr;
+  if (!result ||
+    (result != outputPD->GetPointData()->GetScalars() &&
+      result != outputPD->GetPointData()->GetVectors()))
+  {
+    return nullptr;
+  }
+  result->Register(nullptr);
+  return result;
+}
+
+// Compares the results with and without CompileExpression, and checks that the compiled program
+// is used only when CompileExpression is on and the function is supported.
+bool CompareResults(
+  vtkDataObject* input, const char* function, bool supported, unsigned int block = 0)
+{
+  bool expectedCompiled = true;
+  bool actualCompiled = false;
+  vtkDataArray* expected = RunCalculator(input, function, false, expectedCompiled, block);
+  vtkDataArray* actual = RunCalculator(input, function, true, actualCompiled, block);
+  bool same = true;
+  if (expectedCompiled)
+  {
+    std::cerr << "'" << function << "' was compiled without CompileExpression." << std::endl;
+    same = false;
+  }
+  else if (actualCompiled != supported)
+  {
+    std::cerr << "'" << function << "' used the " << (actualCompiled ? "compiled" : "regular")
+              << " evaluation with CompileExpression." << std::endl;
+    same = false;
+  }
+  else if (!expected || !actual ||
+    expected->GetNumberOfComponents() != actual->GetNumberOfComponents() ||
+    expected->GetNumberOfTuples() != actual->GetNumberOfTuples())
+  {
+    std::cerr << "Mismatched result array for '" << function << "'." << std::endl;
+    same = false;
+  }
+  for (vtkIdType i = 0; same && i < expected->GetNumberOfTuples(); ++i)
+  {
+    for (int cc = 0; same && cc < expected->GetNumberOfComponents(); ++cc)
+    {
+      const double a = expected->GetComponent(i, cc);
+      const double b = actual->GetComponent(i, cc);
+      if (std::abs(a - b) > 1e-12 * std::max(1.0, std::abs(a)))
+      {
+        std::cerr << "Mismatched value for '" << function << "' at " << i << ": " << a
+                  << " != " << b << std::endl;
+        same = false;
+      }
+    }
+  }
+  if (expected)
+  {
+    expected->Delete();
+  }
+  if (actual)
+  {
+    actual->Delete();
+  }
+  return same;
+}
+}
+
+int TestPVArrayCalculatorCompiledExpression(int, char*[])
+{
+  // More than one block of tuples, with a partial last block.
+  const vtkIdType numberOfPoints = 5000;
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<double> distribution(-10.0, 10.0);
+
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numberOfPoints);
+  vtkNew<vtkDoubleArray> pressure;
+  pressure->SetName("Pressure");
+  pressure->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkFloatArray> velocity;
+  velocity->SetName("Velocity");
+  velocity->SetNumberOfComponents(3);
+  velocity->SetNumberOfTuples(numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    points->SetPoint(i, distribution(generator), distribution(generator), distribution(generator));
+    pressure->SetValue(i, distribution(generator));
+    for (int cc = 0; cc < 3; ++cc)
+    {
+      velocity->SetTypedComponent(i, cc, static_cast<float>(distribution(generator)));
+    }
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->GetPointData()->AddArray(pressure);
+  input->GetPointData()->AddArray(velocity);
+
+  // Compiled functions, and one that is not compiled and must still give the
+  // same result through the regular evaluation.
+  const struct
+  {
+    const char* Function;
+    bool Supported;
+  } functions[] = { { "mag(Velocity)", true }, { "cross(Velocity, coords)", true },
+    { "if(Pressure > 0, Pressure, -2 * Pressure)", true },
+    { "dot(Velocity, coords) / (1 + abs(Pressure))", true },
+    { "norm(Velocity) * sqrt(abs(coordsX)) + 0.5 * iHat", true },
+    { "Velocity_X * Pressure - coordsZ", true }, { "Pressure^2", false } };
+  for (const auto& function : functions)
+  {
+    if (!CompareResults(input, function.Function, function.Supported))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Composite inputs are evaluated block by block, empty blocks being passed as is.
+  vtkNew<vtkPolyData> other;
+  other->DeepCopy(input);
+  vtkDoubleArray::SafeDownCast(other->GetPointData()->GetArray("Pressure"))->SetValue(0, 42.0);
+  vtkNew<vtkPolyData> empty;
+  vtkNew<vtkMultiBlockDataSet> multiblock;
+  multiblock->SetBlock(0, input);
+  multiblock->SetBlock(1, empty);
+  multiblock->SetBlock(2, other);
+  for (const auto& function : functions)
+  {
+    if (!CompareResults(multiblock, function.Function, function.Supported, 0) ||
+      !CompareResults(multiblock, function.Function, function.Supported, 2))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,173 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCellArray.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkDummyController.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPVGlyphFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkTrivialProducer.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    std::cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                   \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+const char* IdsArrayName = "InputIds";
+
+void AddPointIds(vtkDataSet* dataSet)
+{
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName(IdsArrayName);
+  ids->SetNumberOfTuples(dataSet->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < dataSet->GetNumberOfPoints(); ++cc)
+  {
+    ids->SetValue(cc, cc);
+  }
+  dataSet->GetPointData()->AddArray(ids);
+}
+
+// A 300 x 300 quad surface with a bumpy z, so that the quads have different areas. It has more
+// cells than a chunk of the parallel prefix sum.
+vtkSmartPointer<vtkPolyData> MakeSurface()
+{
+  const int resolution = 300;
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j <= resolution; ++j)
+  {
+    for (int i = 0; i <= resolution; ++i)
+    {
+      const double x = i * 0.01;
+      const double y = j * 0.01;
+      points->InsertNextPoint(x, y, 0.2 * std::sin(5 * x) * std::cos(3 * y));
+    }
+  }
+  vtkNew<vtkCellArray> quads;
+  for (int j = 0; j < resolution; ++j)
+  {
+    for (int i = 0; i < resolution; ++i)
+    {
+      const vtkIdType first = j * (resolution + 1) + i;
+      const vtkIdType next = first + resolution + 1;
+      const vtkIdType quad[4] = { first, first + 1, next + 1, next };
+      quads->InsertNextCell(4, quad);
+    }
+  }
+  auto surface = vtkSmartPointer<vtkPolyData>::New();
+  surface->SetPoints(points);
+  surface->SetPolys(quads);
+  AddPointIds(surface);
+  return surface;
+}
+
+// A stretched 41 x 41 x 41 cells grid, so that the cells have different volumes. It has more cells
+// than a chunk of the parallel prefix sum.
+vtkSmartPointer<vtkRectilinearGrid> MakeVolume()
+{
+  const int resolution = 41;
+  vtkNew<vtkDoubleArray> coords[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    coords[axis]->SetNumberOfTuples(resolution + 1);
+    for (int n = 0; n <= resolution; ++n)
+    {
+      coords[axis]->SetValue(n, n + 0.01 * (axis + 1) * n * n);
+    }
+  }
+  auto volume = vtkSmartPointer<vtkRectilinearGrid>::New();
+  volume->SetDimensions(resolution + 1, resolution + 1, resolution + 1);
+  volume->SetXCoordinates(coords[0]);
+  volume->SetYCoordinates(coords[1]);
+  volume->SetZCoordinates(coords[2]);
+  AddPointIds(volume);
+  return volume;
+}
+
+// Returns the ids of the input points glyphed with the given mode and number of threads.
+std::vector<vtkIdType> GlyphedPointIds(vtkDataSet* input, int glyphMode, int numberOfThreads)
+{
+  std::vector<vtkIdType> pointIds;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads },
+    [&]()
+    {
+      // A single vertex, so that each glyph has exactly one point.
+      vtkNew<vtkPoints> vertexPoints;
+      vertexPoints->InsertNextPoint(0, 0, 0);
+      vtkNew<vtkCellArray> vertices;
+      const vtkIdType vertex = 0;
+      vertices->InsertNextCell(1, &vertex);
+      vtkNew<vtkPolyData> glyph;
+      glyph->SetPoints(vertexPoints);
+      glyph->SetVerts(vertices);
+      vtkNew<vtkTrivialProducer> glyphProducer;
+      glyphProducer->SetOutput(glyph);
+
+      vtkNew<vtkPVGlyphFilter> filter;
+      filter->SetInputData(input);
+      filter->SetSourceConnection(0, glyphProducer->GetOutputPort());
+      filter->SetGlyphMode(glyphMode);
+      filter->SetMaximumNumberOfSamplePoints(5000);
+      filter->SetSeed(7);
+      filter->Update();
+
+      vtkIdTypeArray* ids = vtkIdTypeArray::SafeDownCast(
+        filter->GetOutput()->GetPointData()->GetArray(IdsArrayName));
+      for (vtkIdType cc = 0; ids && cc < ids->GetNumberOfTuples(); ++cc)
+      {
+        pointIds.push_back(ids->GetValue(cc));
+      }
+    });
+  return pointIds;
+}
+}
+
+extern int TestPVGlyphFilterSamplingThreads(int, char*[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  vtkSmartPointer<vtkPolyData> surface = MakeSurface();
+  vtkSmartPointer<vtkRectilinearGrid> volume = MakeVolume();
+
+  struct Case
+  {
+    vtkDataSet* Input;
+    int GlyphMode;
+  };
+  const Case cases[] = {
+    { volume, vtkPVGlyphFilter::SPATIALLY_UNIFORM_DISTRIBUTION },
+    { surface, vtkPVGlyphFilter::SPATIALLY_UNIFORM_INVERSE_TRANSFORM_SAMPLING_SURFACE },
+    { volume, vtkPVGlyphFilter::SPATIALLY_UNIFORM_INVERSE_TRANSFORM_SAMPLING_VOLUME },
+  };
+
+  // The closest points are stored per sample point, the cell measures are added in cell order and
+  // the prefix sum is chunked independently of the number of threads, so the glyphed points must
+  // not depend on the number of threads.
+  for (const Case& test : cases)
+  {
+    const std::vector<vtkIdType> serial = GlyphedPointIds(test.Input, test.GlyphMode, 1);
+    TASSERT(!serial.empty());
+    for (int numberOfThreads : { 2, 4, 8 })
+    {
+      TASSERT(GlyphedPointIds(test.Input, test.GlyphMode, numberOfThreads) == serial);
+    }
+  }
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkPVIntegrateAttributes.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+bool Compare(const char* what, double expected, double actual)
+{
+  if (std::abs(expected - actual) > 1e-10 * std::max(1.0, std::abs(expected)))
+  {
+    std::cerr << "Mismatched " << what << ": " << expected << " != " << actual << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool CompareArrays(vtkDataSetAttributes* expected, vtkDataSetAttributes* actual)
+{
+  for (int i = 0; i < expected->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* expectedArray = expected->GetArray(i);
+    vtkDataArray* actualArray = actual->GetArray(expectedArray->GetName());
+    if (!actualArray ||
+      actualArray->GetNumberOfComponents() != expectedArray->GetNumberOfComponents())
+    {
+      std::cerr << "Missing array " << expectedArray->GetName() << std::endl;
+      return false;
+    }
+    for (int cc = 0; cc < expectedArray->GetNumberOfComponents(); ++cc)
+    {
+      if (!Compare(expectedArray->GetName(), expectedArray->GetComponent(0, cc),
+            actualArray->GetComponent(0, cc)))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestPVIntegrateAttributesFastMode(int, char*[])
+{
+  // A lattice of hexahedra with planar faces, for which the tetrahedra split
+  // of vtkIntegrateAttributes is exact too, followed by a few tetrahedra.
+  const int n = 40;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> linear;
+  linear->SetName("Linear");
+  vtkNew<vtkDoubleArray> vector;
+  vector->SetName("Vector");
+  vector->SetNumberOfComponents(3);
+  for (int k = 0; k <= n; ++k)
+  {
+    for (int j = 0; j <= n; ++j)
+    {
+      for (int i = 0; i <= n; ++i)
+      {
+        const double x = 0.5 * i, y = 0.25 * j, z = 0.1 * k;
+        points->InsertNextPoint(x, y, z);
+        linear->InsertNextValue(x + 2.0 * y - 3.0 * z);
+        vector->InsertNextTuple3(1.0, y, x * z);
+      }
+    }
+  }
+  auto pointId = [n](int i, int j, int k) -> vtkIdType { return i + (n + 1) * (j + (n + 1) * k); };
+
+  vtkNew<vtkUnstructuredGrid> input;
+  input->SetPoints(points);
+  input->Allocate(n * n * n + n);
+  vtkNew<vtkDoubleArray> cellValue;
+  cellValue->SetName("CellValue");
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        const vtkIdType hex[8] = { pointId(i, j, k), pointId(i + 1, j, k),
+          pointId(i + 1, j + 1, k), pointId(i, j + 1, k), pointId(i, j, k + 1),
+          pointId(i + 1, j, k + 1), pointId(i + 1, j + 1, k + 1), pointId(i, j + 1, k + 1) };
+        input->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+        cellValue->InsertNextValue(i - j + 0.5 * k);
+      }
+    }
+  }
+  for (int i = 0; i < n; ++i)
+  {
+    const vtkIdType tetra[4] = { pointId(i, 0, 0), pointId(i + 1, 0, 0), pointId(i, 1, 0),
+      pointId(i, 0, 1) };
+    input->InsertNextCell(VTK_TETRA, 4, tetra);
+    cellValue->InsertNextValue(-i);
+  }
+  input->GetPointData()->AddArray(linear);
+  input->GetPointData()->AddArray(vector);
+  input->GetCellData()->AddArray(cellValue);
+
+  for (bool divide : { false, true })
+  {
+    vtkNew<vtkPVIntegrateAttributes> expected;
+    expected->SetInputData(input);
+    expected->SetDivideAllCellDataByVolume(divide);
+    expected->Update();
+
+    vtkNew<vtkPVIntegrateAttributes> actual;
+    actual->SetInputData(input);
+    actual->SetDivideAllCellDataByVolume(divide);
+    actual->FastModeOn();
+    actual->Update();
+
+    vtkUnstructuredGrid* expectedOutput = expected->GetOutput();
+    vtkUnstructuredGrid* actualOutput = actual->GetOutput();
+    if (actualOutput->GetNumberOfPoints() != 1 || actualOutput->GetNumberOfCells() != 1)
+    {
+      std::cerr << "Expected a single point and vertex." << std::endl;
+      return EXIT_FAILURE;
+    }
+    double expectedPoint[3], actualPoint[3];
+    expectedOutput->GetPoint(0, expectedPoint);
+    actualOutput->GetPoint(0, actualPoint);
+    for (int cc = 0; cc < 3; ++cc)
+    {
+      if (!Compare("centroid", expectedPoint[cc], actualPoint[cc]))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+    if (!CompareArrays(expectedOutput->GetPointData(), actualOutput->GetPointData()) ||
+      !CompareArrays(expectedOutput->GetCellData(), actualOutput->GetCellData()))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
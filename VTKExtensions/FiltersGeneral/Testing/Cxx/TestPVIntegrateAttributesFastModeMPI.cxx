@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPVIntegrateAttributes.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+enum Scenario
+{
+  // Rank 0 has no data, the fast mode is used with the arrays described by rank 1.
+  EMPTY_ROOT,
+  // The last rank has a quadratic cell, which only it finds unsupported.
+  UNSUPPORTED_CELL,
+  // The last rank has one more point array than the others.
+  DIFFERENT_ARRAYS
+};
+
+// A slab of 4 layers of hexahedra per rank, with a point and a cell array.
+vtkSmartPointer<vtkUnstructuredGrid> MakeInput(Scenario scenario, int rank, int numRanks)
+{
+  auto input = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  if (scenario == EMPTY_ROOT && rank == 0)
+  {
+    return input;
+  }
+
+  const int n = 6;
+  const int layers = 4;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> linear;
+  linear->SetName("Linear");
+  vtkNew<vtkDoubleArray> extra;
+  extra->SetName("Extra");
+  for (int k = 0; k <= layers; ++k)
+  {
+    for (int j = 0; j <= n; ++j)
+    {
+      for (int i = 0; i <= n; ++i)
+      {
+        const double x = 0.5 * i, y = 0.25 * j, z = 0.1 * (k + layers * rank);
+        points->InsertNextPoint(x, y, z);
+        linear->InsertNextValue(x + 2.0 * y - 3.0 * z);
+        extra->InsertNextValue(x * y);
+      }
+    }
+  }
+  auto pointId = [n](int i, int j, int k) -> vtkIdType { return i + (n + 1) * (j + (n + 1) * k); };
+
+  input->SetPoints(points);
+  vtkNew<vtkDoubleArray> cellValue;
+  cellValue->SetName("CellValue");
+  for (int k = 0; k < layers; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        const vtkIdType hex[8] = { pointId(i, j, k), pointId(i + 1, j, k),
+          pointId(i + 1, j + 1, k), pointId(i, j + 1, k), pointId(i, j, k + 1),
+          pointId(i + 1, j, k + 1), pointId(i + 1, j + 1, k + 1), pointId(i, j + 1, k + 1) };
+        input->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+        cellValue->InsertNextValue(i - j + 0.5 * k + rank);
+      }
+    }
+  }
+  const bool lastRank = rank == numRanks - 1;
+  if (scenario == UNSUPPORTED_CELL && lastRank)
+  {
+    // A straight-sided quadratic tetrahedron, whose mid-edge nodes are lattice points.
+    const vtkIdType tetra[10] = { pointId(0, 0, 0), pointId(2, 0, 0), pointId(0, 2, 0),
+      pointId(0, 0, 2), pointId(1, 0, 0), pointId(1, 1, 0), pointId(0, 1, 0), pointId(0, 0, 1),
+      pointId(1, 0, 1), pointId(0, 1, 1) };
+    input->InsertNextCell(VTK_QUADRATIC_TETRA, 10, tetra);
+    cellValue->InsertNextValue(-1.0);
+  }
+  input->GetPointData()->AddArray(linear);
+  if (scenario == DIFFERENT_ARRAYS && lastRank)
+  {
+    input->GetPointData()->AddArray(extra);
+  }
+  input->GetCellData()->AddArray(cellValue);
+  return input;
+}
+
+bool Compare(const char* what, double expected, double actual)
+{
+  if (std::abs(expected - actual) > 1e-10 * std::max(1.0, std::abs(expected)))
+  {
+    std::cerr << "Mismatched " << what << ": " << expected << " != " << actual << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool CompareArrays(vtkDataSetAttributes* expected, vtkDataSetAttributes* actual)
+{
+  if (expected->GetNumberOfArrays() != actual->GetNumberOfArrays())
+  {
+    std::cerr << "Mismatched number of arrays: " << expected->GetNumberOfArrays()
+              << " != " << actual->GetNumberOfArrays() << std::endl;
+    return false;
+  }
+  for (int i = 0; i < expected->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* expectedArray = expected->GetArray(i);
+    vtkDataArray* actualArray = actual->GetArray(expectedArray->GetName());
+    if (!actualArray ||
+      actualArray->GetNumberOfComponents() != expectedArray->GetNumberOfComponents())
+    {
+      std::cerr << "Missing array " << expectedArray->GetName() << std::endl;
+      return false;
+    }
+    for (int cc = 0; cc < expectedArray->GetNumberOfComponents(); ++cc)
+    {
+      if (!Compare(expectedArray->GetName(), expectedArray->GetComponent(0, cc),
+            actualArray->GetComponent(0, cc)))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Integrates with and without the fast mode. All the ranks must agree on whether the fast mode
+// is used, or the collective operations would not match, and rank 0 must get the same result.
+bool TestScenario(vtkMultiProcessController* controller, Scenario scenario)
+{
+  const int rank = controller->GetLocalProcessId();
+  vtkSmartPointer<vtkUnstructuredGrid> input =
+    MakeInput(scenario, rank, controller->GetNumberOfProcesses());
+
+  vtkNew<vtkPVIntegrateAttributes> expected;
+  expected->SetController(controller);
+  expected->SetInputData(input);
+  expected->Update();
+
+  vtkNew<vtkPVIntegrateAttributes> actual;
+  actual->SetController(controller);
+  actual->SetInputData(input);
+  actual->FastModeOn();
+  actual->Update();
+
+  if (rank != 0)
+  {
+    return true;
+  }
+  vtkUnstructuredGrid* expectedOutput = expected->GetOutput();
+  vtkUnstructuredGrid* actualOutput = actual->GetOutput();
+  if (actualOutput->GetNumberOfPoints() != 1 || actualOutput->GetNumberOfCells() != 1)
+  {
+    std::cerr << "Expected a single point and vertex in scenario " << scenario << std::endl;
+    return false;
+  }
+  double expectedPoint[3], actualPoint[3];
+  expectedOutput->GetPoint(0, expectedPoint);
+  actualOutput->GetPoint(0, actualPoint);
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    if (!Compare("centroid", expectedPoint[cc], actualPoint[cc]))
+    {
+      return false;
+    }
+  }
+  if (!CompareArrays(expectedOutput->GetPointData(), actualOutput->GetPointData()) ||
+    !CompareArrays(expectedOutput->GetCellData(), actualOutput->GetCellData()))
+  {
+    std::cerr << "in scenario " << scenario << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestPVIntegrateAttributesFastModeMPI(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv, 0);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int localSuccess = 1;
+  for (Scenario scenario : { EMPTY_ROOT, UNSUPPORTED_CELL, DIFFERENT_ARRAYS })
+  {
+    if (!::TestScenario(controller, scenario))
+    {
+      localSuccess = 0;
+    }
+  }
+  int success = 0;
+  controller->AllReduce(&localSuccess, &success, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,198 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkDummyController.h"
+#include "vtkIdList.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkRectilinearGridConnectivity.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    std::cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                   \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+const int BlockSize = 20;
+const int BlocksPerAxis = 2;
+
+// Three fragments: a sphere that crosses all the blocks, a small sphere in
+// the first block and a bar along x that crosses two blocks. The volume
+// fraction decreases linearly across the boundary of each fragment.
+double VolumeFraction(double x, double y, double z)
+{
+  auto ramp = [](double distance) { return std::min(std::max(1.5 - distance, 0.0), 1.0); };
+  double sphere = std::sqrt((x - 20) * (x - 20) + (y - 20) * (y - 20) + (z - 20) * (z - 20));
+  double small = std::sqrt((x - 6) * (x - 6) + (y - 6) * (y - 6) + (z - 6) * (z - 6));
+  double bar = std::sqrt((y - 33) * (y - 33) + (z - 33) * (z - 33));
+  return std::max({ ramp(sphere - 11.0), ramp(small - 3.0), ramp(bar - 2.0) });
+}
+
+vtkSmartPointer<vtkMultiBlockDataSet> MakeInput()
+{
+  auto input = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  unsigned int blockId = 0;
+  for (int bz = 0; bz < BlocksPerAxis; ++bz)
+  {
+    for (int by = 0; by < BlocksPerAxis; ++by)
+    {
+      for (int bx = 0; bx < BlocksPerAxis; ++bx, ++blockId)
+      {
+        // slightly stretched coordinates, the same on both sides of a block
+        // boundary
+        const int origin[3] = { bx * BlockSize, by * BlockSize, bz * BlockSize };
+        vtkNew<vtkDoubleArray> coords[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          coords[axis]->SetNumberOfTuples(BlockSize + 1);
+          for (int n = 0; n <= BlockSize; ++n)
+          {
+            double t = origin[axis] + n;
+            coords[axis]->SetValue(n, t + 0.002 * t * t);
+          }
+        }
+
+        vtkNew<vtkRectilinearGrid> grid;
+        grid->SetDimensions(BlockSize + 1, BlockSize + 1, BlockSize + 1);
+        grid->SetXCoordinates(coords[0]);
+        grid->SetYCoordinates(coords[1]);
+        grid->SetZCoordinates(coords[2]);
+
+        vtkNew<vtkDoubleArray> volumeFraction;
+        volumeFraction->SetName("vf");
+        volumeFraction->SetNumberOfTuples(grid->GetNumberOfCells());
+        vtkNew<vtkDoubleArray> mass;
+        mass->SetName("mass");
+        mass->SetNumberOfTuples(grid->GetNumberOfCells());
+        vtkIdType cellId = 0;
+        for (int k = 0; k < BlockSize; ++k)
+        {
+          for (int j = 0; j < BlockSize; ++j)
+          {
+            for (int i = 0; i < BlockSize; ++i, ++cellId)
+            {
+              double fraction = VolumeFraction(
+                origin[0] + i + 0.5, origin[1] + j + 0.5, origin[2] + k + 0.5);
+              volumeFraction->SetValue(cellId, fraction);
+              mass->SetValue(cellId, 2.0 * fraction + 0.01 * k);
+            }
+          }
+        }
+        grid->GetCellData()->AddArray(volumeFraction);
+        grid->GetCellData()->AddArray(mass);
+        input->SetBlock(blockId, grid);
+      }
+    }
+  }
+  return input;
+}
+
+struct Fragments
+{
+  std::vector<double> Points;
+  std::vector<vtkIdType> Polygons;
+  std::vector<double> CellValues;
+};
+
+bool Extract(vtkMultiBlockDataSet* input, int numberOfThreads, bool streamBlocks,
+  Fragments& fragments)
+{
+  bool status = false;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads }, [&]() {
+    char fractionName[] = "vf";
+    vtkNew<vtkRectilinearGridConnectivity> filter;
+    filter->SetInputData(input);
+    filter->AddDoubleVolumeArrayName(fractionName);
+    filter->SetVolumeFractionSurfaceValue(0.5);
+    filter->SetStreamBlocks(streamBlocks);
+    filter->Update();
+
+    auto output = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+    auto surface = output ? vtkPolyData::SafeDownCast(output->GetBlock(0)) : nullptr;
+    if (!surface || surface->GetNumberOfCells() == 0)
+    {
+      return;
+    }
+
+    for (vtkIdType cc = 0; cc < surface->GetNumberOfPoints(); ++cc)
+    {
+      double point[3];
+      surface->GetPoint(cc, point);
+      fragments.Points.insert(fragments.Points.end(), point, point + 3);
+    }
+
+    vtkNew<vtkIdList> ptIds;
+    vtkCellArray* polygons = surface->GetPolys();
+    for (vtkIdType cc = 0; cc < polygons->GetNumberOfCells(); ++cc)
+    {
+      polygons->GetCellAtId(cc, ptIds);
+      fragments.Polygons.push_back(ptIds->GetNumberOfIds());
+      for (vtkIdType id = 0; id < ptIds->GetNumberOfIds(); ++id)
+      {
+        fragments.Polygons.push_back(ptIds->GetId(id));
+      }
+    }
+
+    vtkCellData* cellData = surface->GetCellData();
+    for (int a = 0; a < cellData->GetNumberOfArrays(); ++a)
+    {
+      vtkDataArray* array = cellData->GetArray(a);
+      if (!array)
+      {
+        continue;
+      }
+      for (vtkIdType cc = 0; cc < array->GetNumberOfValues(); ++cc)
+      {
+        fragments.CellValues.push_back(array->GetComponent(
+          cc / array->GetNumberOfComponents(), cc % array->GetNumberOfComponents()));
+      }
+    }
+    status = true;
+  });
+  return status;
+}
+}
+
+extern int TestRectilinearGridConnectivityThreads(int, char*[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  vtkSmartPointer<vtkMultiBlockDataSet> input = MakeInput();
+
+  Fragments serial;
+  TASSERT(Extract(input, 1, false, serial));
+
+  // The polyhedra are extracted by slabs of a fixed thickness and the face
+  // hash adds the polygons in order, so the output must not depend on the
+  // number of threads, nor on whether the blocks are streamed.
+  for (bool streamBlocks : { false, true })
+  {
+    for (int numberOfThreads : { 1, 2, 4, 8 })
+    {
+      Fragments threaded;
+      TASSERT(Extract(input, numberOfThreads, streamBlocks, threaded));
+      TASSERT(threaded.Points == serial.Points);
+      TASSERT(threaded.Polygons == serial.Polygons);
+      TASSERT(threaded.CellValues == serial.CellValues);
+    }
+  }
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return EXIT_SUCCESS;
+}
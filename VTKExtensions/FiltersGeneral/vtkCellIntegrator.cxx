@@ -4,10 +4,247 @@
 #include "vtkCellIntegrator.h"
 
 #include "vtkCell.h"
+#include "vtkCellType.h"
+#include "vtkCellTypes.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
 #include "vtkDataSet.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
 #include "vtkIdList.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace
+{
+// Number of cells per chunk in IntegrateCells(). It does not depend on the
+// number of threads, so that the sums are accumulated in the same order for
+// any number of threads.
+constexpr vtkIdType INTEGRATION_CHUNK_SIZE = 16384;
+
+//-----------------------------------------------------------------------------
+// Neumaier's compensated summation.
+struct vtkCompensatedSum
+{
+  double Sum = 0.0;
+  double Compensation = 0.0;
+
+  void Add(double value)
+  {
+    const double sum = this->Sum + value;
+    if (std::abs(this->Sum) >= std::abs(value))
+    {
+      this->Compensation += (this->Sum - sum) + value;
+    }
+    else
+    {
+      this->Compensation += (value - sum) + this->Sum;
+    }
+    this->Sum = sum;
+  }
+
+  double GetValue() const { return this->Sum + this->Compensation; }
+};
+
+//-----------------------------------------------------------------------------
+double vtkTriangleMeasure(const double pt1[3], const double pt2[3], const double pt3[3])
+{
+  double v1[3], v2[3], cross[3];
+  for (int i = 0; i < 3; i++)
+  {
+    v1[i] = pt2[i] - pt1[i];
+    v2[i] = pt3[i] - pt1[i];
+  }
+  vtkMath::Cross(v1, v2, cross);
+  return sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]) * 0.5;
+}
+
+//-----------------------------------------------------------------------------
+// Adds the area of the triangle (pt1Id, pt2Id, pt3Id), given by indices in
+// pts, to measure and a third of it to the weight of each of its points.
+void vtkAddTriangle(vtkDataSet* input, const vtkIdType* pts, vtkIdType pt1Id, vtkIdType pt2Id,
+  vtkIdType pt3Id, double& measure, double* weights)
+{
+  double pt1[3], pt2[3], pt3[3];
+  input->GetPoint(pts[pt1Id], pt1);
+  input->GetPoint(pts[pt2Id], pt2);
+  input->GetPoint(pts[pt3Id], pt3);
+  const double area = vtkTriangleMeasure(pt1, pt2, pt3);
+  measure += area;
+  weights[pt1Id] += area / 3.0;
+  weights[pt2Id] += area / 3.0;
+  weights[pt3Id] += area / 3.0;
+}
+
+//-----------------------------------------------------------------------------
+// Shape functions and their parametric derivatives of the linear hexahedron,
+// wedge and pyramid, with the same parametric coordinates as vtkHexahedron,
+// vtkWedge and vtkPyramid.
+double vtkLinearFactor(int node, double x)
+{
+  return node ? x : 1.0 - x;
+}
+
+double vtkLinearFactorDerivative(int node)
+{
+  return node ? 1.0 : -1.0;
+}
+
+void vtkHexahedronShape(const double pc[3], double* sf, double (*derivs)[3])
+{
+  static const int nodes[8][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 }, { 0, 0, 1 },
+    { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } };
+  for (int i = 0; i < 8; i++)
+  {
+    const double fr = vtkLinearFactor(nodes[i][0], pc[0]);
+    const double fs = vtkLinearFactor(nodes[i][1], pc[1]);
+    const double ft = vtkLinearFactor(nodes[i][2], pc[2]);
+    sf[i] = fr * fs * ft;
+    derivs[i][0] = vtkLinearFactorDerivative(nodes[i][0]) * fs * ft;
+    derivs[i][1] = fr * vtkLinearFactorDerivative(nodes[i][1]) * ft;
+    derivs[i][2] = fr * fs * vtkLinearFactorDerivative(nodes[i][2]);
+  }
+}
+
+void vtkWedgeShape(const double pc[3], double* sf, double (*derivs)[3])
+{
+  const double triangle[3] = { 1.0 - pc[0] - pc[1], pc[0], pc[1] };
+  static const double triangleDerivs[3][2] = { { -1.0, -1.0 }, { 1.0, 0.0 }, { 0.0, 1.0 } };
+  for (int i = 0; i < 6; i++)
+  {
+    const int corner = i % 3;
+    const int top = i / 3;
+    const double ft = vtkLinearFactor(top, pc[2]);
+    sf[i] = triangle[corner] * ft;
+    derivs[i][0] = triangleDerivs[corner][0] * ft;
+    derivs[i][1] = triangleDerivs[corner][1] * ft;
+    derivs[i][2] = triangle[corner] * vtkLinearFactorDerivative(top);
+  }
+}
+
+void vtkPyramidShape(const double pc[3], double* sf, double (*derivs)[3])
+{
+  static const int nodes[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+  for (int i = 0; i < 4; i++)
+  {
+    const double fr = vtkLinearFactor(nodes[i][0], pc[0]);
+    const double fs = vtkLinearFactor(nodes[i][1], pc[1]);
+    sf[i] = fr * fs * (1.0 - pc[2]);
+    derivs[i][0] = vtkLinearFactorDerivative(nodes[i][0]) * fs * (1.0 - pc[2]);
+    derivs[i][1] = fr * vtkLinearFactorDerivative(nodes[i][1]) * (1.0 - pc[2]);
+    derivs[i][2] = -fr * fs;
+  }
+  sf[4] = pc[2];
+  derivs[4][0] = 0.0;
+  derivs[4][1] = 0.0;
+  derivs[4][2] = 1.0;
+}
+
+//-----------------------------------------------------------------------------
+// Integrates the Jacobian determinant, and the shape functions times the
+// Jacobian determinant, of the mapping of a hexahedron, wedge or pyramid with
+// a quadrature rule that is exact for these polynomials: the 2-point Gauss
+// rule in each direction, and for the triangle of the wedge the 3-point rule
+// on the edge midpoints.
+void vtkIntegrate3DCell(vtkDataSet* input, int cellType, const vtkIdType* pts, double& measure,
+  double* weights)
+{
+  const int numberOfPoints = cellType == VTK_HEXAHEDRON ? 8 : (cellType == VTK_WEDGE ? 6 : 5);
+  double x[8][3];
+  for (int i = 0; i < numberOfPoints; i++)
+  {
+    input->GetPoint(pts[i], x[i]);
+  }
+
+  const double gauss[2] = { 0.5 - 0.5 / std::sqrt(3.0), 0.5 + 0.5 / std::sqrt(3.0) };
+  static const double triangleRule[3][2] = { { 0.5, 0.0 }, { 0.5, 0.5 }, { 0.0, 0.5 } };
+  double quadrature[8][4];
+  int numberOfQuadraturePoints = 0;
+  if (cellType == VTK_WEDGE)
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      for (int k = 0; k < 2; k++)
+      {
+        double* q = quadrature[numberOfQuadraturePoints++];
+        q[0] = triangleRule[i][0];
+        q[1] = triangleRule[i][1];
+        q[2] = gauss[k];
+        q[3] = 1.0 / 12.0;
+      }
+    }
+  }
+  else
+  {
+    for (int i = 0; i < 2; i++)
+    {
+      for (int j = 0; j < 2; j++)
+      {
+        for (int k = 0; k < 2; k++)
+        {
+          double* q = quadrature[numberOfQuadraturePoints++];
+          q[0] = gauss[i];
+          q[1] = gauss[j];
+          q[2] = gauss[k];
+          q[3] = 1.0 / 8.0;
+        }
+      }
+    }
+  }
+
+  // The base triangle of a vtkWedge is oriented away from its opposite face,
+  // unlike the base of the other cells: flip the sign so that valid wedges
+  // have a positive volume, as valid tetrahedra, hexahedra and pyramids do.
+  const double orientation = cellType == VTK_WEDGE ? -1.0 : 1.0;
+  double sf[8];
+  double derivs[8][3];
+  for (int q = 0; q < numberOfQuadraturePoints; q++)
+  {
+    switch (cellType)
+    {
+      case VTK_HEXAHEDRON:
+        vtkHexahedronShape(quadrature[q], sf, derivs);
+        break;
+      case VTK_WEDGE:
+        vtkWedgeShape(quadrature[q], sf, derivs);
+        break;
+      default:
+        vtkPyramidShape(quadrature[q], sf, derivs);
+        break;
+    }
+    double jacobian[3][3] = { { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } };
+    for (int i = 0; i < numberOfPoints; i++)
+    {
+      for (int j = 0; j < 3; j++)
+      {
+        for (int k = 0; k < 3; k++)
+        {
+          jacobian[j][k] += x[i][k] * derivs[i][j];
+        }
+      }
+    }
+    double n[3];
+    vtkMath::Cross(jacobian[0], jacobian[1], n);
+    const double value = orientation * vtkMath::Dot(n, jacobian[2]) * quadrature[q][3];
+    measure += value;
+    for (int i = 0; i < numberOfPoints; i++)
+    {
+      weights[i] += value * sf[i];
+    }
+  }
+}
+}
 
 //-----------------------------------------------------------------------------
 double vtkCellIntegrator::IntegratePolyLine(
@@ -347,6 +584,16 @@ double vtkCellIntegrator::Integrate(vtkDataSet* input, vtkIdType cellId)
       sum = vtkCellIntegrator::IntegrateTetrahedron(input, cellId, pt1Id, pt2Id, pt3Id, pt4Id);
       break;
 
+    case VTK_HEXAHEDRON:
+    case VTK_WEDGE:
+    case VTK_PYRAMID:
+    {
+      input->GetCellPoints(cellId, cellPtIds);
+      double weights[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+      vtkIntegrate3DCell(input, cellType, cellPtIds->GetPointer(0), sum, weights);
+      break;
+    }
+
     default:
       // We need to explicitly get the cell
       vtkCell* cell = input->GetCell(cellId);
@@ -389,6 +636,322 @@ double vtkCellIntegrator::Integrate(vtkDataSet* input, vtkIdType cellId)
   return sum;
 }
 
+//-----------------------------------------------------------------------------
+int vtkCellIntegrator::IntegrateLinearCell(vtkDataSet* input, int cellType, vtkIdType npts,
+  const vtkIdType* pts, double& measure, double* weights)
+{
+  measure = 0;
+  std::fill(weights, weights + npts, 0.0);
+  switch (cellType)
+  {
+    case VTK_EMPTY_CELL:
+    case VTK_VERTEX:
+    case VTK_POLY_VERTEX:
+      return 0;
+
+    case VTK_LINE:
+    case VTK_POLY_LINE:
+    {
+      double pt1[3], pt2[3];
+      for (vtkIdType lineIdx = 0; lineIdx + 1 < npts; ++lineIdx)
+      {
+        input->GetPoint(pts[lineIdx], pt1);
+        input->GetPoint(pts[lineIdx + 1], pt2);
+        const double length = sqrt(vtkMath::Distance2BetweenPoints(pt1, pt2));
+        measure += length;
+        weights[lineIdx] += length / 2.0;
+        weights[lineIdx + 1] += length / 2.0;
+      }
+      return 1;
+    }
+
+    case VTK_TRIANGLE:
+      vtkAddTriangle(input, pts, 0, 1, 2, measure, weights);
+      return 2;
+
+    case VTK_TRIANGLE_STRIP:
+      for (vtkIdType triIdx = 0; triIdx + 2 < npts; ++triIdx)
+      {
+        vtkAddTriangle(input, pts, triIdx, triIdx + 1, triIdx + 2, measure, weights);
+      }
+      return 2;
+
+    case VTK_POLYGON:
+      // Works for convex polygons.
+      for (vtkIdType triIdx = 0; triIdx + 2 < npts; ++triIdx)
+      {
+        vtkAddTriangle(input, pts, 0, triIdx + 1, triIdx + 2, measure, weights);
+      }
+      return 2;
+
+    case VTK_QUAD:
+      vtkAddTriangle(input, pts, 0, 1, 2, measure, weights);
+      vtkAddTriangle(input, pts, 0, 3, 2, measure, weights);
+      return 2;
+
+    case VTK_PIXEL:
+    {
+      double pt0[3], pt1[3], pt2[3];
+      input->GetPoint(pts[0], pt0);
+      input->GetPoint(pts[1], pt1);
+      input->GetPoint(pts[2], pt2);
+      const double l = (pt0[0] - pt1[0]) + (pt0[1] - pt1[1]) + (pt0[2] - pt1[2]);
+      const double w = (pt0[0] - pt2[0]) + (pt0[1] - pt2[1]) + (pt0[2] - pt2[2]);
+      measure = fabs(l * w);
+      std::fill(weights, weights + 4, measure / 4.0);
+      return 2;
+    }
+
+    case VTK_TETRA:
+    {
+      double pt[4][3];
+      double a[3], b[3], c[3], n[3];
+      for (int i = 0; i < 4; i++)
+      {
+        input->GetPoint(pts[i], pt[i]);
+      }
+      for (int i = 0; i < 3; i++)
+      {
+        a[i] = pt[1][i] - pt[0][i];
+        b[i] = pt[2][i] - pt[0][i];
+        c[i] = pt[3][i] - pt[0][i];
+      }
+      vtkMath::Cross(a, b, n);
+      measure = vtkMath::Dot(c, n) / 6.0;
+      std::fill(weights, weights + 4, measure / 4.0);
+      return 3;
+    }
+
+    case VTK_VOXEL:
+    {
+      double pt0[3], pt1[3], pt2[3], pt4[3];
+      input->GetPoint(pts[0], pt0);
+      input->GetPoint(pts[1], pt1);
+      input->GetPoint(pts[2], pt2);
+      input->GetPoint(pts[4], pt4);
+      measure = fabs((pt1[0] - pt0[0]) * (pt2[1] - pt0[1]) * (pt4[2] - pt0[2]));
+      std::fill(weights, weights + 8, measure / 8.0);
+      return 3;
+    }
+
+    case VTK_HEXAHEDRON:
+    case VTK_WEDGE:
+    case VTK_PYRAMID:
+      vtkIntegrate3DCell(input, cellType, pts, measure, weights);
+      return 3;
+
+    default:
+      return -1;
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool vtkCellIntegrator::IntegrateCells(vtkDataSet* input, int dimension,
+  const std::vector<vtkDataArray*>& pointArrays, const std::vector<vtkDataArray*>& cellArrays,
+  std::vector<double>& sums)
+{
+  int maxNumberOfComponents = 3;
+  size_t numberOfSums = 4;
+  for (vtkDataArray* array : pointArrays)
+  {
+    maxNumberOfComponents = std::max(maxNumberOfComponents, array->GetNumberOfComponents());
+    numberOfSums += array->GetNumberOfComponents();
+  }
+  for (vtkDataArray* array : cellArrays)
+  {
+    maxNumberOfComponents = std::max(maxNumberOfComponents, array->GetNumberOfComponents());
+    numberOfSums += array->GetNumberOfComponents();
+  }
+  sums.assign(numberOfSums, 0.0);
+
+  const vtkIdType numberOfCells = input->GetNumberOfCells();
+  if (numberOfCells == 0)
+  {
+    return true;
+  }
+
+  // Some datasets build their cells on first access, which is not thread safe.
+  {
+    vtkNew<vtkIdList> ptIds;
+    input->GetCellType(0);
+    input->GetCellPoints(0, ptIds);
+  }
+
+  vtkUnsignedCharArray* ghosts = input->GetCellGhostArray();
+  const vtkIdType numberOfChunks =
+    (numberOfCells + INTEGRATION_CHUNK_SIZE - 1) / INTEGRATION_CHUNK_SIZE;
+  std::vector<vtkCompensatedSum> chunkSums(numberOfChunks * numberOfSums);
+  std::atomic<bool> supported(true);
+  vtkSMPThreadLocalObject<vtkIdList> tlPtIds;
+  vtkSMPTools::For(0, numberOfChunks,
+    [&](vtkIdType firstChunk, vtkIdType lastChunk)
+    {
+      vtkIdList* ptIds = tlPtIds.Local();
+      std::vector<double> weights(8);
+      std::vector<double> tuple(maxNumberOfComponents);
+      for (vtkIdType chunk = firstChunk; chunk < lastChunk && supported; ++chunk)
+      {
+        vtkCompensatedSum* chunkSum = &chunkSums[chunk * numberOfSums];
+        const vtkIdType lastCellId = std::min(numberOfCells, (chunk + 1) * INTEGRATION_CHUNK_SIZE);
+        for (vtkIdType cellId = chunk * INTEGRATION_CHUNK_SIZE; cellId < lastCellId; ++cellId)
+        {
+          if (ghosts && (ghosts->GetValue(cellId) & vtkDataSetAttributes::DUPLICATECELL))
+          {
+            continue;
+          }
+          const int cellType = input->GetCellType(cellId);
+          vtkIdType npts;
+          const vtkIdType* pts;
+          input->GetCellPoints(cellId, npts, pts, ptIds);
+          if (static_cast<vtkIdType>(weights.size()) < npts)
+          {
+            weights.resize(npts);
+          }
+          double measure;
+          const int cellDimension = vtkCellIntegrator::IntegrateLinearCell(
+            input, cellType, npts, pts, measure, weights.data());
+          if (cellDimension < 0 && vtkCellTypes::GetDimension(cellType) == dimension)
+          {
+            supported = false;
+            break;
+          }
+          if (cellDimension != dimension)
+          {
+            continue;
+          }
+
+          chunkSum[0].Add(measure);
+          for (vtkIdType i = 0; i < npts; ++i)
+          {
+            input->GetPoint(pts[i], tuple.data());
+            for (int k = 0; k < 3; ++k)
+            {
+              chunkSum[1 + k].Add(weights[i] * tuple[k]);
+            }
+          }
+          size_t offset = 4;
+          for (vtkDataArray* array : pointArrays)
+          {
+            const int numberOfComponents = array->GetNumberOfComponents();
+            for (vtkIdType i = 0; i < npts; ++i)
+            {
+              array->GetTuple(pts[i], tuple.data());
+              for (int k = 0; k < numberOfComponents; ++k)
+              {
+                chunkSum[offset + k].Add(weights[i] * tuple[k]);
+              }
+            }
+            offset += numberOfComponents;
+          }
+          for (vtkDataArray* array : cellArrays)
+          {
+            const int numberOfComponents = array->GetNumberOfComponents();
+            array->GetTuple(cellId, tuple.data());
+            for (int k = 0; k < numberOfComponents; ++k)
+            {
+              chunkSum[offset + k].Add(measure * tuple[k]);
+            }
+            offset += numberOfComponents;
+          }
+        }
+      }
+    });
+  if (!supported)
+  {
+    return false;
+  }
+
+  for (size_t s = 0; s < numberOfSums; ++s)
+  {
+    vtkCompensatedSum total;
+    for (vtkIdType chunk = 0; chunk < numberOfChunks; ++chunk)
+    {
+      total.Add(chunkSums[chunk * numberOfSums + s].GetValue());
+    }
+    sums[s] = total.GetValue();
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+int vtkCellIntegrator::GetMaximumCellDimension(vtkDataSet* input)
+{
+  vtkNew<vtkCellTypes> cellTypes;
+  input->GetCellTypes(cellTypes);
+  int dimension = -1;
+  for (vtkIdType i = 0; i < cellTypes->GetNumberOfTypes(); ++i)
+  {
+    dimension = std::max(dimension, vtkCellTypes::GetDimension(cellTypes->GetCellType(i)));
+  }
+  return dimension;
+}
+
+//-----------------------------------------------------------------------------
+void vtkCellIntegrator::GetLeavesWithCells(vtkDataObject* input, std::vector<vtkDataSet*>& leaves)
+{
+  leaves.clear();
+  if (vtkDataSet* ds = vtkDataSet::SafeDownCast(input))
+  {
+    if (ds->GetNumberOfCells() > 0)
+    {
+      leaves.push_back(ds);
+    }
+  }
+  else if (vtkCompositeDataSet* cds = vtkCompositeDataSet::SafeDownCast(input))
+  {
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(cds->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+      if (ds && ds->GetNumberOfCells() > 0)
+      {
+        leaves.push_back(ds);
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkCellIntegrator::InitializeVertexOutput(
+  vtkUnstructuredGrid* output, const std::vector<double>& sums)
+{
+  const double total = sums[0];
+  double center[3] = { 0.0, 0.0, 0.0 };
+  if (total != 0.0)
+  {
+    for (int k = 0; k < 3; ++k)
+    {
+      center[k] = sums[1 + k] / total;
+    }
+  }
+
+  output->Initialize();
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(1);
+  points->SetPoint(0, center);
+  output->SetPoints(points);
+  output->Allocate(1);
+  vtkIdType ptId = 0;
+  output->InsertNextCell(VTK_VERTEX, 1, &ptId);
+}
+
+//-----------------------------------------------------------------------------
+vtkDoubleArray* vtkCellIntegrator::AddIntegral(vtkDataSetAttributes* attributes, const char* name,
+  int numberOfComponents, const double* values, double scale)
+{
+  vtkNew<vtkDoubleArray> integral;
+  integral->SetName(name);
+  integral->SetNumberOfComponents(numberOfComponents);
+  integral->SetNumberOfTuples(1);
+  for (int k = 0; k < numberOfComponents; ++k)
+  {
+    integral->SetTypedComponent(0, k, values[k] * scale);
+  }
+  attributes->AddArray(integral);
+  return integral;
+}
+
 //----------------------------------------------------------------------------
 void vtkCellIntegrator::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -8,8 +8,13 @@
  * vtkCellIntegrator is a helper class that calculates the
  * length/area/volume of a 1D/2D/3D cell. The calculation is exact for
  * lines, polylines, triangles, triangle strips, pixels, voxels, convex
- * polygons, quads and tetrahedra. All other 3D cells are triangulated
- * during volume calculation. In such cases, the result may not be exact.
+ * polygons, quads, tetrahedra, hexahedra, wedges and pyramids. All other 3D
+ * cells are triangulated during volume calculation. In such cases, the result
+ * may not be exact.
+ *
+ * IntegrateCells() integrates the measure, the point coordinates and a set of
+ * point and cell arrays over all the cells of a dataset at once, using
+ * vtkSMPTools and compensated sums. It is used by vtkPVIntegrateAttributes.
  */
 
 #ifndef vtkCellIntegrator_h
@@ -18,8 +23,15 @@
 #include "vtkObject.h"
 #include "vtkPVVTKExtensionsFiltersGeneralModule.h" //needed for exports
 
+#include <vector> // for std::vector
+
+class vtkDataArray;
+class vtkDataObject;
 class vtkDataSet;
+class vtkDataSetAttributes;
+class vtkDoubleArray;
 class vtkIdList;
+class vtkUnstructuredGrid;
 
 class VTKPVVTKEXTENSIONSFILTERSGENERAL_EXPORT vtkCellIntegrator : public vtkObject
 {
@@ -34,6 +46,64 @@ public:
    */
   static double Integrate(vtkDataSet* input, vtkIdType cellId);
 
+  /**
+   * Computes the length/area/volume of a linear cell of type `cellType` made
+   * of the `npts` points `pts` of `input` into `measure`, and the integral over
+   * the cell of the shape function of each of its points into `weights`
+   * (`npts` values). The integral of a point field linearly interpolated over
+   * the cell is then the sum of the point values times their weights.
+   * Returns the dimension of the cell, or -1 if the cell type is not one of
+   * the cell types for which the calculation is exact. 0D cells have a null
+   * measure and weights.
+   */
+  static int IntegrateLinearCell(vtkDataSet* input, int cellType, vtkIdType npts,
+    const vtkIdType* pts, double& measure, double* weights);
+
+  /**
+   * Integrates over the non-ghost cells of `input` of the given dimension.
+   * `sums` is resized and receives, in that order, the total length/area/volume,
+   * the integral of the point coordinates (3 values), the integral of each
+   * component of `pointArrays` interpolated over the cells, and the integral
+   * of each component of `cellArrays`, constant over each cell.
+   * Cells are processed in parallel by fixed-size chunks with compensated
+   * sums, and the chunk sums are added in order, so the result does not depend
+   * on the number of threads.
+   * Returns false if a cell of that dimension is not supported by
+   * IntegrateLinearCell().
+   */
+  static bool IntegrateCells(vtkDataSet* input, int dimension,
+    const std::vector<vtkDataArray*>& pointArrays, const std::vector<vtkDataArray*>& cellArrays,
+    std::vector<double>& sums);
+
+  /**
+   * Returns the highest dimension of the cells of `input`, or -1 if it has no
+   * cells.
+   */
+  static int GetMaximumCellDimension(vtkDataSet* input);
+
+  /**
+   * Fills `leaves` with `input` if it is a dataset with cells, or with the
+   * leaves of `input` that are datasets with cells if it is a composite
+   * dataset.
+   */
+  static void GetLeavesWithCells(vtkDataObject* input, std::vector<vtkDataSet*>& leaves);
+
+  /**
+   * Initializes `output` with a single point and a vertex. The point is the
+   * centroid given by `sums`, as computed by IntegrateCells(): the integral of
+   * the point coordinates divided by the total length/area/volume, or the
+   * origin if the latter is null.
+   */
+  static void InitializeVertexOutput(vtkUnstructuredGrid* output, const std::vector<double>& sums);
+
+  /**
+   * Adds to `attributes` a double array named `name` with a single tuple of
+   * `numberOfComponents` components, the `values` multiplied by `scale`.
+   * Returns the new array, owned by `attributes`.
+   */
+  static vtkDoubleArray* AddIntegral(vtkDataSetAttributes* attributes, const char* name,
+    int numberOfComponents, const double* values, double scale = 1.0);
+
 protected:
   vtkCellIntegrator() = default;
   ~vtkCellIntegrator() override = default;
@@ -4,6 +4,11 @@
 #include "vtkEquivalenceSet.h"
 #include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
 
 vtkStandardNewMacro(vtkEquivalenceSet);
 
@@ -11,9 +16,61 @@ vtkStandardNewMacro(vtkEquivalenceSet);
 // A class that implements an equivalent set.  It is used to combine fragments
 // from different processes.
 //
-// I believe that this class is a strictly ordered tree of equivalences.
+// This class is a union-find forest of equivalences.
 // Every member points to its own id or an id smaller than itself.
 
+namespace
+{
+// The union is done in place on the int buffer of the equivalence array.
+// std::atomic<int> has the layout of an int on the supported platforms,
+// this stands for std::atomic_ref which requires C++20.
+static_assert(sizeof(std::atomic<int>) == sizeof(int), "std::atomic<int> must be an int");
+static_assert(std::atomic<int>::is_always_lock_free, "std::atomic<int> must be lock free");
+
+// Lock-free find with path halving. References only ever decrease, so a
+// failed compare-and-swap only means another thread already shortened the
+// path.
+int FindRootAtomic(std::atomic<int>* refs, int memberId)
+{
+  int ref = refs[memberId].load(std::memory_order_relaxed);
+  while (ref != memberId)
+  {
+    int next = refs[ref].load(std::memory_order_relaxed);
+    if (next != ref)
+    {
+      refs[memberId].compare_exchange_weak(ref, next, std::memory_order_relaxed);
+    }
+    memberId = next;
+    ref = refs[memberId].load(std::memory_order_relaxed);
+  }
+  return memberId;
+}
+
+// Lock-free union: the larger root is linked to the smaller one with a
+// compare-and-swap, retrying if the larger root got linked in the meantime.
+void EquateAtomic(std::atomic<int>* refs, int id1, int id2)
+{
+  while (true)
+  {
+    id1 = FindRootAtomic(refs, id1);
+    id2 = FindRootAtomic(refs, id2);
+    if (id1 == id2)
+    {
+      return;
+    }
+    if (id1 > id2)
+    {
+      std::swap(id1, id2);
+    }
+    int expected = id2;
+    if (refs[id2].compare_exchange_strong(expected, id1, std::memory_order_relaxed))
+    {
+      return;
+    }
+  }
+}
+}
+
 //----------------------------------------------------------------------------
 vtkEquivalenceSet::vtkEquivalenceSet()
 {
@@ -65,16 +122,11 @@ void vtkEquivalenceSet::PrintSelf(ostream& os, vtkIndent indent)
 // Return the id of the equivalent set.
 int vtkEquivalenceSet::GetEquivalentSetId(int memberId)
 {
-  int ref;
-
-  ref = this->GetReference(memberId);
-  while (!this->Resolved && ref != memberId)
+  if (this->Resolved || memberId >= this->EquivalenceArray->GetNumberOfTuples())
   {
-    memberId = ref;
-    ref = this->GetReference(memberId);
+    return this->GetReference(memberId);
   }
-
-  return ref;
+  return this->FindRoot(memberId);
 }
 
 //----------------------------------------------------------------------------
@@ -88,6 +140,25 @@ int vtkEquivalenceSet::GetReference(int memberId)
   return this->EquivalenceArray->GetValue(memberId);
 }
 
+//----------------------------------------------------------------------------
+int vtkEquivalenceSet::FindRoot(int memberId)
+{
+  int* refs = this->EquivalenceArray->GetPointer(0);
+  int root = memberId;
+  while (refs[root] != root)
+  {
+    root = refs[root];
+  }
+  // Make every member along the path refer directly to the root.
+  while (refs[memberId] != root)
+  {
+    int next = refs[memberId];
+    refs[memberId] = root;
+    memberId = next;
+  }
+  return root;
+}
+
 //----------------------------------------------------------------------------
 // Makes two new or existing ids equivalent.
 // If the array is too small, the range of ids is increased until it contains
@@ -110,26 +181,54 @@ void vtkEquivalenceSet::AddEquivalence(int id1, int id2)
     ++num;
   }
 
-  // Our rule for references in the equivalent set is that
-  // all elements must point to a member equal to or smaller
-  // than itself.
+  this->EquateInternal(id1, id2);
+}
 
-  // The only problem we could encounter is changing a reference.
-  // we do not want to orphan anything previously referenced.
+//----------------------------------------------------------------------------
+void vtkEquivalenceSet::AddEquivalences(const int* id1, const int* id2, vtkIdType numberOfPairs)
+{
+  if (this->Resolved)
+  {
+    vtkGenericWarningMacro("Set already resolved, you cannot add more equivalences.");
+    return;
+  }
+  if (numberOfPairs <= 0)
+  {
+    return;
+  }
 
-  // Replace the larger references.
-  if (id1 < id2)
+  // Expand the range to include all the ids.
+  int maxId = std::max(*std::max_element(id1, id1 + numberOfPairs),
+    *std::max_element(id2, id2 + numberOfPairs));
+  vtkIdType num = this->EquivalenceArray->GetNumberOfTuples();
+  if (maxId >= num)
   {
-    // We could follow the references to the smallest.  It might
-    // make this processing more efficient.  This is a compromise.
-    // The referenced id will always be smaller than the id so
-    // order does not change.
-    this->EquateInternal(this->GetReference(id1), id2);
+    this->EquivalenceArray->SetNumberOfTuples(maxId + 1);
+    // All values inserted are equivalent to only themselves.
+    std::iota(this->EquivalenceArray->GetPointer(num),
+      this->EquivalenceArray->GetPointer(0) + maxId + 1, static_cast<int>(num));
   }
-  else
+
+  auto refs = reinterpret_cast<std::atomic<int>*>(this->EquivalenceArray->GetPointer(0));
+  vtkSMPTools::For(0, numberOfPairs,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType ii = begin; ii < end; ++ii)
+      {
+        ::EquateAtomic(refs, id1[ii], id2[ii]);
+      }
+    });
+}
+
+//----------------------------------------------------------------------------
+void vtkEquivalenceSet::AddEquivalences(vtkIntArray* ids1, vtkIntArray* ids2)
+{
+  if (!ids1 || !ids2 || ids1->GetNumberOfValues() != ids2->GetNumberOfValues())
   {
-    this->EquateInternal(this->GetReference(id2), id1);
+    vtkErrorMacro("Both arrays must have the same number of values.");
+    return;
   }
+  this->AddEquivalences(ids1->GetPointer(0), ids2->GetPointer(0), ids1->GetNumberOfValues());
 }
 
 //----------------------------------------------------------------------------
@@ -157,32 +256,25 @@ vtkIdType vtkEquivalenceSet::Capacity()
 }
 
 //----------------------------------------------------------------------------
-// id1 must be less than or equal to id2.
 void vtkEquivalenceSet::EquateInternal(int id1, int id2)
 {
-  // This is the reference that might be orphaned in this process.
-  int oldRef = this->GetEquivalentSetId(id2);
-
-  // The two ids are already equal (not the only way they might be equal).
-  if (oldRef == id1)
+  int root1 = this->FindRoot(id1);
+  int root2 = this->FindRoot(id2);
+  if (root1 == root2)
   {
     return;
   }
 
-  // The only problem we could encounter is changing a reference.
-  // we do not want to orphan anything previously referenced.
-  if (oldRef == id2)
-  {
-    this->EquivalenceArray->SetValue(id2, id1);
-  }
-  else if (oldRef > id1)
+  // Our rule for references in the equivalent set is that
+  // all elements must point to a member equal to or smaller
+  // than itself, so the larger root refers to the smaller one.
+  if (root1 < root2)
   {
-    this->EquivalenceArray->SetValue(id2, id1);
-    this->EquateInternal(id1, oldRef);
+    this->EquivalenceArray->SetValue(root2, root1);
   }
   else
-  { // oldRef < id1
-    this->EquateInternal(oldRef, id1);
+  {
+    this->EquivalenceArray->SetValue(root1, root2);
   }
 }
 
@@ -190,29 +282,26 @@ void vtkEquivalenceSet::EquateInternal(int id1, int id2)
 // Returns the number of merged sets.
 int vtkEquivalenceSet::ResolveEquivalences()
 {
-  // Go through the equivalence array collapsing chains
-  // and assigning consecutive ids.
+  // Assign consecutive ids to the sets, in the order of their smallest
+  // member. Every member refers to a smaller or equal id, so when a member is
+  // visited the member it refers to already holds its final set id and a
+  // single pass is enough.
+  vtkIdType numIds = this->EquivalenceArray->GetNumberOfTuples();
+  int* refs = this->EquivalenceArray->GetPointer(0);
   int count = 0;
-  int id;
-  int newId;
-
-  int numIds = this->EquivalenceArray->GetNumberOfTuples();
-  for (int ii = 0; ii < numIds; ++ii)
+  for (vtkIdType ii = 0; ii < numIds; ++ii)
   {
-    id = this->EquivalenceArray->GetValue(ii);
-    if (id == ii)
+    int ref = refs[ii];
+    if (ref == ii)
     { // This is a new equivalence set.
-      this->EquivalenceArray->SetValue(ii, count);
-      ++count;
+      refs[ii] = count++;
     }
     else
     {
-      // All earlier ids will be resolved already.
-      // This array only point to less than or equal ids. (id <= ii).
-      newId = this->EquivalenceArray->GetValue(id);
-      this->EquivalenceArray->SetValue(ii, newId);
+      refs[ii] = refs[ref];
     }
   }
+
   this->Resolved = 1;
   // std::cerr << "Final number of equivalent sets: " << count << endl;
 
@@ -7,6 +7,12 @@
  *
  * Useful for connectivity on multiple processes.  Run connectivity
  * on each processes, then make touching fragments equivalent.
+ *
+ * Equivalences are stored as a union-find forest where every member refers
+ * to a member smaller than or equal to itself, so the root of a set is its
+ * smallest member. Resolved set ids are assigned in the order of the
+ * smallest member of each set, so they do not depend on the order in which
+ * equivalences were added.
  */
 
 #ifndef vtkEquivalenceSet_h
@@ -26,6 +32,20 @@ public:
   void Initialize();
   void AddEquivalence(int id1, int id2);
 
+  /**
+   * Makes id1[i] and id2[i] equivalent for all i in [0, numberOfPairs).
+   * The pairs are merged concurrently using vtkSMPTools, which is much faster
+   * than calling AddEquivalence() for each pair when there are many of them.
+   * The result is the same as adding the pairs one at a time.
+   */
+  void AddEquivalences(const int* id1, const int* id2, vtkIdType numberOfPairs);
+
+  /**
+   * Same as above with the pairs given as two arrays with the same number of
+   * values. This is convenient from wrapped languages.
+   */
+  void AddEquivalences(vtkIntArray* ids1, vtkIntArray* ids2);
+
   // The length of the equivalent array...
   // The Domain of the equivalance map is [0, numberOfMembers).
   int GetNumberOfMembers();
@@ -69,9 +89,12 @@ protected:
   // traversed by different processes or passes.
   vtkIntArray* EquivalenceArray;
 
-  // Return the id of the equivalent set.
+  // Makes the sets of the two ids equivalent.
   void EquateInternal(int id1, int id2);
 
+  // Return the root of the set of memberId, compressing the path to it.
+  int FindRoot(int memberId);
+
 private:
   vtkEquivalenceSet(const vtkEquivalenceSet&) = delete;
   void operator=(const vtkEquivalenceSet&) = delete;
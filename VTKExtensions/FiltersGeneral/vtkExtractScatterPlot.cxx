@@ -3,7 +3,9 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include "vtkExtractScatterPlot.h"
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDoubleArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -11,11 +13,97 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedLongArray.h"
 
 #include "vtkIOStream.h"
 
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// Bins pairs of values. Each thread fills its own bins, which are summed into
+// the output in Reduce().
+template <typename XArrayT, typename YArrayT>
+struct ScatterPlotFunctor
+{
+  XArrayT* XArray;
+  YArrayT* YArray;
+  int XComponent;
+  int YComponent;
+  const double* XBinExtents;
+  const double* YBinExtents;
+  int XBinCount;
+  int YBinCount;
+  vtkUnsignedLongArray* BinValues;
+  vtkSMPThreadLocal<std::vector<unsigned long>> LocalBins;
+
+  void Initialize()
+  {
+    this->LocalBins.Local().assign(static_cast<size_t>(this->XBinCount) * this->YBinCount, 0);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const auto xTuples = vtk::DataArrayTupleRange(this->XArray, begin, end);
+    const auto yTuples = vtk::DataArrayTupleRange(this->YArray, begin, end);
+    std::vector<unsigned long>& bins = this->LocalBins.Local();
+
+    for (vtkIdType i = 0; i < end - begin; ++i)
+    {
+      const double x = static_cast<double>(xTuples[i][this->XComponent]);
+      const double y = static_cast<double>(yTuples[i][this->YComponent]);
+
+      // the bin j verifies extents[j] <= value < extents[j + 1]
+      const int xBin = static_cast<int>(std::upper_bound(this->XBinExtents,
+                         this->XBinExtents + this->XBinCount + 1, x) - this->XBinExtents) - 1;
+      const int yBin = static_cast<int>(std::upper_bound(this->YBinExtents,
+                         this->YBinExtents + this->YBinCount + 1, y) - this->YBinExtents) - 1;
+      if (xBin >= 0 && xBin < this->XBinCount && yBin >= 0 && yBin < this->YBinCount)
+      {
+        bins[static_cast<size_t>(xBin) * this->YBinCount + yBin]++;
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    unsigned long* values = this->BinValues->GetPointer(0);
+    for (const std::vector<unsigned long>& bins : this->LocalBins)
+    {
+      for (size_t i = 0; i < bins.size(); ++i)
+      {
+        values[i] += bins[i];
+      }
+    }
+  }
+};
+
+struct ScatterPlotWorker
+{
+  template <typename XArrayT, typename YArrayT>
+  void operator()(XArrayT* xArray, YArrayT* yArray, int xComponent, int yComponent,
+    vtkDoubleArray* xBinExtents, vtkDoubleArray* yBinExtents, vtkUnsignedLongArray* binValues)
+  {
+    ScatterPlotFunctor<XArrayT, YArrayT> functor;
+    functor.XArray = xArray;
+    functor.YArray = yArray;
+    functor.XComponent = xComponent;
+    functor.YComponent = yComponent;
+    functor.XBinExtents = xBinExtents->GetPointer(0);
+    functor.YBinExtents = yBinExtents->GetPointer(0);
+    functor.XBinCount = static_cast<int>(binValues->GetNumberOfTuples());
+    functor.YBinCount = binValues->GetNumberOfComponents();
+    functor.BinValues = binValues;
+    binValues->FillValue(0);
+    vtkSMPTools::For(0, xArray->GetNumberOfTuples(), functor);
+  }
+};
+}
+
 vtkStandardNewMacro(vtkExtractScatterPlot);
 
 vtkExtractScatterPlot::vtkExtractScatterPlot()
@@ -54,7 +142,7 @@ int vtkExtractScatterPlot::FillInputPortInformation(int port, vtkInformation* in
 int vtkExtractScatterPlot::RequestData(vtkInformation* /*request*/,
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
-  int i, j;
+  int i;
 
   vtkDebugMacro(<< "Executing vtkExtractScatterPlot filter");
 
@@ -77,7 +165,7 @@ int vtkExtractScatterPlot::RequestData(vtkInformation* /*request*/,
 
   vtkDoubleArray* const y_bin_extents = vtkDoubleArray::New();
   y_bin_extents->SetNumberOfComponents(1);
-  y_bin_extents->SetNumberOfTuples(this->XBinCount + 1);
+  y_bin_extents->SetNumberOfTuples(this->YBinCount + 1);
   y_bin_extents->SetName("y_bin_extents");
   for (i = 0; i != this->YBinCount + 1; ++i)
   {
@@ -152,35 +240,15 @@ int vtkExtractScatterPlot::RequestData(vtkInformation* /*request*/,
   bin_values->SetNumberOfTuples(this->XBinCount);
   bin_values->SetName("bin_values");
 
-  for (i = 0; i != this->XBinCount; ++i)
+  // Arrays of any value type are binned through the fast path, others (e.g. implicit arrays)
+  // through the vtkDataArray API.
+  ScatterPlotWorker worker;
+  if (!vtkArrayDispatch::Dispatch2ByValueType<vtkArrayDispatch::AllTypes,
+        vtkArrayDispatch::AllTypes>::Execute(x_data_array, y_data_array, worker, this->XComponent,
+        this->YComponent, x_bin_extents, y_bin_extents, bin_values))
   {
-    for (j = 0; j != this->YBinCount; ++j)
-    {
-      bin_values->SetComponent(i, j, 0);
-    }
-  }
-
-  const int value_count = x_data_array->GetNumberOfTuples();
-  for (i = 0; i != value_count; ++i)
-  {
-    const double x = x_data_array->GetComponent(i, this->XComponent);
-    const double y = y_data_array->GetComponent(i, this->YComponent);
-
-    for (j = 0; j != this->XBinCount; ++j)
-    {
-      if (x_bin_extents->GetValue(j) <= x && x < x_bin_extents->GetValue(j + 1))
-      {
-        for (int k = 0; k != this->YBinCount; ++k)
-        {
-          if (y_bin_extents->GetValue(k) <= y && y < y_bin_extents->GetValue(k + 1))
-          {
-            bin_values->SetComponent(j, k, bin_values->GetComponent(j, k) + 1);
-            break;
-          }
-        }
-        break;
-      }
-    }
+    worker(x_data_array, y_data_array, this->XComponent, this->YComponent, x_bin_extents,
+      y_bin_extents, bin_values);
   }
 
   output_data->GetCellData()->AddArray(bin_values);
@@ -4,23 +4,36 @@
 #include "vtkIntegrateFlowThroughSurface.h"
 
 #include "vtkCellData.h"
+#include "vtkCellIntegrator.h"
+#include "vtkCommunicator.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntegrateAttributes.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkSurfaceVectors.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
 vtkStandardNewMacro(vtkIntegrateFlowThroughSurface);
 
 //-----------------------------------------------------------------------------
@@ -86,6 +99,12 @@ int vtkIntegrateFlowThroughSurface::RequestData(
   // get the input and output
   vtkSmartPointer<vtkDataObject> input = inInfo->Get(vtkDataObject::DATA_OBJECT());
 
+  if (this->FastMode &&
+    this->RequestFastData(input, vtkUnstructuredGrid::GetData(outputVector, 0)))
+  {
+    return 1;
+  }
+
   vtkDataSet* dsInput = vtkDataSet::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
   vtkUnstructuredGrid* output =
     vtkUnstructuredGrid::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
@@ -158,6 +177,123 @@ int vtkIntegrateFlowThroughSurface::RequestData(
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+bool vtkIntegrateFlowThroughSurface::RequestFastData(
+  vtkDataObject* input, vtkUnstructuredGrid* output)
+{
+  if (!output)
+  {
+    return false;
+  }
+
+  // Only the leaves with cells contribute to the flow. They must all have the
+  // vectors, and only 2D cells.
+  std::vector<vtkDataSet*> leaves;
+  vtkCellIntegrator::GetLeavesWithCells(input, leaves);
+
+  std::string vectorsName;
+  int localOk = 1;
+  for (vtkDataSet* leaf : leaves)
+  {
+    vtkDataArray* vectors = this->GetInputArrayToProcess(0, leaf);
+    if (!vectors || vectors->GetNumberOfComponents() != 3 ||
+      vtkCellIntegrator::GetMaximumCellDimension(leaf) != 2)
+    {
+      localOk = 0;
+      break;
+    }
+    if (vectorsName.empty() && vectors->GetName())
+    {
+      vectorsName = vectors->GetName();
+    }
+  }
+
+  // Integrals: area, centroid (3), vectors (3) and flow.
+  std::vector<double> sums(8, 0.0);
+  std::vector<double> flow;
+  std::vector<double> leafSums;
+  vtkSMPThreadLocalObject<vtkIdList> tlCellIds;
+  vtkSMPThreadLocalObject<vtkIdList> tlPtIds;
+  for (size_t l = 0; l < leaves.size() && localOk; ++l)
+  {
+    vtkDataSet* leaf = leaves[l];
+    vtkDataArray* vectors = this->GetInputArrayToProcess(0, leaf);
+
+    // The dot product of the vector and the point normal, as interpolated by
+    // the default path. A single scalar per point is kept since points are
+    // shared by several cells.
+    const vtkIdType numberOfPoints = leaf->GetNumberOfPoints();
+    flow.resize(numberOfPoints);
+    if (numberOfPoints > 0)
+    {
+      // Some datasets build their cells and links on first access, which is
+      // not thread safe.
+      vtkNew<vtkIdList> ids;
+      leaf->GetCellType(0);
+      leaf->GetCellPoints(0, ids);
+      leaf->GetPointCells(0, ids);
+    }
+    vtkSMPTools::For(0, numberOfPoints,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        vtkIdList* cellIds = tlCellIds.Local();
+        vtkIdList* ptIds = tlPtIds.Local();
+        double normal[3];
+        double vector[3];
+        for (vtkIdType pointId = begin; pointId < end; ++pointId)
+        {
+          vtkSurfaceVectors::ComputePointNormal(leaf, pointId, cellIds, ptIds, normal);
+          vectors->GetTuple(pointId, vector);
+          flow[pointId] =
+            normal[0] * vector[0] + normal[1] * vector[1] + normal[2] * vector[2];
+        }
+      });
+
+    vtkNew<vtkDoubleArray> flowArray;
+    flowArray->SetArray(flow.data(), numberOfPoints, 1);
+    if (!vtkCellIntegrator::IntegrateCells(leaf, 2, { vectors, flowArray }, {}, leafSums))
+    {
+      localOk = 0;
+      break;
+    }
+    std::transform(sums.begin(), sums.end(), leafSums.begin(), sums.begin(), std::plus<double>());
+  }
+
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  const bool parallel = controller && controller->GetNumberOfProcesses() > 1;
+  const bool isRoot = !parallel || controller->GetLocalProcessId() == 0;
+
+  // The root names the output vectors, so it must have data.
+  int ok[2] = { localOk, (!isRoot || !leaves.empty()) ? 1 : 0 };
+  if (parallel)
+  {
+    int localFlags[2] = { ok[0], ok[1] };
+    controller->AllReduce(localFlags, ok, 2, vtkCommunicator::MIN_OP);
+  }
+  if (!ok[0] || !ok[1])
+  {
+    return false;
+  }
+  if (parallel)
+  {
+    std::vector<double> localSums(sums);
+    controller->AllReduce(localSums.data(), sums.data(), 8, vtkCommunicator::SUM_OP);
+  }
+
+  output->Initialize();
+  if (!isRoot)
+  {
+    return true;
+  }
+
+  // A single point, at the centroid of the surface, and a vertex.
+  vtkCellIntegrator::InitializeVertexOutput(output, sums);
+  vtkCellIntegrator::AddIntegral(output->GetPointData(), vectorsName.c_str(), 3, &sums[4]);
+  vtkCellIntegrator::AddIntegral(output->GetPointData(), "Surface Flow", 1, &sums[7]);
+  vtkCellIntegrator::AddIntegral(output->GetCellData(), "Area", 1, &sums[0]);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 vtkExecutive* vtkIntegrateFlowThroughSurface::CreateDefaultExecutive()
 {
@@ -168,6 +304,7 @@ vtkExecutive* vtkIntegrateFlowThroughSurface::CreateDefaultExecutive()
 void vtkIntegrateFlowThroughSurface::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "FastMode: " << this->FastMode << endl;
 }
 
 //----------------------------------------------------------------------------
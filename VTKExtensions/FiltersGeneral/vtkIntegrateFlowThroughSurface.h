@@ -9,6 +9,15 @@
  * Takes a point vector field from the input and computes the
  * dot product with the normal.  It then integrates this dot value
  * to get net flow through the surface.
+ *
+ * With FastMode on, the surface vectors dataset and the vtkIntegrateAttributes
+ * pass are skipped: the dot products are computed with vtkSMPTools and
+ * integrated directly with vtkCellIntegrator::IntegrateCells(), and the
+ * results of all processes are combined with a single AllReduce. The output
+ * has the "Surface Flow" and integrated vector point arrays and the "Area"
+ * cell array, on the first process only. Fast mode falls back to the default
+ * path when the input has cells of higher dimension or 2D cells not supported
+ * by vtkCellIntegrator::IntegrateLinearCell().
  */
 
 #ifndef vtkIntegrateFlowThroughSurface_h
@@ -28,6 +37,16 @@ public:
   void PrintSelf(ostream& os, vtkIndent indent) override;
   static vtkIntegrateFlowThroughSurface* New();
 
+  ///@{
+  /**
+   * When on, the flow is computed and integrated in a single threaded pass,
+   * as described above. Default is off.
+   */
+  vtkSetMacro(FastMode, bool);
+  vtkGetMacro(FastMode, bool);
+  vtkBooleanMacro(FastMode, bool);
+  ///@}
+
 protected:
   vtkIntegrateFlowThroughSurface();
   ~vtkIntegrateFlowThroughSurface() override;
@@ -44,6 +63,14 @@ protected:
 
   vtkDataSet* GenerateSurfaceVectors(vtkDataSet* input);
 
+  /**
+   * Fast mode implementation. Returns false, on all processes, when the
+   * default path must be used instead.
+   */
+  bool RequestFastData(vtkDataObject* input, vtkUnstructuredGrid* output);
+
+  bool FastMode = false;
+
 private:
   vtkIntegrateFlowThroughSurface(const vtkIntegrateFlowThroughSurface&) = delete;
   void operator=(const vtkIntegrateFlowThroughSurface&) = delete;
@@ -6,6 +6,8 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkPEquivalenceSet);
 
 vtkPEquivalenceSet::vtkPEquivalenceSet() = default;
@@ -47,6 +49,11 @@ int vtkPEquivalenceSet::ResolveEquivalences()
       {
         this->EquivalenceArray->InsertNextTuple1(0);
       }
+      // Merging the equivalences is deferred until all the references have
+      // been received, so that it is done in a single batch and no link made
+      // by the merge is overwritten by a later reference.
+      std::vector<int> ids1;
+      std::vector<int> ids2;
       for (int i = 0; i < workingSet->GetNumberOfTuples(); i++)
       {
         int workingVal = workingSet->GetValue(i);
@@ -56,11 +63,13 @@ int vtkPEquivalenceSet::ResolveEquivalences()
         }
         int existingVal = this->EquivalenceArray->GetValue(i);
         this->EquivalenceArray->SetValue(i, workingVal);
-        if (existingVal != 0 && existingVal < workingVal)
+        if (existingVal != 0 && existingVal != workingVal)
         {
-          this->EquateInternal(existingVal, workingVal);
+          ids1.push_back(existingVal);
+          ids2.push_back(workingVal);
         }
       }
+      this->AddEquivalences(ids1.data(), ids2.data(), static_cast<vtkIdType>(ids1.size()));
     }
     pivot /= 2;
   }
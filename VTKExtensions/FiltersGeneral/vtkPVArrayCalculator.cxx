@@ -3,9 +3,11 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPVArrayCalculator.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataObject.h"
 #include "vtkDataSet.h"
 #include "vtkGraph.h"
@@ -14,13 +16,24 @@
 #include "vtkObjectFactory.h"
 #include "vtkPVPostFilter.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkTable.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <locale>
+#include <map>
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -62,6 +75,732 @@ public:
     this->Calc->AddScalarVariable(name.c_str(), this->ArrayName, this->Component);
   }
 };
+
+// Number of tuples evaluated at once by a vtkCalculatorProgram.
+constexpr vtkIdType CALCULATOR_BLOCK_SIZE = 1024;
+
+// An input array bound to a scalar (1 component) or vector (3 components)
+// calculator variable.
+struct vtkCalculatorVariable
+{
+  vtkDataArray* Array = nullptr;
+  int NumberOfComponents = 1;
+  int Components[3] = { 0, 0, 0 };
+};
+
+using vtkCalculatorVariableMap = std::map<std::string, vtkCalculatorVariable>;
+
+struct vtkCalculatorLoadWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, vtkIdType begin, vtkIdType end, const int* components,
+    int numberOfComponents, double* const* values) const
+  {
+    const auto tuples = vtk::DataArrayTupleRange(array, begin, end);
+    for (int cc = 0; cc < numberOfComponents; ++cc)
+    {
+      double* output = values[cc];
+      const int component = components[cc];
+      for (const auto tuple : tuples)
+      {
+        *output++ = static_cast<double>(tuple[component]);
+      }
+    }
+  }
+};
+
+struct vtkCalculatorStoreWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, vtkIdType begin, vtkIdType end, const double* const* values) const
+  {
+    using ValueType = vtk::GetAPIType<ArrayT>;
+    auto tuples = vtk::DataArrayTupleRange(array, begin, end);
+    const int numberOfComponents = tuples.GetTupleSize();
+    vtkIdType index = 0;
+    for (auto tuple : tuples)
+    {
+      for (int cc = 0; cc < numberOfComponents; ++cc)
+      {
+        tuple[cc] = static_cast<ValueType>(values[cc][index]);
+      }
+      ++index;
+    }
+  }
+};
+
+/**
+ * A calculator function lowered into a list of instructions working on blocks
+ * of up to CALCULATOR_BLOCK_SIZE tuples. Each instruction writes a new
+ * register, which holds either a scalar or a 3-component vector per tuple, so
+ * every operation is a plain loop over contiguous doubles.
+ *
+ * Only the subset of the ExprTk syntax whose evaluation is unambiguous is
+ * compiled, using the same operation order as the ExprTk parser;
+ * Compile() returns false for anything else.
+ */
+class vtkCalculatorProgram
+{
+public:
+  bool Compile(const std::string& function, const vtkCalculatorVariableMap& variables)
+  {
+    this->Instructions.clear();
+    this->Widths.clear();
+    this->Variables = &variables;
+    this->Position = 0;
+    if (!this->Tokenize(function))
+    {
+      return false;
+    }
+    this->ResultRegister = this->ParseComparison();
+    return this->ResultRegister >= 0 && this->Tokens[this->Position].Type == Token::End;
+  }
+
+  int GetNumberOfResultComponents() const { return this->Widths[this->ResultRegister]; }
+
+  int GetNumberOfRegisters() const { return static_cast<int>(this->Widths.size()); }
+
+  /**
+   * Evaluates tuples [begin, end) into `result`, using `registers` as scratch
+   * space (3 * CALCULATOR_BLOCK_SIZE values per register). Returns false,
+   * without writing `result`, if any result value is not finite.
+   */
+  bool Execute(vtkIdType begin, vtkIdType end, double* registers, vtkDataArray* result) const
+  {
+    const vtkIdType size = end - begin;
+    auto component = [registers](int reg, int comp)
+    { return registers + (3 * reg + comp) * CALCULATOR_BLOCK_SIZE; };
+
+    for (const Instruction& instruction : this->Instructions)
+    {
+      const int reg = instruction.Result;
+      const int width = this->Widths[reg];
+      const int a = instruction.Operands[0];
+      const int b = instruction.Operands[1];
+      const int c = instruction.Operands[2];
+      switch (instruction.Op)
+      {
+        case OpCode::Load:
+        {
+          const vtkCalculatorVariable* variable = instruction.Variable;
+          double* values[3] = { component(reg, 0), component(reg, 1), component(reg, 2) };
+          vtkCalculatorLoadWorker worker;
+          if (!vtkArrayDispatch::Dispatch::Execute(variable->Array, worker, begin, end,
+                variable->Components, variable->NumberOfComponents, values))
+          {
+            worker(variable->Array, begin, end, variable->Components,
+              variable->NumberOfComponents, values);
+          }
+          break;
+        }
+        case OpCode::Constant:
+          std::fill_n(component(reg, 0), size, instruction.Value);
+          break;
+        case OpCode::Axis:
+          for (int cc = 0; cc < 3; ++cc)
+          {
+            std::fill_n(component(reg, cc), size, cc == a ? 1.0 : 0.0);
+          }
+          break;
+        case OpCode::Negate:
+          for (int cc = 0; cc < width; ++cc)
+          {
+            double* out = component(reg, cc);
+            const double* x = component(a, cc);
+            for (vtkIdType i = 0; i < size; ++i)
+            {
+              out[i] = -x[i];
+            }
+          }
+          break;
+        case OpCode::Add:
+        case OpCode::Subtract:
+          for (int cc = 0; cc < width; ++cc)
+          {
+            double* out = component(reg, cc);
+            const double* x = component(a, cc);
+            const double* y = component(b, cc);
+            if (instruction.Op == OpCode::Add)
+            {
+              for (vtkIdType i = 0; i < size; ++i)
+              {
+                out[i] = x[i] + y[i];
+              }
+            }
+            else
+            {
+              for (vtkIdType i = 0; i < size; ++i)
+              {
+                out[i] = x[i] - y[i];
+              }
+            }
+          }
+          break;
+        case OpCode::Multiply:
+        case OpCode::Scale:
+          // Scale multiplies each component of the vector `a` by the scalar `b`.
+          for (int cc = 0; cc < width; ++cc)
+          {
+            double* out = component(reg, cc);
+            const double* x = component(a, cc);
+            const double* y = component(b, 0);
+            for (vtkIdType i = 0; i < size; ++i)
+            {
+              out[i] = x[i] * y[i];
+            }
+          }
+          break;
+        case OpCode::Divide:
+          for (int cc = 0; cc < width; ++cc)
+          {
+            double* out = component(reg, cc);
+            const double* x = component(a, cc);
+            const double* y = component(b, 0);
+            for (vtkIdType i = 0; i < size; ++i)
+            {
+              out[i] = x[i] / y[i];
+            }
+          }
+          break;
+        case OpCode::Less:
+        case OpCode::LessEqual:
+        case OpCode::Greater:
+        case OpCode::GreaterEqual:
+        {
+          double* out = component(reg, 0);
+          const double* x = component(a, 0);
+          const double* y = component(b, 0);
+          switch (instruction.Op)
+          {
+            case OpCode::Less:
+              for (vtkIdType i = 0; i < size; ++i)
+              {
+                out[i] = x[i] < y[i] ? 1.0 : 0.0;
+              }
+              break;
+            case OpCode::LessEqual:
+              for (vtkIdType i = 0; i < size; ++i)
+              {
+                out[i] = x[i] <= y[i] ? 1.0 : 0.0;
+              }
+              break;
+            case OpCode::Greater:
+              for (vtkIdType i = 0; i < size; ++i)
+              {
+                out[i] = x[i] > y[i] ? 1.0 : 0.0;
+              }
+              break;
+            default:
+              for (vtkIdType i = 0; i < size; ++i)
+              {
+                out[i] = x[i] >= y[i] ? 1.0 : 0.0;
+              }
+              break;
+          }
+          break;
+        }
+        case OpCode::Function:
+        {
+          double* out = component(reg, 0);
+          const double* x = component(a, 0);
+          for (vtkIdType i = 0; i < size; ++i)
+          {
+            out[i] = instruction.Function(x[i]);
+          }
+          break;
+        }
+        case OpCode::Dot:
+        {
+          double* out = component(reg, 0);
+          const double *x0 = component(a, 0), *x1 = component(a, 1), *x2 = component(a, 2);
+          const double *y0 = component(b, 0), *y1 = component(b, 1), *y2 = component(b, 2);
+          for (vtkIdType i = 0; i < size; ++i)
+          {
+            out[i] = x0[i] * y0[i] + x1[i] * y1[i] + x2[i] * y2[i];
+          }
+          break;
+        }
+        case OpCode::Cross:
+        {
+          double *out0 = component(reg, 0), *out1 = component(reg, 1), *out2 = component(reg, 2);
+          const double *x0 = component(a, 0), *x1 = component(a, 1), *x2 = component(a, 2);
+          const double *y0 = component(b, 0), *y1 = component(b, 1), *y2 = component(b, 2);
+          for (vtkIdType i = 0; i < size; ++i)
+          {
+            out0[i] = x1[i] * y2[i] - x2[i] * y1[i];
+            out1[i] = x2[i] * y0[i] - x0[i] * y2[i];
+            out2[i] = x0[i] * y1[i] - x1[i] * y0[i];
+          }
+          break;
+        }
+        case OpCode::Magnitude:
+        case OpCode::Normalize:
+        {
+          // Normalize computes the magnitude into its first component first.
+          double* out = component(reg, 0);
+          const double *x0 = component(a, 0), *x1 = component(a, 1), *x2 = component(a, 2);
+          for (vtkIdType i = 0; i < size; ++i)
+          {
+            out[i] = std::sqrt(x0[i] * x0[i] + x1[i] * x1[i] + x2[i] * x2[i]);
+          }
+          if (instruction.Op == OpCode::Normalize)
+          {
+            double *out1 = component(reg, 1), *out2 = component(reg, 2);
+            for (vtkIdType i = 0; i < size; ++i)
+            {
+              const double magnitude = out[i];
+              out[i] = x0[i] / magnitude;
+              out1[i] = x1[i] / magnitude;
+              out2[i] = x2[i] / magnitude;
+            }
+          }
+          break;
+        }
+        case OpCode::Select:
+          for (int cc = 0; cc < width; ++cc)
+          {
+            double* out = component(reg, cc);
+            const double* condition = component(a, 0);
+            const double* x = component(b, cc);
+            const double* y = component(c, cc);
+            for (vtkIdType i = 0; i < size; ++i)
+            {
+              out[i] = condition[i] != 0.0 ? x[i] : y[i];
+            }
+          }
+          break;
+      }
+    }
+
+    const int numberOfComponents = this->GetNumberOfResultComponents();
+    const double* values[3] = { nullptr, nullptr, nullptr };
+    for (int cc = 0; cc < numberOfComponents; ++cc)
+    {
+      values[cc] = component(this->ResultRegister, cc);
+      if (!std::all_of(values[cc], values[cc] + size, [](double v) { return std::isfinite(v); }))
+      {
+        return false;
+      }
+    }
+    vtkCalculatorStoreWorker worker;
+    if (!vtkArrayDispatch::Dispatch::Execute(result, worker, begin, end, values))
+    {
+      worker(result, begin, end, values);
+    }
+    return true;
+  }
+
+private:
+  enum class OpCode
+  {
+    Load,
+    Constant,
+    Axis,
+    Negate,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Scale,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Function,
+    Dot,
+    Cross,
+    Magnitude,
+    Normalize,
+    Select
+  };
+
+  struct Instruction
+  {
+    OpCode Op;
+    int Result;
+    int Operands[3];
+    double Value;
+    double (*Function)(double);
+    const vtkCalculatorVariable* Variable;
+  };
+
+  struct Token
+  {
+    enum KindType
+    {
+      Number,
+      Name,
+      Operator,
+      End
+    };
+    KindType Type;
+    std::string Text;
+    double Value;
+  };
+
+  bool Tokenize(const std::string& function)
+  {
+    this->Tokens.clear();
+    const size_t length = function.size();
+    size_t pos = 0;
+    while (pos < length)
+    {
+      const char ch = function[pos];
+      const char next = pos + 1 < length ? function[pos + 1] : '\0';
+      if (std::isspace(static_cast<unsigned char>(ch)))
+      {
+        ++pos;
+      }
+      else if (std::isdigit(static_cast<unsigned char>(ch)) ||
+        (ch == '.' && std::isdigit(static_cast<unsigned char>(next))))
+      {
+        size_t end = pos;
+        while (end < length &&
+          (std::isdigit(static_cast<unsigned char>(function[end])) || function[end] == '.'))
+        {
+          ++end;
+        }
+        if (end < length && (function[end] == 'e' || function[end] == 'E'))
+        {
+          size_t exponent = end + 1;
+          if (exponent < length && (function[exponent] == '+' || function[exponent] == '-'))
+          {
+            ++exponent;
+          }
+          if (exponent < length && std::isdigit(static_cast<unsigned char>(function[exponent])))
+          {
+            end = exponent;
+            while (end < length && std::isdigit(static_cast<unsigned char>(function[end])))
+            {
+              ++end;
+            }
+          }
+        }
+        Token token{ Token::Number, function.substr(pos, end - pos), 0.0 };
+        std::istringstream stream(token.Text);
+        stream.imbue(std::locale::classic());
+        if (!(stream >> token.Value) || stream.peek() != std::char_traits<char>::eof())
+        {
+          return false;
+        }
+        this->Tokens.push_back(token);
+        pos = end;
+      }
+      else if (std::isalpha(static_cast<unsigned char>(ch)) || ch == '_')
+      {
+        size_t end = pos + 1;
+        while (end < length &&
+          (std::isalnum(static_cast<unsigned char>(function[end])) || function[end] == '_'))
+        {
+          ++end;
+        }
+        this->Tokens.push_back(Token{ Token::Name, function.substr(pos, end - pos), 0.0 });
+        pos = end;
+      }
+      else if (ch == '\"')
+      {
+        const size_t end = function.find('\"', pos + 1);
+        if (end == std::string::npos)
+        {
+          return false;
+        }
+        this->Tokens.push_back(Token{ Token::Name, function.substr(pos, end + 1 - pos), 0.0 });
+        pos = end + 1;
+      }
+      else if ((ch == '<' || ch == '>') && next == '=')
+      {
+        this->Tokens.push_back(Token{ Token::Operator, function.substr(pos, 2), 0.0 });
+        pos += 2;
+      }
+      else if (std::strchr("+-*/(),<>", ch))
+      {
+        this->Tokens.push_back(Token{ Token::Operator, std::string(1, ch), 0.0 });
+        ++pos;
+      }
+      else
+      {
+        return false;
+      }
+    }
+    this->Tokens.push_back(Token{ Token::End, std::string(), 0.0 });
+    return true;
+  }
+
+  bool Accept(const char* text)
+  {
+    const Token& token = this->Tokens[this->Position];
+    if (token.Type == Token::Operator && token.Text == text)
+    {
+      ++this->Position;
+      return true;
+    }
+    return false;
+  }
+
+  int Emit(OpCode op, int width, int a = -1, int b = -1, int c = -1)
+  {
+    Instruction instruction{ op, static_cast<int>(this->Widths.size()), { a, b, c }, 0.0, nullptr,
+      nullptr };
+    this->Widths.push_back(width);
+    this->Instructions.push_back(instruction);
+    return instruction.Result;
+  }
+
+  int Width(int reg) const { return this->Widths[reg]; }
+
+  // comparison := sum (('<' | '<=' | '>' | '>=') sum)*
+  int ParseComparison()
+  {
+    int lhs = this->ParseSum();
+    while (lhs >= 0)
+    {
+      OpCode op;
+      if (this->Accept("<"))
+      {
+        op = OpCode::Less;
+      }
+      else if (this->Accept("<="))
+      {
+        op = OpCode::LessEqual;
+      }
+      else if (this->Accept(">"))
+      {
+        op = OpCode::Greater;
+      }
+      else if (this->Accept(">="))
+      {
+        op = OpCode::GreaterEqual;
+      }
+      else
+      {
+        break;
+      }
+      const int rhs = this->ParseSum();
+      if (rhs < 0 || this->Width(lhs) != 1 || this->Width(rhs) != 1)
+      {
+        return -1;
+      }
+      lhs = this->Emit(op, 1, lhs, rhs);
+    }
+    return lhs;
+  }
+
+  // sum := product (('+' | '-') product)*
+  int ParseSum()
+  {
+    int lhs = this->ParseProduct();
+    while (lhs >= 0)
+    {
+      OpCode op;
+      if (this->Accept("+"))
+      {
+        op = OpCode::Add;
+      }
+      else if (this->Accept("-"))
+      {
+        op = OpCode::Subtract;
+      }
+      else
+      {
+        break;
+      }
+      const int rhs = this->ParseProduct();
+      if (rhs < 0 || this->Width(lhs) != this->Width(rhs))
+      {
+        return -1;
+      }
+      lhs = this->Emit(op, this->Width(lhs), lhs, rhs);
+    }
+    return lhs;
+  }
+
+  // product := unary (('*' | '/') unary)*
+  int ParseProduct()
+  {
+    int lhs = this->ParseUnary();
+    while (lhs >= 0)
+    {
+      if (this->Accept("*"))
+      {
+        const int rhs = this->ParseUnary();
+        if (rhs < 0 || (this->Width(lhs) == 3 && this->Width(rhs) == 3))
+        {
+          return -1;
+        }
+        if (this->Width(lhs) == 1 && this->Width(rhs) == 1)
+        {
+          lhs = this->Emit(OpCode::Multiply, 1, lhs, rhs);
+        }
+        else if (this->Width(lhs) == 3)
+        {
+          lhs = this->Emit(OpCode::Scale, 3, lhs, rhs);
+        }
+        else
+        {
+          lhs = this->Emit(OpCode::Scale, 3, rhs, lhs);
+        }
+      }
+      else if (this->Accept("/"))
+      {
+        const int rhs = this->ParseUnary();
+        if (rhs < 0 || this->Width(rhs) != 1)
+        {
+          return -1;
+        }
+        lhs = this->Emit(OpCode::Divide, this->Width(lhs), lhs, rhs);
+      }
+      else
+      {
+        break;
+      }
+    }
+    return lhs;
+  }
+
+  // unary := ('-' | '+') unary | primary
+  int ParseUnary()
+  {
+    if (this->Accept("-"))
+    {
+      const int operand = this->ParseUnary();
+      return operand < 0 ? -1 : this->Emit(OpCode::Negate, this->Width(operand), operand);
+    }
+    if (this->Accept("+"))
+    {
+      return this->ParseUnary();
+    }
+    return this->ParsePrimary();
+  }
+
+  // primary := number | '(' comparison ')' | name | name '(' arguments ')'
+  int ParsePrimary()
+  {
+    const Token token = this->Tokens[this->Position];
+    if (token.Type == Token::Number)
+    {
+      ++this->Position;
+      const int reg = this->Emit(OpCode::Constant, 1);
+      this->Instructions.back().Value = token.Value;
+      return reg;
+    }
+    if (this->Accept("("))
+    {
+      const int reg = this->ParseComparison();
+      return reg >= 0 && this->Accept(")") ? reg : -1;
+    }
+    if (token.Type != Token::Name)
+    {
+      return -1;
+    }
+    ++this->Position;
+    if (this->Accept("("))
+    {
+      return this->ParseCall(token.Text);
+    }
+    static const char* const axes[3] = { "iHat", "jHat", "kHat" };
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      if (token.Text == axes[axis] && this->Variables->find(token.Text) == this->Variables->end())
+      {
+        return this->Emit(OpCode::Axis, 3, axis);
+      }
+    }
+    auto iter = this->Variables->find(token.Text);
+    if (iter == this->Variables->end())
+    {
+      return -1;
+    }
+    const int reg = this->Emit(OpCode::Load, iter->second.NumberOfComponents);
+    this->Instructions.back().Variable = &iter->second;
+    return reg;
+  }
+
+  // Parses the arguments of a call to `name`, the opening parenthesis having
+  // been consumed.
+  int ParseCall(const std::string& name)
+  {
+    std::vector<int> arguments;
+    if (!this->Accept(")"))
+    {
+      do
+      {
+        const int argument = this->ParseComparison();
+        if (argument < 0)
+        {
+          return -1;
+        }
+        arguments.push_back(argument);
+      } while (this->Accept(","));
+      if (!this->Accept(")"))
+      {
+        return -1;
+      }
+    }
+    std::vector<int> widths;
+    for (int argument : arguments)
+    {
+      widths.push_back(this->Width(argument));
+    }
+
+    struct ScalarFunction
+    {
+      const char* Name;
+      double (*Function)(double);
+    };
+    static const ScalarFunction scalarFunctions[] = {
+      { "abs", [](double x) { return std::abs(x); } },
+      { "sqrt", [](double x) { return std::sqrt(x); } },
+      { "exp", [](double x) { return std::exp(x); } },
+      { "log10", [](double x) { return std::log10(x); } },
+      { "sin", [](double x) { return std::sin(x); } },
+      { "cos", [](double x) { return std::cos(x); } },
+      { "tan", [](double x) { return std::tan(x); } },
+      { "asin", [](double x) { return std::asin(x); } },
+      { "acos", [](double x) { return std::acos(x); } },
+      { "atan", [](double x) { return std::atan(x); } },
+      { "sinh", [](double x) { return std::sinh(x); } },
+      { "cosh", [](double x) { return std::cosh(x); } },
+      { "tanh", [](double x) { return std::tanh(x); } },
+      { "ceil", [](double x) { return std::ceil(x); } },
+      { "floor", [](double x) { return std::floor(x); } },
+    };
+    for (const ScalarFunction& function : scalarFunctions)
+    {
+      if (name == function.Name)
+      {
+        if (widths != std::vector<int>{ 1 })
+        {
+          return -1;
+        }
+        const int reg = this->Emit(OpCode::Function, 1, arguments[0]);
+        this->Instructions.back().Function = function.Function;
+        return reg;
+      }
+    }
+    if ((name == "mag" || name == "norm") && widths == std::vector<int>{ 3 })
+    {
+      return name == "mag" ? this->Emit(OpCode::Magnitude, 1, arguments[0])
+                           : this->Emit(OpCode::Normalize, 3, arguments[0]);
+    }
+    if ((name == "dot" || name == "cross") && widths == std::vector<int>{ 3, 3 })
+    {
+      return name == "dot" ? this->Emit(OpCode::Dot, 1, arguments[0], arguments[1])
+                           : this->Emit(OpCode::Cross, 3, arguments[0], arguments[1]);
+    }
+    if (name == "if" && widths.size() == 3 && widths[0] == 1 && widths[1] == widths[2])
+    {
+      return this->Emit(OpCode::Select, widths[1], arguments[0], arguments[1], arguments[2]);
+    }
+    return -1;
+  }
+
+  std::vector<Token> Tokens;
+  size_t Position = 0;
+  const vtkCalculatorVariableMap* Variables = nullptr;
+  std::vector<Instruction> Instructions;
+  std::vector<int> Widths;
+  int ResultRegister = -1;
+};
 }
 
 vtkStandardNewMacro(vtkPVArrayCalculator);
@@ -242,11 +981,226 @@ int vtkPVArrayCalculator::RequestData(
   assert(this->GetMTime() == mtime && "post: mtime cannot be changed in RequestData()");
   (void)mtime;
 
+  this->UsedCompiledExpression = this->CompileExpression &&
+    this->RequestCompiledData(input, vtkDataObject::GetData(outputVector, 0));
+  if (this->UsedCompiledExpression)
+  {
+    return 1;
+  }
   return this->Superclass::RequestData(request, inputVector, outputVector);
 }
 
+// ----------------------------------------------------------------------------
+bool vtkPVArrayCalculator::RequestCompiledData(vtkDataObject* input, vtkDataObject* output)
+{
+  if (!input || !output || !this->GetFunction() || !this->GetResultArrayName() ||
+    this->GetCoordinateResults() || this->GetResultNormals() || this->GetResultTCoords() ||
+    this->GetFunctionParserType() != FunctionParserTypes::ExprTkFunctionParser)
+  {
+    return false;
+  }
+
+  // Composite datasets are evaluated leaf by leaf. All the results are computed before the
+  // output is touched, so that any leaf that is not supported makes the whole input fall back.
+  std::vector<vtkDataObject*> leaves;
+  auto inputCD = vtkCompositeDataSet::SafeDownCast(input);
+  vtkSmartPointer<vtkCompositeDataIterator> cdIter;
+  if (inputCD)
+  {
+    cdIter.TakeReference(inputCD->NewIterator());
+    cdIter->SkipEmptyNodesOn();
+    for (cdIter->InitTraversal(); !cdIter->IsDoneWithTraversal(); cdIter->GoToNextItem())
+    {
+      leaves.push_back(cdIter->GetCurrentDataObject());
+    }
+  }
+  else
+  {
+    leaves.push_back(input);
+  }
+
+  std::vector<vtkSmartPointer<vtkDataArray>> results(leaves.size());
+  bool evaluated = false;
+  for (size_t cc = 0; cc < leaves.size(); ++cc)
+  {
+    vtkDataObject* leaf = leaves[cc];
+    if (!vtkDataSet::SafeDownCast(leaf) && !vtkTable::SafeDownCast(leaf))
+    {
+      return false;
+    }
+    vtkDataSetAttributes* leafAttrs = leaf->GetAttributes(this->GetAttributeTypeFromInput(leaf));
+    if (!leafAttrs)
+    {
+      return false;
+    }
+    if (leafAttrs->GetNumberOfTuples() <= 0)
+    {
+      // empty leaves are passed without result, as by the superclass
+      continue;
+    }
+    results[cc] = this->ComputeCompiledResult(leaf);
+    if (!results[cc])
+    {
+      return false;
+    }
+    evaluated = true;
+  }
+  if (!evaluated)
+  {
+    return false;
+  }
+
+  // The result becomes the active scalars or vectors, as with the regular evaluation.
+  auto addResult = [&](vtkDataObject* target, vtkDataArray* result)
+  {
+    vtkDataSetAttributes* outDataAttrs =
+      target->GetAttributes(this->GetAttributeTypeFromInput(target));
+    const int index = outDataAttrs->AddArray(result);
+    outDataAttrs->SetActiveAttribute(index,
+      result->GetNumberOfComponents() == 1 ? vtkDataSetAttributes::SCALARS
+                                           : vtkDataSetAttributes::VECTORS);
+  };
+
+  if (!inputCD)
+  {
+    output->ShallowCopy(input);
+    addResult(output, results[0]);
+    return true;
+  }
+
+  auto outputCD = vtkCompositeDataSet::SafeDownCast(output);
+  if (!outputCD)
+  {
+    return false;
+  }
+  outputCD->CopyStructure(inputCD);
+  size_t leafIndex = 0;
+  for (cdIter->InitTraversal(); !cdIter->IsDoneWithTraversal(); cdIter->GoToNextItem(), ++leafIndex)
+  {
+    vtkDataObject* leaf = cdIter->GetCurrentDataObject();
+    vtkSmartPointer<vtkDataObject> outputLeaf = vtk::TakeSmartPointer(leaf->NewInstance());
+    outputLeaf->ShallowCopy(leaf);
+    if (results[leafIndex])
+    {
+      addResult(outputLeaf, results[leafIndex]);
+    }
+    outputCD->SetDataSet(cdIter, outputLeaf);
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> vtkPVArrayCalculator::ComputeCompiledResult(vtkDataObject* input)
+{
+  const int attributeType = this->GetAttributeTypeFromInput(input);
+  vtkDataSetAttributes* inDataAttrs = input->GetAttributes(attributeType);
+  const vtkIdType numberOfTuples = inDataAttrs ? inDataAttrs->GetNumberOfTuples() : 0;
+  if (numberOfTuples <= 0)
+  {
+    return nullptr;
+  }
+
+  // Bind the variables registered with the superclass to the input arrays.
+  // Variables whose array is missing are left out, so that functions using
+  // them fall back to the superclass.
+  vtkCalculatorVariableMap variables;
+  auto addVariable =
+    [&](const std::string& name, vtkDataArray* array, int numberOfComponents, const int* components)
+  {
+    if (!array || array->GetNumberOfTuples() < numberOfTuples)
+    {
+      return;
+    }
+    for (int cc = 0; cc < numberOfComponents; ++cc)
+    {
+      if (components[cc] < 0 || components[cc] >= array->GetNumberOfComponents())
+      {
+        return;
+      }
+    }
+    vtkCalculatorVariable& variable = variables[name];
+    variable.Array = array;
+    variable.NumberOfComponents = numberOfComponents;
+    std::copy(components, components + numberOfComponents, variable.Components);
+  };
+
+  for (int i = 0; i < this->GetNumberOfScalarArrays(); ++i)
+  {
+    const std::string arrayName = this->GetScalarArrayName(i);
+    const int component = this->GetSelectedScalarComponent(i);
+    addVariable(
+      this->GetScalarVariableName(i), inDataAttrs->GetArray(arrayName.c_str()), 1, &component);
+  }
+  for (int i = 0; i < this->GetNumberOfVectorArrays(); ++i)
+  {
+    const std::string arrayName = this->GetVectorArrayName(i);
+    const auto selected = this->GetSelectedVectorComponents(i);
+    const int components[3] = { selected[0], selected[1], selected[2] };
+    addVariable(
+      this->GetVectorVariableName(i), inDataAttrs->GetArray(arrayName.c_str()), 3, components);
+  }
+  auto pointSet = vtkPointSet::SafeDownCast(input);
+  if (attributeType == vtkDataObject::POINT && pointSet && pointSet->GetPoints())
+  {
+    vtkDataArray* coordinates = pointSet->GetPoints()->GetData();
+    for (int i = 0; i < this->GetNumberOfCoordinateScalarArrays(); ++i)
+    {
+      const int component = this->GetSelectedCoordinateScalarComponent(i);
+      addVariable(this->GetCoordinateScalarVariableName(i), coordinates, 1, &component);
+    }
+    for (int i = 0; i < this->GetNumberOfCoordinateVectorArrays(); ++i)
+    {
+      const auto selected = this->GetSelectedCoordinateVectorComponents(i);
+      const int components[3] = { selected[0], selected[1], selected[2] };
+      addVariable(this->GetCoordinateVectorVariableName(i), coordinates, 3, components);
+    }
+  }
+
+  vtkCalculatorProgram program;
+  if (!program.Compile(this->GetFunction(), variables))
+  {
+    return nullptr;
+  }
+
+  vtkSmartPointer<vtkDataArray> result =
+    vtk::TakeSmartPointer(vtkDataArray::CreateDataArray(this->GetResultArrayType()));
+  if (!result)
+  {
+    return nullptr;
+  }
+  result->SetName(this->GetResultArrayName());
+  result->SetNumberOfComponents(program.GetNumberOfResultComponents());
+  result->SetNumberOfTuples(numberOfTuples);
+
+  const vtkIdType numberOfBlocks =
+    (numberOfTuples + CALCULATOR_BLOCK_SIZE - 1) / CALCULATOR_BLOCK_SIZE;
+  std::atomic<bool> finite(true);
+  vtkSMPTools::For(0, numberOfBlocks,
+    [&](vtkIdType first, vtkIdType last)
+    {
+      std::vector<double> registers(
+        static_cast<size_t>(3 * CALCULATOR_BLOCK_SIZE * program.GetNumberOfRegisters()));
+      for (vtkIdType block = first; block < last && finite; ++block)
+      {
+        const vtkIdType begin = block * CALCULATOR_BLOCK_SIZE;
+        const vtkIdType end = std::min(begin + CALCULATOR_BLOCK_SIZE, numberOfTuples);
+        if (!program.Execute(begin, end, registers.data(), result))
+        {
+          finite = false;
+        }
+      }
+    });
+  if (!finite)
+  {
+    return nullptr;
+  }
+  return result;
+}
+
 // ----------------------------------------------------------------------------
 void vtkPVArrayCalculator::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CompileExpression: " << this->CompileExpression << endl;
+  os << indent << "UsedCompiledExpression: " << this->UsedCompiledExpression << endl;
 }
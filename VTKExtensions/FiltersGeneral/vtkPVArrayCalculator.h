@@ -13,6 +13,11 @@
  *  their mapping with the input fields. We extend vtkArrayCalculator to
  *  automatically add scalar/vector fields mapping using the array available in
  *  the input.
+ *
+ *  When CompileExpression is on, simple expressions are lowered into a
+ *  block-wise program that reads the input arrays directly and is evaluated
+ *  over chunks of tuples on multiple threads, instead of evaluating the
+ *  parsed expression once per tuple. See SetCompileExpression().
  * @sa
  *  vtkArrayCalculator vtkFunctionParser
  */
@@ -22,7 +27,9 @@
 
 #include "vtkArrayCalculator.h"
 #include "vtkPVVTKExtensionsFiltersGeneralModule.h" //needed for exports
+#include "vtkSmartPointer.h"                        // for vtkSmartPointer
 
+class vtkDataArray;
 class vtkDataObject;
 class vtkDataSetAttributes;
 
@@ -46,6 +53,24 @@ public:
   }
   ///@}
 
+  ///@{
+  /**
+   * When on, the function is compiled into a block-wise program that is
+   * evaluated over chunks of tuples, reading the input arrays directly.
+   * Only expressions made of scalar and vector variables, numeric constants,
+   * `+`, `-`, `*`, `/`, comparisons, `if(condition, a, b)`, `mag`, `norm`,
+   * `dot`, `cross` and the scalar math functions are compiled, for a vtkDataSet
+   * or vtkTable input using the ExprTk parser and producing a new array.
+   * Everything else, as well as results that are not finite, falls back to the
+   * regular per-tuple evaluation.
+   *
+   * The default is off.
+   */
+  vtkSetMacro(CompileExpression, bool);
+  vtkGetMacro(CompileExpression, bool);
+  vtkBooleanMacro(CompileExpression, bool);
+  ///@}
+
 protected:
   vtkPVArrayCalculator();
   ~vtkPVArrayCalculator() override;
@@ -72,6 +97,31 @@ protected:
    */
   void AddArrayAndVariableNames(vtkDataObject* theInputObj, vtkDataSetAttributes* inDataAttrs);
 
+  /**
+   * Evaluates the function with the compiled block-wise program, filling
+   * `output`. Composite datasets are evaluated leaf by leaf. Returns false,
+   * leaving `output` untouched, when the function or any leaf of the input is
+   * not supported or when a result is not finite, in which case the superclass
+   * evaluation must be used instead.
+   */
+  bool RequestCompiledData(vtkDataObject* input, vtkDataObject* output);
+
+  /**
+   * Evaluates the function with the compiled block-wise program on a dataset
+   * or a table. Returns nullptr when the function or the input is not
+   * supported or when a result is not finite.
+   */
+  vtkSmartPointer<vtkDataArray> ComputeCompiledResult(vtkDataObject* input);
+
+  /**
+   * Returns true when the last execution evaluated the function with the
+   * compiled block-wise program, false when it used the regular evaluation.
+   */
+  vtkGetMacro(UsedCompiledExpression, bool);
+
+  bool CompileExpression = false;
+  bool UsedCompiledExpression = false;
+
 private:
   vtkPVArrayCalculator(const vtkPVArrayCalculator&) = delete;
   void operator=(const vtkPVArrayCalculator&) = delete;
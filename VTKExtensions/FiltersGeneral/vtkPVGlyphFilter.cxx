@@ -6,6 +6,7 @@
 #include "vtkAMRDataObject.h"
 #include "vtkBoundingBox.h"
 #include "vtkCellCenters.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataSet.h"
@@ -20,10 +21,13 @@
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
-#include "vtkOctreePointLocator.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTetra.h"
 #include "vtkTransform.h"
@@ -44,6 +48,90 @@
 #include <vector>
 
 static const std::string IDS_ARRAY_NAME = "vtkPVGlyphFilter_Ids";
+
+namespace
+{
+// Number of values per chunk of the parallel prefix sum. It does not depend on
+// the number of threads so that the sums, hence the sampling, are the same
+// for any number of threads.
+constexpr vtkIdType PARTIAL_SUM_CHUNK_SIZE = 65536;
+
+//-----------------------------------------------------------------------------
+// In-place inclusive prefix sum of values, computed by chunks in parallel:
+// each chunk is summed, the chunk sums are scanned, then each chunk is scanned
+// starting from the sum of the previous chunks.
+void vtkPVGlyphFilterPartialSum(std::vector<double>& values)
+{
+  const vtkIdType size = static_cast<vtkIdType>(values.size());
+  const vtkIdType numberOfChunks = (size + PARTIAL_SUM_CHUNK_SIZE - 1) / PARTIAL_SUM_CHUNK_SIZE;
+  if (numberOfChunks <= 1)
+  {
+    std::partial_sum(values.begin(), values.end(), values.begin());
+    return;
+  }
+
+  std::vector<double> offsets(numberOfChunks, 0.0);
+  vtkSMPTools::For(0, numberOfChunks,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType chunk = begin; chunk < end; ++chunk)
+      {
+        const auto first = values.begin() + chunk * PARTIAL_SUM_CHUNK_SIZE;
+        const auto last = values.begin() + std::min(size, (chunk + 1) * PARTIAL_SUM_CHUNK_SIZE);
+        offsets[chunk] = std::accumulate(first, last, 0.0);
+      }
+    });
+  // offsets[chunk] becomes the sum of all the chunks before it.
+  double sum = 0.0;
+  for (double& offset : offsets)
+  {
+    const double chunkSum = offset;
+    offset = sum;
+    sum += chunkSum;
+  }
+  vtkSMPTools::For(0, numberOfChunks,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType chunk = begin; chunk < end; ++chunk)
+      {
+        const auto first = values.begin() + chunk * PARTIAL_SUM_CHUNK_SIZE;
+        const auto last = values.begin() + std::min(size, (chunk + 1) * PARTIAL_SUM_CHUNK_SIZE);
+        *first += offsets[chunk];
+        std::partial_sum(first, last, first);
+      }
+    });
+}
+
+//-----------------------------------------------------------------------------
+// Adds the measure of each cell of `cells`, computed in parallel by
+// `measure(pts)`, to `samplingVector` at the index given by `cellIds`.
+// Measures are added in cell order, as a serial traversal would.
+template <typename MeasureFunctor>
+void vtkPVGlyphFilterAccumulateMeasures(vtkCellArray* cells, vtkIdTypeArray* cellIds,
+  std::vector<double>& samplingVector, MeasureFunctor measure)
+{
+  const vtkIdType numberOfCells = cells->GetNumberOfCells();
+  std::vector<double> measures(numberOfCells);
+  vtkSMPThreadLocalObject<vtkIdList> tlIds;
+  vtkSMPTools::For(0, numberOfCells,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* ids = tlIds.Local();
+      vtkIdType npts;
+      const vtkIdType* pts;
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        cells->GetCellAtId(cellId, npts, pts, ids);
+        measures[cellId] = measure(pts);
+      }
+    });
+  for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    samplingVector[cellIds->GetValue(cellId)] += measures[cellId];
+  }
+}
+}
+
 class vtkPVGlyphFilter::vtkInternals
 {
   vtkDataSet* LastDataSet = nullptr;
@@ -54,7 +142,7 @@ class vtkPVGlyphFilter::vtkInternals
   std::vector<vtkTuple<double, 3>> Points;
   std::vector<vtkIdType> PointIds;
   size_t NextPointId;
-  vtkNew<vtkOctreePointLocator> Locator;
+  vtkNew<vtkStaticPointLocator> Locator;
 
   // Used with SPATIALLY_UNIFORM_INVERSE_TRANSFORM_SAMPLING_*
   std::map<unsigned int, std::vector<double>> UniformSamplingVectorMap;
@@ -127,11 +215,22 @@ public:
       this->Locator->SetDataSet(ds);
       this->Locator->BuildLocator();
 
-      for (auto iter : this->Points)
+      // The static locator is built in parallel and can be queried
+      // concurrently. Each sample point gets its own slot, so the result does
+      // not depend on the number of threads.
+      std::vector<vtkIdType> closestIds(this->Points.size());
+      vtkSMPTools::For(0, static_cast<vtkIdType>(this->Points.size()),
+        [&](vtkIdType begin, vtkIdType end)
+        {
+          for (vtkIdType cc = begin; cc < end; ++cc)
+          {
+            double dist2;
+            closestIds[cc] = this->Locator->FindClosestPointWithinRadius(
+              this->NearestPointRadius, this->Points[cc].GetData(), dist2);
+          }
+        });
+      for (vtkIdType ptId : closestIds)
       {
-        double dist2;
-        vtkIdType ptId = this->Locator->FindClosestPointWithinRadius(
-          this->NearestPointRadius, iter.GetData(), dist2);
         if (ptId >= 0)
         {
           pointIds.insert(ptId);
@@ -288,21 +387,19 @@ public:
             return dataSetToReturn;
           }
 
-          vtkIdType nPts;
-          vtkIdType triangleId = 0;
-          const vtkIdType* pts;
-          for (triangleArray->InitTraversal(); triangleArray->GetNextCell(nPts, pts); triangleId++)
-          {
-            // Compute and stored in the sampling vector the area of each cell
-            double p1[3];
-            double p2[3];
-            double p3[3];
-            trianglePolyData->GetPoint(pts[0], p1);
-            trianglePolyData->GetPoint(pts[1], p2);
-            trianglePolyData->GetPoint(pts[2], p3);
-            uniformSamplingVector[cellIdArray->GetValue(triangleId)] +=
-              vtkTriangle::TriangleArea(p1, p2, p3);
-          }
+          // Compute and stored in the sampling vector the area of each cell
+          vtkPoints* points = trianglePolyData->GetPoints();
+          vtkPVGlyphFilterAccumulateMeasures(triangleArray, cellIdArray, uniformSamplingVector,
+            [points](const vtkIdType* pts)
+            {
+              double p1[3];
+              double p2[3];
+              double p3[3];
+              points->GetPoint(pts[0], p1);
+              points->GetPoint(pts[1], p2);
+              points->GetPoint(pts[2], p3);
+              return vtkTriangle::TriangleArea(p1, p2, p3);
+            });
         }
         else // if (glyphMode ==
         // vtkPVGlyphFilter::SPATIALLY_UNIFORM_INVERSE_TRANSFORM_SAMPLING_VOLUME)
@@ -323,27 +420,24 @@ public:
             return dataSetToReturn;
           }
 
-          vtkIdType nPts;
-          vtkIdType tetraId = 0;
-          const vtkIdType* pts;
-          for (tetraArray->InitTraversal(); tetraArray->GetNextCell(nPts, pts); tetraId++)
-          {
-            // Compute and stored in the sampling vector the volume of each cell
-            double p1[3];
-            double p2[3];
-            double p3[3];
-            double p4[3];
-            tetraUG->GetPoint(pts[0], p1);
-            tetraUG->GetPoint(pts[1], p2);
-            tetraUG->GetPoint(pts[2], p3);
-            tetraUG->GetPoint(pts[3], p4);
-            uniformSamplingVector[cellIdArray->GetValue(tetraId)] +=
-              std::abs(vtkTetra::ComputeVolume(p1, p2, p3, p4));
-          }
+          // Compute and stored in the sampling vector the volume of each cell
+          vtkPoints* points = tetraUG->GetPoints();
+          vtkPVGlyphFilterAccumulateMeasures(tetraArray, cellIdArray, uniformSamplingVector,
+            [points](const vtkIdType* pts)
+            {
+              double p1[3];
+              double p2[3];
+              double p3[3];
+              double p4[3];
+              points->GetPoint(pts[0], p1);
+              points->GetPoint(pts[1], p2);
+              points->GetPoint(pts[2], p3);
+              points->GetPoint(pts[3], p4);
+              return std::abs(vtkTetra::ComputeVolume(p1, p2, p3, p4));
+            });
         }
         // Compute a partial sum on the sampling vector in order to perform sampling later
-        std::partial_sum(uniformSamplingVector.begin(), uniformSamplingVector.end(),
-          uniformSamplingVector.begin());
+        vtkPVGlyphFilterPartialSum(uniformSamplingVector);
         this->SamplingRunningSum += uniformSamplingVector.back();
       }
       break;
@@ -42,6 +42,10 @@
  * In parallel and with composite dataset, this filter ensures that each piece
  * samples only a representative number of points.
  * Note that the grid will be tetrahedralized first.
+ *
+ * The closest point lookups, cell measures and cumulative sums used by the
+ * SPATIALLY_UNIFORM_* modes are computed with vtkSMPTools. The glyphed points
+ * only depend on \c Seed, not on the number of threads.
  */
 
 #ifndef vtkPVGlyphFilter_h
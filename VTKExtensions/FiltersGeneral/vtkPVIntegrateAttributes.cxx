@@ -0,0 +1,329 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVIntegrateAttributes.h"
+
+#include "vtkCellData.h"
+#include "vtkCellIntegrator.h"
+#include "vtkCommunicator.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+//-----------------------------------------------------------------------------
+// Arrays integrated in fast mode: all the named data arrays but the ghost
+// array.
+void vtkCollectIntegratedArrays(
+  vtkDataSetAttributes* attributes, std::vector<vtkDataArray*>& arrays)
+{
+  arrays.clear();
+  for (int i = 0; i < attributes->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = attributes->GetArray(i);
+    if (array && array->GetName() &&
+      strcmp(array->GetName(), vtkDataSetAttributes::GhostArrayName()) != 0)
+    {
+      arrays.push_back(array);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Finds in `attributes` arrays with the same names and number of components
+// as `reference`. Returns false if one is missing.
+bool vtkMatchIntegratedArrays(vtkDataSetAttributes* attributes,
+  const std::vector<vtkDataArray*>& reference, std::vector<vtkDataArray*>& arrays)
+{
+  arrays.clear();
+  for (vtkDataArray* referenceArray : reference)
+  {
+    vtkDataArray* array = attributes->GetArray(referenceArray->GetName());
+    if (!array || array->GetNumberOfComponents() != referenceArray->GetNumberOfComponents())
+    {
+      return false;
+    }
+    arrays.push_back(array);
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void vtkAppendLayout(const std::vector<vtkDataArray*>& arrays, std::string& layout)
+{
+  for (vtkDataArray* array : arrays)
+  {
+    layout += std::string(array->GetName()) + ":" +
+      std::to_string(array->GetNumberOfComponents()) + ";";
+  }
+  layout += "|";
+}
+
+//-----------------------------------------------------------------------------
+// Name and component names of an integrated array, which is all the output
+// needs, so that it can be produced on a process without data.
+struct vtkIntegratedArrayLayout
+{
+  std::string Name;
+  std::vector<std::string> ComponentNames;
+};
+
+//-----------------------------------------------------------------------------
+void vtkDescribeIntegratedArrays(
+  const std::vector<vtkDataArray*>& arrays, std::vector<vtkIntegratedArrayLayout>& layouts)
+{
+  layouts.clear();
+  for (vtkDataArray* array : arrays)
+  {
+    vtkIntegratedArrayLayout layout;
+    layout.Name = array->GetName();
+    for (int k = 0; k < array->GetNumberOfComponents(); ++k)
+    {
+      const char* componentName = array->GetComponentName(k);
+      layout.ComponentNames.emplace_back(componentName ? componentName : "");
+    }
+    layouts.push_back(layout);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkPushIntegratedArrays(
+  vtkMultiProcessStream& stream, const std::vector<vtkIntegratedArrayLayout>& layouts)
+{
+  stream << static_cast<unsigned int>(layouts.size());
+  for (const vtkIntegratedArrayLayout& layout : layouts)
+  {
+    stream << layout.Name << static_cast<unsigned int>(layout.ComponentNames.size());
+    for (const std::string& componentName : layout.ComponentNames)
+    {
+      stream << componentName;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkPopIntegratedArrays(
+  vtkMultiProcessStream& stream, std::vector<vtkIntegratedArrayLayout>& layouts)
+{
+  unsigned int numberOfArrays = 0;
+  stream >> numberOfArrays;
+  layouts.resize(numberOfArrays);
+  for (vtkIntegratedArrayLayout& layout : layouts)
+  {
+    unsigned int numberOfComponents = 0;
+    stream >> layout.Name >> numberOfComponents;
+    layout.ComponentNames.resize(numberOfComponents);
+    for (std::string& componentName : layout.ComponentNames)
+    {
+      stream >> componentName;
+    }
+  }
+}
+}
+
+vtkStandardNewMacro(vtkPVIntegrateAttributes);
+
+//-----------------------------------------------------------------------------
+vtkPVIntegrateAttributes::vtkPVIntegrateAttributes() = default;
+
+//-----------------------------------------------------------------------------
+vtkPVIntegrateAttributes::~vtkPVIntegrateAttributes() = default;
+
+//-----------------------------------------------------------------------------
+int vtkPVIntegrateAttributes::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (this->FastMode &&
+    this->RequestFastData(
+      vtkDataObject::GetData(inputVector[0], 0), vtkUnstructuredGrid::GetData(outputVector, 0)))
+  {
+    return 1;
+  }
+  return this->Superclass::RequestData(request, inputVector, outputVector);
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPVIntegrateAttributes::RequestFastData(vtkDataObject* input, vtkUnstructuredGrid* output)
+{
+  if (!output)
+  {
+    return false;
+  }
+
+  // Only the leaves with cells contribute to the integrals.
+  std::vector<vtkDataSet*> leaves;
+  vtkCellIntegrator::GetLeavesWithCells(input, leaves);
+  const bool hasData = !leaves.empty();
+
+  // The arrays of the first leaf define the layout of the integrals, which
+  // must be the same on all processes that have data.
+  std::vector<vtkDataArray*> pointArrays;
+  std::vector<vtkDataArray*> cellArrays;
+  int dimension = -1;
+  int numberOfSums = 0;
+  std::string layout;
+  if (hasData)
+  {
+    vtkCollectIntegratedArrays(leaves[0]->GetPointData(), pointArrays);
+    vtkCollectIntegratedArrays(leaves[0]->GetCellData(), cellArrays);
+    vtkAppendLayout(pointArrays, layout);
+    vtkAppendLayout(cellArrays, layout);
+    numberOfSums = 4;
+    for (vtkDataArray* array : pointArrays)
+    {
+      numberOfSums += array->GetNumberOfComponents();
+    }
+    for (vtkDataArray* array : cellArrays)
+    {
+      numberOfSums += array->GetNumberOfComponents();
+    }
+    for (vtkDataSet* leaf : leaves)
+    {
+      dimension = std::max(dimension, vtkCellIntegrator::GetMaximumCellDimension(leaf));
+    }
+  }
+
+  vtkMultiProcessController* controller = this->GetController();
+  const bool parallel = controller && controller->GetNumberOfProcesses() > 1;
+  const int rank = parallel ? controller->GetLocalProcessId() : 0;
+  const bool isRoot = rank == 0;
+
+  // Whether the fast mode can be used is decided collectively, from the data
+  // of all the processes. Processes without data learn the dimension and the
+  // number of sums here, and the lowest process with data is the one that
+  // describes the output arrays.
+  int info[3] = { dimension, numberOfSums, hasData ? -rank : -VTK_INT_MAX };
+  bool sameLayout = true;
+  if (parallel)
+  {
+    int localInfo[3] = { info[0], info[1], info[2] };
+    controller->AllReduce(localInfo, info, 3, vtkCommunicator::MAX_OP);
+
+    // The maxima of the hash and of its complement are the max and the min of
+    // the hashes of the processes with data.
+    const unsigned long long hash = std::hash<std::string>{}(layout);
+    unsigned long long localLayout[2] = { hasData ? hash : 0, hasData ? ~hash : 0 };
+    unsigned long long maxLayout[2] = { 0, 0 };
+    controller->AllReduce(localLayout, maxLayout, 2, vtkCommunicator::MAX_OP);
+    sameLayout = maxLayout[0] == ~maxLayout[1];
+  }
+  dimension = info[0];
+  numberOfSums = info[1];
+  const int describingRank = -info[2];
+  if (dimension <= 0 || describingRank == VTK_INT_MAX || !sameLayout)
+  {
+    return false;
+  }
+
+  std::vector<vtkIntegratedArrayLayout> pointLayouts;
+  std::vector<vtkIntegratedArrayLayout> cellLayouts;
+  vtkDescribeIntegratedArrays(pointArrays, pointLayouts);
+  vtkDescribeIntegratedArrays(cellArrays, cellLayouts);
+  if (parallel && describingRank != 0)
+  {
+    vtkMultiProcessStream stream;
+    if (rank == describingRank)
+    {
+      vtkPushIntegratedArrays(stream, pointLayouts);
+      vtkPushIntegratedArrays(stream, cellLayouts);
+    }
+    controller->Broadcast(stream, describingRank);
+    if (isRoot)
+    {
+      vtkPopIntegratedArrays(stream, pointLayouts);
+      vtkPopIntegratedArrays(stream, cellLayouts);
+    }
+  }
+
+  std::vector<double> sums(numberOfSums, 0.0);
+  int supported = 1;
+  std::vector<vtkDataArray*> leafPointArrays;
+  std::vector<vtkDataArray*> leafCellArrays;
+  std::vector<double> leafSums;
+  for (vtkDataSet* leaf : leaves)
+  {
+    if (!vtkMatchIntegratedArrays(leaf->GetPointData(), pointArrays, leafPointArrays) ||
+      !vtkMatchIntegratedArrays(leaf->GetCellData(), cellArrays, leafCellArrays) ||
+      !vtkCellIntegrator::IntegrateCells(
+        leaf, dimension, leafPointArrays, leafCellArrays, leafSums))
+    {
+      supported = 0;
+      break;
+    }
+    std::transform(sums.begin(), sums.end(), leafSums.begin(), sums.begin(), std::plus<double>());
+  }
+  if (parallel)
+  {
+    int localSupported = supported;
+    controller->AllReduce(&localSupported, &supported, 1, vtkCommunicator::MIN_OP);
+  }
+  if (!supported)
+  {
+    return false;
+  }
+  if (parallel)
+  {
+    std::vector<double> localSums(sums);
+    controller->AllReduce(localSums.data(), sums.data(), numberOfSums, vtkCommunicator::SUM_OP);
+  }
+
+  output->Initialize();
+  if (!isRoot)
+  {
+    return true;
+  }
+
+  // A single point, at the centroid of the integrated cells, and a vertex.
+  vtkCellIntegrator::InitializeVertexOutput(output, sums);
+
+  const double total = sums[0];
+  size_t offset = 4;
+  auto addIntegral =
+    [&](vtkDataSetAttributes* attributes, const vtkIntegratedArrayLayout& layout, double scale)
+  {
+    const int numberOfComponents = static_cast<int>(layout.ComponentNames.size());
+    vtkDoubleArray* integral = vtkCellIntegrator::AddIntegral(
+      attributes, layout.Name.c_str(), numberOfComponents, &sums[offset], scale);
+    for (int k = 0; k < numberOfComponents; ++k)
+    {
+      if (!layout.ComponentNames[k].empty())
+      {
+        integral->SetComponentName(k, layout.ComponentNames[k].c_str());
+      }
+    }
+    offset += numberOfComponents;
+  };
+  for (const vtkIntegratedArrayLayout& layout : pointLayouts)
+  {
+    addIntegral(output->GetPointData(), layout, 1.0);
+  }
+  const double cellScale =
+    (this->GetDivideAllCellDataByVolume() && total != 0.0) ? 1.0 / total : 1.0;
+  for (const vtkIntegratedArrayLayout& layout : cellLayouts)
+  {
+    addIntegral(output->GetCellData(), layout, cellScale);
+  }
+
+  vtkCellIntegrator::AddIntegral(output->GetCellData(),
+    dimension == 1 ? "Length" : (dimension == 2 ? "Area" : "Volume"), 1, &total);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVIntegrateAttributes::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "FastMode: " << this->FastMode << endl;
+}
@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVIntegrateAttributes
+ * @brief   vtkIntegrateAttributes with a threaded fast mode.
+ *
+ * vtkPVIntegrateAttributes adds a FastMode to vtkIntegrateAttributes. In fast
+ * mode, the length/area/volume and the point and cell data of the cells of
+ * highest dimension are integrated with vtkCellIntegrator::IntegrateCells(),
+ * which uses exact measures for linear cells, vtkSMPTools and compensated
+ * sums. In parallel, the integrals are then summed with a single AllReduce
+ * instead of gathering the pieces on the root process.
+ *
+ * The output has the same layout as the one of vtkIntegrateAttributes: a
+ * single point, at the centroid of the integrated cells, and a single vertex,
+ * with the integrated point and cell arrays as double arrays and the total
+ * "Length", "Area" or "Volume" as a cell array. It is produced on the first
+ * process only, whether it has data or not.
+ *
+ * Fast mode falls back to vtkIntegrateAttributes, on all processes, when no
+ * process has cells, when a cell of the highest dimension is not a linear
+ * cell supported by vtkCellIntegrator::IntegrateLinearCell(), or when the
+ * pieces do not have the same arrays. This is decided collectively.
+ * Hexahedra, wedges and pyramids with non-planar faces are integrated
+ * exactly, so their volume can differ slightly from the one of
+ * vtkIntegrateAttributes, which splits them into tetrahedra.
+ *
+ * @sa vtkCellIntegrator vtkIntegrateAttributes
+ */
+
+#ifndef vtkPVIntegrateAttributes_h
+#define vtkPVIntegrateAttributes_h
+
+#include "vtkIntegrateAttributes.h"
+#include "vtkPVVTKExtensionsFiltersGeneralModule.h" //needed for exports
+
+class VTKPVVTKEXTENSIONSFILTERSGENERAL_EXPORT vtkPVIntegrateAttributes
+  : public vtkIntegrateAttributes
+{
+public:
+  static vtkPVIntegrateAttributes* New();
+  vtkTypeMacro(vtkPVIntegrateAttributes, vtkIntegrateAttributes);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * When on, the integration uses the threaded vtkCellIntegrator kernels and
+   * a single AllReduce, as described above. The IntegrationStrategy is then
+   * ignored. Default is off.
+   */
+  vtkSetMacro(FastMode, bool);
+  vtkGetMacro(FastMode, bool);
+  vtkBooleanMacro(FastMode, bool);
+  ///@}
+
+protected:
+  vtkPVIntegrateAttributes();
+  ~vtkPVIntegrateAttributes() override;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  /**
+   * Fast mode implementation. Returns false, on all processes, when the
+   * superclass must be used instead.
+   */
+  bool RequestFastData(vtkDataObject* input, vtkUnstructuredGrid* output);
+
+  bool FastMode = false;
+
+private:
+  vtkPVIntegrateAttributes(const vtkPVIntegrateAttributes&) = delete;
+  void operator=(const vtkPVIntegrateAttributes&) = delete;
+};
+
+#endif
@@ -7,24 +7,34 @@
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
 #include "vtkEquivalenceSet.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkIncrementalOctreePointLocator.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkUnsignedCharArray.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <map>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 vtkStandardNewMacro(vtkRectilinearGridConnectivity);
@@ -68,6 +78,13 @@ public:
   std::vector<std::string> VolumeDataAttributeNames;
   std::vector<std::string> IntegrableAttributeNames;
 
+  // Next intra-process inter-block fragment Id and the equivalences found so
+  // far, kept while the blocks are added one by one to the inter-block face
+  // hash. The equivalences are added to the equivalence set in one batch.
+  int NextFragmentId;
+  std::vector<int> EquivalentIds1;
+  std::vector<int> EquivalentIds2;
+
   int IntegrablePointDataArraysAvailable(vtkRectilinearGrid* rectGrid)
   {
     int numArays = static_cast<int>(this->IntegrableAttributeNames.size());
@@ -84,6 +101,24 @@ public:
     return allExist;
   }
 
+  // Records, only once, the number of components of each integrable attribute.
+  void ObtainComponentNumbers(vtkRectilinearGrid* rectGrid)
+  {
+    if (this->ComponentNumbersObtained)
+    {
+      return;
+    }
+
+    this->ComponentNumbersObtained = 1;
+    this->NumberIntegralComponents = 0;
+    for (const std::string& arayName : this->IntegrableAttributeNames)
+    {
+      int numComps = rectGrid->GetPointData()->GetArray(arayName.c_str())->GetNumberOfComponents();
+      this->NumberIntegralComponents += numComps;
+      this->ComponentNumbersPerArray.push_back(numComps);
+    }
+  }
+
   int IntegrableCellDataArraysAvailable(vtkPolyData* polyData)
   {
     int numArays = static_cast<int>(this->IntegrableAttributeNames.size());
@@ -116,367 +151,350 @@ public:
                        // global index of the face / polygon in a vtkPolyData
 
   // three smallest global point-Ids are used for a unique representation of a
-  // polygon (triangle, quad, or pentagon) and the first one is actually the
-  // index of the entry in the face hash
+  // polygon (triangle, quad, or pentagon). The first one also tells whether
+  // the slot of the hash holding the face is free or being claimed.
+  std::atomic<vtkIdType> PointId1{ -1 };
   vtkIdType PointId2;
   vtkIdType PointId3;
 
-  vtkRectilinearGridConnectivityFace* NextFace; // next face in a linked list
+  // the order in which the face has been added to the hash, -1 if the face
+  // is not in the hash (never added, or removed as an internal face)
+  vtkIdType Sequence;
 };
 
 //============================================================================
 
-class vtkRectilinearGridConnectivityFaceHeap
-{
-public:
-  vtkRectilinearGridConnectivityFaceHeap();
-  ~vtkRectilinearGridConnectivityFaceHeap();
-
-  vtkRectilinearGridConnectivityFace* NewFace();
-
-  // The face is valid until NewFace is called or the heap destructs.
-  void RecycleFace(vtkRectilinearGridConnectivityFace* face);
-
-private:
-  int HeapLength;
-  int NextFaceIndex; // Which heap face is next in line.
-
-  // Hard code the allocation size.
-  // We could do fancy doubling, but why bother.
-  // The cost of allocating another chink is small because
-  // we do not copy.
-  int NumberOfFacesPerAllocation;
-
-  // Ivars that allow fast allocation of face objects.
-  // They are allocated a few hundred at a time, and reused.
-  vtkRectilinearGridConnectivityFace* Heap;
-  vtkRectilinearGridConnectivityFace* RecycleBin;
-
-  // The faces are allocated in arrays/heaps, so they need to be
-  // deleted in arrays.  The first face from every array is reserved
-  // and saved in a linked list so we can delete the arrays later.
-  vtkRectilinearGridConnectivityFace* Heaps;
-
-  void Allocate();
-};
-
-vtkRectilinearGridConnectivityFaceHeap::vtkRectilinearGridConnectivityFaceHeap()
-{
-  this->Heap = nullptr;
-  this->Heaps = nullptr;
-  this->HeapLength = 0;
-  this->RecycleBin = nullptr;
-  this->NextFaceIndex = 0;
-  this->NumberOfFacesPerAllocation = 1000;
-}
-
-vtkRectilinearGridConnectivityFaceHeap::~vtkRectilinearGridConnectivityFaceHeap()
-{
-  this->RecycleBin = nullptr;
-  this->NumberOfFacesPerAllocation = 0;
-
-  while (this->Heaps)
-  {
-    vtkRectilinearGridConnectivityFace* next = this->Heaps->NextFace;
-    delete[] this->Heaps;
-    this->Heaps = next;
-  }
-}
-
-void vtkRectilinearGridConnectivityFaceHeap::Allocate()
-{
-  vtkRectilinearGridConnectivityFace* newHeap =
-    new vtkRectilinearGridConnectivityFace[this->NumberOfFacesPerAllocation];
-
-  // use the first element to construct a linked list of arrays/heaps
-  newHeap[0].NextFace = this->Heaps;
-  this->Heaps = newHeap;
-
-  this->HeapLength = this->NumberOfFacesPerAllocation;
-  this->NextFaceIndex = 1; // skip the first (used for the Heaps linked list)
-  this->Heap = newHeap;
-}
-
-// The face will be valid until NewFace is called or the heap destructs.
-void vtkRectilinearGridConnectivityFaceHeap::RecycleFace(vtkRectilinearGridConnectivityFace* face)
-{
-  face->NextFace = this->RecycleBin;
-  this->RecycleBin = face;
-}
-
-vtkRectilinearGridConnectivityFace* vtkRectilinearGridConnectivityFaceHeap::NewFace()
-{
-  vtkRectilinearGridConnectivityFace* face = nullptr;
-
-  // look for faces to use in the recycle bin
-  if (this->RecycleBin)
-  {
-    face = this->RecycleBin;
-    this->RecycleBin = face->NextFace;
-    face->NextFace = nullptr;
-  }
-  else
-  {
-    // nothing to recycle --> get a face from the heap
-    if (this->NextFaceIndex >= this->HeapLength)
-    {
-      // we need to allocate another heap
-      this->Allocate();
-    }
-
-    face = this->Heap + this->NextFaceIndex++;
-  }
-
-  face->PointId2 = 0;
-  face->PointId3 = 0;
-
-  // we only need one cell id, because we delete from the hash
-  // any face with two cells because it is internal
-  face->BlockId = 0;
-  face->NextFace = nullptr;
-  face->PolygonId = 0;
-  face->FragmentId = 0;
-
-  return face;
-}
-
-//============================================================================
-
+// An open-addressing hash of faces keyed by their three smallest point Ids.
+// The slots of the faces of a vtkPolyData are found, or claimed, concurrently
+// by InsertFaces(). AddFace() then adds or removes the face of a slot, in the
+// order the polygons are pushed, which is what assigns the fragment Ids.
 class vtkRectilinearGridConnectivityFaceHash
 {
 public:
   vtkRectilinearGridConnectivityFaceHash();
-  ~vtkRectilinearGridConnectivityFaceHash();
 
   // Returns the number of faces in the hash (faces returned by iteration).
   vtkIdType GetNumberOfFaces() { return this->NumberOfFaces; }
 
-  // Creates a hash that expects at most "numberOfPoint" points as indexes
-  void Initialize(vtkIdType numberOfPoints);
-
-  // These methods ass a face to the hash.  The four point method is for
-  // convenience. The points do not need to be sorted. If this is a new face,
-  // this method constructs the object and adds it to the hash. The cell id is
-  // set and the face is returned. If this face is already in the hash, the
-  // object is removed from the hash and is returned.  The face is automatically
-  // recycled, but is valid until this method is called again.
-  // Note: I will assume that the ptIds are unique (i.e. pt1 != pt2 ...)
-  vtkRectilinearGridConnectivityFace* AddFace(vtkIdType pt1, vtkIdType pt2, vtkIdType pt3);
-  vtkRectilinearGridConnectivityFace* AddFace(
-    vtkIdType pt1, vtkIdType pt2, vtkIdType pt3, vtkIdType pt4);
-  vtkRectilinearGridConnectivityFace* AddFace(
-    vtkIdType pt1, vtkIdType pt2, vtkIdType pt3, vtkIdType pt4, vtkIdType pt5);
-
-  // A way to iterate over the faces in the hash.
+  // Creates a hash that expects at most "numberOfFaces" different faces. The
+  // hash grows if more faces are inserted.
+  void Initialize(vtkIdType numberOfFaces);
+
+  // Finds or claims, concurrently, the slot of each polygon of the vtkPolyData
+  // and returns it in "slots" (-1 for a polygon that is not a triangle, a
+  // quad, or a pentagon). Polygon point Ids are mapped through "pointIdMap"
+  // unless it is nullptr. The faces are not added to the hash.
+  void InsertFaces(
+    vtkPolyData* plyData, const vtkIdType* pointIdMap, std::vector<vtkIdType>& slots);
+
+  // Adds the face of a slot returned by InsertFaces() to the hash and returns
+  // it. If the face is already in the hash, it is removed from the hash and
+  // returned as is, and stays valid until InsertFaces() is called again.
+  vtkRectilinearGridConnectivityFace* AddFace(vtkIdType slot);
+
+  // Returns the face with the given polygon point Ids if it is in the hash,
+  // nullptr otherwise.
+  vtkRectilinearGridConnectivityFace* FindFace(
+    vtkIdType numbPnts, const vtkIdType* ptIds, const vtkIdType* pointIdMap);
+
+  // A way to iterate over the faces in the hash. The faces are visited by
+  // increasing smallest point Id, then in the order they have been added.
   void InitTraversal();
   vtkRectilinearGridConnectivityFace* GetNextFace();
 
-  // Since the face does not store the first point id explicitley,
-  // this returns the id from the iterator state.
-  vtkIdType GetFirstPointIndex() { return this->IteratorIndex; }
-
 private:
+  // Computes the key of a polygon: its three smallest (mapped) point Ids in
+  // increasing order. Returns false unless the polygon has 3, 4, or 5 points.
+  static bool GetFaceKey(
+    vtkIdType numbPnts, const vtkIdType* ptIds, const vtkIdType* pointIdMap, vtkIdType key[3]);
+
+  vtkIdType GetFirstSlot(const vtkIdType key[3]) const;
+
+  // Returns the slot holding the key, claiming a free one if needed. "claimed"
+  // is set to true if a free slot has been claimed. Thread safe.
+  vtkIdType ClaimSlot(const vtkIdType key[3], bool& claimed);
+
+  // Makes room for "numberOfNewFaces" more faces, rehashing the faces into a
+  // larger table if needed. Faces that are not in the hash are dropped then.
+  void Reserve(vtkIdType numberOfNewFaces);
+
   // Keep track of the number of faces in the hash for convenience.
   // The user does not need to iterate over all faces to count them.
   vtkIdType NumberOfFaces;
 
-  // Array indexed by faces smallest corner id.
-  // Each element is a linked list of faces that share the point.
-  vtkIdType NumberOfPoints;
-  vtkRectilinearGridConnectivityFace** Hash;
+  // Number of slots claimed by a face, whether it is in the hash or not.
+  vtkIdType NumberOfUsedSlots;
+  vtkIdType NextSequence;
 
-  // Allocates faces efficiently.
-  vtkRectilinearGridConnectivityFaceHeap* Heap;
+  vtkIdType Capacity; // a power of 2
+  std::unique_ptr<vtkRectilinearGridConnectivityFace[]> Slots;
 
-  // This class is too simple and internal for a separate iterator object.
+  std::vector<vtkIdType> Traversal;
   vtkIdType IteratorIndex;
-  vtkRectilinearGridConnectivityFace* IteratorCurrent;
 };
 
 vtkRectilinearGridConnectivityFaceHash::vtkRectilinearGridConnectivityFaceHash()
 {
-  this->Hash = nullptr;
-  this->Heap = new vtkRectilinearGridConnectivityFaceHeap;
-
-  this->NumberOfPoints = 0;
   this->NumberOfFaces = 0;
+  this->NumberOfUsedSlots = 0;
+  this->NextSequence = 0;
+  this->Capacity = 0;
   this->IteratorIndex = -1;
-  this->IteratorCurrent = nullptr;
 }
 
-vtkRectilinearGridConnectivityFaceHash::~vtkRectilinearGridConnectivityFaceHash()
+bool vtkRectilinearGridConnectivityFaceHash::GetFaceKey(
+  vtkIdType numbPnts, const vtkIdType* ptIds, const vtkIdType* pointIdMap, vtkIdType key[3])
 {
-  if (this->Hash)
+  if (numbPnts < 3 || numbPnts > 5)
   {
-    delete[] this->Hash;
-    this->Hash = nullptr;
+    return false;
   }
 
-  delete this->Heap;
-  this->Heap = nullptr;
-
-  this->IteratorIndex = 0;
-  this->IteratorCurrent = nullptr;
-  this->NumberOfFaces = 0;
+  vtkIdType pntIndxs[5];
+  for (vtkIdType i = 0; i < numbPnts; i++)
+  {
+    pntIndxs[i] = pointIdMap ? pointIdMap[ptIds[i]] : ptIds[i];
+  }
+  std::partial_sort(pntIndxs, pntIndxs + 3, pntIndxs + numbPnts);
+  key[0] = pntIndxs[0];
+  key[1] = pntIndxs[1];
+  key[2] = pntIndxs[2];
+  return true;
 }
 
-void vtkRectilinearGridConnectivityFaceHash::InitTraversal()
+vtkIdType vtkRectilinearGridConnectivityFaceHash::GetFirstSlot(const vtkIdType key[3]) const
 {
-  // I had a decision: current points to the last or next face.
-  // I chose last because it simplifies InitTraveral.
-  // I just initialize the IteratorIndex as -1 (special value).
-  // This assume that vtkIdType is signed!
-  this->IteratorIndex = -1;
-  this->IteratorCurrent = nullptr;
+  vtkTypeUInt64 hash = static_cast<vtkTypeUInt64>(key[0]) * 0x9E3779B97F4A7C15ULL;
+  hash ^= static_cast<vtkTypeUInt64>(key[1]) * 0xC2B2AE3D27D4EB4FULL;
+  hash ^= static_cast<vtkTypeUInt64>(key[2]) * 0x165667B19E3779F9ULL;
+  hash ^= hash >> 29;
+  return static_cast<vtkIdType>(hash & static_cast<vtkTypeUInt64>(this->Capacity - 1));
 }
 
-vtkRectilinearGridConnectivityFace* vtkRectilinearGridConnectivityFaceHash::GetNextFace()
+vtkIdType vtkRectilinearGridConnectivityFaceHash::ClaimSlot(const vtkIdType key[3], bool& claimed)
 {
-  if (this->IteratorIndex >= this->NumberOfPoints)
+  // PointId1 is -1 for a free slot and -2 while the thread that claimed the
+  // slot writes the key. It is set to the first point Id once the key is set.
+  claimed = false;
+  vtkIdType slot = this->GetFirstSlot(key);
+  for (;;)
   {
-    // past the end of the hash --- it has not been initialized.
-    return nullptr;
-  }
+    vtkRectilinearGridConnectivityFace* face = this->Slots.get() + slot;
+    vtkIdType pointId1 = face->PointId1.load(std::memory_order_acquire);
+    if (pointId1 == -1)
+    {
+      if (face->PointId1.compare_exchange_strong(pointId1, -2, std::memory_order_acq_rel))
+      {
+        face->PointId2 = key[1];
+        face->PointId3 = key[2];
+        face->Sequence = -1;
+        face->PointId1.store(key[0], std::memory_order_release);
+        claimed = true;
+        return slot;
+      }
+    }
 
-  // traverse the linked list.
-  if (this->IteratorCurrent)
-  {
-    this->IteratorCurrent = this->IteratorCurrent->NextFace;
-  }
+    while (pointId1 == -2)
+    {
+      std::this_thread::yield();
+      pointId1 = face->PointId1.load(std::memory_order_acquire);
+    }
 
-  // move through heap to find the next linked list if we hit the end of
-  // the current linked list,
-  while (this->IteratorCurrent == nullptr)
-  {
-    this->IteratorIndex++;
-    if (this->IteratorIndex >= this->NumberOfPoints)
+    if (pointId1 == key[0] && face->PointId2 == key[1] && face->PointId3 == key[2])
     {
-      return nullptr;
+      return slot;
     }
+    slot = (slot + 1) & (this->Capacity - 1);
+  }
+}
 
-    this->IteratorCurrent = this->Hash[this->IteratorIndex];
+void vtkRectilinearGridConnectivityFaceHash::Initialize(vtkIdType numberOfFaces)
+{
+  // keep the load factor under 3/4
+  vtkIdType capacity = 16;
+  while (capacity * 3 < numberOfFaces * 4)
+  {
+    capacity <<= 1;
   }
 
-  return this->IteratorCurrent;
+  this->Slots.reset(new vtkRectilinearGridConnectivityFace[capacity]);
+  this->Capacity = capacity;
+  this->NumberOfFaces = 0;
+  this->NumberOfUsedSlots = 0;
+  this->NextSequence = 0;
+  this->Traversal.clear();
+  this->IteratorIndex = -1;
 }
 
-void vtkRectilinearGridConnectivityFaceHash::Initialize(vtkIdType numberOfPoints)
+void vtkRectilinearGridConnectivityFaceHash::Reserve(vtkIdType numberOfNewFaces)
 {
-  if (this->Hash)
+  if ((this->NumberOfUsedSlots + numberOfNewFaces) * 4 <= this->Capacity * 3)
   {
-    vtkGenericWarningMacro("You can only initialize once.\n");
     return;
   }
 
-  this->Hash = new vtkRectilinearGridConnectivityFace*[numberOfPoints];
-  this->NumberOfPoints = numberOfPoints;
+  // Only the faces still in the hash are kept. A face removed from the hash
+  // that is added again gets a new slot, exactly as a face never seen before.
+  std::unique_ptr<vtkRectilinearGridConnectivityFace[]> oldSlots = std::move(this->Slots);
+  vtkIdType oldCapacity = this->Capacity;
+  vtkIdType numFaces = this->NumberOfFaces;
+  vtkIdType nextSequence = this->NextSequence;
+  this->Initialize(numFaces + numberOfNewFaces);
+  this->NumberOfFaces = numFaces;
+  this->NumberOfUsedSlots = numFaces;
+  this->NextSequence = nextSequence;
+
+  vtkSMPTools::For(0, oldCapacity,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      bool claimed;
+      for (vtkIdType oldSlot = begin; oldSlot < end; oldSlot++)
+      {
+        const vtkRectilinearGridConnectivityFace& oldFace = oldSlots[oldSlot];
+        if (oldFace.PointId1.load(std::memory_order_relaxed) < 0 || oldFace.Sequence < 0)
+        {
+          continue;
+        }
 
-  memset(this->Hash, 0, sizeof(vtkRectilinearGridConnectivityFace*) * numberOfPoints);
+        vtkIdType key[3] = { oldFace.PointId1.load(std::memory_order_relaxed), oldFace.PointId2,
+          oldFace.PointId3 };
+        vtkRectilinearGridConnectivityFace* face =
+          this->Slots.get() + this->ClaimSlot(key, claimed);
+        face->BlockId = oldFace.BlockId;
+        face->FragmentId = oldFace.FragmentId;
+        face->ProcessId = oldFace.ProcessId;
+        face->PolygonId = oldFace.PolygonId;
+        face->Sequence = oldFace.Sequence;
+      }
+    });
 }
 
-vtkRectilinearGridConnectivityFace* vtkRectilinearGridConnectivityFaceHash::AddFace(
-  vtkIdType pt1, vtkIdType pt2, vtkIdType pt3)
+void vtkRectilinearGridConnectivityFaceHash::InsertFaces(
+  vtkPolyData* plyData, const vtkIdType* pointIdMap, std::vector<vtkIdType>& slots)
 {
-  // Sort the three ids. Assume the three ids are unique (actually not)
-  vtkIdType tmp;
-  if (pt2 < pt1)
-  {
-    tmp = pt1;
-    pt1 = pt2;
-    pt2 = tmp;
-  }
+  vtkIdType numFaces = plyData->GetNumberOfCells();
+  slots.resize(numFaces);
+  this->Reserve(numFaces);
+
+  vtkCellArray* polygons = plyData->GetPolys();
+  vtkSMPThreadLocalObject<vtkIdList> tlPtIds;
+  vtkSMPThreadLocal<vtkIdType> tlClaimed(0);
+  vtkSMPTools::For(0, numFaces,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* ptIdList = tlPtIds.Local();
+      vtkIdType& numClaimed = tlClaimed.Local();
+      vtkIdType numbPnts;
+      const vtkIdType* ptIds;
+      vtkIdType key[3];
+      bool claimed;
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        polygons->GetCellAtId(i, numbPnts, ptIds, ptIdList);
+        if (!vtkRectilinearGridConnectivityFaceHash::GetFaceKey(numbPnts, ptIds, pointIdMap, key))
+        {
+          slots[i] = -1;
+          continue;
+        }
+        slots[i] = this->ClaimSlot(key, claimed);
+        numClaimed += claimed ? 1 : 0;
+      }
+    });
 
-  if (pt3 < pt1)
+  for (vtkIdType numClaimed : tlClaimed)
   {
-    tmp = pt1;
-    pt1 = pt3;
-    pt3 = tmp;
+    this->NumberOfUsedSlots += numClaimed;
   }
+}
 
-  if (pt3 < pt2)
+vtkRectilinearGridConnectivityFace* vtkRectilinearGridConnectivityFaceHash::AddFace(
+  vtkIdType slot)
+{
+  if (slot < 0)
   {
-    tmp = pt2;
-    pt2 = pt3;
-    pt3 = tmp;
+    return nullptr;
   }
 
-  // Note: we do not check if the point index is out of bounds.
-
-  // look for the face in the hash and keep old reference for editing
-  vtkRectilinearGridConnectivityFace** ref = this->Hash + pt1;
-  vtkRectilinearGridConnectivityFace* face = *ref;
-  while (face)
+  vtkRectilinearGridConnectivityFace* face = this->Slots.get() + slot;
+  if (face->Sequence >= 0)
   {
-    if (face->PointId2 == pt2 && face->PointId3 == pt3)
-    {
-      // find the face and remove it from the hash
-      *ref = face->NextFace;
-      face->NextFace = nullptr;
-      this->Heap->RecycleFace(face);
-      this->NumberOfFaces--;
-
-      // the face will still be valid until the next cycle.
-      return face;
-    }
-    ref = &face->NextFace;
-    face = face->NextFace;
+    // find the face and remove it from the hash
+    face->Sequence = -1;
+    this->NumberOfFaces--;
+    return face;
   }
-  // this is a new face.
-  face = this->Heap->NewFace();
-  face->PointId2 = pt2;
-  face->PointId3 = pt3;
 
-  // add the face to the hash.
-  *ref = face;
+  // this is a new face
+  face->Sequence = this->NextSequence++;
+  face->BlockId = 0;
+  face->PolygonId = 0;
+  face->FragmentId = 0;
+  face->ProcessId = 0;
   this->NumberOfFaces++;
 
   return face;
 }
 
-vtkRectilinearGridConnectivityFace* vtkRectilinearGridConnectivityFaceHash::AddFace(
-  vtkIdType pt1, vtkIdType pt2, vtkIdType pt3, vtkIdType pt4)
+vtkRectilinearGridConnectivityFace* vtkRectilinearGridConnectivityFaceHash::FindFace(
+  vtkIdType numbPnts, const vtkIdType* ptIds, const vtkIdType* pointIdMap)
 {
-  // we just need to find the three smallest point ids
-  if (pt1 > pt2 && pt1 > pt3 && pt1 > pt4)
+  vtkIdType key[3];
+  if (!vtkRectilinearGridConnectivityFaceHash::GetFaceKey(numbPnts, ptIds, pointIdMap, key))
   {
-    // NOLINTNEXTLINE(readability-suspicious-call-argument)
-    return this->AddFace(pt2, pt3, pt4);
+    return nullptr;
   }
 
-  if (pt2 > pt3 && pt2 > pt4)
+  for (vtkIdType slot = this->GetFirstSlot(key);; slot = (slot + 1) & (this->Capacity - 1))
   {
-    // NOLINTNEXTLINE(readability-suspicious-call-argument)
-    return this->AddFace(pt1, pt3, pt4);
+    vtkRectilinearGridConnectivityFace* face = this->Slots.get() + slot;
+    vtkIdType pointId1 = face->PointId1.load(std::memory_order_relaxed);
+    if (pointId1 == -1)
+    {
+      return nullptr;
+    }
+    if (pointId1 == key[0] && face->PointId2 == key[1] && face->PointId3 == key[2])
+    {
+      return (face->Sequence >= 0) ? face : nullptr;
+    }
   }
+}
 
-  if (pt3 > pt4)
+void vtkRectilinearGridConnectivityFaceHash::InitTraversal()
+{
+  // This is the order in which the former hash (an array of linked lists
+  // indexed by the smallest point Id, new faces being appended to the lists)
+  // returned the faces, which determines the order of the output polygons.
+  this->Traversal.clear();
+  this->Traversal.reserve(this->NumberOfFaces);
+  for (vtkIdType slot = 0; slot < this->Capacity; slot++)
   {
-    return this->AddFace(pt1, pt2, pt4);
+    if (this->Slots[slot].PointId1.load(std::memory_order_relaxed) >= 0 &&
+      this->Slots[slot].Sequence >= 0)
+    {
+      this->Traversal.push_back(slot);
+    }
   }
 
-  return this->AddFace(pt1, pt2, pt3);
+  const vtkRectilinearGridConnectivityFace* faces = this->Slots.get();
+  vtkSMPTools::Sort(this->Traversal.begin(), this->Traversal.end(),
+    [faces](vtkIdType slot1, vtkIdType slot2)
+    {
+      vtkIdType pointId1 = faces[slot1].PointId1.load(std::memory_order_relaxed);
+      vtkIdType pointId2 = faces[slot2].PointId1.load(std::memory_order_relaxed);
+      return pointId1 < pointId2 ||
+        (pointId1 == pointId2 && faces[slot1].Sequence < faces[slot2].Sequence);
+    });
+  this->IteratorIndex = -1;
 }
 
-vtkRectilinearGridConnectivityFace* vtkRectilinearGridConnectivityFaceHash::AddFace(
-  vtkIdType pt1, vtkIdType pt2, vtkIdType pt3, vtkIdType pt4, vtkIdType pt5)
+vtkRectilinearGridConnectivityFace* vtkRectilinearGridConnectivityFaceHash::GetNextFace()
 {
-  vtkIdType tempIndx;
-  vtkIdType pntIndxs[5] = { pt1, pt2, pt3, pt4, pt5 };
-
-  // determine the two largest point Ids
-  for (int j = 0; j < 2; j++)
-    for (int i = j + 1; i < 5; i++)
-    {
-      if (pntIndxs[i] > pntIndxs[j])
-      {
-        tempIndx = pntIndxs[i];
-        pntIndxs[i] = pntIndxs[j];
-        pntIndxs[j] = tempIndx;
-      }
-    }
-
-  // but submit the three smallest point Ids
-  return this->AddFace(pntIndxs[2], pntIndxs[3], pntIndxs[4]);
+  this->IteratorIndex++;
+  if (this->IteratorIndex >= static_cast<vtkIdType>(this->Traversal.size()))
+  {
+    return nullptr;
+  }
+  return this->Slots.get() + this->Traversal[this->IteratorIndex];
 }
 
 // ============================================================================
@@ -507,8 +525,10 @@ vtkRectilinearGridConnectivity::vtkRectilinearGridConnectivity()
   this->Internal->VolumeDataAttributeNames.clear();
   this->Internal->IntegrableAttributeNames.clear();
   this->Internal->VolumeFractionValueScale = 255.0;
+  this->Internal->NextFragmentId = 1;
 
   this->VolumeFractionSurfaceValue = 128.0 / 255.0;
+  this->StreamBlocks = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -751,6 +771,7 @@ void vtkRectilinearGridConnectivity::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 
   os << indent << "Volume Fraction Surface Value: " << this->VolumeFractionSurfaceValue << "\n";
+  os << indent << "Stream Blocks: " << this->StreamBlocks << "\n";
   os << indent << "Dual Grids Ready: " << this->DualGridsReady << "\n";
   os << indent << "Number of Blocks: " << this->NumberOfBlocks << "\n";
   os << indent << "Data Blocks Time: " << this->DataBlocksTime << "\n";
@@ -1167,7 +1188,6 @@ void vtkRectilinearGridConnectivity::ExtractFragments(vtkRectilinearGrid** dualG
   int i;
   int* maxFsize = nullptr;
   vtkPolyData** surfaces = nullptr;
-  vtkPolyData* plyHedra = nullptr;
   vtkPoints* mbPoints = nullptr;
   vtkIncrementalOctreePointLocator* mbPntLoc = nullptr;
 
@@ -1180,24 +1200,120 @@ void vtkRectilinearGridConnectivity::ExtractFragments(vtkRectilinearGrid** dualG
   // than-isovalue sub-volumes (polyhedra in the form of vtkPolyData) on a
   // per-cube basis and write the result to the corresponding vtkPolyData.
 
+  // The blocks are processed one at a time, in block order, because the
+  // global point locator assigns the global point Ids in that order. Marching
+  // cubes runs concurrently on the slabs of a block and the polyhedra of a
+  // block are freed as soon as they are resolved through the intra-block face
+  // hash, so only the polyhedra of one block are kept in memory.
+  const char* fracName = this->GetVolumeFractionArrayName(partIndx);
+  double isoValue = this->VolumeFractionSurfaceValue * this->Internal->VolumeFractionValueScale;
+
+  // record the number of integrated components before the slabs are processed
+  // concurrently, from the first block that has the integrable arrays
+  for (i = 0; i < numBlcks; i++)
+  {
+    if (this->Internal->IntegrablePointDataArraysAvailable(dualGrds[i]))
+    {
+      this->Internal->ObtainComponentNumbers(dualGrds[i]);
+      break;
+    }
+  }
+
+  // In streaming mode, the polygons of a block are pushed to the inter-block
+  // face hash as soon as the block is resolved. Once all the blocks that a
+  // block touches (lastTouch) have been pushed, the polygons of the block that
+  // are no longer in the face hash are shared with another block and freed.
+  std::vector<int> lastTouch;
+  std::vector<std::vector<int>> completed;
+  vtkRectilinearGridConnectivityFaceHash* blockHash = nullptr;
+  vtkEquivalenceSet* blockEquivalences = nullptr;
+  vtkDoubleArray* blockValues = nullptr;
+  if (this->StreamBlocks)
+  {
+    const double tolerance = 0.0001; // that of the global point locator
+    std::vector<std::array<double, 6>> blockBounds(numBlcks);
+    for (i = 0; i < numBlcks; i++)
+    {
+      dualGrds[i]->GetBounds(blockBounds[i].data());
+    }
+    lastTouch.resize(numBlcks);
+    completed.resize(numBlcks);
+    for (i = 0; i < numBlcks; i++)
+    {
+      lastTouch[i] = i;
+      for (int t = i + 1; t < numBlcks; t++)
+      {
+        bool touches = true;
+        for (int d = 0; d < 3 && touches; d++)
+        {
+          touches = blockBounds[t][2 * d] <= blockBounds[i][2 * d + 1] + tolerance &&
+            blockBounds[i][2 * d] <= blockBounds[t][2 * d + 1] + tolerance;
+        }
+        lastTouch[i] = touches ? t : lastTouch[i];
+      }
+      completed[lastTouch[i]].push_back(i);
+    }
+  }
+
+  // The equivalenceSet keeps track of fragment ids and determines which
+  // fragment ids need to be combined into a single fragment.
+  auto initializeInterBlockResolution = [this]()
+  {
+    if (this->EquivalenceSet)
+    {
+      this->EquivalenceSet->Delete();
+      this->EquivalenceSet = nullptr;
+    }
+    this->EquivalenceSet = vtkEquivalenceSet::New();
+
+    // Allocate a vtkDoubleArray to maintain the attributes of each fragment
+    if (this->FragmentValues)
+    {
+      this->FragmentValues->Delete();
+      this->FragmentValues = nullptr;
+    }
+    this->FragmentValues = vtkDoubleArray::New();
+    this->FragmentValues->SetNumberOfComponents(
+      this->Internal->NumberIntegralComponents + 1); // material volume
+
+    this->Internal->NextFragmentId = 1;
+    this->Internal->EquivalentIds1.clear();
+    this->Internal->EquivalentIds2.clear();
+  };
+
+  // ExtractFragmentPolygons() resolves a block with its own face hash,
+  // equivalence set, and fragment attributes, so in streaming mode those of
+  // the inter-block resolution are set aside meanwhile.
+  auto swapResolution = [&]()
+  {
+    std::swap(this->FaceHash, blockHash);
+    std::swap(this->EquivalenceSet, blockEquivalences);
+    std::swap(this->FragmentValues, blockValues);
+  };
+
   maxFsize = new int[numBlcks];
   surfaces = new vtkPolyData*[numBlcks];
-  for (i = 0; i < numBlcks; i++)
+  if (this->StreamBlocks)
   {
-    plyHedra = vtkPolyData::New();
-    surfaces[i] = vtkPolyData::New();
+    // an empty face hash, growing as the blocks are pushed
+    initializeInterBlockResolution();
+    this->InitializeFaceHash(surfaces, 0);
+  }
 
-    // perform marching cubes on the dual grid to obtain the greater-than-
+  for (i = 0; i < numBlcks; i++)
+  {
+    // perform marching cubes on the dual grids to obtain the greater-than-
     // isovalue polyhedra, of which each 2D polygon is assigned with a global
     // volume Id
-    this->ExtractFragmentPolyhedra(dualGrds[i], this->GetVolumeFractionArrayName(partIndx),
-      this->VolumeFractionSurfaceValue * this->Internal->VolumeFractionValueScale, plyHedra);
+    vtkPolyData* plyHedra = vtkPolyData::New();
+    this->ExtractFragmentPolyhedra(dualGrds[i], fracName, isoValue, plyHedra);
+    surfaces[i] = vtkPolyData::New();
 
     // # clear and re-init EquivalenceSet
-    // # clear and re-init the face hash with the number of points contained
+    // # clear and re-init the face hash with the number of polygons contained
     //   in the polyhedra
     // # add each face of the polyhedra to the face hash, with the block-based
-    //   local point Id as the face hash entry / index, assign it with the face
+    //   local point Ids as the face hash key, assign it with the face
     //   index (in the polyhedra, via PolygonId) for late access to the original
     //   2D polygon in the polyhedra, and assign it with the volume index (in
     //   the polyhedra, via VolumeId)
@@ -1208,33 +1324,52 @@ void vtkRectilinearGridConnectivity::ExtractFragments(vtkRectilinearGrid** dualG
     //   the original 2D polygon in the polyhedra, insert it to the output
     //   vtkPolyData. The points are also inserted to the output polygon and
     //   a global Id is assigned to each point as the point data attribute
+    if (this->StreamBlocks)
+    {
+      swapResolution();
+    }
     this->ExtractFragmentPolygons(i, maxFsize[i], plyHedra, surfaces[i], mbPntLoc);
-
     plyHedra->Delete();
     plyHedra = nullptr;
+
+    if (this->StreamBlocks)
+    {
+      swapResolution();
+      delete blockHash;
+      blockHash = nullptr;
+      this->AddSurfaceToFaceHash(i, surfaces[i], maxFsize[i]);
+      for (int blockIdx : completed[i])
+      {
+        this->RemoveInternalPolygons(blockIdx, surfaces[blockIdx]);
+      }
+    }
   }
 
-  // The equivalenceSet keeps track of fragment ids and determines which
-  // fragment ids need to be combined into a single fragment.
-  if (this->EquivalenceSet)
+  if (this->StreamBlocks)
   {
-    this->EquivalenceSet->Delete();
-    this->EquivalenceSet = nullptr;
+    if (blockEquivalences)
+    {
+      blockEquivalences->Delete();
+    }
+    if (blockValues)
+    {
+      blockValues->Delete();
+    }
+    blockEquivalences = nullptr;
+    blockValues = nullptr;
+
+    this->EquivalenceSet->AddEquivalences(this->Internal->EquivalentIds1.data(),
+      this->Internal->EquivalentIds2.data(),
+      static_cast<vtkIdType>(this->Internal->EquivalentIds1.size()));
+    this->Internal->EquivalentIds1.clear();
+    this->Internal->EquivalentIds2.clear();
   }
-  this->EquivalenceSet = vtkEquivalenceSet::New();
-
-  // Allocate a vtkDoubleArray to maintain the attributes of each fragment
-  if (this->FragmentValues)
+  else
   {
-    this->FragmentValues->Delete();
-    this->FragmentValues = nullptr;
+    initializeInterBlockResolution();
+    this->InitializeFaceHash(surfaces, numBlcks);
+    this->AddPolygonsToFaceHash(surfaces, maxFsize, numBlcks);
   }
-  this->FragmentValues = vtkDoubleArray::New();
-  this->FragmentValues->SetNumberOfComponents(
-    this->Internal->NumberIntegralComponents + 1); // material volume
-
-  this->InitializeFaceHash(surfaces, numBlcks);
-  this->AddPolygonsToFaceHash(surfaces, maxFsize, numBlcks);
   this->ResolveEquivalentFragments();
   this->GenerateOutputFromSingleProcess(surfaces, numBlcks, partIndx, polyData);
 
@@ -1599,6 +1734,201 @@ void vtkRectilinearGridConnectivity::ExtractFragmentPolyhedra(
     return;
   }
 
+  // The layers of cubes are split into slabs of a fixed thickness, so that the
+  // polyhedra do not depend on the number of threads. Up to one slab per
+  // thread is extracted concurrently, then the slabs are appended in order and
+  // freed: the points of a slab are merged with those of the previous slab
+  // that lie on the plane between the two slabs, which gives the points the
+  // Ids they would get if the block were processed as a single slab.
+  const int slabThickness = 8;
+  const double tolerance = 0.0001; // that of the point locators
+  int dataDims[3];
+  double dataBbox[6];
+  rectGrid->GetDimensions(dataDims);
+  rectGrid->GetBounds(dataBbox);
+  vtkDataArray* pZcoords = rectGrid->GetZCoordinates();
+  int numSlabs = std::max((dataDims[2] - 1 + slabThickness - 1) / slabThickness, 1);
+  int waveSize = std::min(numSlabs, std::max(1, vtkSMPTools::GetEstimatedNumberOfThreads()));
+  std::vector<vtkPolyData*> slabHedra(waveSize, nullptr);
+
+  vtkPoints* hedraPts = vtkPoints::New();
+  vtkCellArray* polygons = vtkCellArray::New();
+  vtkIdTypeArray* uniVIdxs = nullptr;
+  vtkIdType volIndex = 0; // number of sub-volumes of the previous slabs
+  vtkIdType numbPnts = 0;
+  const vtkIdType* slabPIds = nullptr;
+  vtkIdType plyPtIds[5];
+  vtkNew<vtkIdList> ptIdList;
+
+  // points of the previous slab that lie on the plane shared with the slab
+  // being appended, and their Ids in the polyhedra
+  vtkPoints* planePts = nullptr;
+  vtkIncrementalOctreePointLocator* planeLoc = nullptr;
+  std::vector<vtkIdType> planePIds;
+  std::vector<vtkIdType> pointMap;
+
+  for (int firstSlab = 0; firstSlab < numSlabs; firstSlab += waveSize)
+  {
+    int numWave = std::min(waveSize, numSlabs - firstSlab);
+    vtkSMPTools::For(0, numWave, 1,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType w = begin; w < end; w++)
+        {
+          int kBegin = (firstSlab + static_cast<int>(w)) * slabThickness;
+          slabHedra[w] = vtkPolyData::New();
+          this->ExtractSlabPolyhedra(
+            rectGrid, fracName, isoValue, kBegin, kBegin + slabThickness, slabHedra[w]);
+        }
+      });
+
+    for (int w = 0; w < numWave; w++)
+    {
+      vtkPolyData* slab = slabHedra[w];
+      vtkCellData* slabData = slab->GetCellData();
+      vtkCellData* hedraData = plyHedra->GetCellData();
+      int kBegin = (firstSlab + w) * slabThickness;
+      int kEnd = std::min(kBegin + slabThickness, dataDims[2] - 1);
+
+      // the first slab provides the cell data arrays of the polyhedra
+      if (firstSlab + w == 0)
+      {
+        for (int a = 0; a < slabData->GetNumberOfArrays(); a++)
+        {
+          vtkDataArray* slabAray = slabData->GetArray(a);
+          vtkDataArray* hedraAray = slabAray->NewInstance();
+          hedraAray->SetName(slabAray->GetName());
+          hedraAray->SetNumberOfComponents(slabAray->GetNumberOfComponents());
+          if (slabAray == slabData->GetGlobalIds())
+          {
+            hedraData->SetGlobalIds(hedraAray);
+            uniVIdxs = vtkIdTypeArray::SafeDownCast(hedraAray);
+          }
+          else
+          {
+            hedraData->AddArray(hedraAray);
+          }
+          hedraAray->Delete();
+        }
+      }
+
+      // append the points of the slab
+      vtkPoints* slabPnts = slab->GetPoints();
+      vtkIdType numSlabPts = slabPnts->GetNumberOfPoints();
+      double zPlane = pZcoords->GetComponent(std::min(kBegin, dataDims[2] - 1), 0);
+      pointMap.resize(numSlabPts);
+      for (vtkIdType p = 0; p < numSlabPts; p++)
+      {
+        double pntCoord[3];
+        slabPnts->GetPoint(p, pntCoord);
+        vtkIdType planePId = -1;
+        if (planeLoc && std::abs(pntCoord[2] - zPlane) <= tolerance)
+        {
+          planePId = planeLoc->IsInsertedPoint(pntCoord);
+        }
+        pointMap[p] = (planePId >= 0) ? planePIds[planePId] : hedraPts->InsertNextPoint(pntCoord);
+      }
+
+      // append the polygons of the slab, with the Ids of the polyhedra points
+      vtkCellArray* slabPlys = slab->GetPolys();
+      vtkIdType firstCell = polygons->GetNumberOfCells();
+      vtkIdType numSlabCells = slabPlys->GetNumberOfCells();
+      for (vtkIdType c = 0; c < numSlabCells; c++)
+      {
+        slabPlys->GetCellAtId(c, numbPnts, slabPIds, ptIdList);
+        for (vtkIdType n = 0; n < numbPnts; n++)
+        {
+          plyPtIds[n] = pointMap[slabPIds[n]];
+        }
+        polygons->InsertNextCell(numbPnts, plyPtIds);
+      }
+
+      // append the cell data, the volume Ids following those of the previous
+      // slabs
+      for (int a = 0; a < slabData->GetNumberOfArrays(); a++)
+      {
+        vtkDataArray* slabAray = slabData->GetArray(a);
+        hedraData->GetArray(slabAray->GetName())
+          ->InsertTuples(firstCell, numSlabCells, 0, slabAray);
+      }
+      vtkIdType numSlabVols = 0;
+      vtkIdType* vIdxsPtr = uniVIdxs->GetPointer(firstCell);
+      for (vtkIdType c = 0; c < numSlabCells; c++)
+      {
+        numSlabVols = std::max(numSlabVols, vIdxsPtr[c] + 1);
+        vIdxsPtr[c] += volIndex;
+      }
+      volIndex += numSlabVols;
+
+      // collect the points lying on the plane shared with the next slab
+      if (planeLoc)
+      {
+        planeLoc->Delete();
+        planePts->Delete();
+        planeLoc = nullptr;
+        planePts = nullptr;
+      }
+      planePIds.clear();
+      if (kEnd < dataDims[2] - 1)
+      {
+        double planeBox[6] = { dataBbox[0], dataBbox[1], dataBbox[2], dataBbox[3], 0.0, 0.0 };
+        zPlane = pZcoords->GetComponent(kEnd, 0);
+        planeBox[4] = zPlane - tolerance;
+        planeBox[5] = zPlane + tolerance;
+        planePts = vtkPoints::New();
+        planeLoc = vtkIncrementalOctreePointLocator::New();
+        planeLoc->SetTolerance(tolerance);
+        planeLoc->InitPointInsertion(planePts, planeBox);
+
+        std::vector<vtkIdType> hedraPIds;
+        for (vtkIdType p = 0; p < numSlabPts; p++)
+        {
+          if (std::abs(slabPnts->GetPoint(p)[2] - zPlane) <= tolerance)
+          {
+            hedraPIds.push_back(pointMap[p]);
+          }
+        }
+        std::sort(hedraPIds.begin(), hedraPIds.end());
+        hedraPIds.erase(std::unique(hedraPIds.begin(), hedraPIds.end()), hedraPIds.end());
+        for (vtkIdType hedraPId : hedraPIds)
+        {
+          planeLoc->InsertNextPoint(hedraPts->GetPoint(hedraPId));
+          planePIds.push_back(hedraPId);
+        }
+      }
+
+      slab->Delete();
+      slabHedra[w] = nullptr;
+    }
+  }
+
+  if (planeLoc)
+  {
+    planeLoc->Delete();
+    planePts->Delete();
+  }
+
+  plyHedra->SetPoints(hedraPts);
+  plyHedra->SetPolys(polygons);
+  plyHedra->Squeeze();
+  hedraPts->Delete();
+  polygons->Delete();
+}
+
+//-----------------------------------------------------------------------------
+void vtkRectilinearGridConnectivity::ExtractSlabPolyhedra(vtkRectilinearGrid* rectGrid,
+  const char* fracName, double isoValue, int kBegin, int kEnd, vtkPolyData* plyHedra)
+{
+  if (!rectGrid || !plyHedra || !this->Internal->IntegrablePointDataArraysAvailable(rectGrid) ||
+    vtkDoubleArray::SafeDownCast(rectGrid->GetPointData()->GetArray(fracName)) == nullptr ||
+    vtkDoubleArray::SafeDownCast(rectGrid->GetPointData()->GetArray("GeometricVolume")) == nullptr)
+  {
+    vtkErrorMacro(<< "Input vtkRectilinearGrid, point data GeometricVolume, "
+                  << "integrable point data arrays, or output vtkPolyData "
+                  << "NULL." << endl);
+    return;
+  }
+
   // IIP: Interpolated Iso-value Point --- the on-edge iso-value point obtained
   //      via interpolation. Each IIP is indicated by the associated edge index
   //      (0 ~ 11) in the LUT. In contrast, each vertex of the cube is referred
@@ -1702,22 +2032,19 @@ void vtkRectilinearGridConnectivity::ExtractFragmentPolyhedra(
     }
     tempAray = nullptr;
   }
-  if (this->Internal->ComponentNumbersObtained == 0)
-  {
-    this->Internal->ComponentNumbersObtained = 1;
-    this->Internal->NumberIntegralComponents = 0;
-    for (a = 0; a < numArays; a++)
-    {
-      this->Internal->NumberIntegralComponents += numComps[a];
-      this->Internal->ComponentNumbersPerArray.push_back(numComps[a]);
-    }
-  }
 
-  // create a vtkPoints for all the points of the fragment surfaces
+  // create a vtkPoints for all the points of the fragment surfaces of the slab
   rectGrid->GetBounds(dataBbox);
   rectGrid->GetDimensions(dataDims);
+  kBegin = std::max(kBegin, 0);
+  kEnd = std::max(std::min(kEnd, dataDims[2] - 1), kBegin);
+  if (kEnd > kBegin)
+  {
+    dataBbox[4] = pZcoords->GetComponent(kBegin, 0);
+    dataBbox[5] = pZcoords->GetComponent(kEnd, 0);
+  }
   sliceSiz = dataDims[0] * dataDims[1];
-  estiSize = sliceSiz * dataDims[2];
+  estiSize = sliceSiz * (kEnd - kBegin + 1);
   estiSize = estiSize / 1024 * 1024;
   estiSize = (estiSize < 1024) ? 1024 : estiSize;
   surfPnts = vtkPoints::New();
@@ -1759,9 +2086,9 @@ void vtkRectilinearGridConnectivity::ExtractFragmentPolyhedra(
   }
 
   // marching cubes to create surfaces for the greater-than-isovalue sub-volumes
-  pntKindx = -sliceSiz;
-  lastCord[2] = pZcoords->GetComponent(0, 0); // for reusing z-coordinate
-  for (k = 0; k < dataDims[2] - 1; k++)
+  pntKindx = (kBegin - 1) * sliceSiz;
+  lastCord[2] = pZcoords->GetComponent(kBegin, 0); // for reusing z-coordinate
+  for (k = kBegin; k < kEnd; k++)
   {
     pntKindx += sliceSiz;
     vtxCords[0][2] = lastCord[2];
@@ -2223,16 +2550,18 @@ void vtkRectilinearGridConnectivity::InitializeFaceHash(vtkPolyData* plyHedra)
     this->FaceHash = nullptr;
   }
 
-  int hashSize = plyHedra->GetPoints()->GetNumberOfPoints();
-  hashSize = (hashSize < 1) ? 1 : hashSize;
-
   this->FaceHash = new vtkRectilinearGridConnectivityFaceHash;
-  this->FaceHash->Initialize(hashSize);
+  this->FaceHash->Initialize(plyHedra->GetNumberOfCells());
 }
 
 //-----------------------------------------------------------------------------
 void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(int blockIdx, vtkPolyData* plyHedra)
 {
+  // The equivalences are added in a single batch once all the polygons have
+  // been hashed.
+  std::vector<int> equivalentIds1;
+  std::vector<int> equivalentIds2;
+
   // process the vtkPolyData and add its 2D polygons (faces) to the hash
 
   // make sure the vtkPolyData (set of polyhedra) contains cell data attributes
@@ -2259,7 +2588,6 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(int blockIdx, vtkPoly
   int* numComps = nullptr;    // number of integrated components
   double* tupleBuf = nullptr; // integrated component values
   double** attrPtrs = nullptr;
-  vtkCell* thisFace = nullptr;   // a 2D polygon (instead of a 3D cell)
   vtkIdType numFaces = 0;        // number of 2D polygons in a vtkPolyData
   vtkIdType volIndex = 0;        // global volume Id attached to a 2D polygon
   vtkIdType* vIdxsPtr = nullptr; // array of global volume Ids
@@ -2300,6 +2628,11 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(int blockIdx, vtkPoly
   vIdxsPtr =
     vtkIdTypeArray::SafeDownCast(plyHedra->GetCellData()->GetArray("VolumeId"))->GetPointer(0);
 
+  // find the slots of all the faces in the hash concurrently, the faces being
+  // then added to the hash in order
+  std::vector<vtkIdType> faceSlots;
+  this->FaceHash->InsertFaces(plyHedra, nullptr, faceSlots);
+
   i = 0;
   volIndex = -1;
   numFaces = plyHedra->GetNumberOfCells();
@@ -2332,31 +2665,11 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(int blockIdx, vtkPoly
     while (vIdxsPtr[i] == volIndex) // for each face of the current volume
     {
       // this is really a face of the current volume: add it to the hash
-      hashFace = nullptr;
-      thisFace = plyHedra->GetCell(i);
-      switch (thisFace->GetNumberOfPoints())
+      hashFace = this->FaceHash->AddFace(faceSlots[i]);
+      if (!hashFace)
       {
-        case 3:
-          hashFace = this->FaceHash->AddFace(
-            thisFace->GetPointId(0), thisFace->GetPointId(1), thisFace->GetPointId(2));
-          break;
-
-        case 4:
-          hashFace = this->FaceHash->AddFace(thisFace->GetPointId(0), thisFace->GetPointId(1),
-            thisFace->GetPointId(2), thisFace->GetPointId(3));
-          break;
-
-        case 5:
-          hashFace = this->FaceHash->AddFace(thisFace->GetPointId(0), thisFace->GetPointId(1),
-            thisFace->GetPointId(2), thisFace->GetPointId(3), thisFace->GetPointId(4));
-          break;
-
-        default:
-          hashFace = nullptr;
-          vtkWarningMacro("Invalid number of points: face ignoired.");
-          break;
+        vtkWarningMacro("Invalid number of points: face ignoired.");
       }
-      thisFace = nullptr;
 
       if (hashFace)
       {
@@ -2369,7 +2682,7 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(int blockIdx, vtkPoly
         {
           // This is an internal face. It has been removed from the hash when
           // the hash attempts to accept it for the second time, though it is
-          // accessible until a new face is allocated from the recycle bin.
+          // accessible until faces are inserted in the hash again.
 
           if (hashFace->FragmentId != minIndex && minIndex < fragIndx)
           {
@@ -2383,7 +2696,8 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(int blockIdx, vtkPoly
             // this volume (R) is connected with two currently un-merged volumes
             // S and T. Thus we need to make the fragment Ids of volumes S and T
             // equivalent to each other.
-            this->EquivalenceSet->AddEquivalence(minIndex, hashFace->FragmentId);
+            equivalentIds1.push_back(minIndex);
+            equivalentIds2.push_back(hashFace->FragmentId);
           }
 
           // keep track of the smallest fragment id to use for this volume
@@ -2433,7 +2747,8 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(int blockIdx, vtkPoly
       // since no any neighboring volume has been found (otherwise minIndex
       // would have been updated to be less than fragIndx in case A above).
       // The code below ensures the correct number of equivalence members.
-      this->EquivalenceSet->AddEquivalence(fragIndx, fragIndx);
+      equivalentIds1.push_back(fragIndx);
+      equivalentIds2.push_back(fragIndx);
       fragIndx++;
     }
 
@@ -2462,6 +2777,9 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(int blockIdx, vtkPoly
   numComps = nullptr;
   tupleBuf = nullptr;
   vIdxsPtr = nullptr;
+
+  this->EquivalenceSet->AddEquivalences(
+    equivalentIds1.data(), equivalentIds2.data(), static_cast<vtkIdType>(equivalentIds1.size()));
 }
 
 //-----------------------------------------------------------------------------
@@ -2834,36 +3152,15 @@ void vtkRectilinearGridConnectivity::ExtractFragmentPolygons(int blockIdx, int&
 //-----------------------------------------------------------------------------
 void vtkRectilinearGridConnectivity::InitializeFaceHash(vtkPolyData** plyDatas, int numPolys)
 {
-  int i;
-  vtkIdType maxIndex = 0;
-
-  // find the maximum global point Id to initialize the face hash
-  for (i = 0; i < numPolys; i++)
-  {
-    // The if-statement below is a MUST since an input vtkPolyData may be just
-    // 'empty'. This is the case with both single-process mode and multi-process
-    // mode if no any polygon is extracted from the marching-cubes process or
-    // else no any polygon remains after in-hash polygons resolution (removal
-    // of internal faces). Note that a process may be assigned with no any block
-    // at all.
-    if (vtkIdTypeArray::SafeDownCast(plyDatas[i]->GetPointData()->GetArray("GlobalNodeId")) ==
-      nullptr)
-    {
-      vtkDebugMacro(<< "Point data GlobalNodeId not found in "
-                    << "vtkPolyData #" << i << endl);
-      continue;
-    }
-
-    vtkIdType pntindex = 0;
-    vtkIdType numbPnts = plyDatas[i]->GetNumberOfPoints();
-    vtkIdType* ptIdsPtr =
-      vtkIdTypeArray::SafeDownCast(plyDatas[i]->GetPointData()->GetArray("GlobalNodeId"))
-        ->GetPointer(0);
-
-    for (pntindex = 0; pntindex < numbPnts; pntindex++, ptIdsPtr++)
-    {
-      maxIndex = (*ptIdsPtr > maxIndex) ? (*ptIdsPtr) : maxIndex;
-    }
+  // Size the face hash with the total number of polygons. Note that an input
+  // vtkPolyData may be just 'empty'. This is the case with both single-process
+  // mode and multi-process mode if no any polygon is extracted from the
+  // marching-cubes process or else no any polygon remains after in-hash
+  // polygons resolution (removal of internal faces).
+  vtkIdType numFaces = 0;
+  for (int i = 0; i < numPolys; i++)
+  {
+    numFaces += plyDatas[i]->GetNumberOfCells();
   }
 
   if (this->FaceHash)
@@ -2872,7 +3169,7 @@ void vtkRectilinearGridConnectivity::InitializeFaceHash(vtkPolyData** plyDatas,
     this->FaceHash = nullptr;
   }
   this->FaceHash = new vtkRectilinearGridConnectivityFaceHash;
-  this->FaceHash->Initialize(maxIndex + 1);
+  this->FaceHash->Initialize(numFaces);
 }
 
 //-----------------------------------------------------------------------------
@@ -2885,7 +3182,47 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(
     return;
   }
 
-  int i, j, k, a, c;
+  // process each vtkPolyData and add its 2D polygons (faces) to the hash
+  this->Internal->NextFragmentId = 1;
+  this->Internal->EquivalentIds1.clear();
+  this->Internal->EquivalentIds2.clear();
+  for (int j = 0; j < numPolys; j++)
+  {
+    this->AddSurfaceToFaceHash(j, plyDatas[j], maxFsize[j]);
+  }
+
+  // The equivalences are added in a single batch once all the polygons have
+  // been hashed.
+  this->EquivalenceSet->AddEquivalences(this->Internal->EquivalentIds1.data(),
+    this->Internal->EquivalentIds2.data(),
+    static_cast<vtkIdType>(this->Internal->EquivalentIds1.size()));
+  this->Internal->EquivalentIds1.clear();
+  this->Internal->EquivalentIds2.clear();
+}
+
+//-----------------------------------------------------------------------------
+void vtkRectilinearGridConnectivity::AddSurfaceToFaceHash(
+  int blockIdx, vtkPolyData* surface, int maxFsize)
+{
+  // each vtkPolyData stores individual 2D polygons (triangles, quads, and
+  // pentagons) of which each is though coupled with a local / block-based
+  // fragment Id as the cell data attribute to convey the connectivity of
+  // the exterior polygons of the same fragment --- 'macro volume'
+
+  if (vtkIdTypeArray::SafeDownCast(surface->GetPointData()->GetArray("GlobalNodeId")) ==
+      nullptr ||
+    vtkIntArray::SafeDownCast(surface->GetCellData()->GetArray("FragmentId")) == nullptr ||
+    vtkDoubleArray::SafeDownCast(surface->GetCellData()->GetArray("MaterialVolume")) ==
+      nullptr ||
+    !this->Internal->IntegrableCellDataArraysAvailable(surface))
+  {
+    vtkDebugMacro(<< "Point data GlobalNodeId, cell data FragmentId, "
+                  << "MaterialVolume, or integrable fragemnt "
+                  << "attributes not found in vtkPolyData #" << blockIdx << endl);
+    return;
+  }
+
+  int i, k, a, c;
   int procIndx = this->Controller->GetLocalProcessId();
   int theShift = 0;
   int bufIndex = 0;
@@ -2893,22 +3230,23 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(
   int tupleSiz = 0;           // number of integrated components
   int newIndex = 0;           // index of a new face of the local fragment
   int minIndex = 1;           // the smallest (inter-block) fragment Id
-  int fragIndx = 1;           // next inter-block fragment Id and 0 for
-                              // removing faces
   int* lfIdsPtr = nullptr;    // array of local fragment Ids
   int* numComps = nullptr;    // number of integrated components
   double* tupleBuf = nullptr; // integrated component values
   double** attrPtrs = nullptr;
-  vtkCell* thisFace = nullptr;   // a 2D polygon (not a 3D cell)
   vtkIdType numFaces = 0;        // number of 2D polygons of an input vtkPolyData
   vtkIdType localFId = 0;        // Id of the local fragment being processed
-  vtkIdType numbPnts = 0;        // for a face
-  vtkIdType pointIds[5];         // point Ids of a face (at most 5 points)
   vtkIdType* ptIdsPtr = nullptr; // array of point Ids
   vtkDoubleArray* theArray = nullptr;
   vtkRectilinearGridConnectivityFace* hashFace = nullptr; // a face in the hash
   vtkRectilinearGridConnectivityFace** newFaces = nullptr;
 
+  // the next inter-block fragment Id (0 for removing faces) and the
+  // equivalences are kept across the blocks
+  int& fragIndx = this->Internal->NextFragmentId;
+  std::vector<int>& equivalentIds1 = this->Internal->EquivalentIds1;
+  std::vector<int>& equivalentIds2 = this->Internal->EquivalentIds2;
+
   // determine the number of integrated components (including the material
   // volume) to be saved to the global fragment attributes array and allocate a
   // buffer for a tuple
@@ -2928,229 +3266,181 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(
     attrPtrs[a] = nullptr;
   }
 
-  // process each vtkPolyData and add its 2D polygons (faces) to the hash
-  for (j = 0; j < numPolys; j++)
+  // gain access to global node Ids, global volume Ids, and local fragment Ids
+  ptIdsPtr = vtkIdTypeArray::SafeDownCast(surface->GetPointData()->GetArray("GlobalNodeId"))
+               ->GetPointer(0);
+  lfIdsPtr =
+    vtkIntArray::SafeDownCast(surface->GetCellData()->GetArray("FragmentId"))->GetPointer(0);
+  attrPtrs[0] =
+    vtkDoubleArray::SafeDownCast(surface->GetCellData()->GetArray("MaterialVolume"))
+      ->GetPointer(0);
+  for (a = 1; a < numArays; a++)
   {
-    // each vtkPolyData stores individual 2D polygons (triangles, quads, and
-    // pentagons) of which each is though coupled with a local / block-based
-    // fragment Id as the cell data attribute to convey the connectivity of
-    // the exterior polygons of the same fragment --- 'macro volume'
+    theArray = vtkDoubleArray::SafeDownCast(surface->GetCellData()->GetArray(
+      this->Internal->IntegrableAttributeNames[a - 1].c_str()));
+    attrPtrs[a] = theArray->GetPointer(0);
+    numComps[a] = theArray->GetNumberOfComponents();
+    theArray = nullptr;
+  }
 
-    if (vtkIdTypeArray::SafeDownCast(plyDatas[j]->GetPointData()->GetArray("GlobalNodeId")) ==
-        nullptr ||
-      vtkIntArray::SafeDownCast(plyDatas[j]->GetCellData()->GetArray("FragmentId")) == nullptr ||
-      vtkDoubleArray::SafeDownCast(plyDatas[j]->GetCellData()->GetArray("MaterialVolume")) ==
-        nullptr ||
-      !this->Internal->IntegrableCellDataArraysAvailable(plyDatas[j]))
-    {
-      vtkDebugMacro(<< "Point data GlobalNodeId, cell data FragmentId, "
-                    << "MaterialVolume, or integrable fragemnt "
-                    << "attributes not found in vtkPolyData #" << j << endl);
-      continue;
-    }
+  // given the maximum size of a fragment, i.e., the maximum number of
+  // faces per fragment in this vtkPolyData, allocate a buffer to maintain
+  // the possible new faces of a single fragment
+  newFaces = new vtkRectilinearGridConnectivityFace*[maxFsize];
+  for (k = 0; k < maxFsize; k++)
+  {
+    newFaces[k] = nullptr;
+  }
 
-    // gain access to global node Ids, global volume Ids, and local fragment Ids
-    ptIdsPtr = vtkIdTypeArray::SafeDownCast(plyDatas[j]->GetPointData()->GetArray("GlobalNodeId"))
-                 ->GetPointer(0);
-    lfIdsPtr =
-      vtkIntArray::SafeDownCast(plyDatas[j]->GetCellData()->GetArray("FragmentId"))->GetPointer(0);
-    attrPtrs[0] =
-      vtkDoubleArray::SafeDownCast(plyDatas[j]->GetCellData()->GetArray("MaterialVolume"))
-        ->GetPointer(0);
-    for (a = 1; a < numArays; a++)
-    {
-      theArray = vtkDoubleArray::SafeDownCast(plyDatas[j]->GetCellData()->GetArray(
-        this->Internal->IntegrableAttributeNames[a - 1].c_str()));
-      attrPtrs[a] = theArray->GetPointer(0);
-      numComps[a] = theArray->GetNumberOfComponents();
-      theArray = nullptr;
-    }
+  // find the slots of all the faces in the hash concurrently, the faces being
+  // then added to the hash in order
+  std::vector<vtkIdType> faceSlots;
+  this->FaceHash->InsertFaces(surface, ptIdsPtr, faceSlots);
 
-    // given the maximum size of a fragment, i.e., the maximum number of
-    // faces per fragment in this vtkPolyData, allocate a buffer to maintain
-    // the possible new faces of a single fragment
-    // FIXME: `clang-tidy` reports that `maxFsize[]` can be uninitialized here.
-    // NOLINTNEXTLINE(clang-analyzer-core.uninitialized.NewArraySize)
-    newFaces = new vtkRectilinearGridConnectivityFace*[maxFsize[j]];
-    for (k = 0; k < maxFsize[j]; k++)
-    {
-      newFaces[k] = nullptr;
-    }
+  i = 0;
+  localFId = -1;
+  numFaces = surface->GetNumberOfCells();
+  while (i < numFaces) // for each individual 2D polygon (face)
+  {
+    // "0 < numFaces" guarantees ptIdsPtr, and lfIdsPtr are not nullptr
 
-    i = 0;
-    localFId = -1;
-    numFaces = plyDatas[j]->GetNumberOfCells();
-    while (i < numFaces) // for each individual 2D polygon (face)
+    // note that each cell is a 2D polygon (instead of a 3D cell) and we
+    // have to use the cell data attribute, i.e., the local fragment Id,
+    // to combine individual 2D polygons to reconstruct a 'macro volume'
+    if (lfIdsPtr[i] != localFId)
     {
-      // "0 < numFaces" guarantees ptIdsPtr, and lfIdsPtr are not nullptr
+      // the first face of a NEW 'macro' volume --- init some variables
+      newIndex = 0;
+      minIndex = fragIndx;
+      localFId = lfIdsPtr[i]; // grouping faces via the local fragment Id
 
-      // note that each cell is a 2D polygon (instead of a 3D cell) and we
-      // have to use the cell data attribute, i.e., the local fragment Id,
-      // to combine individual 2D polygons to reconstruct a 'macro volume'
-      if (lfIdsPtr[i] != localFId)
+      // obtain the attribute value of the sub-volume via the first polygon
+      bufIndex = 0;
+      for (a = 0; a < numArays; a++)
       {
-        // the first face of a NEW 'macro' volume --- init some variables
-        newIndex = 0;
-        minIndex = fragIndx;
-        localFId = lfIdsPtr[i]; // grouping faces via the local fragment Id
-
-        // obtain the attribute value of the sub-volume via the first polygon
-        bufIndex = 0;
-        for (a = 0; a < numArays; a++)
+        theShift = i * numComps[a];
+        for (c = 0; c < numComps[a]; c++)
         {
-          theShift = i * numComps[a];
-          for (c = 0; c < numComps[a]; c++)
-          {
-            tupleBuf[bufIndex++] = attrPtrs[a][theShift + c];
-          }
+          tupleBuf[bufIndex++] = attrPtrs[a][theShift + c];
         }
       }
+    }
 
-      while (lfIdsPtr[i] == localFId) // for each face of the 'macro' volume
+    while (lfIdsPtr[i] == localFId) // for each face of the 'macro' volume
+    {
+      // this is a face of the current 'macro' volume: add it to the hash
+      hashFace = this->FaceHash->AddFace(faceSlots[i]);
+      if (!hashFace)
       {
-        // this is a face of the current 'macro' volume
-        hashFace = nullptr;
-        thisFace = plyDatas[j]->GetCell(i);
-        numbPnts = thisFace->GetNumberOfPoints();
+        vtkWarningMacro("Face ignored due to invalid number of points.");
+      }
 
-        // add the face to the hash
-        if (numbPnts == 3)
-        {
-          pointIds[0] = ptIdsPtr[thisFace->GetPointId(0)];
-          pointIds[1] = ptIdsPtr[thisFace->GetPointId(1)];
-          pointIds[2] = ptIdsPtr[thisFace->GetPointId(2)];
-          hashFace = this->FaceHash->AddFace(pointIds[0], pointIds[1], pointIds[2]);
-        }
-        else if (numbPnts == 4)
-        {
-          pointIds[0] = ptIdsPtr[thisFace->GetPointId(0)];
-          pointIds[1] = ptIdsPtr[thisFace->GetPointId(1)];
-          pointIds[2] = ptIdsPtr[thisFace->GetPointId(2)];
-          pointIds[3] = ptIdsPtr[thisFace->GetPointId(3)];
-          hashFace = this->FaceHash->AddFace(pointIds[0], pointIds[1], pointIds[2], pointIds[3]);
-        }
-        else if (numbPnts == 5)
-        {
-          pointIds[0] = ptIdsPtr[thisFace->GetPointId(0)];
-          pointIds[1] = ptIdsPtr[thisFace->GetPointId(1)];
-          pointIds[2] = ptIdsPtr[thisFace->GetPointId(2)];
-          pointIds[3] = ptIdsPtr[thisFace->GetPointId(3)];
-          pointIds[4] = ptIdsPtr[thisFace->GetPointId(4)];
-          hashFace = this->FaceHash->AddFace(
-            pointIds[0], pointIds[1], pointIds[2], pointIds[3], pointIds[4]);
-        }
-        else
-        {
-          hashFace = nullptr;
-          vtkWarningMacro("Face ignored due to invalid number of points.");
-        }
-        thisFace = nullptr;
+      if (hashFace)
+      {
+        // this face has been added to the hash and it is not necessarily the
+        // first time --- the same face may have been added to the hash as the
+        // constituent polygon of another sub-volume ('macro') and in this case
+        // this face is called an 'internal' face
 
-        if (hashFace)
+        if (hashFace->FragmentId > 0)
         {
-          // this face has been added to the hash and it is not necessarily the
-          // first time --- the same face may have been added to the hash as the
-          // constituent polygon of another sub-volume ('macro') and in this case
-          // this face is called an 'internal' face
+          // This is an internal face. It has been removed from the hash when
+          // the hash attempts to accept it for the second time, though it is
+          // accessible until faces are inserted in the hash again.
 
-          if (hashFace->FragmentId > 0)
+          if (hashFace->FragmentId != minIndex && minIndex < fragIndx)
           {
-            // This is an internal face. It has been removed from the hash when
-            // the hash attempts to accept it for the second time, though it is
-            // accessible until a new face is allocated from the recycle bin.
-
-            if (hashFace->FragmentId != minIndex && minIndex < fragIndx)
-            {
-              // This face (X) is not the first one of this 'macro' volume (R,
-              // otherwise minIndex == fragIndx would hold). In fact, there has
-              // been a face (Y, of this 'macro' volume R) that is shared by this
-              // 'macro' volume (R) and a second 'macro' volume (S, otherwise
-              // minIndx == fragIndx would hold). In addition, this face (X) is
-              // shared by this 'macro' volume (R) and a third 'macro' volume (T,
-              // which though has not been merged with 'macro' volume S, otherwise
-              // hashFace->FragmentId == minIndex would hold). In a word, this
-              // 'macro' volume (R) is connected with two currently un-merged 'macro'
-              // volumes S and T. Thus we need to make the fragment Ids of 'macro'
-              // volumes S and T equivalent to each other.
-              this->EquivalenceSet->AddEquivalence(minIndex, hashFace->FragmentId);
-            }
-
-            // keep track of the smallest fragment id to use for this 'macro' volume
-            // --- case A
-            // The first face (certainly internal, since hashFace->FragmentId
-            // > 0 holds above) of this 'macro' volume is guaranteed to come here.
-            // In addition, non-first internal faces (of this 'macro' volume) that
-            // are shared by new 'macro' volumes also come here. In either case,
-            // minIndex is updated below to reflect the smallest fragment Id so
-            // far and will be assigned to those subsequent new faces of this
-            // 'macro' volume.
-            minIndex = std::min<int>(minIndex, hashFace->FragmentId);
+            // This face (X) is not the first one of this 'macro' volume (R,
+            // otherwise minIndex == fragIndx would hold). In fact, there has
+            // been a face (Y, of this 'macro' volume R) that is shared by this
+            // 'macro' volume (R) and a second 'macro' volume (S, otherwise
+            // minIndx == fragIndx would hold). In addition, this face (X) is
+            // shared by this 'macro' volume (R) and a third 'macro' volume (T,
+            // which though has not been merged with 'macro' volume S, otherwise
+            // hashFace->FragmentId == minIndex would hold). In a word, this
+            // 'macro' volume (R) is connected with two currently un-merged 'macro'
+            // volumes S and T. Thus we need to make the fragment Ids of 'macro'
+            // volumes S and T equivalent to each other.
+            equivalentIds1.push_back(minIndex);
+            equivalentIds2.push_back(hashFace->FragmentId);
           }
-          else
-          {
-            // this is a new face (hashFace->FragmentId is inited to be 0)
-            hashFace->BlockId = j;
-            hashFace->PolygonId = i;
-            hashFace->ProcessId = procIndx;
-
-            // save this new face until we process all the faces of this
-            // 'macro' volume to determine the smallest fragment id
-            newFaces[newIndex++] = hashFace;
-
-          } // end if a new face is added to the hash
-        } // end if the input face is valid
-
-        // process the next 2D polygon by updating the index of the face
-        i++;
-        hashFace = nullptr;
-
-      } // for each face of a 'macro' volume
 
-      // The current face (2D polygon) belongs to a new 'macro' volume. Before
-      // processing it in the next cycle (for each separated 2D polygon), we
-      // need to do some thing for the 'macro' volume that we have just recognized.
+          // keep track of the smallest fragment id to use for this 'macro' volume
+          // --- case A
+          // The first face (certainly internal, since hashFace->FragmentId
+          // > 0 holds above) of this 'macro' volume is guaranteed to come here.
+          // In addition, non-first internal faces (of this 'macro' volume) that
+          // are shared by new 'macro' volumes also come here. In either case,
+          // minIndex is updated below to reflect the smallest fragment Id so
+          // far and will be assigned to those subsequent new faces of this
+          // 'macro' volume.
+          minIndex = std::min<int>(minIndex, hashFace->FragmentId);
+        }
+        else
+        {
+          // this is a new face (hashFace->FragmentId is inited to be 0)
+          hashFace->BlockId = blockIdx;
+          hashFace->PolygonId = i;
+          hashFace->ProcessId = procIndx;
 
-      if (minIndex == fragIndx)
-      {
-        // This is an isolated 'macro' volume (possibly the first 'macro' volume
-        // of a fragment) since no any neighboring 'macro' volume has been found
-        // (otherwise minIndex would have been updated to be less than fragIndx
-        // in case A above). The code below ensures the correct number of
-        // equivalence members.
-        this->EquivalenceSet->AddEquivalence(fragIndx, fragIndx);
-        fragIndx++;
-      }
+          // save this new face until we process all the faces of this
+          // 'macro' volume to determine the smallest fragment id
+          newFaces[newIndex++] = hashFace;
 
-      // update the smallest fragment Id used so far
-      minIndex = this->EquivalenceSet->GetEquivalentSetId(minIndex);
+        } // end if a new face is added to the hash
+      } // end if the input face is valid
 
-      // Label the new faces of the 'macro' volume with the final (smallest)
-      // fragment id.
-      for (k = 0; k < newIndex; k++)
-      {
-        newFaces[k]->FragmentId = minIndex;
-      }
+      // process the next 2D polygon by updating the index of the face
+      i++;
+      hashFace = nullptr;
 
-      // fragment attributes integration
-      this->IntegrateFragmentAttributes(minIndex, tupleSiz, tupleBuf);
+    } // for each face of a 'macro' volume
 
-    } // for each individual 2D polygon
+    // The current face (2D polygon) belongs to a new 'macro' volume. Before
+    // processing it in the next cycle (for each separated 2D polygon), we
+    // need to do some thing for the 'macro' volume that we have just recognized.
 
-    // clean up the buffer of new faces
-    for (k = 0; k < maxFsize[j]; k++)
+    if (minIndex == fragIndx)
     {
-      newFaces[k] = nullptr;
+      // This is an isolated 'macro' volume (possibly the first 'macro' volume
+      // of a fragment) since no any neighboring 'macro' volume has been found
+      // (otherwise minIndex would have been updated to be less than fragIndx
+      // in case A above). The code below ensures the correct number of
+      // equivalence members.
+      equivalentIds1.push_back(fragIndx);
+      equivalentIds2.push_back(fragIndx);
+      fragIndx++;
     }
-    delete[] newFaces;
-    newFaces = nullptr;
 
-    for (i = 0; i < numArays; i++)
+    // update the smallest fragment Id used so far
+    minIndex = this->EquivalenceSet->GetEquivalentSetId(minIndex);
+
+    // Label the new faces of the 'macro' volume with the final (smallest)
+    // fragment id.
+    for (k = 0; k < newIndex; k++)
     {
-      attrPtrs[i] = nullptr;
+      newFaces[k]->FragmentId = minIndex;
     }
-    ptIdsPtr = nullptr;
-    lfIdsPtr = nullptr;
-  } // for each input vtkPolyData
+
+    // fragment attributes integration
+    this->IntegrateFragmentAttributes(minIndex, tupleSiz, tupleBuf);
+
+  } // for each individual 2D polygon
+
+  // clean up the buffer of new faces
+  for (k = 0; k < maxFsize; k++)
+  {
+    newFaces[k] = nullptr;
+  }
+  delete[] newFaces;
+  newFaces = nullptr;
+
+  for (i = 0; i < numArays; i++)
+  {
+    attrPtrs[i] = nullptr;
+  }
+  ptIdsPtr = nullptr;
+  lfIdsPtr = nullptr;
 
   delete[] attrPtrs;
   delete[] numComps;
@@ -3160,6 +3450,61 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(
   tupleBuf = nullptr;
 }
 
+//-----------------------------------------------------------------------------
+void vtkRectilinearGridConnectivity::RemoveInternalPolygons(int blockIdx, vtkPolyData* surface)
+{
+  vtkIdTypeArray* ptIdsAray =
+    vtkIdTypeArray::SafeDownCast(surface->GetPointData()->GetArray("GlobalNodeId"));
+  if (!ptIdsAray)
+  {
+    return;
+  }
+
+  // Look up the face of each polygon concurrently. The polygon is kept if its
+  // face is still in the hash, in which case the face has been added by this
+  // very polygon.
+  const vtkIdType* ptIdsPtr = ptIdsAray->GetPointer(0);
+  vtkCellArray* polygons = surface->GetPolys();
+  vtkIdType numFaces = polygons->GetNumberOfCells();
+  std::vector<vtkRectilinearGridConnectivityFace*> hashFaces(numFaces);
+  vtkSMPThreadLocalObject<vtkIdList> tlPtIds;
+  vtkSMPTools::For(0, numFaces,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      vtkIdList* ptIdList = tlPtIds.Local();
+      vtkIdType numbPnts;
+      const vtkIdType* ptIds;
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        polygons->GetCellAtId(i, numbPnts, ptIds, ptIdList);
+        vtkRectilinearGridConnectivityFace* hashFace =
+          this->FaceHash->FindFace(numbPnts, ptIds, ptIdsPtr);
+        hashFaces[i] =
+          (hashFace && hashFace->BlockId == blockIdx && hashFace->PolygonId == i) ? hashFace
+                                                                                  : nullptr;
+      }
+    });
+
+  // Only the polygons are used from now on (the cell data attributes have
+  // been integrated into the fragment attributes already).
+  vtkIdType numbPnts;
+  const vtkIdType* ptIds;
+  vtkNew<vtkIdList> ptIdList;
+  vtkCellArray* remained = vtkCellArray::New();
+  for (vtkIdType i = 0; i < numFaces; i++)
+  {
+    if (hashFaces[i])
+    {
+      polygons->GetCellAtId(i, numbPnts, ptIds, ptIdList);
+      hashFaces[i]->PolygonId = remained->InsertNextCell(numbPnts, ptIds);
+    }
+  }
+  surface->SetPolys(remained);
+  surface->GetCellData()->Initialize();
+  surface->Squeeze();
+  remained->Delete();
+}
+
 //-----------------------------------------------------------------------------
 void vtkRectilinearGridConnectivity::GenerateOutputFromSingleProcess(
   vtkPolyData** surfaces, int numSurfs, unsigned char partIndx, vtkPolyData* polyData)
@@ -3550,6 +3895,11 @@ void vtkRectilinearGridConnectivity::CreateInterProcessPolygons(vtkPolyData* fra
 void vtkRectilinearGridConnectivity::AddInterProcessPolygonsToFaceHash(
   vtkPolyData** procPlys, int* maxFsize, int numProcs)
 {
+  // The equivalences are added in a single batch once all the polygons have
+  // been hashed.
+  std::vector<int> equivalentIds1;
+  std::vector<int> equivalentIds2;
+
   if (!procPlys || !maxFsize)
   {
     vtkErrorMacro("Input vtkPolyData array (procPlys) or maxFsize NULL." << endl);
@@ -3569,15 +3919,13 @@ void vtkRectilinearGridConnectivity::AddInterProcessPolygonsToFaceHash(
   int* numComps = nullptr;    // number of integrated components
   double* tupleBuf = nullptr; // integrated component values
   double** attrPtrs = nullptr;
-  vtkCell* thisFace = nullptr;   // a 2D polygon (not a 3D cell)
   vtkIdType numFaces = 0;        // number of 2D polygons of an input vtkPolyData
   vtkIdType procFIdx = 0;        // Id of the local fragment being processed
-  vtkIdType numbPnts = 0;        // for a face / polygon
-  vtkIdType pointIds[5];         // point Ids of a face (at most 5 points)
   vtkIdType* pIdxsPtr = nullptr; // array of point Ids
   vtkDoubleArray* theArray = nullptr;
   vtkRectilinearGridConnectivityFace* hashFace = nullptr; // a face in the hash
   vtkRectilinearGridConnectivityFace** newFaces = nullptr;
+  std::vector<vtkIdType> faceSlots; // slots of the faces in the hash
 
   // determine the number of integrated components (including the material
   // volume) to be saved to the global fragment attributes array and allocate
@@ -3649,6 +3997,10 @@ void vtkRectilinearGridConnectivity::AddInterProcessPolygonsToFaceHash(
       newFaces[k] = nullptr;
     }
 
+    // find the slots of all the faces in the hash concurrently, the faces
+    // being then added to the hash in order
+    this->FaceHash->InsertFaces(procPlys[j], pIdxsPtr, faceSlots);
+
     i = 0;
     procFIdx = -1;
     numFaces = procPlys[j]->GetNumberOfCells();
@@ -3680,43 +4032,12 @@ void vtkRectilinearGridConnectivity::AddInterProcessPolygonsToFaceHash(
 
       while (fIdxsPtr[i] == procFIdx) // for each face of the 'macro' volume
       {
-        // this is a face of the current 'macro' volume
-        hashFace = nullptr;
-        thisFace = procPlys[j]->GetCell(i);
-        numbPnts = thisFace->GetNumberOfPoints();
-
-        // add the face to the hash
-        if (numbPnts == 3)
+        // this is a face of the current 'macro' volume: add it to the hash
+        hashFace = this->FaceHash->AddFace(faceSlots[i]);
+        if (!hashFace)
         {
-          pointIds[0] = pIdxsPtr[thisFace->GetPointId(0)];
-          pointIds[1] = pIdxsPtr[thisFace->GetPointId(1)];
-          pointIds[2] = pIdxsPtr[thisFace->GetPointId(2)];
-          hashFace = this->FaceHash->AddFace(pointIds[0], pointIds[1], pointIds[2]);
-        }
-        else if (numbPnts == 4)
-        {
-          pointIds[0] = pIdxsPtr[thisFace->GetPointId(0)];
-          pointIds[1] = pIdxsPtr[thisFace->GetPointId(1)];
-          pointIds[2] = pIdxsPtr[thisFace->GetPointId(2)];
-          pointIds[3] = pIdxsPtr[thisFace->GetPointId(3)];
-          hashFace = this->FaceHash->AddFace(pointIds[0], pointIds[1], pointIds[2], pointIds[3]);
-        }
-        else if (numbPnts == 5)
-        {
-          pointIds[0] = pIdxsPtr[thisFace->GetPointId(0)];
-          pointIds[1] = pIdxsPtr[thisFace->GetPointId(1)];
-          pointIds[2] = pIdxsPtr[thisFace->GetPointId(2)];
-          pointIds[3] = pIdxsPtr[thisFace->GetPointId(3)];
-          pointIds[4] = pIdxsPtr[thisFace->GetPointId(4)];
-          hashFace = this->FaceHash->AddFace(
-            pointIds[0], pointIds[1], pointIds[2], pointIds[3], pointIds[4]);
-        }
-        else
-        {
-          hashFace = nullptr;
           vtkWarningMacro("Face ignored due to invalid number of points.");
         }
-        thisFace = nullptr;
 
         if (hashFace)
         {
@@ -3729,7 +4050,7 @@ void vtkRectilinearGridConnectivity::AddInterProcessPolygonsToFaceHash(
           {
             // This is an internal face. It has been removed from the hash when
             // the hash attempts to accept it for the second time, though it is
-            // accessible until a new face is allocated from the recycle bin.
+            // accessible until faces are inserted in the hash again.
 
             if (hashFace->FragmentId != minIndex && minIndex < fragIndx)
             {
@@ -3744,7 +4065,8 @@ void vtkRectilinearGridConnectivity::AddInterProcessPolygonsToFaceHash(
               // 'macro' volume (R) is connected with two currently un-merged 'macro'
               // volumes S and T. Thus we need to make the fragment Ids of 'macro'
               // volumes S and T equivalent to each other.
-              this->EquivalenceSet->AddEquivalence(minIndex, hashFace->FragmentId);
+              equivalentIds1.push_back(minIndex);
+              equivalentIds2.push_back(hashFace->FragmentId);
             }
 
             // keep track of the smallest fragment id to use for this 'macro' volume
@@ -3788,7 +4110,8 @@ void vtkRectilinearGridConnectivity::AddInterProcessPolygonsToFaceHash(
         // (otherwise minIndex would have been updated to be less than fragIndx
         // in case A above). The code below ensures the correct number of
         // equivalence members.
-        this->EquivalenceSet->AddEquivalence(fragIndx, fragIndx);
+        equivalentIds1.push_back(fragIndx);
+        equivalentIds2.push_back(fragIndx);
         fragIndx++;
       }
 
@@ -3829,6 +4152,9 @@ void vtkRectilinearGridConnectivity::AddInterProcessPolygonsToFaceHash(
   attrPtrs = nullptr;
   numComps = nullptr;
   tupleBuf = nullptr;
+
+  this->EquivalenceSet->AddEquivalences(
+    equivalentIds1.data(), equivalentIds2.data(), static_cast<vtkIdType>(equivalentIds1.size()));
 }
 
 //-----------------------------------------------------------------------------
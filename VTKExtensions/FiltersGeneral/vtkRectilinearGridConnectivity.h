@@ -57,6 +57,21 @@
  *  fragment Id are retrieved from the input vtkPolyData and hence combined by
  *  means of the same fragemnt Id.
  *
+ *  The blocks are processed one at a time, in block order. Marching cubes is
+ *  run concurrently (via vtkSMPTools) on slabs of cube layers of the block and
+ *  the slabs are then appended in order, so that only the polyhedra of one
+ *  block are kept in memory. The face hash is an open-addressing hash whose
+ *  slots are found concurrently for all the polygons of a block (intra-block
+ *  level) or of a set of fragments (inter-block and inter-process levels).
+ *  The polygons are then added to the hash in order, so that the fragments do
+ *  not depend on the number of threads. The intra-block face hash only holds
+ *  the polyhedra of a block and is freed once the block is resolved, while the
+ *  inter-block face hash is global: it holds the exterior polygons of the
+ *  fragments of all the blocks. With StreamBlocks on, the exterior polygons of
+ *  each block are added to the inter-block face hash as soon as the block is
+ *  resolved, and the polygons that turn out to be internal are freed once all
+ *  the blocks that the block touches have been added.
+ *
  * @sa
  *  vtkGridConnectivity vtkExtractCTHPart vtkPolyData vtkRectilinearGrid
  *  vtkMultiBlockDataSetAlgorithm
@@ -95,6 +110,19 @@ public:
   vtkGetMacro(VolumeFractionSurfaceValue, double);
   ///@}
 
+  ///@{
+  /**
+   * Set / get whether the exterior polygons of each block are added to the
+   * inter-block face hash as soon as the block is resolved, instead of once
+   * all the blocks have been resolved. Polygons shared by two blocks are then
+   * freed block by block, which lowers the memory used by datasets with many
+   * blocks. The output does not depend on this flag. Off by default.
+   */
+  vtkSetMacro(StreamBlocks, bool);
+  vtkGetMacro(StreamBlocks, bool);
+  vtkBooleanMacro(StreamBlocks, bool);
+  ///@}
+
   /**
    * Remove all volume array names.
    */
@@ -144,6 +172,7 @@ protected:
   double DataBlocksTime;
   double DualGridBounds[6];
   double VolumeFractionSurfaceValue;
+  bool StreamBlocks;
   vtkDoubleArray* FragmentValues;
   vtkEquivalenceSet* EquivalenceSet;
   vtkRectilinearGrid** DualGridBlocks;
@@ -283,15 +312,25 @@ protected:
   // These resulting polyhedra are stored in the output vtkPolyData (plyHedra).
   // All point data attributes except for non-selected volume fraction arrays
   // are integrated when marching cubes. The integrated attribute arrays are
-  // attached to the polyhedra's faces as the cell data.
+  // attached to the polyhedra's faces as the cell data. The slabs of cube
+  // layers are processed concurrently by ExtractSlabPolyhedra() and appended
+  // in order.
   void ExtractFragmentPolyhedra(
     vtkRectilinearGrid* rectGrid, const char* fracName, double isoValue, vtkPolyData* plyHedra);
 
+  /**
+   * Performs marching cubes, as ExtractFragmentPolyhedra() does, on the layers
+   * of cubes [kBegin, kEnd) of a data block only. The volume Ids of the slab
+   * (slabHedra) start at 0.
+   */
+  void ExtractSlabPolyhedra(vtkRectilinearGrid* rectGrid, const char* fracName, double isoValue,
+    int kBegin, int kEnd, vtkPolyData* slabHedra);
+
   /**
    * Given a vtkPolyData (plyHedra) storing the polygons of the greater-than-
    * isovalue sub-volumes (or polyhedra) extracted from a data block, this
-   * function initializes the size of the face hash (with the number of points
-   * of the polyhedra) used to maintain the polygons of the polyhedra.
+   * function initializes the size of the face hash (with the number of
+   * polygons of the polyhedra) used to maintain the polygons of the polyhedra.
    */
   void InitializeFaceHash(vtkPolyData* plyHedra);
 
@@ -339,9 +378,8 @@ protected:
   /**
    * Given a number (numPolys) of vtkPolyData objects (plyDatas) storing the
    * fragments extracted from the multiple data blocks, this function inits
-   * the face hash (with the maximum global inter-block point Id: a point data
-   * attribute attached to each point of these vtkPolyData objects) that is
-   * used to combine these intermediate fragments.
+   * the face hash (with the total number of polygons of these vtkPolyData
+   * objects) that is used to combine these intermediate fragments.
    */
   void InitializeFaceHash(vtkPolyData** plyDatas, int numPolys);
 
@@ -361,6 +399,24 @@ protected:
    */
   void AddPolygonsToFaceHash(vtkPolyData** plyDatas, int* maxFsize, int numPolys);
 
+  /**
+   * Pushes the polygons of the fragments extracted from a single block
+   * (blockIdx), as AddPolygonsToFaceHash() does for all the blocks. The next
+   * fragment Id and the equivalences found so far are kept across the calls
+   * and the equivalences are only added to the equivalence set by
+   * AddPolygonsToFaceHash(), or by ExtractFragments() in streaming mode.
+   */
+  void AddSurfaceToFaceHash(int blockIdx, vtkPolyData* surface, int maxFsize);
+
+  /**
+   * Once all the blocks that a block (blockIdx) touches have been pushed to
+   * the inter-block face hash, removes from the polygons of the block
+   * (surface) those that are no longer in the face hash, i.e., the polygons
+   * shared with another block. The faces left in the hash are updated with
+   * the new polygon Ids.
+   */
+  void RemoveInternalPolygons(int blockIdx, vtkPolyData* surface);
+
   /**
    * With the intra-process inter-block equivalence set resolved, intra-process
    * inter-block fragment Ids resolved, and cell data attributes integrated by
@@ -90,50 +90,10 @@ int vtkSurfaceVectors::RequestData(vtkInformation* vtkNotUsed(request),
     newVectors->SetName(inVectors->GetName());
   }
 
-  // Helper function to compute the normal of a point
-  const auto ComputeNormal = [&input, &cellIds, &ptIds]() -> vtkVector3d
-  {
-    vtkVector3d normal(0.0);
-    for (int i = 0; i < cellIds->GetNumberOfIds(); ++i)
-    {
-      const vtkIdType cellId = cellIds->GetId(i);
-      const vtkIdType cellType = input->GetCellType(cellId);
-
-      if (cellType == VTK_VOXEL || cellType == VTK_POLYGON || cellType == VTK_TRIANGLE ||
-        cellType == VTK_QUAD || cellType == VTK_PIXEL)
-      {
-        input->GetCellPoints(cellId, ptIds);
-
-        vtkVector3d p1, p2, p3;
-        input->GetPoint(ptIds->GetId(0), p1.GetData());
-        input->GetPoint(ptIds->GetId(1), p2.GetData());
-        input->GetPoint(ptIds->GetId(2), p3.GetData());
-
-        const vtkVector3d v1 = p2 - p1;
-        const vtkVector3d v2 = p3 - p1;
-
-        const vtkVector3d cross = v1.Cross(v2);
-
-        // We check the current normal orientation against
-        // the computed one so far: if they have the same orientation
-        // (ie the scalar product is positive) we add it to normal
-        // otherwise we add its negated version.
-        //
-        // This ensures that two opposite normals don't cancel each other
-        // (for example (1, 0, 0) and (-1, 0, 0) gives the same general
-        // direction but the sum is zero).
-        normal += cross.Dot(normal) > 0 ? cross : -cross;
-      }
-    }
-
-    return normal.Normalized();
-  };
-
   for (vtkIdType pointId = 0; pointId < numPoints; ++pointId)
   {
-    input->GetPointCells(pointId, cellIds);
-
-    const vtkVector3d normal = ComputeNormal();
+    vtkVector3d normal;
+    vtkSurfaceVectors::ComputePointNormal(input, pointId, cellIds, ptIds, normal.GetData());
 
     vtkVector3d inVector;
     inVectors->GetTuple(pointId, inVector.GetData());
@@ -174,6 +134,51 @@ int vtkSurfaceVectors::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+void vtkSurfaceVectors::ComputePointNormal(
+  vtkDataSet* input, vtkIdType pointId, vtkIdList* cellIds, vtkIdList* ptIds, double normal[3])
+{
+  input->GetPointCells(pointId, cellIds);
+
+  vtkVector3d sum(0.0);
+  for (int i = 0; i < cellIds->GetNumberOfIds(); ++i)
+  {
+    const vtkIdType cellId = cellIds->GetId(i);
+    const vtkIdType cellType = input->GetCellType(cellId);
+
+    if (cellType == VTK_VOXEL || cellType == VTK_POLYGON || cellType == VTK_TRIANGLE ||
+      cellType == VTK_QUAD || cellType == VTK_PIXEL)
+    {
+      input->GetCellPoints(cellId, ptIds);
+
+      vtkVector3d p1, p2, p3;
+      input->GetPoint(ptIds->GetId(0), p1.GetData());
+      input->GetPoint(ptIds->GetId(1), p2.GetData());
+      input->GetPoint(ptIds->GetId(2), p3.GetData());
+
+      const vtkVector3d v1 = p2 - p1;
+      const vtkVector3d v2 = p3 - p1;
+
+      const vtkVector3d cross = v1.Cross(v2);
+
+      // We check the current normal orientation against
+      // the computed one so far: if they have the same orientation
+      // (ie the scalar product is positive) we add it to normal
+      // otherwise we add its negated version.
+      //
+      // This ensures that two opposite normals don't cancel each other
+      // (for example (1, 0, 0) and (-1, 0, 0) gives the same general
+      // direction but the sum is zero).
+      sum += cross.Dot(sum) > 0 ? cross : -cross;
+    }
+  }
+
+  const vtkVector3d unit = sum.Normalized();
+  normal[0] = unit[0];
+  normal[1] = unit[1];
+  normal[2] = unit[2];
+}
+
 //-----------------------------------------------------------------------------
 void vtkSurfaceVectors::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -16,6 +16,7 @@
 #include "vtkDataSetAlgorithm.h"
 #include "vtkPVVTKExtensionsFiltersGeneralModule.h" //needed for exports
 
+class vtkDataSet;
 class vtkFloatArray;
 class vtkIdList;
 
@@ -52,6 +53,15 @@ public:
   }
   ///@}
 
+  /**
+   * Computes into `normal` the unit normal at point `pointId` of `input`,
+   * averaged over the 2D cells that use the point. `cellIds` and `ptIds` are
+   * scratch lists, so this can be called from several threads once the cells
+   * and the point to cell links of `input` have been built.
+   */
+  static void ComputePointNormal(
+    vtkDataSet* input, vtkIdType pointId, vtkIdList* cellIds, vtkIdList* ptIds, double normal[3]);
+
 protected:
   vtkSurfaceVectors();
   ~vtkSurfaceVectors() override;
@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkDummyController.h"
+#include "vtkMaterialInterfaceFilter.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
+#include "vtkNonOverlappingAMR.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkUniformGrid.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    std::cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                   \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+const int BlockSize = 8;
+const int BlocksPerAxis = 2;
+
+// Three fragments: a sphere that crosses all the blocks, a small sphere in
+// the first block and a bar along x that crosses two blocks.
+bool IsInside(int i, int j, int k)
+{
+  auto distance = [&](double cx, double cy, double cz) {
+    return std::sqrt((i + 0.5 - cx) * (i + 0.5 - cx) + (j + 0.5 - cy) * (j + 0.5 - cy) +
+      (k + 0.5 - cz) * (k + 0.5 - cz));
+  };
+  return distance(8, 8, 8) < 5.0 || distance(3, 3, 3) < 2.0 ||
+    (j >= 13 && j <= 14 && k >= 13 && k <= 14);
+}
+
+vtkSmartPointer<vtkNonOverlappingAMR> MakeInput(int& numberOfInsideCells)
+{
+  const int numBlocks = BlocksPerAxis * BlocksPerAxis * BlocksPerAxis;
+  auto amr = vtkSmartPointer<vtkNonOverlappingAMR>::New();
+  int blocksPerLevel[1] = { numBlocks };
+  amr->Initialize(1, blocksPerLevel);
+  numberOfInsideCells = 0;
+  int blockId = 0;
+  for (int bz = 0; bz < BlocksPerAxis; ++bz)
+  {
+    for (int by = 0; by < BlocksPerAxis; ++by)
+    {
+      for (int bx = 0; bx < BlocksPerAxis; ++bx, ++blockId)
+      {
+        vtkNew<vtkUniformGrid> grid;
+        grid->SetOrigin(bx * BlockSize, by * BlockSize, bz * BlockSize);
+        grid->SetSpacing(1, 1, 1);
+        grid->SetDimensions(BlockSize + 1, BlockSize + 1, BlockSize + 1);
+        vtkNew<vtkUnsignedCharArray> volumeFraction;
+        volumeFraction->SetName("vf");
+        volumeFraction->SetNumberOfTuples(grid->GetNumberOfCells());
+        vtkNew<vtkDoubleArray> mass;
+        mass->SetName("mass");
+        mass->SetNumberOfTuples(grid->GetNumberOfCells());
+        vtkIdType cellId = 0;
+        for (int k = 0; k < BlockSize; ++k)
+        {
+          for (int j = 0; j < BlockSize; ++j)
+          {
+            for (int i = 0; i < BlockSize; ++i, ++cellId)
+            {
+              const bool inside =
+                IsInside(bx * BlockSize + i, by * BlockSize + j, bz * BlockSize + k);
+              volumeFraction->SetValue(cellId, inside ? 255 : 0);
+              mass->SetValue(cellId, inside ? 1.0 : 0.0);
+              numberOfInsideCells += inside ? 1 : 0;
+            }
+          }
+        }
+        grid->GetCellData()->AddArray(volumeFraction);
+        grid->GetCellData()->AddArray(mass);
+        amr->SetDataSet(0, blockId, grid);
+      }
+    }
+  }
+  return amr;
+}
+
+struct Fragments
+{
+  std::vector<double> Volumes;
+  std::vector<double> Masses;
+  std::vector<vtkIdType> NumberOfPoints;
+  std::vector<vtkIdType> NumberOfCells;
+};
+
+bool Extract(vtkNonOverlappingAMR* input, int numberOfThreads, Fragments& fragments)
+{
+  bool status = false;
+  vtkSMPTools::LocalScope(vtkSMPTools::Config{ numberOfThreads }, [&]() {
+    vtkNew<vtkMaterialInterfaceFilter> filter;
+    filter->SetInputData(input);
+    filter->SelectMaterialArray("vf");
+    filter->SelectMassArray("mass");
+    filter->Update();
+
+    auto statistics = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(1));
+    auto centers = statistics ? vtkPolyData::SafeDownCast(statistics->GetBlock(0)) : nullptr;
+    vtkDataArray* volumes = centers ? centers->GetPointData()->GetArray("Volume") : nullptr;
+    vtkDataArray* masses = centers ? centers->GetPointData()->GetArray("Mass") : nullptr;
+    auto geometry = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+    auto pieces = geometry ? vtkMultiPieceDataSet::SafeDownCast(geometry->GetBlock(0)) : nullptr;
+    if (!volumes || !masses || !pieces)
+    {
+      return;
+    }
+    for (vtkIdType cc = 0; cc < volumes->GetNumberOfTuples(); ++cc)
+    {
+      fragments.Volumes.push_back(volumes->GetTuple1(cc));
+      fragments.Masses.push_back(masses->GetTuple1(cc));
+    }
+    for (unsigned int cc = 0; cc < pieces->GetNumberOfPieces(); ++cc)
+    {
+      auto piece = vtkPolyData::SafeDownCast(pieces->GetPiece(cc));
+      fragments.NumberOfPoints.push_back(piece ? piece->GetNumberOfPoints() : -1);
+      fragments.NumberOfCells.push_back(piece ? piece->GetNumberOfCells() : -1);
+    }
+    status = true;
+  });
+  return status;
+}
+}
+
+extern int TestMaterialInterfaceFilterThreads(int, char*[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int numberOfInsideCells;
+  vtkSmartPointer<vtkNonOverlappingAMR> input = MakeInput(numberOfInsideCells);
+
+  Fragments serial;
+  TASSERT(Extract(input, 1, serial));
+  TASSERT(serial.Volumes.size() == 3);
+  double totalVolume = 0.0;
+  double totalMass = 0.0;
+  for (size_t cc = 0; cc < serial.Volumes.size(); ++cc)
+  {
+    totalVolume += serial.Volumes[cc];
+    totalMass += serial.Masses[cc];
+  }
+  TASSERT(std::abs(totalVolume - numberOfInsideCells) < 1e-6);
+  TASSERT(std::abs(totalMass - numberOfInsideCells) < 1e-6);
+
+  // Fragment ids, and so the order of the fragments, must not depend on the
+  // number of threads.
+  for (int numberOfThreads : { 2, 4, 8 })
+  {
+    Fragments threaded;
+    TASSERT(Extract(input, numberOfThreads, threaded));
+    TASSERT(threaded.Volumes == serial.Volumes);
+    TASSERT(threaded.Masses == serial.Masses);
+    TASSERT(threaded.NumberOfPoints == serial.NumberOfPoints);
+    TASSERT(threaded.NumberOfCells == serial.NumberOfCells);
+  }
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return EXIT_SUCCESS;
+}
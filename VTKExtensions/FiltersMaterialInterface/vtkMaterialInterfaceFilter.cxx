@@ -32,6 +32,7 @@
 #include "vtkCollection.h"
 #include "vtkDataObject.h"
 #include "vtkDoubleArray.h"
+#include "vtkEquivalenceSet.h"
 #include "vtkFloatArray.h"
 #include "vtkIntArray.h"
 #include "vtkMaterialInterfaceIdList.h"
@@ -43,6 +44,7 @@
 #include "vtkMaterialInterfaceToProcMap.h"
 #include "vtkPointAccumulator.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedIntArray.h"
 // IO & IPC
@@ -229,230 +231,6 @@ int GetEnabledArrayNames(vtkDataArraySelection* das, vector<string>& names)
   return nEnabled;
 }
 };
-//============================================================================
-// A class that implements an equivalent set.  It is used to combine fragments
-// from different processes.
-//
-// I believe that this class is a strictly ordered tree of equivalences.
-// Every member points to its own id or an id smaller than itself.
-class vtkMaterialInterfaceEquivalenceSet
-{
-public:
-  vtkMaterialInterfaceEquivalenceSet();
-  ~vtkMaterialInterfaceEquivalenceSet();
-
-  void Print();
-
-  void Initialize();
-  void AddEquivalence(int id1, int id2);
-
-  // The length of the equivalent array...
-  int GetNumberOfMembers() { return this->EquivalenceArray->GetNumberOfTuples(); }
-
-  // Return the id of the equivalent set.
-  int GetEquivalentSetId(int memberId);
-
-  // Equivalent set ids are reassinged to be sequential.
-  // You cannot add anymore equivalences after this is called.
-  int ResolveEquivalences();
-
-  void DeepCopy(vtkMaterialInterfaceEquivalenceSet* in);
-
-  // Needed for sending the set over MPI.
-  // Be very careful with the pointer.
-  int* GetPointer() { return this->EquivalenceArray->GetPointer(0); }
-
-  // Free unused memory
-  void Squeeze() { this->EquivalenceArray->Squeeze(); }
-
-  // Report used memory
-  vtkIdType Capacity() { return this->EquivalenceArray->GetCapacity(); }
-
-  // We should fix the pointer API and hide this ivar.
-  int Resolved;
-
-private:
-  // To merge connected framgments that have different ids because they were
-  // traversed by different processes or passes.
-  vtkIntArray* EquivalenceArray;
-
-  // Return the id of the equivalent set.
-  int GetReference(int memberId);
-  void EquateInternal(int id1, int id2);
-};
-
-//----------------------------------------------------------------------------
-vtkMaterialInterfaceEquivalenceSet::vtkMaterialInterfaceEquivalenceSet()
-{
-  this->Resolved = 0;
-  this->EquivalenceArray = vtkIntArray::New();
-}
-
-//----------------------------------------------------------------------------
-vtkMaterialInterfaceEquivalenceSet::~vtkMaterialInterfaceEquivalenceSet()
-{
-  this->Resolved = 0;
-  if (this->EquivalenceArray)
-  {
-    this->EquivalenceArray->Delete();
-    this->EquivalenceArray = nullptr;
-  }
-}
-
-//----------------------------------------------------------------------------
-void vtkMaterialInterfaceEquivalenceSet::Initialize()
-{
-  this->Resolved = 0;
-  this->EquivalenceArray->Initialize();
-}
-
-//----------------------------------------------------------------------------
-void vtkMaterialInterfaceEquivalenceSet::DeepCopy(vtkMaterialInterfaceEquivalenceSet* in)
-{
-  this->Resolved = in->Resolved;
-  this->EquivalenceArray->DeepCopy(in->EquivalenceArray);
-}
-
-//----------------------------------------------------------------------------
-void vtkMaterialInterfaceEquivalenceSet::Print()
-{
-  vtkIdType num = this->GetNumberOfMembers();
-  std::cerr << num << endl;
-  for (vtkIdType ii = 0; ii < num; ++ii)
-  {
-    std::cerr << "  " << ii << " : " << this->GetEquivalentSetId(ii) << endl;
-  }
-  std::cerr << endl;
-}
-
-//----------------------------------------------------------------------------
-// Return the id of the equivalent set.
-int vtkMaterialInterfaceEquivalenceSet::GetEquivalentSetId(int memberId)
-{
-  int ref;
-
-  ref = this->GetReference(memberId);
-  while (!this->Resolved && ref != memberId)
-  {
-    memberId = ref;
-    ref = this->GetReference(memberId);
-  }
-
-  return ref;
-}
-
-//----------------------------------------------------------------------------
-// Return the id of the equivalent set.
-int vtkMaterialInterfaceEquivalenceSet::GetReference(int memberId)
-{
-  if (memberId >= this->EquivalenceArray->GetNumberOfTuples())
-  { // We might consider this an error ...
-    return memberId;
-  }
-  return this->EquivalenceArray->GetValue(memberId);
-}
-
-//----------------------------------------------------------------------------
-// Makes two new or existing ids equivalent.
-// If the array is too small, the range of ids is increased until it contains
-// both the ids.  Negative ids are not allowed.
-void vtkMaterialInterfaceEquivalenceSet::AddEquivalence(int id1, int id2)
-{
-  if (this->Resolved)
-  {
-    vtkGenericWarningMacro("Set already resolved, you cannot add more equivalences.");
-    return;
-  }
-
-  int num = this->EquivalenceArray->GetNumberOfTuples();
-
-  // Expand the range to include both ids.
-  while (num <= id1 || num <= id2)
-  {
-    // All values inserted are equivalent to only themselves.
-    this->EquivalenceArray->InsertNextTuple1(num);
-    ++num;
-  }
-
-  // Our rule for references in the equivalent set is that
-  // all elements must point to a member equal to or smaller
-  // than itself.
-
-  // The only problem we could encounter is changing a reference.
-  // we do not want to orphan anything previously referenced.
-
-  // Replace the larger references.
-  if (id1 < id2)
-  {
-    // We could follow the references to the smallest.  It might
-    // make this processing more efficient.  This is a compromise.
-    // The referenced id will always be smaller than the id so
-    // order does not change.
-    this->EquateInternal(this->GetReference(id1), id2);
-  }
-  else
-  {
-    this->EquateInternal(this->GetReference(id2), id1);
-  }
-}
-
-//----------------------------------------------------------------------------
-// id1 must be less than or equal to id2.
-void vtkMaterialInterfaceEquivalenceSet::EquateInternal(int id1, int id2)
-{
-  // This is the reference that might be orphaned in this process.
-  int oldRef = this->GetEquivalentSetId(id2);
-
-  // The only problem we could encounter is changing a reference.
-  // we do not want to orphan anything previously referenced.
-  if (oldRef == id2 || oldRef == id1)
-  {
-    this->EquivalenceArray->SetValue(id2, id1);
-  }
-  else if (oldRef > id1)
-  {
-    this->EquivalenceArray->SetValue(id2, id1);
-    this->EquateInternal(id1, oldRef);
-  }
-  else
-  { // oldRef < id1
-    this->EquateInternal(oldRef, id1);
-  }
-}
-
-//----------------------------------------------------------------------------
-// Returns the number of merged sets.
-int vtkMaterialInterfaceEquivalenceSet::ResolveEquivalences()
-{
-  // Go through the equivalence array collapsing chains
-  // and assigning consecutive ids.
-  int count = 0;
-  int id;
-  int newId;
-
-  int numIds = this->EquivalenceArray->GetNumberOfTuples();
-  for (int ii = 0; ii < numIds; ++ii)
-  {
-    id = this->EquivalenceArray->GetValue(ii);
-    if (id == ii)
-    { // This is a new equivalence set.
-      this->EquivalenceArray->SetValue(ii, count);
-      ++count;
-    }
-    else
-    {
-      // All earlier ids will be resolved already.
-      // This array only point to less than or equal ids. (id <= ii).
-      newId = this->EquivalenceArray->GetValue(id);
-      this->EquivalenceArray->SetValue(ii, newId);
-    }
-  }
-  this->Resolved = 1;
-  // std::cerr << "Final number of equivalent sets: " << count << endl;
-
-  return count;
-}
-
 //============================================================================
 // Helper object to clip hexahedra with implicit half sphere.
 class vtkMaterialInterfaceFilterHalfSphere
@@ -1529,6 +1307,68 @@ int vtkMaterialInterfaceFilterRingBuffer::Pop(vtkMaterialInterfaceFilterIterator
   return 1;
 }
 
+//============================================================================
+// The fragments found in a single block. Blocks are labeled concurrently, so
+// each block has its own accumulators and scratch space to build faces, and
+// keeps the attributes of its fragments until all the blocks are labeled.
+// Fragment ids are local to the block until then.
+class vtkMaterialInterfaceFilterBlockFragments
+{
+public:
+  vtkMaterialInterfaceFilterBlockFragments() = default;
+  ~vtkMaterialInterfaceFilterBlockFragments()
+  {
+    ClearVectorOfVtkPointers(this->FragmentMeshes);
+    CheckAndReleaseVtkPointer(this->CurrentFragmentMesh);
+  }
+  vtkMaterialInterfaceFilterBlockFragments(
+    const vtkMaterialInterfaceFilterBlockFragments&) = delete;
+  void operator=(const vtkMaterialInterfaceFilterBlockFragments&) = delete;
+
+  // The block being labeled. The ghost blocks are labeled together once
+  // all the local blocks are done, in which case this is nullptr.
+  vtkMaterialInterfaceFilterBlock* Block = nullptr;
+  // Returns true when the search may label the voxels of the block.
+  bool Owns(vtkMaterialInterfaceFilterBlock* block) const
+  {
+    return this->Block ? block == this->Block : block->GetGhostFlag() != 0;
+  }
+
+  // Ivars for computing the point on corners and edges of a face.
+  vtkMaterialInterfaceFilterIterator FaceNeighbors[32];
+  double FaceCornerPoints[12];
+  double FaceEdgePoints[12];
+  int FaceEdgeFlags[4];
+
+  // Accumulators for the current fragment.
+  vtkPolyData* CurrentFragmentMesh = nullptr;
+  double FragmentVolume = 0.0;
+  double ClipDepthMin = VTK_FLOAT_MAX;
+  double ClipDepthMax = 0.0;
+  vector<double> FragmentMoment; // =(Myz, Mxz, Mxy, m)
+  vector<vector<double>> FragmentVolumeWtdAvg;
+  vector<vector<double>> FragmentMassWtdAvg;
+  vector<vector<double>> FragmentSum;
+
+  // Attributes of the fragments found so far, indexed by local id. Tuples
+  // are stored one after the other.
+  vector<vtkPolyData*> FragmentMeshes;
+  vector<double> FragmentVolumes;
+  vector<double> ClipDepthMinimums;
+  vector<double> ClipDepthMaximums;
+  vector<double> FragmentMoments;
+  vector<vector<double>> FragmentVolumeWtdAvgs;
+  vector<vector<double>> FragmentMassWtdAvgs;
+  vector<vector<double>> FragmentSums;
+
+  // Voxels the search is not allowed to label, or that were labeled by
+  // another search, that are face connected to a fragment. Each one is
+  // stored with the id of that fragment.
+  vector<std::pair<int, vtkMaterialInterfaceFilterIterator>> Links;
+  // Pairs of fragment ids to merge, resolved from the links.
+  vector<std::pair<int, int>> Equivalences;
+};
+
 //============================================================================
 
 //----------------------------------------------------------------------------
@@ -1599,21 +1439,17 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
   this->RootSpacing[0] = this->RootSpacing[1] = this->RootSpacing[2] = 1.0;
 
   this->FragmentId = 0;
-  this->FragmentVolume = 0.0;
   this->FragmentVolumes = nullptr;
-  this->FragmentMoment.resize(4, 0.0);
   this->FragmentMoments = nullptr;
   this->FragmentAABBCenters = nullptr;
   this->FragmentOBBs = nullptr;
   this->FragmentSplitGeometry = nullptr;
 
   // Keep depth of crater along clip plane normal.
-  this->ClipDepthMax = 0.0;
-  this->ClipDepthMin = VTK_FLOAT_MAX;
   this->ClipDepthMaximums = nullptr;
   this->ClipDepthMinimums = nullptr;
 
-  this->EquivalenceSet = new vtkMaterialInterfaceEquivalenceSet;
+  this->EquivalenceSet = vtkEquivalenceSet::New();
   this->LocalToGlobalOffsets = nullptr;
   this->TotalNumberOfRawFragments = 0;
   this->NumberOfResolvedFragments = 0;
@@ -1624,10 +1460,6 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
   this->ResolvedFragmentCenters = nullptr;
   this->ResolvedFragmentOBBs = nullptr;
 
-  this->FaceNeighbors = new vtkMaterialInterfaceFilterIterator[32];
-
-  this->CurrentFragmentMesh = nullptr;
-
   this->NVolumeWtdAvgs = 0;
   this->NToSum = 0;
   this->ComputeMoments = false;
@@ -1670,9 +1502,6 @@ vtkMaterialInterfaceFilter::~vtkMaterialInterfaceFilter()
   this->RootSpacing[0] = this->RootSpacing[1] = this->RootSpacing[2] = 1.0;
 
   this->FragmentId = 0;
-  this->FragmentVolume = 0.0;
-  this->ClipDepthMax = 0.0;
-  this->ClipDepthMin = VTK_FLOAT_MAX;
 
   this->SetClipFunction(nullptr);
 
@@ -1687,12 +1516,9 @@ vtkMaterialInterfaceFilter::~vtkMaterialInterfaceFilter()
   ClearVectorOfVtkPointers(this->FragmentMassWtdAvgs);
   ClearVectorOfVtkPointers(this->FragmentSums);
 
-  delete this->EquivalenceSet;
+  this->EquivalenceSet->Delete();
   this->EquivalenceSet = nullptr;
 
-  delete[] this->FaceNeighbors;
-  this->FaceNeighbors = nullptr;
-
   // clean up PV interface
   this->MaterialArraySelection->RemoveObserver(this->SelectionObserver);
   this->MaterialArraySelection->Delete();
@@ -1883,18 +1709,13 @@ int vtkMaterialInterfaceFilter::InitializeBlocks(vtkNonOverlappingAMR* input,
     this->InputBlocks[blockId] = nullptr;
   }
 
-  // Initialize each block with the input image
-  // and global index coordinate system.
-  int blockIndex = -1;
-  this->Levels.resize(numLevels);
+  // Collect the images of all the levels. Block ids follow the level
+  // ordering.
+  vector<vtkImageData*> blockImages;
+  vector<int> blockLevels;
+  vector<int> levelBlockIds;
   for (level = 0; level < numLevels; ++level)
   {
-    this->Levels[level] = new vtkMaterialInterfaceLevel;
-
-    int cumulativeExt[6];
-    cumulativeExt[0] = cumulativeExt[2] = cumulativeExt[4] = VTK_INT_MAX;
-    cumulativeExt[1] = cumulativeExt[3] = cumulativeExt[5] = -VTK_INT_MAX;
-
     int numBlocks = input->GetNumberOfBlocks(level);
     for (int levelBlockId = 0; levelBlockId < numBlocks; ++levelBlockId)
     {
@@ -1904,32 +1725,65 @@ int vtkMaterialInterfaceFilter::InitializeBlocks(vtkNonOverlappingAMR* input,
 
       if (image)
       {
-        block = this->InputBlocks[++blockIndex] = new vtkMaterialInterfaceFilterBlock;
-        // Do we really need the block to know its id?
-        // We use it to find neighbors.  We should save pointers
-        // directly in neighbor array. We also use it for debugging.
-        block->Initialize(blockIndex, image, level, this->GlobalOrigin, this->RootSpacing,
-          materialFractionArrayName, massArrayName, volumeWtdAvgArrayNames, massWtdAvgArrayNames,
-          summedArrayNames, integratedArrayNames, this->InvertVolumeFraction, sphere);
-        // For debugging:
-        block->LevelBlockId = levelBlockId;
-
-        // Collect information about the blocks in this level.
-        const int* ext;
-        ext = block->GetBaseCellExtent();
-        // We need the cumulative extent to determine the grid extent.
-        cumulativeExt[0] = std::min(cumulativeExt[0], ext[0]);
-        cumulativeExt[1] = std::max(cumulativeExt[1], ext[1]);
-        cumulativeExt[2] = std::min(cumulativeExt[2], ext[2]);
-        cumulativeExt[3] = std::max(cumulativeExt[3], ext[3]);
-        cumulativeExt[4] = std::min(cumulativeExt[4], ext[4]);
-        cumulativeExt[5] = std::max(cumulativeExt[5], ext[5]);
+        blockImages.push_back(image);
+        blockLevels.push_back(level);
+        levelBlockIds.push_back(levelBlockId);
       }
       else if (cg)
       {
         vtkWarningMacro("Non vtkImageData in AMR are not supported and are skipped");
       }
     }
+  }
+
+  // Initialize each block with the input image and global index coordinate
+  // system. Blocks are independent from each other at this point, and
+  // preparing the volume fraction (inversion, clipping) is done cell by cell,
+  // so blocks are initialized concurrently.
+  vtkSMPTools::For(0, static_cast<vtkIdType>(blockImages.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType blockId = begin; blockId < end; ++blockId)
+      {
+        vtkMaterialInterfaceFilterBlock* newBlock = new vtkMaterialInterfaceFilterBlock;
+        this->InputBlocks[blockId] = newBlock;
+        // Do we really need the block to know its id?
+        // We use it to find neighbors.  We should save pointers
+        // directly in neighbor array. We also use it for debugging.
+        newBlock->Initialize(static_cast<int>(blockId), blockImages[blockId],
+          blockLevels[blockId], this->GlobalOrigin, this->RootSpacing, materialFractionArrayName,
+          massArrayName, volumeWtdAvgArrayNames, massWtdAvgArrayNames, summedArrayNames,
+          integratedArrayNames, this->InvertVolumeFraction, sphere);
+        // For debugging:
+        newBlock->LevelBlockId = levelBlockIds[blockId];
+      }
+    });
+
+  int blockIndex = 0;
+  const int numberOfImageBlocks = static_cast<int>(blockImages.size());
+  this->Levels.resize(numLevels);
+  for (level = 0; level < numLevels; ++level)
+  {
+    this->Levels[level] = new vtkMaterialInterfaceLevel;
+
+    int cumulativeExt[6];
+    cumulativeExt[0] = cumulativeExt[2] = cumulativeExt[4] = VTK_INT_MAX;
+    cumulativeExt[1] = cumulativeExt[3] = cumulativeExt[5] = -VTK_INT_MAX;
+
+    for (; blockIndex < numberOfImageBlocks && blockLevels[blockIndex] == level; ++blockIndex)
+    {
+      block = this->InputBlocks[blockIndex];
+      // Collect information about the blocks in this level.
+      const int* ext;
+      ext = block->GetBaseCellExtent();
+      // We need the cumulative extent to determine the grid extent.
+      cumulativeExt[0] = std::min(cumulativeExt[0], ext[0]);
+      cumulativeExt[1] = std::max(cumulativeExt[1], ext[1]);
+      cumulativeExt[2] = std::min(cumulativeExt[2], ext[2]);
+      cumulativeExt[3] = std::max(cumulativeExt[3], ext[3]);
+      cumulativeExt[4] = std::min(cumulativeExt[4], ext[4]);
+      cumulativeExt[5] = std::max(cumulativeExt[5], ext[5]);
+    }
 
     // Expand the grid extent by 1 in all directions to accommodate ghost blocks.
     // We might have a problem with level 0 here since blockDims is not global yet.
@@ -3123,14 +2977,11 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
 {
   this->FragmentId = 0;
 
-  this->FragmentVolume = 0.0;
   ReNewVtkPointer(this->FragmentVolumes);
   this->FragmentVolumes->SetName("Volume");
 
   if (this->ClipWithPlane)
   {
-    this->ClipDepthMax = 0.0;
-    this->ClipDepthMin = VTK_FLOAT_MAX;
     ReNewVtkPointer(this->ClipDepthMaximums);
     ReNewVtkPointer(this->ClipDepthMinimums);
     this->ClipDepthMaximums->SetName("ClipDepthMax");
@@ -3139,8 +2990,6 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
 
   if (this->ComputeMoments)
   {
-    this->FragmentMoment.clear();
-    this->FragmentMoment.resize(4, 0.0);
     ReNewVtkPointer(this->FragmentMoments);
     this->FragmentMoments->SetNumberOfComponents(4);
     this->FragmentMoments->SetName("Moments");
@@ -3175,14 +3024,13 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
   // if we got a null pointer then this indicates that
   // we do not have any blocks on this process.
 
-  // Configure data structures
+  // Configure data structures, the accumulators are sized from these
+  // when a block is processed.
   // 1) Volume weighted average of attribute over the
   // fragment set up containers
-  this->FragmentVolumeWtdAvg.clear();
-  this->FragmentVolumeWtdAvg.resize(this->NVolumeWtdAvgs);
   ClearVectorOfVtkPointers(this->FragmentVolumeWtdAvgs);
   this->FragmentVolumeWtdAvgs.resize(this->NVolumeWtdAvgs);
-  // set up data array and accumulator for each weighted average
+  // set up data array for each weighted average
   for (int j = 0; j < this->NVolumeWtdAvgs; ++j)
   {
     // data array
@@ -3201,16 +3049,12 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
     ostringstream osIntegratedArrayName;
     osIntegratedArrayName << "VolumeWeightedAverage-" << thisArrayName;
     this->FragmentVolumeWtdAvgs[j]->SetName(osIntegratedArrayName.str().c_str());
-    // accumulator
-    this->FragmentVolumeWtdAvg[j].resize(nComp, 0.0);
   }
   // 2) Mass weighted average of attribute over the fragment
   // set up containers
-  this->FragmentMassWtdAvg.clear();
-  this->FragmentMassWtdAvg.resize(this->NMassWtdAvgs);
   ClearVectorOfVtkPointers(this->FragmentMassWtdAvgs);
   this->FragmentMassWtdAvgs.resize(this->NMassWtdAvgs);
-  // set up data array and accumulator for each weighted average
+  // set up data array for each weighted average
   for (int j = 0; j < this->NMassWtdAvgs; ++j)
   {
     // data array
@@ -3229,16 +3073,12 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
     ostringstream osIntegratedArrayName;
     osIntegratedArrayName << "MassWeightedAverage-" << thisArrayName;
     this->FragmentMassWtdAvgs[j]->SetName(osIntegratedArrayName.str().c_str());
-    // accumulator
-    this->FragmentMassWtdAvg[j].resize(nComp, 0.0);
   }
   // 3) Summation of attribute over the fragment
   // set up containers
-  this->FragmentSum.clear();
-  this->FragmentSum.resize(this->NToSum);
   ClearVectorOfVtkPointers(this->FragmentSums);
   this->FragmentSums.resize(this->NToSum);
-  // set up data array and accumulator for each weighted average
+  // set up data array for each weighted average
   for (int j = 0; j < this->NToSum; ++j)
   {
     // data array
@@ -3257,8 +3097,6 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
     ostringstream osIntegratedArrayName;
     osIntegratedArrayName << "Summation-" << thisArrayName;
     this->FragmentSums[j]->SetName(osIntegratedArrayName.str().c_str());
-    // accumulator
-    this->FragmentSum[j].resize(nComp, 0.0);
   }
 
   // 4) Unique list of integrated attributes
@@ -3487,12 +3325,8 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
     // Lets profile to see what takes the most time for large number of processes.
     this->ProcessBlocksTimer->StartTimer();
 #endif
-    int blockId;
-    for (blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
-    {
-      // build fragments
-      this->ProcessBlock(blockId);
-    }
+    // build fragments
+    this->ProcessBlocks();
 #ifdef vtkMaterialInterfaceFilterPROFILE
     // Lets profile to see what takes the most time for large number of processes.
     this->ProcessBlocksTimer->StopTimer();
@@ -3636,22 +3470,213 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
 }
 
 //----------------------------------------------------------------------------
-int vtkMaterialInterfaceFilter::ProcessBlock(int blockId)
+// Labels the fragments of all the local blocks. Each block is labeled on its
+// own and concurrently with the others, then the fragments that cross block
+// boundaries are merged through the equivalence set. Fragments are numbered
+// in block order, so the ids do not depend on the number of threads.
+void vtkMaterialInterfaceFilter::ProcessBlocks()
 {
-#ifdef vtkMaterialInterfaceFilterDEBUG
-  ostringstream progressMesg;
-  progressMesg << "vtkMaterialInterfaceFilter::ProcessBlock(" << blockId << ") , Material "
-               << this->MaterialId;
-  this->SetProgressText(progressMesg.str().c_str());
-#endif
-  this->Progress += this->ProgressBlockInc;
+  const int numBlocks = this->NumberOfInputBlocks;
+  // One more for the ghost blocks.
+  vector<vtkMaterialInterfaceFilterBlockFragments> blockFragments(numBlocks + 1);
+  vtkMaterialInterfaceFilterBlockFragments& ghostFragments = blockFragments[numBlocks];
+
+  // Label the fragments of each block and extract their surface.
+  vtkSMPTools::For(0, numBlocks, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType blockId = begin; blockId < end; ++blockId)
+    {
+      this->ProcessBlock(static_cast<int>(blockId), &blockFragments[blockId]);
+    }
+  });
+  this->Progress += numBlocks * this->ProgressBlockInc;
   this->UpdateProgress(this->Progress);
 
+  // Number the fragments of the blocks one after the other.
+  vector<int> offsets(numBlocks + 1);
+  offsets[0] = this->FragmentId;
+  for (int blockId = 0; blockId < numBlocks; ++blockId)
+  {
+    offsets[blockId + 1] =
+      offsets[blockId] + static_cast<int>(blockFragments[blockId].FragmentMeshes.size());
+  }
+  const int numberOfFragments = offsets[numBlocks];
+  this->FragmentMeshes.resize(numberOfFragments, nullptr);
+  this->FragmentVolumes->SetNumberOfTuples(numberOfFragments);
+  if (this->ClipWithPlane)
+  {
+    this->ClipDepthMaximums->SetNumberOfTuples(numberOfFragments);
+    this->ClipDepthMinimums->SetNumberOfTuples(numberOfFragments);
+  }
+  if (this->ComputeMoments)
+  {
+    this->FragmentMoments->SetNumberOfTuples(numberOfFragments);
+  }
+  for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
+  {
+    this->FragmentVolumeWtdAvgs[i]->SetNumberOfTuples(numberOfFragments);
+  }
+  for (int i = 0; i < this->NMassWtdAvgs; ++i)
+  {
+    this->FragmentMassWtdAvgs[i]->SetNumberOfTuples(numberOfFragments);
+  }
+  for (int i = 0; i < this->NToSum; ++i)
+  {
+    this->FragmentSums[i]->SetNumberOfTuples(numberOfFragments);
+  }
+
+  // Turn the block local ids into process ids, and move the fragments of
+  // the blocks into the process arrays.
+  auto copyTuples = [](const vector<double>& values, vtkDoubleArray* array, int offset) {
+    std::copy(values.begin(), values.end(),
+      array->GetPointer(static_cast<vtkIdType>(offset) * array->GetNumberOfComponents()));
+  };
+  vtkSMPTools::For(0, numBlocks, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType blockId = begin; blockId < end; ++blockId)
+    {
+      vtkMaterialInterfaceFilterBlockFragments& fragments = blockFragments[blockId];
+      const int offset = offsets[blockId];
+      if (fragments.FragmentMeshes.empty())
+      {
+        continue;
+      }
+      int ext[6];
+      fragments.Block->GetCellExtent(ext);
+      const vtkIdType numCells = static_cast<vtkIdType>(ext[1] - ext[0] + 1) *
+        (ext[3] - ext[2] + 1) * (ext[5] - ext[4] + 1);
+      int* fragmentIds = fragments.Block->GetFragmentIdPointer();
+      for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+        if (fragmentIds[cellId] >= 0)
+        {
+          fragmentIds[cellId] += offset;
+        }
+      }
+      std::copy(fragments.FragmentMeshes.begin(), fragments.FragmentMeshes.end(),
+        this->FragmentMeshes.begin() + offset);
+      fragments.FragmentMeshes.clear();
+      copyTuples(fragments.FragmentVolumes, this->FragmentVolumes, offset);
+      if (this->ClipWithPlane)
+      {
+        copyTuples(fragments.ClipDepthMaximums, this->ClipDepthMaximums, offset);
+        copyTuples(fragments.ClipDepthMinimums, this->ClipDepthMinimums, offset);
+      }
+      if (this->ComputeMoments)
+      {
+        copyTuples(fragments.FragmentMoments, this->FragmentMoments, offset);
+      }
+      for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
+      {
+        copyTuples(fragments.FragmentVolumeWtdAvgs[i], this->FragmentVolumeWtdAvgs[i], offset);
+      }
+      for (int i = 0; i < this->NMassWtdAvgs; ++i)
+      {
+        copyTuples(fragments.FragmentMassWtdAvgs[i], this->FragmentMassWtdAvgs[i], offset);
+      }
+      for (int i = 0; i < this->NToSum; ++i)
+      {
+        copyTuples(fragments.FragmentSums[i], this->FragmentSums[i], offset);
+      }
+    }
+  });
+
+  // Ghost blocks are only labeled where they touch the fragments of the
+  // local blocks. Follow the links into ghost blocks, in block order.
+  vtkMaterialInterfaceFilterRingBuffer queue;
+  for (int blockId = 0; blockId < numBlocks; ++blockId)
+  {
+    for (auto& link : blockFragments[blockId].Links)
+    {
+      vtkMaterialInterfaceFilterIterator& neighbor = link.second;
+      if (!neighbor.Block->GetGhostFlag() || *(neighbor.FragmentIdPointer) != -1)
+      {
+        continue;
+      }
+      *(neighbor.FragmentIdPointer) = link.first + offsets[blockId];
+      queue.Push(&neighbor);
+      this->ConnectFragment(&queue, &ghostFragments);
+    }
+  }
+
+  // Resolve the links into pairs of equivalent fragments. The links of the
+  // ghost blocks already use process ids.
+  vtkSMPTools::For(0, numBlocks + 1, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType blockId = begin; blockId < end; ++blockId)
+    {
+      vtkMaterialInterfaceFilterBlockFragments& fragments = blockFragments[blockId];
+      const int offset = blockId < numBlocks ? offsets[blockId] : 0;
+      for (const auto& link : fragments.Links)
+      {
+        const int id1 = link.first + offset;
+        const int id2 = *(link.second.FragmentIdPointer);
+        if (id2 >= 0 && id1 != id2)
+        {
+          fragments.Equivalences.emplace_back(std::min(id1, id2), std::max(id1, id2));
+        }
+      }
+      std::sort(fragments.Equivalences.begin(), fragments.Equivalences.end());
+      fragments.Equivalences.erase(
+        std::unique(fragments.Equivalences.begin(), fragments.Equivalences.end()),
+        fragments.Equivalences.end());
+    }
+  });
+
+  // Merge the fragments. The equivalence set numbers its sets by their
+  // smallest member, so the result does not depend on the merge order.
+  this->FragmentId = numberOfFragments;
+  if (numberOfFragments > 0)
+  {
+    this->EquivalenceSet->AddEquivalence(numberOfFragments - 1, numberOfFragments - 1);
+  }
+  std::vector<int> ids1;
+  std::vector<int> ids2;
+  for (const auto& fragments : blockFragments)
+  {
+    for (const auto& equivalence : fragments.Equivalences)
+    {
+      ids1.push_back(equivalence.first);
+      ids2.push_back(equivalence.second);
+    }
+  }
+  this->EquivalenceSet->AddEquivalences(
+    ids1.data(), ids2.data(), static_cast<vtkIdType>(ids1.size()));
+}
+
+//----------------------------------------------------------------------------
+// Labels the fragments of a single block with block local ids and extracts
+// their surface. The search stays in the block: the voxels of other blocks
+// are kept as links and merged once all the blocks have been labeled.
+int vtkMaterialInterfaceFilter::ProcessBlock(
+  int blockId, vtkMaterialInterfaceFilterBlockFragments* fragments)
+{
   vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[blockId];
   if (block == nullptr)
   {
     return 0;
   }
+  fragments->Block = block;
+
+  // Set up the accumulators.
+  fragments->FragmentMoment.assign(4, 0.0);
+  fragments->FragmentVolumeWtdAvg.resize(this->NVolumeWtdAvgs);
+  fragments->FragmentVolumeWtdAvgs.resize(this->NVolumeWtdAvgs);
+  for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
+  {
+    fragments->FragmentVolumeWtdAvg[i].assign(
+      this->FragmentVolumeWtdAvgs[i]->GetNumberOfComponents(), 0.0);
+  }
+  fragments->FragmentMassWtdAvg.resize(this->NMassWtdAvgs);
+  fragments->FragmentMassWtdAvgs.resize(this->NMassWtdAvgs);
+  for (int i = 0; i < this->NMassWtdAvgs; ++i)
+  {
+    fragments->FragmentMassWtdAvg[i].assign(
+      this->FragmentMassWtdAvgs[i]->GetNumberOfComponents(), 0.0);
+  }
+  fragments->FragmentSum.resize(this->NToSum);
+  fragments->FragmentSums.resize(this->NToSum);
+  for (int i = 0; i < this->NToSum; ++i)
+  {
+    fragments->FragmentSum[i].assign(this->FragmentSums[i]->GetNumberOfComponents(), 0.0);
+  }
 
   vtkMaterialInterfaceFilterIterator* xIterator = new vtkMaterialInterfaceFilterIterator;
   vtkMaterialInterfaceFilterIterator* yIterator = new vtkMaterialInterfaceFilterIterator;
@@ -3686,65 +3711,66 @@ int vtkMaterialInterfaceFilter::ProcessBlock(int blockId)
         if (*(xIterator->FragmentIdPointer) == -1 &&
           *(xIterator->VolumeFractionPointer) > this->scaledMaterialFractionThreshold)
         { // We have a new fragment.
-          this->CurrentFragmentMesh = this->NewFragmentMesh();
-          this->EquivalenceSet->AddEquivalence(this->FragmentId, this->FragmentId);
+          const int fragmentId = static_cast<int>(fragments->FragmentMeshes.size());
+          fragments->CurrentFragmentMesh = this->NewFragmentMesh();
           // We have to mark every voxel we push on the queue.
-          *(xIterator->FragmentIdPointer) = this->FragmentId;
+          *(xIterator->FragmentIdPointer) = fragmentId;
           // There should be no need to clear the queue.
           queue->Push(xIterator);
-          this->ConnectFragment(queue);
+          this->ConnectFragment(queue, fragments);
           // save the current fragment mesh
           // the id is implicit given by its position in the vector, but only
           // until fragments are resolved. After resolution we add addributes such
           // as id, volume, summations averages, etc..
-          this->CurrentFragmentMesh->Squeeze();
-          this->FragmentMeshes.push_back(this->CurrentFragmentMesh);
+          fragments->CurrentFragmentMesh->Squeeze();
+          fragments->FragmentMeshes.push_back(fragments->CurrentFragmentMesh);
+          fragments->CurrentFragmentMesh = nullptr;
           // Save the volume from the last fragment.
-          this->FragmentVolumes->InsertTuple1(this->FragmentId, this->FragmentVolume);
+          fragments->FragmentVolumes.push_back(fragments->FragmentVolume);
           if (this->ClipWithPlane)
           {
-            this->ClipDepthMaximums->InsertTuple1(this->FragmentId, this->ClipDepthMax);
-            this->ClipDepthMinimums->InsertTuple1(this->FragmentId, this->ClipDepthMin);
+            fragments->ClipDepthMaximums.push_back(fragments->ClipDepthMax);
+            fragments->ClipDepthMinimums.push_back(fragments->ClipDepthMin);
           }
           // clear the volume accumulator
-          this->FragmentVolume = 0.0;
-          this->ClipDepthMax = 0.0;
-          this->ClipDepthMin = VTK_FLOAT_MAX;
+          fragments->FragmentVolume = 0.0;
+          fragments->ClipDepthMax = 0.0;
+          fragments->ClipDepthMin = VTK_FLOAT_MAX;
           if (this->ComputeMoments)
           {
             // Save the moments from the last fragment
-            this->FragmentMoments->InsertTuple(this->FragmentId, this->FragmentMoment.data());
+            fragments->FragmentMoments.insert(fragments->FragmentMoments.end(),
+              fragments->FragmentMoment.begin(), fragments->FragmentMoment.end());
             // clear the moment accumulator
-            FillVector(this->FragmentMoment, 0.0);
+            FillVector(fragments->FragmentMoment, 0.0);
           }
           // for the volume weighted averaged scalars/vectors...
           for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
           {
             // update the integrated value, independent of ncomps
-            this->FragmentVolumeWtdAvgs[i]->InsertTuple(
-              this->FragmentId, this->FragmentVolumeWtdAvg[i].data());
+            fragments->FragmentVolumeWtdAvgs[i].insert(fragments->FragmentVolumeWtdAvgs[i].end(),
+              fragments->FragmentVolumeWtdAvg[i].begin(), fragments->FragmentVolumeWtdAvg[i].end());
             // clear the accumulator
-            FillVector(this->FragmentVolumeWtdAvg[i], 0.0);
+            FillVector(fragments->FragmentVolumeWtdAvg[i], 0.0);
           }
           // for the mass weighted averaged scalars/vectors...
           for (int i = 0; i < this->NMassWtdAvgs; ++i)
           {
             // update the integrated value, independent of ncomps
-            this->FragmentMassWtdAvgs[i]->InsertTuple(
-              this->FragmentId, this->FragmentMassWtdAvg[i].data());
+            fragments->FragmentMassWtdAvgs[i].insert(fragments->FragmentMassWtdAvgs[i].end(),
+              fragments->FragmentMassWtdAvg[i].begin(), fragments->FragmentMassWtdAvg[i].end());
             // clear the accumulator
-            FillVector(this->FragmentMassWtdAvg[i], 0.0);
+            FillVector(fragments->FragmentMassWtdAvg[i], 0.0);
           }
           // for the summed scalars/vectors...
           for (int i = 0; i < this->NToSum; ++i)
           {
             // update the integrated value, independent of ncomps
-            this->FragmentSums[i]->InsertTuple(this->FragmentId, this->FragmentSum[i].data());
+            fragments->FragmentSums[i].insert(fragments->FragmentSums[i].end(),
+              fragments->FragmentSum[i].begin(), fragments->FragmentSum[i].end());
             // clear the accumulator
-            FillVector(this->FragmentSum[i], 0.0);
+            FillVector(fragments->FragmentSum[i], 0.0);
           }
-          // Move to next fragment.
-          ++this->FragmentId;
         }
         xIterator->FlatIndex += cellIncs[0]; // 1/ncomp
         xIterator->VolumeFractionPointer += cellIncs[0];
@@ -4133,7 +4159,8 @@ int vtkMaterialInterfaceFilter::ComputeDisplacementFactors(
 // The return value indicates that an edge may be non manifold.
 // It returns the y or z axis index of the edge that may be non manifold.
 int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(double* point,
-  vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8], int rootNeighborIdx, int faceAxis)
+  vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8], int rootNeighborIdx, int faceAxis,
+  vtkMaterialInterfaceFilterBlockFragments* fragments)
 {
   int retVal;
 
@@ -4181,8 +4208,8 @@ int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(double* point,
     projection = (point[0] - this->ClipCenter[0]) * this->ClipPlaneNormal[0];
     projection += (point[1] - this->ClipCenter[1]) * this->ClipPlaneNormal[1];
     projection += (point[2] - this->ClipCenter[2]) * this->ClipPlaneNormal[2];
-    this->ClipDepthMax = std::max(this->ClipDepthMax, projection);
-    this->ClipDepthMin = std::min(this->ClipDepthMin, projection);
+    fragments->ClipDepthMax = std::max(fragments->ClipDepthMax, projection);
+    fragments->ClipDepthMin = std::min(fragments->ClipDepthMin, projection);
   }
 
   return retVal;
@@ -4200,7 +4227,8 @@ int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(double* point,
 // I need to have more than 4 points for a face.
 // I am only going to support transitions of 1 level.
 void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator* in,
-  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag)
+  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag,
+  vtkMaterialInterfaceFilterBlockFragments* fragments)
 {
   if (in->Block == nullptr || in->Block->GetGhostFlag())
   {
@@ -4223,8 +4251,8 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
   // Add points to the output.  Create separate points for each triangle.
   // We can worry about merging points later.
   vtkMaterialInterfaceFilterIterator* cornerNeighbors[8];
-  vtkPoints* points = this->CurrentFragmentMesh->GetPoints(); // TODO for performance store?
-  vtkCellArray* polys = this->CurrentFragmentMesh->GetPolys();
+  vtkPoints* points = fragments->CurrentFragmentMesh->GetPoints(); // TODO for performance store?
+  vtkCellArray* polys = fragments->CurrentFragmentMesh->GetPolys();
   vtkIdType quadCornerIds[4];
   vtkIdType quadMidIds[4];
   vtkIdType triPtIds[3];
@@ -4235,10 +4263,10 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 
   // Compute the corner and edge points (before subpixel positioning).
   // Store the results in ivars.
-  this->ComputeFacePoints(in, out, axis, outMaxFlag);
+  this->ComputeFacePoints(in, out, axis, outMaxFlag, fragments);
   // Find the neighbor iterators.
   // Store the results in ivars.
-  this->ComputeFaceNeighbors(in, out, axis, outMaxFlag);
+  this->ComputeFaceNeighbors(in, out, axis, outMaxFlag, fragments);
 
   // A word about indexing:
   // face neighbors 2x4x4 indexed face normal axis first, axis1, then axis2.
@@ -4273,55 +4301,55 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
   // to perform connectivity on the 2x2x2 point neighbors.
   int inNeighborIdx;
 
-  cornerNeighbors[i0] = &(this->FaceNeighbors[0]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[1]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[2]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[3]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[8]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[9]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[10]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[11]);
+  cornerNeighbors[i0] = &(fragments->FaceNeighbors[0]);
+  cornerNeighbors[i1] = &(fragments->FaceNeighbors[1]);
+  cornerNeighbors[i2] = &(fragments->FaceNeighbors[2]);
+  cornerNeighbors[i3] = &(fragments->FaceNeighbors[3]);
+  cornerNeighbors[i4] = &(fragments->FaceNeighbors[8]);
+  cornerNeighbors[i5] = &(fragments->FaceNeighbors[9]);
+  cornerNeighbors[i6] = &(fragments->FaceNeighbors[10]);
+  cornerNeighbors[i7] = &(fragments->FaceNeighbors[11]);
   inNeighborIdx = outMaxFlag ? i6 : i7; // Face neighbor 10 or 11
-  manifoldIssue[0] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints, cornerNeighbors, inNeighborIdx, axis);
+  manifoldIssue[0] = this->SubVoxelPositionCorner(
+    fragments->FaceCornerPoints, cornerNeighbors, inNeighborIdx, axis, fragments);
   // 1 =>
-  quadCornerIds[0] = points->InsertNextPoint(this->FaceCornerPoints);
-  cornerNeighbors[i0] = &(this->FaceNeighbors[4]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[5]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[6]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[7]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[12]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[13]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[14]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[15]);
+  quadCornerIds[0] = points->InsertNextPoint(fragments->FaceCornerPoints);
+  cornerNeighbors[i0] = &(fragments->FaceNeighbors[4]);
+  cornerNeighbors[i1] = &(fragments->FaceNeighbors[5]);
+  cornerNeighbors[i2] = &(fragments->FaceNeighbors[6]);
+  cornerNeighbors[i3] = &(fragments->FaceNeighbors[7]);
+  cornerNeighbors[i4] = &(fragments->FaceNeighbors[12]);
+  cornerNeighbors[i5] = &(fragments->FaceNeighbors[13]);
+  cornerNeighbors[i6] = &(fragments->FaceNeighbors[14]);
+  cornerNeighbors[i7] = &(fragments->FaceNeighbors[15]);
   inNeighborIdx = outMaxFlag ? i4 : i5; // Face neighbor 12 or 13
-  manifoldIssue[1] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints + 3, cornerNeighbors, inNeighborIdx, axis);
-  quadCornerIds[1] = points->InsertNextPoint(this->FaceCornerPoints + 3);
-  cornerNeighbors[i0] = &(this->FaceNeighbors[16]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[17]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[18]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[19]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[24]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[25]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[26]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[27]);
+  manifoldIssue[1] = this->SubVoxelPositionCorner(
+    fragments->FaceCornerPoints + 3, cornerNeighbors, inNeighborIdx, axis, fragments);
+  quadCornerIds[1] = points->InsertNextPoint(fragments->FaceCornerPoints + 3);
+  cornerNeighbors[i0] = &(fragments->FaceNeighbors[16]);
+  cornerNeighbors[i1] = &(fragments->FaceNeighbors[17]);
+  cornerNeighbors[i2] = &(fragments->FaceNeighbors[18]);
+  cornerNeighbors[i3] = &(fragments->FaceNeighbors[19]);
+  cornerNeighbors[i4] = &(fragments->FaceNeighbors[24]);
+  cornerNeighbors[i5] = &(fragments->FaceNeighbors[25]);
+  cornerNeighbors[i6] = &(fragments->FaceNeighbors[26]);
+  cornerNeighbors[i7] = &(fragments->FaceNeighbors[27]);
   inNeighborIdx = outMaxFlag ? i2 : i3; // Face neighbor 18 or 19
-  manifoldIssue[2] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints + 6, cornerNeighbors, inNeighborIdx, axis);
-  quadCornerIds[2] = points->InsertNextPoint(this->FaceCornerPoints + 6);
-  cornerNeighbors[i0] = &(this->FaceNeighbors[20]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[21]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[22]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[23]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[28]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[29]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[30]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[31]);
+  manifoldIssue[2] = this->SubVoxelPositionCorner(
+    fragments->FaceCornerPoints + 6, cornerNeighbors, inNeighborIdx, axis, fragments);
+  quadCornerIds[2] = points->InsertNextPoint(fragments->FaceCornerPoints + 6);
+  cornerNeighbors[i0] = &(fragments->FaceNeighbors[20]);
+  cornerNeighbors[i1] = &(fragments->FaceNeighbors[21]);
+  cornerNeighbors[i2] = &(fragments->FaceNeighbors[22]);
+  cornerNeighbors[i3] = &(fragments->FaceNeighbors[23]);
+  cornerNeighbors[i4] = &(fragments->FaceNeighbors[28]);
+  cornerNeighbors[i5] = &(fragments->FaceNeighbors[29]);
+  cornerNeighbors[i6] = &(fragments->FaceNeighbors[30]);
+  cornerNeighbors[i7] = &(fragments->FaceNeighbors[31]);
   inNeighborIdx = outMaxFlag ? i0 : i1; // Face neighbor 20 or 21
-  manifoldIssue[3] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints + 9, cornerNeighbors, inNeighborIdx, axis);
-  quadCornerIds[3] = points->InsertNextPoint(this->FaceCornerPoints + 9);
+  manifoldIssue[3] = this->SubVoxelPositionCorner(
+    fragments->FaceCornerPoints + 9, cornerNeighbors, inNeighborIdx, axis, fragments);
+  quadCornerIds[3] = points->InsertNextPoint(fragments->FaceCornerPoints + 9);
 
   // If both corners of an edge have an issue, the we need an extra
   // point on the edge to generate a hole.
@@ -4334,93 +4362,97 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
   if (manifoldIssue[0] != 0 && manifoldIssue[1] != 0 && tmp[manifoldIssue[0]] == 1 &&
     tmp[manifoldIssue[1]] == 1)
   {
-    this->FaceEdgeFlags[0] = 1;
+    fragments->FaceEdgeFlags[0] = 1;
   }
 
   if (manifoldIssue[0] != 0 && manifoldIssue[2] != 0 && tmp[manifoldIssue[0]] == 2 &&
     tmp[manifoldIssue[2]] == 2)
   {
-    this->FaceEdgeFlags[1] = 1;
+    fragments->FaceEdgeFlags[1] = 1;
   }
   if (manifoldIssue[1] != 0 && manifoldIssue[3] != 0 && tmp[manifoldIssue[1]] == 2 &&
     tmp[manifoldIssue[3]] == 2)
   {
-    this->FaceEdgeFlags[2] = 1;
+    fragments->FaceEdgeFlags[2] = 1;
   }
   if (manifoldIssue[2] != 0 && manifoldIssue[3] && tmp[manifoldIssue[2]] == 1 &&
     tmp[manifoldIssue[3]] == 1)
   {
-    this->FaceEdgeFlags[3] = 1;
+    fragments->FaceEdgeFlags[3] = 1;
   }
 
   // Now for the mid edge point if the neighbors on that side are smaller.
-  if (this->FaceEdgeFlags[0])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[2]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[3]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[4]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[5]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[10]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[11]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[12]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[13]);
+  if (fragments->FaceEdgeFlags[0])
+  {
+    cornerNeighbors[i0] = &(fragments->FaceNeighbors[2]);
+    cornerNeighbors[i1] = &(fragments->FaceNeighbors[3]);
+    cornerNeighbors[i2] = &(fragments->FaceNeighbors[4]);
+    cornerNeighbors[i3] = &(fragments->FaceNeighbors[5]);
+    cornerNeighbors[i4] = &(fragments->FaceNeighbors[10]);
+    cornerNeighbors[i5] = &(fragments->FaceNeighbors[11]);
+    cornerNeighbors[i6] = &(fragments->FaceNeighbors[12]);
+    cornerNeighbors[i7] = &(fragments->FaceNeighbors[13]);
     // Two choices here (10, 12) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i4 : i5;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[0] = points->InsertNextPoint(this->FaceEdgePoints);
-  }
-  if (this->FaceEdgeFlags[1])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[8]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[9]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[10]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[11]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[16]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[17]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[18]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[19]);
+    this->SubVoxelPositionCorner(
+      fragments->FaceEdgePoints, cornerNeighbors, inNeighborIdx, axis, fragments);
+    quadMidIds[0] = points->InsertNextPoint(fragments->FaceEdgePoints);
+  }
+  if (fragments->FaceEdgeFlags[1])
+  {
+    cornerNeighbors[i0] = &(fragments->FaceNeighbors[8]);
+    cornerNeighbors[i1] = &(fragments->FaceNeighbors[9]);
+    cornerNeighbors[i2] = &(fragments->FaceNeighbors[10]);
+    cornerNeighbors[i3] = &(fragments->FaceNeighbors[11]);
+    cornerNeighbors[i4] = &(fragments->FaceNeighbors[16]);
+    cornerNeighbors[i5] = &(fragments->FaceNeighbors[17]);
+    cornerNeighbors[i6] = &(fragments->FaceNeighbors[18]);
+    cornerNeighbors[i7] = &(fragments->FaceNeighbors[19]);
     // Two choices here (10, 18) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i2 : i3;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints + 3, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[1] = points->InsertNextPoint(this->FaceEdgePoints + 3);
-  }
-  if (this->FaceEdgeFlags[2])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[12]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[13]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[14]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[15]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[20]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[21]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[22]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[23]);
+    this->SubVoxelPositionCorner(
+      fragments->FaceEdgePoints + 3, cornerNeighbors, inNeighborIdx, axis, fragments);
+    quadMidIds[1] = points->InsertNextPoint(fragments->FaceEdgePoints + 3);
+  }
+  if (fragments->FaceEdgeFlags[2])
+  {
+    cornerNeighbors[i0] = &(fragments->FaceNeighbors[12]);
+    cornerNeighbors[i1] = &(fragments->FaceNeighbors[13]);
+    cornerNeighbors[i2] = &(fragments->FaceNeighbors[14]);
+    cornerNeighbors[i3] = &(fragments->FaceNeighbors[15]);
+    cornerNeighbors[i4] = &(fragments->FaceNeighbors[20]);
+    cornerNeighbors[i5] = &(fragments->FaceNeighbors[21]);
+    cornerNeighbors[i6] = &(fragments->FaceNeighbors[22]);
+    cornerNeighbors[i7] = &(fragments->FaceNeighbors[23]);
     // Two choices here (12, 20) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i0 : i1;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints + 6, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[2] = points->InsertNextPoint(this->FaceEdgePoints + 6);
-  }
-  if (this->FaceEdgeFlags[3])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[18]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[19]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[20]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[21]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[26]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[27]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[28]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[29]);
+    this->SubVoxelPositionCorner(
+      fragments->FaceEdgePoints + 6, cornerNeighbors, inNeighborIdx, axis, fragments);
+    quadMidIds[2] = points->InsertNextPoint(fragments->FaceEdgePoints + 6);
+  }
+  if (fragments->FaceEdgeFlags[3])
+  {
+    cornerNeighbors[i0] = &(fragments->FaceNeighbors[18]);
+    cornerNeighbors[i1] = &(fragments->FaceNeighbors[19]);
+    cornerNeighbors[i2] = &(fragments->FaceNeighbors[20]);
+    cornerNeighbors[i3] = &(fragments->FaceNeighbors[21]);
+    cornerNeighbors[i4] = &(fragments->FaceNeighbors[26]);
+    cornerNeighbors[i5] = &(fragments->FaceNeighbors[27]);
+    cornerNeighbors[i6] = &(fragments->FaceNeighbors[28]);
+    cornerNeighbors[i7] = &(fragments->FaceNeighbors[29]);
     // Two choices here (18, 20) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i0 : i1;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints + 9, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[3] = points->InsertNextPoint(this->FaceEdgePoints + 9);
+    this->SubVoxelPositionCorner(
+      fragments->FaceEdgePoints + 9, cornerNeighbors, inNeighborIdx, axis, fragments);
+    quadMidIds[3] = points->InsertNextPoint(fragments->FaceEdgePoints + 9);
   }
 
   // Now there are 9 possibilities
   // (10 if you count the two ways to triangulate the simple quad).
   // No edges, $ cases with one mid point, 4 cases with two mid points.
   // That is all because the face is always the smallest of the two in/out voxels.
-  int caseIdx = this->FaceEdgeFlags[0] | (this->FaceEdgeFlags[1] << 1) |
-    (this->FaceEdgeFlags[2] << 2) | (this->FaceEdgeFlags[3] << 3);
+  int caseIdx = fragments->FaceEdgeFlags[0] | (fragments->FaceEdgeFlags[1] << 1) |
+    (fragments->FaceEdgeFlags[2] << 2) | (fragments->FaceEdgeFlags[3] << 3);
 
   // c2 e3 c3
   // e1    e2
@@ -4566,10 +4598,10 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
       // This will help us decide which way to split up the quad into triangles.
       double d0011 = 0.0;
       double d0110 = 0.0;
-      double* pt00 = this->FaceCornerPoints;
-      double* pt01 = this->FaceCornerPoints + 3;
-      double* pt10 = this->FaceCornerPoints + 6;
-      double* pt11 = this->FaceCornerPoints + 9;
+      double* pt00 = fragments->FaceCornerPoints;
+      double* pt01 = fragments->FaceCornerPoints + 3;
+      double* pt10 = fragments->FaceCornerPoints + 6;
+      double* pt11 = fragments->FaceCornerPoints + 9;
       for (int ii = 0; ii < 3; ++ii)
       {
         double tmp2 = pt00[ii] - pt11[ii];
@@ -4619,7 +4651,7 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 
     // fragment
     vtkDoubleArray* destArray =
-      dynamic_cast<vtkDoubleArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray(i));
+      dynamic_cast<vtkDoubleArray*>(fragments->CurrentFragmentMesh->GetCellData()->GetArray(i));
     for (vtkIdType ii = 0; ii < numTris; ++ii)
     {
       destArray->InsertNextTuple(thisTup.data());
@@ -4628,13 +4660,13 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 // Cell data attributes for debugging.
 #ifdef vtkMaterialInterfaceFilterDEBUG
   vtkIntArray* levelArray =
-    dynamic_cast<vtkIntArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray("Level"));
+    dynamic_cast<vtkIntArray*>(fragments->CurrentFragmentMesh->GetCellData()->GetArray("Level"));
 
   vtkIntArray* blockIdArray =
-    dynamic_cast<vtkIntArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray("BlockId"));
+    dynamic_cast<vtkIntArray*>(fragments->CurrentFragmentMesh->GetCellData()->GetArray("BlockId"));
 
   vtkIntArray* procIdArray =
-    dynamic_cast<vtkIntArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray("ProcId"));
+    dynamic_cast<vtkIntArray*>(fragments->CurrentFragmentMesh->GetCellData()->GetArray("ProcId"));
 
   for (vtkIdType ii = 0; ii < numTris; ++ii)
   {
@@ -4649,7 +4681,8 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 // Computes the face and edge middle points of the shared contact face
 // between the two iterators.
 void vtkMaterialInterfaceFilter::ComputeFacePoints(vtkMaterialInterfaceFilterIterator* in,
-  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag)
+  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag,
+  vtkMaterialInterfaceFilterBlockFragments* fragments)
 {
   vtkMaterialInterfaceFilterIterator* smaller;
   double* origin;
@@ -4689,41 +4722,42 @@ void vtkMaterialInterfaceFilter::ComputeFacePoints(vtkMaterialInterfaceFilterIte
   // 6 9
   // 0 3
   // First set them all to the origin.
-  this->FaceCornerPoints[0] = this->FaceCornerPoints[3] = this->FaceCornerPoints[6] =
-    this->FaceCornerPoints[9] = faceOrigin[0];
-  this->FaceCornerPoints[1] = this->FaceCornerPoints[4] = this->FaceCornerPoints[7] =
-    this->FaceCornerPoints[10] = faceOrigin[1];
-  this->FaceCornerPoints[2] = this->FaceCornerPoints[5] = this->FaceCornerPoints[8] =
-    this->FaceCornerPoints[11] = faceOrigin[2];
+  fragments->FaceCornerPoints[0] = fragments->FaceCornerPoints[3] = fragments->FaceCornerPoints[6] =
+    fragments->FaceCornerPoints[9] = faceOrigin[0];
+  fragments->FaceCornerPoints[1] = fragments->FaceCornerPoints[4] = fragments->FaceCornerPoints[7] =
+    fragments->FaceCornerPoints[10] = faceOrigin[1];
+  fragments->FaceCornerPoints[2] = fragments->FaceCornerPoints[5] = fragments->FaceCornerPoints[8] =
+    fragments->FaceCornerPoints[11] = faceOrigin[2];
   // Now offset them to the corners.
-  this->FaceCornerPoints[3 + axis1] += spacing[axis1];
-  this->FaceCornerPoints[9 + axis1] += spacing[axis1];
-  this->FaceCornerPoints[6 + axis2] += spacing[axis2];
-  this->FaceCornerPoints[9 + axis2] += spacing[axis2];
+  fragments->FaceCornerPoints[3 + axis1] += spacing[axis1];
+  fragments->FaceCornerPoints[9 + axis1] += spacing[axis1];
+  fragments->FaceCornerPoints[6 + axis2] += spacing[axis2];
+  fragments->FaceCornerPoints[9 + axis2] += spacing[axis2];
 
   // Now do the same for the edge points
   //   3
   // 1   2
   //   0
   // First set them all to the origin.
-  this->FaceEdgePoints[0] = this->FaceEdgePoints[3] = this->FaceEdgePoints[6] =
-    this->FaceEdgePoints[9] = faceOrigin[0];
-  this->FaceEdgePoints[1] = this->FaceEdgePoints[4] = this->FaceEdgePoints[7] =
-    this->FaceEdgePoints[10] = faceOrigin[1];
-  this->FaceEdgePoints[2] = this->FaceEdgePoints[5] = this->FaceEdgePoints[8] =
-    this->FaceEdgePoints[11] = faceOrigin[2];
+  fragments->FaceEdgePoints[0] = fragments->FaceEdgePoints[3] = fragments->FaceEdgePoints[6] =
+    fragments->FaceEdgePoints[9] = faceOrigin[0];
+  fragments->FaceEdgePoints[1] = fragments->FaceEdgePoints[4] = fragments->FaceEdgePoints[7] =
+    fragments->FaceEdgePoints[10] = faceOrigin[1];
+  fragments->FaceEdgePoints[2] = fragments->FaceEdgePoints[5] = fragments->FaceEdgePoints[8] =
+    fragments->FaceEdgePoints[11] = faceOrigin[2];
   // Now offset the points to the middle of the edges.
-  this->FaceEdgePoints[axis1] += halfSpacing[axis1];
-  this->FaceEdgePoints[9 + axis1] += halfSpacing[axis1];
-  this->FaceEdgePoints[6 + axis1] += spacing[axis1];
-  this->FaceEdgePoints[3 + axis2] += halfSpacing[axis2];
-  this->FaceEdgePoints[6 + axis2] += halfSpacing[axis2];
-  this->FaceEdgePoints[9 + axis2] += spacing[axis2];
+  fragments->FaceEdgePoints[axis1] += halfSpacing[axis1];
+  fragments->FaceEdgePoints[9 + axis1] += halfSpacing[axis1];
+  fragments->FaceEdgePoints[6 + axis1] += spacing[axis1];
+  fragments->FaceEdgePoints[3 + axis2] += halfSpacing[axis2];
+  fragments->FaceEdgePoints[6 + axis2] += halfSpacing[axis2];
+  fragments->FaceEdgePoints[9 + axis2] += spacing[axis2];
 }
 
 //----------------------------------------------------------------------------
 void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilterIterator* in,
-  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag)
+  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag,
+  vtkMaterialInterfaceFilterBlockFragments* fragments)
 {
   int axis1 = (axis + 1) % 3;
   int axis2 = (axis + 2) % 3;
@@ -4770,17 +4804,17 @@ void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilter
   // for subdivision.
   if (outMaxFlag)
   {
-    this->FaceNeighbors[10] = this->FaceNeighbors[12] = this->FaceNeighbors[18] =
-      this->FaceNeighbors[20] = *in;
-    this->FaceNeighbors[11] = this->FaceNeighbors[13] = this->FaceNeighbors[19] =
-      this->FaceNeighbors[21] = *out;
+    fragments->FaceNeighbors[10] = fragments->FaceNeighbors[12] = fragments->FaceNeighbors[18] =
+      fragments->FaceNeighbors[20] = *in;
+    fragments->FaceNeighbors[11] = fragments->FaceNeighbors[13] = fragments->FaceNeighbors[19] =
+      fragments->FaceNeighbors[21] = *out;
   }
   else
   {
-    this->FaceNeighbors[10] = this->FaceNeighbors[12] = this->FaceNeighbors[18] =
-      this->FaceNeighbors[20] = *out;
-    this->FaceNeighbors[11] = this->FaceNeighbors[13] = this->FaceNeighbors[19] =
-      this->FaceNeighbors[21] = *in;
+    fragments->FaceNeighbors[10] = fragments->FaceNeighbors[12] = fragments->FaceNeighbors[18] =
+      fragments->FaceNeighbors[20] = *out;
+    fragments->FaceNeighbors[11] = fragments->FaceNeighbors[13] = fragments->FaceNeighbors[19] =
+      fragments->FaceNeighbors[21] = *in;
   }
 
   // Ok, we have 24 neighbors to compute.
@@ -4790,91 +4824,115 @@ void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilter
   // increments: 1, 2, 8
   // Start at the corner and march around the edges.
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 3, this->FaceNeighbors + 11);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 3, fragments->FaceNeighbors + 11);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 5, this->FaceNeighbors + 3);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 5, fragments->FaceNeighbors + 3);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 7, this->FaceNeighbors + 5);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 7, fragments->FaceNeighbors + 5);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 15, this->FaceNeighbors + 7);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 15, fragments->FaceNeighbors + 7);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 23, this->FaceNeighbors + 15);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 23, fragments->FaceNeighbors + 15);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 31, this->FaceNeighbors + 23);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 31, fragments->FaceNeighbors + 23);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 29, this->FaceNeighbors + 31);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 29, fragments->FaceNeighbors + 31);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 27, this->FaceNeighbors + 29);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 27, fragments->FaceNeighbors + 29);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 25, this->FaceNeighbors + 27);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 25, fragments->FaceNeighbors + 27);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 17, this->FaceNeighbors + 25);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 17, fragments->FaceNeighbors + 25);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 9, this->FaceNeighbors + 17);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 9, fragments->FaceNeighbors + 17);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 1, this->FaceNeighbors + 9);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 1, fragments->FaceNeighbors + 9);
   // Now for the other side (min axis).
   faceIndex[axis] -= 1;  // Move to the other layer
   faceIndex[axis1] += 1; // Start below reference block.
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 2, this->FaceNeighbors + 10);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 2, fragments->FaceNeighbors + 10);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 4, this->FaceNeighbors + 2);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 4, fragments->FaceNeighbors + 2);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 6, this->FaceNeighbors + 4);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 6, fragments->FaceNeighbors + 4);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 14, this->FaceNeighbors + 6);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 14, fragments->FaceNeighbors + 6);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 22, this->FaceNeighbors + 14);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 22, fragments->FaceNeighbors + 14);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 30, this->FaceNeighbors + 22);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 30, fragments->FaceNeighbors + 22);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 28, this->FaceNeighbors + 30);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 28, fragments->FaceNeighbors + 30);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 26, this->FaceNeighbors + 28);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 26, fragments->FaceNeighbors + 28);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 24, this->FaceNeighbors + 26);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 24, fragments->FaceNeighbors + 26);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 16, this->FaceNeighbors + 24);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 16, fragments->FaceNeighbors + 24);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 8, this->FaceNeighbors + 16);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 8, fragments->FaceNeighbors + 16);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 0, this->FaceNeighbors + 8);
+  this->FindNeighbor(
+    faceIndex, faceLevel, fragments->FaceNeighbors + 0, fragments->FaceNeighbors + 8);
 
   // Split edges if neighbors are a higher level than face.
   --faceLevel;
-  this->FaceEdgeFlags[0] = 0;
+  fragments->FaceEdgeFlags[0] = 0;
   // Checking equivalences (this->FaceNeighbor[2] != this->FaceNeighbor[4])
   // May be faster and work fine.
-  if (this->FaceNeighbors[2].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[3].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[4].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[5].Block->GetLevel() > faceLevel)
+  if (fragments->FaceNeighbors[2].Block->GetLevel() > faceLevel ||
+    fragments->FaceNeighbors[3].Block->GetLevel() > faceLevel ||
+    fragments->FaceNeighbors[4].Block->GetLevel() > faceLevel ||
+    fragments->FaceNeighbors[5].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[0] = 1;
+    fragments->FaceEdgeFlags[0] = 1;
   }
-  this->FaceEdgeFlags[1] = 0;
-  if (this->FaceNeighbors[8].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[9].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[16].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[17].Block->GetLevel() > faceLevel)
+  fragments->FaceEdgeFlags[1] = 0;
+  if (fragments->FaceNeighbors[8].Block->GetLevel() > faceLevel ||
+    fragments->FaceNeighbors[9].Block->GetLevel() > faceLevel ||
+    fragments->FaceNeighbors[16].Block->GetLevel() > faceLevel ||
+    fragments->FaceNeighbors[17].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[1] = 1;
+    fragments->FaceEdgeFlags[1] = 1;
   }
-  this->FaceEdgeFlags[2] = 0;
-  if (this->FaceNeighbors[14].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[15].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[22].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[23].Block->GetLevel() > faceLevel)
+  fragments->FaceEdgeFlags[2] = 0;
+  if (fragments->FaceNeighbors[14].Block->GetLevel() > faceLevel ||
+    fragments->FaceNeighbors[15].Block->GetLevel() > faceLevel ||
+    fragments->FaceNeighbors[22].Block->GetLevel() > faceLevel ||
+    fragments->FaceNeighbors[23].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[2] = 1;
+    fragments->FaceEdgeFlags[2] = 1;
   }
-  this->FaceEdgeFlags[3] = 0;
-  if (this->FaceNeighbors[26].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[27].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[28].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[29].Block->GetLevel() > faceLevel)
+  fragments->FaceEdgeFlags[3] = 0;
+  if (fragments->FaceNeighbors[26].Block->GetLevel() > faceLevel ||
+    fragments->FaceNeighbors[27].Block->GetLevel() > faceLevel ||
+    fragments->FaceNeighbors[28].Block->GetLevel() > faceLevel ||
+    fragments->FaceNeighbors[29].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[3] = 1;
+    fragments->FaceEdgeFlags[3] = 1;
   }
 }
 
@@ -5337,7 +5395,8 @@ inline int vtkMaterialInterfaceFilter::AccumulateMoments(double* moments, // =(M
 // This integrates quantities at the same time.
 // This is called only when the voxel is part of a fragment.
 // I tried to create a generic API to replace the hard coded conditional ifs.
-void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingBuffer* queue)
+void vtkMaterialInterfaceFilter::ConnectFragment(
+  vtkMaterialInterfaceFilterRingBuffer* queue, vtkMaterialInterfaceFilterBlockFragments* fragments)
 {
   while (queue->GetSize())
   {
@@ -5357,14 +5416,14 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
       double voxelVolumeFrac =
         dX[0] * dX[1] * dX[2] * (double)(*(iterator.VolumeFractionPointer)) / 255.0;
 #endif
-      this->FragmentVolume += voxelVolumeFrac;
+      fragments->FragmentVolume += voxelVolumeFrac;
       // The clip depth is accumulated in SubvoxelPositionCorner.
       // accumulate volume weighted average
       for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
       {
         vtkDataArray* arrayToIntegrate = iterator.Block->GetVolumeWtdAvgArray(i);
         int nComps = arrayToIntegrate->GetNumberOfComponents();
-        this->Accumulate(this->FragmentVolumeWtdAvg[i].data(), arrayToIntegrate, nComps,
+        this->Accumulate(fragments->FragmentVolumeWtdAvg[i].data(), arrayToIntegrate, nComps,
           iterator.FlatIndex, voxelVolumeFrac);
       }
       // accumulate mass weighted average
@@ -5376,7 +5435,8 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         const double* X0 = iterator.Block->GetOrigin();
         double X[3] = { X0[0] + dX[0] * (0.5 + iterator.Index[0]),
           X0[1] + dX[1] * (0.5 + iterator.Index[1]), X0[2] + dX[2] * (0.5 + iterator.Index[2]) };
-        this->AccumulateMoments(this->FragmentMoment.data(), massArray, iterator.FlatIndex, X);
+        this->AccumulateMoments(
+          fragments->FragmentMoment.data(), massArray, iterator.FlatIndex, X);
         // mass weighted averages
         double voxelMass;
         massArray->GetTuple(iterator.FlatIndex, &voxelMass);
@@ -5384,7 +5444,7 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         {
           vtkDataArray* arrayToIntegrate = iterator.Block->GetMassWtdAvgArray(i);
           int nComps = arrayToIntegrate->GetNumberOfComponents();
-          this->Accumulate(this->FragmentMassWtdAvg[i].data(), arrayToIntegrate, nComps,
+          this->Accumulate(fragments->FragmentMassWtdAvg[i].data(), arrayToIntegrate, nComps,
             iterator.FlatIndex, voxelMass);
         }
       }
@@ -5394,7 +5454,7 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         vtkDataArray* arrayToIntegrate = iterator.Block->GetArrayToSum(i);
         int nComps = arrayToIntegrate->GetNumberOfComponents();
         this->Accumulate(
-          this->FragmentSum[i].data(), arrayToIntegrate, nComps, iterator.FlatIndex, 1.0);
+          fragments->FragmentSum[i].data(), arrayToIntegrate, nComps, iterator.FlatIndex, 1.0);
       }
     }
 
@@ -5411,187 +5471,40 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
       // axis0 = ii;
       // axis1 = (ii+1)%3;
       // axis2 = (ii+2)%3;
-      // idxMin = 2*ii;
-      // idxMax = 2*ii+1this->IndexMax+1;
-      // "Left"/min
-      this->GetNeighborIterator(&next, &iterator, ii, 0, (ii + 1) % 3, 0, (ii + 2) % 3, 0);
-
-      if (next.VolumeFractionPointer == nullptr ||
-        next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
+      // "Left"/min first, then "Right"/max.
+      for (int maxFlag = 0; maxFlag < 2; ++maxFlag)
       {
-        // Neighbor is outside of fragment.  Make a face.
-        this->CreateFace(&iterator, &next, ii, 0);
-      }
-      else if (next.FragmentIdPointer[0] == -1)
-      { // We have not visited this neighbor yet. Mark the voxel and recurse.
-        *(next.FragmentIdPointer) = this->FragmentId;
-        queue->Push(&next);
-      }
-      else
-      { // The last case is that we have already visited this voxel and it
-        // is in the same fragment.
-        this->AddEquivalence(&iterator, &next);
-      }
-
-      // Handle the case when the new iterator is a higher level.
-      // We need to loop over all the faces of the higher level that touch this face.
-      // We will restrict our case to 4 neighbors (max difference in levels is 1).
-      // If level skip, things should still work OK. Biggest issue is holes in surface.
-      // This also sort of assumes that at most one other block touches this face.
-      // Holes might appear if this is not true.
-      if (next.Block && next.Block->GetLevel() > iterator.Block->GetLevel())
-      {
-        vtkMaterialInterfaceFilterIterator next2;
-        bool threeDimFlag = next.Block->GetBaseCellExtent()[4] < next.Block->GetBaseCellExtent()[5];
-        // Take the first neighbor found and move +Y
-        if (ii != 1 || threeDimFlag)
-        { // stupid after the fact way of dealing with 2d AMR input.
-          this->GetNeighborIterator(&next2, &next, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next2.VolumeFractionPointer == nullptr ||
-            next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 0);
-          }
-          else if (next2.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next2);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-        // Take the fist iterator found and move +Z
-        if (ii != 0 || threeDimFlag)
-        { // stupid after the fact way of dealing with 2d AMR input.
-          this->GetNeighborIterator(&next2, &next, (ii + 2) % 3, 1, ii, 0, (ii + 1) % 3, 0);
-          if (next2.VolumeFractionPointer == nullptr ||
-            next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 0);
-          }
-          else if (next2.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next2);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-        // To get the +Y+Z start with the +Z iterator and move +Y put results in "next"
-        if (next2.Block && threeDimFlag)
+        this->GetNeighborIterator(&next, &iterator, ii, maxFlag, (ii + 1) % 3, 0, (ii + 2) % 3, 0);
+        this->ConnectNeighbor(&iterator, &next, ii, maxFlag, queue, fragments);
+
+        // Handle the case when the new iterator is a higher level.
+        // We need to loop over all the faces of the higher level that touch this face.
+        // We will restrict our case to 4 neighbors (max difference in levels is 1).
+        // If level skip, things should still work OK. Biggest issue is holes in surface.
+        // This also sort of assumes that at most one other block touches this face.
+        // Holes might appear if this is not true.
+        if (next.Block && next.Block->GetLevel() > iterator.Block->GetLevel())
         {
-          this->GetNeighborIterator(&next, &next2, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next.VolumeFractionPointer == nullptr ||
-            next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next, ii, 0);
-          }
-          else if (next.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-      }
-
-      // "Right"/max
-      this->GetNeighborIterator(&next, &iterator, ii, 1, (ii + 1) % 3, 0, (ii + 2) % 3, 0);
-      if (next.VolumeFractionPointer == nullptr ||
-        next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-      { // Neighbor is outside of fragment.  Make a face.
-        this->CreateFace(&iterator, &next, ii, 1);
-      }
-      else if (next.FragmentIdPointer[0] == -1)
-      { // We have not visited this neighbor yet. Mark the voxel and recurse.
-        *(next.FragmentIdPointer) = this->FragmentId;
-        queue->Push(&next);
-      }
-      else
-      { // The last case is that we have already visited this voxel and it
-        // is in the same fragment.
-        this->AddEquivalence(&iterator, &next);
-      }
-      // Same case as above with the same logic to visit the
-      // four smaller cells that touch this face of the current block.
-      if (next.Block && next.Block->GetLevel() > iterator.Block->GetLevel())
-      {
-        vtkMaterialInterfaceFilterIterator next2;
-        bool threeDimFlag = next.Block->GetBaseCellExtent()[4] < next.Block->GetBaseCellExtent()[5];
-        // Take the first neighbor found and move +Y
-        if (ii != 1 || threeDimFlag)
-        { // stupid after the fact way of dealing with 2d AMR input.
-          this->GetNeighborIterator(&next2, &next, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next2.VolumeFractionPointer == nullptr ||
-            next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 1);
+          vtkMaterialInterfaceFilterIterator next2;
+          bool threeDimFlag =
+            next.Block->GetBaseCellExtent()[4] < next.Block->GetBaseCellExtent()[5];
+          // Take the first neighbor found and move +Y
+          if (ii != 1 || threeDimFlag)
+          { // stupid after the fact way of dealing with 2d AMR input.
+            this->GetNeighborIterator(&next2, &next, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
+            this->ConnectNeighbor(&iterator, &next2, ii, maxFlag, queue, fragments);
           }
-          else if (next2.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next2);
+          // Take the fist iterator found and move +Z
+          if (ii != 0 || threeDimFlag)
+          { // stupid after the fact way of dealing with 2d AMR input.
+            this->GetNeighborIterator(&next2, &next, (ii + 2) % 3, 1, ii, 0, (ii + 1) % 3, 0);
+            this->ConnectNeighbor(&iterator, &next2, ii, maxFlag, queue, fragments);
           }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-        // Take the fist iterator found and move +Z
-        if (ii != 0 || threeDimFlag)
-        { // stupid after the fact way of dealing with 2d AMR input.
-          this->GetNeighborIterator(&next2, &next, (ii + 2) % 3, 1, ii, 0, (ii + 1) % 3, 0);
-          if (next2.VolumeFractionPointer == nullptr ||
-            next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
+          // To get the +Y+Z start with the +Z iterator and move +Y put results in "next"
+          if (next2.Block && threeDimFlag)
           {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 1);
-          }
-          else if (next2.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next2);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-        // To get the +Y+Z start with the +Z iterator and move +Y put results in "next"
-        if (next2.Block && threeDimFlag)
-        {
-          this->GetNeighborIterator(&next, &next2, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next.VolumeFractionPointer == nullptr ||
-            next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next, ii, 1);
-          }
-          else if (next.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
+            this->GetNeighborIterator(&next, &next2, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
+            this->ConnectNeighbor(&iterator, &next, ii, maxFlag, queue, fragments);
           }
         }
       }
@@ -5599,6 +5512,34 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
   }
 }
 
+//----------------------------------------------------------------------------
+// Visits a face connected neighbor of a voxel of the current fragment.
+// A face is created when the neighbor is outside of the material, and the
+// neighbor joins the fragment when the search may label it. Otherwise the
+// neighbor is kept as a link, and the fragments are merged once all the
+// blocks have been labeled.
+void vtkMaterialInterfaceFilter::ConnectNeighbor(vtkMaterialInterfaceFilterIterator* in,
+  vtkMaterialInterfaceFilterIterator* neighbor, int axis, int outMaxFlag,
+  vtkMaterialInterfaceFilterRingBuffer* queue, vtkMaterialInterfaceFilterBlockFragments* fragments)
+{
+  if (neighbor->VolumeFractionPointer == nullptr ||
+    neighbor->VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
+  {
+    // Neighbor is outside of fragment.  Make a face.
+    this->CreateFace(in, neighbor, axis, outMaxFlag, fragments);
+  }
+  else if (fragments->Owns(neighbor->Block) && neighbor->FragmentIdPointer[0] == -1)
+  { // We have not visited this neighbor yet. Mark the voxel and recurse.
+    *(neighbor->FragmentIdPointer) = *(in->FragmentIdPointer);
+    queue->Push(neighbor);
+  }
+  else if (!fragments->Owns(neighbor->Block) ||
+    neighbor->FragmentIdPointer[0] != *(in->FragmentIdPointer))
+  { // The voxel belongs to another block, or was labeled by another search.
+    fragments->Links.emplace_back(*(in->FragmentIdPointer), *neighbor);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkMaterialInterfaceFilter::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -6188,24 +6129,6 @@ void vtkMaterialInterfaceFilter::SetUpperLoadingBound(int nPolys)
   }
 }
 
-//----------------------------------------------------------------------------
-// This is for finding equivalent fragment ids within a single process.
-// I thought of loops and chains but both have problems.
-// Chains can leave orphans, loops break when two nodes in the loop are
-// equated a second time.
-// Lets try a directed tree
-void vtkMaterialInterfaceFilter::AddEquivalence(
-  vtkMaterialInterfaceFilterIterator* neighbor1, vtkMaterialInterfaceFilterIterator* neighbor2)
-{
-  int id1 = *(neighbor1->FragmentIdPointer);
-  int id2 = *(neighbor2->FragmentIdPointer);
-
-  if (id1 != id2 && id1 != -1 && id2 != -1)
-  {
-    this->EquivalenceSet->AddEquivalence(id1, id2);
-  }
-}
-
 //----------------------------------------------------------------------------
 // Merge fragment pieces which are split locally.
 void vtkMaterialInterfaceFilter::ResolveLocalFragmentGeometry()
@@ -8116,7 +8039,7 @@ void vtkMaterialInterfaceFilter::ResolveEquivalences()
 //----------------------------------------------------------------------------
 // This also fills in the arrays NumberOfRawFragments and LocalToGlobalOffsets
 // as a side effect. (also NumberOfResolvedFragments).
-void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquivalenceSet* set)
+void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkEquivalenceSet* set)
 {
 #ifdef vtkMaterialInterfaceFilterDEBUG
   ostringstream progressMesg;
@@ -8161,7 +8084,7 @@ void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquiv
   this->TotalNumberOfRawFragments = totalNumberOfIds;
 
   // Change the set to a global set.
-  vtkMaterialInterfaceEquivalenceSet* globalSet = new vtkMaterialInterfaceEquivalenceSet;
+  vtkEquivalenceSet* globalSet = vtkEquivalenceSet::New();
   // This just initializes the set so that every set has one member.
   //  Every id is equivalent to itself and no others.
   if (totalNumberOfIds > 0)
@@ -8170,19 +8093,19 @@ void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquiv
   }
   // Add the equivalences from our process.
   int myOffset = this->LocalToGlobalOffsets[myProcId];
-  int memberSetId;
+  std::vector<int> memberIds(numLocalMembers);
+  std::vector<int> memberSetIds(numLocalMembers);
   for (int ii = 0; ii < numLocalMembers; ++ii)
   {
-    memberSetId = set->GetEquivalentSetId(ii);
-    // This will be inefficient until I make the scheduled improvemnt to the
-    // add method (Ordered multilevel tree instead of a one level tree).
-    globalSet->AddEquivalence(ii + myOffset, memberSetId + myOffset);
+    memberIds[ii] = ii + myOffset;
+    memberSetIds[ii] = set->GetEquivalentSetId(ii) + myOffset;
   }
+  globalSet->AddEquivalences(memberIds.data(), memberSetIds.data(), numLocalMembers);
 
   // std::cerr << myProcId << " Input set: " << endl;
-  // set->Print();
+  // set->Print(std::cerr);
   // std::cerr << myProcId << " global set: " << endl;
-  // globalSet->Print();
+  // globalSet->Print(std::cerr);
 
   // Now add equivalents between processes.
   // Send all the ghost blocks to the process that owns the block.
@@ -8190,14 +8113,14 @@ void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquiv
   this->ShareGhostEquivalences(globalSet, this->LocalToGlobalOffsets);
 
   // std::cerr << "Global after ghost: " << myProcId << endl;
-  // globalSet->Print();
+  // globalSet->Print(std::cerr);
 
   // Merge all of the processes global sets.
   // Clean the global set so that the resulting set ids are sequential.
   this->MergeGhostEquivalenceSets(globalSet);
 
   // std::cerr << "Global after merge: " << myProcId << endl;
-  // globalSet->Print();
+  // globalSet->Print(std::cerr);
 
   // free what do not need
   globalSet->Squeeze();
@@ -8206,12 +8129,12 @@ void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquiv
   // The ids will be the global ids so the GetId method will work.
   set->DeepCopy(globalSet);
 
-  delete globalSet;
+  globalSet->Delete();
 }
 
 //----------------------------------------------------------------------------
 void vtkMaterialInterfaceFilter::MergeGhostEquivalenceSets(
-  vtkMaterialInterfaceEquivalenceSet* globalSet)
+  vtkEquivalenceSet* globalSet)
 {
   const int myProcId = this->Controller->GetLocalProcessId();
   int* buf = globalSet->GetPointer();
@@ -8237,21 +8160,25 @@ void vtkMaterialInterfaceFilter::MergeGhostEquivalenceSets(
   // Only process 0 from here out.
 
   int numProcs = this->Controller->GetNumberOfProcesses();
-  int* tmp;
-  tmp = new int[numIds];
+  std::vector<int> tmp(numIds);
+  std::vector<int> ids1;
+  std::vector<int> ids2;
   for (int ii = 1; ii < numProcs; ++ii)
   {
-    this->Controller->Receive(tmp, numIds, ii, 342320);
+    this->Controller->Receive(tmp.data(), numIds, ii, 342320);
     // Merge the values.
+    ids1.clear();
+    ids2.clear();
     for (int jj = 0; jj < numIds; ++jj)
     {
       if (tmp[jj] != jj)
-      { // TODO: Make sure this is efficient.  Avoid n^2.
-        globalSet->AddEquivalence(jj, tmp[jj]);
+      {
+        ids1.push_back(jj);
+        ids2.push_back(tmp[jj]);
       }
     }
+    globalSet->AddEquivalences(ids1.data(), ids2.data(), static_cast<vtkIdType>(ids1.size()));
   }
-  delete[] tmp;
 
   // Make the set ids sequential.
   this->NumberOfResolvedFragments = globalSet->ResolveEquivalences();
@@ -8270,7 +8197,7 @@ void vtkMaterialInterfaceFilter::MergeGhostEquivalenceSets(
 
 //----------------------------------------------------------------------------
 void vtkMaterialInterfaceFilter::ShareGhostEquivalences(
-  vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffsets)
+  vtkEquivalenceSet* globalSet, int* procOffsets)
 {
   const int numProcs = this->Controller->GetNumberOfProcesses();
   const int myProcId = this->Controller->GetLocalProcessId();
@@ -8321,7 +8248,7 @@ void vtkMaterialInterfaceFilter::ShareGhostEquivalences(
 // Receive all the gost blocks from remote processes and
 // find the equivalences.
 void vtkMaterialInterfaceFilter::ReceiveGhostFragmentIds(
-  vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffsets)
+  vtkEquivalenceSet* globalSet, int* procOffsets)
 {
   int msg[8];
   int otherProc;
@@ -8335,6 +8262,10 @@ void vtkMaterialInterfaceFilter::ReceiveGhostFragmentIds(
   const int myProcId = this->Controller->GetLocalProcessId();
   int localOffset = procOffsets[myProcId];
   int remoteOffset;
+  // The equivalences are added in a single batch once all the ghost blocks
+  // have been received.
+  std::vector<int> localIds;
+  std::vector<int> remoteIds;
 
   // We do not receive requests from our own process.
   int remainingProcs = this->Controller->GetNumberOfProcesses() - 1;
@@ -8394,7 +8325,8 @@ void vtkMaterialInterfaceFilter::ReceiveGhostFragmentIds(
             remoteId = *remoteFragmentIds;
             if (localId >= 0 && remoteId >= 0)
             {
-              globalSet->AddEquivalence(localId + localOffset, remoteId + remoteOffset);
+              localIds.push_back(localId + localOffset);
+              remoteIds.push_back(remoteId + remoteOffset);
             }
             ++remoteFragmentIds;
             ++px;
@@ -8406,6 +8338,8 @@ void vtkMaterialInterfaceFilter::ReceiveGhostFragmentIds(
     }
   }
   delete[] buf;
+  globalSet->AddEquivalences(
+    localIds.data(), remoteIds.data(), static_cast<vtkIdType>(localIds.size()));
 }
 
 //----------------------------------------------------------------------------
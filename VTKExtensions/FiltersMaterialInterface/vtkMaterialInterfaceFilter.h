@@ -10,6 +10,12 @@
  * a particle index as part of the cell data of the output.  It computes
  * the volume of each particle from the volume fraction.
  *
+ * The blocks of the input are prepared and labeled concurrently using
+ * vtkSMPTools. Each block extracts the surface of its own fragments, then the
+ * fragments that cross block boundaries are merged through the equivalence
+ * set. Fragments are numbered in block order, so fragment ids do not depend
+ * on the number of threads.
+ *
  * This will turn on validation and debug i/o of the filter.
  * \code{.cpp}
  * #define vtkMaterialInterfaceFilterDEBUG
@@ -51,8 +57,9 @@ class vtkImplicitFunction;
 // specific to us
 class vtkMaterialInterfaceLevel;
 class vtkMaterialInterfaceFilterBlock;
+class vtkMaterialInterfaceFilterBlockFragments;
 class vtkMaterialInterfaceFilterIterator;
-class vtkMaterialInterfaceEquivalenceSet;
+class vtkEquivalenceSet;
 class vtkMaterialInterfaceFilterRingBuffer;
 class vtkMaterialInterfacePieceLoading;
 class vtkMaterialInterfaceCommBuffer;
@@ -339,11 +346,19 @@ protected:
     std::vector<std::string>& integratedArrayNames);
   // Create a new fragment/piece.
   vtkPolyData* NewFragmentMesh();
-  // Process each cell, looking for fragments.
-  int ProcessBlock(int blockId);
+  // Label the fragments of all local blocks and merge the ones that
+  // cross block boundaries.
+  void ProcessBlocks();
+  // Process each cell of a block, looking for fragments.
+  int ProcessBlock(int blockId, vtkMaterialInterfaceFilterBlockFragments* fragments);
   // Cell has been identified as inside the fragment. Integrate, and
   // generate fragment surface etc...
-  void ConnectFragment(vtkMaterialInterfaceFilterRingBuffer* iterator);
+  void ConnectFragment(vtkMaterialInterfaceFilterRingBuffer* iterator,
+    vtkMaterialInterfaceFilterBlockFragments* fragments);
+  void ConnectNeighbor(vtkMaterialInterfaceFilterIterator* in,
+    vtkMaterialInterfaceFilterIterator* neighbor, int axis, int outMaxFlag,
+    vtkMaterialInterfaceFilterRingBuffer* queue,
+    vtkMaterialInterfaceFilterBlockFragments* fragments);
   void GetNeighborIterator(vtkMaterialInterfaceFilterIterator* next,
     vtkMaterialInterfaceFilterIterator* iterator, int axis0, int maxFlag0, int axis1, int maxFlag1,
     int axis2, int maxFlag2);
@@ -351,12 +366,12 @@ protected:
     vtkMaterialInterfaceFilterIterator* iterator, int axis0, int maxFlag0, int axis1, int maxFlag1,
     int axis2, int maxFlag2);
   void CreateFace(vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out,
-    int axis, int outMaxFlag);
+    int axis, int outMaxFlag, vtkMaterialInterfaceFilterBlockFragments* fragments);
   int ComputeDisplacementFactors(vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8],
     double displacmentFactors[3], int rootNeighborIdx, int faceAxis);
   int SubVoxelPositionCorner(double* point,
     vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8], int rootNeighborIdx,
-    int faceAxis);
+    int faceAxis, vtkMaterialInterfaceFilterBlockFragments* fragments);
   void FindPointNeighbors(vtkMaterialInterfaceFilterIterator* iteratorMin0,
     vtkMaterialInterfaceFilterIterator* iteratorMax0, int axis0, int maxFlag1, int maxFlag2,
     vtkMaterialInterfaceFilterIterator pointNeighborIterators[8], double pt[3]);
@@ -376,17 +391,15 @@ protected:
 
   vtkMultiProcessController* Controller;
 
-  vtkMaterialInterfaceEquivalenceSet* EquivalenceSet;
-  void AddEquivalence(
-    vtkMaterialInterfaceFilterIterator* neighbor1, vtkMaterialInterfaceFilterIterator* neighbor2);
+  vtkEquivalenceSet* EquivalenceSet;
   //
   void PrepareForResolveEquivalences();
   //
   void ResolveEquivalences();
-  void GatherEquivalenceSets(vtkMaterialInterfaceEquivalenceSet* set);
-  void ShareGhostEquivalences(vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffsets);
-  void ReceiveGhostFragmentIds(vtkMaterialInterfaceEquivalenceSet* globalSet, int* procOffset);
-  void MergeGhostEquivalenceSets(vtkMaterialInterfaceEquivalenceSet* globalSet);
+  void GatherEquivalenceSets(vtkEquivalenceSet* set);
+  void ShareGhostEquivalences(vtkEquivalenceSet* globalSet, int* procOffsets);
+  void ReceiveGhostFragmentIds(vtkEquivalenceSet* globalSet, int* procOffset);
+  void MergeGhostEquivalenceSets(vtkEquivalenceSet* globalSet);
 
   // Sum/finalize attribute's contribution for those
   // which are split over multiple processes.
@@ -516,10 +529,6 @@ protected:
   char* MaterialFractionArrayName;
   vtkSetStringMacro(MaterialFractionArrayName);
 
-  // while processing a material array this holds
-  // a pointer to the output poly data
-  // data set
-  vtkPolyData* CurrentFragmentMesh;
   // As pieces/fragments are found they are stored here
   // until resolution.
   std::vector<vtkPolyData*> FragmentMeshes;
@@ -529,23 +538,18 @@ protected:
   // all of the supported operations.
   /// class vtkMaterialInterfaceFilterIntegrator
   ///{
-  // Local id of current fragment
+  // Number of local fragments found so far. The accumulators for the
+  // current fragment live in vtkMaterialInterfaceFilterBlockFragments.
   int FragmentId;
-  // Accumulator for the volume of the current fragment.
-  double FragmentVolume;
   // Fragment volumes indexed by the fragment id. It's a local
   // per-process indexing until fragments have been resolved
   vtkDoubleArray* FragmentVolumes;
 
   // Min and max depth of crater.
   // These are only computed when the clip plane is on.
-  double ClipDepthMin;
-  double ClipDepthMax;
   vtkDoubleArray* ClipDepthMinimums;
   vtkDoubleArray* ClipDepthMaximums;
 
-  // Accumulator for moments of the current fragment
-  std::vector<double> FragmentMoment; // =(Myz, Mxz, Mxy, m)
   // Moments indexed by fragment id
   vtkDoubleArray* FragmentMoments;
   // Centers of fragment AABBs, only computed if moments are not
@@ -554,8 +558,6 @@ protected:
   bool ComputeMoments;
 
   // Weighted average, where weights correspond to fragment volume.
-  // Accumulators one for each array to average, scalar or vector
-  std::vector<std::vector<double>> FragmentVolumeWtdAvg;
   // weighted averages indexed by fragment id.
   std::vector<vtkDoubleArray*> FragmentVolumeWtdAvgs;
   // number of arrays for which to compute the weighted average
@@ -564,8 +566,6 @@ protected:
   std::vector<std::string> VolumeWtdAvgArrayNames;
 
   // Weighted average, where weights correspond to fragment mass.
-  // Accumulators one for each array to average, scalar or vector
-  std::vector<std::vector<double>> FragmentMassWtdAvg;
   // weighted averages indexed by fragment id.
   std::vector<vtkDoubleArray*> FragmentMassWtdAvgs;
   // number of arrays for which to compute the weighted average
@@ -582,8 +582,6 @@ protected:
   int NToIntegrate;
 
   // Sum of data over the fragment.
-  // Accumulators, one for each array to sum
-  std::vector<std::vector<double>> FragmentSum;
   // sums indexed by fragment id.
   std::vector<vtkDoubleArray*> FragmentSums;
   // number of arrays for which to compute the weighted average
@@ -647,20 +645,14 @@ protected:
   // It could be changed into the primary storage of blocks.
   std::vector<vtkMaterialInterfaceLevel*> Levels;
 
-  // Ivars for computing the point on corners and edges of a face.
-  vtkMaterialInterfaceFilterIterator* FaceNeighbors;
-  // Permutation of the neighbors. Axis0 normal to face.
-  int faceAxis0;
-  int faceAxis1;
-  int faceAxis2;
-  double FaceCornerPoints[12];
-  double FaceEdgePoints[12];
-  int FaceEdgeFlags[4];
+  // Compute the point on corners and edges of a face.
   // outMaxFlag implies out is positive direction of axis.
   void ComputeFacePoints(vtkMaterialInterfaceFilterIterator* in,
-    vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag);
+    vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag,
+    vtkMaterialInterfaceFilterBlockFragments* fragments);
   void ComputeFaceNeighbors(vtkMaterialInterfaceFilterIterator* in,
-    vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag);
+    vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag,
+    vtkMaterialInterfaceFilterBlockFragments* fragments);
 
   long ComputeProximity(const int faceIdx[3], int faceLevel, const int ext[6], int refLevel);
 
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include "vtkDeltaImageCompressor.h"
 #include "vtkImageCompressor.h"
 #include "vtkImageData.h"
 #include "vtkLZ4Compressor.h"
@@ -14,6 +15,8 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 #include <map>
 #include <string>
@@ -39,10 +42,15 @@ typedef std::map<std::string, Data> MapType;
 
 namespace
 {
-bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* input)
+bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* input,
+  vtkUnsignedCharArray* outputDeCompressed = nullptr)
 {
   vtkNew<vtkUnsignedCharArray> outputCompressed;
-  vtkNew<vtkUnsignedCharArray> outputDeCompressed;
+  vtkNew<vtkUnsignedCharArray> localOutputDeCompressed;
+  if (outputDeCompressed == nullptr)
+  {
+    outputDeCompressed = localOutputDeCompressed;
+  }
   outputDeCompressed->SetNumberOfComponents(input->GetNumberOfComponents());
   outputDeCompressed->SetNumberOfTuples(input->GetNumberOfTuples());
 
@@ -59,7 +67,7 @@ bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* in
   data.CompressTime += timer->GetElapsedTime();
 
   compressor->SetInput(outputCompressed.Get());
-  compressor->SetOutput(outputDeCompressed.Get());
+  compressor->SetOutput(outputDeCompressed);
   timer->StartTimer();
   if (!compressor->Decompress())
   {
@@ -73,6 +81,228 @@ bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* in
 }
 }
 
+namespace
+{
+// Compresses `frame` and decompresses it into `decoded`.
+bool RoundTrip(vtkDeltaImageCompressor* compressor, vtkDeltaImageCompressor* decompressor,
+  vtkUnsignedCharArray* frame, vtkUnsignedCharArray* decoded)
+{
+  vtkNew<vtkUnsignedCharArray> compressed;
+  compressor->SetInput(frame);
+  compressor->SetOutput(compressed);
+  if (!compressor->Compress())
+  {
+    return false;
+  }
+
+  decoded->SetNumberOfComponents(frame->GetNumberOfComponents());
+  decoded->SetNumberOfTuples(frame->GetNumberOfTuples());
+  decompressor->SetInput(compressed);
+  decompressor->SetOutput(decoded);
+  return decompressor->Decompress() != 0;
+}
+
+// Returns true if each color channel of `decoded` is within `tolerance` of
+// `frame`. The alpha channel is skipped since SQUIRT always quantizes it.
+bool IsClose(vtkUnsignedCharArray* frame, vtkUnsignedCharArray* decoded, int tolerance)
+{
+  const int numComps = frame->GetNumberOfComponents();
+  const unsigned char* a = frame->GetPointer(0);
+  const unsigned char* b = decoded->GetPointer(0);
+  for (vtkIdType cc = 0, max = frame->GetDataSize(); cc < max; ++cc)
+  {
+    const int error = std::abs(static_cast<int>(a[cc]) - static_cast<int>(b[cc]));
+    if (cc % numComps < 3 && error > tolerance)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Round-trips frames through a vtkDeltaImageCompressor using the given tile
+// compressor and quality: a keyframe, a frame differing from the first in a
+// single pixel, for which only the changed tile must be sent, and a lossless
+// still frame equal to the previous one, which must resend all the tiles.
+// Lossy frames must be within the error of the quality level's color mask.
+bool TestDeltaCompressor(vtkImageData* image, vtkUnsignedCharArray* input, int tileCompressor,
+  int quality)
+{
+  const int* dims = image->GetDimensions();
+  vtkNew<vtkDeltaImageCompressor> compressor;
+  vtkNew<vtkDeltaImageCompressor> decompressor;
+  compressor->SetTileSize(32);
+  compressor->SetTileCompressor(tileCompressor);
+  compressor->SetQuality(quality);
+  compressor->SetLossLessMode(0);
+  compressor->SetImageResolution(dims[0], dims[1]);
+  decompressor->SetImageResolution(dims[0], dims[1]);
+
+  const int tolerance = (1 << quality) - 1;
+  vtkNew<vtkUnsignedCharArray> frame;
+  frame->DeepCopy(input);
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    if (cc == 1)
+    {
+      // modify a single pixel.
+      unsigned char* pixel = frame->GetPointer(0);
+      pixel[0] = static_cast<unsigned char>(pixel[0] + 1);
+    }
+
+    vtkNew<vtkUnsignedCharArray> decompressed;
+    if (!RoundTrip(compressor, decompressor, frame, decompressed))
+    {
+      return false;
+    }
+    if (!IsClose(frame, decompressed, tolerance))
+    {
+      std::cerr << "ERROR: delta frame " << cc << " (quality " << quality
+                << ") does not match the input." << endl;
+      return false;
+    }
+  }
+
+  if (compressor->GetNumberOfChangedTiles() != 1)
+  {
+    std::cerr << "ERROR: expected 1 changed tile, got " << compressor->GetNumberOfChangedTiles()
+              << "." << endl;
+    return false;
+  }
+
+  // a lossless still frame must replace the lossy tiles, even though the
+  // image did not change.
+  compressor->SetLossLessMode(1);
+  vtkNew<vtkUnsignedCharArray> still;
+  if (!RoundTrip(compressor, decompressor, frame, still))
+  {
+    return false;
+  }
+  if (quality > 0 && compressor->GetNumberOfChangedTiles() != compressor->GetNumberOfTiles())
+  {
+    std::cerr << "ERROR: a change of quality must send a keyframe." << endl;
+    return false;
+  }
+  if (!IsClose(frame, still, 0))
+  {
+    std::cerr << "ERROR: lossless still frame does not match the input." << endl;
+    return false;
+  }
+  return true;
+}
+
+// Drops a delta frame and checks that the decompressor refuses the next one
+// until the compressor is asked for a keyframe.
+bool TestDeltaCompressorRecovery(vtkImageData* image, vtkUnsignedCharArray* input)
+{
+  const int* dims = image->GetDimensions();
+  vtkNew<vtkDeltaImageCompressor> compressor;
+  vtkNew<vtkDeltaImageCompressor> decompressor;
+  compressor->SetQuality(0);
+  compressor->SetImageResolution(dims[0], dims[1]);
+  decompressor->SetImageResolution(dims[0], dims[1]);
+
+  vtkNew<vtkUnsignedCharArray> frame;
+  frame->DeepCopy(input);
+  vtkNew<vtkUnsignedCharArray> decompressed;
+  if (!RoundTrip(compressor, decompressor, frame, decompressed))
+  {
+    return false;
+  }
+
+  // this frame is lost.
+  vtkNew<vtkUnsignedCharArray> lost;
+  frame->GetPointer(0)[0]++;
+  compressor->SetInput(frame);
+  compressor->SetOutput(lost);
+  compressor->Compress();
+
+  frame->GetPointer(0)[0]++;
+  if (RoundTrip(compressor, decompressor, frame, decompressed))
+  {
+    std::cerr << "ERROR: delta frame following a lost frame must be refused." << endl;
+    return false;
+  }
+
+  // the receiving end requests a keyframe.
+  compressor->ForceKeyFrame();
+  frame->GetPointer(0)[0]++;
+  if (!RoundTrip(compressor, decompressor, frame, decompressed) || !IsClose(frame, decompressed, 0))
+  {
+    std::cerr << "ERROR: keyframe did not recover from the lost frame." << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+namespace
+{
+// Checks that the receiver picks the tiled or legacy SQUIRT decoder from the
+// stream rather than from its own configuration, that restored stripe
+// counts are clamped and that missing configuration fields get their defaults.
+bool TestSquirtStreamDetection(vtkUnsignedCharArray* input, vtkUnsignedCharArray* expected)
+{
+  for (int senderStripes : { 0, 8 })
+  {
+    vtkNew<vtkSquirtCompressor> sender;
+    sender->SetSquirtLevel(0);
+    sender->SetNumberOfStripes(senderStripes);
+    vtkNew<vtkUnsignedCharArray> compressed;
+    sender->SetInput(input);
+    sender->SetOutput(compressed);
+    if (!sender->Compress())
+    {
+      return false;
+    }
+
+    vtkNew<vtkSquirtCompressor> receiver;
+    receiver->SetNumberOfStripes(8 - senderStripes);
+    vtkNew<vtkUnsignedCharArray> decompressed;
+    decompressed->SetNumberOfComponents(input->GetNumberOfComponents());
+    decompressed->SetNumberOfTuples(input->GetNumberOfTuples());
+    receiver->SetInput(compressed);
+    receiver->SetOutput(decompressed);
+    if (!receiver->Decompress() ||
+      !std::equal(expected->GetPointer(0), expected->GetPointer(0) + expected->GetDataSize(),
+        decompressed->GetPointer(0)))
+    {
+      std::cerr << "ERROR: SQUIRT stream with " << senderStripes
+                << " stripe(s) was not decoded by a receiver with "
+                << receiver->GetNumberOfStripes() << " stripe(s)." << endl;
+      return false;
+    }
+  }
+
+  vtkNew<vtkSquirtCompressor> restored;
+  restored->RestoreConfiguration("vtkSquirtCompressor 0 3 5000");
+  if (restored->GetNumberOfStripes() != 1024)
+  {
+    std::cerr << "ERROR: restored number of stripes is not clamped." << endl;
+    return false;
+  }
+
+  // A legacy configuration without the number of stripes, then one without
+  // any squirt field.
+  restored->RestoreConfiguration("vtkSquirtCompressor 0 2");
+  if (restored->GetSquirtLevel() != 2 || restored->GetNumberOfStripes() != 0)
+  {
+    std::cerr << "ERROR: legacy configuration not restored with a single stripe." << endl;
+    return false;
+  }
+  restored->SetNumberOfStripes(8);
+  restored->SetSquirtLevel(1);
+  const char* end = restored->RestoreConfiguration("vtkSquirtCompressor 0");
+  if (!end || *end != '\0' || restored->GetSquirtLevel() != 3 ||
+    restored->GetNumberOfStripes() != 0)
+  {
+    std::cerr << "ERROR: missing configuration fields not restored to their defaults." << endl;
+    return false;
+  }
+  return true;
+}
+}
+
 extern int TestImageCompressors(int argc, char* argv[])
 {
   int max_count = 10;
@@ -112,6 +342,21 @@ extern int TestImageCompressors(int argc, char* argv[])
     vtkUnsignedCharArray::SafeDownCast(image->GetPointData()->GetScalars());
   vtkIdType uncompressedSize = input->GetNumberOfTuples() * input->GetNumberOfComponents();
 
+  for (int tileCompressor : { vtkDeltaImageCompressor::LZ4, vtkDeltaImageCompressor::SQUIRT })
+  {
+    for (int quality : { 0, 3, 5 })
+    {
+      if (!TestDeltaCompressor(image, input, tileCompressor, quality))
+      {
+        return TEST_FAILED;
+      }
+    }
+  }
+  if (!TestDeltaCompressorRecovery(image, input))
+  {
+    return TEST_FAILED;
+  }
+
   MapType datas;
   for (int cc = 0; cc < max_count; cc++)
   {
@@ -139,7 +384,29 @@ extern int TestImageCompressors(int argc, char* argv[])
 
     vtkNew<vtkSquirtCompressor> squirt;
     squirt->SetSquirtLevel(0);
-    if (!DoTest(datas["SQUIRT (squirt-level: 0)"], squirt.Get(), input))
+    vtkNew<vtkUnsignedCharArray> squirtDecompressed;
+    if (!DoTest(datas["SQUIRT (squirt-level: 0)"], squirt.Get(), input, squirtDecompressed))
+    {
+      return TEST_FAILED;
+    }
+
+    // the tiled stream must decode to the same image as the legacy stream.
+    squirt->SetNumberOfStripes(8);
+    vtkNew<vtkUnsignedCharArray> tiledDecompressed;
+    if (!DoTest(
+          datas["SQUIRT (squirt-level: 0, stripes: 8)"], squirt.Get(), input, tiledDecompressed))
+    {
+      return TEST_FAILED;
+    }
+    if (!std::equal(squirtDecompressed->GetPointer(0),
+          squirtDecompressed->GetPointer(0) + squirtDecompressed->GetDataSize(),
+          tiledDecompressed->GetPointer(0)))
+    {
+      std::cerr << "ERROR: tiled SQUIRT stream does not match the legacy stream." << endl;
+      return TEST_FAILED;
+    }
+    squirt->SetNumberOfStripes(0);
+    if (!TestSquirtStreamDetection(input, squirtDecompressed))
     {
       return TEST_FAILED;
     }
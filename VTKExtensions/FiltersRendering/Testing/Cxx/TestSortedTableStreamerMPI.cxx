@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDoubleArray.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkSortedTableStreamer.h"
+#include "vtkTable.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// Values of the given rank. Ranks have different sizes, many values are
+// repeated across ranks and the last rank has no rows when there are more
+// than 2 ranks.
+std::vector<double> GetValues(int rank, int numRanks)
+{
+  std::vector<double> values;
+  if (numRanks > 2 && rank == numRanks - 1)
+  {
+    return values;
+  }
+  const int size = 1000 + 337 * rank;
+  for (int cc = 0; cc < size; ++cc)
+  {
+    values.push_back(((cc + 17 * rank) * 7919) % 613);
+  }
+  return values;
+}
+
+bool TestSortedBlocks(vtkMultiProcessController* controller)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+
+  std::vector<double> expected;
+  for (int cc = 0; cc < numRanks; ++cc)
+  {
+    const auto values = ::GetValues(cc, numRanks);
+    expected.insert(expected.end(), values.begin(), values.end());
+  }
+  std::sort(expected.begin(), expected.end());
+  const vtkIdType total = static_cast<vtkIdType>(expected.size());
+
+  const auto localValues = ::GetValues(rank, numRanks);
+  vtkNew<vtkDoubleArray> data;
+  data->SetName("data");
+  data->SetNumberOfTuples(static_cast<vtkIdType>(localValues.size()));
+  std::copy(localValues.begin(), localValues.end(), data->GetPointer(0));
+  vtkNew<vtkTable> input;
+  input->AddColumn(data);
+
+  const vtkIdType blockSize = 256;
+  vtkNew<vtkSortedTableStreamer> streamer;
+  streamer->SetController(controller);
+  streamer->SetInputData(input);
+  streamer->SetColumnNameToSort("data");
+  streamer->SetSelectedComponent(0);
+  streamer->SetBlockSize(blockSize);
+
+  bool success = true;
+  for (int invert = 0; invert < 2; ++invert)
+  {
+    if (invert)
+    {
+      std::reverse(expected.begin(), expected.end());
+    }
+    streamer->SetInvertOrder(invert);
+    // Visit the blocks out of order: only the first request sorts the keys.
+    for (vtkIdType block : { 0, 5, 2, 7, 1, 3, 6, 4 })
+    {
+      streamer->SetBlock(block);
+      streamer->Update();
+
+      // The rows of the block are merged on a single process.
+      vtkTable* output = streamer->GetOutput();
+      const vtkIdType expectedSize =
+        std::max<vtkIdType>(0, std::min(blockSize, total - block * blockSize));
+      vtkIdType localSize = output->GetNumberOfRows();
+      vtkIdType size = 0;
+      controller->AllReduce(&localSize, &size, 1, vtkCommunicator::SUM_OP);
+      if (size != expectedSize)
+      {
+        vtkLog(ERROR, "block " << block << ": " << size << " rows instead of " << expectedSize);
+        success = false;
+        continue;
+      }
+      if (localSize == 0)
+      {
+        continue;
+      }
+
+      auto values = vtkDoubleArray::SafeDownCast(output->GetColumnByName("data"));
+      if (!values)
+      {
+        vtkLog(ERROR, "block " << block << ": missing column.");
+        success = false;
+        continue;
+      }
+      for (vtkIdType row = 0; row < localSize; ++row)
+      {
+        if (values->GetValue(row) != expected[block * blockSize + row])
+        {
+          vtkLog(ERROR, "block " << block << (invert ? " (inverted)" : "") << ", row " << row
+                                 << ": " << values->GetValue(row) << " instead of "
+                                 << expected[block * blockSize + row]);
+          success = false;
+          break;
+        }
+      }
+    }
+  }
+  return success;
+}
+}
+
+int TestSortedTableStreamerMPI(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv, 0);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int localSuccess = ::TestSortedBlocks(controller) ? 1 : 0;
+  int success = 0;
+  controller->AllReduce(&localSuccess, &success, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
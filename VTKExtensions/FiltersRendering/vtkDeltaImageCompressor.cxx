@@ -0,0 +1,541 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkDeltaImageCompressor.h"
+
+#include "vtkLZ4Compressor.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkSquirtCompressor.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+// Magic word identifying a delta stream.
+constexpr unsigned int DELTA_MAGIC = 0x41544c44; // "DLTA"
+constexpr unsigned int DELTA_KEYFRAME_FLAG = 0x1;
+
+// Layout of the header words at the start of each compressed frame. The
+// header is followed by the indices of the changed tiles (not present for
+// keyframes) and then by the compressed pixels of the changed tiles.
+enum HeaderWords
+{
+  MAGIC = 0,
+  FLAGS,
+  WIDTH,
+  HEIGHT,
+  NUMBER_OF_COMPONENTS,
+  TILE_SIZE,
+  TILE_COMPRESSOR,
+  FRAME_NUMBER,
+  BASE_FRAME_NUMBER,
+  NUMBER_OF_CHANGED_TILES,
+  PACKED_SIZE,
+  HEADER_SIZE
+};
+
+struct TileLayout
+{
+  int Width;
+  int Height;
+  int TileSize;
+  int TilesX;
+  int TilesY;
+
+  TileLayout(int width, int height, int tileSize)
+    : Width(width)
+    , Height(height)
+    , TileSize(tileSize)
+    , TilesX((width + tileSize - 1) / tileSize)
+    , TilesY((height + tileSize - 1) / tileSize)
+  {
+  }
+
+  int GetNumberOfTiles() const { return this->TilesX * this->TilesY; }
+
+  // Returns the pixel extent [x0, x1) x [y0, y1) of a tile.
+  void GetTileExtent(int tile, int& x0, int& x1, int& y0, int& y1) const
+  {
+    const int tx = tile % this->TilesX;
+    const int ty = tile / this->TilesX;
+    x0 = tx * this->TileSize;
+    x1 = std::min(x0 + this->TileSize, this->Width);
+    y0 = ty * this->TileSize;
+    y1 = std::min(y0 + this->TileSize, this->Height);
+  }
+
+  vtkIdType GetNumberOfTilePixels(int tile) const
+  {
+    int x0, x1, y0, y1;
+    this->GetTileExtent(tile, x0, x1, y0, y1);
+    return static_cast<vtkIdType>(x1 - x0) * (y1 - y0);
+  }
+
+  /**
+   * Copies the tile pixels between the image and a packed buffer. When
+   * `toPacked` is true, the tile is copied from `image` into `packed`.
+   */
+  void CopyTile(int tile, int numComps, unsigned char* image, unsigned char* packed,
+    bool toPacked) const
+  {
+    int x0, x1, y0, y1;
+    this->GetTileExtent(tile, x0, x1, y0, y1);
+    const size_t rowBytes = static_cast<size_t>(x1 - x0) * numComps;
+    for (int y = y0; y < y1; ++y)
+    {
+      unsigned char* row =
+        image + (static_cast<size_t>(y) * this->Width + static_cast<size_t>(x0)) * numComps;
+      if (toPacked)
+      {
+        std::memcpy(packed, row, rowBytes);
+      }
+      else
+      {
+        std::memcpy(row, packed, rowBytes);
+      }
+      packed += rowBytes;
+    }
+  }
+
+  bool IsTileDifferent(
+    int tile, int numComps, const unsigned char* image, const unsigned char* previous) const
+  {
+    int x0, x1, y0, y1;
+    this->GetTileExtent(tile, x0, x1, y0, y1);
+    const size_t rowBytes = static_cast<size_t>(x1 - x0) * numComps;
+    for (int y = y0; y < y1; ++y)
+    {
+      const size_t offset =
+        (static_cast<size_t>(y) * this->Width + static_cast<size_t>(x0)) * numComps;
+      if (std::memcmp(image + offset, previous + offset, rowBytes) != 0)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+}
+
+vtkStandardNewMacro(vtkDeltaImageCompressor);
+//----------------------------------------------------------------------------
+vtkDeltaImageCompressor::vtkDeltaImageCompressor()
+  : TileSize(64)
+  , TileCompressor(vtkDeltaImageCompressor::LZ4)
+  , Quality(3)
+  , KeyFrameInterval(0)
+  , Width(0)
+  , Height(0)
+  , NumberOfChangedTiles(0)
+  , NumberOfTiles(0)
+  , PreviousWidth(0)
+  , PreviousHeight(0)
+  , PreviousQuality(-1)
+  , KeyFrameRequested(true)
+  , FrameNumber(0)
+  , FramesSinceKeyFrame(0)
+  , DecodedWidth(0)
+  , DecodedHeight(0)
+  , DecodedFrameValid(false)
+  , DecodedFrameNumber(0)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkDeltaImageCompressor::~vtkDeltaImageCompressor() = default;
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::SetImageResolution(int width, int height)
+{
+  this->Width = width;
+  this->Height = height;
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::ForceKeyFrame()
+{
+  this->KeyFrameRequested = true;
+}
+
+//----------------------------------------------------------------------------
+vtkImageCompressor* vtkDeltaImageCompressor::GetTileCompressorInstance()
+{
+  vtkImageCompressor* compressor = nullptr;
+  if (this->TileCompressor == vtkDeltaImageCompressor::SQUIRT)
+  {
+    this->SquirtCompressor->SetSquirtLevel(this->Quality);
+    compressor = this->SquirtCompressor;
+  }
+  else
+  {
+    this->LZ4Compressor->SetQuality(this->Quality);
+    compressor = this->LZ4Compressor;
+  }
+  compressor->SetLossLessMode(this->LossLessMode);
+  return compressor;
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::Compress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot compress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  vtkUnsignedCharArray* input = this->Input;
+  const int numComps = input->GetNumberOfComponents();
+  if (numComps != 3 && numComps != 4)
+  {
+    vtkErrorMacro("Delta compression only works with RGBA or RGB.");
+    return VTK_ERROR;
+  }
+
+  int width = this->Width;
+  int height = this->Height;
+  if (static_cast<vtkIdType>(width) * height != input->GetNumberOfTuples())
+  {
+    // resolution was not communicated, treat the image as a single row.
+    width = static_cast<int>(input->GetNumberOfTuples());
+    height = 1;
+  }
+
+  // The previous frame holds the raw input, not what the receiver decoded. When
+  // the effective quality changes, e.g. a lossless still render following
+  // lossy interactive ones, unchanged tiles would keep their previous encoding
+  // on the receiver, hence all tiles are resent.
+  const int quality = this->LossLessMode ? 0 : this->Quality;
+  const bool keyframe = this->KeyFrameRequested || width != this->PreviousWidth ||
+    height != this->PreviousHeight || numComps != this->PreviousFrame->GetNumberOfComponents() ||
+    quality != this->PreviousQuality ||
+    (this->KeyFrameInterval > 0 && this->FramesSinceKeyFrame >= this->KeyFrameInterval);
+
+  // Determine the tiles that changed since the previous frame.
+  const TileLayout layout(width, height, this->TileSize);
+  const int numTiles = layout.GetNumberOfTiles();
+  std::vector<unsigned char> changed(static_cast<size_t>(numTiles), 1);
+  if (!keyframe)
+  {
+    const unsigned char* image = input->GetPointer(0);
+    const unsigned char* previous = this->PreviousFrame->GetPointer(0);
+    vtkSMPTools::For(0, numTiles,
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType tile = begin; tile < end; ++tile)
+        {
+          changed[tile] =
+            layout.IsTileDifferent(static_cast<int>(tile), numComps, image, previous) ? 1 : 0;
+        }
+      });
+  }
+
+  std::vector<unsigned int> changedTiles;
+  std::vector<vtkIdType> offsets(1, 0);
+  for (int tile = 0; tile < numTiles; ++tile)
+  {
+    if (changed[tile])
+    {
+      changedTiles.push_back(static_cast<unsigned int>(tile));
+      offsets.push_back(offsets.back() + layout.GetNumberOfTilePixels(tile));
+    }
+  }
+
+  // Pack the changed tiles in a contiguous buffer and compress them at once.
+  const vtkIdType numPackedPixels = offsets.back();
+  this->PackedTiles->SetNumberOfComponents(numComps);
+  this->PackedTiles->SetNumberOfTuples(numPackedPixels);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(changedTiles.size()),
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        layout.CopyTile(static_cast<int>(changedTiles[cc]), numComps, input->GetPointer(0),
+          this->PackedTiles->GetPointer(offsets[cc] * numComps), true);
+      }
+    });
+
+  vtkIdType compressedSize = 0;
+  if (numPackedPixels > 0)
+  {
+    vtkImageCompressor* compressor = this->GetTileCompressorInstance();
+    compressor->SetInput(this->PackedTiles);
+    compressor->SetOutput(this->CompressedTiles);
+    if (compressor->Compress() == VTK_ERROR)
+    {
+      vtkErrorMacro("Failed to compress changed tiles.");
+      return VTK_ERROR;
+    }
+    compressedSize = this->CompressedTiles->GetNumberOfTuples() *
+      this->CompressedTiles->GetNumberOfComponents();
+  }
+
+  const unsigned int frameNumber = this->FrameNumber + 1;
+  unsigned int header[HEADER_SIZE];
+  header[MAGIC] = DELTA_MAGIC;
+  header[FLAGS] = keyframe ? DELTA_KEYFRAME_FLAG : 0;
+  header[WIDTH] = static_cast<unsigned int>(width);
+  header[HEIGHT] = static_cast<unsigned int>(height);
+  header[NUMBER_OF_COMPONENTS] = static_cast<unsigned int>(numComps);
+  header[TILE_SIZE] = static_cast<unsigned int>(this->TileSize);
+  header[TILE_COMPRESSOR] = static_cast<unsigned int>(this->TileCompressor);
+  header[FRAME_NUMBER] = frameNumber;
+  header[BASE_FRAME_NUMBER] = this->FrameNumber;
+  header[NUMBER_OF_CHANGED_TILES] = static_cast<unsigned int>(changedTiles.size());
+  header[PACKED_SIZE] = static_cast<unsigned int>(compressedSize);
+
+  const size_t headerBytes = sizeof(header);
+  const size_t indicesBytes = keyframe ? 0 : changedTiles.size() * sizeof(unsigned int);
+  this->Output->SetNumberOfComponents(1);
+  this->Output->SetNumberOfTuples(
+    static_cast<vtkIdType>(headerBytes + indicesBytes + compressedSize));
+  unsigned char* out = this->Output->GetPointer(0);
+  std::memcpy(out, header, headerBytes);
+  if (indicesBytes > 0)
+  {
+    std::memcpy(out + headerBytes, changedTiles.data(), indicesBytes);
+  }
+  if (compressedSize > 0)
+  {
+    std::memcpy(
+      out + headerBytes + indicesBytes, this->CompressedTiles->GetPointer(0), compressedSize);
+  }
+
+  // Save the current frame to compare the next one against.
+  this->PreviousFrame->DeepCopy(input);
+  this->PreviousWidth = width;
+  this->PreviousHeight = height;
+  this->PreviousQuality = quality;
+  this->FrameNumber = frameNumber;
+  this->FramesSinceKeyFrame = keyframe ? 0 : this->FramesSinceKeyFrame + 1;
+  this->KeyFrameRequested = false;
+  this->NumberOfTiles = numTiles;
+  this->NumberOfChangedTiles = static_cast<int>(changedTiles.size());
+  return VTK_OK;
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::Decompress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot decompress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  const size_t inputBytes =
+    static_cast<size_t>(this->Input->GetNumberOfTuples()) * this->Input->GetNumberOfComponents();
+  unsigned int header[HEADER_SIZE];
+  if (inputBytes < sizeof(header))
+  {
+    vtkErrorMacro("Invalid delta stream, missing header.");
+    return VTK_ERROR;
+  }
+  const unsigned char* in = this->Input->GetPointer(0);
+  std::memcpy(header, in, sizeof(header));
+  if (header[MAGIC] != DELTA_MAGIC)
+  {
+    vtkErrorMacro("Invalid delta stream.");
+    return VTK_ERROR;
+  }
+
+  const bool keyframe = (header[FLAGS] & DELTA_KEYFRAME_FLAG) != 0;
+  const int width = static_cast<int>(header[WIDTH]);
+  const int height = static_cast<int>(header[HEIGHT]);
+  const int numComps = static_cast<int>(header[NUMBER_OF_COMPONENTS]);
+  const int tileSize = static_cast<int>(header[TILE_SIZE]);
+  const unsigned int numChangedTiles = header[NUMBER_OF_CHANGED_TILES];
+  const size_t compressedSize = header[PACKED_SIZE];
+  if (tileSize <= 0 || (numComps != 3 && numComps != 4) ||
+    this->Output->GetNumberOfComponents() != numComps ||
+    this->Output->GetNumberOfTuples() != static_cast<vtkIdType>(width) * height)
+  {
+    vtkErrorMacro("Delta stream does not match the output image.");
+    return VTK_ERROR;
+  }
+
+  if (!keyframe &&
+    (!this->DecodedFrameValid || this->DecodedFrameNumber != header[BASE_FRAME_NUMBER] ||
+      this->DecodedWidth != width || this->DecodedHeight != height ||
+      this->DecodedFrame->GetNumberOfComponents() != numComps))
+  {
+    // we missed a frame, wait for the next keyframe.
+    this->DecodedFrameValid = false;
+    vtkErrorMacro("Delta frame " << header[FRAME_NUMBER]
+                                 << " does not apply to the last decoded frame, "
+                                    "a keyframe is needed.");
+    return VTK_ERROR;
+  }
+
+  const TileLayout layout(width, height, tileSize);
+  const int numTiles = layout.GetNumberOfTiles();
+  std::vector<unsigned int> changedTiles;
+  size_t offset = sizeof(header);
+  if (keyframe)
+  {
+    changedTiles.resize(static_cast<size_t>(numTiles));
+    for (int tile = 0; tile < numTiles; ++tile)
+    {
+      changedTiles[tile] = static_cast<unsigned int>(tile);
+    }
+  }
+  else
+  {
+    const size_t indicesBytes = numChangedTiles * sizeof(unsigned int);
+    if (offset + indicesBytes > inputBytes)
+    {
+      vtkErrorMacro("Truncated delta stream.");
+      return VTK_ERROR;
+    }
+    changedTiles.resize(numChangedTiles);
+    std::memcpy(changedTiles.data(), in + offset, indicesBytes);
+    offset += indicesBytes;
+  }
+  if (offset + compressedSize > inputBytes)
+  {
+    vtkErrorMacro("Truncated delta stream.");
+    return VTK_ERROR;
+  }
+
+  std::vector<vtkIdType> offsets(1, 0);
+  for (unsigned int tile : changedTiles)
+  {
+    if (tile >= static_cast<unsigned int>(numTiles))
+    {
+      vtkErrorMacro("Invalid tile index in delta stream.");
+      return VTK_ERROR;
+    }
+    offsets.push_back(offsets.back() + layout.GetNumberOfTilePixels(static_cast<int>(tile)));
+  }
+
+  if (keyframe)
+  {
+    this->DecodedFrame->SetNumberOfComponents(numComps);
+    this->DecodedFrame->SetNumberOfTuples(static_cast<vtkIdType>(width) * height);
+    this->DecodedWidth = width;
+    this->DecodedHeight = height;
+  }
+
+  if (compressedSize > 0)
+  {
+    this->CompressedTiles->SetNumberOfComponents(1);
+    this->CompressedTiles->SetNumberOfTuples(static_cast<vtkIdType>(compressedSize));
+    std::memcpy(this->CompressedTiles->GetPointer(0), in + offset, compressedSize);
+
+    this->PackedTiles->SetNumberOfComponents(numComps);
+    this->PackedTiles->SetNumberOfTuples(offsets.back());
+
+    const int tileCompressor = this->TileCompressor;
+    this->TileCompressor = static_cast<int>(header[TILE_COMPRESSOR]);
+    vtkImageCompressor* compressor = this->GetTileCompressorInstance();
+    this->TileCompressor = tileCompressor;
+    compressor->SetInput(this->CompressedTiles);
+    compressor->SetOutput(this->PackedTiles);
+    if (compressor->Decompress() == VTK_ERROR)
+    {
+      this->DecodedFrameValid = false;
+      vtkErrorMacro("Failed to decompress changed tiles.");
+      return VTK_ERROR;
+    }
+
+    vtkSMPTools::For(0, static_cast<vtkIdType>(changedTiles.size()),
+      [&](vtkIdType begin, vtkIdType end)
+      {
+        for (vtkIdType cc = begin; cc < end; ++cc)
+        {
+          layout.CopyTile(static_cast<int>(changedTiles[cc]), numComps,
+            this->DecodedFrame->GetPointer(0),
+            this->PackedTiles->GetPointer(offsets[cc] * numComps), false);
+        }
+      });
+  }
+
+  std::memcpy(this->Output->GetPointer(0), this->DecodedFrame->GetPointer(0),
+    static_cast<size_t>(width) * height * numComps);
+  this->DecodedFrameValid = true;
+  this->DecodedFrameNumber = header[FRAME_NUMBER];
+  this->NumberOfTiles = numTiles;
+  this->NumberOfChangedTiles = static_cast<int>(changedTiles.size());
+  return VTK_OK;
+}
+
+//-----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::SaveConfiguration(vtkMultiProcessStream* stream)
+{
+  this->Superclass::SaveConfiguration(stream);
+  *stream << this->TileSize << this->TileCompressor << this->Quality << this->KeyFrameInterval;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkDeltaImageCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
+{
+  if (this->Superclass::RestoreConfiguration(stream))
+  {
+    int tileSize, tileCompressor, quality, keyFrameInterval;
+    *stream >> tileSize >> tileCompressor >> quality >> keyFrameInterval;
+    this->SetTileSize(tileSize);
+    this->SetTileCompressor(tileCompressor);
+    this->SetQuality(quality);
+    this->SetKeyFrameInterval(keyFrameInterval);
+    this->ForceKeyFrame();
+    return true;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkDeltaImageCompressor::SaveConfiguration()
+{
+  std::ostringstream oss;
+  oss << this->Superclass::SaveConfiguration() << " " << this->TileSize << " "
+      << this->TileCompressor << " " << this->Quality << " " << this->KeyFrameInterval;
+  this->SetConfiguration(oss.str().c_str());
+  return this->Configuration;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkDeltaImageCompressor::RestoreConfiguration(const char* stream)
+{
+  stream = this->Superclass::RestoreConfiguration(stream);
+  if (stream)
+  {
+    std::istringstream iss(stream);
+    int tileSize, tileCompressor, quality, keyFrameInterval;
+    iss >> tileSize >> tileCompressor >> quality >> keyFrameInterval;
+    if (iss.fail())
+    {
+      return nullptr;
+    }
+    // tellg() fails once the last field ends the stream.
+    const std::streampos pos =
+      iss.eof() ? std::streampos(strlen(stream)) : std::streampos(iss.tellg());
+    if (pos == std::streampos(-1))
+    {
+      return nullptr;
+    }
+    this->SetTileSize(tileSize);
+    this->SetTileCompressor(tileCompressor);
+    this->SetQuality(quality);
+    this->SetKeyFrameInterval(keyFrameInterval);
+    this->ForceKeyFrame();
+    return stream + pos;
+  }
+  return nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "TileSize: " << this->TileSize << endl;
+  os << indent << "TileCompressor: " << this->TileCompressor << endl;
+  os << indent << "Quality: " << this->Quality << endl;
+  os << indent << "KeyFrameInterval: " << this->KeyFrameInterval << endl;
+  os << indent << "NumberOfChangedTiles: " << this->NumberOfChangedTiles << endl;
+  os << indent << "NumberOfTiles: " << this->NumberOfTiles << endl;
+}
@@ -0,0 +1,173 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkDeltaImageCompressor
+ * @brief   Image compressor/decompressor that only sends the tiles that
+ * changed since the previous frame.
+ *
+ * vtkDeltaImageCompressor keeps the previous frame on both ends of the
+ * connection. On compression, the image is split into square tiles of
+ * TileSize pixels and only the tiles that differ from the previous frame are
+ * packed together and compressed using LZ4 or SQUIRT (see TileCompressor).
+ * On decompression, the changed tiles are written over the previously decoded
+ * frame. This greatly reduces the bandwidth when only a small region of the
+ * image changes between frames, for example when dragging a widget.
+ *
+ * A keyframe, i.e. a frame with all tiles, is sent for the first frame, when
+ * the image resolution or number of components changes, when the effective
+ * quality (Quality, or 0 in LossLessMode) changes, every KeyFrameInterval
+ * frames and after ForceKeyFrame() is called. Each frame
+ * carries its sequence number and the sequence number of the frame it is
+ * relative to; if the decompressor detects that it missed a frame, it fails
+ * to decompress until the next keyframe is received.
+ * vtkPVClientServerSynchronizedRenderers then requests a keyframe from the
+ * sending end, which calls ForceKeyFrame(). Changing the configuration with
+ * RestoreConfiguration() also forces a keyframe.
+ *
+ * Since changed tiles replace the previous tile contents instead of being
+ * added to them, lossy tile compression does not accumulate errors across
+ * frames.
+ */
+
+#ifndef vtkDeltaImageCompressor_h
+#define vtkDeltaImageCompressor_h
+
+#include "vtkImageCompressor.h"
+#include "vtkNew.h"                                   // needed for vtkNew
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
+
+class vtkLZ4Compressor;
+class vtkMultiProcessStream;
+class vtkSquirtCompressor;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkDeltaImageCompressor : public vtkImageCompressor
+{
+public:
+  static vtkDeltaImageCompressor* New();
+  vtkTypeMacro(vtkDeltaImageCompressor, vtkImageCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum TileCompressorTypes
+  {
+    LZ4 = 0,
+    SQUIRT = 1
+  };
+
+  ///@{
+  /**
+   * Set the size, in pixels, of the side of the square tiles compared between
+   * frames. Default is 64.
+   */
+  vtkSetClampMacro(TileSize, int, 8, 1024);
+  vtkGetMacro(TileSize, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set the compressor used for the changed tiles. Default is LZ4.
+   */
+  vtkSetClampMacro(TileCompressor, int, LZ4, SQUIRT);
+  vtkGetMacro(TileCompressor, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set the quality level passed to the tile compressor (see
+   * vtkLZ4Compressor::SetQuality and vtkSquirtCompressor::SetSquirtLevel).
+   * Default is 3.
+   */
+  vtkSetClampMacro(Quality, int, 0, 5);
+  vtkGetMacro(Quality, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set the number of frames after which a keyframe is sent regardless of
+   * what changed. 0 disables periodic keyframes. Default is 0.
+   */
+  vtkSetClampMacro(KeyFrameInterval, int, 0, VTK_INT_MAX);
+  vtkGetMacro(KeyFrameInterval, int);
+  ///@}
+
+  /**
+   * Request that the next compressed frame be a keyframe. Call this when the
+   * receiving end reports that it failed to decompress a frame.
+   */
+  void ForceKeyFrame();
+
+  /**
+   * Returns the number of tiles sent in the last compressed frame and the
+   * total number of tiles in the image.
+   */
+  vtkGetMacro(NumberOfChangedTiles, int);
+  vtkGetMacro(NumberOfTiles, int);
+
+  /**
+   * Communicates the next expected image resolution.
+   */
+  void SetImageResolution(int width, int height) override;
+
+  ///@{
+  /**
+   * Compress/Decompress data array on the objects input with results
+   * in the objects output. See also Set/GetInput/Output.
+   */
+  int Compress() override;
+  int Decompress() override;
+  ///@}
+
+  ///@{
+  /**
+   * Serialize/Restore compressor configuration (but not the data) into the stream.
+   */
+  void SaveConfiguration(vtkMultiProcessStream* stream) override;
+  bool RestoreConfiguration(vtkMultiProcessStream* stream) override;
+  const char* SaveConfiguration() override;
+  const char* RestoreConfiguration(const char* stream) override;
+  ///@}
+
+protected:
+  vtkDeltaImageCompressor();
+  ~vtkDeltaImageCompressor() override;
+
+  vtkImageCompressor* GetTileCompressorInstance();
+
+  int TileSize;
+  int TileCompressor;
+  int Quality;
+  int KeyFrameInterval;
+
+  int Width;
+  int Height;
+  int NumberOfChangedTiles;
+  int NumberOfTiles;
+
+private:
+  vtkDeltaImageCompressor(const vtkDeltaImageCompressor&) = delete;
+  void operator=(const vtkDeltaImageCompressor&) = delete;
+
+  vtkNew<vtkLZ4Compressor> LZ4Compressor;
+  vtkNew<vtkSquirtCompressor> SquirtCompressor;
+
+  // Packed pixels of the changed tiles.
+  vtkNew<vtkUnsignedCharArray> PackedTiles;
+  vtkNew<vtkUnsignedCharArray> CompressedTiles;
+
+  // Compressor side state.
+  vtkNew<vtkUnsignedCharArray> PreviousFrame;
+  int PreviousWidth;
+  int PreviousHeight;
+  int PreviousQuality;
+  bool KeyFrameRequested;
+  unsigned int FrameNumber;
+  int FramesSinceKeyFrame;
+
+  // Decompressor side state.
+  vtkNew<vtkUnsignedCharArray> DecodedFrame;
+  int DecodedWidth;
+  int DecodedHeight;
+  bool DecodedFrameValid;
+  unsigned int DecodedFrameNumber;
+};
+
+#endif
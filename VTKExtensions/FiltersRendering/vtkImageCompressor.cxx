@@ -7,6 +7,7 @@
 #include "vtkCommand.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkUnsignedCharArray.h"
+#include <cstring>
 #include <sstream>
 #include <string>
 
@@ -83,7 +84,9 @@ const char* vtkImageCompressor::RestoreConfiguration(const char* stream)
     int mode;
     iss >> mode;
     this->SetLossLessMode(mode);
-    return stream + iss.tellg();
+    // tellg() fails once the last field ends the stream.
+    const std::streampos pos = iss.tellg();
+    return pos == std::streampos(-1) ? stream + strlen(stream) : stream + pos;
   }
   return nullptr;
 }
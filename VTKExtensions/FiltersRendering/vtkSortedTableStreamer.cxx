@@ -23,13 +23,21 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkPartitionedDataSet.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkUnsignedIntArray.h"
 
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+#include "vtkMPI.h"
+#include "vtkMPICommunicator.h"
+#endif
+
 #include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <numeric>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -564,11 +572,74 @@ public:
     }
   };
 
+  // Key used by the distributed sort. The process id and the local index
+  // differentiate equal values so that the global order is total.
+  struct SortKey
+  {
+    T Value;
+    int ProcessId;
+    vtkIdType Index;
+
+    static bool Less(const SortKey& a, const SortKey& b)
+    {
+      if (a.Value != b.Value)
+      {
+        return a.Value < b.Value;
+      }
+      if (a.ProcessId != b.ProcessId)
+      {
+        return a.ProcessId < b.ProcessId;
+      }
+      return a.Index < b.Index;
+    }
+  };
+  struct KeyFiller
+  {
+    template <class TArray>
+    void operator()(
+      TArray* dataArray, int selectedComponent, int processId, std::vector<SortKey>& keys)
+    {
+      const vtkIdType numTuples = dataArray->GetNumberOfTuples();
+      const int numComponents = dataArray->GetNumberOfComponents();
+      const auto data = vtk::DataArrayTupleRange(dataArray);
+
+      if (numComponents == 1 && selectedComponent < 0)
+      {
+        selectedComponent = 0; // We can not compute magnitude on scalar value
+      }
+
+      keys.resize(numTuples);
+      vtkSMPTools::For(0, numTuples, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          SortKey& key = keys[i];
+          key.ProcessId = processId;
+          key.Index = i;
+          if (selectedComponent < 0)
+          {
+            // Compute magnitude
+            double value = 0;
+            for (int k = 0; k < numComponents; k++)
+            {
+              const double tmp = static_cast<double>(data[i][k]);
+              value += tmp * tmp;
+            }
+            value = sqrt(value) / sqrt(static_cast<double>(numComponents));
+            key.Value = static_cast<T>(value);
+          }
+          else
+          {
+            key.Value = static_cast<T>(data[i][selectedComponent]);
+          }
+        }
+      });
+    }
+  };
+
   Internals()
   {
     // Only used for testing
     this->LocalSorter = nullptr;
-    this->GlobalHistogram = nullptr;
     this->Debug = false;
   }
 
@@ -593,91 +664,47 @@ public:
 
     // Create internal objects
     this->LocalSorter = new ArraySorter();
-    this->GlobalHistogram = new Histogram(HISTOGRAM_SIZE);
   }
 
   ~Internals() override
   {
     delete this->LocalSorter;
-    delete this->GlobalHistogram;
   }
 
   // --------------------------------------------------------------------------
   bool IsSortable() override
   {
-    // See if one process is able to sort the table,
-    // if not then just say NOT sortable
-    int localCanSort = (this->DataToSort == nullptr) ? 0 : 1;
-    int globalCanSort;
-    this->MPI->AllReduce(&localCanSort, &globalCanSort, 1, vtkCommunicator::MAX_OP);
-    if (globalCanSort == 0)
-    {
-      return false;
-    }
-
-    // Communication buffer
-    double localRange[2] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
-
-    // Get the local information
-    if (this->DataToSort && this->DataToSort->GetNumberOfTuples() > 0)
-    {
-      this->DataToSort->GetRange(localRange, this->SelectedComponent);
-    }
-
-    // Gather the array range to build a common scale histogram
-    this->MPI->AllReduce(&localRange[0], &this->CommonRange[0], 1, vtkCommunicator::MIN_OP);
-    this->MPI->AllReduce(&localRange[1], &this->CommonRange[1], 1, vtkCommunicator::MAX_OP);
-
-    // Make sure that the range stay in the original min/max of the type
-    // in case of magnitude.
-    // CAUTION: As some process may not have DataToSort due to block
-    //          distribution, we MUST globaly agree on a ratio.
-    // 3 case:
-    //    - scalar    => no ratio (=1)
-    //    - magniture => ratio    (>0)
-    //    - no data   => ratio ? MUST be overridden by other
-
-    double localRatio = 1;
-    double globalRatio;
-    if (this->DataToSort && this->SelectedComponent == -1 &&
-      this->DataToSort->GetNumberOfComponents() > 1)
+    // A single reduction tells whether any process has the array, whether the
+    // values differ and whether any process has to rebuild its cache. The
+    // cache is built collectively, so all processes must rebuild it together.
+    // The range is only compared, so the magnitude does not need to be scaled
+    // as the keys are.
+    double localValues[4] = { this->NeedToBuildCache ? 1. : 0., 0., -VTK_DOUBLE_MAX,
+      -VTK_DOUBLE_MAX };
+    if (this->DataToSort)
     {
-      localRatio = sqrt(static_cast<double>(this->DataToSort->GetNumberOfComponents()));
-    }
-    else if (this->DataToSort == nullptr)
-    {
-      localRatio = 0;
+      localValues[1] = 1;
+      if (this->DataToSort->GetNumberOfTuples() > 0)
+      {
+        double localRange[2];
+        this->DataToSort->GetRange(localRange, this->SelectedComponent);
+        localValues[2] = -localRange[0];
+        localValues[3] = localRange[1];
+      }
     }
-    this->MPI->AllReduce(&localRatio, &globalRatio, 1, vtkCommunicator::MAX_OP);
-
-    // Apply the common ratio
-    this->CommonRange[0] /= globalRatio;
-    this->CommonRange[1] /= globalRatio;
+    double globalValues[4];
+    this->MPI->AllReduce(localValues, globalValues, 4, vtkCommunicator::MAX_OP);
 
-    double delta = std::fabs(this->CommonRange[1] - this->CommonRange[0]);
-    delta *= delta;
-
-    double epsilon = std::nextafter(this->CommonRange[0], std::numeric_limits<double>::max());
-    epsilon = std::fabs(epsilon - this->CommonRange[0]);
-
-    bool sortable = delta > epsilon;
-
-    // Extend range with epsilon to make sure that a computed magnitude will fit in
-    this->CommonRange[0] -= epsilon;
-    this->CommonRange[1] += epsilon;
-
-    return sortable;
+    this->NeedToBuildCache = globalValues[0] > 0;
+    return globalValues[1] > 0 && globalValues[3] > -globalValues[2];
   }
 
   // --------------------------------------------------------------------------
-  int BuildCache(bool sortableArray, bool invertOrder)
+  int BuildCache(bool sortableArray)
   {
     // We are building the cache so no need to build it next time
     this->NeedToBuildCache = false;
 
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
-
     // Is there something to sort ???
     if (!sortableArray)
     {
@@ -686,49 +713,207 @@ public:
       {
         this->LocalSorter->FillArray(this->DataToSort->GetNumberOfTuples());
       }
+      this->SortedSlice.clear();
+      this->SliceOffsets.clear();
     }
     else
     {
-      if (this->DataToSort)
+      this->BuildSortedSlice();
+    }
+    return 1;
+  }
+
+  // --------------------------------------------------------------------------
+  // Distributed sample sort of the keys of the array to sort. Once done, each
+  // process holds a sorted slice of the global order in SortedSlice and the
+  // slices are range-partitioned by process id, so the global index of
+  // SortedSlice[i] is SliceOffsets[Me] + i.
+  // Only the keys are exchanged, the rows stay on the process that owns them.
+  void BuildSortedSlice()
+  {
+    // Build and sort the local keys
+    std::vector<SortKey> localKeys;
+    if (this->DataToSort)
+    {
+      KeyFiller filler;
+      using Dispatcher = vtkArrayDispatch::DispatchByValueType<vtkTypeList::Create<T>>;
+      if (!Dispatcher::Execute(
+            this->DataToSort, filler, this->SelectedComponent, this->Me, localKeys))
       {
-        // Sort and build local histogram
-        using Dispatcher = vtkArrayDispatch::DispatchByValueType<vtkTypeList::Create<T>>;
-        if (!Dispatcher::Execute(this->DataToSort, *this->LocalSorter, this->SelectedComponent,
-              HISTOGRAM_SIZE, this->CommonRange, invertOrder))
-        {
-          this->LocalSorter->operator()(this->DataToSort, this->SelectedComponent, HISTOGRAM_SIZE,
-            this->CommonRange, invertOrder);
-        }
+        filler(this->DataToSort, this->SelectedComponent, this->Me, localKeys);
       }
-      else
+    }
+    vtkSMPTools::Sort(localKeys.begin(), localKeys.end(), SortKey::Less);
+
+    this->SliceOffsets.assign(this->NumProcs + 1, 0);
+    if (this->NumProcs == 1)
+    {
+      this->SortedSlice.swap(localKeys);
+      this->SliceOffsets[1] = static_cast<vtkIdType>(this->SortedSlice.size());
+      return;
+    }
+
+    // Only the processes that have the array own a slice. Processes without
+    // the array may have instantiated a different value type, so they never
+    // receive nor interpret keys.
+    int localHasData = this->DataToSort ? 1 : 0;
+    std::vector<int> hasData(this->NumProcs);
+    this->MPI->AllGather(&localHasData, hasData.data(), 1);
+    std::vector<int> owners;
+    for (int pid = 0; pid < this->NumProcs; ++pid)
+    {
+      if (hasData[pid])
       {
-        // Build empty local histogram
-        this->LocalSorter->Clear();
-        this->LocalSorter->Histo = new Histogram(HISTOGRAM_SIZE);
-        this->LocalSorter->Histo->SetScalarRange(this->CommonRange);
-        this->LocalSorter->Histo->Inverted = invertOrder;
+        owners.push_back(pid);
       }
+    }
+    const int nbOwners = static_cast<int>(owners.size());
 
-      // Initialize the global histogram with same range
-      this->LocalSorter->Histo->CopyRangeTo(*this->GlobalHistogram);
-
-      // Make sure that the global histogram is properly initialized
-      this->GlobalHistogram->ClearHistogramValues();
-      this->GlobalHistogram->Inverted = invertOrder;
+    // Pick regular samples from the local sorted keys and share them
+    const vtkIdType nbLocalKeys = static_cast<vtkIdType>(localKeys.size());
+    const vtkIdType nbSamples = std::min(nbLocalKeys,
+      std::min(static_cast<vtkIdType>(SAMPLES_PER_OWNER) * nbOwners,
+        static_cast<vtkIdType>(MAX_SAMPLES_PER_PROCESS)));
+    std::vector<SortKey> samples(nbSamples);
+    for (vtkIdType i = 0; i < nbSamples; ++i)
+    {
+      samples[i] = localKeys[((2 * i + 1) * nbLocalKeys) / (2 * nbSamples)];
+    }
 
-      // Send local histogram and receive every histogram from everybody
-      this->MPI->AllGather(this->LocalSorter->Histo->Values, bufferHistogramValues, HISTOGRAM_SIZE);
+    const vtkIdType sampleLength = nbSamples * static_cast<vtkIdType>(sizeof(SortKey));
+    std::vector<vtkIdType> sampleLengths(this->NumProcs);
+    std::vector<vtkIdType> sampleOffsets(this->NumProcs, 0);
+    this->MPI->AllGather(&sampleLength, sampleLengths.data(), 1);
+    std::partial_sum(sampleLengths.begin(), sampleLengths.end() - 1, sampleOffsets.begin() + 1);
+    std::vector<char> allSamplesBuffer(sampleOffsets.back() + sampleLengths.back() + 1);
+    this->MPI->AllGatherV(reinterpret_cast<const char*>(samples.data()), allSamplesBuffer.data(),
+      sampleLength, sampleLengths.data(), sampleOffsets.data());
 
-      // Merge all histogram into the GlobalHistogram
-      for (int idx = 0, nb = this->NumProcs * HISTOGRAM_SIZE; idx < nb; ++idx)
+    // Choose one splitter per slice boundary
+    std::vector<SortKey> splitters;
+    if (this->DataToSort)
+    {
+      std::vector<SortKey> allSamples((allSamplesBuffer.size() - 1) / sizeof(SortKey));
+      if (!allSamples.empty())
       {
-        this->GlobalHistogram->TotalValues += bufferHistogramValues[idx];
-        this->GlobalHistogram->Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
+        std::memcpy(
+          allSamples.data(), allSamplesBuffer.data(), allSamples.size() * sizeof(SortKey));
+        std::sort(allSamples.begin(), allSamples.end(), SortKey::Less);
+        for (int owner = 1; owner < nbOwners; ++owner)
+        {
+          splitters.push_back(allSamples[(owner * allSamples.size()) / nbOwners]);
+        }
       }
     }
 
-    delete[] bufferHistogramValues;
-    return 1;
+    // Find the range of local keys sent to each owner
+    std::vector<vtkIdType> sendCounts(this->NumProcs, 0);
+    std::vector<vtkIdType> sendOffsets(this->NumProcs, 0);
+    auto first = localKeys.begin();
+    for (int owner = 0; owner < nbOwners && !localKeys.empty(); ++owner)
+    {
+      auto last = owner < static_cast<int>(splitters.size())
+        ? std::lower_bound(first, localKeys.end(), splitters[owner], SortKey::Less)
+        : localKeys.end();
+      sendOffsets[owners[owner]] = first - localKeys.begin();
+      sendCounts[owners[owner]] = last - first;
+      first = last;
+    }
+
+    // Exchange the keys and sort the received ones
+    std::vector<SortKey> slice = this->ExchangeKeys(localKeys, sendCounts, sendOffsets);
+    std::vector<SortKey>().swap(localKeys);
+    vtkSMPTools::Sort(slice.begin(), slice.end(), SortKey::Less);
+    this->SortedSlice.swap(slice);
+
+    // Share the slice sizes to be able to locate any global index
+    vtkIdType sliceSize = static_cast<vtkIdType>(this->SortedSlice.size());
+    this->MPI->AllGather(&sliceSize, this->SliceOffsets.data() + 1, 1);
+    std::partial_sum(
+      this->SliceOffsets.begin(), this->SliceOffsets.end(), this->SliceOffsets.begin());
+  }
+
+  // --------------------------------------------------------------------------
+  // All-to-all exchange of the keys: sends sendCounts[pid] keys starting at
+  // sendOffsets[pid] to each process pid and returns the keys received from
+  // all the processes.
+  std::vector<SortKey> ExchangeKeys(const std::vector<SortKey>& keys,
+    const std::vector<vtkIdType>& sendCounts, const std::vector<vtkIdType>& sendOffsets)
+  {
+    std::vector<SortKey> received;
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+    if (auto communicator = vtkMPICommunicator::SafeDownCast(this->MPI))
+    {
+      MPI_Comm comm = *communicator->GetMPIComm()->GetHandle();
+      std::vector<int> counts(sendCounts.begin(), sendCounts.end());
+      std::vector<int> offsets(sendOffsets.begin(), sendOffsets.end());
+      std::vector<int> recvCounts(this->NumProcs);
+      std::vector<int> recvOffsets(this->NumProcs, 0);
+      MPI_Alltoall(counts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, comm);
+      std::partial_sum(recvCounts.begin(), recvCounts.end() - 1, recvOffsets.begin() + 1);
+      received.resize(static_cast<size_t>(recvOffsets.back()) + recvCounts.back());
+
+      MPI_Datatype keyType;
+      MPI_Type_contiguous(static_cast<int>(sizeof(SortKey)), MPI_BYTE, &keyType);
+      MPI_Type_commit(&keyType);
+      MPI_Alltoallv(const_cast<SortKey*>(keys.data()), counts.data(), offsets.data(), keyType,
+        received.data(), recvCounts.data(), recvOffsets.data(), keyType, comm);
+      MPI_Type_free(&keyType);
+      return received;
+    }
+#endif
+
+    // Pairwise exchanges scheduled as a round-robin tournament: in each round
+    // every process talks to at most one other one, and the lower process id of
+    // each pair sends first, so that blocking sends never deadlock.
+    received.insert(received.end(), keys.begin() + sendOffsets[this->Me],
+      keys.begin() + sendOffsets[this->Me] + sendCounts[this->Me]);
+    const int nbPlayers = this->NumProcs + (this->NumProcs % 2);
+    for (int round = 0; round < nbPlayers - 1; ++round)
+    {
+      int partner = -1;
+      for (int pid = 0; pid < nbPlayers; ++pid)
+      {
+        const bool paired = (pid == nbPlayers - 1 || this->Me == nbPlayers - 1)
+          ? (2 * std::min(pid, this->Me)) % (nbPlayers - 1) == round
+          : (pid + this->Me) % (nbPlayers - 1) == round;
+        if (pid != this->Me && paired)
+        {
+          partner = pid;
+          break;
+        }
+      }
+      if (partner < 0 || partner >= this->NumProcs)
+      {
+        continue;
+      }
+
+      const auto send = [&]() {
+        const vtkIdType count = sendCounts[partner];
+        this->MPI->Send(&count, 1, partner, VTK_KEYS_EXCHANGE_TAG);
+        this->MPI->Send(reinterpret_cast<const char*>(keys.data() + sendOffsets[partner]),
+          count * static_cast<vtkIdType>(sizeof(SortKey)), partner, VTK_KEYS_EXCHANGE_TAG);
+      };
+      const auto receive = [&]() {
+        vtkIdType count = 0;
+        this->MPI->Receive(&count, 1, partner, VTK_KEYS_EXCHANGE_TAG);
+        const size_t begin = received.size();
+        received.resize(begin + count);
+        this->MPI->Receive(reinterpret_cast<char*>(received.data() + begin),
+          count * static_cast<vtkIdType>(sizeof(SortKey)), partner, VTK_KEYS_EXCHANGE_TAG);
+      };
+      if (this->Me < partner)
+      {
+        send();
+        receive();
+      }
+      else
+      {
+        receive();
+        send();
+      }
+    }
+    return received;
   }
 
   // --------------------------------------------------------------------------
@@ -743,7 +928,7 @@ public:
     // ------------------------------------------------------------------------
     if (this->NeedToBuildCache)
     {
-      this->BuildCache(false, revertOrder);
+      this->BuildCache(false);
     }
 
     // Build empty local table with empty arrays so they stay in the same order
@@ -874,45 +1059,88 @@ public:
   {
     // ------------------------------------------------------------------------
     // Make sure that the Cache is built
-    //    This will sort the local array, that's why we don't want to do it
-    //    at each execution. Specially when we only change the requested block.
+    //    This will sort the keys across processes, that's why we don't want to
+    //    do it at each execution. Specially when we only change the requested
+    //    block.
     // ------------------------------------------------------------------------
-    if (this->NeedToBuildCache)
+    if (this->NeedToBuildCache || this->SliceOffsets.empty())
     {
-      this->BuildCache(true, revertOrder);
+      this->BuildCache(true);
     }
 
     // ------------------------------------------------------------------------
-    // Search for lower bound
+    // Find the requested window in the ascending global order
     // ------------------------------------------------------------------------
-    vtkIdType nbElementsToRemoveFromHead = 0;
-    vtkIdType localOffset = 0;
-    vtkIdType nbElementsInBar = 0;
-    this->SearchGlobalIndexLocation((block * blockSize), this->LocalSorter->Histo,
-      this->GlobalHistogram, nbElementsToRemoveFromHead, localOffset, nbElementsInBar);
+    const vtkIdType total = this->SliceOffsets.back();
+    vtkIdType windowBegin = std::min(block * blockSize, total);
+    vtkIdType windowEnd = std::min(windowBegin + blockSize, total);
+    if (revertOrder)
+    {
+      const vtkIdType tmp = total - windowEnd;
+      windowEnd = total - windowBegin;
+      windowBegin = tmp;
+    }
 
     // ------------------------------------------------------------------------
-    // Search for upper bound
+    // Share the location of the rows of the window held by our slice so that
+    // each process knows which of its rows are requested and in which order.
     // ------------------------------------------------------------------------
-    vtkIdType upperOffset = 0;
-    vtkIdType globalUpperOffset = 0;
-    vtkIdType searchIdx = (this->GlobalHistogram->TotalValues < (block + 1) * blockSize)
-      ? this->GlobalHistogram->TotalValues
-      : ((block + 1) * blockSize);
-    searchIdx--; // It is not a size it is an index (so -1)
-
-    this->SearchGlobalIndexLocation(searchIdx, this->LocalSorter->Histo, this->GlobalHistogram,
-      globalUpperOffset, upperOffset, nbElementsInBar);
+    const vtkIdType sliceBegin = this->SliceOffsets[this->Me];
+    const vtkIdType first = std::max(windowBegin, sliceBegin) - sliceBegin;
+    const vtkIdType last = std::min(windowEnd, this->SliceOffsets[this->Me + 1]) - sliceBegin;
+    std::vector<vtkIdType> localWindow;
+    for (vtkIdType idx = first; idx < last; ++idx)
+    {
+      localWindow.push_back(this->SortedSlice[idx].ProcessId);
+      localWindow.push_back(this->SortedSlice[idx].Index);
+    }
 
-    // We have to include our searched index (so +1)
-    vtkIdType localSize = (upperOffset + nbElementsInBar) - localOffset + 1;
+    std::vector<vtkIdType> window;
+    if (this->NumProcs == 1)
+    {
+      window.swap(localWindow);
+    }
+    else
+    {
+      const vtkIdType localLength = static_cast<vtkIdType>(localWindow.size());
+      std::vector<vtkIdType> lengths(this->NumProcs);
+      std::vector<vtkIdType> offsets(this->NumProcs, 0);
+      this->MPI->AllGather(&localLength, lengths.data(), 1);
+      std::partial_sum(lengths.begin(), lengths.end() - 1, offsets.begin() + 1);
+      window.resize(offsets.back() + lengths.back());
+      this->MPI->AllGatherV(
+        localWindow.data(), window.data(), localLength, lengths.data(), offsets.data());
+    }
+    const vtkIdType windowSize = static_cast<vtkIdType>(window.size() / 2);
+    if (revertOrder)
+    {
+      for (vtkIdType idx = 0; idx < windowSize / 2; ++idx)
+      {
+        std::swap(window[2 * idx], window[2 * (windowSize - idx - 1)]);
+        std::swap(window[2 * idx + 1], window[2 * (windowSize - idx - 1) + 1]);
+      }
+    }
 
     // ------------------------------------------------------------------------
-    // Build local subset table
+    // Build local subset table with our rows, in the window order
     // ------------------------------------------------------------------------
+    vtkIdType nbLocalRows = 0;
+    for (vtkIdType idx = 0; idx < windowSize; ++idx)
+    {
+      nbLocalRows += (window[2 * idx] == this->Me) ? 1 : 0;
+    }
+    ArraySorter localRows;
+    localRows.FillArray(nbLocalRows);
+    for (vtkIdType idx = 0, row = 0; idx < windowSize; ++idx)
+    {
+      if (window[2 * idx] == this->Me)
+      {
+        localRows.Array[row++].OriginalIndex = window[2 * idx + 1];
+      }
+    }
+
     vtkSmartPointer<vtkTable> localSubset;
-    localSubset.TakeReference(
-      this->NewSubsetTable(input, this->LocalSorter, localOffset, localSize));
+    localSubset.TakeReference(this->NewSubsetTable(input, &localRows, 0, nbLocalRows));
 
     // ------------------------------------------------------------------------
     // Find the process that will merge all subset table
@@ -926,7 +1154,7 @@ public:
     {
       vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
       processIdArray->SetName("vtkOriginalProcessIds");
-      processIdArray->ReserveValues((blockSize < localSize) ? localSize : blockSize);
+      processIdArray->ReserveValues(windowSize);
       for (vtkIdType idx = 0; idx < localSubset->GetNumberOfRows(); idx++)
       {
         processIdArray->InsertNextTuple1(mergePid);
@@ -947,6 +1175,7 @@ public:
     // ------------------------------------------------------------------------
     if (this->Me == mergePid)
     {
+      std::vector<vtkIdType> rowOffsets(this->NumProcs, 0);
       vtkSmartPointer<vtkTable> tmp = vtkSmartPointer<vtkTable>::New();
       for (int i = 0; i < this->NumProcs; i++)
       {
@@ -954,36 +1183,20 @@ public:
           continue;
 
         this->MPI->Receive(tmp.GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
-        this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), blockSize);
+        rowOffsets[i] = localSubset->GetNumberOfRows();
+        this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), windowSize);
       }
 
-      // Sort new table/array
-      if (!this->DataToSort)
+      // Each process sent its rows in the window order, so interleave them
+      // following the window.
+      ArraySorter order;
+      order.FillArray(windowSize);
+      for (vtkIdType idx = 0; idx < windowSize; ++idx)
       {
-        // This mean that no output can be provided
-        // std::cout << "ERROR the merge process have no DataArray." << endl;
-        return 1;
+        order.Array[idx].OriginalIndex = rowOffsets[window[2 * idx]]++;
       }
-      vtkDataArray* subsetArray =
-        vtkDataArray::SafeDownCast(localSubset->GetColumnByName(this->DataToSort->GetName()));
-
-      if (!subsetArray)
-      {
-        vtkSortedTableStreamer::PrintInfo(localSubset.GetPointer());
-      }
-
-      ArraySorter sorter;
-      using Dispatcher = vtkArrayDispatch::DispatchByValueType<vtkTypeList::Create<T>>;
-      if (!Dispatcher::Execute(subsetArray, sorter, this->SelectedComponent, HISTOGRAM_SIZE,
-            this->CommonRange, revertOrder))
-      {
-        sorter(
-          subsetArray, this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, revertOrder);
-      }
-
-      // trim it (remove head and tail that don't belong to the result)
-      localSubset.TakeReference(this->NewSubsetTable(
-        localSubset.GetPointer(), &sorter, nbElementsToRemoveFromHead, blockSize));
+      localSubset.TakeReference(
+        this->NewSubsetTable(localSubset.GetPointer(), &order, 0, windowSize));
 
       // Add extra information such as structured indices, block number...
       this->DecorateTable(input, localSubset.GetPointer(), mergePid);
@@ -1000,73 +1213,6 @@ public:
     return 1;
   }
 
-  // --------------------------------------------------------------------------
-  // nbGlobalToSkip is the number of elements that should be skipped at the end
-  // if you exactly want to reach the searchedGlobalIndex.
-  // localOffset is the corresponding local index in the sorted table to the
-  // global index of (searchedGlobalIndex - nbGlobalToSkip)
-  // nbInLocalBar is the local number of elements that are available
-  // in the histogram bar where the searchedGlobalIndex has been found.
-  // nbInLocalBar is used when you want to get an upper bound that
-  // will include the searchedGlobalIndex.
-  void SearchGlobalIndexLocation(vtkIdType searchedGlobalIndex, Histogram* localHistogram,
-    Histogram* globalHistogram, vtkIdType& nbGlobalToSkip, vtkIdType& localOffset,
-    vtkIdType& nbInLocalBar)
-  {
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
-
-    // Local internal working var
-    vtkIdType histogramBarIdx = -1;
-    double currentRange[2];
-    vtkIdType idx, idxEnd;
-
-    // Setup initial histogram range and values
-    Histogram _globalHistogram;
-    Histogram _localHistogram;
-    localHistogram->CopyTo(_localHistogram);
-    globalHistogram->CopyTo(_globalHistogram);
-
-    // Reset local offsets
-    localOffset = 0;
-    nbGlobalToSkip = searchedGlobalIndex;
-
-    do
-    {
-      nbGlobalToSkip -= _globalHistogram.GetNewRange(nbGlobalToSkip, histogramBarIdx, currentRange);
-
-      localOffset += _localHistogram.GetNumberOfElements(0, histogramBarIdx);
-      nbInLocalBar = _localHistogram.GetNumberOfElements(histogramBarIdx, histogramBarIdx + 1);
-
-      // Based on a narrowed range, build local histogram to get closer to the
-      // real index of the object
-      _localHistogram.SetScalarRange(currentRange);
-      _localHistogram.ClearHistogramValues();
-
-      idxEnd = localOffset + nbInLocalBar;
-      for (idx = localOffset; idx < idxEnd; ++idx)
-      {
-        _localHistogram.AddValue(this->LocalSorter->Array[idx].Value);
-      }
-
-      // Exchange local histo with everyone
-      this->MPI->AllGather(_localHistogram.Values, bufferHistogramValues, HISTOGRAM_SIZE);
-
-      // Build global histogram
-      _globalHistogram.SetScalarRange(currentRange);
-      _globalHistogram.ClearHistogramValues();
-
-      idxEnd = this->NumProcs * HISTOGRAM_SIZE;
-      for (idx = 0; idx < idxEnd; ++idx)
-      {
-        _globalHistogram.TotalValues += bufferHistogramValues[idx];
-        _globalHistogram.Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
-      }
-    } while (nbGlobalToSkip > 0 && _globalHistogram.CanBeReduced());
-
-    delete[] bufferHistogramValues;
-  }
-
   // --------------------------------------------------------------------------
   static vtkTable* NewSubsetTable(
     vtkTable* srcTable, ArraySorter* sorter, vtkIdType offset, vtkIdType size)
@@ -1135,8 +1281,10 @@ public:
   // --------------------------------------------------------------------------
   bool IsInvalid(vtkTable* input, vtkDataArray* dataToProcess) override
   {
-    return !dataToProcess || input->GetMTime() != this->InputMTime ||
-      dataToProcess->GetMTime() != this->DataMTime;
+    // Processes without the array keep their internal object as well, so that
+    // they do not force all the others to rebuild their cache.
+    return dataToProcess != this->DataToSort || input->GetMTime() != this->InputMTime ||
+      (dataToProcess && dataToProcess->GetMTime() != this->DataMTime);
   }
 
   // --------------------------------------------------------------------------
@@ -1347,8 +1495,7 @@ private:
   vtkMTimeType DataMTime;     // Keep the original data MTime
   vtkDataArray* DataToSort;   // DataArray to sort
   ArraySorter* LocalSorter;   // Local ArraySorter based on global range
-  Histogram* GlobalHistogram; // Globaly merged Histogram based on global range
-  double CommonRange[2];      // Scalar range used across processes
+  double CommonRange[2];      // Range of the process ids sorted by Extract
   int Me;                     // Current process ID
   int NumProcs;               // Number of processes involved
   vtkCommunicator* MPI;       // MPI communicator to send/receive/gather
@@ -1356,7 +1503,11 @@ private:
   bool NeedToBuildCache;
   bool Debug;
 
+  std::vector<SortKey> SortedSlice;     // Local slice of the global ascending order
+  std::vector<vtkIdType> SliceOffsets; // Global index of the first key of each slice
+
   static constexpr int VTK_TABLE_EXCHANGE_TAG = 50;
+  static constexpr int VTK_KEYS_EXCHANGE_TAG = 51;
   // HISTOGRAM_SIZE could be computed dynamically based on the type of the
   // array to sort but to make sure that unsigned char won't be distributed
   // correctly we set the histogram size to be their max number of element
@@ -1364,6 +1515,10 @@ private:
   // Maybe make some test on huge cluster to see which histogram size is
   // the best.
   static constexpr int HISTOGRAM_SIZE = 256;
+  // Number of samples taken per slice owner on each process to choose the
+  // splitters of the sample sort, bounded to keep the samples exchange small.
+  static constexpr int SAMPLES_PER_OWNER = 16;
+  static constexpr int MAX_SAMPLES_PER_PROCESS = 4096;
 };
 //****************************************************************************
 vtkStandardNewMacro(vtkSortedTableStreamer);
@@ -9,6 +9,15 @@
  * This filter is used quickly get a sorted subset of a given vtkTable.
  * By sorted we mean a subset build from a global sort even if some optimisation
  * allow us to skip a global table sorting.
+ *
+ * The first request after the input, the column, the component or the order
+ * changed sorts the keys of the selected column across all processes using a
+ * sample sort: each process sorts its keys with vtkSMPTools, splitters are
+ * chosen from regular samples of the sorted keys and the keys are exchanged
+ * so that each process holds a sorted, range-partitioned slice of the global
+ * order. The rows themselves stay on the process that owns them. Subsequent
+ * requests for any block only exchange the location of the requested rows and
+ * the rows themselves.
  */
 
 #ifndef vtkSortedTableStreamer_h
@@ -5,21 +5,204 @@
 #include "vtkSquirtCompressor.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
+
 #include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <sstream>
+#include <vector>
 
 vtkStandardNewMacro(vtkSquirtCompressor);
 
+namespace
+{
+// Used for the fields missing from a configuration.
+constexpr int DefaultSquirtLevel = 3;
+constexpr int DefaultNumberOfStripes = 0;
+}
+
 //-----------------------------------------------------------------------------
 vtkSquirtCompressor::vtkSquirtCompressor()
-  : SquirtLevel(3)
+  : SquirtLevel(DefaultSquirtLevel)
+  , NumberOfStripes(DefaultNumberOfStripes)
 {
 }
 
 //-----------------------------------------------------------------------------
 vtkSquirtCompressor::~vtkSquirtCompressor() = default;
 
+namespace
+{
+// Magic word identifying a tiled (striped) squirt stream.
+constexpr unsigned int SQUIRT_TILED_MAGIC = 0x54515153; // "SQQT"
+// Number of header words before the per-stripe sizes in a tiled stream.
+constexpr vtkIdType SQUIRT_TILED_HEADER_SIZE = 3;
+
+const unsigned char SQUIRT_COMPRESS_MASKS[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF },
+  { 0xFE, 0xFF, 0xFE, 0xFE }, { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 },
+  { 0xF0, 0xF8, 0xF0, 0xF0 }, { 0xE0, 0xF0, 0xE0, 0xE0 } };
+
+inline unsigned int ReadRGB(const unsigned char* rgb)
+{
+  unsigned int color = 0;
+  unsigned char* p = reinterpret_cast<unsigned char*>(&color);
+  p[0] = rgb[0];
+  p[1] = rgb[1];
+  p[2] = rgb[2];
+  return color;
+}
+
+/**
+ * Returns the number of pixels following `in[0]` that match its color under
+ * `mask`, up to `maxRun`. All `maxRun` comparisons are evaluated without an
+ * early exit so that the compiler can vectorize the loop.
+ */
+inline int ComputeRunRGBA(
+  const unsigned int* in, vtkIdType available, unsigned int mask, int maxRun)
+{
+  const int n = static_cast<int>(std::min<vtkIdType>(available, maxRun));
+  const unsigned int masked = in[0] & mask;
+  unsigned int matches = 0;
+  for (int k = 0; k < n; ++k)
+  {
+    matches |= static_cast<unsigned int>((in[k + 1] & mask) == masked) << k;
+  }
+  int count = 0;
+  while (matches & 0x1)
+  {
+    ++count;
+    matches >>= 1;
+  }
+  return count;
+}
+
+/**
+ * Run-length encodes `numPixels` RGBA pixels into `out` and returns the number
+ * of words written. `out` must have room for `numPixels` words.
+ */
+vtkIdType EncodeRGBA(
+  const unsigned int* in, vtkIdType numPixels, unsigned int compress_mask, unsigned int* out)
+{
+  vtkIdType index = 0;
+  vtkIdType comp_index = 0;
+  while (index < numPixels)
+  {
+    // Record color
+    const unsigned int current_color = out[comp_index] = in[index];
+    unsigned char opacity = *(reinterpret_cast<const unsigned char*>(&current_color) + 3);
+
+    // Compute Run
+    int count = ComputeRunRGBA(in + index, numPixels - index - 1, compress_mask, 0x0F);
+    index += count + 1;
+    if (opacity > 0)
+    {
+      opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
+      opacity = opacity << 4;
+      count |= opacity;
+    }
+
+    // Record Run length
+    reinterpret_cast<unsigned char*>(out)[comp_index * 4 + 3] = static_cast<unsigned char>(count);
+    comp_index++;
+  }
+  return comp_index;
+}
+
+/**
+ * Run-length encodes `numPixels` RGB pixels into `out` and returns the number
+ * of words written. `out` must have room for `numPixels` words.
+ */
+vtkIdType EncodeRGB(
+  const unsigned char* in, vtkIdType numPixels, unsigned int compress_mask, unsigned int* out)
+{
+  vtkIdType index = 0;
+  vtkIdType comp_index = 0;
+  while (index < numPixels)
+  {
+    // Record color
+    const unsigned int current_color = out[comp_index] = ReadRGB(in + 3 * index);
+    index++;
+
+    // Compute Run
+    int count = 0;
+    while (index < numPixels && count < 255 &&
+      (current_color & compress_mask) == (ReadRGB(in + 3 * index) & compress_mask))
+    {
+      index++;
+      count++;
+    }
+
+    // Record Run length
+    reinterpret_cast<unsigned char*>(out)[comp_index * 4 + 3] = static_cast<unsigned char>(count);
+    comp_index++;
+  }
+  return comp_index;
+}
+
+/**
+ * Decodes `numWords` RLE words into at most `maxPixels` RGBA pixels.
+ */
+void DecodeRGBA(const unsigned int* in, vtkIdType numWords, unsigned int* out, vtkIdType maxPixels)
+{
+  vtkIdType index = 0;
+  for (vtkIdType i = 0; i < numWords && index < maxPixels; i++)
+  {
+    // Get color and count
+    unsigned int current_color = in[i];
+
+    // Get run length count;
+    int count = *(reinterpret_cast<unsigned char*>(&current_color) + 3);
+    if (count > 0x0f)
+    {
+      // we have some opacity.
+      unsigned char opacity = (count & 0xF0);
+      opacity = opacity >> 4;
+      opacity *= 16;
+      *(reinterpret_cast<unsigned char*>(&current_color) + 3) = opacity;
+    }
+    else
+    {
+      *(reinterpret_cast<unsigned char*>(&current_color) + 3) = 0;
+    }
+    count &= 0x0F;
+
+    // Blast color into color buffer
+    const vtkIdType last = std::min<vtkIdType>(index + count + 1, maxPixels);
+    std::fill(out + index, out + last, current_color);
+    index = last;
+  }
+}
+
+/**
+ * Decodes `numWords` RLE words into at most `maxPixels` RGB pixels.
+ */
+void DecodeRGB(const unsigned int* in, vtkIdType numWords, unsigned char* out, vtkIdType maxPixels)
+{
+  vtkIdType index = 0;
+  for (vtkIdType i = 0; i < numWords && index < maxPixels; i++)
+  {
+    // Get color and count
+    const unsigned int current_color = in[i];
+    const unsigned char* rgb = reinterpret_cast<const unsigned char*>(&current_color);
+
+    // Get run length count;
+    const int count = rgb[3];
+    const vtkIdType last = std::min<vtkIdType>(index + count + 1, maxPixels);
+    for (; index < last; ++index)
+    {
+      std::copy(rgb, rgb + 3, out + 3 * index);
+    }
+  }
+}
+
+inline vtkIdType StripeBegin(vtkIdType stripe, vtkIdType numStripes, vtkIdType numPixels)
+{
+  return (stripe * numPixels) / numStripes;
+}
+}
+
 //-----------------------------------------------------------------------------
 int vtkSquirtCompressor::Compress()
 {
@@ -37,16 +220,7 @@ int vtkSquirtCompressor::Compress()
     return VTK_ERROR;
   }
 
-  int count = 0;
-  int index = 0;
-  int comp_index = 0;
-  int end_index;
   int compress_level = this->LossLessMode ? 0 : this->SquirtLevel;
-  unsigned int current_color;
-  unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFE, 0xFF, 0xFE, 0xFE },
-    { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 }, { 0xF0, 0xF8, 0xF0, 0xF0 },
-    { 0xE0, 0xF0, 0xE0, 0xE0 } };
-
   if (compress_level < 0 || compress_level > 5)
   {
     vtkErrorMacro("Squirt compression level (" << compress_level << ") is out of range [0,5].");
@@ -56,107 +230,77 @@ int vtkSquirtCompressor::Compress()
   // Set bitmask based on compress_level
   unsigned int compress_mask;
   // I shifted the level by one so that 0 means no compression.
-  memcpy(&compress_mask, &compress_masks[compress_level], 4);
+  memcpy(&compress_mask, &SQUIRT_COMPRESS_MASKS[compress_level], 4);
 
-  // Access raw arrays directly
-  if (input->GetNumberOfComponents() == 4)
+  const int numComps = input->GetNumberOfComponents();
+  const vtkIdType numPixels = input->GetNumberOfTuples();
+  auto encode = [&](vtkIdType first, vtkIdType numStripePixels, unsigned int* out)
   {
-    unsigned int* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned int*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < end_index) && (comp_index < end_index))
+    if (numComps == 4)
     {
+      const unsigned int* in = reinterpret_cast<const unsigned int*>(input->GetPointer(0));
+      return EncodeRGBA(in + first, numStripePixels, compress_mask, out);
+    }
+    return EncodeRGB(input->GetPointer(0) + 3 * first, numStripePixels, compress_mask, out);
+  };
 
-      // Record color
-      current_color = _rawCompressedBuffer[comp_index] = _rawColorBuffer[index];
-      unsigned char opacity = *(((unsigned char*)&current_color) + 3);
-      index++;
+  if (this->NumberOfStripes <= 0)
+  {
+    // Legacy, single stream.
+    unsigned int* out =
+      reinterpret_cast<unsigned int*>(this->Output->WritePointer(0, numPixels * 4));
+    const vtkIdType comp_index = encode(0, numPixels, out);
+
+    // Back to vtk arrays :)
+    this->Output->SetNumberOfComponents(1);
+    this->Output->SetNumberOfTuples(4 * comp_index);
+    return VTK_OK;
+  }
 
-      // Compute Run
-      while ((index < end_index) && (count < 0x0F) &&
-        ((current_color & compress_mask) == (_rawColorBuffer[index] & compress_mask)))
-      {
-        index++;
-        count++;
-      }
-      if (opacity > 0)
+  // Tiled stream: the image is split into independent stripes of contiguous
+  // pixels that are encoded in parallel. The stream starts with a header
+  // (magic, number of stripes, number of pixels, size of each stripe in words)
+  // followed by the encoded stripes.
+  const vtkIdType numStripes =
+    std::max<vtkIdType>(1, std::min<vtkIdType>(this->NumberOfStripes, numPixels));
+  const vtkIdType headerSize = SQUIRT_TILED_HEADER_SIZE + numStripes;
+
+  // An encoded stripe never has more words than pixels, so each stripe is
+  // encoded directly into the output at the offset of its first pixel and the
+  // stripes are then packed towards the header. Packing only moves the encoded
+  // words, which is cheap compared to encoding, and no scratch frame is needed.
+  unsigned int* out =
+    reinterpret_cast<unsigned int*>(this->Output->WritePointer(0, 4 * (headerSize + numPixels)));
+  this->StripeSizes.resize(static_cast<size_t>(numStripes));
+  vtkSMPTools::For(0, numStripes,
+    [&](vtkIdType begin, vtkIdType end)
+    {
+      for (vtkIdType stripe = begin; stripe < end; ++stripe)
       {
-        opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
-        opacity = opacity << 4;
-        count |= opacity;
+        const vtkIdType first = StripeBegin(stripe, numStripes, numPixels);
+        const vtkIdType last = StripeBegin(stripe + 1, numStripes, numPixels);
+        this->StripeSizes[stripe] = encode(first, last - first, out + headerSize + first);
       }
+    });
 
-      // Record Run length
-      *((unsigned char*)_rawCompressedBuffer + comp_index * 4 + 3) = (unsigned char)count;
-      comp_index++;
-
-      count = 0;
-    }
-  }
-  else if (input->GetNumberOfComponents() == 3)
+  out[0] = SQUIRT_TILED_MAGIC;
+  out[1] = static_cast<unsigned int>(numStripes);
+  out[2] = static_cast<unsigned int>(numPixels);
+  vtkIdType numWords = headerSize;
+  for (vtkIdType stripe = 0; stripe < numStripes; ++stripe)
   {
-    unsigned char* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned char*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < 3 * numPixels) && (comp_index < end_index))
+    const vtkIdType size = this->StripeSizes[stripe];
+    const vtkIdType first = headerSize + StripeBegin(stripe, numStripes, numPixels);
+    out[SQUIRT_TILED_HEADER_SIZE + stripe] = static_cast<unsigned int>(size);
+    if (first != numWords)
     {
-
-      int next_color = 0;
-      // Record color
-      unsigned char* p = (unsigned char*)&current_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      _rawCompressedBuffer[comp_index] = current_color;
-      index += 3;
-
-      p = (unsigned char*)&next_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      // Compute Run
-      while (((current_color & compress_mask) == (next_color & compress_mask)) &&
-        (index < 3 * numPixels) && (count < 255))
-      {
-        index += 3;
-        count++;
-        if (index < 3 * numPixels)
-        {
-          p = (unsigned char*)&next_color;
-          *p++ = _rawColorBuffer[index];
-          *p++ = _rawColorBuffer[index + 1];
-          *p++ = _rawColorBuffer[index + 2];
-          *p = 0x0;
-        }
-      }
-
-      // Record Run length
-      reinterpret_cast<unsigned char*>(_rawCompressedBuffer)[comp_index * 4 + 3] =
-        static_cast<unsigned char>(count);
-      comp_index++;
-
-      count = 0;
+      std::memmove(out + numWords, out + first, sizeof(unsigned int) * size);
     }
+    numWords += size;
   }
 
-  // Back to vtk arrays :)
   this->Output->SetNumberOfComponents(1);
-  this->Output->SetNumberOfTuples(4 * comp_index);
-
+  this->Output->SetNumberOfTuples(4 * numWords);
   return VTK_OK;
 }
 
@@ -171,14 +315,18 @@ int vtkSquirtCompressor::Decompress()
 
   vtkUnsignedCharArray* out = this->GetOutput();
 
+  // The stream tells whether it is tiled, so that a receiver decodes streams
+  // from senders configured with any number of stripes.
+  const bool tiled = this->IsTiledStream();
+
   // We assume that 'out' has exactly the same number of component set as the
   // input before compression.
   switch (out->GetNumberOfComponents())
   {
     case 3:
-      return this->DecompressRGB();
+      return tiled ? this->DecompressTiled() : this->DecompressRGB();
     case 4:
-      return this->DecompressRGBA();
+      return tiled ? this->DecompressTiled() : this->DecompressRGBA();
 
     default:
       vtkErrorMacro("SQUIRT only support 3 or 4 component arrays.");
@@ -187,57 +335,45 @@ int vtkSquirtCompressor::Decompress()
 }
 
 //-----------------------------------------------------------------------------
-int vtkSquirtCompressor::DecompressRGBA()
+bool vtkSquirtCompressor::IsTiledStream()
 {
   vtkUnsignedCharArray* in = this->GetInput();
   vtkUnsignedCharArray* out = this->GetOutput();
-  assert(out->GetNumberOfComponents() == 4);
-
-  int count = 0;
-  int index = 0;
-  unsigned int current_color;
-  unsigned int* _rawColorBuffer;
-  unsigned int* _rawCompressedBuffer;
-
-  // Get compressed buffer size
-  int CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
 
-  // Access raw arrays directly
-  _rawColorBuffer = (unsigned int*)out->GetPointer(0);
-  _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
-
-  // Go through compress buffer and extract RLE format into color buffer
-  for (int i = 0; i < CompSize; i++)
+  // A legacy stream may start with a word equal to the magic word, so the
+  // header must also match the output size and the size of the stream.
+  const vtkIdType compSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
+  const unsigned int* words = reinterpret_cast<const unsigned int*>(in->GetPointer(0));
+  if (compSize < SQUIRT_TILED_HEADER_SIZE || words[0] != SQUIRT_TILED_MAGIC ||
+    static_cast<vtkIdType>(words[2]) != out->GetNumberOfTuples())
   {
-    // Get color and count
-    current_color = _rawCompressedBuffer[i];
-
-    // Get run length count;
-    count = *((unsigned char*)&current_color + 3);
-
-    if (count > 0x0f)
-    {
-      // we have some opacity.
-      unsigned char opacity = (count & 0xF0);
-      opacity = opacity >> 4;
-      opacity *= 16;
-      *((unsigned char*)&current_color + 3) = opacity;
-    }
-    else
-    {
-      *((unsigned char*)&current_color + 3) = 0;
-    }
-    count &= 0x0F;
+    return false;
+  }
+  const vtkIdType numStripes = words[1];
+  const vtkIdType headerSize = SQUIRT_TILED_HEADER_SIZE + numStripes;
+  if (numStripes <= 0 || numStripes > words[2] || compSize < headerSize)
+  {
+    return false;
+  }
+  vtkIdType numWords = headerSize;
+  for (vtkIdType stripe = 0; stripe < numStripes; ++stripe)
+  {
+    numWords += words[SQUIRT_TILED_HEADER_SIZE + stripe];
+  }
+  return numWords == compSize;
+}
 
-    // Set color
-    _rawColorBuffer[index++] = current_color;
+//-----------------------------------------------------------------------------
+int vtkSquirtCompressor::DecompressRGBA()
+{
+  vtkUnsignedCharArray* in = this->GetInput();
+  vtkUnsignedCharArray* out = this->GetOutput();
+  assert(out->GetNumberOfComponents() == 4);
 
-    // Blast color into color buffer
-    for (int j = 0; j < count; j++)
-    {
-      _rawColorBuffer[index++] = current_color;
-    }
-  }
+  // Get compressed buffer size
+  const vtkIdType compSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
+  DecodeRGBA(reinterpret_cast<const unsigned int*>(in->GetPointer(0)), compSize,
+    reinterpret_cast<unsigned int*>(out->GetPointer(0)), out->GetNumberOfTuples());
   return VTK_OK;
 }
 
@@ -248,40 +384,68 @@ int vtkSquirtCompressor::DecompressRGB()
   vtkUnsignedCharArray* out = this->GetOutput();
   assert(out->GetNumberOfComponents() == 3);
 
-  int count = 0;
-  unsigned int current_color;
-  unsigned char* _rawColorBuffer;
-  unsigned int* _rawCompressedBuffer;
-
   // Get compressed buffer size
-  int CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
+  const vtkIdType compSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
+  DecodeRGB(reinterpret_cast<const unsigned int*>(in->GetPointer(0)), compSize,
+    out->GetPointer(0), out->GetNumberOfTuples());
+  return VTK_OK;
+}
 
-  // Access raw arrays directly
-  _rawColorBuffer = (unsigned char*)out->GetPointer(0);
-  _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
+//-----------------------------------------------------------------------------
+int vtkSquirtCompressor::DecompressTiled()
+{
+  vtkUnsignedCharArray* in = this->GetInput();
+  vtkUnsignedCharArray* out = this->GetOutput();
 
-  // Go through compress buffer and extract RLE format into color buffer
-  for (int i = 0; i < CompSize; i++)
+  const vtkIdType compSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
+  const unsigned int* words = reinterpret_cast<const unsigned int*>(in->GetPointer(0));
+  if (compSize < SQUIRT_TILED_HEADER_SIZE || words[0] != SQUIRT_TILED_MAGIC)
   {
-    // Get color and count
-    current_color = _rawCompressedBuffer[i];
+    vtkErrorMacro("Not a tiled squirt stream.");
+    return VTK_ERROR;
+  }
 
-    // Get run length count;
-    count = *((unsigned char*)&current_color + 3);
+  const vtkIdType numStripes = words[1];
+  const vtkIdType numPixels = words[2];
+  const vtkIdType headerSize = SQUIRT_TILED_HEADER_SIZE + numStripes;
+  if (numStripes <= 0 || compSize < headerSize || numPixels > out->GetNumberOfTuples())
+  {
+    vtkErrorMacro("Invalid tiled squirt stream header.");
+    return VTK_ERROR;
+  }
 
-    *((unsigned char*)&current_color + 3) = 0xff;
+  std::vector<vtkIdType> offsets(static_cast<size_t>(numStripes) + 1, 0);
+  for (vtkIdType stripe = 0; stripe < numStripes; ++stripe)
+  {
+    offsets[stripe + 1] = offsets[stripe] + words[SQUIRT_TILED_HEADER_SIZE + stripe];
+  }
+  if (headerSize + offsets[numStripes] > compSize)
+  {
+    vtkErrorMacro("Truncated tiled squirt stream.");
+    return VTK_ERROR;
+  }
 
-    unsigned char current_color_rgb[3];
-    std::copy(reinterpret_cast<const unsigned char*>(&current_color),
-      reinterpret_cast<const unsigned char*>(&current_color) + 3, current_color_rgb);
-    std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer);
-    _rawColorBuffer += 3;
-    for (int j = 0; j < count; j++)
+  const int numComps = out->GetNumberOfComponents();
+  vtkSMPTools::For(0, numStripes,
+    [&](vtkIdType begin, vtkIdType end)
     {
-      std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer);
-      _rawColorBuffer += 3;
-    }
-  }
+      for (vtkIdType stripe = begin; stripe < end; ++stripe)
+      {
+        const unsigned int* src = words + headerSize + offsets[stripe];
+        const vtkIdType numWords = offsets[stripe + 1] - offsets[stripe];
+        const vtkIdType first = StripeBegin(stripe, numStripes, numPixels);
+        const vtkIdType count = StripeBegin(stripe + 1, numStripes, numPixels) - first;
+        if (numComps == 4)
+        {
+          DecodeRGBA(src, numWords,
+            reinterpret_cast<unsigned int*>(out->GetPointer(0)) + first, count);
+        }
+        else
+        {
+          DecodeRGB(src, numWords, out->GetPointer(0) + 3 * first, count);
+        }
+      }
+    });
   return VTK_OK;
 }
 
@@ -289,7 +453,7 @@ int vtkSquirtCompressor::DecompressRGB()
 void vtkSquirtCompressor::SaveConfiguration(vtkMultiProcessStream* stream)
 {
   vtkImageCompressor::SaveConfiguration(stream);
-  *stream << this->SquirtLevel;
+  *stream << this->SquirtLevel << this->NumberOfStripes;
 }
 
 //-----------------------------------------------------------------------------
@@ -297,7 +461,20 @@ bool vtkSquirtCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
 {
   if (vtkImageCompressor::RestoreConfiguration(stream))
   {
-    *stream >> this->SquirtLevel;
+    // configurations saved by older versions do not have the number of
+    // stripes; these use the legacy single stream.
+    int squirtLevel = ::DefaultSquirtLevel;
+    int numberOfStripes = ::DefaultNumberOfStripes;
+    if (!stream->Empty())
+    {
+      *stream >> squirtLevel;
+    }
+    if (!stream->Empty())
+    {
+      *stream >> numberOfStripes;
+    }
+    this->SetSquirtLevel(squirtLevel);
+    this->SetNumberOfStripes(numberOfStripes);
     return true;
   }
   return false;
@@ -307,7 +484,8 @@ bool vtkSquirtCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
 const char* vtkSquirtCompressor::SaveConfiguration()
 {
   std::ostringstream oss;
-  oss << vtkImageCompressor::SaveConfiguration() << " " << this->SquirtLevel;
+  oss << vtkImageCompressor::SaveConfiguration() << " " << this->SquirtLevel << " "
+      << this->NumberOfStripes;
 
   this->SetConfiguration(oss.str().c_str());
 
@@ -320,9 +498,33 @@ const char* vtkSquirtCompressor::RestoreConfiguration(const char* stream)
   stream = vtkImageCompressor::RestoreConfiguration(stream);
   if (stream)
   {
+    // each field is optional: configurations saved by older versions do not
+    // have the number of stripes, and these use the legacy single stream. A
+    // failed extraction leaves the field to its default and the returned
+    // position after the last field read.
     std::istringstream iss(stream);
-    iss >> this->SquirtLevel;
-    return stream + iss.tellg();
+    std::streampos pos = 0;
+    int squirtLevel = ::DefaultSquirtLevel;
+    int numberOfStripes = ::DefaultNumberOfStripes;
+    if (iss >> squirtLevel)
+    {
+      pos = iss.tellg();
+      if (iss >> numberOfStripes)
+      {
+        pos = iss.tellg();
+      }
+      else
+      {
+        numberOfStripes = ::DefaultNumberOfStripes;
+      }
+    }
+    else
+    {
+      squirtLevel = ::DefaultSquirtLevel;
+    }
+    this->SetSquirtLevel(squirtLevel);
+    this->SetNumberOfStripes(numberOfStripes);
+    return pos == std::streampos(-1) ? stream + strlen(stream) : stream + pos;
   }
   return nullptr;
 }
@@ -332,4 +534,5 @@ void vtkSquirtCompressor::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "SquirtLevel: " << this->SquirtLevel << endl;
+  os << indent << "NumberOfStripes: " << this->NumberOfStripes << endl;
 }
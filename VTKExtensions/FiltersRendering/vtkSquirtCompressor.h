@@ -29,6 +29,13 @@
  * The compressor uses a modified SQUIRT implementation where encode 4-bit
  * opacity information as well. This is needed to improve background color
  * blending for translucent renderings in ParaView.
+ *
+ * When NumberOfStripes is greater than 0, the image is split into that many
+ * stripes of contiguous pixels which are encoded and decoded independently
+ * using vtkSMPTools. The resulting tiled stream starts with a small header that
+ * Decompress() recognizes, so the receiver decodes both tiled and legacy
+ * streams whatever its own NumberOfStripes. Older versions only decode the
+ * legacy stream.
  * @par Thanks:
  * Thanks to Sandia National Laboratories for this compression technique
  */
@@ -39,6 +46,8 @@
 #include "vtkImageCompressor.h"
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
 
+#include <vector> // for std::vector
+
 class vtkMultiProcessStream;
 
 class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkSquirtCompressor : public vtkImageCompressor
@@ -58,6 +67,16 @@ public:
   vtkGetMacro(SquirtLevel, int);
   ///@}
 
+  ///@{
+  /**
+   * Set the number of stripes used to encode the image in parallel.
+   * 0 (default) produces the legacy single stream understood by older
+   * versions.
+   */
+  vtkSetClampMacro(NumberOfStripes, int, 0, 1024);
+  vtkGetMacro(NumberOfStripes, int);
+  ///@}
+
   ///@{
   /**
    * Compress/Decompress data array on the objects input with results
@@ -83,8 +102,20 @@ protected:
   ~vtkSquirtCompressor() override;
   int DecompressRGB();
   int DecompressRGBA();
+  int DecompressTiled();
+
+  /**
+   * Returns true if the input is a tiled stream whose header is consistent
+   * with the input and output sizes.
+   */
+  bool IsTiledStream();
 
   int SquirtLevel;
+  int NumberOfStripes;
+
+  // Number of words of each encoded stripe, kept to avoid reallocating it
+  // for every frame.
+  std::vector<vtkIdType> StripeSizes;
 
 private:
   vtkSquirtCompressor(const vtkSquirtCompressor&) = delete;
@@ -9,11 +9,14 @@
 #include <vtkLogger.h>
 #include <vtkMPIController.h>
 #include <vtkNew.h>
+#include <vtkSignedCharArray.h>
 #include <vtkStringFormatter.h>
 #include <vtkTable.h>
 #include <vtkTesting.h>
 
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <string>
 
 namespace
@@ -21,7 +24,7 @@ namespace
 
 // ensure that the writer works when the columns are not in the same order on all ranks.
 // also ensures partial arrays don't mess things up.
-bool WriteCSV(const std::string& fname, int rank)
+bool WriteCSV(const std::string& fname, int rank, bool streaming)
 {
   vtkNew<vtkTable> table;
   vtkNew<vtkDoubleArray> col1;
@@ -42,12 +45,17 @@ bool WriteCSV(const std::string& fname, int rank)
   col4->SetNumberOfComponents(1);
   col4->SetBackend(std::make_shared<vtkConstantImplicitBackend<int>>(42));
 
+  vtkNew<vtkSignedCharArray> col5;
+  col5->SetName("Column5-signed-char");
+  col5->SetNumberOfTuples(10);
+
   for (int cc = 0; cc < 10; ++cc)
   {
     const auto row = cc + rank * 10;
     col1->SetValue(cc, row + 1.5);
     col2->SetValue(cc, row * 100);
     col3->SetValue(cc, 20);
+    col5->SetValue(cc, static_cast<signed char>('a' + cc));
   }
 
   if (rank == 0)
@@ -56,9 +64,11 @@ bool WriteCSV(const std::string& fname, int rank)
     table->AddColumn(col3);
     table->AddColumn(col2);
     table->AddColumn(col4);
+    table->AddColumn(col5);
   }
   else
   {
+    table->AddColumn(col5);
     table->AddColumn(col4);
     table->AddColumn(col2);
     table->AddColumn(col1);
@@ -66,6 +76,7 @@ bool WriteCSV(const std::string& fname, int rank)
 
   vtkNew<vtkCSVWriter> writer;
   writer->SetFileName(fname.c_str());
+  writer->SetStreamingMode(streaming);
   writer->SetInputDataObject(table);
   writer->Update();
   return true;
@@ -94,7 +105,7 @@ bool ReadAndVerifyCSV(const std::string& fname, int rank, int numRanks)
 
   auto table = reader->GetOutput();
   VERITFY_EQ(table->GetNumberOfRows(), 10 * numRanks, "incorrect row count");
-  VERITFY_EQ(table->GetNumberOfColumns(), 3, "incorrect column count");
+  VERITFY_EQ(table->GetNumberOfColumns(), 4, "incorrect column count");
 
   for (int irank = 0; irank < numRanks; ++irank)
   {
@@ -104,17 +115,38 @@ bool ReadAndVerifyCSV(const std::string& fname, int rank, int numRanks)
       auto value1 = table->GetValueByName(row, "Column1");
       auto value2 = table->GetValueByName(row, "Column2");
       auto value3 = table->GetValueByName(row, "Column4-implicit");
+      auto value5 = table->GetValueByName(row, "Column5-signed-char");
       VERITFY_EQ(value1.ToDouble(), row + 1.5,
         std::string("incorrect column1  values at row ") + vtk::to_string(row));
       VERITFY_EQ(value2.ToInt(), row * 100,
         std::string("incorrect column2  values at row ") + vtk::to_string(row));
       VERITFY_EQ(
         value3.ToInt(), 42, std::string("incorrect column4  values at row ") + vtk::to_string(row));
+      VERITFY_EQ(value5.ToString(), std::string(1, static_cast<char>('a' + cc)),
+        std::string("incorrect column5  values at row ") + vtk::to_string(row));
     }
   }
   return true;
 }
 
+// the streaming mode must write exactly the same text as the default mode.
+bool CompareCSV(const std::string& fname, const std::string& otherFname, int rank)
+{
+  if (rank != 0)
+  {
+    return true;
+  }
+
+  std::ifstream file(fname.c_str(), std::ios::binary);
+  std::ifstream otherFile(otherFname.c_str(), std::ios::binary);
+  std::string contents, otherContents;
+  contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  otherContents.assign(
+    std::istreambuf_iterator<char>(otherFile), std::istreambuf_iterator<char>());
+  VERITFY_EQ(contents == otherContents, true, "streaming output differs from " + fname);
+  return true;
+}
+
 } // end of namespace
 
 extern int TestCSVWriter(int argc, char* argv[])
@@ -137,8 +169,11 @@ extern int TestCSVWriter(int argc, char* argv[])
   }
 
   std::string tname{ testing->GetTempDirectory() };
-  int success = WriteCSV(tname + "/TestCSVWriter.csv", myRank) &&
-      ReadAndVerifyCSV(tname + "/TestCSVWriter.csv", myRank, numRanks)
+  int success = WriteCSV(tname + "/TestCSVWriter.csv", myRank, false) &&
+      ReadAndVerifyCSV(tname + "/TestCSVWriter.csv", myRank, numRanks) &&
+      WriteCSV(tname + "/TestCSVWriterStreaming.csv", myRank, true) &&
+      ReadAndVerifyCSV(tname + "/TestCSVWriterStreaming.csv", myRank, numRanks) &&
+      CompareCSV(tname + "/TestCSVWriter.csv", tname + "/TestCSVWriterStreaming.csv", myRank)
     ? 1
     : 0;
 
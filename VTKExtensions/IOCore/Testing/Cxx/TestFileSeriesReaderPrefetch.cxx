@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkFileSeriesReader.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+#include "vtkPolyDataWriter.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLMultiBlockDataReader.h"
+#include "vtkXMLMultiBlockDataWriter.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    std::cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                   \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> MakePoint(double x)
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(x, 0, 0);
+  auto pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->SetPoints(points);
+  return pd;
+}
+
+bool WriteLegacy(const std::string& fname, double x)
+{
+  vtkNew<vtkPolyDataWriter> writer;
+  writer->SetInputData(MakePoint(x));
+  writer->SetFileName(fname.c_str());
+  return writer->Write() == 1;
+}
+
+// Returns the x coordinate of the single point read for the given time step.
+double ReadTimeStep(vtkFileSeriesReader* reader, int step)
+{
+  reader->UpdateTimeStep(step);
+  vtkDataObject* output = reader->GetOutputDataObject(0);
+  if (auto mb = vtkMultiBlockDataSet::SafeDownCast(output))
+  {
+    output = mb->GetNumberOfBlocks() == 1 ? mb->GetBlock(0) : nullptr;
+  }
+  auto pd = vtkPolyData::SafeDownCast(output);
+  return (pd && pd->GetNumberOfPoints() == 1) ? pd->GetPoint(0)[0] : -1.0;
+}
+}
+
+extern int TestFileSeriesReaderPrefetch(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string prefix = std::string(tempDir) + "/TestFileSeriesReaderPrefetch_";
+  delete[] tempDir;
+
+  const int numFiles = 6;
+  std::vector<std::string> fnames;
+  for (int cc = 0; cc < numFiles; ++cc)
+  {
+    fnames.push_back(prefix + std::to_string(cc) + ".vtk");
+    TASSERT(WriteLegacy(fnames.back(), cc));
+  }
+
+  vtkNew<vtkPolyDataReader> legacyReader;
+  vtkNew<vtkFileSeriesReader> reader;
+  reader->SetReader(legacyReader);
+  reader->SetFileNameMethod("SetFileName");
+  for (const auto& fname : fnames)
+  {
+    reader->AddFileName(fname.c_str());
+  }
+  reader->SetPrefetchDepth(2);
+  reader->SetPrefetchMemoryLimit(16);
+
+  // Reading step 0 prefetches steps 1 and 2. Once they have been read,
+  // overwrite the files: the reader must use the prefetched bytes.
+  TASSERT(ReadTimeStep(reader, 0) == 0);
+  reader->WaitForPrefetching();
+  TASSERT(WriteLegacy(fnames[1], 101));
+  TASSERT(WriteLegacy(fnames[2], 102));
+  TASSERT(WriteLegacy(fnames[4], 104));
+  TASSERT(ReadTimeStep(reader, 1) == 1);
+  reader->WaitForPrefetching();
+  TASSERT(ReadTimeStep(reader, 2) == 2);
+
+  // Step 4 was overwritten before it was prefetched.
+  reader->WaitForPrefetching();
+  TASSERT(ReadTimeStep(reader, 4) == 104);
+
+  // Playing backward: 3 was released when moving to 4, then 2 and 1 are
+  // prefetched again from the overwritten files.
+  reader->WaitForPrefetching();
+  TASSERT(WriteLegacy(fnames[3], 103));
+  TASSERT(ReadTimeStep(reader, 3) == 103);
+  reader->WaitForPrefetching();
+  TASSERT(ReadTimeStep(reader, 2) == 102);
+
+  // Disabling prefetching must go back to reading from the files.
+  reader->SetPrefetchDepth(0);
+  TASSERT(WriteLegacy(fnames[5], 105));
+  TASSERT(ReadTimeStep(reader, 5) == 105);
+  TASSERT(ReadTimeStep(reader, 1) == 101);
+
+  // Meta files refer to other files relative to their own location, so XML
+  // readers always read the files themselves.
+  std::vector<std::string> vtmNames;
+  for (int cc = 0; cc < numFiles; ++cc)
+  {
+    vtkNew<vtkMultiBlockDataSet> mb;
+    mb->SetBlock(0, MakePoint(cc));
+    vtmNames.push_back(prefix + std::to_string(cc) + ".vtm");
+    vtkNew<vtkXMLMultiBlockDataWriter> writer;
+    writer->SetInputData(mb);
+    writer->SetFileName(vtmNames.back().c_str());
+    TASSERT(writer->Write() == 1);
+  }
+
+  vtkNew<vtkXMLMultiBlockDataReader> vtmReader;
+  vtkNew<vtkFileSeriesReader> metaReader;
+  metaReader->SetReader(vtmReader);
+  metaReader->SetFileNameMethod("SetFileName");
+  for (const auto& fname : vtmNames)
+  {
+    metaReader->AddFileName(fname.c_str());
+  }
+  metaReader->SetPrefetchDepth(2);
+  for (int step = 0; step < numFiles; ++step)
+  {
+    TASSERT(ReadTimeStep(metaReader, step) == step);
+    metaReader->WaitForPrefetching();
+  }
+  for (int step : { 3, 1, 4, 0, 5, 2 })
+  {
+    TASSERT(ReadTimeStep(metaReader, step) == step);
+  }
+  return EXIT_SUCCESS;
+}
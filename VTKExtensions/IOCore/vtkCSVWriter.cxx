@@ -15,11 +15,13 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVMergeTables.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -29,9 +31,13 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <numeric>
 #include <regex>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 //-----------------------------------------------------------------------------
@@ -58,6 +64,7 @@ vtkCSVWriter::vtkCSVWriter()
   this->AddMetaData = false;
   this->AddTimeStep = false;
   this->AddTime = false;
+  this->StreamingMode = false;
   this->CurrentTimeIndex = 0;
   this->NumberOfTimeSteps = 0;
   this->TimeValues = nullptr;
@@ -208,21 +215,61 @@ int vtkCSVWriter::ProcessRequest(
 
 namespace
 {
+/**
+ * Formats a value to text the same way the stream does, with the precision
+ * and notation of the writer, using vtk::format_to.
+ */
+struct ValueFormatter
+{
+  bool Scientific;
+  int Precision;
+
+  template <typename ValueT>
+  void operator()(std::string& text, ValueT value) const
+  {
+    if constexpr (std::is_floating_point<ValueT>::value)
+    {
+      if (this->Scientific)
+      {
+        vtk::format_to(std::back_inserter(text), "{:.{}e}", value, this->Precision);
+      }
+      else
+      {
+        vtk::format_to(std::back_inserter(text), "{:.{}g}", value, this->Precision);
+      }
+    }
+    else if constexpr (std::is_same<ValueT, signed char>::value)
+    {
+      // vtkSignedCharArray has no worker specialization, so the stream
+      // writes its values as characters.
+      text += static_cast<char>(value);
+    }
+    else
+    {
+      vtk::format_to(std::back_inserter(text), "{}", value);
+    }
+  }
+};
+
 /**
  * Worker interface, so we can store pointers of concrete subclasses in a generic container.
- * The operator() should write the array value at given index into the stream.
+ * The operator() should write the array value at given index into the stream, or append it
+ * to the text. The latter is used concurrently from multiple threads in StreamingMode.
  */
 struct AbstractStreamWorker
 {
-  AbstractStreamWorker(vtkAbstractArray* arr)
+  AbstractStreamWorker(vtkAbstractArray* arr, const ValueFormatter& formatter)
     : NumberOfComponents(arr->GetNumberOfComponents())
+    , Formatter(formatter)
   {
   }
 
   virtual ~AbstractStreamWorker() = default;
 
   virtual void operator()(ostream& stream, vtkCSVWriter* writer, vtkIdType index) = 0;
+  virtual void operator()(std::string& text, vtkCSVWriter* writer, vtkIdType index) const = 0;
   vtkIdType NumberOfComponents;
+  ValueFormatter Formatter;
 };
 
 /**
@@ -231,8 +278,8 @@ struct AbstractStreamWorker
 template <typename ArrayT>
 struct DataToStreamWorker : public AbstractStreamWorker
 {
-  DataToStreamWorker(ArrayT* array)
-    : AbstractStreamWorker(array)
+  DataToStreamWorker(ArrayT* array, const ValueFormatter& formatter)
+    : AbstractStreamWorker(array, formatter)
   {
     this->Range = vtk::DataArrayValueRange(array);
   }
@@ -242,6 +289,13 @@ struct DataToStreamWorker : public AbstractStreamWorker
     stream << this->Range[index];
   }
 
+  void operator()(
+    std::string& text, vtkCSVWriter* vtkNotUsed(writer), vtkIdType index) const override
+  {
+    const vtk::GetAPIType<ArrayT> value = this->Range[index];
+    this->Formatter(text, value);
+  }
+
 private:
   using RangeType =
     typename vtk::detail::SelectValueRange<ArrayT, vtk::detail::DynamicTupleSize>::type;
@@ -254,8 +308,8 @@ private:
 template <>
 struct DataToStreamWorker<vtkStringArray> : public AbstractStreamWorker
 {
-  DataToStreamWorker(vtkStringArray* array)
-    : AbstractStreamWorker(array)
+  DataToStreamWorker(vtkStringArray* array, const ValueFormatter& formatter)
+    : AbstractStreamWorker(array, formatter)
     , Array(array)
   {
   }
@@ -265,6 +319,11 @@ struct DataToStreamWorker<vtkStringArray> : public AbstractStreamWorker
     stream << writer->GetString(this->Array->GetValue(index));
   }
 
+  void operator()(std::string& text, vtkCSVWriter* writer, vtkIdType index) const override
+  {
+    text += writer->GetString(this->Array->GetValue(index));
+  }
+
   vtkStringArray* Array;
 };
 
@@ -274,8 +333,8 @@ struct DataToStreamWorker<vtkStringArray> : public AbstractStreamWorker
 template <>
 struct DataToStreamWorker<vtkAOSDataArrayTemplate<char>> : public AbstractStreamWorker
 {
-  DataToStreamWorker(vtkAOSDataArrayTemplate<char>* array)
-    : AbstractStreamWorker(array)
+  DataToStreamWorker(vtkAOSDataArrayTemplate<char>* array, const ValueFormatter& formatter)
+    : AbstractStreamWorker(array, formatter)
   {
     this->Range = vtk::DataArrayValueRange(array);
   }
@@ -285,6 +344,12 @@ struct DataToStreamWorker<vtkAOSDataArrayTemplate<char>> : public AbstractStream
     stream << static_cast<int>(this->Range[index]);
   }
 
+  void operator()(
+    std::string& text, vtkCSVWriter* vtkNotUsed(writer), vtkIdType index) const override
+  {
+    this->Formatter(text, static_cast<int>(this->Range[index]));
+  }
+
 private:
   using RangeType = typename vtk::detail::SelectValueRange<vtkAOSDataArrayTemplate<char>,
     vtk::detail::DynamicTupleSize>::type;
@@ -297,8 +362,9 @@ private:
 template <>
 struct DataToStreamWorker<vtkAOSDataArrayTemplate<unsigned char>> : public AbstractStreamWorker
 {
-  DataToStreamWorker(vtkAOSDataArrayTemplate<unsigned char>* array)
-    : AbstractStreamWorker(array)
+  DataToStreamWorker(
+    vtkAOSDataArrayTemplate<unsigned char>* array, const ValueFormatter& formatter)
+    : AbstractStreamWorker(array, formatter)
   {
     this->Range = vtk::DataArrayValueRange(array);
   }
@@ -308,6 +374,12 @@ struct DataToStreamWorker<vtkAOSDataArrayTemplate<unsigned char>> : public Abstr
     stream << static_cast<int>(this->Range[index]);
   }
 
+  void operator()(
+    std::string& text, vtkCSVWriter* vtkNotUsed(writer), vtkIdType index) const override
+  {
+    this->Formatter(text, static_cast<int>(this->Range[index]));
+  }
+
 private:
   using RangeType = typename vtk::detail::SelectValueRange<vtkAOSDataArrayTemplate<unsigned char>,
     vtk::detail::DynamicTupleSize>::type;
@@ -323,9 +395,10 @@ private:
 struct WorkerCreator
 {
   template <typename ArrayT>
-  void operator()(ArrayT* array, std::shared_ptr<AbstractStreamWorker>& worker)
+  void operator()(ArrayT* array, const ValueFormatter& formatter,
+    std::shared_ptr<AbstractStreamWorker>& worker)
   {
-    auto typed_worker = std::make_shared<DataToStreamWorker<ArrayT>>(array);
+    auto typed_worker = std::make_shared<DataToStreamWorker<ArrayT>>(array, formatter);
     worker = typed_worker;
   }
 };
@@ -340,6 +413,12 @@ class vtkCSVWriter::CSVFile
   double Time = vtkMath::Nan();
   std::vector<std::shared_ptr<::AbstractStreamWorker>> ColumnsWorkers;
 
+  // Number of rows formatted by a single task in StreamingMode.
+  static constexpr vtkIdType RowsPerChunk = 4096;
+  // Number of rows formatted before being written to the stream in StreamingMode,
+  // which bounds the memory used for the text.
+  static constexpr vtkIdType RowsPerBatch = 64 * RowsPerChunk;
+
 public:
   CSVFile(int timeStep, double time)
     : TimeStep(timeStep)
@@ -350,7 +429,8 @@ public:
   enum class OpenMode
   {
     Write,
-    Append
+    Append,
+    Update
   };
 
   int Open(const char* filename, OpenMode mode)
@@ -363,10 +443,14 @@ public:
     {
       this->Stream.open(filename, ios::out);
     }
-    else // (OpenMode::Append == mode)
+    else if (OpenMode::Append == mode)
     {
       this->Stream.open(filename, ios::app);
     }
+    else // (OpenMode::Update == mode)
+    {
+      this->Stream.open(filename, ios::in | ios::out);
+    }
     if (this->Stream.fail())
     {
       return vtkErrorCode::CannotOpenFileError;
@@ -454,10 +538,16 @@ public:
     using SupportedArrays = vtkArrayDispatch::AllArrays;
     using Dispatcher = vtkArrayDispatch::DispatchByArray<SupportedArrays>;
     ::WorkerCreator creator;
+    const ::ValueFormatter formatter{ self->GetUseScientificNotation(), self->GetPrecision() };
 
     for (const auto& cinfo : this->ColumnInfo)
     {
       auto array = dsa->GetAbstractArray(cinfo.first.c_str());
+      if (!array)
+      {
+        vtkErrorWithObjectMacro(self, "Missing column '" << cinfo.first << "'!");
+        continue;
+      }
       if (array->GetNumberOfComponents() != cinfo.second)
       {
         vtkErrorWithObjectMacro(self, "Mismatched components for '" << array->GetName() << "'!");
@@ -465,7 +555,8 @@ public:
 
       if (auto stringArray = vtkStringArray::SafeDownCast(array))
       {
-        auto stringWorker = std::make_shared<DataToStreamWorker<vtkStringArray>>(stringArray);
+        auto stringWorker =
+          std::make_shared<DataToStreamWorker<vtkStringArray>>(stringArray, formatter);
         this->ColumnsWorkers.push_back(stringWorker);
         continue;
       }
@@ -474,9 +565,9 @@ public:
       if (dataArray)
       {
         std::shared_ptr<::AbstractStreamWorker> streamWorker;
-        if (!Dispatcher::Execute(dataArray, creator, streamWorker))
+        if (!Dispatcher::Execute(dataArray, creator, formatter, streamWorker))
         {
-          creator(dataArray, streamWorker);
+          creator(dataArray, formatter, streamWorker);
         }
         this->ColumnsWorkers.push_back(streamWorker);
         continue;
@@ -535,6 +626,172 @@ public:
     }
   }
 
+  void Close() { this->Stream.close(); }
+
+  ///@{
+  /**
+   * Serialize/deserialize the columns to write, so that all ranks agree on
+   * them in StreamingMode.
+   */
+  void SaveColumnInfo(vtkMultiProcessStream& stream) const
+  {
+    stream << static_cast<unsigned int>(this->ColumnInfo.size());
+    for (const auto& cinfo : this->ColumnInfo)
+    {
+      stream << cinfo.first << cinfo.second;
+    }
+  }
+
+  void RestoreColumnInfo(vtkMultiProcessStream& stream)
+  {
+    unsigned int count = 0;
+    stream >> count;
+    this->ColumnInfo.resize(count);
+    for (auto& cinfo : this->ColumnInfo)
+    {
+      stream >> cinfo.first >> cinfo.second;
+    }
+  }
+  ///@}
+
+  /**
+   * Format the rows in [begin, end) to text, in parallel chunks of rows.
+   * InitializeStreamWorkers must have been called first.
+   */
+  std::string FormatData(
+    vtkIdType begin, vtkIdType end, vtkIdType numTuples, vtkCSVWriter* self) const
+  {
+    const std::string delimiter = self->GetFieldDelimiter() ? self->GetFieldDelimiter() : "";
+    const ::ValueFormatter formatter{ self->GetUseScientificNotation(), self->GetPrecision() };
+    const vtkIdType numChunks = (end - begin + RowsPerChunk - 1) / RowsPerChunk;
+    std::vector<std::string> chunks(numChunks);
+
+    vtkSMPTools::For(0, numChunks, [&](vtkIdType firstChunk, vtkIdType lastChunk) {
+      for (vtkIdType chunk = firstChunk; chunk < lastChunk; ++chunk)
+      {
+        std::string& text = chunks[chunk];
+        const vtkIdType firstRow = begin + chunk * RowsPerChunk;
+        const vtkIdType lastRow = std::min(firstRow + RowsPerChunk, end);
+        for (vtkIdType tupleIndex = firstRow; tupleIndex < lastRow; ++tupleIndex)
+        {
+          bool firstColumn = true;
+          if (this->TimeStep >= 0)
+          {
+            formatter(text, this->TimeStep);
+            firstColumn = false;
+          }
+          if (!vtkMath::IsNan(this->Time))
+          {
+            if (!firstColumn)
+            {
+              text += delimiter;
+            }
+            // add a time column.
+            formatter(text, this->Time);
+            firstColumn = false;
+          }
+
+          for (const auto& columnWorker : this->ColumnsWorkers)
+          {
+            const vtkIdType numComps = columnWorker->NumberOfComponents;
+            const vtkIdType index = tupleIndex * numComps;
+            for (vtkIdType component = 0; component < numComps; component++)
+            {
+              if (!firstColumn)
+              {
+                text += delimiter;
+              }
+              firstColumn = false;
+              if ((index + component) < numComps * numTuples)
+              {
+                (*columnWorker)(text, self, index + component);
+              }
+            }
+          }
+          text += '\n';
+        }
+      }
+    });
+
+    std::string result;
+    result.reserve(std::accumulate(chunks.begin(), chunks.end(), std::size_t(0),
+      [](std::size_t size, const std::string& chunk) { return size + chunk.size(); }));
+    for (const auto& chunk : chunks)
+    {
+      result += chunk;
+    }
+    return result;
+  }
+
+  /**
+   * Same as WriteData, but formats batches of rows in parallel before writing
+   * them to the stream.
+   */
+  void StreamData(vtkTable* table, vtkCSVWriter* self)
+  {
+    this->InitializeStreamWorkers(table->GetRowData(), self);
+    const vtkIdType numTuples = table->GetNumberOfRows();
+    for (vtkIdType begin = 0; begin < numTuples; begin += RowsPerBatch)
+    {
+      const std::string text =
+        this->FormatData(begin, std::min(begin + RowsPerBatch, numTuples), numTuples, self);
+      this->Stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+  }
+
+  /**
+   * Formats the rows in batches of RowsPerBatch rows.
+   * InitializeStreamWorkers must have been called first.
+   */
+  std::vector<std::string> FormatBatches(vtkIdType numTuples, vtkCSVWriter* self) const
+  {
+    std::vector<std::string> batches;
+    batches.reserve((numTuples + RowsPerBatch - 1) / RowsPerBatch);
+    for (vtkIdType begin = 0; begin < numTuples; begin += RowsPerBatch)
+    {
+      batches.push_back(
+        this->FormatData(begin, std::min(begin + RowsPerBatch, numTuples), numTuples, self));
+    }
+    return batches;
+  }
+
+  /**
+   * Returns the number of bytes the batches take in the file. The file is
+   * opened in text mode, where each line ending takes two bytes on Windows.
+   */
+  static vtkTypeUInt64 GetFileSize(const std::vector<std::string>& batches)
+  {
+    vtkTypeUInt64 size = 0;
+    for (const auto& text : batches)
+    {
+      size += text.size();
+#ifdef _WIN32
+      size += std::count(text.begin(), text.end(), '\n');
+#endif
+    }
+    return size;
+  }
+
+  /**
+   * Writes the batches at the current position of the stream, releasing
+   * each one once written.
+   */
+  void StreamData(std::vector<std::string>& batches)
+  {
+    for (auto& text : batches)
+    {
+      this->Stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+      std::string().swap(text);
+    }
+  }
+
+  /**
+   * Moves the position of the stream, for files opened with OpenMode::Update.
+   */
+  void Seek(vtkTypeUInt64 offset) { this->Stream.seekp(static_cast<std::streamoff>(offset)); }
+
+  bool Fail() const { return this->Stream.fail(); }
+
 private:
   CSVFile(const CSVFile&) = delete;
   void operator=(const CSVFile&) = delete;
@@ -664,13 +921,25 @@ bool vtkCSVWriter::WriteDataAndReturn()
     if (error_code == vtkErrorCode::NoError)
     {
       file.WriteHeader(table, this, openMode);
-      file.WriteData(table, this);
+      if (this->StreamingMode)
+      {
+        file.StreamData(table, this);
+      }
+      else
+      {
+        file.WriteData(table, this);
+      }
       ret = true;
     }
     this->SetErrorCode(error_code);
     return ret;
   }
 
+  if (this->StreamingMode)
+  {
+    return this->WriteStreamedData(table, filename.str(), timeStep, time);
+  }
+
   const int myRank = controller->GetLocalProcessId();
   const int numRanks = controller->GetNumberOfProcesses();
   if (myRank > 0)
@@ -793,6 +1062,119 @@ bool vtkCSVWriter::WriteDataAndReturn()
   return true;
 }
 
+//-----------------------------------------------------------------------------
+bool vtkCSVWriter::WriteStreamedData(
+  vtkTable* table, const std::string& filename, int timeStep, double time)
+{
+  auto controller = this->Controller;
+  const int myRank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+
+  vtkCSVWriter::CSVFile file(timeStep, time);
+  CSVFile::OpenMode openMode =
+    this->WriteAllTimeSteps && !this->WriteAllTimeStepsSeparately && this->CurrentTimeIndex > 0
+    ? CSVFile::OpenMode::Append
+    : CSVFile::OpenMode::Write;
+
+  const vtkIdType row_count = table->GetNumberOfRows();
+  std::vector<vtkIdType> global_row_counts(numRanks, 0);
+  controller->AllGather(&row_count, global_row_counts.data(), 1);
+
+  // The root determines the columns to write, writes the header and shares
+  // the columns and the offset at which the rows start with the other ranks.
+  vtkMultiProcessStream header;
+  if (myRank == 0)
+  {
+    vtkDataSetAttributes::FieldList columns;
+    for (int rank = 0; rank < numRanks; ++rank)
+    {
+      if (global_row_counts[rank] > 0)
+      {
+        if (rank == 0)
+        {
+          columns.IntersectFieldList(table->GetRowData());
+        }
+        else
+        {
+          vtkNew<vtkTable> emptytable;
+          controller->Receive(emptytable, rank, 88020);
+          columns.IntersectFieldList(emptytable->GetRowData());
+        }
+      }
+    }
+
+    vtkTypeUInt64 dataOffset = 0;
+    int error_code = file.Open(filename.c_str(), openMode);
+    if (error_code == vtkErrorCode::NoError)
+    {
+      vtkNew<vtkDataSetAttributes> tmp;
+      tmp->CopyAllOn();
+      columns.CopyAllocate(tmp, vtkDataSetAttributes::PASSDATA, /*sz=*/1, 0);
+      file.WriteHeader(tmp, this, openMode);
+      file.Close();
+      dataOffset = static_cast<vtkTypeUInt64>(vtksys::SystemTools::FileLength(filename));
+    }
+    header << error_code << dataOffset;
+    file.SaveColumnInfo(header);
+  }
+  else if (row_count > 0)
+  {
+    vtkNew<vtkTable> clone;
+    auto cloneRD = clone->GetRowData();
+    cloneRD->CopyAllOn();
+    cloneRD->CopyAllocate(table->GetRowData(), /*sze=*/1);
+    cloneRD->CopyData(table->GetRowData(), 0, 1, 0);
+    controller->Send(clone, 0, 88020);
+  }
+
+  controller->Broadcast(header, 0);
+  int error_code = vtkErrorCode::NoError;
+  vtkTypeUInt64 dataOffset = 0;
+  header >> error_code >> dataOffset;
+  if (error_code != vtkErrorCode::NoError)
+  {
+    this->SetErrorCode(error_code);
+    return false;
+  }
+  file.RestoreColumnInfo(header);
+
+  // Format the local rows to compute where each rank writes, then write them
+  // at that offset.
+  std::vector<std::string> batches;
+  vtkTypeUInt64 text_size = 0;
+  if (row_count > 0)
+  {
+    file.InitializeStreamWorkers(table->GetRowData(), this);
+    batches = file.FormatBatches(row_count, this);
+    text_size = CSVFile::GetFileSize(batches);
+  }
+
+  std::vector<vtkTypeUInt64> global_text_sizes(numRanks, 0);
+  controller->AllGather(&text_size, global_text_sizes.data(), 1);
+  const vtkTypeUInt64 offset = std::accumulate(
+    global_text_sizes.begin(), global_text_sizes.begin() + myRank, dataOffset);
+
+  if (text_size > 0)
+  {
+    error_code = file.Open(filename.c_str(), CSVFile::OpenMode::Update);
+    if (error_code == vtkErrorCode::NoError)
+    {
+      file.Seek(offset);
+      file.StreamData(batches);
+      file.Close();
+      if (file.Fail())
+      {
+        error_code = vtkErrorCode::OutOfDiskSpaceError;
+      }
+    }
+  }
+
+  int global_error_code = vtkErrorCode::NoError;
+  controller->AllReduce(&error_code, &global_error_code, 1, vtkCommunicator::MAX_OP);
+  this->SetErrorCode(global_error_code);
+  return global_error_code == vtkErrorCode::NoError;
+}
+
 //-----------------------------------------------------------------------------
 void vtkCSVWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -814,6 +1196,7 @@ void vtkCSVWriter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "AddMetaData: " << (this->AddMetaData ? "Yes" : "No") << endl;
   os << indent << "AddTimeStep: " << (this->AddTimeStep ? "Yes" : "No") << endl;
   os << indent << "AddTime: " << (this->AddTime ? "Yes" : "No") << endl;
+  os << indent << "StreamingMode: " << (this->StreamingMode ? "Yes" : "No") << endl;
   os << indent << "NumberOfTimeSteps: " << this->NumberOfTimeSteps << endl;
   os << indent << "CurrentTimeIndex: " << this->CurrentTimeIndex << endl;
   os << indent << "TimeValues " << (this->TimeValues ? this->TimeValues->GetName() : "(none)")
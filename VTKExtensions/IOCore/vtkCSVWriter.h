@@ -169,6 +169,22 @@ public:
   vtkBooleanMacro(AddTimeStep, bool);
   ///@}
 
+  ///@{
+  /**
+   * When set to true (default is false), values are formatted to text using
+   * multiple threads, in chunks of rows, without going through an ostream,
+   * and written in batches of a fixed number of rows.
+   * In parallel, each rank then writes its own rows directly at their offset
+   * in the file instead of sending them to the root rank, so the data is never
+   * gathered on a single rank. This requires the file to be accessible from all
+   * ranks at the same path. Rows are written in rank order and the text is the
+   * same as in the default mode.
+   */
+  vtkSetMacro(StreamingMode, bool);
+  vtkGetMacro(StreamingMode, bool);
+  vtkBooleanMacro(StreamingMode, bool);
+  ///@}
+
   ///@{
   /**
    * Internal method: decorates the "string" with the "StringDelimiter" if
@@ -211,6 +227,7 @@ protected:
   bool AddMetaData;
   bool AddTimeStep;
   bool AddTime;
+  bool StreamingMode;
 
   vtkMultiProcessController* Controller;
 
@@ -223,6 +240,11 @@ private:
   void operator=(const vtkCSVWriter&) = delete;
 
   class CSVFile;
+
+  /**
+   * Writes the table in StreamingMode when running with more than one rank.
+   */
+  bool WriteStreamedData(vtkTable* table, const std::string& filename, int timeStep, double time);
 };
 
 #endif
@@ -6,7 +6,9 @@
 
 #include "vtkClientServerInterpreter.h"
 #include "vtkClientServerInterpreterInitializer.h"
+#include "vtkCharArray.h"
 #include "vtkClientServerStream.h"
+#include "vtkDataReader.h"
 #include "vtkFileSeriesUtilities.h"
 #include "vtkGenericDataObjectReader.h"
 #include "vtkInformation.h"
@@ -27,10 +29,16 @@
 
 #include <algorithm>
 #include <cctype> // for isprint().
+#include <condition_variable>
+#include <cstring>
+#include <deque>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "vtk_jsoncpp.h"
@@ -359,6 +367,187 @@ public:
 private:
   void operator=(const vtkRecordMTime&);
 };
+
+// Reads the contents of files in a background thread. Schedule() sets the
+// list of files that should be prefetched, in order; contents of files no
+// longer in that list are released. Take() hands over the contents of a
+// prefetched file. When contents are not kept, files are only read to bring
+// them in the file system cache.
+class vtkFileSeriesPrefetcher
+{
+public:
+  ~vtkFileSeriesPrefetcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Terminate = true;
+      this->Pending.clear();
+    }
+    this->Condition.notify_all();
+    if (this->Thread.joinable())
+    {
+      this->Thread.join();
+    }
+  }
+
+  void Schedule(const std::vector<std::string>& fnames, size_t budget, bool keepContents)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Budget = budget;
+      this->KeepContents = keepContents;
+      this->Wanted = std::set<std::string>(fnames.begin(), fnames.end());
+      for (auto iter = this->Contents.begin(); iter != this->Contents.end();)
+      {
+        if (!keepContents || this->Wanted.find(iter->first) == this->Wanted.end())
+        {
+          this->ContentsSize -= static_cast<size_t>(iter->second->GetNumberOfValues());
+          iter = this->Contents.erase(iter);
+        }
+        else
+        {
+          ++iter;
+        }
+      }
+      this->Pending.clear();
+      for (const auto& fname : fnames)
+      {
+        if (this->Contents.find(fname) == this->Contents.end() && fname != this->Reading &&
+          this->Warmed.find(fname) == this->Warmed.end())
+        {
+          this->Pending.push_back(fname);
+        }
+      }
+      for (auto iter = this->Warmed.begin(); iter != this->Warmed.end();)
+      {
+        iter = this->Wanted.find(*iter) == this->Wanted.end() ? this->Warmed.erase(iter) : ++iter;
+      }
+      if (!this->Thread.joinable() && !this->Pending.empty())
+      {
+        this->Thread = std::thread(&vtkFileSeriesPrefetcher::Run, this);
+      }
+    }
+    this->Condition.notify_all();
+  }
+
+  vtkSmartPointer<vtkCharArray> Take(const std::string& fname)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto iter = this->Contents.find(fname);
+    if (iter == this->Contents.end())
+    {
+      return nullptr;
+    }
+    this->ContentsSize -= static_cast<size_t>(iter->second->GetNumberOfValues());
+    vtkSmartPointer<vtkCharArray> contents = iter->second;
+    this->Contents.erase(iter);
+    return contents;
+  }
+
+  void Wait()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Idle.wait(lock, [this]() { return this->Pending.empty() && this->Reading.empty(); });
+  }
+
+private:
+  void Run()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
+    {
+      this->Condition.wait(lock, [this]() { return this->Terminate || !this->Pending.empty(); });
+      if (this->Terminate)
+      {
+        return;
+      }
+
+      this->Reading = this->Pending.front();
+      this->Pending.pop_front();
+      const std::string fname = this->Reading;
+      const bool keepContents = this->KeepContents;
+      const size_t available =
+        this->Budget > this->ContentsSize ? this->Budget - this->ContentsSize : 0;
+      lock.unlock();
+
+      vtkSmartPointer<vtkCharArray> contents;
+      if (keepContents)
+      {
+        contents = vtkFileSeriesPrefetcher::ReadFile(fname, available);
+      }
+      else
+      {
+        vtkFileSeriesPrefetcher::WarmFile(fname);
+      }
+
+      lock.lock();
+      this->Reading.clear();
+      if (this->Wanted.find(fname) != this->Wanted.end())
+      {
+        if (contents && this->KeepContents &&
+          this->ContentsSize + static_cast<size_t>(contents->GetNumberOfValues()) <= this->Budget)
+        {
+          this->ContentsSize += static_cast<size_t>(contents->GetNumberOfValues());
+          this->Contents[fname] = contents;
+        }
+        else if (!keepContents)
+        {
+          this->Warmed.insert(fname);
+        }
+      }
+      if (this->Pending.empty())
+      {
+        this->Idle.notify_all();
+      }
+    }
+  }
+
+  // Reads the whole file in a vtkCharArray that is handed over to the reader,
+  // so the bytes are never copied again.
+  static vtkSmartPointer<vtkCharArray> ReadFile(const std::string& fname, size_t maxSize)
+  {
+    const size_t length = static_cast<size_t>(vtksys::SystemTools::FileLength(fname));
+    if (length == 0 || length > maxSize)
+    {
+      return nullptr;
+    }
+    vtksys::ifstream file(fname.c_str(), std::ios::in | std::ios::binary);
+    if (!file)
+    {
+      return nullptr;
+    }
+    auto contents = vtkSmartPointer<vtkCharArray>::New();
+    contents->SetNumberOfValues(static_cast<vtkIdType>(length));
+    file.read(contents->GetPointer(0), static_cast<std::streamsize>(length));
+    return static_cast<size_t>(file.gcount()) == length ? contents : nullptr;
+  }
+
+  // Reads the file in small chunks, discarding them.
+  static void WarmFile(const std::string& fname)
+  {
+    vtksys::ifstream file(fname.c_str(), std::ios::in | std::ios::binary);
+    std::vector<char> chunk(1 << 20);
+    while (file.read(chunk.data(), static_cast<std::streamsize>(chunk.size())))
+    {
+      // nothing to do, the bytes are only read to be cached.
+    }
+  }
+
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::condition_variable Idle;
+  std::thread Thread;
+  bool Terminate = false;
+
+  std::deque<std::string> Pending;
+  std::set<std::string> Wanted;
+  std::set<std::string> Warmed;
+  std::string Reading;
+  std::map<std::string, vtkSmartPointer<vtkCharArray>> Contents;
+  size_t ContentsSize = 0;
+  size_t Budget = 0;
+  bool KeepContents = true;
+};
 }
 
 //=============================================================================
@@ -369,6 +558,15 @@ struct vtkFileSeriesReaderInternals
   std::vector<double> TimeValues;
   bool FileNameIsSet;
   vtkFileSeriesReaderTimeRanges* TimeRanges;
+
+  // Prefetching state. The prefetcher is only created once prefetching is
+  // requested.
+  std::unique_ptr<vtkFileSeriesPrefetcher> Prefetcher;
+  int LastRequestedIndex = -1;
+  int PrefetchDirection = 1;
+  std::string PrefetchedFileName;
+  vtkSmartPointer<vtkCharArray> PrefetchedContents;
+  bool ReaderUsesPrefetchedContents = false;
 };
 
 //=============================================================================
@@ -689,6 +887,8 @@ int vtkFileSeriesReader::RequestUpdateExtent(vtkInformation* request,
     return 0;
   }
 
+  this->SchedulePrefetch(index);
+
   // Make sure that the reader file name is set correctly and that
   // RequestInformation has been called.
   outputVector->GetInformationObject(requestFromPort)
@@ -752,6 +952,7 @@ int vtkFileSeriesReader::RequestInformationForInput(
     {
       this->ReaderSetFileName(nullptr);
     }
+    this->ReaderSetPrefetchedContents(index);
 
     this->_FileIndex = index;
     // Need to call RequestInformation on reader to refresh any metadata for the
@@ -786,6 +987,106 @@ int vtkFileSeriesReader::RequestInformationForInput(
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::SchedulePrefetch(int index)
+{
+  auto& internals = (*this->Internal);
+  const int numFiles = static_cast<int>(this->GetNumberOfFileNames());
+  if (this->PrefetchDepth <= 0 || numFiles < 2)
+  {
+    internals.Prefetcher.reset();
+    internals.PrefetchedFileName.clear();
+    internals.PrefetchedContents = nullptr;
+    internals.LastRequestedIndex = index;
+    return;
+  }
+
+  if (index == internals.LastRequestedIndex)
+  {
+    return;
+  }
+  if (internals.LastRequestedIndex >= 0)
+  {
+    internals.PrefetchDirection = index > internals.LastRequestedIndex ? 1 : -1;
+  }
+  internals.LastRequestedIndex = index;
+
+  // Queue the next files in the direction the time steps are being requested,
+  // wrapping around as animations typically loop.
+  std::vector<std::string> fnames;
+  for (int cc = 1; cc <= std::min(this->PrefetchDepth, numFiles - 1); ++cc)
+  {
+    const int next = ((index + cc * internals.PrefetchDirection) % numFiles + numFiles) % numFiles;
+    fnames.emplace_back(this->GetFileName(next));
+  }
+
+  if (!internals.Prefetcher)
+  {
+    internals.Prefetcher.reset(new vtkFileSeriesPrefetcher());
+  }
+
+  // Take the contents for the requested file, if available, before scheduling
+  // as that releases everything not in the new list.
+  internals.PrefetchedFileName = this->GetFileName(index);
+  internals.PrefetchedContents = internals.Prefetcher->Take(internals.PrefetchedFileName);
+  if (!internals.PrefetchedContents)
+  {
+    internals.PrefetchedFileName.clear();
+  }
+
+  const size_t budget = static_cast<size_t>(this->PrefetchMemoryLimit) << 20;
+  internals.Prefetcher->Schedule(fnames, budget, this->CanReadPrefetchedContents());
+}
+
+//-----------------------------------------------------------------------------
+bool vtkFileSeriesReader::CanReadPrefetchedContents()
+{
+  // Only legacy readers can read from memory without copying the bytes. Since
+  // the file name is still set, they can be used even when the file refers to
+  // other files.
+  return vtkDataReader::SafeDownCast(this->Reader) != nullptr && this->FileNameMethod &&
+    strcmp(this->FileNameMethod, "SetFileName") == 0;
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::WaitForPrefetching()
+{
+  if (this->Internal->Prefetcher)
+  {
+    this->Internal->Prefetcher->Wait();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::ReaderSetPrefetchedContents(int index)
+{
+  auto& internals = (*this->Internal);
+
+  vtkSmartPointer<vtkCharArray> contents;
+  const char* fname = this->GetFileName(static_cast<unsigned int>(index));
+  if (fname && internals.PrefetchedFileName == fname)
+  {
+    contents = internals.PrefetchedContents;
+  }
+  internals.PrefetchedFileName.clear();
+  internals.PrefetchedContents = nullptr;
+
+  auto legacyReader = vtkDataReader::SafeDownCast(this->Reader);
+  if (contents && this->CanReadPrefetchedContents())
+  {
+    vtkLogF(TRACE, "%s: using prefetched '%s'", vtkLogIdentifier(this), fname);
+    legacyReader->SetInputArray(contents);
+    legacyReader->SetReadFromInputString(true);
+    internals.ReaderUsesPrefetchedContents = true;
+  }
+  else if (internals.ReaderUsesPrefetchedContents && legacyReader)
+  {
+    legacyReader->SetReadFromInputString(false);
+    legacyReader->SetInputArray(nullptr);
+    internals.ReaderUsesPrefetchedContents = false;
+  }
+}
+
 //-----------------------------------------------------------------------------
 int vtkFileSeriesReader::FillOutputPortInformation(int port, vtkInformation* info)
 {
@@ -1000,6 +1301,8 @@ void vtkFileSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
      << endl;
   os << indent << "UseMetaFile: " << this->UseMetaFile << endl;
   os << indent << "IgnoreReaderTime: " << this->IgnoreReaderTime << endl;
+  os << indent << "PrefetchDepth: " << this->PrefetchDepth << endl;
+  os << indent << "PrefetchMemoryLimit: " << this->PrefetchMemoryLimit << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -55,6 +55,16 @@
  * with SetMetaFileName in this case. Do not use the AddFileName() method when
  * using SetMetaFileName() as names set with AddFileName() will be ignored.
  *
+ * When PrefetchDepth is greater than 0, a background thread reads the
+ * contents of the next PrefetchDepth files, in the direction in which the
+ * time steps are being requested, while the current one is being processed.
+ * Readers deriving from vtkDataReader then parse the prefetched bytes from
+ * memory, without copying them, while the file name is still set on the
+ * reader. Other readers, including XML readers, read the files themselves and
+ * benefit from them being in the operating system's file cache. The bytes
+ * kept in memory are limited to PrefetchMemoryLimit MiB. Since whole files
+ * are prefetched, this is mostly useful when every process reads entire files.
+ *
 */
 
 #ifndef vtkFileSeriesReader_h
@@ -140,6 +150,30 @@ public:
   vtkBooleanMacro(IgnoreReaderTime, bool);
   ///@}
 
+  ///@{
+  /**
+   * Set the number of files to prefetch in the background. 0, the default,
+   * disables prefetching.
+   */
+  vtkSetClampMacro(PrefetchDepth, int, 0, VTK_INT_MAX);
+  vtkGetMacro(PrefetchDepth, int);
+  ///@}
+
+  ///@{
+  /**
+   * Set the maximum amount of prefetched data, in MiB, kept in memory. Default
+   * is 256.
+   */
+  vtkSetClampMacro(PrefetchMemoryLimit, int, 0, VTK_INT_MAX);
+  vtkGetMacro(PrefetchMemoryLimit, int);
+  ///@}
+
+  /**
+   * Blocks until the files scheduled for prefetching have been read. This is
+   * mostly useful for testing.
+   */
+  void WaitForPrefetching();
+
   // Expose number of files, first filename and current file number as
   // information keys for potential use in the internal reader
   static vtkInformationIntegerKey* FILE_SERIES_NUMBER_OF_FILES();
@@ -224,9 +258,30 @@ protected:
   void CopyRealFileNamesFromFileNames();
 
   bool IgnoreReaderTime;
+  int PrefetchDepth = 0;
+  int PrefetchMemoryLimit = 256;
 
   int ChooseInput(vtkInformation*);
 
+  /**
+   * Called in RequestUpdateExtent() with the index of the file about to be
+   * read to queue prefetching of the following files.
+   */
+  void SchedulePrefetch(int index);
+
+  /**
+   * If the file at the given index was prefetched, passes its contents to the
+   * internal reader, if supported. Otherwise, makes sure the internal reader
+   * reads from the file.
+   */
+  void ReaderSetPrefetchedContents(int index);
+
+  /**
+   * Returns true if the internal reader can read the prefetched contents from
+   * memory. Otherwise, files are only prefetched to the file system cache.
+   */
+  bool CanReadPrefetchedContents();
+
 private:
   vtkFileSeriesReader(const vtkFileSeriesReader&) = delete;
   void operator=(const vtkFileSeriesReader&) = delete;
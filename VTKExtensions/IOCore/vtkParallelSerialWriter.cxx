@@ -17,15 +17,27 @@
 #include "vtkObjectFactory.h"
 #include "vtkPartitionedDataSet.h"
 #include "vtkPartitionedDataSetCollection.h"
+#include "vtkPolyData.h"
 #include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringFormatter.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkXMLPolyDataWriter.h"
+#include "vtkXMLUnstructuredGridWriter.h"
+
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+#include "vtkMPI.h"
+#include "vtkMPICommunicator.h"
+#endif
 
 #include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <vtksys/FStream.hxx>
 #include <vtksys/SystemTools.hxx>
 
 namespace
@@ -41,6 +53,49 @@ bool vtkIsEmpty(vtkDataObject* dobj)
   }
   return true;
 }
+
+// Returns a VTK XML writer for the given data type, or nullptr if the type
+// cannot be written as a multi-piece file.
+vtkSmartPointer<vtkXMLWriter> vtkNewPartWriter(vtkDataObject* dobj)
+{
+  vtkSmartPointer<vtkXMLWriter> writer;
+  if (vtkPolyData::SafeDownCast(dobj))
+  {
+    writer = vtkSmartPointer<vtkXMLPolyDataWriter>::New();
+  }
+  else if (vtkUnstructuredGrid::SafeDownCast(dobj))
+  {
+    writer = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
+  }
+  if (writer)
+  {
+    // Inline data keeps every piece self-contained.
+    writer->SetDataModeToBinary();
+  }
+  return writer;
+}
+
+// Splits the output of a VTK XML writer for a single piece in the lines
+// before the piece, the piece itself and the lines after the piece, without
+// copying them.
+bool vtkSplitPiece(std::string_view xml, std::string_view& header, std::string_view& piece,
+  std::string_view& trailer)
+{
+  const auto pieceBegin = xml.find("<Piece");
+  const auto pieceEnd = xml.rfind("</Piece>");
+  if (pieceBegin == std::string::npos || pieceEnd == std::string::npos)
+  {
+    return false;
+  }
+  const auto lineBegin = xml.rfind('\n', pieceBegin);
+  const auto first = lineBegin == std::string::npos ? 0 : lineBegin + 1;
+  const auto lineEnd = xml.find('\n', pieceEnd);
+  const auto last = lineEnd == std::string::npos ? xml.size() : lineEnd + 1;
+  header = xml.substr(0, first);
+  piece = xml.substr(first, last - first);
+  trailer = xml.substr(last);
+  return true;
+}
 }
 
 vtkStandardNewMacro(vtkParallelSerialWriter);
@@ -52,6 +107,7 @@ vtkCxxSetObjectMacro(vtkParallelSerialWriter, Controller, vtkMultiProcessControl
 vtkParallelSerialWriter::vtkParallelSerialWriter()
   : NumberOfIORanks(1)
   , RankAssignmentMode(vtkParallelSerialWriter::ASSIGNMENT_MODE_CONTIGUOUS)
+  , CollectiveIO(false)
   , Controller(nullptr)
   , SubController(nullptr)
 {
@@ -198,6 +254,16 @@ int vtkParallelSerialWriter::RequestData(vtkInformation* request,
     this->CurrentTimeIndex = 0;
   }
 
+  // The input type is the same on all ranks, even those without data, so all
+  // of them make the same decision.
+  this->PartWriter =
+    this->CollectiveIO ? vtkNewPartWriter(vtkDataObject::GetData(inputVector[0], 0)) : nullptr;
+  if (this->CollectiveIO && !this->PartWriter)
+  {
+    vtkWarningMacro("CollectiveIO only supports vtkPolyData and vtkUnstructuredGrid inputs. "
+                    "Writing one file per IO rank.");
+  }
+
   const int num_ranks = this->Controller->GetNumberOfProcesses();
   int num_io_ranks = std::min(this->NumberOfIORanks, num_ranks);
   num_io_ranks = num_io_ranks <= 0 ? num_ranks : num_io_ranks;
@@ -290,6 +356,21 @@ int vtkParallelSerialWriter::RequestData(vtkInformation* request,
 
 //----------------------------------------------------------------------------
 void vtkParallelSerialWriter::WriteATimestep(const std::string& fname, vtkPartitionedDataSet* input)
+{
+  auto merged = this->GatherToIORanks(input);
+  if (this->PartWriter)
+  {
+    this->WriteCollectively(fname, merged);
+  }
+  else if (merged)
+  {
+    this->WriteAFile(fname, merged);
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkParallelSerialWriter::GatherToIORanks(
+  vtkPartitionedDataSet* input)
 {
   assert(input != nullptr);
 
@@ -310,7 +391,7 @@ void vtkParallelSerialWriter::WriteATimestep(const std::string& fname, vtkPartit
   if (controller->GetLocalProcessId() != 0)
   {
     // done.
-    return;
+    return nullptr;
   }
   assert(!gatheredDataSets.empty());
 
@@ -329,7 +410,7 @@ void vtkParallelSerialWriter::WriteATimestep(const std::string& fname, vtkPartit
     allDataSets.end());
   if (allDataSets.empty())
   {
-    return;
+    return nullptr;
   }
 
   if (this->PostGatherHelper)
@@ -352,16 +433,162 @@ void vtkParallelSerialWriter::WriteATimestep(const std::string& fname, vtkPartit
   {
     inputDO = allDataSets.front();
   }
+  return inputDO;
+}
 
-  // release memory.
-  allDataSets.clear();
-  this->WriteAFile(fname, inputDO);
+//----------------------------------------------------------------------------
+void vtkParallelSerialWriter::WriteCollectively(const std::string& fname, vtkDataObject* input)
+{
+  // Serialize the local part, if any, in memory and split it so that the
+  // pieces of all IO ranks can be written between a single header and trailer.
+  std::string xml;
+  std::string_view header, piece, trailer;
+  if (input)
+  {
+    this->PartWriter->SetInputDataObject(input);
+    this->PartWriter->WriteToOutputStringOn();
+    this->PartWriter->Write();
+    xml = this->PartWriter->GetOutputString();
+    if (!vtkSplitPiece(xml, header, piece, trailer))
+    {
+      vtkErrorMacro("Failed to serialize the data to write.");
+      header = piece = trailer = std::string_view();
+    }
+    this->PartWriter->WriteToOutputStringOff();
+    this->PartWriter->RemoveAllInputConnections(0);
+  }
+
+  const std::string path = vtksys::SystemTools::GetFilenamePath(fname);
+  const std::string fnameNoExt = vtksys::SystemTools::GetFilenameWithoutLastExtension(fname);
+  const std::string filename = this->GetTimeStepFileName(vtk::format("{0}{1}{2}.{3}", path,
+    path.empty() ? "" : "/", fnameNoExt, this->PartWriter->GetDefaultFileExtension()));
+  if (!this->WriteSharedFile(filename, header, piece, trailer))
+  {
+    vtkErrorMacro("Failed to write '" << filename << "'.");
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkParallelSerialWriter::WriteSharedFile(const std::string& filename,
+  std::string_view header, std::string_view piece, std::string_view trailer)
+{
+  const int numRanks = this->Controller->GetNumberOfProcesses();
+  const int myId = this->Controller->GetLocalProcessId();
+
+  // Exchange the sizes to compute where each rank writes. The header comes
+  // from the first rank with a piece, the trailer from the last one.
+  const vtkTypeUInt64 localSizes[3] = { piece.size(), header.size(), trailer.size() };
+  std::vector<vtkTypeUInt64> sizes(3 * numRanks, 0);
+  this->Controller->AllGather(localSizes, sizes.data(), 3);
+  int first = -1, last = -1;
+  vtkTypeUInt64 maxPieceSize = 0;
+  for (int cc = 0; cc < numRanks; ++cc)
+  {
+    if (sizes[3 * cc] > 0)
+    {
+      first = first == -1 ? cc : first;
+      last = cc;
+    }
+    maxPieceSize = std::max(maxPieceSize, sizes[3 * cc]);
+  }
+  if (first == -1)
+  {
+    // nothing to write.
+    return true;
+  }
+
+  std::vector<vtkTypeUInt64> offsets(numRanks + 1, 0);
+  offsets[0] = sizes[3 * first + 1];
+  for (int cc = 0; cc < numRanks; ++cc)
+  {
+    offsets[cc + 1] = offsets[cc] + sizes[3 * cc];
+  }
+  const vtkTypeUInt64 total = offsets[numRanks] + sizes[3 * last + 2];
+
+  // The header, the pieces and the trailer are written from where they are,
+  // each at its own offset. Ranks that do not own a segment write nothing.
+  struct Segment
+  {
+    std::string_view Data;
+    vtkTypeUInt64 Offset;
+    vtkTypeUInt64 MaxSize; // same on all ranks.
+  };
+  const Segment segments[3] = {
+    { myId == first ? header : std::string_view(), 0, sizes[3 * first + 1] },
+    { piece, offsets[myId], maxPieceSize },
+    { myId == last ? trailer : std::string_view(), offsets[numRanks], sizes[3 * last + 2] },
+  };
+
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  if (auto communicator = vtkMPICommunicator::SafeDownCast(this->Controller->GetCommunicator()))
+  {
+    MPI_Comm comm = *communicator->GetMPIComm()->GetHandle();
+    MPI_File fh;
+    if (MPI_File_open(comm, filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL,
+          &fh) != MPI_SUCCESS)
+    {
+      return false;
+    }
+
+    bool success = MPI_File_set_size(fh, static_cast<MPI_Offset>(total)) == MPI_SUCCESS;
+
+    // MPI counts are ints, hence write in chunks. All ranks must make the same
+    // number of collective calls, which the gathered sizes give.
+    const vtkTypeUInt64 chunkSize = vtkTypeUInt64(1) << 30;
+    for (const Segment& segment : segments)
+    {
+      const vtkTypeUInt64 localSize = segment.Data.size();
+      const vtkTypeUInt64 numChunks = (segment.MaxSize + chunkSize - 1) / chunkSize;
+      for (vtkTypeUInt64 cc = 0; cc < numChunks; ++cc)
+      {
+        const vtkTypeUInt64 begin = std::min(cc * chunkSize, localSize);
+        const vtkTypeUInt64 count = std::min(chunkSize, localSize - begin);
+        // older MPI implementations take a non-const buffer.
+        char* data = const_cast<char*>(segment.Data.data()) + begin;
+        success = MPI_File_write_at_all(fh, static_cast<MPI_Offset>(segment.Offset + begin), data,
+                    static_cast<int>(count), MPI_BYTE, MPI_STATUS_IGNORE) == MPI_SUCCESS &&
+          success;
+      }
+    }
+    success = MPI_File_close(&fh) == MPI_SUCCESS && success;
+
+    int localSuccess = success ? 1 : 0;
+    int allSuccess = 0;
+    this->Controller->AllReduce(&localSuccess, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+    return allSuccess != 0;
+  }
+#endif
+
+  if (numRanks > 1)
+  {
+    vtkErrorMacro("CollectiveIO requires an MPI controller when running in parallel.");
+    return false;
+  }
+
+  // A single rank writes all the segments, in order.
+  vtksys::ofstream file(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  for (const Segment& segment : segments)
+  {
+    file.write(segment.Data.data(), static_cast<std::streamsize>(segment.Data.size()));
+  }
+  return static_cast<bool>(file);
 }
 
 //----------------------------------------------------------------------------
 void vtkParallelSerialWriter::WriteAFile(const std::string& filename_arg, vtkDataObject* input)
 {
-  std::string filename = this->GetPartitionFileName(filename_arg);
+  const std::string filename =
+    this->GetTimeStepFileName(this->GetPartitionFileName(filename_arg));
+  this->Writer->SetInputDataObject(input);
+  this->SetWriterFileName(filename.c_str());
+  this->WriteInternal();
+  this->Writer->RemoveAllInputConnections(0);
+}
+
+//----------------------------------------------------------------------------
+std::string vtkParallelSerialWriter::GetTimeStepFileName(const std::string& filename_arg)
+{
+  std::string filename = filename_arg;
   if (this->WriteAllTimeSteps)
   {
     std::string path = vtksys::SystemTools::GetFilenamePath(filename);
@@ -381,11 +608,7 @@ void vtkParallelSerialWriter::WriteAFile(const std::string& filename_arg, vtkDat
       filename = vtk::format("{0}/{1}.{2}{3}", path, fnamenoext, this->CurrentTimeIndex, ext);
     }
   }
-
-  this->Writer->SetInputDataObject(input);
-  this->SetWriterFileName(filename.c_str());
-  this->WriteInternal();
-  this->Writer->RemoveAllInputConnections(0);
+  return filename;
 }
 
 //----------------------------------------------------------------------------
@@ -448,4 +671,7 @@ void vtkParallelSerialWriter::SetWriterFileName(const char* fname)
 void vtkParallelSerialWriter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfIORanks: " << this->NumberOfIORanks << endl;
+  os << indent << "RankAssignmentMode: " << this->RankAssignmentMode << endl;
+  os << indent << "CollectiveIO: " << this->CollectiveIO << endl;
 }
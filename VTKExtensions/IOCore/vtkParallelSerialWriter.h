@@ -13,6 +13,13 @@
  *
  * This also makes it possible to write time-series for temporal datasets using
  * simple non-time-aware writers.
+ *
+ * When CollectiveIO is enabled and the input is a vtkPolyData or a
+ * vtkUnstructuredGrid, the IO ranks do not write one file each. Instead, each IO
+ * rank serializes its part in memory as a VTK XML piece and all pieces are
+ * written to a single VTK XML file (.vtp or .vtu) using MPI-IO collective
+ * writes, each at its own offset. The result can be read with
+ * vtkXMLPolyDataReader or vtkXMLUnstructuredGridReader.
  */
 
 #ifndef vtkParallelSerialWriter_h
@@ -22,10 +29,12 @@
 #include "vtkPVVTKExtensionsIOCoreModule.h" //needed for exports
 #include "vtkSmartPointer.h"                // needed for vtkSmartPointer
 #include <string>                           // for std::string
+#include <string_view>                      // for std::string_view
 
 class vtkClientServerInterpreter;
 class vtkMultiProcessController;
 class vtkPartitionedDataSet;
+class vtkXMLWriter;
 
 class VTKPVVTKEXTENSIONSIOCORE_EXPORT vtkParallelSerialWriter : public vtkDataObjectAlgorithm
 {
@@ -180,6 +189,20 @@ public:
   vtkGetMacro(RankAssignmentMode, int);
   ///@}
 
+  ///@{
+  /**
+   * When set to true, the IO ranks write their parts as the pieces of a single
+   * VTK XML file using MPI-IO collective writes instead of writing one file per
+   * IO rank. The extension of the file name is replaced by .vtp or .vtu. This is
+   * only supported for vtkPolyData and vtkUnstructuredGrid inputs; otherwise
+   * one file per IO rank is written. Without MPI, it is only supported on a
+   * single rank. Default is false.
+   */
+  vtkSetMacro(CollectiveIO, bool);
+  vtkGetMacro(CollectiveIO, bool);
+  vtkBooleanMacro(CollectiveIO, bool);
+  ///@}
+
   ///@{
   /**
    * Get/Set the controller to use. By default initialized to
@@ -207,6 +230,23 @@ private:
   void WriteATimestep(const std::string& fname, vtkPartitionedDataSet* input);
   void WriteAFile(const std::string& fname, vtkDataObject* input);
 
+  /**
+   * Gathers and merges the input to the IO ranks. Returns nullptr on other
+   * ranks or if there is nothing to write.
+   */
+  vtkSmartPointer<vtkDataObject> GatherToIORanks(vtkPartitionedDataSet* input);
+
+  /**
+   * Writes the input of all IO ranks to a single shared file. This must be
+   * called on all ranks, with a nullptr input on ranks that have nothing to
+   * write.
+   */
+  void WriteCollectively(const std::string& fname, vtkDataObject* input);
+  bool WriteSharedFile(const std::string& fname, std::string_view header, std::string_view piece,
+    std::string_view trailer);
+
+  std::string GetTimeStepFileName(const std::string& fname);
+
   void SetWriterFileName(const char* fname);
   void WriteInternal();
 
@@ -233,6 +273,8 @@ private:
 
   int NumberOfIORanks;
   int RankAssignmentMode;
+  bool CollectiveIO;
+  vtkSmartPointer<vtkXMLWriter> PartWriter;
 
   vtkMultiProcessController* Controller;
   vtkSmartPointer<vtkMultiProcessController> SubController;
@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkMPIController.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPGenericEnSightReader.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <array>
+#include <iostream>
+#include <map>
+#include <vector>
+
+// Each process reads only the range of variable values it owns. The values of its points and
+// cells must be the ones a single process reads for the same points and cells.
+
+namespace
+{
+using Key = std::array<double, 3>;
+
+Key GetPointKey(vtkDataSet* dataSet, vtkIdType pointId)
+{
+  Key key;
+  dataSet->GetPoint(pointId, key.data());
+  return key;
+}
+
+// Cells are identified by the average of their points.
+Key GetCellKey(vtkDataSet* dataSet, vtkIdType cellId, vtkIdList* pointIds)
+{
+  Key key = { 0.0, 0.0, 0.0 };
+  dataSet->GetCellPoints(cellId, pointIds);
+  for (vtkIdType i = 0; i < pointIds->GetNumberOfIds(); ++i)
+  {
+    const Key point = GetPointKey(dataSet, pointIds->GetId(i));
+    for (int cc = 0; cc < 3; ++cc)
+    {
+      key[cc] += point[cc] / pointIds->GetNumberOfIds();
+    }
+  }
+  return key;
+}
+
+// Compares the arrays of `expected` with the ones of `actual`, for the tuples of `actual` found
+// in `expectedIds`.
+bool CompareArrays(const char* what, vtkDataSetAttributes* expected, vtkDataSetAttributes* actual,
+  const std::vector<vtkIdType>& expectedIds)
+{
+  for (int a = 0; a < expected->GetNumberOfArrays(); ++a)
+  {
+    vtkDataArray* expectedArray = expected->GetArray(a);
+    if (!expectedArray || !expectedArray->GetName())
+    {
+      continue;
+    }
+    vtkDataArray* actualArray = actual->GetArray(expectedArray->GetName());
+    if (!actualArray ||
+      actualArray->GetNumberOfComponents() != expectedArray->GetNumberOfComponents())
+    {
+      std::cerr << "Missing " << what << " array " << expectedArray->GetName() << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < static_cast<vtkIdType>(expectedIds.size()); ++i)
+    {
+      for (int cc = 0; cc < expectedArray->GetNumberOfComponents(); ++cc)
+      {
+        if (expectedArray->GetComponent(expectedIds[i], cc) != actualArray->GetComponent(i, cc))
+        {
+          std::cerr << "Mismatched " << what << " value of " << expectedArray->GetName() << " at "
+                    << i << ": " << expectedArray->GetComponent(expectedIds[i], cc)
+                    << " != " << actualArray->GetComponent(i, cc) << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Checks the local block `actual` against the block `expected` read by a single process, and
+// counts the local cells that are not ghosts.
+bool CompareBlock(vtkDataSet* expected, vtkDataSet* actual, vtkIdType& numberOfCells)
+{
+  std::map<Key, vtkIdType> expectedPoints;
+  for (vtkIdType pointId = 0; pointId < expected->GetNumberOfPoints(); ++pointId)
+  {
+    expectedPoints.emplace(GetPointKey(expected, pointId), pointId);
+  }
+  std::vector<vtkIdType> pointIds(actual->GetNumberOfPoints());
+  for (vtkIdType pointId = 0; pointId < actual->GetNumberOfPoints(); ++pointId)
+  {
+    auto found = expectedPoints.find(GetPointKey(actual, pointId));
+    if (found == expectedPoints.end())
+    {
+      std::cerr << "Unexpected point " << pointId << std::endl;
+      return false;
+    }
+    pointIds[pointId] = found->second;
+  }
+
+  vtkNew<vtkIdList> cellPointIds;
+  std::map<Key, vtkIdType> expectedCells;
+  for (vtkIdType cellId = 0; cellId < expected->GetNumberOfCells(); ++cellId)
+  {
+    expectedCells.emplace(GetCellKey(expected, cellId, cellPointIds), cellId);
+  }
+  std::vector<vtkIdType> cellIds(actual->GetNumberOfCells());
+  vtkUnsignedCharArray* ghosts = actual->GetCellData()->GetGhostArray();
+  for (vtkIdType cellId = 0; cellId < actual->GetNumberOfCells(); ++cellId)
+  {
+    auto found = expectedCells.find(GetCellKey(actual, cellId, cellPointIds));
+    if (found == expectedCells.end())
+    {
+      std::cerr << "Unexpected cell " << cellId << std::endl;
+      return false;
+    }
+    cellIds[cellId] = found->second;
+    if (!ghosts || ghosts->GetValue(cellId) == 0)
+    {
+      ++numberOfCells;
+    }
+  }
+
+  return CompareArrays("point", expected->GetPointData(), actual->GetPointData(), pointIds) &&
+    CompareArrays("cell", expected->GetCellData(), actual->GetCellData(), cellIds);
+}
+
+vtkSmartPointer<vtkMultiBlockDataSet> Read(const char* fname)
+{
+  vtkNew<vtkPGenericEnSightReader> reader;
+  reader->SetCaseFileName(fname);
+  reader->ReadAllVariablesOn();
+  reader->Update();
+  return reader->GetOutput();
+}
+}
+
+extern int TestPEnSightBinaryGoldReaderVariables(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv, 0);
+
+  char* fname =
+    vtkTestUtilities::ExpandDataFileName(argc, argv, "Testing/Data/EnSight/TEST_bin.case");
+
+  // Without a global controller, the reader reads all the data.
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  vtkSmartPointer<vtkMultiBlockDataSet> expected = Read(fname);
+
+  vtkMultiProcessController::SetGlobalController(controller);
+  vtkSmartPointer<vtkMultiBlockDataSet> actual = Read(fname);
+  delete[] fname;
+
+  int localSuccess = 1;
+  vtkIdType localCells = 0;
+  vtkIdType expectedCells = 0;
+  for (unsigned int block = 0; block < expected->GetNumberOfBlocks(); ++block)
+  {
+    auto expectedBlock = vtkDataSet::SafeDownCast(expected->GetBlock(block));
+    auto actualBlock = block < actual->GetNumberOfBlocks()
+      ? vtkDataSet::SafeDownCast(actual->GetBlock(block))
+      : nullptr;
+    if (!expectedBlock)
+    {
+      continue;
+    }
+    expectedCells += expectedBlock->GetNumberOfCells();
+    if (actualBlock && !::CompareBlock(expectedBlock, actualBlock, localCells))
+    {
+      std::cerr << "in block " << block << std::endl;
+      localSuccess = 0;
+    }
+  }
+
+  // The cells are distributed between the processes.
+  vtkIdType cells = 0;
+  controller->AllReduce(&localCells, &cells, 1, vtkCommunicator::SUM_OP);
+  if (cells != expectedCells)
+  {
+    std::cerr << "Read " << cells << " cells in parallel instead of " << expectedCells << std::endl;
+    localSuccess = 0;
+  }
+
+  int success = 0;
+  controller->AllReduce(&localSuccess, &success, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1292,7 +1292,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
   int component)
 {
   char line[80];
-  int partId, realId, numPts, i, lineRead;
+  int partId, realId, numPts, i, lineRead, first, last;
   vtkFloatArray* scalars;
   float* scalarsRead;
   vtkDataSet* output;
@@ -1463,9 +1463,10 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
       }
 
       scalarsRead = new float[numPts];
-      this->ReadFloatArray(scalarsRead, numPts);
+      this->GetPointIds(realId)->GetLocalIdRange(numPts, first, last);
+      this->ReadFloatArray(scalarsRead, numPts, first, last);
 
-      for (i = 0; i < numPts; i++)
+      for (i = first; i < last; i++)
       {
         this->InsertVariableComponent(
           scalars, i, component, &(scalarsRead[i]), realId, 0, SCALAR_PER_NODE);
@@ -1507,7 +1508,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
   int timeStep, vtkMultiBlockDataSet* compositeOutput, int measured)
 {
   char line[80];
-  int partId, realId, numPts, i, lineRead;
+  int partId, realId, numPts, i, lineRead, first, last;
   vtkFloatArray* vectors;
   float tuple[3];
   float *comp1, *comp2, *comp3;
@@ -1670,10 +1671,11 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
       comp1 = new float[numPts];
       comp2 = new float[numPts];
       comp3 = new float[numPts];
-      this->ReadFloatArray(comp1, numPts);
-      this->ReadFloatArray(comp2, numPts);
-      this->ReadFloatArray(comp3, numPts);
-      for (i = 0; i < numPts; i++)
+      this->GetPointIds(realId)->GetLocalIdRange(numPts, first, last);
+      this->ReadFloatArray(comp1, numPts, first, last);
+      this->ReadFloatArray(comp2, numPts, first, last);
+      this->ReadFloatArray(comp3, numPts, first, last);
+      for (i = first; i < last; i++)
       {
         tuple[0] = comp1[i];
         tuple[1] = comp2[i];
@@ -1712,7 +1714,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
   int timeStep, vtkMultiBlockDataSet* compositeOutput)
 {
   char line[80];
-  int partId, realId, numPts, i, lineRead;
+  int partId, realId, numPts, i, lineRead, first, last;
   vtkFloatArray* tensors;
   float *comp1, *comp2, *comp3, *comp4, *comp5, *comp6;
   float tuple[6];
@@ -1824,13 +1826,14 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
       comp4 = new float[numPts];
       comp5 = new float[numPts];
       comp6 = new float[numPts];
-      this->ReadFloatArray(comp1, numPts);
-      this->ReadFloatArray(comp2, numPts);
-      this->ReadFloatArray(comp3, numPts);
-      this->ReadFloatArray(comp4, numPts);
-      this->ReadFloatArray(comp6, numPts);
-      this->ReadFloatArray(comp5, numPts);
-      for (i = 0; i < numPts; i++)
+      this->GetPointIds(realId)->GetLocalIdRange(numPts, first, last);
+      this->ReadFloatArray(comp1, numPts, first, last);
+      this->ReadFloatArray(comp2, numPts, first, last);
+      this->ReadFloatArray(comp3, numPts, first, last);
+      this->ReadFloatArray(comp4, numPts, first, last);
+      this->ReadFloatArray(comp6, numPts, first, last);
+      this->ReadFloatArray(comp5, numPts, first, last);
+      for (i = first; i < last; i++)
       {
         tuple[0] = comp1[i];
         tuple[1] = comp2[i];
@@ -1872,7 +1875,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
   int numberOfComponents, int component)
 {
   char line[80];
-  int partId, realId, numCells, numCellsPerElement, i, idx;
+  int partId, realId, numCells, numCellsPerElement, i, idx, first, last;
   vtkFloatArray* scalars;
   float* scalarsRead;
   int lineRead, elementType;
@@ -2023,8 +2026,9 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
       if (strncmp(line, "block", 5) == 0)
       {
         scalarsRead = new float[numCells];
-        this->ReadFloatArray(scalarsRead, numCells);
-        for (i = 0; i < numCells; i++)
+        this->GetCellIds(realId, 0)->GetLocalIdRange(numCells, first, last);
+        this->ReadFloatArray(scalarsRead, numCells, first, last);
+        for (i = first; i < last; i++)
         {
           this->InsertVariableComponent(
             scalars, i, component, &(scalarsRead[i]), realId, 0, SCALAR_PER_ELEMENT);
@@ -2059,8 +2063,9 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
           idx = this->UnstructuredPartIds->IsId(realId);
           numCellsPerElement = this->GetCellIds(idx, elementType)->GetNumberOfIds();
           scalarsRead = new float[numCellsPerElement];
-          this->ReadFloatArray(scalarsRead, numCellsPerElement);
-          for (i = 0; i < numCellsPerElement; i++)
+          this->GetCellIds(idx, elementType)->GetLocalIdRange(numCellsPerElement, first, last);
+          this->ReadFloatArray(scalarsRead, numCellsPerElement, first, last);
+          for (i = first; i < last; i++)
           {
             this->InsertVariableComponent(
               scalars, i, component, &(scalarsRead[i]), idx, elementType, SCALAR_PER_ELEMENT);
@@ -2117,7 +2122,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
   const char* description, int timeStep, vtkMultiBlockDataSet* compositeOutput)
 {
   char line[80];
-  int partId, realId, numCells, numCellsPerElement, i, idx;
+  int partId, realId, numCells, numCellsPerElement, i, idx, first, last;
   vtkFloatArray* vectors;
   float *comp1, *comp2, *comp3;
   int lineRead, elementType;
@@ -2264,10 +2269,11 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
         comp1 = new float[numCells];
         comp2 = new float[numCells];
         comp3 = new float[numCells];
-        this->ReadFloatArray(comp1, numCells);
-        this->ReadFloatArray(comp2, numCells);
-        this->ReadFloatArray(comp3, numCells);
-        for (i = 0; i < numCells; i++)
+        this->GetCellIds(realId, 0)->GetLocalIdRange(numCells, first, last);
+        this->ReadFloatArray(comp1, numCells, first, last);
+        this->ReadFloatArray(comp2, numCells, first, last);
+        this->ReadFloatArray(comp3, numCells, first, last);
+        for (i = first; i < last; i++)
         {
           tuple[0] = comp1[i];
           tuple[1] = comp2[i];
@@ -2305,10 +2311,11 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
           comp1 = new float[numCellsPerElement];
           comp2 = new float[numCellsPerElement];
           comp3 = new float[numCellsPerElement];
-          this->ReadFloatArray(comp1, numCellsPerElement);
-          this->ReadFloatArray(comp2, numCellsPerElement);
-          this->ReadFloatArray(comp3, numCellsPerElement);
-          for (i = 0; i < numCellsPerElement; i++)
+          this->GetCellIds(idx, elementType)->GetLocalIdRange(numCellsPerElement, first, last);
+          this->ReadFloatArray(comp1, numCellsPerElement, first, last);
+          this->ReadFloatArray(comp2, numCellsPerElement, first, last);
+          this->ReadFloatArray(comp3, numCellsPerElement, first, last);
+          for (i = first; i < last; i++)
           {
             tuple[0] = comp1[i];
             tuple[1] = comp2[i];
@@ -2363,7 +2370,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
   const char* description, int timeStep, vtkMultiBlockDataSet* compositeOutput)
 {
   char line[80];
-  int partId, realId, numCells, numCellsPerElement, i, idx;
+  int partId, realId, numCells, numCellsPerElement, i, idx, first, last;
   vtkFloatArray* tensors;
   int lineRead, elementType;
   float *comp1, *comp2, *comp3, *comp4, *comp5, *comp6;
@@ -2514,13 +2521,14 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
         comp4 = new float[numCells];
         comp5 = new float[numCells];
         comp6 = new float[numCells];
-        this->ReadFloatArray(comp1, numCells);
-        this->ReadFloatArray(comp2, numCells);
-        this->ReadFloatArray(comp3, numCells);
-        this->ReadFloatArray(comp4, numCells);
-        this->ReadFloatArray(comp6, numCells);
-        this->ReadFloatArray(comp5, numCells);
-        for (i = 0; i < numCells; i++)
+        this->GetCellIds(realId, 0)->GetLocalIdRange(numCells, first, last);
+        this->ReadFloatArray(comp1, numCells, first, last);
+        this->ReadFloatArray(comp2, numCells, first, last);
+        this->ReadFloatArray(comp3, numCells, first, last);
+        this->ReadFloatArray(comp4, numCells, first, last);
+        this->ReadFloatArray(comp6, numCells, first, last);
+        this->ReadFloatArray(comp5, numCells, first, last);
+        for (i = first; i < last; i++)
         {
           tuple[0] = comp1[i];
           tuple[1] = comp2[i];
@@ -2567,13 +2575,14 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
           comp4 = new float[numCellsPerElement];
           comp5 = new float[numCellsPerElement];
           comp6 = new float[numCellsPerElement];
-          this->ReadFloatArray(comp1, numCellsPerElement);
-          this->ReadFloatArray(comp2, numCellsPerElement);
-          this->ReadFloatArray(comp3, numCellsPerElement);
-          this->ReadFloatArray(comp4, numCellsPerElement);
-          this->ReadFloatArray(comp6, numCellsPerElement);
-          this->ReadFloatArray(comp5, numCellsPerElement);
-          for (i = 0; i < numCellsPerElement; i++)
+          this->GetCellIds(idx, elementType)->GetLocalIdRange(numCellsPerElement, first, last);
+          this->ReadFloatArray(comp1, numCellsPerElement, first, last);
+          this->ReadFloatArray(comp2, numCellsPerElement, first, last);
+          this->ReadFloatArray(comp3, numCellsPerElement, first, last);
+          this->ReadFloatArray(comp4, numCellsPerElement, first, last);
+          this->ReadFloatArray(comp6, numCellsPerElement, first, last);
+          this->ReadFloatArray(comp5, numCellsPerElement, first, last);
+          for (i = first; i < last; i++)
           {
             tuple[0] = comp1[i];
             tuple[1] = comp2[i];
@@ -4271,6 +4280,58 @@ int vtkPEnSightGoldBinaryReader::ReadFloatArray(float* result, int numFloats)
   return 1;
 }
 
+// Internal function to read the [first, last) range of a float array.
+// Returns zero if there was an error.
+int vtkPEnSightGoldBinaryReader::ReadFloatArray(
+  float* result, int numFloats, int first, int last)
+{
+  if (numFloats <= 0)
+  {
+    return 1;
+  }
+  if (first <= 0 && last >= numFloats)
+  {
+    return this->ReadFloatArray(result, numFloats);
+  }
+
+  // The layout of the array is fully known, so we can seek directly to the
+  // needed values and past the end of the array.
+  vtkTypeInt64 begin = static_cast<vtkTypeInt64>(this->IFile->tellg());
+  if (this->Fortran)
+  {
+    begin += 4;
+  }
+  const vtkTypeInt64 end = begin + static_cast<vtkTypeInt64>(sizeof(float)) * numFloats;
+
+  if (first < last)
+  {
+    const int count = last - first;
+    this->IFile->seekg(begin + static_cast<vtkTypeInt64>(sizeof(float)) * first, ios::beg);
+    if (!this->IFile->read((char*)(result + first), sizeof(float) * count).good())
+    {
+      vtkErrorMacro("Read failed");
+      return 0;
+    }
+
+    if (this->ByteOrder == FILE_LITTLE_ENDIAN)
+    {
+      vtkByteSwap::Swap4LERange(result + first, count);
+    }
+    else
+    {
+      vtkByteSwap::Swap4BERange(result + first, count);
+    }
+  }
+
+  this->IFile->seekg(end + (this->Fortran ? 4 : 0), ios::beg);
+  if (!this->IFile->good())
+  {
+    vtkErrorMacro("Seek failed");
+    return 0;
+  }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkPEnSightGoldBinaryReader::ReadOrSkipCoordinates(
   vtkPoints* points, long offset, int partId, bool skip)
@@ -159,6 +159,15 @@ protected:
    */
   int ReadFloatArray(float* result, int numFloats);
 
+  /**
+   * Internal function to read in a float array of which only the values in
+   * [first, last) are needed by this process. Only that range is read from
+   * the file, the rest of the array is skipped. Values of result outside of
+   * the range are left untouched.
+   * Returns zero if there was an error.
+   */
+  int ReadFloatArray(float* result, int numFloats, int first, int last);
+
   /**
    * Read Coordinates, or just skip the part in the file.
    */
@@ -425,6 +425,69 @@ public:
       return result;
     }
 
+    // Compute the smallest range [first, last) of global ids, among the
+    // numberOfIds ids of the part, that contains all the ids owned by this
+    // process. first == last if this process does not own any of them.
+    void GetLocalIdRange(int numberOfIds, int& first, int& last)
+    {
+      first = 0;
+      last = numberOfIds;
+      switch (this->mode)
+      {
+        case SINGLE_PROCESS_MODE:
+        {
+          return;
+        }
+        case IMPLICIT_STRUCTURED_MODE:
+        {
+          if (this->ImplicitSplitDimension == -1 ||
+            this->ImplicitSplitDimensionBeginIndex >= this->ImplicitSplitDimensionEndIndex)
+          {
+            last = 0;
+            return;
+          }
+          // Ids owned by this process are the ones whose index along the split
+          // dimension lies in [Begin, End).
+          const int* dims = this->ImplicitDimensions;
+          int stride[3] = { 1, dims[0], dims[0] * dims[1] };
+          int maxIndex[3] = { dims[0] - 1, dims[1] - 1, dims[2] - 1 };
+          int dim = this->ImplicitSplitDimension;
+          maxIndex[dim] = this->ImplicitSplitDimensionEndIndex - 1;
+          first = this->ImplicitSplitDimensionBeginIndex * stride[dim];
+          last = maxIndex[0] * stride[0] + maxIndex[1] * stride[1] + maxIndex[2] * stride[2] + 1;
+          break;
+        }
+        case SPARSE_MODE:
+        {
+          if (this->cellMap->empty())
+          {
+            last = 0;
+            return;
+          }
+          first = this->cellMap->begin()->first;
+          last = this->cellMap->rbegin()->first + 1;
+          break;
+        }
+        default:
+        {
+          int size = static_cast<int>(this->cellVector->size());
+          first = 0;
+          while (first < size && (*this->cellVector)[first] == -1)
+          {
+            first++;
+          }
+          last = size;
+          while (last > first && (*this->cellVector)[last - 1] == -1)
+          {
+            last--;
+          }
+          break;
+        }
+      }
+      first = std::max(0, std::min(first, numberOfIds));
+      last = std::max(first, std::min(last, numberOfIds));
+    }
+
   protected:
     IntIntMap* cellMap;
     int cellNumberOfIds;
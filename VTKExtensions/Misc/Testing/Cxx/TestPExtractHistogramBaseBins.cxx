@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPExtractHistogram.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+
+#include <iostream>
+
+namespace
+{
+constexpr int BASE_BIN_COUNT = 57600;
+
+void SetupHistogram(vtkPExtractHistogram* histogram, vtkTable* input, int binCount)
+{
+  histogram->SetInputData(input);
+  histogram->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_ROWS, "values");
+  histogram->SetUseCustomBinRanges(true);
+  histogram->SetCustomBinRanges(0, 1000);
+  histogram->SetBaseBinCount(BASE_BIN_COUNT);
+  histogram->SetBinCount(binCount);
+}
+
+// Histogram computed by a new filter, with no kept bins.
+vtkSmartPointer<vtkTable> ComputeHistogram(vtkTable* input, int binCount)
+{
+  vtkNew<vtkPExtractHistogram> histogram;
+  SetupHistogram(histogram, input, binCount);
+  histogram->Update();
+  vtkSmartPointer<vtkTable> result = vtkSmartPointer<vtkTable>::New();
+  result->ShallowCopy(histogram->GetOutput());
+  return result;
+}
+
+// Compares the bins, reporting differences when a label is given.
+bool SameBins(vtkTable* result, vtkTable* expected, int binCount, const char* label = nullptr)
+{
+  for (const char* name : { "bin_extents", "bin_values" })
+  {
+    vtkDataArray* resultArray = vtkDataArray::SafeDownCast(result->GetColumnByName(name));
+    vtkDataArray* expectedArray = vtkDataArray::SafeDownCast(expected->GetColumnByName(name));
+    if (!resultArray || !expectedArray || resultArray->GetNumberOfTuples() != binCount ||
+      expectedArray->GetNumberOfTuples() != binCount)
+    {
+      if (label)
+      {
+        std::cerr << label << ": missing " << name << " or wrong number of bins for " << binCount
+                  << " bins" << std::endl;
+      }
+      return false;
+    }
+    for (vtkIdType bin = 0; bin < binCount; ++bin)
+    {
+      if (resultArray->GetTuple1(bin) != expectedArray->GetTuple1(bin))
+      {
+        if (label)
+        {
+          std::cerr << label << ": " << name << " differ at bin " << bin << " of " << binCount
+                    << ": " << resultArray->GetTuple1(bin)
+                    << " != " << expectedArray->GetTuple1(bin) << std::endl;
+        }
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+double Total(vtkTable* histogram)
+{
+  vtkDataArray* values = vtkDataArray::SafeDownCast(histogram->GetColumnByName("bin_values"));
+  double total = 0;
+  for (vtkIdType bin = 0; values && bin < values->GetNumberOfTuples(); ++bin)
+  {
+    total += values->GetTuple1(bin);
+  }
+  return total;
+}
+}
+
+extern int TestPExtractHistogramBaseBins(int, char*[])
+{
+  // Integers, many of them on the edges of the bins, and random values.
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("values");
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  for (int i = 0; i <= 1000; ++i)
+  {
+    values->InsertNextValue(i);
+  }
+  for (int i = 0; i < 20000; ++i)
+  {
+    values->InsertNextValue(random->GetNextRangeValue(0, 1000));
+  }
+  vtkNew<vtkTable> table;
+  table->AddColumn(values);
+
+  // Bin counts dividing BASE_BIN_COUNT, derived one after the other from the
+  // kept bins, match the histograms of filters computing them first.
+  const int binCounts[] = { 10, 256, 1, 3, 64, 100, 7200, BASE_BIN_COUNT };
+  vtkNew<vtkPExtractHistogram> histogram;
+  SetupHistogram(histogram, table, binCounts[0]);
+  for (int binCount : binCounts)
+  {
+    histogram->SetBinCount(binCount);
+    histogram->Update();
+    vtkSmartPointer<vtkTable> expected = ComputeHistogram(table, binCount);
+    if (!SameBins(histogram->GetOutput(), expected, binCount, "derived bins") ||
+      Total(expected) != values->GetNumberOfTuples())
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The kept bins are used as long as the input is not modified...
+  vtkSmartPointer<vtkTable> before = ComputeHistogram(table, 10);
+  for (vtkIdType i = 0; i < values->GetNumberOfTuples(); ++i)
+  {
+    values->SetValue(i, 1000 - values->GetValue(i) / 2);
+  }
+  histogram->SetBinCount(10);
+  histogram->Update();
+  if (!SameBins(histogram->GetOutput(), before, 10, "kept bins"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // ... and computed again once it is.
+  values->Modified();
+  for (int binCount : { 10, 64 })
+  {
+    histogram->SetBinCount(binCount);
+    histogram->Update();
+    vtkSmartPointer<vtkTable> expected = ComputeHistogram(table, binCount);
+    if (!SameBins(histogram->GetOutput(), expected, binCount, "modified input"))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  vtkSmartPointer<vtkTable> after = ComputeHistogram(table, 10);
+  if (SameBins(after, before, 10))
+  {
+    std::cerr << "Modifying the input did not change the histogram." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Bin counts that do not divide BASE_BIN_COUNT are computed directly.
+  histogram->SetBinCount(7);
+  histogram->Update();
+  vtkNew<vtkPExtractHistogram> direct;
+  SetupHistogram(direct, table, 7);
+  direct->SetBaseBinCount(0);
+  direct->Update();
+  if (!SameBins(histogram->GetOutput(), direct->GetOutput(), 7, "direct bins"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
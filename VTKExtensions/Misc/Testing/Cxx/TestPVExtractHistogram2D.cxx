@@ -1,8 +1,11 @@
 // SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include "vtkDataArray.h"
 #include "vtkElevationFilter.h"
+#include "vtkImageData.h"
 #include "vtkPVExtractHistogram2D.h"
+#include "vtkPointData.h"
 #include "vtkPointDataToCellData.h"
 #include "vtkSphereSource.h"
 
@@ -29,5 +32,19 @@ extern int TestPVExtractHistogram2D(int, char*[])
   histogram->SetNumberOfBins(10, 10);
   histogram->Update();
 
+  // Every cell must fall in exactly one bin
+  vtkDataArray* bins = histogram->GetOutput()->GetPointData()->GetScalars();
+  double total = 0.0;
+  for (vtkIdType i = 0; i < bins->GetNumberOfTuples(); ++i)
+  {
+    total += bins->GetTuple1(i);
+  }
+  if (total != static_cast<double>(pd2cd->GetOutput()->GetNumberOfCells()))
+  {
+    std::cerr << "Expected " << pd2cd->GetOutput()->GetNumberOfCells() << " binned values, got "
+              << total << std::endl;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
@@ -7,18 +7,25 @@
 #include "vtkCellData.h"
 #include "vtkCommunicator.h"
 #include "vtkDataArrayRange.h"
+#include "vtkDataSetAttributes.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <sstream>
 #include <string>
+#include <vector>
 #include <vtksys/RegularExpression.hxx>
 
 vtkStandardNewMacro(vtkPExtractHistogram);
@@ -28,6 +35,7 @@ vtkPExtractHistogram::vtkPExtractHistogram()
 {
   this->Controller = nullptr;
   this->SetController(vtkMultiProcessController::GetGlobalController());
+  this->BaseBinCount = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -60,10 +68,133 @@ bool vtkPExtractHistogram::GetInputArrayRange(vtkInformationVector** inputVector
   return true;
 }
 
+//-----------------------------------------------------------------------------
+void vtkPExtractHistogram::MergeBins(
+  vtkTable* input, int binCount, const char* binExtentsArrayName, vtkTable* output)
+{
+  const vtkIdType numberOfRows = input->GetNumberOfRows();
+  if (binCount <= 0 || numberOfRows == 0 || numberOfRows % binCount != 0)
+  {
+    output->ShallowCopy(input);
+    return;
+  }
+
+  const vtkIdType ratio = numberOfRows / binCount;
+  vtkNew<vtkTable> merged;
+  vtkDataSetAttributes* rowData = input->GetRowData();
+  for (int i = 0; i < rowData->GetNumberOfArrays(); i++)
+  {
+    vtkDataArray* array = rowData->GetArray(i);
+    if (array == nullptr)
+    {
+      continue;
+    }
+    const bool isExtents =
+      binExtentsArrayName && array->GetName() && strcmp(array->GetName(), binExtentsArrayName) == 0;
+    const int numComps = array->GetNumberOfComponents();
+    vtkSmartPointer<vtkDataArray> mergedArray;
+    mergedArray.TakeReference(array->NewInstance());
+    mergedArray->SetName(array->GetName());
+    mergedArray->SetNumberOfComponents(numComps);
+    mergedArray->SetNumberOfTuples(binCount);
+    for (vtkIdType bin = 0; bin < binCount; bin++)
+    {
+      const vtkIdType first = bin * ratio;
+      const vtkIdType last = first + ratio - 1;
+      for (int comp = 0; comp < numComps; comp++)
+      {
+        double value = 0;
+        if (isExtents)
+        {
+          value = 0.5 * (array->GetComponent(first, comp) + array->GetComponent(last, comp));
+        }
+        else
+        {
+          for (vtkIdType row = first; row <= last; row++)
+          {
+            value += array->GetComponent(row, comp);
+          }
+        }
+        mergedArray->SetComponent(bin, comp, value);
+      }
+    }
+    merged->AddColumn(mergedArray);
+  }
+  output->ShallowCopy(merged);
+}
+
+//-----------------------------------------------------------------------------
+std::string vtkPExtractHistogram::GetBaseBinsKey(vtkInformationVector** inputVector)
+{
+  // Modification times come from a global counter, so they also tell apart
+  // different input data objects and array selections.
+  vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
+  vtkInformation* arrayInfo = this->GetInputArrayInformation(0);
+  const char* extentsName = this->GetBinExtentsArrayName();
+  std::ostringstream key;
+  key.precision(17);
+  key << (input ? input->GetMTime() : 0) << ":" << (arrayInfo ? arrayInfo->GetMTime() : 0)
+      << ":" << this->Component << ":" << this->UseCustomBinRanges << ":"
+      << this->CustomBinRanges[0] << ":" << this->CustomBinRanges[1] << ":"
+      << this->BaseBinCount << ":" << (extentsName ? extentsName : "");
+  return key.str();
+}
+
+//-----------------------------------------------------------------------------
+int vtkPExtractHistogram::RequestDataFromBaseBins(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // All ranks must agree on whether the kept bins are reused, since computing
+  // them again involves collective range computations.
+  const std::string key = this->GetBaseBinsKey(inputVector);
+  int reuse = this->BaseBins && this->BaseBinsKey == key ? 1 : 0;
+  if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
+  {
+    int allReuse = 0;
+    if (!this->Controller->AllReduce(&reuse, &allReuse, 1, vtkCommunicator::MIN_OP))
+    {
+      vtkErrorMacro("Parallel communication error. Could not check the kept bins.");
+      return 0;
+    }
+    reuse = allReuse;
+  }
+
+  vtkTable* output = vtkTable::GetData(outputVector, 0);
+  if (!reuse)
+  {
+    this->BaseBins = nullptr;
+    this->BaseBinsKey.clear();
+    const int binCount = this->BinCount;
+    this->BinCount = this->BaseBinCount;
+    const int superRequestData = this->Superclass::RequestData(request, inputVector, outputVector);
+    this->BinCount = binCount;
+    if (superRequestData == 0)
+    {
+      return 0;
+    }
+    this->BaseBins = vtkSmartPointer<vtkTable>::New();
+    this->BaseBins->ShallowCopy(output);
+    this->BaseBinsKey = key;
+  }
+
+  vtkPExtractHistogram::MergeBins(
+    this->BaseBins, this->BinCount, this->GetBinExtentsArrayName(), output);
+  return 1;
+}
+
 //-----------------------------------------------------------------------------
 int vtkPExtractHistogram::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
+  const bool useBaseBins = this->BaseBinCount > 0 && this->BinCount > 0 &&
+    this->BaseBinCount % this->BinCount == 0 && !this->CalculateAverages &&
+    !this->CenterBinsAroundMinAndMax;
+  if (!useBaseBins)
+  {
+    this->BaseBins = nullptr;
+    this->BaseBinsKey.clear();
+  }
+
   // All processes generate the histogram.
   // However we want to avoid the super class to normalize/accumulate the results, hence temporarily
   // disable these functionalities.
@@ -72,7 +203,9 @@ int vtkPExtractHistogram::RequestData(
   bool tempAccumulation = this->Accumulation;
   this->Accumulation = false;
 
-  int superRequestData = this->Superclass::RequestData(request, inputVector, outputVector);
+  int superRequestData = useBaseBins
+    ? this->RequestDataFromBaseBins(request, inputVector, outputVector)
+    : this->Superclass::RequestData(request, inputVector, outputVector);
 
   this->Normalize = tempNormalize;
   this->Accumulation = tempAccumulation;
@@ -95,35 +228,101 @@ int vtkPExtractHistogram::RequestData(
       // Nothing to do if there is no data
       return 1;
     }
-    // Now we need to collect and reduce data from all nodes on the root.
-    vtkSmartPointer<vtkReductionFilter> reduceFilter = vtkSmartPointer<vtkReductionFilter>::New();
-    reduceFilter->SetController(this->Controller);
-
-    if (isRoot)
+    // All ranks binned over the same global range. When they also produced the same bin arrays,
+    // the arrays are packed and summed on the root with a single reduction. Otherwise the tables
+    // are gathered and reduced on the root.
+    vtkDataSetAttributes* rowData = output->GetRowData();
+    std::string layout;
+    for (int i = 0; i < rowData->GetNumberOfArrays(); i++)
+    {
+      vtkAbstractArray* array = rowData->GetAbstractArray(i);
+      layout += std::string(array->GetName() ? array->GetName() : "") + ":" +
+        std::to_string(array->GetDataType()) + ":" +
+        std::to_string(array->GetNumberOfComponents()) + ":" +
+        std::to_string(array->GetNumberOfTuples()) + ";";
+    }
+    // The maximum of the hash and of its complement give both the max and the min hash.
+    unsigned long long localLayout[2];
+    localLayout[0] = std::hash<std::string>{}(layout);
+    localLayout[1] = ~localLayout[0];
+    unsigned long long maxLayout[2] = { 0, 0 };
+    if (!this->Controller->AllReduce(localLayout, maxLayout, 2, vtkCommunicator::MAX_OP))
     {
-      // PostGatherHelper needs to be set only on the root node.
-      vtkSmartPointer<vtkAttributeDataReductionFilter> rf =
-        vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
-      rf->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
-      rf->SetReductionType(vtkAttributeDataReductionFilter::ADD);
-      reduceFilter->SetPostGatherHelper(rf);
+      vtkErrorMacro("Parallel communication error. Could not compare bins.");
+      return 0;
     }
 
-    vtkSmartPointer<vtkTable> copy = vtkSmartPointer<vtkTable>::New();
-    copy->ShallowCopy(output);
-    reduceFilter->SetInputData(copy);
-    reduceFilter->Update();
-    if (isRoot)
+    if (maxLayout[0] == ~maxLayout[1])
     {
-      // We save the old bin extents and then revert to be restored later since
-      // the reduction reduces the bin extents as well.
-      output->ShallowCopy(reduceFilter->GetOutput());
-      if (output->GetRowData()->GetNumberOfArrays() == 0)
+      // Counts and totals are packed as doubles, which is exact for counts up to 2^53.
+      std::vector<vtkDataArray*> binArrays;
+      std::vector<double> packed;
+      for (int i = 0; i < rowData->GetNumberOfArrays(); i++)
       {
-        vtkErrorMacro(<< "Reduced data has 0 arrays");
+        vtkDataArray* array = rowData->GetArray(i);
+        if (array == nullptr || array == oldExtents)
+        {
+          continue;
+        }
+        binArrays.push_back(array);
+        const auto values = vtk::DataArrayValueRange(array);
+        packed.insert(packed.end(), values.begin(), values.end());
+      }
+      std::vector<double> summed(packed.size());
+      if (!this->Controller->Reduce(packed.data(), summed.data(),
+            static_cast<vtkIdType>(packed.size()), vtkCommunicator::SUM_OP, 0))
+      {
+        vtkErrorMacro("Parallel communication error. Could not reduce bins.");
         return 0;
       }
-      output->GetRowData()->GetArray(this->BinExtentsArrayName)->DeepCopy(oldExtents);
+      if (isRoot)
+      {
+        auto next = summed.cbegin();
+        for (vtkDataArray* array : binArrays)
+        {
+          auto values = vtk::DataArrayValueRange(array);
+          std::copy(next, next + values.size(), values.begin());
+          next += values.size();
+          array->Modified();
+        }
+      }
+    }
+    else
+    {
+      vtkSmartPointer<vtkReductionFilter> reduceFilter =
+        vtkSmartPointer<vtkReductionFilter>::New();
+      reduceFilter->SetController(this->Controller);
+
+      if (isRoot)
+      {
+        // PostGatherHelper needs to be set only on the root node.
+        vtkSmartPointer<vtkAttributeDataReductionFilter> rf =
+          vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
+        rf->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
+        rf->SetReductionType(vtkAttributeDataReductionFilter::ADD);
+        reduceFilter->SetPostGatherHelper(rf);
+      }
+
+      vtkSmartPointer<vtkTable> copy = vtkSmartPointer<vtkTable>::New();
+      copy->ShallowCopy(output);
+      reduceFilter->SetInputData(copy);
+      reduceFilter->Update();
+      if (isRoot)
+      {
+        // We save the old bin extents and then revert to be restored later since
+        // the reduction reduces the bin extents as well.
+        output->ShallowCopy(reduceFilter->GetOutput());
+        if (output->GetRowData()->GetNumberOfArrays() == 0)
+        {
+          vtkErrorMacro(<< "Reduced data has 0 arrays");
+          return 0;
+        }
+        output->GetRowData()->GetArray(this->BinExtentsArrayName)->DeepCopy(oldExtents);
+      }
+    }
+
+    if (isRoot)
+    {
       if (this->CalculateAverages)
       {
         vtkDataArray* bin_values = output->GetRowData()->GetArray(this->BinValuesArrayName);
@@ -175,4 +374,5 @@ void vtkPExtractHistogram::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "BaseBinCount: " << this->BaseBinCount << endl;
 }
@@ -7,6 +7,10 @@
  *
  * vtkPExtractHistogram is vtkExtractHistogram subclass for parallel datasets.
  * It gathers the histogram data on the root node.
+ *
+ * When BaseBinCount is set, the histogram is derived from a finer histogram
+ * that each rank keeps, so that changing BinCount does not go through the
+ * input again.
  */
 
 #ifndef vtkPExtractHistogram_h
@@ -14,8 +18,12 @@
 
 #include "vtkExtractHistogram.h"
 #include "vtkPVVTKExtensionsMiscModule.h" //needed for exports
+#include "vtkSmartPointer.h"              // for vtkSmartPointer
+
+#include <string> // for std::string
 
 class vtkMultiProcessController;
+class vtkTable;
 
 class VTKPVVTKEXTENSIONSMISC_EXPORT vtkPExtractHistogram : public vtkExtractHistogram
 {
@@ -33,6 +41,36 @@ public:
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   ///@}
 
+  ///@{
+  /**
+   * When positive and a multiple of BinCount, the histogram is computed with
+   * BaseBinCount bins, which every rank keeps, and consecutive bins are summed
+   * to give BinCount bins. When only BinCount changes, to another divisor of
+   * BaseBinCount, the histogram is then derived from the kept bins without
+   * going through the input or computing its range again. The kept bins are
+   * recomputed when the input, the input array, the component or the bin range
+   * change.
+   *
+   * The histograms derived for every divisor are consistent with each other,
+   * but a value within rounding error of a bin edge may land in a neighboring
+   * bin compared with a histogram computed with BinCount bins directly.
+   * BaseBinCount is not used with CalculateAverages or
+   * CenterBinsAroundMinAndMax. Default is 0, which computes BinCount bins
+   * directly.
+   */
+  vtkSetClampMacro(BaseBinCount, int, 0, VTK_INT_MAX);
+  vtkGetMacro(BaseBinCount, int);
+  ///@}
+
+  /**
+   * Sums consecutive rows of the histogram table `input` so that `output` has
+   * `binCount` rows. The array named `binExtentsArrayName` holds bin centers,
+   * which are averaged instead. When `input` is empty or its number of rows is
+   * not a multiple of `binCount`, `output` is a shallow copy of `input`.
+   */
+  static void MergeBins(
+    vtkTable* input, int binCount, const char* binExtentsArrayName, vtkTable* output);
+
 protected:
   vtkPExtractHistogram();
   ~vtkPExtractHistogram() override;
@@ -46,7 +84,22 @@ protected:
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  /**
+   * Computes the histogram in `outputVector` from the kept BaseBinCount bins,
+   * computing them first if needed. All ranks must call it.
+   */
+  int RequestDataFromBaseBins(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector);
+
+  /**
+   * Returns what the kept bins depend on, besides BinCount.
+   */
+  std::string GetBaseBinsKey(vtkInformationVector** inputVector);
+
   vtkMultiProcessController* Controller;
+  int BaseBinCount;
+  vtkSmartPointer<vtkTable> BaseBins;
+  std::string BaseBinsKey;
 
 private:
   vtkPExtractHistogram(const vtkPExtractHistogram&) = delete;
@@ -4,6 +4,7 @@
 #include "vtkPVExtractHistogram2D.h"
 
 // VTK includes
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkDataArray.h"
 #include "vtkDataArrayRange.h"
@@ -19,10 +20,104 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------------------------
+// Bins the tuples of the two component arrays. Each thread fills its own histogram and the
+// histograms are summed into the output in Reduce().
+template <typename Array1T, typename Array2T>
+struct Histogram2DFunctor
+{
+  Array1T* Array1;
+  Array2T* Array2;
+  int Components[2];
+  int NumberOfBins[2];
+  double Ranges[2][2];
+  vtkUnsignedCharArray* GhostArray;
+  unsigned char GhostsToSkip;
+  vtkDataArray* HistArray;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> LocalHistogram;
+
+  void Initialize()
+  {
+    this->LocalHistogram.Local().assign(
+      static_cast<size_t>(this->NumberOfBins[0]) * this->NumberOfBins[1], 0);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const auto arr1Range = vtk::DataArrayTupleRange(this->Array1, begin, end);
+    const auto arr2Range = vtk::DataArrayTupleRange(this->Array2, begin, end);
+    const unsigned char* ghosts = this->GhostArray ? this->GhostArray->GetPointer(begin) : nullptr;
+    std::vector<vtkIdType>& histogram = this->LocalHistogram.Local();
+
+    for (vtk::TupleIdType tupleId = 0; tupleId < end - begin; ++tupleId)
+    {
+      if (ghosts && (ghosts[tupleId] & this->GhostsToSkip))
+      {
+        continue;
+      }
+      const auto a1 = arr1Range[tupleId][this->Components[0]];
+      vtkIdType bin1 = static_cast<vtkIdType>((a1 - this->Ranges[0][0]) *
+        (this->NumberOfBins[0] - 1) / (this->Ranges[0][1] - this->Ranges[0][0]));
+      bin1 = bin1 >= this->NumberOfBins[0] ? this->NumberOfBins[0] - 1 : bin1;
+      bin1 = bin1 < 0 ? 0 : bin1;
+      const auto a2 = arr2Range[tupleId][this->Components[1]];
+      vtkIdType bin2 = static_cast<vtkIdType>((a2 - this->Ranges[1][0]) *
+        (this->NumberOfBins[1] - 1) / (this->Ranges[1][1] - this->Ranges[1][0]));
+      bin2 = bin2 >= this->NumberOfBins[1] ? this->NumberOfBins[1] - 1 : bin2;
+      bin2 = bin2 < 0 ? 0 : bin2;
+      histogram[bin2 * this->NumberOfBins[0] + bin1]++;
+    }
+  }
+
+  void Reduce()
+  {
+    auto histRange = vtk::DataArrayValueRange<1>(this->HistArray);
+    for (const std::vector<vtkIdType>& histogram : this->LocalHistogram)
+    {
+      for (size_t histIndex = 0; histIndex < histogram.size(); ++histIndex)
+      {
+        histRange[histIndex] += histogram[histIndex];
+      }
+    }
+  }
+};
+
+//------------------------------------------------------------------------------------------------
+struct Histogram2DWorker
+{
+  template <typename Array1T, typename Array2T>
+  void operator()(Array1T* array1, Array2T* array2, const int components[2],
+    const int numberOfBins[2], double ranges[2][2], vtkUnsignedCharArray* ghostArray,
+    unsigned char ghostsToSkip, vtkDataArray* histArray)
+  {
+    Histogram2DFunctor<Array1T, Array2T> functor;
+    functor.Array1 = array1;
+    functor.Array2 = array2;
+    for (int i = 0; i < 2; ++i)
+    {
+      functor.Components[i] = components[i];
+      functor.NumberOfBins[i] = numberOfBins[i];
+      functor.Ranges[i][0] = ranges[i][0];
+      functor.Ranges[i][1] = ranges[i][1];
+    }
+    functor.GhostArray = ghostArray;
+    functor.GhostsToSkip = ghostsToSkip;
+    functor.HistArray = histArray;
+    vtkSMPTools::For(0, array1->GetNumberOfTuples(), functor);
+  }
+};
+}
+
 vtkStandardNewMacro(vtkPVExtractHistogram2D);
 vtkCxxSetObjectMacro(vtkPVExtractHistogram2D, Controller, vtkMultiProcessController);
 
@@ -367,35 +462,25 @@ void vtkPVExtractHistogram2D::ComputeHistogram2D(vtkImageData* histogram)
   auto histArray = histogram->GetPointData()->GetScalars();
   histArray->FillComponent(0, 0);
 
-  const auto arr1Range = vtk::DataArrayTupleRange(this->ComponentArrayCache[0]);
-  const auto arr2Range = vtk::DataArrayTupleRange(this->ComponentArrayCache[1]);
-  auto histRange = vtk::DataArrayValueRange(histArray);
-
-  const vtk::TupleIdType numTuples = arr1Range.size();
-  if (arr2Range.size() != numTuples)
+  if (this->ComponentArrayCache[1]->GetNumberOfTuples() !=
+    this->ComponentArrayCache[0]->GetNumberOfTuples())
   {
     vtkErrorMacro("<< Both arrays should be the same size");
     return;
   }
 
-  for (vtk::TupleIdType tupleId = 0; tupleId < numTuples; ++tupleId)
+  // Arrays of any value type are binned through the fast path, others (e.g. implicit arrays)
+  // through the vtkDataArray API.
+  using Dispatcher =
+    vtkArrayDispatch::Dispatch2ByValueType<vtkArrayDispatch::AllTypes, vtkArrayDispatch::AllTypes>;
+  Histogram2DWorker worker;
+  if (!Dispatcher::Execute(this->ComponentArrayCache[0], this->ComponentArrayCache[1], worker,
+        this->ComponentIndexCache, this->NumberOfBins, this->ComponentRangeCache,
+        this->GhostArray, this->GhostsToSkip, histArray))
   {
-    const auto a1 = arr1Range[tupleId][this->ComponentIndexCache[0]];
-    vtkIdType bin1 =
-      static_cast<vtkIdType>((a1 - this->ComponentRangeCache[0][0]) * (this->NumberOfBins[0] - 1) /
-        (this->ComponentRangeCache[0][1] - this->ComponentRangeCache[0][0]));
-    bin1 = bin1 >= this->NumberOfBins[0] ? this->NumberOfBins[0] - 1 : bin1;
-    const auto a2 = arr2Range[tupleId][this->ComponentIndexCache[1]];
-    vtkIdType bin2 =
-      static_cast<vtkIdType>((a2 - this->ComponentRangeCache[1][0]) * (this->NumberOfBins[1] - 1) /
-        (this->ComponentRangeCache[1][1] - this->ComponentRangeCache[1][0]));
-    bin2 = bin2 >= this->NumberOfBins[1] ? this->NumberOfBins[1] - 1 : bin2;
-    vtkIdType histIndex = bin2 * this->NumberOfBins[0] + bin1;
-
-    if (!this->GhostArray || !(this->GhostArray->GetValue(tupleId) & this->GhostsToSkip))
-    {
-      histRange[histIndex]++;
-    }
+    worker(this->ComponentArrayCache[0], this->ComponentArrayCache[1], this->ComponentIndexCache,
+      this->NumberOfBins, this->ComponentRangeCache, this->GhostArray, this->GhostsToSkip,
+      histArray);
   }
 }
 
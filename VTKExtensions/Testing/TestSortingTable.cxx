@@ -13,8 +13,10 @@
 #include "vtkTestUtilities.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <iostream>
+#include <vector>
 
 // ----------------------------------------------------------------------------
 void fillArray(vtkDoubleArray* array, double* dataPointer, int dataSize, const char* name)
@@ -155,6 +157,56 @@ int sortMagnitudeOnUnsignedCharVector()
   return EXIT_SUCCESS;
 }
 
+// ----------------------------------------------------------------------------
+int sortByBlocks(bool debug)
+{
+  const int size = 5000;
+  const int blockSize = 128;
+  std::vector<double> dataArray(size);
+  for (int i = 0; i < size; i++)
+  {
+    dataArray[i] = (i * 7919) % 613; // Many repeated values
+  }
+  std::vector<double> sortedArray(dataArray);
+  std::sort(sortedArray.begin(), sortedArray.end());
+
+  vtkSmartPointer<vtkDoubleArray> dataToSort = vtkSmartPointer<vtkDoubleArray>::New();
+  fillArray(dataToSort.GetPointer(), dataArray.data(), size, "data");
+
+  vtkSmartPointer<vtkTable> input = vtkSmartPointer<vtkTable>::New();
+  input->AddColumn(dataToSort);
+
+  vtkSmartPointer<vtkSortedTableStreamer> sortingfilter =
+    vtkSmartPointer<vtkSortedTableStreamer>::New();
+  sortingfilter->SetInputData(input.GetPointer());
+  sortingfilter->SetSelectedComponent(0);
+  sortingfilter->SetColumnNameToSort("data");
+  sortingfilter->SetBlockSize(blockSize);
+
+  for (int invert = 0; invert < 2; invert++)
+  {
+    if (invert)
+    {
+      std::reverse(sortedArray.begin(), sortedArray.end());
+    }
+    sortingfilter->SetInvertOrder(invert);
+    for (int block = 0; block * blockSize < size; block++)
+    {
+      sortingfilter->SetBlock(block);
+      sortingfilter->Update();
+      const int expectedSize = std::min(blockSize, size - block * blockSize);
+      if (!compareArray(sortingfilter->GetOutput(), "data",
+            sortedArray.data() + block * blockSize, expectedSize, debug))
+      {
+        std::cout << "Invalid block " << block << (invert ? " (inverted)" : "") << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
 // ----------------------------------------------------------------------------
 int TestSortingTable(int vtkNotUsed(argc), char** vtkNotUsed(argv))
 {
@@ -174,6 +226,9 @@ int TestSortingTable(int vtkNotUsed(argc), char** vtkNotUsed(argv))
   std::cout << "Testing sorting with magnitude on unsigned char: "
             << ((result += sortMagnitudeOnUnsignedCharVector()) ? "FAILED" : "SUCCESS") << endl;
   // --------------------------------------------------------------------------
+  std::cout << "Testing sorting by blocks: "
+            << ((result += sortByBlocks(debug)) ? "FAILED" : "SUCCESS") << endl;
+  // --------------------------------------------------------------------------
   // --------------------------------------------------------------------------
 
   // Delete Fake MPI controller
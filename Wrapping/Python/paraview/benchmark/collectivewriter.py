@@ -0,0 +1,88 @@
+'''
+Collective writer benchmark: times writing a distributed unstructured grid
+with the parallel legacy VTK writer, either one file per IO rank or a single
+VTK XML file written collectively with MPI-IO, for several numbers of IO ranks.
+
+Run it with pvbatch on a varying number of MPI ranks, or import
+collectivewriter from paraview.benchmark and call its run method.
+'''
+
+from __future__ import print_function
+import datetime as dt
+from paraview.simple import *
+from paraview import servermanager
+import paraview
+import os
+
+
+def run(filename=None, directory='.', ioranks=(1, 2, 4), extent=100, repeat=5):
+    '''Runs the benchmark. If a filename is specified, it will write the
+    results to that file as csv. The files are written to `directory` and
+    removed afterwards. Each configuration writes the data `repeat` times and
+    the average time is reported. A number of IO ranks of 0 makes every rank an
+    IO rank.
+    '''
+    paraview.servermanager.SetProgressPrintingEnabled(0)
+
+    wavelet = Wavelet()
+    wavelet.WholeExtent = [-extent, extent, -extent, extent, -extent, extent]
+    grid = Tetrahedralize(Input=wavelet)
+    grid.UpdatePipeline()
+
+    pm = servermanager.vtkProcessModule.GetProcessModule()
+    ranks = pm.GetNumberOfLocalPartitions()
+    fname = os.path.join(directory, 'collectivewriter.vtk')
+
+    results = []
+    for numIORanks in ioranks:
+        for collective in (0, 1):
+            writer = servermanager.writers.PDataSetWriterUnstructuredGrid(
+                Input=grid, FileName=fname)
+            writer.FileType = 'Binary'
+            writer.CollectiveIO = collective
+            writer.NumberOfIORanks = numIORanks
+            t0 = dt.datetime.now()
+            for i in range(repeat):
+                writer.UpdatePipeline()
+            elapsed = (dt.datetime.now() - t0).total_seconds() / repeat
+            del writer
+            print('ranks %5d io-ranks %5d collective %d %10.6f s' %
+                  (ranks, numIORanks, collective, elapsed))
+            results.append((ranks, numIORanks, collective, elapsed))
+
+    for f in os.listdir(directory):
+        if f.startswith('collectivewriter'):
+            os.remove(os.path.join(directory, f))
+
+    if filename:
+        with open(filename, 'w') as ofile:
+            ofile.write('ranks,ioranks,collective,seconds\n')
+            for r in results:
+                ofile.write('%d,%d,%d,%f\n' % r)
+    return results
+
+
+def main(argv):
+    import argparse
+    parser = argparse.ArgumentParser(
+        description='Benchmark the collective mode of the parallel legacy VTK writer')
+    parser.add_argument('-o', '--output', default=None, type=str,
+                        help='CSV file to write the timings to')
+    parser.add_argument('-d', '--directory', default='.', type=str,
+                        help='Directory to write the data files into')
+    parser.add_argument('-i', '--ioranks', default=[1, 2, 4], type=int, nargs='+',
+                        help='Numbers of IO ranks to time, 0 uses all ranks')
+    parser.add_argument('-e', '--extent', default=100, type=int,
+                        help='Half extent of the wavelet along each axis')
+    parser.add_argument('-r', '--repeat', default=5, type=int,
+                        help='Number of writes per configuration')
+
+    args = parser.parse_args(argv)
+    run(filename=args.output, directory=args.directory, ioranks=args.ioranks,
+        extent=args.extent, repeat=args.repeat)
+
+
+if __name__ == "__main__":
+    import sys
+
+    main(sys.argv[1:])
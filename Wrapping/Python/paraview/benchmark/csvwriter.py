@@ -0,0 +1,84 @@
+'''
+CSV writer benchmark: times writing the point data of a wavelet to a CSV file
+in the default mode and in StreamingMode, and reports the throughput in rows
+per second.
+
+Run it with pvpython or pvbatch on a varying number of MPI ranks, or import
+csvwriter from paraview.benchmark and call its run method.
+'''
+
+from __future__ import print_function
+import datetime as dt
+from paraview.simple import *
+from paraview import servermanager
+import paraview
+import os
+
+
+def run(filename=None, directory='.', extent=100, repeat=5):
+    '''Runs the benchmark. If a filename is specified, it will write the
+    results to that file as csv. The CSV files are written to `directory` and
+    removed afterwards. Each mode writes the data `repeat` times and the
+    average time is reported.
+    '''
+    paraview.servermanager.SetProgressPrintingEnabled(0)
+
+    wavelet = Wavelet()
+    wavelet.WholeExtent = [-extent, extent, -extent, extent, -extent, extent]
+    # A few more columns, of several types, than the RTData scalars.
+    gradient = Gradient(Input=wavelet)
+    ids = PointAndCellIds(Input=gradient)
+    ids.UpdatePipeline()
+
+    pm = servermanager.vtkProcessModule.GetProcessModule()
+    ranks = pm.GetNumberOfLocalPartitions()
+    rows = ids.GetDataInformation().GetNumberOfPoints()
+    fname = os.path.join(directory, 'csvwriter.csv')
+
+    results = []
+    for streaming in (0, 1):
+        writer = servermanager.writers.CSVWriter(Input=ids, FileName=fname)
+        writer.FieldAssociation = 'Point Data'
+        writer.StreamingMode = streaming
+        t0 = dt.datetime.now()
+        for i in range(repeat):
+            writer.UpdatePipeline()
+        elapsed = (dt.datetime.now() - t0).total_seconds() / repeat
+        del writer
+        print('ranks %5d streaming %d rows %10d %10.6f s %12.0f rows/s' %
+              (ranks, streaming, rows, elapsed, rows / elapsed))
+        results.append((ranks, streaming, rows, elapsed, rows / elapsed))
+
+    if os.path.exists(fname):
+        os.remove(fname)
+
+    if filename:
+        with open(filename, 'w') as ofile:
+            ofile.write('ranks,streaming,rows,seconds,rows_per_second\n')
+            for r in results:
+                ofile.write('%d,%d,%d,%f,%f\n' % r)
+    return results
+
+
+def main(argv):
+    import argparse
+    parser = argparse.ArgumentParser(
+        description='Benchmark the streaming mode of the CSV writer')
+    parser.add_argument('-o', '--output', default=None, type=str,
+                        help='CSV file to write the timings to')
+    parser.add_argument('-d', '--directory', default='.', type=str,
+                        help='Directory to write the data files into')
+    parser.add_argument('-e', '--extent', default=100, type=int,
+                        help='Half extent of the wavelet along each axis')
+    parser.add_argument('-r', '--repeat', default=5, type=int,
+                        help='Number of writes per mode')
+
+    args = parser.parse_args(argv)
+    run(filename=args.output, directory=args.directory, extent=args.extent,
+        repeat=args.repeat)
+
+
+if __name__ == "__main__":
+    import sys
+
+    main(sys.argv[1:])
@@ -0,0 +1,100 @@
+'''
+Equivalence set benchmark: times adding a large batch of equivalences to a
+vtkEquivalenceSet, as done by the connectivity and material interface
+filters, and resolving the set, for several numbers of threads.
+
+Run it with pvpython, or import equivalenceset from paraview.benchmark and
+call its run method.
+'''
+
+from __future__ import print_function
+import datetime as dt
+
+
+def __make_pairs(members, pairs, pattern, seed):
+    import numpy
+    from vtkmodules.util import numpy_support
+
+    rng = numpy.random.RandomState(seed)
+    ids1 = rng.randint(0, members, size=pairs).astype(numpy.int32)
+    if pattern == 'chain':
+        # Links every member to the next one, which builds the deepest trees.
+        ids2 = numpy.minimum(ids1 + 1, members - 1).astype(numpy.int32)
+    else:
+        ids2 = rng.randint(0, members, size=pairs).astype(numpy.int32)
+    return (numpy_support.numpy_to_vtk(ids1, deep=1),
+            numpy_support.numpy_to_vtk(ids2, deep=1))
+
+
+def run(filename=None, members=10**8, pairs=10**8, threads=(1, 2, 4, 8),
+        pattern='random', seed=0):
+    '''Runs the benchmark. If a filename is specified, it will write the
+    results to that file as csv. The same `pairs` random equivalences between
+    `members` ids are added for each number of threads. With the 'chain'
+    pattern every pair links an id to the next one.
+    '''
+    from paraview.modules.vtkPVVTKExtensionsFiltersGeneral import vtkEquivalenceSet
+    from vtkmodules.vtkCommonCore import vtkSMPTools
+
+    ids1, ids2 = __make_pairs(members, pairs, pattern, seed)
+
+    results = []
+    resolved = None
+    for numThreads in threads:
+        vtkSMPTools.Initialize(numThreads)
+        eqset = vtkEquivalenceSet()
+
+        t0 = dt.datetime.now()
+        eqset.AddEquivalences(ids1, ids2)
+        addTime = (dt.datetime.now() - t0).total_seconds()
+
+        t0 = dt.datetime.now()
+        numSets = eqset.ResolveEquivalences()
+        resolveTime = (dt.datetime.now() - t0).total_seconds()
+
+        # The resolved ids do not depend on the number of threads.
+        if resolved is None:
+            resolved = numSets
+        elif resolved != numSets:
+            raise RuntimeError('%d threads resolved %d sets instead of %d' %
+                               (numThreads, numSets, resolved))
+        del eqset
+
+        print('threads %3d pairs %d add %10.6f s resolve %10.6f s sets %d' %
+              (numThreads, pairs, addTime, resolveTime, numSets))
+        results.append((numThreads, members, pairs, addTime, resolveTime, numSets))
+
+    if filename:
+        with open(filename, 'w') as ofile:
+            ofile.write('threads,members,pairs,add_seconds,resolve_seconds,sets\n')
+            for r in results:
+                ofile.write('%d,%d,%d,%f,%f,%d\n' % r)
+    return results
+
+
+def main(argv):
+    import argparse
+    parser = argparse.ArgumentParser(
+        description='Benchmark adding and resolving equivalences in vtkEquivalenceSet')
+    parser.add_argument('-o', '--output', default=None, type=str,
+                        help='CSV file to write the timings to')
+    parser.add_argument('-m', '--members', default=10**8, type=int,
+                        help='Number of ids in the set')
+    parser.add_argument('-p', '--pairs', default=10**8, type=int,
+                        help='Number of equivalences to add')
+    parser.add_argument('-t', '--threads', default=[1, 2, 4, 8], type=int, nargs='+',
+                        help='Numbers of threads to time')
+    parser.add_argument('--pattern', default='random', choices=['random', 'chain'],
+                        help='How the pairs of equivalent ids are chosen')
+    parser.add_argument('-s', '--seed', default=0, type=int,
+                        help='Seed of the random pairs')
+
+    args = parser.parse_args(argv)
+    run(filename=args.output, members=args.members, pairs=args.pairs,
+        threads=args.threads, pattern=args.pattern, seed=args.seed)
+
+
+if __name__ == "__main__":
+    import sys
+
+    main(sys.argv[1:])
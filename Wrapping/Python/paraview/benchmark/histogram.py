@@ -0,0 +1,135 @@
+'''
+Histogram benchmark: times binning two random point arrays with
+vtkPVExtractHistogram2D, vtkExtractScatterPlot and vtkPExtractHistogram,
+for several numbers of threads, and checks the bins do not depend on the
+number of threads.
+
+Run it with pvpython, or import histogram from paraview.benchmark and call
+its run method.
+'''
+
+from __future__ import print_function
+import datetime as dt
+
+
+def __make_input(dimension, seed):
+    import numpy
+    from vtkmodules.util import numpy_support
+    from vtkmodules.vtkCommonDataModel import vtkImageData
+
+    image = vtkImageData()
+    image.SetDimensions(dimension, dimension, dimension)
+    rng = numpy.random.RandomState(seed)
+    npoints = image.GetNumberOfPoints()
+    # a float array and an int array, to time both kinds of value types
+    a = numpy_support.numpy_to_vtk(rng.normal(size=npoints).astype(numpy.float32), deep=1)
+    a.SetName('a')
+    b = numpy_support.numpy_to_vtk(rng.randint(0, 1000, size=npoints).astype(numpy.int32), deep=1)
+    b.SetName('b')
+    image.GetPointData().AddArray(a)
+    image.GetPointData().AddArray(b)
+    return image
+
+
+def __make_filters(bins):
+    from paraview.modules.vtkPVVTKExtensionsFiltersGeneral import vtkExtractScatterPlot
+    from paraview.modules.vtkPVVTKExtensionsMisc import vtkPExtractHistogram
+    from paraview.modules.vtkPVVTKExtensionsMisc import vtkPVExtractHistogram2D
+    from vtkmodules.vtkCommonDataModel import vtkDataObject
+
+    points = vtkDataObject.FIELD_ASSOCIATION_POINTS
+
+    histogram2d = vtkPVExtractHistogram2D()
+    histogram2d.SetInputArrayToProcess(0, 0, 0, points, 'a')
+    histogram2d.SetInputArrayToProcess(1, 0, 0, points, 'b')
+    histogram2d.SetNumberOfBins(bins, bins)
+
+    scatterplot = vtkExtractScatterPlot()
+    scatterplot.SetInputArrayToProcess(0, 0, 0, points, 'a')
+    scatterplot.SetInputArrayToProcess(1, 0, 0, points, 'b')
+    scatterplot.SetXBinCount(bins)
+    scatterplot.SetYBinCount(bins)
+
+    histogram = vtkPExtractHistogram()
+    histogram.SetInputArrayToProcess(0, 0, 0, points, 'a')
+    histogram.SetBinCount(bins)
+
+    return [('histogram2d', histogram2d, lambda f: f.GetOutput().GetPointData().GetScalars()),
+            ('scatterplot', scatterplot,
+             lambda f: f.GetOutput().GetCellData().GetArray('bin_values')),
+            ('histogram', histogram,
+             lambda f: f.GetOutput().GetRowData().GetArray('bin_values'))]
+
+
+def run(filename=None, dimension=200, bins=256, threads=(1, 2, 4, 8, 16, 32, 64),
+        repeat=3, seed=0):
+    '''Runs the benchmark. If a filename is specified, it will write the
+    results to that file as csv. Each filter bins the same `dimension`^3
+    values `repeat` times for each number of threads, and the best time is
+    reported.
+    '''
+    from vtkmodules.util import numpy_support
+    from vtkmodules.vtkCommonCore import vtkSMPTools
+
+    image = __make_input(dimension, seed)
+    ntuples = image.GetNumberOfPoints()
+
+    results = []
+    for name, algorithm, get_bins in __make_filters(bins):
+        algorithm.SetInputData(image)
+        expected = None
+        for numThreads in threads:
+            vtkSMPTools.Initialize(numThreads)
+            best = None
+            for i in range(repeat):
+                algorithm.Modified()
+                t0 = dt.datetime.now()
+                algorithm.Update()
+                elapsed = (dt.datetime.now() - t0).total_seconds()
+                best = elapsed if best is None else min(best, elapsed)
+
+            # The bins do not depend on the number of threads.
+            actual = numpy_support.vtk_to_numpy(get_bins(algorithm)).copy()
+            if expected is None:
+                expected = actual
+            elif not (expected == actual).all():
+                raise RuntimeError('%s: %d threads gave different bins' % (name, numThreads))
+
+            print('%-12s threads %3d tuples %d %10.6f s %8.2f Mtuples/s' %
+                  (name, numThreads, ntuples, best, ntuples / best / 1e6))
+            results.append((name, numThreads, ntuples, bins, best))
+
+    if filename:
+        with open(filename, 'w') as ofile:
+            ofile.write('filter,threads,tuples,bins,seconds\n')
+            for r in results:
+                ofile.write('%s,%d,%d,%d,%f\n' % r)
+    return results
+
+
+def main(argv):
+    import argparse
+    parser = argparse.ArgumentParser(
+        description='Benchmark histogram and scatter plot binning')
+    parser.add_argument('-o', '--output', default=None, type=str,
+                        help='CSV file to write the timings to')
+    parser.add_argument('-d', '--dimension', default=200, type=int,
+                        help='The dimension of each side of the cubic volume')
+    parser.add_argument('-b', '--bins', default=256, type=int,
+                        help='Number of bins along each axis')
+    parser.add_argument('-t', '--threads', default=[1, 2, 4, 8, 16, 32, 64], type=int,
+                        nargs='+', help='Numbers of threads to time')
+    parser.add_argument('-r', '--repeat', default=3, type=int,
+                        help='Number of runs per number of threads')
+    parser.add_argument('-s', '--seed', default=0, type=int,
+                        help='Seed of the random values')
+
+    args = parser.parse_args(argv)
+    run(filename=args.output, dimension=args.dimension, bins=args.bins,
+        threads=args.threads, repeat=args.repeat, seed=args.seed)
+
+
+if __name__ == "__main__":
+    import sys
+
+    main(sys.argv[1:])
@@ -0,0 +1,93 @@
+'''
+Information reduction benchmark: times gathering data information from all
+the ranks of a data server, either by gathering every rank's information on
+the root or with the tree-based reduction of vtkPVSessionCore for several
+fan-outs, and checks that all of them give the same result.
+
+Run it with pvbatch on a varying number of MPI ranks to measure how each
+strategy scales, or import informationreduction from paraview.benchmark and
+call its run method.
+'''
+
+from __future__ import print_function
+import datetime as dt
+from paraview.simple import *
+from paraview import servermanager
+import paraview
+
+
+def __gather(session, proxy, fanOut):
+    from paraview.modules.vtkRemotingCore import vtkPVDataInformation
+    session.GetSessionCore().SetInformationReductionFanOut(fanOut)
+    info = vtkPVDataInformation()
+    info.SetPortNumber(0)
+    session.GatherInformation(servermanager.vtkPVSession.DATA_SERVER, info, proxy.GetGlobalID())
+    return info
+
+
+def __summary(info):
+    return (info.GetNumberOfPoints(), info.GetNumberOfCells(), info.GetNumberOfDataSets(),
+            tuple(info.GetBounds()))
+
+
+def run(filename=None, fanouts=(0, 2, 4, 8), blocks=12, repeat=20):
+    '''Runs the benchmark. If a filename is specified, it will write the
+    results to that file as csv. A fan-out of 0 gathers every rank's
+    information on the root. Each strategy gathers the information `repeat`
+    times and the average time is reported.
+    '''
+    paraview.servermanager.SetProgressPrintingEnabled(0)
+
+    source = PartitionedDataSetCollectionSource(NumberOfShapes=blocks)
+    data = ProcessIds(Input=source)
+    data.UpdatePipeline()
+
+    session = servermanager.ActiveConnection.Session
+    pm = servermanager.vtkProcessModule.GetProcessModule()
+    ranks = pm.GetNumberOfLocalPartitions()
+    previous = session.GetSessionCore().GetInformationReductionFanOut()
+
+    results = []
+    expected = None
+    for fanOut in fanouts:
+        t0 = dt.datetime.now()
+        for i in range(repeat):
+            info = __gather(session, data, fanOut)
+        elapsed = (dt.datetime.now() - t0).total_seconds() / repeat
+        if expected is None:
+            expected = __summary(info)
+        elif __summary(info) != expected:
+            raise RuntimeError('Mismatched information for fan-out %d' % fanOut)
+        print('ranks %5d fan-out %3d %10.6f s' % (ranks, fanOut, elapsed))
+        results.append((ranks, fanOut, elapsed))
+
+    session.GetSessionCore().SetInformationReductionFanOut(previous)
+    if filename:
+        with open(filename, 'w') as ofile:
+            ofile.write('ranks,fanout,seconds\n')
+            for r in results:
+                ofile.write('%d,%d,%f\n' % r)
+    return results
+
+
+def main(argv):
+    import argparse
+    parser = argparse.ArgumentParser(
+        description='Benchmark the reduction of data information across ranks')
+    parser.add_argument('-o', '--output', default=None, type=str,
+                        help='CSV file to write the timings to')
+    parser.add_argument('-f', '--fanouts', default=[0, 2, 4, 8], type=int, nargs='+',
+                        help='Fan-outs to time, 0 gathers on the root')
+    parser.add_argument('-b', '--blocks', default=12, type=int,
+                        help='Number of shapes of the partitioned dataset collection')
+    parser.add_argument('-r', '--repeat', default=20, type=int,
+                        help='Number of gathers per fan-out')
+
+    args = parser.parse_args(argv)
+    run(filename=args.output, fanouts=args.fanouts, blocks=args.blocks, repeat=args.repeat)
+
+
+if __name__ == "__main__":
+    import sys
+
+    main(sys.argv[1:])
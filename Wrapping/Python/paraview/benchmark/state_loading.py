@@ -0,0 +1,98 @@
+'''
+State loading benchmark: saves a state with many pipeline proxies and times
+loading it back, with the proxies created one at a time and in waves of
+independent proxies (the LoadStateInWaves general setting).
+
+Run it with pvpython, connected to a server or not, or import state_loading
+from paraview.benchmark and call its run method. The duration of each stage
+of the loading shows in the Timer Log.
+'''
+
+from __future__ import print_function
+import datetime as dt
+import os
+import shutil
+import tempfile
+from paraview.simple import *
+import paraview
+
+
+def __build_pipelines(pipelines):
+    '''Creates `pipelines` independent Sphere - Shrink - Elevation chains.'''
+    for i in range(pipelines):
+        sphere = Sphere(Center=[i, 0, 0], ThetaResolution=8 + i % 8)
+        shrink = Shrink(Input=sphere, ShrinkFactor=0.5 + (i % 5) * 0.1)
+        Elevation(Input=shrink, LowPoint=[i, -1, 0], HighPoint=[i, 1, 0])
+
+
+def __load(statefile, in_waves):
+    ResetSession()
+    GetSettingsProxy('GeneralSettings').LoadStateInWaves = 1 if in_waves else 0
+    t0 = dt.datetime.now()
+    LoadState(statefile)
+    elapsed = (dt.datetime.now() - t0).total_seconds()
+    return elapsed, len(GetSources())
+
+
+def run(filename=None, pipelines=1700, repeat=3):
+    '''Runs the benchmark. If a filename is specified, it will write the
+    results to that file as csv. The state of `pipelines` chains of three
+    proxies is loaded `repeat` times in each mode, and the best time is
+    reported.
+    '''
+    paraview.servermanager.SetProgressPrintingEnabled(0)
+
+    ResetSession()
+    __build_pipelines(pipelines)
+    nproxies = len(GetSources())
+
+    results = []
+    tempdir = tempfile.mkdtemp()
+    try:
+        statefile = os.path.join(tempdir, 'state_loading.pvsm')
+        SaveState(statefile)
+
+        for in_waves in (False, True):
+            best = None
+            for i in range(repeat):
+                elapsed, nloaded = __load(statefile, in_waves)
+                if nloaded != nproxies:
+                    raise RuntimeError('Loaded %d sources instead of %d' % (nloaded, nproxies))
+                best = elapsed if best is None else min(best, elapsed)
+            mode = 'waves' if in_waves else 'sequential'
+            print('%-10s sources %d %10.4f s' % (mode, nproxies, best))
+            results.append((mode, nproxies, best))
+    finally:
+        shutil.rmtree(tempdir)
+        ResetSession()
+        GetSettingsProxy('GeneralSettings').LoadStateInWaves = 0
+
+    print('speedup %6.2fx' % (results[0][2] / results[1][2]))
+
+    if filename:
+        with open(filename, 'w') as ofile:
+            ofile.write('mode,sources,seconds\n')
+            for r in results:
+                ofile.write('%s,%d,%f\n' % r)
+    return results
+
+
+def main(argv):
+    import argparse
+    parser = argparse.ArgumentParser(
+        description='Benchmark loading a state file with many proxies')
+    parser.add_argument('-o', '--output', default=None, type=str,
+                        help='CSV file to write the timings to')
+    parser.add_argument('-p', '--pipelines', default=1700, type=int,
+                        help='Number of Sphere - Shrink - Elevation pipelines in the state')
+    parser.add_argument('-r', '--repeat', default=3, type=int,
+                        help='Number of loads per mode')
+
+    args = parser.parse_args(argv)
+    run(filename=args.output, pipelines=args.pipelines, repeat=args.repeat)
+
+
+if __name__ == "__main__":
+    import sys
+
+    main(sys.argv[1:])
@@ -24,8 +24,9 @@ def IntegrateCell(dataset, cellId):
     This functions uses vtkCellIntegrator's Integrate method that calculates
     the length/area/volume of a 1D/2D/3D cell. The calculation is exact for
     lines, polylines, triangles, triangle strips, pixels, voxels, convex
-    polygons, quads and tetrahedra. All other 3D cells are triangulated
-    during volume calculation. In such cases, the result may not be exact.
+    polygons, quads, tetrahedra, hexahedra, wedges and pyramids. All other 3D
+    cells are triangulated during volume calculation. In such cases, the result
+    may not be exact.
     """
     from paraview.modules.vtkPVVTKExtensionsFiltersGeneral import vtkCellIntegrator
     return vtkCellIntegrator.Integrate(dataset, cellId)